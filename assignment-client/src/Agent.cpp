@@ -62,6 +62,9 @@
 
 static const int RECEIVED_AUDIO_STREAM_CAPACITY_FRAMES = 10;
 
+// an agent has the injector thread to itself, and may play a whole crowd of sounds
+static const size_t MAX_AGENT_INJECTORS = 5000;
+
 Agent::Agent(ReceivedMessage& message) :
     ThreadedAssignment(message),
     _receivedAudioStream(RECEIVED_AUDIO_STREAM_CAPACITY_FRAMES, RECEIVED_AUDIO_STREAM_CAPACITY_FRAMES),
@@ -92,7 +95,7 @@ Agent::Agent(ReceivedMessage& message) :
     DependencyManager::set<SoundCache>();
     DependencyManager::set<SoundCacheScriptingInterface>();
     DependencyManager::set<AudioScriptingInterface>();
-    DependencyManager::set<AudioInjectorManager>();
+    DependencyManager::set<AudioInjectorManager>()->setMaxInjectors(MAX_AGENT_INJECTORS);
 
     DependencyManager::set<recording::Deck>();
     DependencyManager::set<recording::Recorder>();
@@ -931,6 +931,7 @@ void AssetServer::sendStatsPacket() {
         connectionStats["5. Period (us)"] = stats.packetSendPeriod;
         connectionStats["6. Up (Mb/s)"] = stats.sentBytes * megabitsPerSecPerByte;
         connectionStats["7. Down (Mb/s)"] = stats.receivedBytes * megabitsPerSecPerByte;
+        connectionStats["8. Send Jitter (us)"] = stats.sendJitter;
         nodeStats["Connection Stats"] = connectionStats;
 
         using Events = udt::ConnectionStats::Stats::Event;
@@ -942,6 +943,8 @@ void AssetServer::sendStatsPacket() {
         upstreamStats["3. Recvd ACK"] = events[Events::ReceivedACK];
         upstreamStats["4. Procd ACK"] = events[Events::ProcessedACK];
         upstreamStats["5. Retransmitted"] = (int)stats.retransmittedPackets;
+        upstreamStats["6. Sender Threads"] = stats.senderThreads;
+        upstreamStats["7. Sender Wakeups (/s)"] = stats.senderWakeupsPerSecond;
         nodeStats["Upstream Stats"] = upstreamStats;
 
         QJsonObject downstreamStats;
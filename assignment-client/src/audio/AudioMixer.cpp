@@ -23,6 +23,7 @@
 #include <NetworkAccessManager.h>
 #include <NodeList.h>
 #include <Node.h>
+#include <GLMHelpers.h>
 #include <OctreeConstants.h>
 #include <plugins/PluginManager.h>
 #include <plugins/CodecPlugin.h>
@@ -57,6 +58,7 @@ QStringList AudioMixer::_codecPreferenceOrder{};
 vector<AudioMixer::ZoneDescription> AudioMixer::_audioZones;
 vector<AudioMixer::ZoneSettings> AudioMixer::_zoneSettings;
 vector<AudioMixer::ReverbSettings> AudioMixer::_zoneReverbSettings;
+vector<AudioMixer::AudienceSettings> AudioMixer::_zoneAudienceSettings;
 
 AudioMixer::AudioMixer(ReceivedMessage& message) :
     ThreadedAssignment(message)
@@ -291,6 +293,12 @@ void AudioMixer::sendStatsPacket() {
 
     statsObject["silent_packets_per_frame"] = (float)_numSilentPackets / (float)_numStatFrames;
 
+    // mixes that were silent enough not to be encoded
+    auto encoderStats = _encoder.takeStats();
+    statsObject["avg_encodes_per_frame"] = (float)encoderStats.numEncodes / (float)_numStatFrames;
+    statsObject["silent_frame_ratio"] = encoderStats.numListenerFrames > 0 ?
+        (float)encoderStats.numSilentFrames / (float)encoderStats.numListenerFrames : 0.0f;
+
     // timing stats
     QJsonObject timingStats;
 
@@ -309,6 +317,13 @@ void AudioMixer::sendStatsPacket() {
     addTiming(_mixTiming, "mix");
     addTiming(_eventsTiming, "events");
 
+    // the encoding stage runs along the next frame, its latency is from the start of a frame to its last packet
+    if (encoderStats.numFrames > 0) {
+        timingStats["us_per_encode"] = (qint64)(encoderStats.encodeTime / encoderStats.numFrames);
+        timingStats["us_frame_latency"] = (qint64)(encoderStats.latency / encoderStats.numFrames);
+        timingStats["us_frame_latency_max"] = (qint64)encoderStats.maxLatency;
+    }
+
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     timingStats["ns_per_mix"] = (_stats.totalMixes > 0) ?  (float)(_stats.mixTime / _stats.totalMixes) : 0;
 #endif
@@ -338,6 +353,11 @@ void AudioMixer::sendStatsPacket() {
     mixStats["3_active_to_skippped"] = (int)(_stats.activeToSkipped / (float)_numStatFrames);
     mixStats["3_active_to_inactive"] = (int)(_stats.activeToInactive / (float)_numStatFrames);
 
+    mixStats["4_shared_mixes"] = (int)(_stats.sharedMixes / (float)_numStatFrames);
+    mixStats["4_shared_mix_listeners"] = (int)(_stats.sharedMixListeners / (float)_numStatFrames);
+    mixStats["4_shared_encodes"] = (int)(_stats.sharedEncodes / (float)_numStatFrames);
+    mixStats["4_neighbor_mixes"] = (int)(_stats.neighborMixes / (float)_numStatFrames);
+
     mixStats["total_mixes"] = _stats.totalMixes;
     mixStats["avg_mixes_per_block"] = _stats.totalMixes / _numStatFrames;
 
@@ -428,6 +448,7 @@ void AudioMixer::start() {
         }
 
         auto frameTimer = _frameTiming.timer();
+        auto frameStart = p_high_resolution_clock::now();
 
         // process (node-isolated) audio packets across worker threads
         {
@@ -461,7 +482,11 @@ void AudioMixer::start() {
         nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
             // mix across worker threads
             auto mixTimer = _mixTiming.timer();
+            _workerSharedData.audience.assignListeners(cbegin, cend);
             _workerPool.mix(cbegin, cend, frame, numToRetain);
+
+            // encode and send this frame while the next one is mixed
+            _encoder.encode(cbegin, cend, frame, frameStart);
         });
 
         // gather stats
@@ -475,6 +500,8 @@ void AudioMixer::start() {
 
 
         if (_isFinished) {
+            _encoder.wait();
+
             // alert qt eventing that this is finished
             QCoreApplication::sendPostedEvents(this, QEvent::DeferredDelete);
             break;
@@ -553,6 +580,7 @@ void AudioMixer::clearDomainSettings() {
     _audioZones.clear();
     _zoneSettings.clear();
     _zoneReverbSettings.clear();
+    _zoneAudienceSettings.clear();
 }
 
 void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
@@ -804,6 +832,45 @@ void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
                 }
             }
         }
+
+        const QString AUDIENCE = "audience";
+        if (audioEnvGroupObject[AUDIENCE].isArray()) {
+            const QJsonArray& audience = audioEnvGroupObject[AUDIENCE].toArray();
+
+            const QString ZONE = "zone";
+            const QString CELL_SIZE = "cell_size";
+            const QString FACING = "facing";
+            const QString MIX_NEIGHBORS = "mix_neighbors";
+            const float MIN_CELL_SIZE = 1.0f;
+            for (int i = 0; i < audience.count(); ++i) {
+                QJsonObject audienceObject = audience[i].toObject();
+
+                if (audienceObject.contains(ZONE) && audienceObject.contains(CELL_SIZE)) {
+                    bool okCellSize;
+                    auto itZone = find_if(begin(_audioZones), end(_audioZones), [&](const ZoneDescription& description) {
+                        return description.name == audienceObject.value(ZONE).toString();
+                    });
+                    float cellSize = audienceObject.value(CELL_SIZE).toString().toFloat(&okCellSize);
+
+                    // facing is a yaw in degrees, the audience faces -z by default
+                    bool okFacing;
+                    float facing = audienceObject.value(FACING).toString().toFloat(&okFacing);
+
+                    if (okCellSize && cellSize >= MIN_CELL_SIZE && itZone != end(_audioZones)) {
+                        AudienceSettings settings;
+                        settings.zone = itZone - begin(_audioZones);
+                        settings.cellSize = cellSize;
+                        settings.orientation = glm::angleAxis(glm::radians(okFacing ? facing : 0.0f), Vectors::UNIT_Y);
+                        settings.mixNeighbors = audienceObject.value(MIX_NEIGHBORS).toBool();
+
+                        _zoneAudienceSettings.push_back(settings);
+
+                        qCDebug(audio) << "Added Audience:" << itZone->name << cellSize << (okFacing ? facing : 0.0f)
+                            << settings.mixNeighbors;
+                    }
+                }
+            }
+        }
     }
 }
 
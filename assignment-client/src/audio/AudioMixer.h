@@ -20,6 +20,7 @@
 
 #include <plugins/Forward.h>
 
+#include "AudioMixerEncoder.h"
 #include "AudioMixerStats.h"
 #include "AudioMixerWorkerPool.h"
 
@@ -49,6 +50,13 @@ public:
         float reverbTime;
         float wetLevel;
     };
+    // The listeners in an audience zone share the mix of the cell they are in
+    struct AudienceSettings {
+        int zone;
+        float cellSize;
+        glm::quat orientation; // which way the audience faces
+        bool mixNeighbors; // whether listeners also hear the others in their cell
+    };
 
     static int getStaticJitterFrames() { return _numStaticJitterFrames; }
     static bool shouldMute(float quietestFrame) { return quietestFrame > _noiseMutingThreshold; }
@@ -56,6 +64,7 @@ public:
     static const std::vector<ZoneDescription>& getAudioZones() { return _audioZones; }
     static const std::vector<ZoneSettings>& getZoneSettings() { return _zoneSettings; }
     static const std::vector<ReverbSettings>& getReverbSettings() { return _zoneReverbSettings; }
+    static const std::vector<AudienceSettings>& getAudienceSettings() { return _zoneAudienceSettings; }
     static const std::pair<QString, CodecPluginPointer> negotiateCodec(std::vector<QString> codecs);
 
     static bool shouldReplicateTo(const Node& from, const Node& to) {
@@ -106,6 +115,7 @@ private:
     AudioMixerStats _stats;
 
     AudioMixerWorkerPool _workerPool { _workerSharedData };
+    AudioMixerEncoder _encoder;
 
     class Timer {
     public:
@@ -147,6 +157,7 @@ private:
     static std::vector<ZoneDescription> _audioZones;
     static std::vector<ZoneSettings> _zoneSettings;
     static std::vector<ReverbSettings> _zoneReverbSettings;
+    static std::vector<AudienceSettings> _zoneAudienceSettings;
 
     float _throttleStartTarget = 0.9f;
     float _throttleBackoffTarget = 0.44f;
@@ -0,0 +1,134 @@
+//
+//  AudioMixerAudience.cpp
+//  assignment-client/src/audio
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioMixerAudience.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "AudioMixer.h"
+#include "AvatarAudioStream.h"
+
+namespace {
+
+AudienceCells::Listener getListener(const Node& node) {
+    AudienceCells::Listener listener;
+    listener.isAgent = node.getType() == NodeType::Agent;
+    listener.hasActiveSocket = node.getActiveSocket() != nullptr;
+    listener.isUpstream = node.isUpstream();
+
+    auto data = static_cast<AudioMixerClientData*>(node.getLinkedData());
+    auto avatarStream = data ? data->getAvatarAudioStream() : nullptr;
+    listener.hasAvatarStream = avatarStream != nullptr;
+    if (!avatarStream) {
+        return listener;
+    }
+
+    listener.isIgnoreBoxEnabled = avatarStream->isIgnoreBoxEnabled();
+    listener.isLoopingBack = avatarStream->shouldLoopbackForNode();
+    listener.isSoloing = !data->getSoloedNodes().empty();
+    listener.isIgnoring = !node.getIgnoredNodeIDs().empty() || !data->getIgnoringNodeIDs().empty() ||
+        !data->getNewIgnoredNodeIDs().empty() || !data->getNewUnignoredNodeIDs().empty() ||
+        !data->getNewIgnoringNodeIDs().empty() || !data->getNewUnignoringNodeIDs().empty();
+    listener.masterAvatarGain = data->getMasterAvatarGain();
+    listener.masterInjectorGain = data->getMasterInjectorGain();
+    listener.hasAvatarGainAdjustments = data->hasAvatarGainAdjustments();
+    return listener;
+}
+
+}
+
+AudioMixerAudience::Cell::Cell() :
+    limiter(AudioConstants::SAMPLE_RATE, AudioConstants::STEREO)
+{
+}
+
+AudioMixerAudience::Cell::~Cell() {
+    for (auto& encoding : encodings) {
+        if (encoding.second.codec && encoding.second.encoder) {
+            encoding.second.codec->releaseEncoder(encoding.second.encoder);
+        }
+    }
+}
+
+void AudioMixerAudience::assignListeners(ConstIter begin, ConstIter end) {
+    _listenerCells.clear();
+
+    auto& audienceSettings = AudioMixer::getAudienceSettings();
+    if (audienceSettings.empty()) {
+        _cells.clear();
+        return;
+    }
+    auto& audioZones = AudioMixer::getAudioZones();
+
+    std::vector<AudienceCells::Audience> audiences;
+    audiences.reserve(audienceSettings.size());
+    for (const auto& settings : audienceSettings) {
+        audiences.push_back({ audioZones[settings.zone].area, settings.cellSize });
+    }
+
+    std::map<CellKey, std::vector<Node*>> cellListeners;
+    std::for_each(begin, end, [&](const SharedNodePointer& node) {
+        if (!AudienceCells::canShareMix(getListener(*node))) {
+            return;
+        }
+
+        CellKey cell;
+        glm::vec3 position = static_cast<AudioMixerClientData*>(node->getLinkedData())->getPosition();
+        if (AudienceCells::findCell(audiences, position, cell)) {
+            cellListeners[cell].push_back(node.get());
+        }
+    });
+
+    // let go of the cells nobody shares anymore, along with their encoders
+    for (auto it = _cells.begin(); it != _cells.end();) {
+        auto listeners = cellListeners.find(it->first);
+        if (listeners == cellListeners.end() || listeners->second.size() < AudienceCells::MIN_LISTENERS_PER_CELL) {
+            it = _cells.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    for (const auto& listeners : cellListeners) {
+        if (listeners.second.size() < AudienceCells::MIN_LISTENERS_PER_CELL) {
+            continue;
+        }
+
+        auto& cell = _cells[listeners.first];
+        if (!cell) {
+            cell.reset(new Cell());
+        }
+
+        const auto& settings = audienceSettings[std::get<0>(listeners.first)];
+        glm::vec3 corner = AudienceCells::getCellCorner(audiences, listeners.first);
+        cell->area = AABox(corner, settings.cellSize);
+
+        // mix in the middle of the cell, at the height of the listeners' ears
+        float height = 0.0f;
+        for (auto listener : listeners.second) {
+            height += static_cast<AudioMixerClientData*>(listener->getLinkedData())->getPosition().y;
+            _listenerCells[listener->getLocalID()] = cell.get();
+        }
+        height /= (float)listeners.second.size();
+        float halfCellSize = 0.5f * settings.cellSize;
+        cell->position = glm::vec3(corner.x + halfCellSize, height, corner.z + halfCellSize);
+        cell->orientation = settings.orientation;
+        cell->mixNeighbors = settings.mixNeighbors;
+
+        cell->isMixed = false;
+    }
+}
+
+AudioMixerAudience::Cell* AudioMixerAudience::getCell(Node::LocalID listener) const {
+    auto cell = _listenerCells.find(listener);
+    return cell != _listenerCells.end() ? cell->second : nullptr;
+}
@@ -0,0 +1,86 @@
+//
+//  AudioMixerAudience.h
+//  assignment-client/src/audio
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioMixerAudience_h
+#define hifi_AudioMixerAudience_h
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <AABox.h>
+#include <AudienceCells.h>
+#include <AudioConstants.h>
+#include <AudioLimiter.h>
+#include <NodeList.h>
+#include <plugins/CodecPlugin.h>
+
+#include "AudioMixerClientData.h"
+
+// Groups the listeners of the audience zones into cells.  The listeners in a cell hear one mix, made at the center of
+// the cell and encoded once per codec, instead of a mix each.
+class AudioMixerAudience {
+public:
+    using ConstIter = NodeList::const_iterator;
+
+    struct Cell {
+        Cell();
+        ~Cell();
+
+        AABox area;
+        glm::vec3 position;
+        glm::quat orientation;
+        bool mixNeighbors { false };
+
+        // the first worker to need the mix or an encoding of it this frame makes it, under the mutex
+        std::mutex mutex;
+        bool isMixed { false };
+        bool hasAudio { false };
+
+        // the streams from outside the cell, the ones inside are skipped
+        bool hasStreams { false };
+        AudioMixerClientData::Streams streams;
+
+        float mixSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+        int16_t samples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+        AudioLimiter limiter;
+
+        struct Encoding {
+            CodecPluginPointer codec;
+            Encoder* encoder { nullptr };
+            QByteArray encoded;
+            bool isEncoded { false };
+            bool shouldFlush { false };
+        };
+        std::map<QString, Encoding> encodings;
+    };
+
+    // sort the listeners into cells for the coming frame, before the workers mix
+    void assignListeners(ConstIter begin, ConstIter end);
+
+    // the cell a listener shares a mix in, nullptr if the listener gets a mix of its own
+    Cell* getCell(Node::LocalID listener) const;
+
+    int getNumCells() const { return (int)_cells.size(); }
+
+private:
+    using CellKey = AudienceCells::CellKey;
+
+    std::map<CellKey, std::unique_ptr<Cell>> _cells;
+    std::unordered_map<Node::LocalID, Cell*> _listenerCells;
+};
+
+#endif // hifi_AudioMixerAudience_h
@@ -11,6 +11,7 @@
 
 #include "AudioMixerClientData.h"
 
+#include <algorithm>
 #include <random>
 
 #include <glm/common.hpp>
@@ -115,6 +116,9 @@ int AudioMixerClientData::processPackets(ConcurrentAddedStreams& addedStreams) {
     }
     assert(_packetQueue.empty());
 
+    // the streams only queued their audio as the packets were parsed, so decode whatever each one got this frame together
+    decodePendingFrames();
+
     // now that we have processed all packets for this frame
     // we can prepare the sources from this client to be ready for mixing
     return checkBuffersBeforeFrameSend();
@@ -229,9 +233,24 @@ void AudioMixerClientData::setGainForAvatar(QUuid nodeID, float gain) {
 
     if (it != _streams.active.cend()) {
         it->hrtf->setGainAdjustment(gain);
+
+        auto avatar = it->nodeStreamID.nodeLocalID;
+        auto adjusted = std::find(_avatarsWithAdjustedGain.begin(), _avatarsWithAdjustedGain.end(), avatar);
+        if (gain != 1.0f) {
+            if (adjusted == _avatarsWithAdjustedGain.end()) {
+                _avatarsWithAdjustedGain.push_back(avatar);
+            }
+        } else if (adjusted != _avatarsWithAdjustedGain.end()) {
+            _avatarsWithAdjustedGain.erase(adjusted);
+        }
     }
 }
 
+void AudioMixerClientData::forgetAvatarGain(Node::LocalID avatar) {
+    _avatarsWithAdjustedGain.erase(std::remove(_avatarsWithAdjustedGain.begin(), _avatarsWithAdjustedGain.end(), avatar),
+                                   _avatarsWithAdjustedGain.end());
+}
+
 void AudioMixerClientData::parseNodeIgnoreRequest(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& node) {
     auto ignoredNodesPair = node->parseIgnoreRequestMessage(message);
 
@@ -475,6 +494,7 @@ void AudioMixerClientData::processStreamPacket(ReceivedMessage& message, Concurr
             }
 
             auto avatarAudioStream = new AvatarAudioStream(isStereo, AudioMixer::getStaticJitterFrames());
+            avatarAudioStream->setDecodeDeferred(true);
             avatarAudioStream->setupCodec(_codec, _selectedCodecName, isStereo ? AudioConstants::STEREO : AudioConstants::MONO);
 
             if (_isIgnoreRadiusEnabled) {
@@ -514,6 +534,7 @@ void AudioMixerClientData::processStreamPacket(ReceivedMessage& message, Concurr
 
             // we don't have this injected stream yet, so add it
             auto injectorStream = new InjectedAudioStream(streamIdentifier, isStereo, AudioMixer::getStaticJitterFrames());
+            injectorStream->setDecodeDeferred(true);
 
 #if INJECTORS_SUPPORT_CODECS
             injectorStream->setupCodec(_codec, _selectedCodecName, isStereo ? AudioConstants::STEREO : AudioConstants::MONO);
@@ -532,21 +553,26 @@ void AudioMixerClientData::processStreamPacket(ReceivedMessage& message, Concurr
     // seek to the beginning of the packet so that the next reader is in the right spot
     message.seek(0);
 
-    // check the overflow count before we parse data
-    auto overflowBefore = matchingStream->getOverflowCount();
     matchingStream->parseData(message);
 
-    if (matchingStream->getOverflowCount() > overflowBefore) {
-        qCDebug(audio) << "Just overflowed on stream" << matchingStream->getStreamIdentifier()
-            << "from" << message.getSourceID();
-    }
-
     if (newStream) {
         // whenever a stream is added, push it to the concurrent vector of streams added this frame
         addedStreams.push_back(AddedStream(getNodeID(), getNodeLocalID(), matchingStream->getStreamIdentifier(), matchingStream.get()));
     }
 }
 
+void AudioMixerClientData::decodePendingFrames() {
+    for (auto& stream : _audioStreams) {
+        // check the overflow count before we decode
+        auto overflowBefore = stream->getOverflowCount();
+        stream->decodePendingFrames();
+
+        if (stream->getOverflowCount() > overflowBefore) {
+            qCDebug(audio) << "Just overflowed on stream" << stream->getStreamIdentifier() << "from" << getNodeLocalID();
+        }
+    }
+}
+
 int AudioMixerClientData::checkBuffersBeforeFrameSend() {
     auto it = _audioStreams.begin();
     while (it != _audioStreams.end()) {
@@ -758,12 +784,15 @@ void AudioMixerClientData::encodeFrameOfZeros(QByteArray& encodedZeros) {
 }
 
 void AudioMixerClientData::setupCodec(CodecPluginPointer codec, const QString& codecName) {
-    cleanupCodec(); // cleanup any previously allocated coders first
-    _codec = codec;
-    _selectedCodecName = codecName;
-    if (codec) {
-        _encoder = codec->createEncoder(AudioConstants::SAMPLE_RATE, AudioConstants::STEREO);
-        _decoder = codec->createDecoder(AudioConstants::SAMPLE_RATE, AudioConstants::MONO);
+    {
+        std::lock_guard<std::mutex> lock(_encoderMutex);
+        releaseCoders(); // cleanup any previously allocated coders first
+        _codec = codec;
+        _selectedCodecName = codecName;
+        if (codec) {
+            _encoder = codec->createEncoder(AudioConstants::SAMPLE_RATE, AudioConstants::STEREO);
+            _decoder = codec->createDecoder(AudioConstants::SAMPLE_RATE, AudioConstants::MONO);
+        }
     }
 
     auto avatarAudioStream = getAvatarAudioStream();
@@ -786,6 +815,11 @@ void AudioMixerClientData::setupCodec(CodecPluginPointer codec, const QString& c
 }
 
 void AudioMixerClientData::cleanupCodec() {
+    std::lock_guard<std::mutex> lock(_encoderMutex);
+    releaseCoders();
+}
+
+void AudioMixerClientData::releaseCoders() {
     // release any old codec encoder/decoder first...
     if (_codec) {
         if (_decoder) {
@@ -12,6 +12,7 @@
 #ifndef hifi_AudioMixerClientData_h
 #define hifi_AudioMixerClientData_h
 
+#include <mutex>
 #include <queue>
 
 #if !defined(Q_MOC_RUN)
@@ -71,6 +72,9 @@ public:
     void parseSoloRequest(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& node);
     void parseStopInjectorPacket(QSharedPointer<ReceivedMessage> packet);
 
+    // decode the audio each stream queued while its packets were parsed
+    void decodePendingFrames();
+
     // attempt to pop a frame from each audio stream, and return the number of streams from this client
     int checkBuffersBeforeFrameSend();
 
@@ -106,6 +110,22 @@ public:
     bool shouldFlushEncoder() { return _shouldFlushEncoder; }
 
     QString getCodecName() { return _selectedCodecName; }
+    CodecPluginPointer getCodec() const { return _codec; }
+
+    // the encoding stage of the mixer runs along the next frame, it holds this while it encodes and sends
+    std::mutex& getEncoderMutex() { return _encoderMutex; }
+
+    // A mix on its way from the mixing stage to the encoding stage.  There are two, so one can be mixed while the
+    // other is encoded.
+    struct OutboundMix {
+        enum Type { Silent, Mixed, Shared };
+
+        Type type { Silent };
+        bool isPending { false };
+        int16_t samples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+        QByteArray encoded; // the encoded mix of a cell, empty when it is silent
+    };
+    OutboundMix& getOutboundMix(unsigned int frame) { return _outboundMixes[frame % NUM_OUTBOUND_MIXES]; }
 
     bool shouldMuteClient() { return _shouldMuteClient; }
     void setShouldMuteClient(bool shouldMuteClient) { _shouldMuteClient = shouldMuteClient; }
@@ -158,6 +178,11 @@ public:
 
     const std::vector<QUuid>& getSoloedNodes() const { return _soloedNodes; }
 
+    // whether this listener hears any single avatar at other than unity gain
+    bool hasAvatarGainAdjustments() const { return !_avatarsWithAdjustedGain.empty(); }
+    // the avatar is gone, and its gain with it
+    void forgetAvatarGain(Node::LocalID avatar);
+
     bool getHasReceivedFirstMix() const { return _hasReceivedFirstMix; }
     void setHasReceivedFirstMix(bool hasReceivedFirstMix) { _hasReceivedFirstMix = hasReceivedFirstMix; }
 
@@ -194,6 +219,9 @@ private:
 
     float _masterAvatarGain { 1.0f };   // per-listener mixing gain, applied only to avatars
     float _masterInjectorGain { 1.0f }; // per-listener mixing gain, applied only to injectors
+    std::vector<Node::LocalID> _avatarsWithAdjustedGain; // the avatars this listener has set a gain other than 1 for
+
+    void releaseCoders();
 
     CodecPluginPointer _codec;
     QString _selectedCodecName;
@@ -201,6 +229,10 @@ private:
     Decoder* _decoder{ nullptr }; // for mic stream
 
     bool _shouldFlushEncoder { false };
+    std::mutex _encoderMutex;
+
+    static const int NUM_OUTBOUND_MIXES = 2;
+    OutboundMix _outboundMixes[NUM_OUTBOUND_MIXES];
 
     bool _shouldMuteClient { false };
     bool _requestsDomainListData { false };
@@ -0,0 +1,140 @@
+//
+//  AudioMixerEncoder.cpp
+//  assignment-client/src/audio
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioMixerEncoder.h"
+
+#include <algorithm>
+#include <mutex>
+
+#include <TBBHelpers.h>
+#include <udt/PacketHeaders.h>
+
+#include "AudioMixerClientData.h"
+
+// packet helpers
+std::unique_ptr<NLPacket> createAudioPacket(PacketType type, int size, quint16 sequence, QString codec);
+void sendMixPacket(const SharedNodePointer& node, AudioMixerClientData& data, QByteArray& buffer);
+void sendSilentPacket(const SharedNodePointer& node, AudioMixerClientData& data);
+
+void AudioMixerEncoder::encode(ConstIter begin, ConstIter end, unsigned int frame,
+                               p_high_resolution_clock::time_point frameStart) {
+    // the mixes of the last frame are in the other buffer, and need to be out before this frame's can go
+    wait();
+
+    _listeners.clear();
+    std::for_each(begin, end, [&](const SharedNodePointer& node) {
+        auto data = static_cast<AudioMixerClientData*>(node->getLinkedData());
+        if (data && data->getOutboundMix(frame).isPending) {
+            _listeners.push_back(node);
+        }
+    });
+
+    _tasks.run([this, frame, frameStart] {
+        auto encodeStart = p_high_resolution_clock::now();
+
+        const size_t MIN_LISTENERS_PER_TASK = 8;
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, _listeners.size(), MIN_LISTENERS_PER_TASK),
+                          [&](const tbb::blocked_range<size_t>& range) {
+            for (size_t i = range.begin(); i != range.end(); ++i) {
+                encode(_listeners[i], frame);
+            }
+        });
+
+        auto encodeEnd = p_high_resolution_clock::now();
+        uint64_t encodeTime = std::chrono::duration_cast<std::chrono::microseconds>(encodeEnd - encodeStart).count();
+        uint64_t latency = std::chrono::duration_cast<std::chrono::microseconds>(encodeEnd - frameStart).count();
+
+        _numFrames++;
+        _numListenerFrames += (int)_listeners.size();
+        _encodeTime += encodeTime;
+        _latency += latency;
+        uint64_t maxLatency = _maxLatency;
+        while (latency > maxLatency && !_maxLatency.compare_exchange_weak(maxLatency, latency)) {}
+    });
+}
+
+void AudioMixerEncoder::encode(const SharedNodePointer& node, unsigned int frame) {
+    auto data = static_cast<AudioMixerClientData*>(node->getLinkedData());
+    auto& mix = data->getOutboundMix(frame);
+
+    // keep the codec from changing under us
+    std::lock_guard<std::mutex> lock(data->getEncoderMutex());
+
+    if (mix.type == AudioMixerClientData::OutboundMix::Mixed) {
+        QByteArray decodedBuffer(reinterpret_cast<char*>(mix.samples), AudioConstants::NETWORK_FRAME_BYTES_STEREO);
+        QByteArray encodedBuffer;
+        data->encode(decodedBuffer, encodedBuffer);
+        sendMixPacket(node, *data, encodedBuffer);
+        ++_numEncodes;
+    } else if (mix.type == AudioMixerClientData::OutboundMix::Shared && !mix.encoded.isEmpty()) {
+        sendMixPacket(node, *data, mix.encoded);
+    } else if (mix.type == AudioMixerClientData::OutboundMix::Silent && data->shouldFlushEncoder()) {
+        // time to flush (resets shouldFlush until the next encode), so the codec goes quiet along with the client's
+        QByteArray encodedBuffer;
+        data->encodeFrameOfZeros(encodedBuffer);
+        sendMixPacket(node, *data, encodedBuffer);
+        ++_numEncodes;
+    } else {
+        sendSilentPacket(node, *data);
+        ++_numSilentFrames;
+    }
+
+    mix.isPending = false;
+}
+
+AudioMixerEncoder::Stats AudioMixerEncoder::takeStats() {
+    Stats stats;
+    stats.numFrames = _numFrames.exchange(0);
+    stats.numListenerFrames = _numListenerFrames.exchange(0);
+    stats.numEncodes = _numEncodes.exchange(0);
+    stats.numSilentFrames = _numSilentFrames.exchange(0);
+    stats.encodeTime = _encodeTime.exchange(0);
+    stats.latency = _latency.exchange(0);
+    stats.maxLatency = _maxLatency.exchange(0);
+    return stats;
+}
+
+std::unique_ptr<NLPacket> createAudioPacket(PacketType type, int size, quint16 sequence, QString codec) {
+    auto audioPacket = NLPacket::create(type, size);
+    audioPacket->writePrimitive(sequence);
+    audioPacket->writeString(codec);
+    return audioPacket;
+}
+
+void sendMixPacket(const SharedNodePointer& node, AudioMixerClientData& data, QByteArray& buffer) {
+    const int MIX_PACKET_SIZE =
+        sizeof(quint16) + AudioConstants::MAX_CODEC_NAME_LENGTH_ON_WIRE + AudioConstants::NETWORK_FRAME_BYTES_STEREO;
+    quint16 sequence = data.getOutgoingSequenceNumber();
+    QString codec = data.getCodecName();
+    auto mixPacket = createAudioPacket(PacketType::MixedAudio, MIX_PACKET_SIZE, sequence, codec);
+
+    // pack samples
+    mixPacket->write(buffer.constData(), buffer.size());
+
+    // send packet
+    DependencyManager::get<NodeList>()->sendPacket(std::move(mixPacket), *node);
+    data.incrementOutgoingMixedAudioSequenceNumber();
+}
+
+void sendSilentPacket(const SharedNodePointer& node, AudioMixerClientData& data) {
+    const int SILENT_PACKET_SIZE =
+        sizeof(quint16) + AudioConstants::MAX_CODEC_NAME_LENGTH_ON_WIRE + sizeof(quint16);
+    quint16 sequence = data.getOutgoingSequenceNumber();
+    QString codec = data.getCodecName();
+    auto mixPacket = createAudioPacket(PacketType::SilentAudioFrame, SILENT_PACKET_SIZE, sequence, codec);
+
+    // pack number of samples
+    mixPacket->writePrimitive(AudioConstants::NETWORK_FRAME_SAMPLES_STEREO);
+
+    // send packet
+    DependencyManager::get<NodeList>()->sendPacket(std::move(mixPacket), *node);
+    data.incrementOutgoingMixedAudioSequenceNumber();
+}
@@ -0,0 +1,67 @@
+//
+//  AudioMixerEncoder.h
+//  assignment-client/src/audio
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioMixerEncoder_h
+#define hifi_AudioMixerEncoder_h
+
+#include <atomic>
+#include <vector>
+
+#if !defined(Q_MOC_RUN)
+#include <tbb/task_group.h>
+#endif
+
+#include <NodeList.h>
+#include <PortableHighResolutionClock.h>
+
+// Encodes and sends the mixes of a frame in the background, so the next frame is mixed while this one is encoded.
+//   AudioMixerEncoder is not thread-safe! It should be used from the mixer's thread.
+class AudioMixerEncoder {
+public:
+    using ConstIter = NodeList::const_iterator;
+
+    struct Stats {
+        int numFrames { 0 };
+        int numListenerFrames { 0 };
+        int numEncodes { 0 };
+        int numSilentFrames { 0 };
+        uint64_t encodeTime { 0 };
+        uint64_t latency { 0 };
+        uint64_t maxLatency { 0 };
+    };
+
+    ~AudioMixerEncoder() { wait(); }
+
+    // encode and send the mixes of the frame, once the previous frame is done with
+    void encode(ConstIter begin, ConstIter end, unsigned int frame, p_high_resolution_clock::time_point frameStart);
+
+    // wait for the frame that is being encoded
+    void wait() { _tasks.wait(); }
+
+    // the stats since the last time they were taken, times in microseconds
+    Stats takeStats();
+
+private:
+    void encode(const SharedNodePointer& node, unsigned int frame);
+
+    tbb::task_group _tasks;
+    std::vector<SharedNodePointer> _listeners;
+
+    std::atomic<int> _numFrames { 0 };
+    std::atomic<int> _numListenerFrames { 0 };
+    std::atomic<int> _numEncodes { 0 };
+    std::atomic<int> _numSilentFrames { 0 };
+    std::atomic<uint64_t> _encodeTime { 0 };
+    std::atomic<uint64_t> _latency { 0 };
+    std::atomic<uint64_t> _maxLatency { 0 };
+};
+
+#endif // hifi_AudioMixerEncoder_h
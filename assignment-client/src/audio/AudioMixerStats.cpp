@@ -36,6 +36,11 @@ void AudioMixerStats::reset() {
     inactive = 0;
     active = 0;
 
+    sharedMixes = 0;
+    sharedMixListeners = 0;
+    sharedEncodes = 0;
+    neighborMixes = 0;
+
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     mixTime = 0;
 #endif
@@ -66,6 +71,11 @@ void AudioMixerStats::accumulate(const AudioMixerStats& otherStats) {
     inactive += otherStats.inactive;
     active += otherStats.active;
 
+    sharedMixes += otherStats.sharedMixes;
+    sharedMixListeners += otherStats.sharedMixListeners;
+    sharedEncodes += otherStats.sharedEncodes;
+    neighborMixes += otherStats.neighborMixes;
+
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     mixTime += otherStats.mixTime;
 #endif
@@ -41,6 +41,11 @@ struct AudioMixerStats {
     int inactive { 0 };
     int active { 0 };
 
+    int sharedMixes { 0 };
+    int sharedMixListeners { 0 };
+    int sharedEncodes { 0 };
+    int neighborMixes { 0 };
+
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     uint64_t mixTime { 0 };
 #endif
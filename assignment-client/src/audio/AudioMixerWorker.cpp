@@ -42,18 +42,14 @@ using MixableStream = AudioMixerClientData::MixableStream;
 using MixableStreamsVector = AudioMixerClientData::MixableStreamsVector;
 
 // packet helpers
-std::unique_ptr<NLPacket> createAudioPacket(PacketType type, int size, quint16 sequence, QString codec);
-void sendMixPacket(const SharedNodePointer& node, AudioMixerClientData& data, QByteArray& buffer);
-void sendSilentPacket(const SharedNodePointer& node, AudioMixerClientData& data);
 void sendMutePacket(const SharedNodePointer& node, AudioMixerClientData&);
 void sendEnvironmentPacket(const SharedNodePointer& node, AudioMixerClientData& data);
 
 // mix helpers
-inline float approximateGain(const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd);
-inline float computeGain(float masterAvatarGain, float masterInjectorGain, const AvatarAudioStream& listeningNodeStream,
+inline float approximateGain(const glm::vec3& listenerPosition, const PositionalAudioStream& streamToAdd);
+inline float computeGain(float masterAvatarGain, float masterInjectorGain, const glm::vec3& listenerPosition,
         const PositionalAudioStream& streamToAdd, const glm::vec3& relativePosition, float distance);
-inline float computeAzimuth(const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd,
-        const glm::vec3& relativePosition);
+inline float computeAzimuth(const glm::quat& listenerOrientation, const glm::vec3& relativePosition);
 
 void AudioMixerWorker::processPackets(const SharedNodePointer& node) {
     AudioMixerClientData* data = (AudioMixerClientData*)node->getLinkedData();
@@ -96,25 +92,27 @@ void AudioMixerWorker::mix(const SharedNodePointer& node) {
     if (node->getType() == NodeType::Agent && node->getActiveSocket()) {
         ++stats.sumListeners;
 
-        // mix the audio
-        bool mixHasAudio = prepareMix(node);
+        // the encoding stage encodes and sends the mix along the next frame
+        auto& outboundMix = data->getOutboundMix(_frame);
+        outboundMix.isPending = true;
 
-        // send audio packet
-        if (mixHasAudio || data->shouldFlushEncoder()) {
-            QByteArray encodedBuffer;
-            if (mixHasAudio) {
-                // encode the audio
-                QByteArray decodedBuffer(reinterpret_cast<char*>(_bufferSamples), AudioConstants::NETWORK_FRAME_BYTES_STEREO);
-                data->encode(decodedBuffer, encodedBuffer);
-            } else {
-                // time to flush (resets shouldFlush until the next encode)
-                data->encodeFrameOfZeros(encodedBuffer);
-            }
+        // listeners in a cell of an audience share the cell's mix, unless they also hear a neighbor in it
+        auto cell = _sharedData.audience.getCell(node->getLocalID());
+        if (cell && !prepareNeighborMix(node, *cell)) {
+            ++stats.sharedMixListeners;
 
-            sendMixPacket(node, *data, encodedBuffer);
+            outboundMix.type = AudioMixerClientData::OutboundMix::Shared;
+            outboundMix.encoded = encodeCellMix(*cell, *data);
+            if (outboundMix.encoded.isEmpty()) {
+                ++stats.sumListenersSilent;
+            }
+        } else if (cell || prepareMix(node)) {
+            // a neighbor mix always has audio
+            outboundMix.type = AudioMixerClientData::OutboundMix::Mixed;
+            memcpy(outboundMix.samples, _bufferSamples, sizeof(_bufferSamples));
         } else {
             ++stats.sumListenersSilent;
-            sendSilentPacket(node, *data);
+            outboundMix.type = AudioMixerClientData::OutboundMix::Silent;
         }
 
         // send environment packet
@@ -296,7 +294,7 @@ float approximateVolume(const MixableStream& stream, const AvatarAudioStream* li
     }
 
     // approximate the gain
-    float gain = approximateGain(*listenerAudioStream, *(stream.positionalStream));
+    float gain = approximateGain(listenerAudioStream->getPosition(), *(stream.positionalStream));
 
     // for avatar streams, modify by the set gain adjustment
     if (stream.nodeStreamID.streamID.isNull()) {
@@ -306,10 +304,31 @@ float approximateVolume(const MixableStream& stream, const AvatarAudioStream* li
     return stream.positionalStream->getLastPopOutputTrailingLoudness() * gain;
 };
 
+// A mix that stays under one least significant bit would only be dither once limited, so it goes out as a silent
+// frame instead of being encoded.
+bool isAudible(const float* mixSamples) {
+    const float MIN_AUDIBLE_SAMPLE = 1.0f / AudioConstants::MAX_SAMPLE_VALUE;
+    return std::any_of(mixSamples, mixSamples + AudioConstants::NETWORK_FRAME_SAMPLES_STEREO, [&](float sample) {
+        return std::abs(sample) >= MIN_AUDIBLE_SAMPLE;
+    });
+}
+
 bool AudioMixerWorker::prepareMix(const SharedNodePointer& listener) {
     AvatarAudioStream* listenerAudioStream = static_cast<AudioMixerClientData*>(listener->getLinkedData())->getAvatarAudioStream();
     AudioMixerClientData* listenerData = static_cast<AudioMixerClientData*>(listener->getLinkedData());
 
+    // the gains set for avatars that are gone would otherwise keep the listener out of a shared mix
+    if (listenerData->hasAvatarGainAdjustments()) {
+        for (auto removedNode : _sharedData.removedNodes) {
+            listenerData->forgetAvatarGain(removedNode);
+        }
+        for (const auto& removedStream : _sharedData.removedStreams) {
+            if (removedStream.streamID.isNull()) {
+                listenerData->forgetAvatarGain(removedStream.nodeLocalID);
+            }
+        }
+    }
+
     // zero out the mix for this listener
     memset(_mixSamples, 0, sizeof(_mixSamples));
 
@@ -475,18 +494,241 @@ bool AudioMixerWorker::prepareMix(const SharedNodePointer& listener) {
 
     // check for silent audio before limiting
     // limiting uses a dither and can only guarantee abs(sample) <= 1
-    bool hasAudio = false;
-    for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_STEREO; ++i) {
-        if (_mixSamples[i] != 0.0f) {
-            hasAudio = true;
-            break;
+    bool hasAudio = isAudible(_mixSamples);
+
+    // use the per listener AudioLimiter to render the mixed data
+    listenerData->audioLimiter.render(_mixSamples, _bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+
+    return hasAudio;
+}
+
+bool shouldBeSkippedByCell(const MixableStream& stream, const AudioMixerAudience::Cell& cell) {
+    // the streams in the cell are up to its listeners, and an ignore box that reaches into the cell keeps a stream out
+    const auto& positionalStream = *stream.positionalStream;
+    return cell.area.contains(positionalStream.getPosition()) ||
+        (positionalStream.isIgnoreBoxEnabled() && cell.area.touches(positionalStream.getIgnoreBox()));
+}
+
+void AudioMixerWorker::mixCell(AudioMixerAudience::Cell& cell) {
+    std::lock_guard<std::mutex> lock(cell.mutex);
+    if (cell.isMixed) {
+        return;
+    }
+    cell.isMixed = true;
+    ++stats.sharedMixes;
+
+    auto& streams = cell.streams;
+
+    // add data for newly created streams, or all of them for a new cell
+    if (!cell.hasStreams) {
+        std::for_each(_begin, _end, [&](const SharedNodePointer& node) {
+            AudioMixerClientData* nodeData = static_cast<AudioMixerClientData*>(node->getLinkedData());
+            if (nodeData) {
+                for (auto& stream : nodeData->getAudioStreams()) {
+                    streams.active.emplace_back(node->getUUID(), node->getLocalID(),
+                                                stream->getStreamIdentifier(), stream.get());
+                }
+            }
+        });
+        cell.hasStreams = true;
+    } else {
+        for (const auto& newStream : _sharedData.addedStreams) {
+            streams.active.emplace_back(newStream.nodeIDStreamID, newStream.positionalStream);
+        }
+    }
+
+    memset(cell.mixSamples, 0, sizeof(cell.mixSamples));
+
+    // skipped streams go through inactive on their way to active
+    erase_if(streams.skipped, [&](MixableStream& stream) {
+        if (shouldBeRemoved(stream, _sharedData)) {
+            return true;
+        }
+
+        if (!shouldBeSkippedByCell(stream, cell)) {
+            streams.inactive.push_back(move(stream));
+            return true;
+        }
+        return false;
+    });
+
+    erase_if(streams.inactive, [&](MixableStream& stream) {
+        if (shouldBeRemoved(stream, _sharedData)) {
+            return true;
+        }
+
+        if (shouldBeSkippedByCell(stream, cell)) {
+            streams.skipped.push_back(move(stream));
+            return true;
+        }
+
+        if (!shouldBeInactive(stream)) {
+            streams.active.push_back(move(stream));
+            return true;
+        }
+        return false;
+    });
+
+    erase_if(streams.active, [&](MixableStream& stream) {
+        if (shouldBeRemoved(stream, _sharedData)) {
+            return true;
+        }
+
+        if (shouldBeSkippedByCell(stream, cell)) {
+            resetHRTFState(stream);
+            streams.skipped.push_back(move(stream));
+            return true;
+        }
+
+        if (shouldBeInactive(stream)) {
+            // To reduce artifacts we still call render to flush the HRTF on the first frame where the source
+            // becomes silent
+            addCellStream(stream, cell);
+            streams.inactive.push_back(move(stream));
+            return true;
+        }
+
+        stream.approximateVolume = stream.positionalStream->getLastPopOutputTrailingLoudness() *
+            approximateGain(cell.position, *stream.positionalStream);
+        return false;
+    });
+
+    // when throttling, the cell gets the loudest streams, like a listener would
+    auto throttlePoint = end(streams.active);
+    if (_numToRetain != -1 && _numToRetain < (int)streams.active.size()) {
+        throttlePoint = begin(streams.active) + _numToRetain;
+        std::nth_element(begin(streams.active), throttlePoint, end(streams.active), [](const auto& a, const auto& b) {
+            return a.approximateVolume > b.approximateVolume;
+        });
+        std::for_each(throttlePoint, end(streams.active), [&](MixableStream& stream) {
+            resetHRTFState(stream);
+        });
+    }
+    std::for_each(begin(streams.active), throttlePoint, [&](MixableStream& stream) {
+        addCellStream(stream, cell);
+    });
+
+    // check for silent audio before limiting
+    cell.hasAudio = isAudible(cell.mixSamples);
+    cell.limiter.render(cell.mixSamples, cell.samples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+
+    for (auto& encoding : cell.encodings) {
+        encoding.second.isEncoded = false;
+    }
+}
+
+void AudioMixerWorker::addCellStream(AudioMixerClientData::MixableStream& mixableStream, AudioMixerAudience::Cell& cell) {
+    ++stats.totalMixes;
+
+    auto streamToAdd = mixableStream.positionalStream;
+
+    glm::vec3 relativePosition = streamToAdd->getPosition() - cell.position;
+
+    float distance = glm::max(glm::length(relativePosition), EPSILON);
+    float gain = computeGain(1.0f, 1.0f, cell.position, *streamToAdd, relativePosition, distance);
+    float azimuth = computeAzimuth(cell.orientation, relativePosition);
+
+    renderStream(mixableStream, gain, azimuth, distance, false, cell.mixSamples);
+}
+
+bool AudioMixerWorker::prepareNeighborMix(const SharedNodePointer& listener, AudioMixerAudience::Cell& cell) {
+    mixCell(cell);
+
+    AudioMixerClientData* listenerData = static_cast<AudioMixerClientData*>(listener->getLinkedData());
+    AvatarAudioStream* listenerAudioStream = listenerData->getAvatarAudioStream();
+
+    auto& streams = listenerData->getStreams();
+
+    // keep up with the streams, for when this listener gets a mix of its own again
+    addStreams(*listener, *listenerData);
+
+    // the listener has no ignores or solos to sort out, what it doesn't hear in the cell is itself or in its ignore box
+    auto isNeighbor = [&](MixableStream& stream) {
+        return cell.mixNeighbors && cell.area.contains(stream.positionalStream->getPosition()) &&
+            !shouldBeSkipped(stream, *listener, *listenerAudioStream, *listenerData);
+    };
+
+    auto activateNeighbor = [&](MixableStream& stream) {
+        if (shouldBeRemoved(stream, _sharedData)) {
+            return true;
+        }
+
+        if (isNeighbor(stream) && !shouldBeInactive(stream)) {
+            streams.active.push_back(move(stream));
+            return true;
+        }
+        return false;
+    };
+    erase_if(streams.skipped, activateNeighbor);
+    erase_if(streams.inactive, activateNeighbor);
+
+    memcpy(_mixSamples, cell.mixSamples, sizeof(_mixSamples));
+
+    int numNeighbors = 0;
+    erase_if(streams.active, [&](MixableStream& stream) {
+        if (shouldBeRemoved(stream, _sharedData)) {
+            return true;
         }
+
+        if (!isNeighbor(stream)) {
+            return false;
+        }
+
+        addStream(stream, *listenerAudioStream, 1.0f, 1.0f, false);
+        ++numNeighbors;
+
+        if (shouldBeInactive(stream)) {
+            streams.inactive.push_back(move(stream));
+            return true;
+        }
+        return false;
+    });
+
+    if (numNeighbors == 0) {
+        return false;
     }
+    ++stats.neighborMixes;
 
     // use the per listener AudioLimiter to render the mixed data
     listenerData->audioLimiter.render(_mixSamples, _bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 
-    return hasAudio;
+    return true;
+}
+
+QByteArray AudioMixerWorker::encodeCellMix(AudioMixerAudience::Cell& cell, AudioMixerClientData& listenerData) {
+    std::lock_guard<std::mutex> lock(cell.mutex);
+
+    // the listeners with the same codec get the same audio, only the sequence numbers of their packets differ
+    auto& encoding = cell.encodings[listenerData.getCodecName()];
+    if (!encoding.codec && listenerData.getCodec()) {
+        encoding.codec = listenerData.getCodec();
+        encoding.encoder = encoding.codec->createEncoder(AudioConstants::SAMPLE_RATE, AudioConstants::STEREO);
+    }
+
+    if (!encoding.isEncoded) {
+        encoding.isEncoded = true;
+
+        if (cell.hasAudio || encoding.shouldFlush) {
+            QByteArray decodedBuffer(AudioConstants::NETWORK_FRAME_BYTES_STEREO, 0);
+            if (cell.hasAudio) {
+                memcpy(decodedBuffer.data(), cell.samples, AudioConstants::NETWORK_FRAME_BYTES_STEREO);
+            }
+
+            if (encoding.encoder) {
+                encoding.encoder->encode(decodedBuffer, encoding.encoded);
+            } else {
+                encoding.encoded = decodedBuffer;
+            }
+
+            // once there was audio, flush with a frame of zeros
+            encoding.shouldFlush = cell.hasAudio;
+            ++stats.sharedEncodes;
+        } else {
+            encoding.encoded.clear();
+        }
+    }
+
+    return encoding.encoded;
 }
 
 void AudioMixerWorker::addStream(AudioMixerClientData::MixableStream& mixableStream,
@@ -506,9 +748,16 @@ void AudioMixerWorker::addStream(AudioMixerClientData::MixableStream& mixableStr
     float distance = glm::max(glm::length(relativePosition), EPSILON);
     float gain = isEcho ? 1.0f
                         : (isSoloing ? masterAvatarGain
-                                     : computeGain(masterAvatarGain, masterInjectorGain, listeningNodeStream, *streamToAdd,
-                                                   relativePosition, distance));
-    float azimuth = isEcho ? 0.0f : computeAzimuth(listeningNodeStream, listeningNodeStream, relativePosition);
+                                     : computeGain(masterAvatarGain, masterInjectorGain, listeningNodeStream.getPosition(),
+                                                   *streamToAdd, relativePosition, distance));
+    float azimuth = isEcho ? 0.0f : computeAzimuth(listeningNodeStream.getOrientation(), relativePosition);
+
+    renderStream(mixableStream, gain, azimuth, distance, isEcho, _mixSamples);
+}
+
+void AudioMixerWorker::renderStream(AudioMixerClientData::MixableStream& mixableStream, float gain, float azimuth,
+                                    float distance, bool isEcho, float* mixSamples) {
+    auto streamToAdd = mixableStream.positionalStream;
 
     const int HRTF_DATASET_INDEX = 1;
 
@@ -536,7 +785,7 @@ void AudioMixerWorker::addStream(AudioMixerClientData::MixableStream& mixableStr
             // (this is not done for stereo streams since they do not go through the HRTF)
             if (!streamToAdd->isStereo() && !isEcho) {
                 static int16_t silentMonoBlock[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL] = {};
-                mixableStream.hrtf->render(silentMonoBlock, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
+                mixableStream.hrtf->render(silentMonoBlock, mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
                                            AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 
                 ++stats.hrtfRenders;
@@ -554,7 +803,7 @@ void AudioMixerWorker::addStream(AudioMixerClientData::MixableStream& mixableStr
         streamPopOutput.readSamples(_bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_STEREO);
 
         // stereo sources are not passed through HRTF
-        mixableStream.hrtf->mixStereo(_bufferSamples, _mixSamples, gain, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        mixableStream.hrtf->mixStereo(_bufferSamples, mixSamples, gain, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 
         ++stats.manualStereoMixes;
     } else if (isEcho) {
@@ -562,14 +811,14 @@ void AudioMixerWorker::addStream(AudioMixerClientData::MixableStream& mixableStr
         streamPopOutput.readSamples(_bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 
         // echo sources are not passed through HRTF
-        mixableStream.hrtf->mixMono(_bufferSamples, _mixSamples, gain, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        mixableStream.hrtf->mixMono(_bufferSamples, mixSamples, gain, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 
         ++stats.manualEchoMixes;
     } else {
 
         streamPopOutput.readSamples(_bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 
-        mixableStream.hrtf->render(_bufferSamples, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
+        mixableStream.hrtf->render(_bufferSamples, mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
                                    AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
         ++stats.hrtfRenders;
     }
@@ -587,9 +836,9 @@ void AudioMixerWorker::updateHRTFParameters(AudioMixerClientData::MixableStream&
     glm::vec3 relativePosition = streamToAdd->getPosition() - listeningNodeStream.getPosition();
 
     float distance = glm::max(glm::length(relativePosition), EPSILON);
-    float gain = isEcho ? 1.0f : computeGain(masterAvatarGain, masterInjectorGain, listeningNodeStream, *streamToAdd, 
-                                             relativePosition, distance);
-    float azimuth = isEcho ? 0.0f : computeAzimuth(listeningNodeStream, listeningNodeStream, relativePosition);
+    float gain = isEcho ? 1.0f : computeGain(masterAvatarGain, masterInjectorGain, listeningNodeStream.getPosition(),
+                                             *streamToAdd, relativePosition, distance);
+    float azimuth = isEcho ? 0.0f : computeAzimuth(listeningNodeStream.getOrientation(), relativePosition);
 
     mixableStream.hrtf->setParameterHistory(azimuth, distance, gain);
 
@@ -601,43 +850,6 @@ void AudioMixerWorker::resetHRTFState(AudioMixerClientData::MixableStream& mixab
     ++stats.hrtfResets;
 }
 
-std::unique_ptr<NLPacket> createAudioPacket(PacketType type, int size, quint16 sequence, QString codec) {
-    auto audioPacket = NLPacket::create(type, size);
-    audioPacket->writePrimitive(sequence);
-    audioPacket->writeString(codec);
-    return audioPacket;
-}
-
-void sendMixPacket(const SharedNodePointer& node, AudioMixerClientData& data, QByteArray& buffer) {
-    const int MIX_PACKET_SIZE =
-        sizeof(quint16) + AudioConstants::MAX_CODEC_NAME_LENGTH_ON_WIRE + AudioConstants::NETWORK_FRAME_BYTES_STEREO;
-    quint16 sequence = data.getOutgoingSequenceNumber();
-    QString codec = data.getCodecName();
-    auto mixPacket = createAudioPacket(PacketType::MixedAudio, MIX_PACKET_SIZE, sequence, codec);
-
-    // pack samples
-    mixPacket->write(buffer.constData(), buffer.size());
-
-    // send packet
-    DependencyManager::get<NodeList>()->sendPacket(std::move(mixPacket), *node);
-    data.incrementOutgoingMixedAudioSequenceNumber();
-}
-
-void sendSilentPacket(const SharedNodePointer& node, AudioMixerClientData& data) {
-    const int SILENT_PACKET_SIZE =
-        sizeof(quint16) + AudioConstants::MAX_CODEC_NAME_LENGTH_ON_WIRE + sizeof(quint16);
-    quint16 sequence = data.getOutgoingSequenceNumber();
-    QString codec = data.getCodecName();
-    auto mixPacket = createAudioPacket(PacketType::SilentAudioFrame, SILENT_PACKET_SIZE, sequence, codec);
-
-    // pack number of samples
-    mixPacket->writePrimitive(AudioConstants::NETWORK_FRAME_SAMPLES_STEREO);
-
-    // send packet
-    DependencyManager::get<NodeList>()->sendPacket(std::move(mixPacket), *node);
-    data.incrementOutgoingMixedAudioSequenceNumber();
-}
-
 void sendMutePacket(const SharedNodePointer& node, AudioMixerClientData& data) {
     auto mutePacket = NLPacket::create(PacketType::NoisyMute, 0);
     DependencyManager::get<NodeList>()->sendPacket(std::move(mutePacket), *node);
@@ -707,7 +919,7 @@ void sendEnvironmentPacket(const SharedNodePointer& node, AudioMixerClientData&
     }
 }
 
-float approximateGain(const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd) {
+float approximateGain(const glm::vec3& listenerPosition, const PositionalAudioStream& streamToAdd) {
     float gain = 1.0f;
 
     // injector: apply attenuation
@@ -719,7 +931,7 @@ float approximateGain(const AvatarAudioStream& listeningNodeStream, const Positi
     // avatar: skip attenuation - it is too costly to approximate
 
     // distance attenuation: approximate, ignore zone-specific attenuations
-    glm::vec3 relativePosition = streamToAdd.getPosition() - listeningNodeStream.getPosition();
+    glm::vec3 relativePosition = streamToAdd.getPosition() - listenerPosition;
     float distance = glm::length(relativePosition);
     return gain / distance;
 
@@ -728,7 +940,7 @@ float approximateGain(const AvatarAudioStream& listeningNodeStream, const Positi
 
 float computeGain(float masterAvatarGain,
                   float masterInjectorGain,
-                  const AvatarAudioStream& listeningNodeStream,
+                  const glm::vec3& listenerPosition,
                   const PositionalAudioStream& streamToAdd,
                   const glm::vec3& relativePosition,
                   float distance) {
@@ -765,7 +977,7 @@ float computeGain(float masterAvatarGain,
     float attenuationPerDoublingInDistance = AudioMixer::getAttenuationPerDoublingInDistance();
     for (const auto& settings : zoneSettings) {
         if (audioZones[settings.source].area.contains(streamToAdd.getPosition()) &&
-            audioZones[settings.listener].area.contains(listeningNodeStream.getPosition())) {
+            audioZones[settings.listener].area.contains(listenerPosition)) {
             attenuationPerDoublingInDistance = settings.coefficient;
             break;
         }
@@ -801,10 +1013,8 @@ float computeGain(float masterAvatarGain,
     return gain;
 }
 
-float computeAzimuth(const AvatarAudioStream& listeningNodeStream,
-                     const PositionalAudioStream& streamToAdd,
-                     const glm::vec3& relativePosition) {
-    glm::quat inverseOrientation = glm::inverse(listeningNodeStream.getOrientation());
+float computeAzimuth(const glm::quat& listenerOrientation, const glm::vec3& relativePosition) {
+    glm::quat inverseOrientation = glm::inverse(listenerOrientation);
 
     glm::vec3 rotatedSourcePosition = inverseOrientation * relativePosition;
 
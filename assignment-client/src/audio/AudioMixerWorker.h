@@ -24,6 +24,7 @@
 #include <NodeList.h>
 #include <PositionalAudioStream.h>
 
+#include "AudioMixerAudience.h"
 #include "AudioMixerClientData.h"
 #include "AudioMixerStats.h"
 
@@ -38,6 +39,7 @@ public:
         AudioMixerClientData::ConcurrentAddedStreams addedStreams;
         std::vector<Node::LocalID> removedNodes;
         std::vector<NodeIDStreamID> removedStreams;
+        AudioMixerAudience audience;
     };
 
     AudioMixerWorker(SharedData& sharedData) : _sharedData(sharedData) {};
@@ -67,6 +69,16 @@ private:
                               float masterAvatarGain,
                               float masterInjectorGain);
     void resetHRTFState(AudioMixerClientData::MixableStream& mixableStream);
+    void renderStream(AudioMixerClientData::MixableStream& mixableStream, float gain, float azimuth, float distance,
+                      bool isEcho, float* mixSamples);
+
+    // mix the cell once a frame, for the first of its listeners to get here
+    void mixCell(AudioMixerAudience::Cell& cell);
+    void addCellStream(AudioMixerClientData::MixableStream& mixableStream, AudioMixerAudience::Cell& cell);
+    // create the mix of the cell and the listener's neighbors in it, returns false if there is nobody to add
+    bool prepareNeighborMix(const SharedNodePointer& listener, AudioMixerAudience::Cell& cell);
+    // encode the cell's mix once a frame per codec, returns an empty buffer for silence
+    QByteArray encodeCellMix(AudioMixerAudience::Cell& cell, AudioMixerClientData& listenerData);
 
     void addStreams(Node& listener, AudioMixerClientData& listenerData);
 
@@ -870,6 +870,8 @@ void AvatarMixer::sendStatsPacket() {
     workersAggregatObject["sent_5_averageTraitsBytes"] = TIGHT_LOOP_STAT(aggregateStats.numTraitsBytesSent);
     workersAggregatObject["sent_6_averageIdentityBytes"] = TIGHT_LOOP_STAT(aggregateStats.numIdentityBytesSent);
     workersAggregatObject["sent_7_averageHeroAvatars"] = TIGHT_LOOP_STAT(aggregateStats.numHeroesIncluded);
+    workersAggregatObject["sent_8_averageTraitsBytesSavedByDeltas"] = TIGHT_LOOP_STAT(aggregateStats.numTraitsBytesSavedByDeltas);
+    workersAggregatObject["sent_9_averageTraitsDeferred"] = TIGHT_LOOP_STAT(aggregateStats.numTraitsDeferred);
 
     workersAggregatObject["timing_1_processIncomingPackets"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.processIncomingPacketsElapsedTime);
     workersAggregatObject["timing_2_ignoreCalculation"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.ignoreCalculationElapsedTime);
@@ -1061,6 +1063,16 @@ void AvatarMixer::parseDomainServerSettings(const QJsonObject& domainSettings) {
         }
     }
 
+    {   // Avatar entities of avatars further away than this from a listener are held back until they come closer:
+        static const QString AVATAR_ENTITY_INTEREST_RADIUS_KEY = "avatar_entity_interest_radius";
+        float interestRadius = (float)avatarMixerGroupObject[AVATAR_ENTITY_INTEREST_RADIUS_KEY].toDouble(0.0);
+        _workerSharedData.avatarEntityInterestRadius = std::max(0.0f, interestRadius);
+        if (_workerSharedData.avatarEntityInterestRadius > 0.0f) {
+            qCDebug(avatars) << "Avatar mixer only sending avatar entities within"
+                             << _workerSharedData.avatarEntityInterestRadius << "m of each listener";
+        }
+    }
+
     const QString AVATARS_SETTINGS_KEY = "avatars";
 
     static const QString MIN_HEIGHT_OPTION = "min_avatar_height";
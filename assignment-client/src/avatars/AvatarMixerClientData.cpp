@@ -16,6 +16,7 @@
 
 #include <DependencyManager.h>
 #include <NodeList.h>
+#include <SharedUtil.h>
 #include <EntityTree.h>
 #include <ZoneEntityItem.h>
 
@@ -239,9 +240,24 @@ void AvatarMixerClientData::processSetTraitsMessage(ReceivedMessage& message,
                         // to track a deleted instance but keep version information
                         // the avatar mixer uses the negative value of the sent version
                         instanceVersionRef = -packetTraitVersion;
+
+                        if (traitType == AvatarTraits::AvatarEntity) {
+                            _avatarEntityPayloads.erase(instanceID);
+                        }
                     } else {
-                        _avatar->processTraitInstance(traitType, instanceID, message.read(traitSize));
+                        auto traitData = message.read(traitSize);
+                        _avatar->processTraitInstance(traitType, instanceID, traitData);
                         instanceVersionRef = packetTraitVersion;
+
+                        if (traitType == AvatarTraits::AvatarEntity) {
+                            // keep a few versions around, listeners may be a couple of acks behind
+                            const size_t MAX_AVATAR_ENTITY_PAYLOAD_VERSIONS = 4;
+                            auto& payloads = _avatarEntityPayloads[instanceID];
+                            payloads.push_back({ packetTraitVersion, traitData });
+                            if (payloads.size() > MAX_AVATAR_ENTITY_PAYLOAD_VERSIONS) {
+                                payloads.pop_front();
+                            }
+                        }
                     }
 
                     anyTraitsChanged = true;
@@ -261,6 +277,20 @@ void AvatarMixerClientData::processSetTraitsMessage(ReceivedMessage& message,
     }
 }
 
+const QByteArray* AvatarMixerClientData::getAvatarEntityPayload(AvatarTraits::TraitInstanceID instanceID,
+                                                                AvatarTraits::TraitVersion version) const {
+    auto payloadsIt = _avatarEntityPayloads.find(instanceID);
+    if (payloadsIt == _avatarEntityPayloads.end()) {
+        return nullptr;
+    }
+    for (const auto& versionedPayload : payloadsIt->second) {
+        if (versionedPayload.version == version) {
+            return &versionedPayload.payload;
+        }
+    }
+    return nullptr;
+}
+
 void AvatarMixerClientData::processBulkAvatarTraitsAckMessage(ReceivedMessage& message) {
     // Avatar Traits flow control marks each outgoing avatar traits packet with a
     // sequence number. The mixer caches the traits sent in the traits packet.
@@ -315,6 +345,17 @@ void AvatarMixerClientData::processBulkAvatarTraitsAckMessage(ReceivedMessage& m
                        << message.getSenderSockAddr();
         }
     }
+
+    // The node had to drop trait deltas of these avatars, because it didn't hold the version they were based on.
+    // Start over with them, so all of their traits go out whole
+    auto nodeList = DependencyManager::get<NodeList>();
+    while (message.getBytesLeftToRead() >= NUM_BYTES_RFC4122_UUID) {
+        auto avatarID = QUuid::fromRfc4122(message.readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+        auto avatarNode = nodeList->nodeWithUUID(avatarID);
+        if (avatarNode) {
+            resetSentTraitData(avatarNode->getLocalID());
+        }
+    }
 }
 
 uint64_t AvatarMixerClientData::getLastBroadcastTime(NLPacket::LocalID nodeUUID) const {
@@ -383,6 +424,17 @@ void AvatarMixerClientData::resetSentTraitData(Node::LocalID nodeLocalID) {
     }
 }
 
+void AvatarMixerClientData::deferTraitsFrom(Node::LocalID otherAvatar) {
+    _deferredTraitSenders.defer(otherAvatar, getPosition(), usecTimestampNow());
+}
+
+void AvatarMixerClientData::releaseDeferredTraitSenders(float interestRadius) {
+    for (auto otherAvatar : _deferredTraitSenders.release(getPosition(), interestRadius, usecTimestampNow())) {
+        // their traits haven't all been sent, so the next frame looks at them again
+        _lastSentTraitsTimestamps[otherAvatar] = TraitsCheckTimestamp();
+    }
+}
+
 void AvatarMixerClientData::readViewFrustumPacket(const QByteArray& message) {
     _currentViewFrustums.clear();
 
@@ -414,6 +466,9 @@ void AvatarMixerClientData::loadJSONStats(QJsonObject& jsonObject) const {
 
     jsonObject[OUTBOUND_AVATAR_DATA_STATS_KEY] = getOutboundAvatarDataKbps();
     jsonObject[OUTBOUND_AVATAR_TRAITS_STATS_KEY] = getOutboundAvatarTraitsKbps();
+    jsonObject["total_traits_bytes_sent"] = (double)_sentTraitBytes.sent;
+    jsonObject["total_traits_bytes_saved_by_deltas"] = (double)_sentTraitBytes.savedByDeltas;
+    jsonObject["avatars_deferred_out_of_interest"] = _deferredTraitSenders.size();
     jsonObject[INBOUND_AVATAR_DATA_STATS_KEY] = _avatar->getAverageBytesReceivedPerSecond() / (float)BYTES_PER_KILOBIT;
 
     jsonObject["av_data_receive_rate"] = _avatar->getReceiveRate();
@@ -436,6 +491,7 @@ void AvatarMixerClientData::cleanupKilledNode(const QUuid&, Node::LocalID nodeLo
     removeLastBroadcastSequenceNumber(nodeLocalID);
     removeLastBroadcastTime(nodeLocalID);
     _lastSentTraitsTimestamps.erase(nodeLocalID);
+    _deferredTraitSenders.remove(nodeLocalID);
     _perNodeSentTraitVersions.erase(nodeLocalID);
     _perNodeAckedTraitVersions.erase(nodeLocalID);
     for (auto&& pendingTraitVersions : _perNodePendingTraitVersions) {
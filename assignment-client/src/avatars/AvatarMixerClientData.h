@@ -14,6 +14,7 @@
 
 #include <algorithm>
 #include <cfloat>
+#include <deque>
 #include <unordered_map>
 #include <vector>
 #include <queue>
@@ -23,6 +24,7 @@
 
 #include "MixerAvatar.h"
 #include <AssociatedTraitValues.h>
+#include <DeferredTraitSenders.h>
 #include <NodeData.h>
 #include <NumericalConstants.h>
 #include <udt/PacketHeaders.h>
@@ -101,6 +103,14 @@ public:
     float getOutboundAvatarTraitsKbps() const
         { return _avgOtherAvatarTraitsRate.getAverageSampleValuePerSecond() / BYTES_PER_KILOBIT; }
 
+    // traits sent to this node, in bytes, and how much sending deltas instead of whole instances saved
+    void recordSentTraitBytes(qint64 bytesSent, qint64 bytesSavedByDeltas) { _sentTraitBytes.record(bytesSent, bytesSavedByDeltas); }
+
+    // avatars whose avatar entities are held back from this node because they are outside its interest radius
+    void deferTraitsFrom(Node::LocalID otherAvatar);
+    // has the traits of the deferred avatars looked at again, once this node has moved far enough or enough time passed
+    void releaseDeferredTraitSenders(float interestRadius);
+
     void loadJSONStats(QJsonObject& jsonObject) const;
 
     glm::vec3 getPosition() const { return _avatar ? _avatar->getClientGlobalPosition() : glm::vec3(0); }
@@ -161,6 +171,10 @@ public:
 
     void resetSentTraitData(Node::LocalID nodeID);
 
+    // the payload of a recent version of one of this avatar's entities, or null if we no longer have it.
+    // Listeners holding one of these versions can be sent just the changes to the current one
+    const QByteArray* getAvatarEntityPayload(AvatarTraits::TraitInstanceID instanceID, AvatarTraits::TraitVersion version) const;
+
 private:
     struct PacketQueue : public std::queue<QSharedPointer<ReceivedMessage>> {
         QWeakPointer<Node> node;
@@ -203,6 +217,15 @@ private:
     AvatarTraits::TraitVersions _lastReceivedTraitVersions;
     TraitsCheckTimestamp _lastReceivedTraitsChange;
 
+    struct VersionedPayload {
+        AvatarTraits::TraitVersion version;
+        QByteArray payload;
+    };
+    std::unordered_map<AvatarTraits::TraitInstanceID, std::deque<VersionedPayload>> _avatarEntityPayloads;
+
+    AvatarTraits::SentTraitBytes _sentTraitBytes;
+    DeferredTraitSenders _deferredTraitSenders;
+
     AvatarTraits::TraitMessageSequence _currentTraitsMessageSequence{ 0 };
 
     // Cache of trait versions sent in a given packet (indexed by sequence number)
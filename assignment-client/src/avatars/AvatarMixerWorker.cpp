@@ -117,12 +117,20 @@ qint64 AvatarMixerWorker::addChangedTraitsToBulkPacket(AvatarMixerClientData* li
     bool allTraitsUpdated = true;
 
     qint64 bytesWritten = 0;
+    qint64 bytesSavedByDeltas = 0;
 
     if (timeOfLastTraitsChange > timeOfLastTraitsSent) {
         // there is definitely new traits data to send
 
         auto sendingAvatar = sendingNodeData->getAvatarSharedPointer();
 
+        // avatar entities of an avatar outside the listener's interest radius wait until it comes closer,
+        // the rest of its traits (and entity deletes) still go out
+        bool deferAvatarEntities = DeferredTraitSenders::isOutsideInterest(listeningNodeData->getPosition(),
+                                                                           sendingNodeData->getPosition(),
+                                                                           _sharedData->avatarEntityInterestRadius);
+        bool anyTraitsDeferred = false;
+
         // compare trait versions so we can see what exactly needs to go out
         auto& lastSentVersions = listeningNodeData->getLastSentTraitVersions(sendingNodeLocalID);
         auto& lastAckedVersions = listeningNodeData->getLastAckedTraitVersions(sendingNodeLocalID);
@@ -194,11 +202,33 @@ qint64 AvatarMixerWorker::addChangedTraitsToBulkPacket(AvatarMixerClientData* li
                     continue;
                 }
                 if (!isDeleted && (sentInstanceIt == sentIDValuePairs.end() || receivedVersion > sentInstanceIt->value)) {
+                    if (deferAvatarEntities && traitType == AvatarTraits::AvatarEntity) {
+                        anyTraitsDeferred = true;
+                        _stats.numTraitsDeferred++;
+                        continue;
+                    }
+
                     bytesWritten += addTraitsNodeHeader(listeningNodeData, sendingNodeData, traitsPacketList, bytesWritten);
 
-                    // this instance version exists and has never been sent or is newer so we need to send it
-                    bytesWritten += AvatarTraits::packVersionedTraitInstance(traitType, instanceID, traitsPacketList,
-                                                                             receivedVersion, *sendingAvatar);
+                    // this instance version exists and has never been sent or is newer so we need to send it.
+                    // If the listener holds an earlier version we still have, send it only what changed since then
+                    const QByteArray* payload = nullptr;
+                    if (traitType == AvatarTraits::AvatarEntity) {
+                        payload = sendingNodeData->getAvatarEntityPayload(instanceID, receivedVersion);
+                    }
+                    if (payload) {
+                        bool holdsBase = sentInstanceIt != sentIDValuePairs.end();
+                        auto baseVersion = holdsBase ? sentInstanceIt->value : AvatarTraits::NULL_TRAIT_VERSION;
+                        auto basePayload = holdsBase ? sendingNodeData->getAvatarEntityPayload(instanceID, baseVersion) : nullptr;
+                        qint64 savedBytes = 0;
+                        bytesWritten += AvatarTraits::packVersionedTraitInstanceUpdate(traitType, instanceID, traitsPacketList,
+                                                                                       receivedVersion, *payload, baseVersion,
+                                                                                       basePayload, savedBytes);
+                        bytesSavedByDeltas += savedBytes;
+                    } else {
+                        bytesWritten += AvatarTraits::packVersionedTraitInstance(traitType, instanceID, traitsPacketList,
+                                                                                 receivedVersion, *sendingAvatar);
+                    }
 
                     if (sentInstanceIt != sentIDValuePairs.end()) {
                         sentInstanceIt->value = receivedVersion;
@@ -233,14 +263,20 @@ qint64 AvatarMixerWorker::addChangedTraitsToBulkPacket(AvatarMixerClientData* li
         if (bytesWritten) {
             // write a null trait type to mark the end of trait data for this avatar
             bytesWritten += traitsPacketList.writePrimitive(AvatarTraits::NullTrait);
+        }
+        if (allTraitsUpdated && (bytesWritten || anyTraitsDeferred)) {
             // since we send all traits for this other avatar, update the time of last traits sent
-            // to match the time of last traits change
-            if (allTraitsUpdated) {
-                listeningNodeData->setLastOtherAvatarTraitsSendPoint(sendingNodeLocalID, timeOfLastTraitsChange);
+            // to match the time of last traits change.  The avatar entities held back wait in the listener's
+            // deferred list rather than have this avatar looked at again every frame
+            listeningNodeData->setLastOtherAvatarTraitsSendPoint(sendingNodeLocalID, timeOfLastTraitsChange);
+            if (anyTraitsDeferred) {
+                listeningNodeData->deferTraitsFrom(sendingNodeLocalID);
             }
         }
     }
 
+    listeningNodeData->recordSentTraitBytes(bytesWritten, bytesSavedByDeltas);
+    _stats.numTraitsBytesSavedByDeltas += bytesSavedByDeltas;
 
     return bytesWritten;
 }
@@ -326,6 +362,7 @@ void AvatarMixerWorker::broadcastAvatarDataToAgent(const SharedNodePointer& node
     AvatarMixerClientData* destinationNodeData = reinterpret_cast<AvatarMixerClientData*>(destinationNode->getLinkedData());
 
     destinationNodeData->resetInViewStats();
+    destinationNodeData->releaseDeferredTraitSenders(_sharedData->avatarEntityInterestRadius);
 
     const AvatarData& avatar = destinationNodeData->getAvatar();
     glm::vec3 destinationPosition = avatar.getClientGlobalPosition();
@@ -33,6 +33,8 @@ public:
     int numOthersIncluded { 0 };
     int overBudgetAvatars { 0 };
     int numHeroesIncluded { 0 };
+    int numTraitsBytesSavedByDeltas { 0 };
+    int numTraitsDeferred { 0 };
 
     quint64 ignoreCalculationElapsedTime { 0 };
     quint64 avatarDataPackingElapsedTime { 0 };
@@ -59,6 +61,8 @@ public:
         numOthersIncluded = 0;
         overBudgetAvatars = 0;
         numHeroesIncluded = 0;
+        numTraitsBytesSavedByDeltas = 0;
+        numTraitsDeferred = 0;
 
         ignoreCalculationElapsedTime = 0;
         avatarDataPackingElapsedTime = 0;
@@ -83,6 +87,8 @@ public:
         numOthersIncluded += rhs.numOthersIncluded;
         overBudgetAvatars += rhs.overBudgetAvatars;
         numHeroesIncluded += rhs.numHeroesIncluded;
+        numTraitsBytesSavedByDeltas += rhs.numTraitsBytesSavedByDeltas;
+        numTraitsDeferred += rhs.numTraitsDeferred;
 
         ignoreCalculationElapsedTime += rhs.ignoreCalculationElapsedTime;
         avatarDataPackingElapsedTime += rhs.avatarDataPackingElapsedTime;
@@ -98,6 +104,8 @@ using EntityTreePointer = std::shared_ptr<EntityTree>;
 
 struct WorkerSharedData {
     EntityTreePointer entityTree;
+    // avatar entities are only sent to listeners within this distance of their avatar, zero for no limit
+    float avatarEntityInterestRadius { 0.0f };
 };
 
 class AvatarMixerWorker {
@@ -11,6 +11,9 @@
 
 #include "EntityServer.h"
 
+#include <cstdlib>
+#include <functional>
+
 #include <QtCore/QEventLoop>
 #include <QTimer>
 #include <QJsonArray>
@@ -18,6 +21,7 @@
 #include <QRandomGenerator>
 
 #include <EntityTree.h>
+#include <EntityTreeElement.h>
 #include <ResourceCache.h>
 #include <ScriptCache.h>
 #include <plugins/PluginManager.h>
@@ -71,6 +75,13 @@ EntityServer::~EntityServer() {
         _pruneDeletedEntitiesTimer->stop();
         _pruneDeletedEntitiesTimer->deleteLater();
     }
+    if (_compressionDictionaryTimer) {
+        _compressionDictionaryTimer->stop();
+        _compressionDictionaryTimer->deleteLater();
+    }
+    if (_compressionDictionaryTraining.valid()) {
+        _compressionDictionaryTraining.wait();
+    }
 
     EntityTreePointer tree = std::static_pointer_cast<EntityTree>(_tree);
     tree->removeNewlyCreatedHook(this);
@@ -122,6 +133,11 @@ void EntityServer::beforeRun() {
     const int PRUNE_DELETED_MODELS_INTERVAL_MSECS = 1 * 1000; // once every second
     _pruneDeletedEntitiesTimer->start(PRUNE_DELETED_MODELS_INTERVAL_MSECS);
 
+    _compressionDictionaryTimer = new QTimer();
+    connect(_compressionDictionaryTimer, &QTimer::timeout, this, &EntityServer::updateCompressionDictionary);
+    const int UPDATE_COMPRESSION_DICTIONARY_INTERVAL_MSECS = 60 * 1000; // once a minute
+    _compressionDictionaryTimer->start(UPDATE_COMPRESSION_DICTIONARY_INTERVAL_MSECS);
+
     DomainHandler& domainHandler = DependencyManager::get<NodeList>()->getDomainHandler();
     connect(&domainHandler, &DomainHandler::settingsReceiveFail, this, &EntityServer::domainSettingsRequestFailed);
 }
@@ -138,7 +154,7 @@ bool EntityServer::hasSpecialPacketsToSend(const SharedNodePointer& node) {
     if (nodeData) {
         quint64 deletedEntitiesSentAt = nodeData->getLastDeletedEntitiesSentAt();
         EntityTreePointer tree = std::static_pointer_cast<EntityTree>(_tree);
-        shouldSendDeletedEntities = tree->hasEntitiesDeletedSince(deletedEntitiesSentAt);
+        shouldSendDeletedEntities = tree->hasEntitiesDeletedSince(deletedEntitiesSentAt, nodeData->getDeletedEntitiesCursor());
 
         #ifdef EXTRA_ERASE_DEBUGGING
             if (shouldSendDeletedEntities) {
@@ -148,7 +164,7 @@ bool EntityServer::hasSpecialPacketsToSend(const SharedNodePointer& node) {
         #endif
     }
 
-    return shouldSendDeletedEntities;
+    return shouldSendDeletedEntities || (nodeData && shouldSendCompressionDictionary(nodeData));
 }
 
 // FIXME - most of the old code for this was encapsulated in EntityTree, I liked that design from a data
@@ -157,18 +173,22 @@ bool EntityServer::hasSpecialPacketsToSend(const SharedNodePointer& node) {
 // for now this works and addresses the bug.
 int EntityServer::sendSpecialPackets(const SharedNodePointer& node, OctreeQueryNode* queryNode, int& packetsSent) {
     int totalBytes = 0;
+    packetsSent = 0;
 
     EntityNodeData* nodeData = static_cast<EntityNodeData*>(node->getLinkedData());
-    if (nodeData) {
+    if (nodeData && shouldSendCompressionDictionary(nodeData)) {
+        totalBytes += sendCompressionDictionary(node, nodeData);
+        packetsSent++;
+    }
+
+    EntityTreePointer tree = std::static_pointer_cast<EntityTree>(_tree);
+    if (nodeData && tree->hasEntitiesDeletedSince(nodeData->getLastDeletedEntitiesSentAt(), nodeData->getDeletedEntitiesCursor())) {
 
         quint64 deletedEntitiesSentAt = nodeData->getLastDeletedEntitiesSentAt();
         quint64 considerEntitiesSince = EntityTree::getAdjustedConsiderSince(deletedEntitiesSentAt);
 
         quint64 deletePacketSentAt = usecTimestampNow();
-        EntityTreePointer tree = std::static_pointer_cast<EntityTree>(_tree);
-        auto recentlyDeleted = tree->getRecentlyDeletedEntityIDs();
-
-        packetsSent = 0;
+        const DeletedEntityLog& recentlyDeleted = tree->getDeletedEntityLog();
 
         // create a new special packet
         std::unique_ptr<NLPacket> deletesPacket = NLPacket::create(PacketType::EntityErase);
@@ -190,76 +210,63 @@ int EntityServer::sendSpecialPackets(const SharedNodePointer& node, OctreeQueryN
         qint64 numberOfIDsPos = deletesPacket->pos();
         deletesPacket->writePrimitive(numberOfIDs);
 
-        // we keep a multi map of entity IDs to timestamps, we only want to include the entity IDs that have been
-        // deleted since we last sent to this node
-        auto it = recentlyDeleted.constBegin();
-        while (it != recentlyDeleted.constEnd()) {
-
-            // if the timestamp is more recent then out last sent time, include it
-            if (it.key() > considerEntitiesSince) {
+        // the log is sorted by time, so only the entity IDs deleted since we last sent to this node (or those
+        // appended after the end we saw then) are visited
+        auto cursor = recentlyDeleted.forEachDeletedSince(nodeData->getDeletedEntitiesCursor(), considerEntitiesSince,
+                                                          [&](const DeletedEntityLog::Entry& deleted) {
+            const QUuid& entityID = deleted.entityID;
 
-                // get all the IDs for this timestamp
-                const auto& entityIDsFromTime = recentlyDeleted.values(it.key());
+            // check to make sure we have room for one more ID, if we don't have more
+            // room, then send out this packet and create another one
+            if (NUM_BYTES_RFC4122_UUID > deletesPacket->bytesAvailableForWrite()) {
 
-                for (const auto& entityID : entityIDsFromTime) {
+                // replace the count for the number of included IDs
+                deletesPacket->seek(numberOfIDsPos);
+                deletesPacket->writePrimitive(numberOfIDs);
 
-                    // check to make sure we have room for one more ID, if we don't have more
-                    // room, then send out this packet and create another one
-                    if (NUM_BYTES_RFC4122_UUID > deletesPacket->bytesAvailableForWrite()) {
+                // Send the current packet
+                queryNode->packetSent(*deletesPacket);
+                auto thisPacketSize = deletesPacket->getDataSize();
+                totalBytes += thisPacketSize;
+                packetsSent++;
+                DependencyManager::get<NodeList>()->sendPacket(std::move(deletesPacket), *node);
 
-                        // replace the count for the number of included IDs
-                        deletesPacket->seek(numberOfIDsPos);
-                        deletesPacket->writePrimitive(numberOfIDs);
+                #ifdef EXTRA_ERASE_DEBUGGING
+                    qDebug() << "EntityServer::sendSpecialPackets() sending packet packetsSent[" << packetsSent << "] size:" << thisPacketSize;
+                #endif
 
-                        // Send the current packet
-                        queryNode->packetSent(*deletesPacket);
-                        auto thisPacketSize = deletesPacket->getDataSize();
-                        totalBytes += thisPacketSize;
-                        packetsSent++;
-                        DependencyManager::get<NodeList>()->sendPacket(std::move(deletesPacket), *node);
 
-                        #ifdef EXTRA_ERASE_DEBUGGING
-                            qDebug() << "EntityServer::sendSpecialPackets() sending packet packetsSent[" << packetsSent << "] size:" << thisPacketSize;
-                        #endif
+                // create another packet
+                deletesPacket = NLPacket::create(PacketType::EntityErase);
 
+                // pack in flags
+                deletesPacket->writePrimitive(flags);
 
-                        // create another packet
-                        deletesPacket = NLPacket::create(PacketType::EntityErase);
+                // pack in sequence number
+                sequenceNumber = queryNode->getSequenceNumber();
+                deletesPacket->writePrimitive(sequenceNumber);
 
-                        // pack in flags
-                        deletesPacket->writePrimitive(flags);
-
-                        // pack in sequence number
-                        sequenceNumber = queryNode->getSequenceNumber();
-                        deletesPacket->writePrimitive(sequenceNumber);
-
-                        // pack in timestamp
-                        deletesPacket->writePrimitive(now);
-
-                        // figure out where we are now and pack a temporary number of IDs
-                        numberOfIDs = 0;
-                        numberOfIDsPos = deletesPacket->pos();
-                        deletesPacket->writePrimitive(numberOfIDs);
-                    }
-
-                    // FIXME - we still seem to see cases where incorrect EntityIDs get sent from the server
-                    // to the client. These were causing "lost" entities like flashlights and laser pointers
-                    // now that we keep around some additional history of the erased entities and resend that
-                    // history for a longer time window, these entities are not "lost". But we haven't yet
-                    // found/fixed the underlying issue that caused bad UUIDs to be sent to some users.
-                    deletesPacket->write(entityID.toRfc4122());
-                    ++numberOfIDs;
-
-                    #ifdef EXTRA_ERASE_DEBUGGING
-                        qDebug() << "EntityTree::encodeEntitiesDeletedSince() including:" << entityID;
-                    #endif
-                } // end for (ids)
-
-            } // end if (it.val > sinceLast)
+                // pack in timestamp
+                deletesPacket->writePrimitive(now);
 
+                // figure out where we are now and pack a temporary number of IDs
+                numberOfIDs = 0;
+                numberOfIDsPos = deletesPacket->pos();
+                deletesPacket->writePrimitive(numberOfIDs);
+            }
 
-            ++it;
-        } // end while
+            // FIXME - we still seem to see cases where incorrect EntityIDs get sent from the server
+            // to the client. These were causing "lost" entities like flashlights and laser pointers
+            // now that we keep around some additional history of the erased entities and resend that
+            // history for a longer time window, these entities are not "lost". But we haven't yet
+            // found/fixed the underlying issue that caused bad UUIDs to be sent to some users.
+            deletesPacket->write(entityID.toRfc4122());
+            ++numberOfIDs;
+
+            #ifdef EXTRA_ERASE_DEBUGGING
+                qDebug() << "EntityTree::encodeEntitiesDeletedSince() including:" << entityID;
+            #endif
+        });
 
         // replace the count for the number of included IDs
         deletesPacket->seek(numberOfIDsPos);
@@ -276,6 +283,7 @@ int EntityServer::sendSpecialPackets(const SharedNodePointer& node, OctreeQueryN
         #endif
 
         nodeData->setLastDeletedEntitiesSentAt(deletePacketSentAt);
+        nodeData->setDeletedEntitiesCursor(cursor);
     }
 
     #ifdef EXTRA_ERASE_DEBUGGING
@@ -289,21 +297,107 @@ int EntityServer::sendSpecialPackets(const SharedNodePointer& node, OctreeQueryN
     return totalBytes;
 }
 
+bool EntityServer::shouldSendCompressionDictionary(EntityNodeData* nodeData) const {
+    // only clients that report the dictionary they have in their query know what to do with one
+    auto dictionary = getCompressionDictionary();
+    return dictionary && nodeData->getSentCompressionDictionary() != dictionary &&
+        nodeData->getJSONParameters().contains(COMPRESSION_DICTIONARY_QUERY_PARAMETER);
+}
+
+int EntityServer::sendCompressionDictionary(const SharedNodePointer& node, EntityNodeData* nodeData) {
+    auto dictionary = getCompressionDictionary();
+
+    // the entity data compressed with it only starts once the client says it has it, see OctreeQueryNode
+    auto dictionaryPacketList = NLPacketList::create(PacketType::EntityCompressionDictionary, QByteArray(), true, true);
+    dictionaryPacketList->write(dictionary->getData());
+    nodeData->setSentCompressionDictionary(dictionary);
+
+    return (int)DependencyManager::get<NodeList>()->sendPacketList(std::move(dictionaryPacketList), *node);
+}
+
+void EntityServer::updateCompressionDictionary() {
+    if (_compressionDictionaryTraining.valid()) {
+        if (_compressionDictionaryTraining.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            return;
+        }
+
+        QByteArray data = _compressionDictionaryTraining.get();
+        _numEntitiesAtTraining = _numEntitiesInTraining;
+        if (!data.isEmpty()) {
+            auto dictionary = std::make_shared<const OctreeCompressionDictionary>(data);
+            auto currentDictionary = getCompressionDictionary();
+            if (!currentDictionary || currentDictionary->getID() != dictionary->getID()) {
+                qCDebug(entities) << "Trained a" << data.size() << "byte compression dictionary" << dictionary->getID()
+                    << "on" << _numEntitiesAtTraining << "entities";
+                // registered so that the edits clients compress with it can be uncompressed
+                OctreeCompressionDictionary::add(dictionary);
+                std::atomic_store(&_compressionDictionary, OctreeCompressionDictionaryPointer(dictionary));
+            }
+        }
+        return;
+    }
+
+    const int MIN_ENTITIES_TO_TRAIN_ON = 16;
+    const int MAX_SAMPLES = 4096;
+    const int MAX_SAMPLE_BYTES = 1024 * 1024;
+
+    EntityTreePointer tree = std::static_pointer_cast<EntityTree>(_tree);
+    auto forEachEntity = [&](std::function<void(const EntityItemPointer&)> f) {
+        tree->withReadLock([&] {
+            tree->recurseTreeWithOperation([&](const OctreeElementPointer& element, void*) {
+                std::static_pointer_cast<EntityTreeElement>(element)->forEachEntity(f);
+                return true;
+            });
+        });
+    };
+
+    int numEntities = 0;
+    forEachEntity([&](const EntityItemPointer&) {
+        numEntities++;
+    });
+    bool hasChanged = std::abs(numEntities - _numEntitiesAtTraining) * 4 > _numEntitiesAtTraining;
+    if (numEntities < MIN_ENTITIES_TO_TRAIN_ON || !hasChanged) {
+        return;
+    }
+
+    // the training samples are the entities encoded as they would be sent, less their private user data since the
+    // dictionary goes to every client
+    std::vector<QByteArray> samples;
+    int numSampleBytes = 0;
+    OctreePacketData packetData(false);
+    forEachEntity([&](const EntityItemPointer& entity) {
+        if ((int)samples.size() < MAX_SAMPLES && numSampleBytes < MAX_SAMPLE_BYTES) {
+            EncodeBitstreamParams params;
+            packetData.reset();
+            entity->appendEntityData(&packetData, params, nullptr);
+            samples.emplace_back((const char*)packetData.getUncompressedData(), packetData.getUncompressedSize());
+            numSampleBytes += packetData.getUncompressedSize();
+        }
+    });
+
+    _numEntitiesInTraining = numEntities;
+    _compressionDictionaryTraining = std::async(std::launch::async, [samples = std::move(samples)] {
+        return OctreeCompressionDictionary::train(samples);
+    });
+}
+
 void EntityServer::pruneDeletedEntities() {
     EntityTreePointer tree = std::static_pointer_cast<EntityTree>(_tree);
     if (tree->hasAnyDeletedEntities()) {
 
         quint64 earliestLastDeletedEntitiesSent = usecTimestampNow() + 1; // in the future
-        DependencyManager::get<NodeList>()->eachNode([&earliestLastDeletedEntitiesSent](const SharedNodePointer& node) {
+        DeletedEntityLog::Sequence earliestDeletedEntitiesCursor = DeletedEntityLog::NO_CURSOR;
+        DependencyManager::get<NodeList>()->eachNode([&](const SharedNodePointer& node) {
             if (node->getLinkedData()) {
                 EntityNodeData* nodeData = static_cast<EntityNodeData*>(node->getLinkedData());
                 quint64 nodeLastDeletedEntitiesSentAt = nodeData->getLastDeletedEntitiesSentAt();
                 if (nodeLastDeletedEntitiesSentAt < earliestLastDeletedEntitiesSent) {
                     earliestLastDeletedEntitiesSent = nodeLastDeletedEntitiesSentAt;
                 }
+                earliestDeletedEntitiesCursor = std::min(earliestDeletedEntitiesCursor, nodeData->getDeletedEntitiesCursor());
             }
         });
-        tree->forgetEntitiesDeletedBefore(earliestLastDeletedEntitiesSent);
+        tree->forgetEntitiesDeletedBefore(earliestLastDeletedEntitiesSent, earliestDeletedEntitiesCursor);
     }
 }
 
@@ -417,6 +511,50 @@ QString EntityServer::serverSubclassStats() {
     statsString += QString().asprintf("       EntityItem size... %ld bytes\r\n", sizeof(EntityItem));
     statsString += "\r\n\r\n";
 
+    if (_entitySimulation) {
+        const auto& updateStats = _entitySimulation->getUpdateStats();
+        statsString += "<b>Entity Server Simulation Statistics</b>\r\n";
+        statsString += QString().asprintf("       Average expire time:    %9.2f usecs\r\n",
+                                         (double)updateStats.expireTime.getAverage());
+        statsString += QString().asprintf("       Average update time:    %9.2f usecs\r\n",
+                                         (double)updateStats.updateTime.getAverage());
+        statsString += QString().asprintf("         Average move time:    %9.2f usecs (%.1f entities in %.1f batches)\r\n",
+                                         (double)updateStats.moveTime.getAverage(), (double)updateStats.numMoved.getAverage(),
+                                         (double)updateStats.numMoveBatches.getAverage());
+        statsString += QString().asprintf("         Average sort time:    %9.2f usecs\r\n",
+                                         (double)updateStats.sortTime.getAverage());
+        statsString += QString().asprintf("  Average delete dead time:    %9.2f usecs\r\n",
+                                         (double)updateStats.deadTime.getAverage());
+        statsString += QString().asprintf("   Average simulation tick:    %9.2f usecs\r\n",
+                                         (double)updateStats.totalTime.getAverage());
+        statsString += "\r\n\r\n";
+    }
+
+    {
+        quint64 compressCalls = OctreePacketData::getCompressContentCalls();
+        quint64 bytesIn = OctreePacketData::getCompressContentBytesIn();
+        quint64 bytesOut = OctreePacketData::getCompressContentBytesOut();
+        auto dictionary = getCompressionDictionary();
+        statsString += "<b>Entity Server Compression Statistics</b>\r\n";
+        statsString += QString().asprintf("     Compression dictionary:    %s\r\n", dictionary ?
+            qPrintable(QString("%1 (%2 bytes)").arg(dictionary->getID()).arg(dictionary->getData().size())) : "none");
+        statsString += QString().asprintf("       EntityData sections:    %9llu (%llu with the dictionary)\r\n",
+                                         (unsigned long long)compressCalls,
+                                         (unsigned long long)OctreePacketData::getDictionaryCompressContentCalls());
+        statsString += QString().asprintf("    EntityData compression:    %9.2f : 1\r\n",
+                                         bytesOut == 0 ? 0.0 : (double)bytesIn / bytesOut);
+        statsString += QString().asprintf("  Average compression time:    %9.2f usecs per section\r\n",
+                                         compressCalls == 0 ? 0.0 : (double)OctreePacketData::getCompressContentTime() / compressCalls);
+        quint64 compressedEdits = EntityItemProperties::getCompressedEditMessages();
+        quint64 compressedEditBytes = EntityItemProperties::getCompressedEditBytes();
+        statsString += QString().asprintf("    Adds and edits decoded:    %9llu (%llu compressed)\r\n",
+                                         (unsigned long long)EntityItemProperties::getDecodedEditMessages(),
+                                         (unsigned long long)compressedEdits);
+        statsString += QString().asprintf("    EntityEdit compression:    %9.2f : 1\r\n", compressedEditBytes == 0 ? 0.0 :
+                                         (double)EntityItemProperties::getUncompressedEditBytes() / compressedEditBytes);
+        statsString += "\r\n\r\n";
+    }
+
     statsString += "<b>Entity Server Sending to Viewer Statistics</b>\r\n";
     statsString += "----- Viewer Node ID -----------------    ----- Entity ID ----------------------    "
                    "---------- Last Sent To ----------    ---------- Last Edited -----------\r\n";
@@ -14,14 +14,18 @@
 
 #include "../octree/OctreeServer.h"
 
+#include <future>
 #include <memory>
 
 #include <EntityItem.h>
 #include <EntityTree.h>
+#include <OctreeCompressionDictionary.h>
 #include <SimpleEntitySimulation.h>
 
 #include "EntityServerConsts.h"
 
+class EntityNodeData;
+
 /// Handles assignments of type EntityServer - sending entities to various clients.
 
 struct ViewerSendingStats {
@@ -63,6 +67,7 @@ public slots:
     virtual void nodeAdded(SharedNodePointer node) override;
     virtual void nodeKilled(SharedNodePointer node) override;
     void pruneDeletedEntities();
+    void updateCompressionDictionary();
     void entityFilterAdded(EntityItemID id, bool success);
 
 protected:
@@ -74,9 +79,21 @@ private slots:
     void domainSettingsRequestFailed();
 
 private:
+    OctreeCompressionDictionaryPointer getCompressionDictionary() const { return std::atomic_load(&_compressionDictionary); }
+    bool shouldSendCompressionDictionary(EntityNodeData* nodeData) const;
+    int sendCompressionDictionary(const SharedNodePointer& node, EntityNodeData* nodeData);
+
     SimpleEntitySimulationPointer _entitySimulation;
     QTimer* _pruneDeletedEntitiesTimer = nullptr;
 
+    // the dictionary entity data is compressed with for the clients that have it, trained in the background on a
+    // sample of the entities in the tree and retrained when the number of entities changes by more than a quarter
+    QTimer* _compressionDictionaryTimer = nullptr;
+    std::future<QByteArray> _compressionDictionaryTraining;
+    OctreeCompressionDictionaryPointer _compressionDictionary;
+    int _numEntitiesAtTraining { 0 };
+    int _numEntitiesInTraining { 0 };
+
     QReadWriteLock _viewerSendingStatsLock;
     QMap<QUuid, QMap<QUuid, ViewerSendingStats>> _viewerSendingStats;
 
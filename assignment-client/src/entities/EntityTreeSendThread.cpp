@@ -32,6 +32,7 @@ void EntityTreeSendThread::resetState() {
     qCDebug(entities) << "Clearing known EntityTreeSendThread state for" << _nodeUuid;
 
     _knownState.clear();
+    _extraEncodeData->voxelBricksSent.clear();
     _traversal.reset();
 }
 
@@ -241,6 +242,7 @@ void EntityTreeSendThread::startNewTraversal(const DiffTraversal::View& view, En
         case DiffTraversal::First:
             // When we get to a First traversal, clear the _knownState
             _knownState.clear();
+            _extraEncodeData->voxelBricksSent.clear();
             _traversal.setScanCallback([this](DiffTraversal::VisibleElement& next) {
                 next.element->forEachEntity([&](EntityItemPointer entity) {
                     // Bail early if we've already checked this entity this frame
@@ -391,6 +393,15 @@ bool EntityTreeSendThread::traverseTreeAndBuildNextPacketPayload(EncodeBitstream
                     entityNodeData->removeSentFilteredEntity(entityID);
                 }
                 ++_numEntities;
+
+                // for an entity this client already knew, track how long the server sat on the latest change to it
+                auto knownTimestamp = _knownState.find(entity.get());
+                if (knownTimestamp != _knownState.end()) {
+                    quint64 lastChangedOnServer = entity->getLastChangedOnServer();
+                    if (lastChangedOnServer > knownTimestamp->second && lastChangedOnServer < sendTime) {
+                        OctreeServer::trackEditToBroadcastTime((float)(sendTime - lastChangedOnServer));
+                    }
+                }
             }
             if (queuedItem.shouldForceRemove()) {
                 _knownState.erase(entity.get());
@@ -436,4 +447,5 @@ void EntityTreeSendThread::editingEntityPointer(const EntityItemPointer& entity)
 
 void EntityTreeSendThread::deletingEntityPointer(EntityItem* entity) {
     _knownState.erase(entity);
+    _extraEncodeData->voxelBricksSent.erase(entity);
 }
@@ -14,9 +14,14 @@
 #include <QtCore/QCoreApplication>
 #include <QtCore/QJsonObject>
 #include <QBuffer>
+
+#include <algorithm>
+
 #include <LogHandler.h>
 #include <MessagesClient.h>
 #include <NodeList.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
 #include <udt/PacketHeaders.h>
 
 const QString MESSAGES_MIXER_LOGGING_NAME = "messages-mixer";
@@ -30,10 +35,32 @@ MessagesMixer::MessagesMixer(ReceivedMessage& message) : ThreadedAssignment(mess
     packetReceiver.registerListener(PacketType::MessagesUnsubscribe, this, "handleMessagesUnsubscribe");
 }
 
+MessagesMixer::~MessagesMixer() {
+    stopSending();
+}
+
+void MessagesMixer::aboutToFinish() {
+    stopSending();
+    ThreadedAssignment::aboutToFinish();
+}
+
 void MessagesMixer::nodeKilled(SharedNodePointer killedNode) {
-    for (auto& channel : _channelSubscribers) {
-        channel.remove(killedNode->getUUID());
+    auto nodeChannels = _nodeChannels.find(killedNode->getUUID());
+    if (nodeChannels == _nodeChannels.end()) {
+        return;
+    }
+
+    for (auto& channel : *nodeChannels) {
+        auto subscribers = _channelSubscribers.find(channel);
+        if (subscribers != _channelSubscribers.end()) {
+            auto& nodes = subscribers.value();
+            nodes.erase(std::remove(nodes.begin(), nodes.end(), killedNode), nodes.end());
+            if (nodes.empty()) {
+                _channelSubscribers.erase(subscribers);
+            }
+        }
     }
+    _nodeChannels.erase(nodeChannels);
 }
 
 void MessagesMixer::handleMessages(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode) {
@@ -43,28 +70,103 @@ void MessagesMixer::handleMessages(QSharedPointer<ReceivedMessage> receivedMessa
     bool isText;
     MessagesClient::decodeMessagesPacket(receivedMessage, channel, isText, message, data, senderID);
 
+    _numMessagesReceived++;
+    auto& channelStats = _channelStats[channel];
+    channelStats.numMessages++;
+
+    auto subscribers = _channelSubscribers.constFind(channel);
+    if (subscribers == _channelSubscribers.constEnd()) {
+        return;
+    }
+
+    OutboundMessage outboundMessage;
+    outboundMessage.recipients.reserve(subscribers->size());
+    for (auto& node : *subscribers) {
+        if (node->getActiveSocket()) {
+            outboundMessage.recipients.push_back(node);
+        }
+    }
+    if (outboundMessage.recipients.empty()) {
+        return;
+    }
+
+    outboundMessage.payload = MessagesClient::encodeMessagesPayload(channel, isText, isText ? message.toUtf8() : data, senderID);
+    channelStats.numRecipients += (int)outboundMessage.recipients.size();
+    _numMessagesSent += (int)outboundMessage.recipients.size();
+
+    {
+        std::lock_guard<std::mutex> lock(_outboundMutex);
+        _outboundMessages.push_back(std::move(outboundMessage));
+    }
+    _outboundCondition.notify_one();
+}
+
+void MessagesMixer::sendOutboundMessages() {
     auto nodeList = DependencyManager::get<NodeList>();
+    std::vector<OutboundMessage> batch;
 
-    nodeList->eachMatchingNode(
-        [&](const SharedNodePointer& node)->bool {
-        return node->getActiveSocket() && _channelSubscribers[channel].contains(node->getUUID());
-    },
-        [&](const SharedNodePointer& node) {
-        auto packetList = isText ? MessagesClient::encodeMessagesPacket(channel, message, senderID) :
-                                   MessagesClient::encodeMessagesDataPacket(channel, data, senderID);
-        nodeList->sendPacketList(std::move(packetList), *node);
-    });
+    std::unique_lock<std::mutex> lock(_outboundMutex);
+    while (_isSending) {
+        _outboundCondition.wait(lock, [&] { return !_isSending || !_outboundMessages.empty(); });
+
+        // take whatever came in meanwhile and send it all in one go
+        batch.swap(_outboundMessages);
+        lock.unlock();
+
+        for (auto& outboundMessage : batch) {
+            // the payload is encoded once, but every recipient still gets its own copy of it in its own packet list,
+            // since a reliable connection takes ownership of the packets it sends and stamps its own sequence
+            // numbers into them
+            for (auto& node : outboundMessage.recipients) {
+                auto packetList = NLPacketList::create(PacketType::MessagesData, QByteArray(), true, true);
+                packetList->write(outboundMessage.payload);
+                nodeList->sendPacketList(std::move(packetList), *node);
+            }
+        }
+        if (!batch.empty()) {
+            _numSendBatches++;
+        }
+        batch.clear();
+
+        lock.lock();
+    }
+}
+
+void MessagesMixer::stopSending() {
+    {
+        std::lock_guard<std::mutex> lock(_outboundMutex);
+        _isSending = false;
+    }
+    _outboundCondition.notify_one();
+
+    if (_sendThread.joinable()) {
+        _sendThread.join();
+    }
 }
 
 void MessagesMixer::handleMessagesSubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
     QString channel = QString::fromUtf8(message->getMessage());
-    _channelSubscribers[channel] << senderNode->getUUID();
+    auto& nodeChannels = _nodeChannels[senderNode->getUUID()];
+    if (!nodeChannels.contains(channel)) {
+        nodeChannels << channel;
+        _channelSubscribers[channel].push_back(senderNode);
+    }
 }
 
 void MessagesMixer::handleMessagesUnsubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
     QString channel = QString::fromUtf8(message->getMessage());
-    if (_channelSubscribers.contains(channel)) {
-        _channelSubscribers[channel].remove(senderNode->getUUID());
+    auto nodeChannels = _nodeChannels.find(senderNode->getUUID());
+    if (nodeChannels == _nodeChannels.end() || !nodeChannels->remove(channel)) {
+        return;
+    }
+
+    auto subscribers = _channelSubscribers.find(channel);
+    if (subscribers != _channelSubscribers.end()) {
+        auto& nodes = subscribers.value();
+        nodes.erase(std::remove(nodes.begin(), nodes.end(), senderNode), nodes.end());
+        if (nodes.empty()) {
+            _channelSubscribers.erase(subscribers);
+        }
     }
 }
 
@@ -81,6 +183,36 @@ void MessagesMixer::sendStatsPacket() {
     });
 
     statsObject["messages"] = messagesMixerObject;
+
+    quint64 now = usecTimestampNow();
+    float secondsSinceLastStats = _lastStatsTime > 0 ? (float)(now - _lastStatsTime) / USECS_PER_SECOND : 0.0f;
+    _lastStatsTime = now;
+    auto perSecond = [&](int count) { return secondsSinceLastStats > 0.0f ? count / secondsSinceLastStats : 0.0f; };
+
+    // fan-out of every channel with subscribers or traffic
+    QJsonObject channelsObject;
+    for (auto it = _channelSubscribers.constBegin(); it != _channelSubscribers.constEnd(); ++it) {
+        _channelStats[it.key()];
+    }
+    for (auto it = _channelStats.constBegin(); it != _channelStats.constEnd(); ++it) {
+        const auto& channelStats = it.value();
+        QJsonObject channelObject;
+        channelObject["subscribers"] = (int)_channelSubscribers.value(it.key()).size();
+        channelObject["messages_per_second"] = perSecond(channelStats.numMessages);
+        channelObject["average_fan_out"] = channelStats.numMessages > 0 ?
+            (float)channelStats.numRecipients / channelStats.numMessages : 0.0f;
+        channelsObject[it.key()] = channelObject;
+    }
+    statsObject["channels"] = channelsObject;
+
+    statsObject["messages_received_per_second"] = perSecond(_numMessagesReceived);
+    statsObject["messages_sent_per_second"] = perSecond(_numMessagesSent);
+    statsObject["send_batches_per_second"] = perSecond(_numSendBatches.exchange(0));
+
+    _channelStats.clear();
+    _numMessagesReceived = 0;
+    _numMessagesSent = 0;
+
     ThreadedAssignment::addPacketStatsAndSendStatsPacket(statsObject);
 }
 
@@ -88,4 +220,8 @@ void MessagesMixer::run() {
     ThreadedAssignment::commonInit(MESSAGES_MIXER_LOGGING_NAME, NodeType::MessagesMixer);
     auto nodeList = DependencyManager::get<NodeList>();
     nodeList->addSetOfNodeTypesToNodeInterestSet({ NodeType::Agent, NodeType::EntityScriptServer });
+
+    // fan messages out from a thread of our own, so that a busy channel doesn't hold up receiving
+    _isSending = true;
+    _sendThread = std::thread(&MessagesMixer::sendOutboundMessages, this);
 }
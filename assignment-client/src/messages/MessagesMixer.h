@@ -15,6 +15,12 @@
 #ifndef hifi_MessagesMixer_h
 #define hifi_MessagesMixer_h
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 #include <ThreadedAssignment.h>
 
 /// Handles assignments of type MessagesMixer - distribution of avatar data to various clients
@@ -22,6 +28,9 @@ class MessagesMixer : public ThreadedAssignment {
     Q_OBJECT
 public:
     MessagesMixer(ReceivedMessage& message);
+    ~MessagesMixer();
+
+    void aboutToFinish() override;
 
 public slots:
     void run() override;
@@ -34,7 +43,36 @@ private slots:
     void handleMessagesUnsubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
 
 private:
-    QHash<QString,QSet<QUuid>> _channelSubscribers;
+    // a message on its way out: the payload is encoded once and copied into a packet list for each recipient
+    struct OutboundMessage {
+        QByteArray payload;
+        std::vector<SharedNodePointer> recipients;
+    };
+
+    struct ChannelStats {
+        int numMessages { 0 };
+        int numRecipients { 0 };
+    };
+
+    void sendOutboundMessages(); // runs on _sendThread
+    void stopSending();
+
+    // subscribers of each channel, with the channels of each node so a leaving node is quick to drop
+    QHash<QString, std::vector<SharedNodePointer>> _channelSubscribers;
+    QHash<QUuid, QSet<QString>> _nodeChannels;
+
+    std::thread _sendThread;
+    std::mutex _outboundMutex;
+    std::condition_variable _outboundCondition;
+    std::vector<OutboundMessage> _outboundMessages;
+    bool _isSending { false };
+
+    // since the last stats packet
+    QHash<QString, ChannelStats> _channelStats;
+    int _numMessagesReceived { 0 };
+    int _numMessagesSent { 0 };
+    std::atomic<int> _numSendBatches { 0 };
+    quint64 _lastStatsTime { 0 };
 };
 
 #endif // hifi_MessagesMixer_h
@@ -29,6 +29,7 @@ OctreeInboundPacketProcessor::OctreeInboundPacketProcessor(OctreeServer* myServe
     _totalTransitTime(0),
     _totalProcessTime(0),
     _totalLockWaitTime(0),
+    _totalLockHoldTime(0),
     _totalElementsInPacket(0),
     _totalPackets(0),
     _lastNackTime(usecTimestampNow()),
@@ -40,6 +41,7 @@ void OctreeInboundPacketProcessor::resetStats() {
     _totalTransitTime = 0;
     _totalProcessTime = 0;
     _totalLockWaitTime = 0;
+    _totalLockHoldTime = 0;
     _totalElementsInPacket = 0;
     _totalPackets = 0;
     _lastNackTime = usecTimestampNow();
@@ -128,6 +130,7 @@ void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage>
         int editsInPacket = 0;
         quint64 processTime = 0;
         quint64 lockWaitTime = 0;
+        quint64 lockHoldTime = 0;
 
         if (debugProcessPacket || _myServer->wantsDebugReceiving()) {
             qDebug() << "PROCESSING THREAD: got '" << packetType << "' packet - " << _receivedPacketCount << " command from client";
@@ -170,13 +173,10 @@ void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage>
                         message->getPosition(), maxSize);
             }
 
-            quint64 startProcess, startLock = usecTimestampNow();
-            int editDataBytesRead;
-            _myServer->getOctree()->withWriteLock([&] {
-                startProcess = usecTimestampNow();
-                editDataBytesRead =
-                    _myServer->getOctree()->processEditPacketData(*message, editData, maxSize, sendingNode);
-            });
+            quint64 startProcess = usecTimestampNow();
+            Octree::EditLockTimes lockTimes;
+            int editDataBytesRead =
+                _myServer->getOctree()->lockAndProcessEditPacketData(*message, editData, maxSize, sendingNode, lockTimes);
             quint64 endProcess = usecTimestampNow();
 
             if (debugProcessPacket) {
@@ -185,10 +185,10 @@ void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage>
             }
 
             editsInPacket++;
-            quint64 thisProcessTime = endProcess - startProcess;
-            quint64 thisLockWaitTime = startProcess - startLock;
-            processTime += thisProcessTime;
-            lockWaitTime += thisLockWaitTime;
+            // process time doesn't count the wait for the tree lock, as before
+            processTime += endProcess - startProcess - lockTimes.waitTime;
+            lockWaitTime += lockTimes.waitTime;
+            lockHoldTime += lockTimes.holdTime;
 
             // skip to next edit record in the packet
             message->seek(message->getPosition() + editDataBytesRead);
@@ -219,18 +219,19 @@ void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage>
                 qDebug() << "sender has no known nodeUUID.";
             }
         }
-        trackInboundPacket(nodeUUID, sequence, transitTime, editsInPacket, processTime, lockWaitTime);
+        trackInboundPacket(nodeUUID, sequence, transitTime, editsInPacket, processTime, lockWaitTime, lockHoldTime);
     } else {
         qDebug("unknown packet ignored... packetType=%hhu", (unsigned char)packetType);
     }
 }
 
 void OctreeInboundPacketProcessor::trackInboundPacket(const QUuid& nodeUUID, unsigned short int sequence, quint64 transitTime,
-            int editsInPacket, quint64 processTime, quint64 lockWaitTime) {
+            int editsInPacket, quint64 processTime, quint64 lockWaitTime, quint64 lockHoldTime) {
 
     _totalTransitTime += transitTime;
     _totalProcessTime += processTime;
     _totalLockWaitTime += lockWaitTime;
+    _totalLockHoldTime += lockHoldTime;
     _totalElementsInPacket += editsInPacket;
     _totalPackets++;
 
@@ -240,11 +241,11 @@ void OctreeInboundPacketProcessor::trackInboundPacket(const QUuid& nodeUUID, uns
     // see if this is the first we've heard of this node...
     if (_singleSenderStats.find(nodeUUID) == _singleSenderStats.end()) {
         SingleSenderStats stats;
-        stats.trackInboundPacket(sequence, transitTime, editsInPacket, processTime, lockWaitTime);
+        stats.trackInboundPacket(sequence, transitTime, editsInPacket, processTime, lockWaitTime, lockHoldTime);
         _singleSenderStats[nodeUUID] = stats;
     } else {
         SingleSenderStats& stats = _singleSenderStats[nodeUUID];
-        stats.trackInboundPacket(sequence, transitTime, editsInPacket, processTime, lockWaitTime);
+        stats.trackInboundPacket(sequence, transitTime, editsInPacket, processTime, lockWaitTime, lockHoldTime);
     }
 }
 
@@ -326,6 +327,7 @@ SingleSenderStats::SingleSenderStats()
     : _totalTransitTime(0),
     _totalProcessTime(0),
     _totalLockWaitTime(0),
+    _totalLockHoldTime(0),
     _totalElementsInPacket(0),
     _totalPackets(0),
     _incomingEditSequenceNumberStats()
@@ -334,7 +336,7 @@ SingleSenderStats::SingleSenderStats()
 }
 
 void SingleSenderStats::trackInboundPacket(unsigned short int incomingSequence, quint64 transitTime,
-    int editsInPacket, quint64 processTime, quint64 lockWaitTime) {
+    int editsInPacket, quint64 processTime, quint64 lockWaitTime, quint64 lockHoldTime) {
 
     // track sequence number
     _incomingEditSequenceNumberStats.sequenceNumberReceived(incomingSequence);
@@ -343,6 +345,7 @@ void SingleSenderStats::trackInboundPacket(unsigned short int incomingSequence,
     _totalTransitTime += transitTime;
     _totalProcessTime += processTime;
     _totalLockWaitTime += lockWaitTime;
+    _totalLockHoldTime += lockHoldTime;
     _totalElementsInPacket += editsInPacket;
     _totalPackets++;
 }
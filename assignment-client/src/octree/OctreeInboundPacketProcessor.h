@@ -27,22 +27,26 @@ public:
     quint64 getAverageTransitTimePerPacket() const { return _totalPackets == 0 ? 0 : _totalTransitTime / _totalPackets; }
     quint64 getAverageProcessTimePerPacket() const { return _totalPackets == 0 ? 0 : _totalProcessTime / _totalPackets; }
     quint64 getAverageLockWaitTimePerPacket() const { return _totalPackets == 0 ? 0 : _totalLockWaitTime / _totalPackets; }
+    quint64 getAverageLockHoldTimePerPacket() const { return _totalPackets == 0 ? 0 : _totalLockHoldTime / _totalPackets; }
     quint64 getTotalElementsProcessed() const { return _totalElementsInPacket; }
     quint64 getTotalPacketsProcessed() const { return _totalPackets; }
     quint64 getAverageProcessTimePerElement() const
                 { return _totalElementsInPacket == 0 ? 0 : _totalProcessTime / _totalElementsInPacket; }
     quint64 getAverageLockWaitTimePerElement() const
                 { return _totalElementsInPacket == 0 ? 0 : _totalLockWaitTime / _totalElementsInPacket; }
+    quint64 getAverageLockHoldTimePerElement() const
+                { return _totalElementsInPacket == 0 ? 0 : _totalLockHoldTime / _totalElementsInPacket; }
     
     const SequenceNumberStats& getIncomingEditSequenceNumberStats() const { return _incomingEditSequenceNumberStats; }
     SequenceNumberStats& getIncomingEditSequenceNumberStats() { return _incomingEditSequenceNumberStats; }
 
     void trackInboundPacket(unsigned short int incomingSequence, quint64 transitTime,
-        int editsInPacket, quint64 processTime, quint64 lockWaitTime);
+        int editsInPacket, quint64 processTime, quint64 lockWaitTime, quint64 lockHoldTime);
 
     quint64 _totalTransitTime;
     quint64 _totalProcessTime;
     quint64 _totalLockWaitTime;
+    quint64 _totalLockHoldTime;
     quint64 _totalElementsInPacket;
     quint64 _totalPackets;
     SequenceNumberStats _incomingEditSequenceNumberStats;
@@ -63,12 +67,15 @@ public:
     quint64 getAverageTransitTimePerPacket() const { return _totalPackets == 0 ? 0 : _totalTransitTime / _totalPackets; }
     quint64 getAverageProcessTimePerPacket() const { return _totalPackets == 0 ? 0 : _totalProcessTime / _totalPackets; }
     quint64 getAverageLockWaitTimePerPacket() const { return _totalPackets == 0 ? 0 : _totalLockWaitTime / _totalPackets; }
+    quint64 getAverageLockHoldTimePerPacket() const { return _totalPackets == 0 ? 0 : _totalLockHoldTime / _totalPackets; }
     quint64 getTotalElementsProcessed() const { return _totalElementsInPacket; }
     quint64 getTotalPacketsProcessed() const { return _totalPackets; }
     quint64 getAverageProcessTimePerElement() const
                 { return _totalElementsInPacket == 0 ? 0 : _totalProcessTime / _totalElementsInPacket; }
     quint64 getAverageLockWaitTimePerElement() const
                 { return _totalElementsInPacket == 0 ? 0 : _totalLockWaitTime / _totalElementsInPacket; }
+    quint64 getAverageLockHoldTimePerElement() const
+                { return _totalElementsInPacket == 0 ? 0 : _totalLockHoldTime / _totalElementsInPacket; }
 
     void resetStats();
 
@@ -89,7 +96,7 @@ private:
 
 private:
     void trackInboundPacket(const QUuid& nodeUUID, unsigned short int sequence, quint64 transitTime,
-            int elementsInPacket, quint64 processTime, quint64 lockWaitTime);
+            int elementsInPacket, quint64 processTime, quint64 lockWaitTime, quint64 lockHoldTime);
 
     OctreeServer* _myServer;
     int _receivedPacketCount;
@@ -97,6 +104,7 @@ private:
     std::atomic<uint64_t> _totalTransitTime;
     std::atomic<uint64_t> _totalProcessTime;
     std::atomic<uint64_t> _totalLockWaitTime;
+    std::atomic<uint64_t> _totalLockHoldTime;
     std::atomic<uint64_t> _totalElementsInPacket;
     std::atomic<uint64_t> _totalPackets;
     
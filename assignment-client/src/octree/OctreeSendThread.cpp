@@ -337,6 +337,7 @@ int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode*
     targetSize = nodeData->getAvailable() - sizeof(OCTREE_PACKET_INTERNAL_SECTION_SIZE);
 
     _packetData.changeSettings(true, targetSize); // FIXME - eventually support only compressed packets
+    _packetData.setCompressionDictionary(nodeData->updateCompressionDictionary());
 
     // If the current view frustum has changed OR we have nothing to send, then search against
     // the current view frustum for things to send.
@@ -439,6 +440,8 @@ bool OctreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, Octre
         _myServer->trackSend(dataID, dataEdited, _nodeUuid);
     };
 
+    auto jsonFilters = nodeData->getJSONFilters();
+
     bool somethingToSend = true; // assume we have something
     bool hadSomething = hasSomethingToSend(nodeData);
     while (somethingToSend && _packetsSentThisInterval < maxPacketsPerInterval && !nodeData->isShuttingDown()) {
@@ -450,7 +453,7 @@ bool OctreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, Octre
         bool lastNodeDidntFit = false; // assume each node fits
         params.stopReason = EncodeBitstreamParams::UNKNOWN; // reset params.stopReason before traversal
 
-        somethingToSend = traverseTreeAndBuildNextPacketPayload(params, nodeData->getJSONParameters());
+        somethingToSend = traverseTreeAndBuildNextPacketPayload(params, jsonFilters);
 
         if (params.stopReason == EncodeBitstreamParams::DIDNT_FIT) {
             lastNodeDidntFit = true;
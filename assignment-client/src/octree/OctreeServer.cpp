@@ -65,6 +65,8 @@ int OctreeServer::_noTreeWait = 0;
 
 SimpleMovingAverage OctreeServer::_averageTreeTraverseTime(MOVING_AVERAGE_SAMPLE_COUNTS);
 
+SimpleMovingAverage OctreeServer::_averageEditToBroadcastTime(MOVING_AVERAGE_SAMPLE_COUNTS);
+
 SimpleMovingAverage OctreeServer::_averageNodeWaitTime(MOVING_AVERAGE_SAMPLE_COUNTS);
 
 SimpleMovingAverage OctreeServer::_averageCompressAndWriteTime(MOVING_AVERAGE_SAMPLE_COUNTS);
@@ -115,6 +117,8 @@ void OctreeServer::resetSendingStats() {
 
     _averageTreeTraverseTime.reset();
 
+    _averageEditToBroadcastTime.reset();
+
     _averageNodeWaitTime.reset();
 
     _averageCompressAndWriteTime.reset();
@@ -518,6 +522,11 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
         float averageTreeTraverseTime = getAverageTreeTraverseTime();
         statsString += QString().asprintf("          Average tree traverse time:    %9.2f usecs\r\n\r\n", (double)averageTreeTraverseTime);
 
+        // edit to broadcast
+        float averageEditToBroadcastTime = getAverageEditToBroadcastTime();
+        statsString += QString().asprintf("          Average edit to broadcast time: %9.2f usecs\r\n\r\n",
+                                         (double)averageEditToBroadcastTime);
+
         // encode
         float averageEncodeTime = getAverageEncodeTime();
         statsString += QString().asprintf("                 Average encode time:    %9.2f usecs\r\n", (double)averageEncodeTime);
@@ -651,8 +660,10 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
         quint64 averageTransitTimePerPacket = _octreeInboundPacketProcessor->getAverageTransitTimePerPacket();
         quint64 averageProcessTimePerPacket = _octreeInboundPacketProcessor->getAverageProcessTimePerPacket();
         quint64 averageLockWaitTimePerPacket = _octreeInboundPacketProcessor->getAverageLockWaitTimePerPacket();
+        quint64 averageLockHoldTimePerPacket = _octreeInboundPacketProcessor->getAverageLockHoldTimePerPacket();
         quint64 averageProcessTimePerElement = _octreeInboundPacketProcessor->getAverageProcessTimePerElement();
         quint64 averageLockWaitTimePerElement = _octreeInboundPacketProcessor->getAverageLockWaitTimePerElement();
+        quint64 averageLockHoldTimePerElement = _octreeInboundPacketProcessor->getAverageLockHoldTimePerElement();
         quint64 totalElementsProcessed = _octreeInboundPacketProcessor->getTotalElementsProcessed();
         quint64 totalPacketsProcessed = _octreeInboundPacketProcessor->getTotalPacketsProcessed();
 
@@ -686,10 +697,14 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
             .arg(locale.toString((uint)averageProcessTimePerPacket).rightJustified(COLUMN_WIDTH, ' '));
         statsString += QString("   Average Wait Lock Time/Packet: %1 usecs\r\n")
             .arg(locale.toString((uint)averageLockWaitTimePerPacket).rightJustified(COLUMN_WIDTH, ' '));
+        statsString += QString("   Average Hold Lock Time/Packet: %1 usecs\r\n")
+            .arg(locale.toString((uint)averageLockHoldTimePerPacket).rightJustified(COLUMN_WIDTH, ' '));
         statsString += QString("    Average Process Time/Element: %1 usecs\r\n")
             .arg(locale.toString((uint)averageProcessTimePerElement).rightJustified(COLUMN_WIDTH, ' '));
         statsString += QString("  Average Wait Lock Time/Element: %1 usecs\r\n")
             .arg(locale.toString((uint)averageLockWaitTimePerElement).rightJustified(COLUMN_WIDTH, ' '));
+        statsString += QString("  Average Hold Lock Time/Element: %1 usecs\r\n")
+            .arg(locale.toString((uint)averageLockHoldTimePerElement).rightJustified(COLUMN_WIDTH, ' '));
 
         statsString += QString("             Average Decode Time: %1 usecs\r\n")
             .arg(locale.toString((uint)averageDecodeTime).rightJustified(COLUMN_WIDTH, ' '));
@@ -718,8 +733,10 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
             averageTransitTimePerPacket = senderStats.getAverageTransitTimePerPacket();
             averageProcessTimePerPacket = senderStats.getAverageProcessTimePerPacket();
             averageLockWaitTimePerPacket = senderStats.getAverageLockWaitTimePerPacket();
+            averageLockHoldTimePerPacket = senderStats.getAverageLockHoldTimePerPacket();
             averageProcessTimePerElement = senderStats.getAverageProcessTimePerElement();
             averageLockWaitTimePerElement = senderStats.getAverageLockWaitTimePerElement();
+            averageLockHoldTimePerElement = senderStats.getAverageLockHoldTimePerElement();
             totalElementsProcessed = senderStats.getTotalElementsProcessed();
             totalPacketsProcessed = senderStats.getTotalPacketsProcessed();
 
@@ -747,10 +764,14 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
                 .arg(locale.toString((uint)averageProcessTimePerPacket).rightJustified(COLUMN_WIDTH, ' '));
             statsString += QString("       Average Wait Lock Time/Packet: %1 usecs\r\n")
                 .arg(locale.toString((uint)averageLockWaitTimePerPacket).rightJustified(COLUMN_WIDTH, ' '));
+            statsString += QString("       Average Hold Lock Time/Packet: %1 usecs\r\n")
+                .arg(locale.toString((uint)averageLockHoldTimePerPacket).rightJustified(COLUMN_WIDTH, ' '));
             statsString += QString("        Average Process Time/Element: %1 usecs\r\n")
                 .arg(locale.toString((uint)averageProcessTimePerElement).rightJustified(COLUMN_WIDTH, ' '));
             statsString += QString("      Average Wait Lock Time/Element: %1 usecs\r\n")
                 .arg(locale.toString((uint)averageLockWaitTimePerElement).rightJustified(COLUMN_WIDTH, ' '));
+            statsString += QString("      Average Hold Lock Time/Element: %1 usecs\r\n")
+                .arg(locale.toString((uint)averageLockHoldTimePerElement).rightJustified(COLUMN_WIDTH, ' '));
 
             statsString += QString("\r\n       Inbound Edit Packets --------------------------------\r\n");
             statsString += QString("                            Received: %1\r\n")
@@ -1445,6 +1466,7 @@ void OctreeServer::sendStatsPacket() {
     timingArray1["5. avgCompressAndWriteTime"] = getAverageCompressAndWriteTime();
     timingArray1["6. avgSendTime"] = getAveragePacketSendingTime();
     timingArray1["7. nodeWaitTime"] = getAverageNodeWaitTime();
+    timingArray1["8. avgEditToBroadcastTime"] = getAverageEditToBroadcastTime();
 
     QJsonObject statsObject2;
     statsObject2["data"] = dataObject1;
@@ -1464,6 +1486,8 @@ void OctreeServer::sendStatsPacket() {
         timingArray2["3. avgLockWaitTimePerPacket"] = (double)_octreeInboundPacketProcessor->getAverageLockWaitTimePerPacket();
         timingArray2["4. avgProcessTimePerElement"] = (double)_octreeInboundPacketProcessor->getAverageProcessTimePerElement();
         timingArray2["5. avgLockWaitTimePerElement"] = (double)_octreeInboundPacketProcessor->getAverageLockWaitTimePerElement();
+        timingArray2["6. avgLockHoldTimePerPacket"] = (double)_octreeInboundPacketProcessor->getAverageLockHoldTimePerPacket();
+        timingArray2["7. avgLockHoldTimePerElement"] = (double)_octreeInboundPacketProcessor->getAverageLockHoldTimePerElement();
     }
 
     QJsonObject statsObject3;
@@ -102,6 +102,10 @@ public:
     static void trackTreeTraverseTime(float time) { _averageTreeTraverseTime.updateAverage(time); }
     static float getAverageTreeTraverseTime() { return _averageTreeTraverseTime.getAverage(); }
 
+    // time from the entity server taking in an edit until it is first sent to a client that already knew the entity
+    static void trackEditToBroadcastTime(float time) { _averageEditToBroadcastTime.updateAverage(time); }
+    static float getAverageEditToBroadcastTime() { return _averageEditToBroadcastTime.getAverage(); }
+
     static void trackNodeWaitTime(float time) { _averageNodeWaitTime.updateAverage(time); }
     static float getAverageNodeWaitTime() { return _averageNodeWaitTime.getAverage(); }
 
@@ -228,6 +232,8 @@ protected:
 
     static SimpleMovingAverage _averageTreeTraverseTime;
 
+    static SimpleMovingAverage _averageEditToBroadcastTime;
+
     static SimpleMovingAverage _averageNodeWaitTime;
 
     static SimpleMovingAverage _averageCompressAndWriteTime;
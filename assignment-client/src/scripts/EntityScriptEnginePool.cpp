@@ -0,0 +1,329 @@
+//
+//  EntityScriptEnginePool.cpp
+//  assignment-client/src/scripts
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityScriptEnginePool.h"
+
+#include <QtCore/QJsonArray>
+
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+#include <UUID.h>
+
+using Lock = std::lock_guard<std::mutex>;
+
+// don't bother moving scripts around unless the engines differ by at least this much busy time per second
+static const quint64 MIN_MIGRATION_IMBALANCE_USECS_PER_SECOND = 50 * USECS_PER_MSEC;
+// a script that was just moved stays put for a while, so we don't bounce it between engines
+static const quint64 MIGRATION_COOLDOWN_USECS = 30 * USECS_PER_SECOND;
+
+void EntityScriptEnginePool::addEngine(ScriptEnginePointer engine) {
+    Lock lock(_lock);
+    EngineState state;
+    state.engine = engine;
+    _engines.push_back(state);
+}
+
+ScriptEnginePointer EntityScriptEnginePool::takeLastEngine(QList<EntityItemID>& orphanedEntities) {
+    Lock lock(_lock);
+    if (_engines.empty()) {
+        return ScriptEnginePointer();
+    }
+
+    int lastIndex = (int)_engines.size() - 1;
+    auto engine = _engines.back().engine;
+    _engines.pop_back();
+
+    for (auto it = _assignments.begin(); it != _assignments.end();) {
+        if (it->second == lastIndex) {
+            orphanedEntities << it->first;
+            _scriptStats.erase(it->first);
+            it = _assignments.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    return engine;
+}
+
+std::vector<ScriptEnginePointer> EntityScriptEnginePool::getEngines() const {
+    Lock lock(_lock);
+    std::vector<ScriptEnginePointer> engines;
+    engines.reserve(_engines.size());
+    for (const auto& state : _engines) {
+        engines.push_back(state.engine);
+    }
+    return engines;
+}
+
+int EntityScriptEnginePool::getNumEngines() const {
+    Lock lock(_lock);
+    return (int)_engines.size();
+}
+
+int EntityScriptEnginePool::getNumRunningEntityScripts() const {
+    int sum = 0;
+    for (const auto& engine : getEngines()) {
+        sum += engine->getNumRunningEntityScripts();
+    }
+    return sum;
+}
+
+ScriptEnginePointer EntityScriptEnginePool::getEngineForEntity(const EntityItemID& entityID) const {
+    Lock lock(_lock);
+    auto it = _assignments.find(entityID);
+    if (it == _assignments.end()) {
+        return ScriptEnginePointer();
+    }
+    return _engines[it->second].engine;
+}
+
+int EntityScriptEnginePool::getEngineIndexForEntity(const EntityItemID& entityID) const {
+    Lock lock(_lock);
+    auto it = _assignments.find(entityID);
+    return it != _assignments.end() ? it->second : NO_ENGINE;
+}
+
+int EntityScriptEnginePool::getLeastLoadedEngineIndex() const {
+    int bestIndex = NO_ENGINE;
+    for (int i = 0; i < (int)_engines.size(); ++i) {
+        if (bestIndex == NO_ENGINE) {
+            bestIndex = i;
+            continue;
+        }
+        const auto& candidate = _engines[i];
+        const auto& best = _engines[bestIndex];
+        // prefer the engine with the least measured load, then the one running the fewest scripts,
+        // since newly loaded scripts haven't been measured yet
+        if (candidate.callUsecsPerSecond < best.callUsecsPerSecond ||
+            (candidate.callUsecsPerSecond == best.callUsecsPerSecond &&
+             candidate.numAssignedEntities < best.numAssignedEntities)) {
+            bestIndex = i;
+        }
+    }
+    return bestIndex;
+}
+
+ScriptEnginePointer EntityScriptEnginePool::assignEntity(const EntityItemID& entityID) {
+    Lock lock(_lock);
+    auto it = _assignments.find(entityID);
+    if (it != _assignments.end()) {
+        return _engines[it->second].engine;
+    }
+
+    int index = getLeastLoadedEngineIndex();
+    if (index == NO_ENGINE) {
+        return ScriptEnginePointer();
+    }
+    _assignments[entityID] = index;
+    _engines[index].numAssignedEntities++;
+    _scriptStats[entityID].engineIndex = index;
+    return _engines[index].engine;
+}
+
+ScriptEnginePointer EntityScriptEnginePool::assignEntityToEngine(const EntityItemID& entityID, int engineIndex) {
+    Lock lock(_lock);
+    if (engineIndex < 0 || engineIndex >= (int)_engines.size()) {
+        return ScriptEnginePointer();
+    }
+
+    auto it = _assignments.find(entityID);
+    if (it != _assignments.end()) {
+        _engines[it->second].numAssignedEntities--;
+    }
+    _assignments[entityID] = engineIndex;
+    _engines[engineIndex].numAssignedEntities++;
+
+    // the script starts over on its new engine, so its history no longer describes that engine's load
+    auto& stats = _scriptStats[entityID];
+    stats = ScriptStats();
+    stats.engineIndex = engineIndex;
+    _lastMigrationTimes[entityID] = usecTimestampNow();
+    return _engines[engineIndex].engine;
+}
+
+void EntityScriptEnginePool::unassignEntity(const EntityItemID& entityID) {
+    Lock lock(_lock);
+    auto it = _assignments.find(entityID);
+    if (it != _assignments.end()) {
+        _engines[it->second].numAssignedEntities--;
+        _assignments.erase(it);
+    }
+    _scriptStats.erase(entityID);
+    _lastMigrationTimes.erase(entityID);
+}
+
+void EntityScriptEnginePool::clearAssignments() {
+    Lock lock(_lock);
+    _assignments.clear();
+    _scriptStats.clear();
+    _lastMigrationTimes.clear();
+    for (auto& state : _engines) {
+        state.numAssignedEntities = 0;
+        state.callUsecsPerSecond = 0;
+    }
+}
+
+void EntityScriptEnginePool::sampleLoad() {
+    auto engines = getEngines();
+
+    // grab the call times outside of our lock, each engine has its own
+    std::vector<QHash<EntityItemID, quint64>> callTimes;
+    callTimes.reserve(engines.size());
+    for (const auto& engine : engines) {
+        callTimes.push_back(engine->getEntityScriptCallTimes());
+    }
+
+    Lock lock(_lock);
+    auto now = usecTimestampNow();
+    float secondsSinceLastSample = _lastSampleTime > 0 ? (float)(now - _lastSampleTime) / USECS_PER_SECOND : 0.0f;
+    _lastSampleTime = now;
+
+    for (auto& state : _engines) {
+        state.callUsecsPerSecond = 0;
+    }
+
+    for (int i = 0; i < (int)callTimes.size() && i < (int)_engines.size(); ++i) {
+        for (auto it = callTimes[i].constBegin(); it != callTimes[i].constEnd(); ++it) {
+            auto assignment = _assignments.find(it.key());
+            if (assignment == _assignments.end() || assignment->second != i) {
+                // stale time from an engine this script has since left
+                continue;
+            }
+
+            auto& stats = _scriptStats[it.key()];
+            stats.engineIndex = i;
+            // the engine's counter only ever grows while the script is loaded there
+            quint64 delta = it.value() >= stats.totalCallUsecs ? it.value() - stats.totalCallUsecs : it.value();
+            stats.totalCallUsecs = it.value();
+            stats.callUsecsPerSecond = secondsSinceLastSample > 0.0f ? (quint64)(delta / secondsSinceLastSample) : 0;
+            _engines[i].callUsecsPerSecond += stats.callUsecsPerSecond;
+        }
+    }
+}
+
+void EntityScriptEnginePool::probeQueueLatency() {
+    std::vector<std::pair<ScriptEnginePointer, std::shared_ptr<std::atomic<quint64>>>> probes;
+    {
+        Lock lock(_lock);
+        for (const auto& state : _engines) {
+            probes.emplace_back(state.engine, state.queueLatencyUsecs);
+        }
+    }
+
+    for (auto& probe : probes) {
+        auto queueLatencyUsecs = probe.second;
+        auto sentAt = usecTimestampNow();
+        probe.first->executeOnScriptThread([queueLatencyUsecs, sentAt] {
+            *queueLatencyUsecs = usecTimestampNow() - sentAt;
+        });
+    }
+}
+
+bool EntityScriptEnginePool::findMigration(Migration& migration) const {
+    Lock lock(_lock);
+    if (_engines.size() < 2) {
+        return false;
+    }
+
+    int busiest = 0;
+    int idlest = 0;
+    for (int i = 1; i < (int)_engines.size(); ++i) {
+        if (_engines[i].callUsecsPerSecond > _engines[busiest].callUsecsPerSecond) {
+            busiest = i;
+        }
+        if (_engines[i].callUsecsPerSecond < _engines[idlest].callUsecsPerSecond) {
+            idlest = i;
+        }
+    }
+
+    quint64 imbalance = _engines[busiest].callUsecsPerSecond - _engines[idlest].callUsecsPerSecond;
+    if (imbalance < MIN_MIGRATION_IMBALANCE_USECS_PER_SECOND || _engines[busiest].numAssignedEntities < 2) {
+        return false;
+    }
+
+    // pick the heaviest script that still leaves the pair better balanced than before,
+    // i.e. one that costs less than the difference between the two engines
+    auto now = usecTimestampNow();
+    quint64 bestCost = 0;
+    for (const auto& entry : _scriptStats) {
+        const auto& stats = entry.second;
+        if (stats.engineIndex != busiest || stats.callUsecsPerSecond == 0 ||
+            stats.callUsecsPerSecond >= imbalance || stats.callUsecsPerSecond <= bestCost) {
+            continue;
+        }
+        auto lastMigration = _lastMigrationTimes.find(entry.first);
+        if (lastMigration != _lastMigrationTimes.end() && now - lastMigration->second < MIGRATION_COOLDOWN_USECS) {
+            continue;
+        }
+        bestCost = stats.callUsecsPerSecond;
+        migration.entityID = entry.first;
+    }
+
+    if (bestCost == 0) {
+        return false;
+    }
+    migration.fromEngine = busiest;
+    migration.toEngine = idlest;
+    return true;
+}
+
+QJsonObject EntityScriptEnginePool::getStats() const {
+    Lock lock(_lock);
+
+    QJsonArray enginesArray;
+    for (const auto& state : _engines) {
+        QJsonObject engineObject;
+        engineObject["number_assigned_scripts"] = state.numAssignedEntities;
+        engineObject["busy_usecs_per_second"] = (double)state.callUsecsPerSecond;
+        engineObject["queue_latency_usecs"] = (double)state.queueLatencyUsecs->load();
+        enginesArray.push_back(engineObject);
+    }
+
+    QJsonObject scriptsObject;
+    for (const auto& entry : _scriptStats) {
+        const auto& stats = entry.second;
+        QJsonObject scriptObject;
+        scriptObject["engine"] = stats.engineIndex;
+        scriptObject["busy_usecs_per_second"] = (double)stats.callUsecsPerSecond;
+        scriptObject["total_busy_usecs"] = (double)stats.totalCallUsecs;
+        if (stats.engineIndex >= 0 && stats.engineIndex < (int)_engines.size()) {
+            // calls into a script wait behind everything else queued on its engine
+            scriptObject["queue_latency_usecs"] = (double)_engines[stats.engineIndex].queueLatencyUsecs->load();
+        }
+        scriptsObject[uuidStringWithoutCurlyBraces(entry.first)] = scriptObject;
+    }
+
+    QJsonObject statsObject;
+    statsObject["engines"] = enginesArray;
+    statsObject["scripts"] = scriptsObject;
+    return statsObject;
+}
+
+void EntityScriptEnginePool::callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName,
+                                                    const QStringList& params, const QUuid& remoteCallerID) {
+    auto engine = getEngineForEntity(entityID);
+    if (engine) {
+        engine->callEntityScriptMethod(entityID, methodName, params, remoteCallerID);
+    }
+}
+
+QFuture<QVariant> EntityScriptEnginePool::getLocalEntityScriptDetails(const EntityItemID& entityID) {
+    auto engine = getEngineForEntity(entityID);
+    if (!engine) {
+        // fall back to the first engine, which reports the script as not found
+        auto engines = getEngines();
+        if (engines.empty()) {
+            return QFuture<QVariant>();
+        }
+        engine = engines.front();
+    }
+    return engine->getLocalEntityScriptDetails(entityID);
+}
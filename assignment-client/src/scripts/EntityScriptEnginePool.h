@@ -0,0 +1,104 @@
+//
+//  EntityScriptEnginePool.h
+//  assignment-client/src/scripts
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityScriptEnginePool_h
+#define hifi_EntityScriptEnginePool_h
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <QtCore/QJsonObject>
+
+#include <EntitiesScriptEngineProvider.h>
+#include <ScriptEngine.h>
+
+// a single engine keeps all server entity scripts sharing one global scope, as they always have
+static const int DEFAULT_ENTITY_SCRIPT_ENGINES = 1;
+static const int MAX_ENTITY_SCRIPT_ENGINES = 16;
+
+// Spreads server entity scripts across several ScriptEngines, each running on its own thread.
+// Scripts are assigned to the engine with the lowest measured load and can be migrated between engines.
+// The pool is also the EntitiesScriptEngineProvider handed to the EntityScriptingInterface, so that
+// calls into an entity script are always routed to the engine that owns it.
+class EntityScriptEnginePool : public EntitiesScriptEngineProvider {
+public:
+    static const int NO_ENGINE = -1;
+
+    struct ScriptStats {
+        int engineIndex { NO_ENGINE };
+        quint64 totalCallUsecs { 0 };
+        quint64 callUsecsPerSecond { 0 };
+    };
+
+    struct Migration {
+        EntityItemID entityID;
+        int fromEngine { NO_ENGINE };
+        int toEngine { NO_ENGINE };
+    };
+
+    void addEngine(ScriptEnginePointer engine);
+
+    // removes the last engine from the pool, returning it along with the entities that were assigned to it
+    ScriptEnginePointer takeLastEngine(QList<EntityItemID>& orphanedEntities);
+
+    std::vector<ScriptEnginePointer> getEngines() const;
+    int getNumEngines() const;
+    int getNumRunningEntityScripts() const;
+
+    ScriptEnginePointer getEngineForEntity(const EntityItemID& entityID) const;
+    int getEngineIndexForEntity(const EntityItemID& entityID) const;
+
+    // returns the engine already running this entity's script, or assigns it to the least loaded engine
+    ScriptEnginePointer assignEntity(const EntityItemID& entityID);
+    ScriptEnginePointer assignEntityToEngine(const EntityItemID& entityID, int engineIndex);
+    void unassignEntity(const EntityItemID& entityID);
+    void clearAssignments();
+
+    // pulls the per-entity call times from every engine and updates the per-second rates
+    void sampleLoad();
+
+    // posts a probe to every engine's event queue to measure how long queued calls wait before running
+    void probeQueueLatency();
+
+    // picks one script to move from the busiest to the idlest engine, if doing so reduces the imbalance
+    bool findMigration(Migration& migration) const;
+
+    QJsonObject getStats() const;
+
+    // EntitiesScriptEngineProvider
+    void callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName,
+                                const QStringList& params = QStringList(), const QUuid& remoteCallerID = QUuid()) override;
+    QFuture<QVariant> getLocalEntityScriptDetails(const EntityItemID& entityID) override;
+
+private:
+    struct EngineState {
+        ScriptEnginePointer engine;
+        std::shared_ptr<std::atomic<quint64>> queueLatencyUsecs { std::make_shared<std::atomic<quint64>>(0) };
+        quint64 callUsecsPerSecond { 0 };
+        int numAssignedEntities { 0 };
+    };
+
+    int getLeastLoadedEngineIndex() const;
+
+    mutable std::mutex _lock;
+    std::vector<EngineState> _engines;
+    std::unordered_map<EntityItemID, int> _assignments;
+    std::unordered_map<EntityItemID, ScriptStats> _scriptStats;
+    std::unordered_map<EntityItemID, quint64> _lastMigrationTimes;
+    quint64 _lastSampleTime { 0 };
+};
+
+using EntityScriptEnginePoolPointer = QSharedPointer<EntityScriptEnginePool>;
+
+#endif // hifi_EntityScriptEnginePool_h
@@ -96,6 +96,12 @@ EntityScriptServer::EntityScriptServer(ReceivedMessage& message) : ThreadedAssig
     timer->setInterval(LOG_INTERVAL);
     connect(timer, &QTimer::timeout, this, &EntityScriptServer::pushLogs);
     timer->start();
+
+    static const int BALANCE_INTERVAL = 5 * MSECS_PER_SECOND;
+    auto balanceTimer = new QTimer(this);
+    balanceTimer->setInterval(BALANCE_INTERVAL);
+    connect(balanceTimer, &QTimer::timeout, this, &EntityScriptServer::balanceEntitiesScriptEngines);
+    balanceTimer->start();
 }
 
 EntityScriptServer::~EntityScriptServer() {
@@ -125,7 +131,8 @@ void EntityScriptServer::handleEntityScriptGetStatusPacket(QSharedPointer<Receiv
         replyPacketList->writePrimitive(messageID);
 
         EntityScriptDetails details;
-        if (_entitiesScriptEngine->getEntityScriptDetails(entityID, details)) {
+        auto engine = _entitiesScriptEngines ? _entitiesScriptEngines->getEngineForEntity(entityID) : ScriptEnginePointer();
+        if (engine && engine->getEntityScriptDetails(entityID, details)) {
             replyPacketList->writePrimitive(true);
             replyPacketList->writePrimitive(details.status);
             replyPacketList->writeString(details.errorInfo);
@@ -156,6 +163,16 @@ void EntityScriptServer::handleSettings() {
 
     static const QString MAX_ENTITY_PPS_OPTION = "max_total_entity_pps";
     static const QString ENTITY_PPS_PER_SCRIPT = "entity_pps_per_script";
+    static const QString SCRIPT_ENGINES_OPTION = "script_engines";
+
+    if (entityScriptServerSettings.contains(SCRIPT_ENGINES_OPTION)) {
+        int numEngines = entityScriptServerSettings[SCRIPT_ENGINES_OPTION].toInt();
+        _numEntitiesScriptEngines = std::min(std::max(numEngines, 1), MAX_ENTITY_SCRIPT_ENGINES);
+        qDebug() << "Received entity script server settings, Script Engines:" << _numEntitiesScriptEngines;
+        if (_entitiesScriptEngines && !_shuttingDown) {
+            resizeEntitiesScriptEngines(_numEntitiesScriptEngines);
+        }
+    }
 
     if (!entityScriptServerSettings.contains(MAX_ENTITY_PPS_OPTION) || !entityScriptServerSettings.contains(ENTITY_PPS_PER_SCRIPT)) {
         qWarning() << "Received settings from the domain-server with no max_total_entity_pps or entity_pps_per_script properties.";
@@ -170,7 +187,7 @@ void EntityScriptServer::handleSettings() {
 }
 
 void EntityScriptServer::updateEntityPPS() {
-    int numRunningScripts = _entitiesScriptEngine->getNumRunningEntityScripts();
+    int numRunningScripts = _entitiesScriptEngines ? _entitiesScriptEngines->getNumRunningEntityScripts() : 0;
     int pps;
     if (std::numeric_limits<int>::max() / _entityPPSPerScript < numRunningScripts) {
         qWarning() << QString("Integer multiplication would overflow, clamping to maxint: %1 * %2").arg(numRunningScripts).arg(_entityPPSPerScript);
@@ -231,7 +248,7 @@ void EntityScriptServer::pushLogs() {
 
 void EntityScriptServer::handleEntityScriptCallMethodPacket(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode) {
 
-    if (_entitiesScriptEngine && _entityViewer.getTree() && !_shuttingDown) {
+    if (_entitiesScriptEngines && _entityViewer.getTree() && !_shuttingDown) {
         auto entityID = QUuid::fromRfc4122(receivedMessage->read(NUM_BYTES_RFC4122_UUID));
 
         auto method = receivedMessage->readString();
@@ -245,7 +262,7 @@ void EntityScriptServer::handleEntityScriptCallMethodPacket(QSharedPointer<Recei
             params << paramString;
         }
 
-        _entitiesScriptEngine->callEntityScriptMethod(entityID, method, params, senderNode->getUUID());
+        _entitiesScriptEngines->callEntityScriptMethod(entityID, method, params, senderNode->getUUID());
     }
 }
 
@@ -276,8 +293,8 @@ void EntityScriptServer::run() {
         NodeType::EntityServer, NodeType::MessagesMixer, NodeType::AssetServer
     });
 
-    // Setup Script Engine
-    resetEntitiesScriptEngine();
+    // Setup Script Engines
+    resetEntitiesScriptEngines();
 
     auto entityScriptingInterface = DependencyManager::get<EntityScriptingInterface>();
     entityScriptingInterface->init();
@@ -439,7 +456,7 @@ void EntityScriptServer::selectAudioFormat(const QString& selectedCodecName) {
     }
 }
 
-void EntityScriptServer::resetEntitiesScriptEngine() {
+ScriptEnginePointer EntityScriptServer::createEntitiesScriptEngine(bool drivesTreeUpdates) {
     auto engineName = QString("about:Entities %1").arg(++_entitiesScriptEngineCount);
     auto newEngine = scriptEngineFactory(ScriptEngine::ENTITY_SERVER_SCRIPT, NO_SCRIPT, engineName);
 
@@ -456,48 +473,116 @@ void EntityScriptServer::resetEntitiesScriptEngine() {
     connect(newEngine.data(), &ScriptEngine::warningMessage, scriptEngines, &ScriptEngines::onWarningMessage);
     connect(newEngine.data(), &ScriptEngine::infoMessage, scriptEngines, &ScriptEngines::onInfoMessage);
 
-    connect(newEngine.data(), &ScriptEngine::update, this, [this] {
-        _entityViewer.queryOctree();
-        _entityViewer.getTree()->preUpdate();
-        _entityViewer.getTree()->update();
-    });
+    // only one engine of the pool drives the entity tree, the others just run scripts
+    if (drivesTreeUpdates) {
+        connect(newEngine.data(), &ScriptEngine::update, this, [this] {
+            _entityViewer.queryOctree();
+            _entityViewer.getTree()->preUpdate();
+            _entityViewer.getTree()->update();
+        });
+    }
+
+    connect(newEngine.data(), &ScriptEngine::entityScriptDetailsUpdated,
+            this, &EntityScriptServer::updateEntityPPS);
 
     scriptEngines->runScriptInitializers(newEngine);
     newEngine->runInThread();
-    auto newEngineSP = qSharedPointerCast<EntitiesScriptEngineProvider>(newEngine);
-    DependencyManager::get<EntityScriptingInterface>()->setEntitiesScriptEngine(newEngineSP);
+    return newEngine;
+}
 
-    if (_entitiesScriptEngine) {
-        disconnect(_entitiesScriptEngine.data(), &ScriptEngine::entityScriptDetailsUpdated,
-                   this, &EntityScriptServer::updateEntityPPS);
+void EntityScriptServer::resetEntitiesScriptEngines() {
+    auto newPool = EntityScriptEnginePoolPointer::create();
+    for (int i = 0; i < _numEntitiesScriptEngines; ++i) {
+        newPool->addEngine(createEntitiesScriptEngine(i == 0));
     }
 
-    _entitiesScriptEngine.swap(newEngine);
-    connect(_entitiesScriptEngine.data(), &ScriptEngine::entityScriptDetailsUpdated,
-            this, &EntityScriptServer::updateEntityPPS);
+    DependencyManager::get<EntityScriptingInterface>()->setEntitiesScriptEngine(newPool);
+    _entitiesScriptEngines.swap(newPool);
 }
 
+void EntityScriptServer::resizeEntitiesScriptEngines(int numEngines) {
+    while (_entitiesScriptEngines->getNumEngines() < numEngines) {
+        _entitiesScriptEngines->addEngine(createEntitiesScriptEngine(false));
+    }
 
-void EntityScriptServer::clear() {
-    // unload and stop the engine
-    if (_entitiesScriptEngine) {
+    // the first engine drives the tree, so the pool always keeps at least that one
+    while (_entitiesScriptEngines->getNumEngines() > std::max(numEngines, 1)) {
+        QList<EntityItemID> orphanedEntities;
+        auto engine = _entitiesScriptEngines->takeLastEngine(orphanedEntities);
+        stopEntitiesScriptEngine(engine);
+
+        // restart the scripts that were running there on the remaining engines
+        for (const auto& entityID : orphanedEntities) {
+            checkAndCallPreload(entityID, false);
+        }
+    }
+}
+
+void EntityScriptServer::stopEntitiesScriptEngine(ScriptEnginePointer engine) {
+    if (engine) {
         // do this here (instead of in deleter) to avoid marshalling unload signals back to this thread
-        _entitiesScriptEngine->unloadAllEntityScripts();
-        _entitiesScriptEngine->stop();
-        _entitiesScriptEngine->waitTillDoneRunning();
+        engine->unloadAllEntityScripts();
+        engine->stop();
+        engine->waitTillDoneRunning();
+    }
+}
+
+void EntityScriptServer::migrateEntityScript(const EntityItemID& entityID, int toEngine) {
+    if (!_entitiesScriptEngines || !_entityViewer.getTree() || _shuttingDown) {
+        return;
+    }
+
+    auto fromEngine = _entitiesScriptEngines->getEngineIndexForEntity(entityID);
+    if (fromEngine == toEngine || toEngine < 0 || toEngine >= _entitiesScriptEngines->getNumEngines()) {
+        return;
+    }
+
+    auto oldEngine = _entitiesScriptEngines->getEngineForEntity(entityID);
+    if (oldEngine) {
+        oldEngine->unloadEntityScript(entityID, true);
+    }
+
+    qCDebug(entity_script_server) << "Moving script for" << entityID << "from engine" << fromEngine << "to engine" << toEngine;
+    _entitiesScriptEngines->assignEntityToEngine(entityID, toEngine);
+    checkAndCallPreload(entityID, false);
+}
+
+void EntityScriptServer::balanceEntitiesScriptEngines() {
+    if (!_entitiesScriptEngines || _shuttingDown) {
+        return;
+    }
+
+    _entitiesScriptEngines->sampleLoad();
+    _entitiesScriptEngines->probeQueueLatency();
+
+    EntityScriptEnginePool::Migration migration;
+    if (_entitiesScriptEngines->findMigration(migration)) {
+        migrateEntityScript(migration.entityID, migration.toEngine);
+    }
+}
+
+void EntityScriptServer::clear() {
+    // unload and stop the engines
+    if (_entitiesScriptEngines) {
+        for (const auto& engine : _entitiesScriptEngines->getEngines()) {
+            stopEntitiesScriptEngine(engine);
+        }
+        _entitiesScriptEngines->clearAssignments();
     }
 
     _entityViewer.clear();
 
-    // reset the engine
+    // reset the engines
     if (!_shuttingDown) {
-        resetEntitiesScriptEngine();
+        resetEntitiesScriptEngines();
     }
 }
 
 void EntityScriptServer::shutdownScriptEngine() {
-    if (_entitiesScriptEngine) {
-        _entitiesScriptEngine->disconnectNonEssentialSignals(); // disconnect all slots/signals from the script engine, except essential
+    if (_entitiesScriptEngines) {
+        for (const auto& engine : _entitiesScriptEngines->getEngines()) {
+            engine->disconnectNonEssentialSignals(); // disconnect all slots/signals from the script engine, except essential
+        }
     }
     _shuttingDown = true;
 
@@ -506,7 +591,7 @@ void EntityScriptServer::shutdownScriptEngine() {
     auto scriptEngines = DependencyManager::get<ScriptEngines>();
     scriptEngines->shutdownScripting();
 
-    _entitiesScriptEngine.clear();
+    _entitiesScriptEngines.clear();
 
     auto entityScriptingInterface = DependencyManager::get<EntityScriptingInterface>();
     // our entity tree is going to go away so tell that to the EntityScriptingInterface
@@ -524,8 +609,12 @@ void EntityScriptServer::addingEntity(const EntityItemID& entityID) {
 }
 
 void EntityScriptServer::deletingEntity(const EntityItemID& entityID) {
-    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptEngine) {
-        _entitiesScriptEngine->unloadEntityScript(entityID, true);
+    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptEngines) {
+        auto engine = _entitiesScriptEngines->getEngineForEntity(entityID);
+        if (engine) {
+            engine->unloadEntityScript(entityID, true);
+        }
+        _entitiesScriptEngines->unassignEntity(entityID);
     }
 }
 
@@ -536,20 +625,26 @@ void EntityScriptServer::entityServerScriptChanging(const EntityItemID& entityID
 }
 
 void EntityScriptServer::checkAndCallPreload(const EntityItemID& entityID, bool forceRedownload) {
-    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptEngine) {
+    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptEngines) {
 
         EntityItemPointer entity = _entityViewer.getTree()->findEntityByEntityItemID(entityID);
         EntityScriptDetails details;
-        bool isRunning = _entitiesScriptEngine->getEntityScriptDetails(entityID, details);
+        auto engine = _entitiesScriptEngines->getEngineForEntity(entityID);
+        bool isRunning = engine && engine->getEntityScriptDetails(entityID, details);
         if (entity && (forceRedownload || !isRunning || details.scriptText != entity->getServerScripts())) {
             if (isRunning) {
-                _entitiesScriptEngine->unloadEntityScript(entityID, true);
+                engine->unloadEntityScript(entityID, true);
             }
 
             QString scriptUrl = entity->getServerScripts();
             if (!scriptUrl.isEmpty()) {
                 scriptUrl = DependencyManager::get<ResourceManager>()->normalizeURL(scriptUrl);
-                _entitiesScriptEngine->loadEntityScript(entityID, scriptUrl, forceRedownload);
+                engine = _entitiesScriptEngines->assignEntity(entityID);
+                if (engine) {
+                    engine->loadEntityScript(entityID, scriptUrl, forceRedownload);
+                }
+            } else {
+                _entitiesScriptEngines->unassignEntity(entityID);
             }
         }
     }
@@ -566,9 +661,14 @@ void EntityScriptServer::sendStatsPacket() {
 
     QJsonObject scriptEngineStats;
     int numberRunningScripts = 0;
-    const auto scriptEngine = _entitiesScriptEngine;
-    if (scriptEngine) {
-        numberRunningScripts = scriptEngine->getNumRunningEntityScripts();
+    const auto scriptEngines = _entitiesScriptEngines;
+    if (scriptEngines) {
+        numberRunningScripts = scriptEngines->getNumRunningEntityScripts();
+        // per engine and per script busy time and queue latency
+        auto poolStats = scriptEngines->getStats();
+        for (auto it = poolStats.constBegin(); it != poolStats.constEnd(); ++it) {
+            scriptEngineStats[it.key()] = it.value();
+        }
     }
     scriptEngineStats["number_running_scripts"] = numberRunningScripts;
     statsObject["script_engine_stats"] = scriptEngineStats;
@@ -24,6 +24,7 @@
 #include <SimpleEntitySimulation.h>
 #include <ThreadedAssignment.h>
 #include "../entities/EntityTreeHeadlessViewer.h"
+#include "EntityScriptEnginePool.h"
 
 class EntityScriptServer : public ThreadedAssignment {
     Q_OBJECT
@@ -54,6 +55,8 @@ private slots:
 
     void pushLogs();
 
+    void balanceEntitiesScriptEngines();
+
     void handleEntityScriptCallMethodPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
 
 
@@ -61,7 +64,11 @@ private:
     void negotiateAudioFormat();
     void selectAudioFormat(const QString& selectedCodecName);
 
-    void resetEntitiesScriptEngine();
+    ScriptEnginePointer createEntitiesScriptEngine(bool drivesTreeUpdates);
+    void resetEntitiesScriptEngines();
+    void resizeEntitiesScriptEngines(int numEngines);
+    void stopEntitiesScriptEngine(ScriptEnginePointer engine);
+    void migrateEntityScript(const EntityItemID& entityID, int toEngine);
     void clear();
     void shutdownScriptEngine();
 
@@ -75,7 +82,8 @@ private:
     bool _shuttingDown { false };
 
     static int _entitiesScriptEngineCount;
-    ScriptEnginePointer _entitiesScriptEngine;
+    EntityScriptEnginePoolPointer _entitiesScriptEngines;
+    int _numEntitiesScriptEngines { DEFAULT_ENTITY_SCRIPT_ENGINES };
     SimpleEntitySimulationPointer _entitySimulation;
     EntityEditPacketSender _entityEditSender;
     EntityTreeHeadlessViewer _entityViewer;
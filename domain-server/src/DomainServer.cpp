@@ -335,6 +335,13 @@ DomainServer::DomainServer(int argc, char* argv[]) :
     _nodePingMonitorTimer = new QTimer{ this };
     connect(_nodePingMonitorTimer, &QTimer::timeout, this, &DomainServer::nodePingMonitor);
     _nodePingMonitorTimer->start(NODE_PING_MONITOR_INTERVAL_MSECS);
+
+    // nodes joining and leaving are batched up and sent out as domain list deltas at most this often
+    static const int DOMAIN_LIST_DELTA_INTERVAL_MSECS = 100;
+    _domainListDeltaTimer = new QTimer { this };
+    _domainListDeltaTimer->setSingleShot(true);
+    _domainListDeltaTimer->setInterval(DOMAIN_LIST_DELTA_INTERVAL_MSECS);
+    connect(_domainListDeltaTimer, &QTimer::timeout, this, &DomainServer::sendDomainListDeltas);
 }
 
 void DomainServer::parseCommandLine(int argc, char* argv[]) {
@@ -1103,7 +1110,11 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
     }
 
     // update the NodeInterestSet in case there have been any changes
-    nodeData->setNodeInterestSet(safeInterestSet);
+    if (safeInterestSet != nodeData->getNodeInterestSet()) {
+        // the deltas only cover the types it was interested in, so it needs a full list again
+        nodeData->resetDomainListVersion();
+        nodeData->setNodeInterestSet(safeInterestSet);
+    }
 
     // update the connecting hostname in case it has changed
     nodeData->setPlaceName(nodeRequestData.placeName);
@@ -1222,7 +1233,24 @@ void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 r
     // store the nodeInterestSet on this DomainServerNodeData, in case it has changed
     auto& nodeInterestSet = nodeData->getNodeInterestSet();
 
-    if (nodeInterestSet.size() > 0) {
+    // A node that was sent a full list is kept current by the domain list deltas, so most check-ins are answered
+    // with just the header.  The list is sent in full again every so often in case one went missing, and to pick up
+    // changes to the other nodes that aren't deltas (e.g. their permissions).
+    // The answer to a connect request doesn't count, so the first check-in after it gets a full list as well.
+    static const int DOMAIN_LIST_SNAPSHOT_INTERVAL = 10;
+    bool sendFullList = newConnection
+        || nodeData->getDomainListVersion() == DomainListDeltas::NO_VERSION
+        || nodeData->getNumDomainListsSinceSnapshot() >= DOMAIN_LIST_SNAPSHOT_INTERVAL;
+
+    if (!sendFullList) {
+        nodeData->incrementNumDomainListsSinceSnapshot();
+    } else if (newConnection) {
+        nodeData->resetDomainListVersion();
+    } else {
+        nodeData->setDomainListVersion(_domainListDeltas.getVersion());
+    }
+
+    if (sendFullList && nodeInterestSet.size() > 0) {
 
         // DTLSServerSession* dtlsSession = _isUsingDTLS ? _dtlsSessions[senderSockAddr] : NULL;
         if (nodeData->isAuthenticated()) {
@@ -1274,42 +1302,81 @@ QUuid DomainServer::connectionSecretForNodes(const SharedNodePointer& nodeA, con
 }
 
 void DomainServer::broadcastNewNode(const SharedNodePointer& addedNode) {
+    // the other nodes hear about it with the next batch of domain list deltas
+    _domainListDeltas.addNode(addedNode->getUUID(), addedNode->getType());
+    queueDomainListDeltas();
+}
 
-    auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
-    QWeakPointer<LimitedNodeList> limitedNodeListWeak = limitedNodeList;
-
-    auto addNodePacket = NLPacket::create(PacketType::DomainServerAddedNode);
-
-    // setup the add packet for this new node
-    QDataStream addNodeStream(addNodePacket.get());
+void DomainServer::queueDomainListDeltas() {
+    if (!_domainListDeltaTimer->isActive()) {
+        _domainListDeltaTimer->start();
+    }
+}
 
-    addNodeStream << *addedNode.data();
+void DomainServer::sendDomainListDeltas() {
+    auto batch = _domainListDeltas.takePendingChanges();
+    if (batch.isEmpty()) {
+        return;
+    }
 
-    int connectionSecretIndex = addNodePacket->pos();
+    auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
 
-    limitedNodeList->eachMatchingNode(
-        [this, addedNode](const SharedNodePointer& node)->bool {
-            // is the added Node in this node's interest list?
-            return node->getLinkedData()
-                && node->getActiveSocket()
-                && node != addedNode
-                && isInInterestSet(node, addedNode);
-        },
-        [this, &addNodePacket, connectionSecretIndex, addedNode, limitedNodeListWeak](const SharedNodePointer& node) {
-            // send off this packet to the node
-            auto limitedNodeList = limitedNodeListWeak.lock();
-            if (limitedNodeList) {
-                addNodePacket->seek(connectionSecretIndex);
+    // pack each added node once, every node interested in it gets the same bytes plus their connection secret
+    QHash<QUuid, QPair<SharedNodePointer, QByteArray>> addedNodes;
+    for (const auto& change : batch.getChanges()) {
+        if (!change.isRemoval) {
+            auto addedNode = limitedNodeList->nodeWithUUID(change.nodeID);
+            if (addedNode) {
+                QByteArray addedNodeData;
+                QDataStream addedNodeStream(&addedNodeData, QIODevice::WriteOnly);
+                addedNodeStream << *addedNode.data();
+                addedNodes.insert(change.nodeID, { addedNode, addedNodeData });
+            }
+        }
+    }
 
-                QByteArray rfcConnectionSecret = connectionSecretForNodes(node, addedNode).toRfc4122();
+    // one pass over the nodes for the whole batch, each gets (at most) one list of removals and one of additions
+    limitedNodeList->eachNode([this, &batch, &addedNodes, &limitedNodeList](const SharedNodePointer& node) {
+        auto nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
+        if (!nodeData || !node->getActiveSocket()) {
+            return;
+        }
 
-                // replace the bytes at the end of the packet for the connection secret between these nodes
-                addNodePacket->write(rfcConnectionSecret);
+        std::unique_ptr<NLPacketList> removedNodesList;
+        std::unique_ptr<NLPacketList> addedNodesList;
 
-                limitedNodeList->sendUnreliablePacket(*addNodePacket, *node);
+        batch.forEachChangeFor(node->getUUID(), nodeData->getNodeInterestSet(), nodeData->getDomainListVersion(),
+                               [&](const DomainListDeltas::Change& change) {
+            if (change.isRemoval) {
+                if (!removedNodesList) {
+                    removedNodesList = NLPacketList::create(PacketType::DomainServerRemovedNode, QByteArray(), true, true);
+                }
+                removedNodesList->startSegment();
+                removedNodesList->write(change.nodeID.toRfc4122());
+                removedNodesList->endSegment();
+            } else {
+                auto it = addedNodes.find(change.nodeID);
+                if (it == addedNodes.end()) {
+                    return;
+                }
+                if (!addedNodesList) {
+                    addedNodesList = NLPacketList::create(PacketType::DomainServerAddedNode, QByteArray(), true, true);
+                }
+                addedNodesList->startSegment();
+                addedNodesList->write(it.value().second);
+                addedNodesList->write(connectionSecretForNodes(node, it.value().first).toRfc4122());
+                addedNodesList->endSegment();
             }
+        });
+
+        // removals first, in case a node left and came back with the same ID
+        if (removedNodesList) {
+            limitedNodeList->sendPacketList(std::move(removedNodesList), *node);
         }
-    );
+        if (addedNodesList) {
+            limitedNodeList->sendPacketList(std::move(addedNodesList), *node);
+        }
+    });
 }
 
 void DomainServer::processRequestAssignmentPacket(QSharedPointer<ReceivedMessage> message) {
@@ -3373,21 +3440,9 @@ void DomainServer::handleKillNode(SharedNodePointer nodeToKill) {
 }
 
 void DomainServer::broadcastNodeDisconnect(const SharedNodePointer& disconnectedNode) {
-    auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
-
-    static auto removedNodePacket = NLPacket::create(PacketType::DomainServerRemovedNode, NUM_BYTES_RFC4122_UUID, true);
-
-    removedNodePacket->reset();
-    removedNodePacket->write(disconnectedNode->getUUID().toRfc4122());
-
-    // broadcast out the DomainServerRemovedNode message
-    limitedNodeList->eachMatchingNode([this, &disconnectedNode](const SharedNodePointer& otherNode) -> bool {
-        // only send the removed node packet to nodes that care about the type of node this was
-        return isInInterestSet(otherNode, disconnectedNode);
-    }, [&limitedNodeList](const SharedNodePointer& otherNode){
-        auto removedNodePacketCopy = NLPacket::createCopy(*removedNodePacket);
-        limitedNodeList->sendPacket(std::move(removedNodePacketCopy), *otherNode);
-    });
+    // the nodes that care about the type of node this was hear about it with the next batch of domain list deltas
+    _domainListDeltas.removeNode(disconnectedNode->getUUID(), disconnectedNode->getType());
+    queueDomainListDeltas();
 }
 
 void DomainServer::processICEServerHeartbeatDenialPacket(QSharedPointer<ReceivedMessage> message) {
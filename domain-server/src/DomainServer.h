@@ -24,6 +24,7 @@
 #include <QAbstractNativeEventFilter>
 
 #include <Assignment.h>
+#include <DomainListDeltas.h>
 #include <HTTPSConnection.h>
 #include <LimitedNodeList.h>
 
@@ -112,6 +113,7 @@ private slots:
     void sendHeartbeatToMetaverse() { sendHeartbeatToMetaverse(QString()); }
     void sendHeartbeatToIceServer();
     void nodePingMonitor();
+    void sendDomainListDeltas();
 
     void handleConnectedNode(SharedNodePointer newNode, quint64 requestReceiveTime); 
     void handleTempDomainSuccess(QNetworkReply* requestReply);
@@ -182,6 +184,7 @@ private:
 
     QUuid connectionSecretForNodes(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB);
     void broadcastNewNode(const SharedNodePointer& node);
+    void queueDomainListDeltas();
 
     void parseAssignmentConfigs(QSet<Assignment::Type>& excludedTypes);
     void addStaticAssignmentToAssignmentHash(Assignment* newAssignment);
@@ -263,6 +266,9 @@ private:
     QTimer* _metaverseHeartbeatTimer { nullptr };
     QTimer* _metaverseGroupCacheTimer { nullptr };
     QTimer* _nodePingMonitorTimer { nullptr };
+    QTimer* _domainListDeltaTimer { nullptr };
+
+    DomainListDeltas _domainListDeltas;
 
     QList<QHostAddress> _iceServerAddresses;
     QSet<QHostAddress> _failedIceServerAddresses;
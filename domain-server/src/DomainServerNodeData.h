@@ -17,6 +17,7 @@
 #include <QtCore/QUuid>
 #include <QtCore/QJsonObject>
 
+#include <DomainListDeltas.h>
 #include <HifiSockAddr.h>
 #include <NLPacket.h>
 #include <NodeData.h>
@@ -75,6 +76,14 @@ public:
 
     bool hasCheckedIn() const { return _hasCheckedIn; }
     void setHasCheckedIn(bool hasCheckedIn) { _hasCheckedIn = hasCheckedIn; }
+
+    // the version of the last full domain list sent to this node, the domain list deltas since then keep it current
+    DomainListDeltas::Version getDomainListVersion() const { return _domainListVersion; }
+    void setDomainListVersion(DomainListDeltas::Version version) { _domainListVersion = version; _numDomainListsSinceSnapshot = 0; }
+    void resetDomainListVersion() { _domainListVersion = DomainListDeltas::NO_VERSION; }
+
+    int getNumDomainListsSinceSnapshot() const { return _numDomainListsSinceSnapshot; }
+    void incrementNumDomainListsSinceSnapshot() { _numDomainListsSinceSnapshot++; }
     
 private:
     QJsonObject overrideValuesIfNeeded(const QJsonObject& newStats);
@@ -102,6 +111,9 @@ private:
     bool _wasAssigned { false };
 
     bool _hasCheckedIn { false };
+
+    DomainListDeltas::Version _domainListVersion { DomainListDeltas::NO_VERSION };
+    int _numDomainListsSinceSnapshot { 0 };
 };
 
 #endif // hifi_DomainServerNodeData_h
@@ -443,6 +443,12 @@ Item {
                         visible: root.expanded
                         text: "Entity Updates: " + root.numEntityUpdates + " / " + root.numNeededEntityUpdates;
                     }
+                    StatText {
+                        visible: root.expanded
+                        text: "Entity Update Backlog: " + root.entityUpdateBacklog +
+                            ", latency: " + root.entityUpdateLatency.toFixed(2) +
+                            " / " + root.entityUpdateMaxLatency.toFixed(2) + " ms";
+                    }
                 }
             }
         }
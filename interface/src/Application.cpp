@@ -7099,6 +7099,11 @@ void Application::queryOctree(
     }
     _octreeQuery.setReportInitialCompletion(isModifiedQuery);
 
+    // let the entity server know we take compression dictionaries, and which one we have
+    QJsonObject jsonParameters = _octreeQuery.getJSONParameters();
+    jsonParameters[COMPRESSION_DICTIONARY_QUERY_PARAMETER] = (double)_octreeProcessor.getCompressionDictionaryID();
+    _octreeQuery.setJSONParameters(jsonParameters);
+
 
     // auto menu = Menu::getInstance();
     auto treeRenderer = DependencyManager::get<EntityTreeRenderer>();
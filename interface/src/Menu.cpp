@@ -516,6 +516,12 @@ Menu::Menu() {
     addCheckableActionToQMenuAndActionHash(renderOptionsMenu, MenuOption::ComputeBlendshapes, 0, true,
         DependencyManager::get<ModelBlender>().data(), SLOT(setComputeBlendshapes(bool)));
 
+    // Developer > Render > Model LODs
+    action = addCheckableActionToQMenuAndActionHash(renderOptionsMenu, MenuOption::ModelLODs, 0, MeshPartPayload::enableLODs);
+    connect(action, &QAction::triggered, [action] {
+        MeshPartPayload::enableLODs = action->isChecked();
+    });
+
     {
         auto drawStatusConfig = qApp->getRenderEngine()->getConfiguration()->getConfig<render::DrawStatus>("RenderMainView.DrawStatus");
         addCheckableActionToQMenuAndActionHash(renderOptionsMenu, MenuOption::HighlightTransitions, 0, false,
@@ -220,6 +220,7 @@ namespace MenuOption {
     const QString NotificationSoundsTablet = "play_notification_sounds_tablet";
     const QString ForceCoarsePicking = "Force Coarse Picking";
     const QString ComputeBlendshapes = "Compute Blendshapes";
+    const QString ModelLODs = "Model LODs";
     const QString HighlightTransitions = "Highlight Transitions";
     const QString DisableWebEntities = "Disable Web Entities";
     const QString MaterialProceduralShaders = "Custom Shaders on Models";
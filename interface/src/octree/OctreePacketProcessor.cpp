@@ -26,6 +26,7 @@ OctreePacketProcessor::OctreePacketProcessor():
     const PacketReceiver::PacketTypeList octreePackets =
         { PacketType::OctreeStats, PacketType::EntityData, PacketType::EntityErase, PacketType::EntityQueryInitialResultsComplete };
     packetReceiver.registerDirectListenerForTypes(octreePackets, this, "handleOctreePacket");
+    packetReceiver.registerDirectListener(PacketType::EntityCompressionDictionary, this, "handleCompressionDictionaryPacket");
 }
 
 OctreePacketProcessor::~OctreePacketProcessor() { }
@@ -34,6 +35,15 @@ void OctreePacketProcessor::handleOctreePacket(QSharedPointer<ReceivedMessage> m
     queueReceivedPacket(message, senderNode);
 }
 
+void OctreePacketProcessor::handleCompressionDictionaryPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    // the entity data compressed with it comes once the next query has told the server we have it, while our edits can
+    // be compressed with it right away since the server trained it
+    auto dictionary = std::make_shared<const OctreeCompressionDictionary>(message->getMessage());
+    OctreeCompressionDictionary::add(dictionary);
+    _compressionDictionaryID = dictionary->getID();
+    qApp->getEntityEditPacketSender()->setCompressionDictionary(dictionary);
+}
+
 void OctreePacketProcessor::processPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
     PerformanceWarning warn(Menu::getInstance()->isOptionChecked(MenuOption::PipelineWarnings),
                             "OctreePacketProcessor::processPacket()");
@@ -12,6 +12,9 @@
 #ifndef hifi_OctreePacketProcessor_h
 #define hifi_OctreePacketProcessor_h
 
+#include <atomic>
+
+#include <OctreeCompressionDictionary.h>
 #include <ReceivedPacketProcessor.h>
 #include <ReceivedMessage.h>
 
@@ -34,6 +37,9 @@ public:
 
     float domainLoadingProgress() const { return _safeLanding->loadingProgressPercentage(); }
 
+    // the latest compression dictionary the entity server sent, reported back to it in the octree query
+    OctreeCompressionDictionary::ID getCompressionDictionaryID() const { return _compressionDictionaryID; }
+
 signals:
     void packetVersionMismatch();
 
@@ -42,9 +48,11 @@ protected:
 
 private slots:
     void handleOctreePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
+    void handleCompressionDictionaryPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
 
 private:
     OCTREE_PACKET_SEQUENCE _safeLandingSequenceStart { SafeLanding::INVALID_SEQUENCE };
     std::unique_ptr<SafeLanding> _safeLanding;
+    std::atomic<OctreeCompressionDictionary::ID> _compressionDictionaryID { OctreeCompressionDictionary::NO_DICTIONARY };
 };
 #endif  // hifi_OctreePacketProcessor_h
@@ -463,6 +463,9 @@ void Stats::updateStats(bool force) {
         STAT_UPDATE(lodStatus, "You can see " + DependencyManager::get<LODManager>()->getLODFeedbackText());
         STAT_UPDATE(numEntityUpdates, DependencyManager::get<EntityTreeRenderer>()->getPrevNumEntityUpdates());
         STAT_UPDATE(numNeededEntityUpdates, DependencyManager::get<EntityTreeRenderer>()->getPrevTotalNeededEntityUpdates());
+        STAT_UPDATE(entityUpdateBacklog, DependencyManager::get<EntityTreeRenderer>()->getRenderUpdateBacklog());
+        STAT_UPDATE_FLOAT(entityUpdateLatency, DependencyManager::get<EntityTreeRenderer>()->getAvgRenderUpdateLatency(), 0.01f);
+        STAT_UPDATE_FLOAT(entityUpdateMaxLatency, DependencyManager::get<EntityTreeRenderer>()->getMaxRenderUpdateLatency(), 0.01f);
     }
 
 
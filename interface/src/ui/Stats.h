@@ -253,6 +253,14 @@ private: \
  *     <em>Read-only.</em>
  * @property {string} numNeededEntityUpdates - The total number of entity updates scheduled for last frame.
  *     <em>Read-only.</em>
+ * @property {number} entityUpdateBacklog - The number of entity updates that didn't fit in last frame's time budget.
+ *     <em>Read-only.</em>
+ * @property {number} entityUpdateLatency - The average time, in ms, between an entity changing and its update being
+ *     committed to the scene, over last frame's updates.
+ *     <em>Read-only.</em>
+ * @property {number} entityUpdateMaxLatency - The longest time, in ms, between an entity changing and its update being
+ *     committed to the scene, over last frame's updates.
+ *     <em>Read-only.</em>
  * @property {string} timingStats - Details of the average time (ms) spent in and number of calls made to different parts of 
  *     the code. Provided only if <code>timingExpanded</code> is <code>true</code>. Only the top 10 items are provided if 
  *     Developer &gt; Timing &gt; Performance Timer &gt; Only Display Top 10 is enabled.
@@ -551,6 +559,9 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(QString, lodStatus, QString())
     STATS_PROPERTY(int, numEntityUpdates, 0)
     STATS_PROPERTY(int, numNeededEntityUpdates, 0)
+    STATS_PROPERTY(int, entityUpdateBacklog, 0)
+    STATS_PROPERTY(float, entityUpdateLatency, 0)
+    STATS_PROPERTY(float, entityUpdateMaxLatency, 0)
     STATS_PROPERTY(QString, timingStats, QString())
     STATS_PROPERTY(QString, gameUpdateStats, QString())
     STATS_PROPERTY(int, serverElements, 0)
@@ -1240,6 +1251,27 @@ signals:
      */
     void numNeededEntityUpdatesChanged();
 
+    /**jsdoc
+     * Triggered when the value of the <code>entityUpdateBacklog</code> property changes.
+     * @function Stats.entityUpdateBacklogChanged
+     * @returns {Signal}
+     */
+    void entityUpdateBacklogChanged();
+
+    /**jsdoc
+     * Triggered when the value of the <code>entityUpdateLatency</code> property changes.
+     * @function Stats.entityUpdateLatencyChanged
+     * @returns {Signal}
+     */
+    void entityUpdateLatencyChanged();
+
+    /**jsdoc
+     * Triggered when the value of the <code>entityUpdateMaxLatency</code> property changes.
+     * @function Stats.entityUpdateMaxLatencyChanged
+     * @returns {Signal}
+     */
+    void entityUpdateMaxLatencyChanged();
+
     /**jsdoc
      * Triggered when the value of the <code>timingStats</code> property changes.
      * @function Stats.timingStatsChanged
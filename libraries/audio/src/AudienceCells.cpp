@@ -0,0 +1,46 @@
+//
+//  AudienceCells.cpp
+//  libraries/audio/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudienceCells.h"
+
+namespace AudienceCells {
+
+// Solos, ignores, gains, ignore boxes and hearing oneself are per listener, so a listener with any of them gets a mix
+// of its own.
+bool canShareMix(const Listener& listener) {
+    if (!listener.isAgent || !listener.hasActiveSocket || listener.isUpstream || !listener.hasAvatarStream) {
+        return false;
+    }
+
+    return !listener.isIgnoreBoxEnabled && !listener.isLoopingBack && !listener.isSoloing && !listener.isIgnoring &&
+        listener.masterAvatarGain == 1.0f && listener.masterInjectorGain == 1.0f &&
+        !listener.hasAvatarGainAdjustments;
+}
+
+bool findCell(const std::vector<Audience>& audiences, const glm::vec3& position, CellKey& cell) {
+    for (int i = 0; i < (int)audiences.size(); ++i) {
+        const AABox& area = audiences[i].area;
+        if (area.contains(position)) {
+            glm::ivec3 index = glm::floor((position - area.getCorner()) / audiences[i].cellSize);
+            cell = CellKey(i, index.x, index.y, index.z);
+            return true;
+        }
+    }
+    return false;
+}
+
+glm::vec3 getCellCorner(const std::vector<Audience>& audiences, const CellKey& cell) {
+    const auto& audience = audiences[std::get<0>(cell)];
+    glm::vec3 index(std::get<1>(cell), std::get<2>(cell), std::get<3>(cell));
+    return audience.area.getCorner() + index * audience.cellSize;
+}
+
+}
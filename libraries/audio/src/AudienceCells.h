@@ -0,0 +1,61 @@
+//
+//  AudienceCells.h
+//  libraries/audio/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudienceCells_h
+#define hifi_AudienceCells_h
+
+#include <tuple>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <AABox.h>
+
+// The rules the audio mixer shares mixes in audience zones by: which listeners may share a mix, and which cell of
+// which audience zone each of them is in.
+namespace AudienceCells {
+
+// a cell of one is a mix of its own
+const size_t MIN_LISTENERS_PER_CELL = 2;
+
+// audience, then cell coordinates in the zone
+using CellKey = std::tuple<int, int, int, int>;
+
+struct Audience {
+    AABox area;
+    float cellSize;
+};
+
+// what a listener hears beyond what anyone else at the same spot would
+struct Listener {
+    bool isAgent { true };
+    bool hasActiveSocket { true };
+    bool isUpstream { false };
+    bool hasAvatarStream { true };
+    bool isIgnoreBoxEnabled { false };
+    bool isLoopingBack { false };
+    bool isSoloing { false };
+    bool isIgnoring { false };
+    float masterAvatarGain { 1.0f };
+    float masterInjectorGain { 1.0f };
+    bool hasAvatarGainAdjustments { false };
+};
+
+bool canShareMix(const Listener& listener);
+
+// the cell of the first audience whose area holds the position, false if none does
+bool findCell(const std::vector<Audience>& audiences, const glm::vec3& position, CellKey& cell);
+
+glm::vec3 getCellCorner(const std::vector<Audience>& audiences, const CellKey& cell);
+
+}
+
+#endif // hifi_AudienceCells_h
@@ -208,7 +208,7 @@ qint64 writeStringToStream(const QString& string, QDataStream& stream) {
     return length + sizeof(uint32_t);
 }
 
-int64_t AudioInjector::injectNextFrame() {
+int64_t AudioInjector::injectNextFrame(const SharedNodePointer& audioMixer) {
     if (stateHas(AudioInjectorState::NetworkInjectionFinished)) {
         return NEXT_FRAME_DELTA_ERROR_OR_FINISHED;
     }
@@ -326,10 +326,6 @@ int64_t AudioInjector::injectNextFrame() {
 
     _currentPacket->seek(audioDataOffset);
 
-    // This code is copying bytes from the _sound directly into the packet, handling looping appropriately.
-    // Might be a reasonable place to do the encode step here.
-    QByteArray decodedAudio;
-
     int totalBytesLeftToCopy = (options.stereo ? 2 : 1) * AudioConstants::NETWORK_FRAME_BYTES_PER_CHANNEL;
     if (!options.loop) {
         // If we aren't looping, let's make sure we don't read past the end
@@ -337,43 +333,39 @@ int64_t AudioInjector::injectNextFrame() {
         totalBytesLeftToCopy = std::min(totalBytesLeftToCopy, bytesLeftToRead);
     }
 
-    auto samples = _audioData->data();
-    auto currentSample = _currentSendOffset / AudioConstants::SAMPLE_SIZE;
-    auto samplesLeftToCopy = totalBytesLeftToCopy / AudioConstants::SAMPLE_SIZE;
-
     using AudioConstants::AudioSample;
-    decodedAudio.resize(totalBytesLeftToCopy);
-    auto samplesOut = reinterpret_cast<AudioSample*>(decodedAudio.data());
+    auto samples = _audioData->data();
+    int numSamples = _audioData->getNumSamples();
+    int currentSample = _currentSendOffset / AudioConstants::SAMPLE_SIZE;
+    int samplesLeftToCopy = totalBytesLeftToCopy / AudioConstants::SAMPLE_SIZE;
 
-    //  Copy and Measure the loudness of this frame
-    withWriteLock([&] {
-        _loudness = 0.0f;
-        for (int i = 0; i < samplesLeftToCopy; ++i) {
-            auto index = (currentSample + i) % _audioData->getNumSamples();
-            auto sample = samples[index];
-            samplesOut[i] = sample;
-            _loudness += abs(sample) / (AudioConstants::MAX_SAMPLE_VALUE / 2.0f);
+    // Copy the samples straight from the (shared) sound into the packet, wrapping around when looping,
+    // and measure the loudness of this frame.
+    // FIXME -- good place to call codec encode here. We need to figure out how to tell the AudioInjector which
+    // codec to use... possible through AbstractAudioInterface.
+    float loudness = 0.0f;
+    for (int samplesCopied = 0; samplesCopied < samplesLeftToCopy;) {
+        int samplesToCopy = std::min(samplesLeftToCopy - samplesCopied, numSamples - currentSample);
+        const AudioSample* chunk = samples + currentSample;
+        _currentPacket->write(reinterpret_cast<const char*>(chunk), samplesToCopy * AudioConstants::SAMPLE_SIZE);
+        for (int i = 0; i < samplesToCopy; ++i) {
+            loudness += abs(chunk[i]) / (AudioConstants::MAX_SAMPLE_VALUE / 2.0f);
         }
-        _loudness /= (float)samplesLeftToCopy;
+        samplesCopied += samplesToCopy;
+        currentSample = (currentSample + samplesToCopy) % numSamples;
+    }
+    withWriteLock([&] {
+        _loudness = loudness / (float)samplesLeftToCopy;
     });
     _currentSendOffset = (_currentSendOffset + totalBytesLeftToCopy) %
                          _audioData->getNumBytes();
 
-    // FIXME -- good place to call codec encode here. We need to figure out how to tell the AudioInjector which
-    // codec to use... possible through AbstractAudioInterface.
-    QByteArray encodedAudio = decodedAudio;
-    _currentPacket->write(encodedAudio.data(), encodedAudio.size());
-
     // set the correct size used for this packet
     _currentPacket->setPayloadSize(_currentPacket->pos());
 
-    // grab our audio mixer from the NodeList, if it exists
-    auto nodeList = DependencyManager::get<NodeList>();
-    SharedNodePointer audioMixer = nodeList->soloNodeOfType(NodeType::AudioMixer);
-
     if (audioMixer) {
         // send off this audio packet
-        nodeList->sendUnreliablePacket(*_currentPacket, *audioMixer);
+        DependencyManager::get<NodeList>()->sendUnreliablePacket(*_currentPacket, *audioMixer);
         _outgoingSequenceNumber++;
     }
 
@@ -406,14 +398,13 @@ int64_t AudioInjector::injectNextFrame() {
 }
 
 
-void AudioInjector::sendStopInjectorPacket() {
-    auto nodeList = DependencyManager::get<NodeList>();
-    if (auto audioMixer = nodeList->soloNodeOfType(NodeType::AudioMixer)) {
+void AudioInjector::sendStopInjectorPacket(const SharedNodePointer& audioMixer) {
+    if (audioMixer) {
         // Build packet
         auto stopInjectorPacket = NLPacket::create(PacketType::StopInjector);
         stopInjectorPacket->write(_streamID.toRfc4122());
 
         // Send packet
-        nodeList->sendUnreliablePacket(*stopInjectorPacket, *audioMixer);
+        DependencyManager::get<NodeList>()->sendUnreliablePacket(*stopInjectorPacket, *audioMixer);
     }
 }
@@ -25,6 +25,7 @@
 #include <glm/gtx/quaternion.hpp>
 
 #include <NLPacket.h>
+#include <Node.h>
 
 #include "AudioInjectorLocalBuffer.h"
 #include "AudioInjectorOptions.h"
@@ -97,10 +98,11 @@ signals:
     void restarting();
 
 private:
-    int64_t injectNextFrame();
+    // the manager looks up the mixer once for the whole batch of injectors it sends a frame of
+    int64_t injectNextFrame(const SharedNodePointer& audioMixer);
     bool inject(bool(AudioInjectorManager::*injection)(const AudioInjectorPointer&));
     bool injectLocally();
-    void sendStopInjectorPacket();
+    void sendStopInjectorPacket(const SharedNodePointer& audioMixer);
 
     static AbstractAudioInterface* _localAudioInterface;
 
@@ -13,6 +13,7 @@
 
 #include <QtCore/QCoreApplication>
 
+#include <NodeList.h>
 #include <SharedUtil.h>
 #include <shared/QtHelpers.h>
 
@@ -22,21 +23,29 @@
 
 #include "AudioSRC.h"
 
+static const int MAX_INJECTORS_PER_THREAD = 40; // calculated based on AudioInjector time to send frame, with sufficient padding
+
+// a tick is a quarter of a frame, so an injector sends its frame at most an eighth of a frame early or late
+static const int WHEEL_TICKS_PER_FRAME = 4;
+static const uint64_t WHEEL_TICK_USECS = AudioConstants::NETWORK_FRAME_USECS / WHEEL_TICKS_PER_FRAME;
+
+AudioInjectorManager::AudioInjectorManager() :
+    _injectors(WHEEL_TICK_USECS, usecTimestampNow()),
+    _maxInjectors(MAX_INJECTORS_PER_THREAD)
+{
+    createThread();
+}
+
 AudioInjectorManager::~AudioInjectorManager() {
     _shouldStop = true;
 
     Lock lock(_injectorsMutex);
 
     // make sure any still living injectors are stopped and deleted
-    while (!_injectors.empty()) {
-        // grab the injector at the front
-        auto& timePointerPair = _injectors.top();
-
+    _injectors.clear([](const AudioInjectorPointer& injector) {
         // ask it to stop and be deleted
-        timePointerPair.second->finish();
-
-        _injectors.pop();
-    }
+        injector->finish();
+    });
 
     // get rid of the lock now that we've stopped all living injectors
     lock.unlock();
@@ -68,63 +77,19 @@ void AudioInjectorManager::createThread() {
 
 void AudioInjectorManager::run() {
     while (!_shouldStop) {
-        // wait until the next injector is ready, or until we get a new injector given to us
+        // wait until the next tick, or until we get a new injector given to us
         Lock lock(_injectorsMutex);
 
         if (_injectors.size() > 0) {
-            // when does the next injector need to send a frame?
-            // do we get to wait or should we just go for it now?
-
-            auto timeInjectorPair = _injectors.top();
-
-            auto nextTimestamp = timeInjectorPair.first;
-            int64_t difference = int64_t(nextTimestamp - usecTimestampNow());
-
-            if (difference > 0) {
-                _injectorReady.wait_for(lock, std::chrono::microseconds(difference));
-            }
-
-            if (_injectors.size() > 0) {
-                // loop through the injectors in the map and send whatever frames need to go out
-                auto front = _injectors.top();
-
-                // create an InjectorQueue to hold injectors to be queued
-                // this allows us to call processEvents even if a single injector wants to be re-queued immediately
-                std::vector<TimeInjectorPointerPair> heldInjectors;
-                heldInjectors.reserve(_injectors.size());
-
-                while (_injectors.size() > 0 && front.first <= usecTimestampNow()) {
-                    // either way we're popping this injector off - get a copy first
-                    auto injector = front.second;
-                    _injectors.pop();
-
-                    if (!injector.isNull()) {
-                        // this is an injector that's ready to go, have it send a frame now
-                        auto nextCallDelta = injector->injectNextFrame();
-
-                        if (nextCallDelta >= 0 && !injector->isFinished()) {
-                            // enqueue the injector with the correct timing in our holding queue
-                            heldInjectors.emplace(heldInjectors.end(), usecTimestampNow() + nextCallDelta, injector);
-                        } else {
-                            injector->sendStopInjectorPacket();
-                        }
-                    }
-
-                    if (_injectors.size() > 0) {
-                        front = _injectors.top();
-                    } else {
-                        // no more injectors to look at, break
-                        break;
-                    }
-                }
-
-                // if there are injectors in the holding queue, push them to our persistent queue now
-                while (!heldInjectors.empty()) {
-                    _injectors.push(heldInjectors.back());
-                    heldInjectors.pop_back();
-                }
+            uint64_t now = usecTimestampNow();
+            uint64_t nextTickTimestamp = _injectors.getNextTickTimestamp();
+            if (nextTickTimestamp > now) {
+                _injectorReady.wait_for(lock, std::chrono::microseconds(nextTickTimestamp - now));
+                now = usecTimestampNow();
             }
 
+            // send the frames of the injectors that are due by now
+            injectFrames(now);
         } else {
             // we have no current injectors, wait until we get at least one before we do anything
             _injectorReady.wait(lock);
@@ -137,12 +102,33 @@ void AudioInjectorManager::run() {
     }
 }
 
-static const int MAX_INJECTORS_PER_THREAD = 40; // calculated based on AudioInjector time to send frame, with sufficient padding
+void AudioInjectorManager::injectFrames(uint64_t now) {
+    // grab our audio mixer from the NodeList, if it exists, once for the whole batch
+    SharedNodePointer audioMixer;
+    if (DependencyManager::isSet<NodeList>()) {
+        audioMixer = DependencyManager::get<NodeList>()->soloNodeOfType(NodeType::AudioMixer);
+    }
+
+    _injectors.advance(now, [&](const AudioInjectorPointer& injector) -> int64_t {
+        if (injector.isNull()) {
+            return -1;
+        }
+
+        // this is an injector that's ready to go, have it send a frame now
+        auto nextCallDelta = injector->injectNextFrame(audioMixer);
+        if (nextCallDelta >= 0 && !injector->isFinished()) {
+            return nextCallDelta;
+        }
+
+        injector->sendStopInjectorPacket(audioMixer);
+        return -1;
+    });
+}
 
 bool AudioInjectorManager::wouldExceedLimits() { // Should be called inside of a lock.
-    if (_injectors.size() >= MAX_INJECTORS_PER_THREAD) {
+    if (_injectors.size() >= _maxInjectors) {
         qCDebug(audio)  << "AudioInjectorManager::threadInjector could not thread AudioInjector - at max of"
-            << MAX_INJECTORS_PER_THREAD << "current audio injectors.";
+            << _maxInjectors << "current audio injectors.";
         return true;
     }
     return false;
@@ -160,8 +146,8 @@ bool AudioInjectorManager::threadInjector(const AudioInjectorPointer& injector)
     if (wouldExceedLimits()) {
         return false;
     } else {
-        // add the injector to the queue with a send timestamp of now
-        _injectors.emplace(usecTimestampNow(), injector);
+        // add the injector to the wheel with a send timestamp of now
+        _injectors.schedule(usecTimestampNow(), injector);
 
         // notify our wait condition so we can inject two frames for this injector immediately
         _injectorReady.notify_one();
@@ -357,3 +343,8 @@ size_t AudioInjectorManager::getNumInjectors() {
     Lock lock(_injectorsMutex);
     return _injectors.size();
 }
+
+void AudioInjectorManager::setMaxInjectors(size_t maxInjectors) {
+    Lock lock(_injectorsMutex);
+    _maxInjectors = maxInjectors;
+}
@@ -15,7 +15,6 @@
 #define hifi_AudioInjectorManager_h
 
 #include <condition_variable>
-#include <queue>
 #include <mutex>
 
 #include <QtCore/QPointer>
@@ -24,6 +23,7 @@
 #include <DependencyManager.h>
 
 #include "AudioInjector.h"
+#include "InjectorWheel.h"
 
 class AudioInjectorManager : public QObject, public Dependency {
     Q_OBJECT
@@ -36,6 +36,9 @@ public:
 
     size_t getNumInjectors();
 
+    // how many injectors can play at once, a script server playing a crowd of sounds can afford more than a client
+    void setMaxInjectors(size_t maxInjectors);
+
 public slots:
     void setOptionsAndRestart(const AudioInjectorPointer& injector, const AudioInjectorOptions& options);
     void restart(const AudioInjectorPointer& injector);
@@ -53,25 +56,15 @@ private slots:
 
 private:
 
-    using TimeInjectorPointerPair = std::pair<uint64_t, AudioInjectorPointer>;
-
-    struct greaterTime {
-        bool operator() (const TimeInjectorPointerPair& x, const TimeInjectorPointerPair& y) const {
-            return x.first > y.first;
-        }
-    };
-
-    using InjectorQueue = std::priority_queue<TimeInjectorPointerPair,
-                                              std::deque<TimeInjectorPointerPair>,
-                                              greaterTime>;
     using Mutex = std::mutex;
     using Lock = std::unique_lock<Mutex>;
 
     bool threadInjector(const AudioInjectorPointer& injector);
+    void injectFrames(uint64_t now); // Should be called inside of a lock.
     void notifyInjectorReadyCondition() { _injectorReady.notify_one(); }
     bool wouldExceedLimits();
 
-    AudioInjectorManager() { createThread(); }
+    AudioInjectorManager();
     AudioInjectorManager(const AudioInjectorManager&) = delete;
     AudioInjectorManager& operator=(const AudioInjectorManager&) = delete;
 
@@ -79,7 +72,8 @@ private:
 
     QThread* _thread { nullptr };
     bool _shouldStop { false };
-    InjectorQueue _injectors;
+    InjectorWheel<AudioInjectorPointer> _injectors;
+    size_t _maxInjectors;
     Mutex _injectorsMutex;
     std::condition_variable _injectorReady;
 
@@ -0,0 +1,121 @@
+//
+//  AudioJitterEstimator.cpp
+//  libraries/audio/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioJitterEstimator.h"
+
+#include <algorithm>
+
+#include "AudioConstants.h"
+
+const float AudioJitterEstimator::TARGET_QUANTILE = 0.97f;
+
+// about 2s for a late packet to lose half its weight
+const float AudioJitterEstimator::FORGET_FACTOR = 0.9965f;
+
+void AudioJitterEstimator::reset() {
+    _packetsReceived = 0;
+    _lastSequence = 0;
+    _lastFrame = 0;
+    _firstArrivalUsecs = 0;
+    _minDelays.clear();
+    _histogram.fill(0.0f);
+    _quantileFrames = 1;
+    _peaks.clear();
+    _isInPeak = false;
+    _targetFrames = 1;
+}
+
+void AudioJitterEstimator::packetReceived(quint16 sequence, quint64 arrivalUsecs) {
+    const qint64 FRAME_USECS = AudioConstants::NETWORK_FRAME_USECS;
+
+    if (_packetsReceived == 0) {
+        _lastSequence = sequence;
+        _lastFrame = 0;
+        _firstArrivalUsecs = arrivalUsecs;
+    }
+    _packetsReceived++;
+
+    // sequence numbers wrap, so go from the last one
+    qint64 frame = _lastFrame + (qint16)(quint16)(sequence - _lastSequence);
+    qint64 delay = (qint64)(arrivalUsecs - _firstArrivalUsecs) - frame * FRAME_USECS;
+
+    if (frame > _lastFrame || _minDelays.empty()) {
+        _lastSequence = sequence;
+        _lastFrame = frame;
+
+        while (!_minDelays.empty() && _minDelays.back().usecs >= delay) {
+            _minDelays.pop_back();
+        }
+        _minDelays.push_back({ frame, delay });
+        while (_minDelays.front().frame <= frame - MIN_DELAY_WINDOW_FRAMES) {
+            _minDelays.pop_front();
+        }
+    }
+
+    qint64 relativeDelay = std::max(delay - _minDelays.front().usecs, (qint64)0);
+    int frames = 1 + (int)((relativeDelay + FRAME_USECS - 1) / FRAME_USECS);
+    if (frames > MAX_TARGET_FRAMES) {
+        // the sender stopped for a while, or the stream was restarted; either way what came before doesn't tell us
+        // when the next packets will arrive, so start measuring again from this one
+        frames = MAX_TARGET_FRAMES;
+        _firstArrivalUsecs = arrivalUsecs;
+        _lastSequence = sequence;
+        _lastFrame = 0;
+        _minDelays.clear();
+        _minDelays.push_back({ 0, 0 });
+    }
+
+    // weigh the first packets evenly, so the histogram is useful straight away
+    float weight = std::max(1.0f - FORGET_FACTOR, 1.0f / _packetsReceived);
+    for (auto& bucket : _histogram) {
+        bucket *= 1.0f - weight;
+    }
+    _histogram[frames - 1] += weight;
+
+    updateQuantile();
+    updatePeaks(frames);
+
+    _targetFrames = _quantileFrames;
+    if ((int)_peaks.size() >= MIN_PEAKS) {
+        for (const auto& peak : _peaks) {
+            _targetFrames = std::max(_targetFrames, peak.frames);
+        }
+    }
+}
+
+void AudioJitterEstimator::updateQuantile() {
+    float sum = 0.0f;
+    for (int i = 0; i < MAX_TARGET_FRAMES; i++) {
+        sum += _histogram[i];
+        if (sum >= TARGET_QUANTILE) {
+            _quantileFrames = i + 1;
+            return;
+        }
+    }
+    _quantileFrames = MAX_TARGET_FRAMES;
+}
+
+void AudioJitterEstimator::updatePeaks(int frames) {
+    if (frames > _quantileFrames + PEAK_MIN_FRAMES) {
+        if (_isInPeak) {
+            _peaks.back().frames = std::max(_peaks.back().frames, frames);
+        } else {
+            _peaks.push_back({ _packetsReceived, frames });
+            _isInPeak = true;
+        }
+    } else {
+        _isInPeak = false;
+    }
+
+    while (!_peaks.empty() && _peaks.front().packet <= _packetsReceived - PEAK_WINDOW_PACKETS) {
+        _peaks.pop_front();
+    }
+}
@@ -0,0 +1,87 @@
+//
+//  AudioJitterEstimator.h
+//  libraries/audio/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioJitterEstimator_h
+#define hifi_AudioJitterEstimator_h
+
+#include <array>
+#include <deque>
+
+#include <QtGlobal>
+
+// Works out how many frames an audio stream has to buffer from when its packets arrive.
+//
+// Each packet's delay is measured against the time it would have arrived at if the stream were perfectly paced, from
+// the first packet and its sequence number, and relative to the earliest packet of the last couple of seconds so that
+// clock drift and route changes drop out.  The delays, in frames, go in a histogram that slowly forgets, and the target
+// is the number of frames that covers TARGET_QUANTILE of them.  A run of late packets raises the target within a few
+// frames; it comes back down over several seconds once they stop.
+//
+// A network that stalls every few seconds delays too few packets to move the quantile, but starves the stream each
+// time, so the stalls are tracked too: a run of packets more than PEAK_MIN_FRAMES later than the quantile covers is a
+// peak, and once MIN_PEAKS of them have come within PEAK_WINDOW_PACKETS, the target covers the highest until they stop.
+//
+// Arrival times are passed in, so the estimator can be replayed against recorded traces.
+class AudioJitterEstimator {
+public:
+    static const int MAX_TARGET_FRAMES = 50;
+    static const float TARGET_QUANTILE;
+    static const float FORGET_FACTOR;
+    static const int MIN_DELAY_WINDOW_FRAMES = 200;
+    static const int PEAK_MIN_FRAMES = 2;
+    static const int PEAK_WINDOW_PACKETS = 2000;
+    static const int MIN_PEAKS = 2;
+
+    AudioJitterEstimator() { reset(); }
+
+    void reset();
+
+    // a packet with this sequence number arrived at this time.  packets that arrive out of order are fine
+    void packetReceived(quint16 sequence, quint64 arrivalUsecs);
+
+    // the frames to buffer, at least 1
+    int getTargetFrames() const { return _targetFrames; }
+
+    int getPacketsReceived() const { return _packetsReceived; }
+
+private:
+    void updateQuantile();
+    void updatePeaks(int frames);
+
+    struct Delay {
+        qint64 frame;
+        qint64 usecs;
+    };
+
+    struct Peak {
+        int packet;
+        int frames;
+    };
+
+    int _packetsReceived { 0 };
+    quint16 _lastSequence { 0 };
+    qint64 _lastFrame { 0 };
+    quint64 _firstArrivalUsecs { 0 };
+
+    // the packets of the window that have a lower delay than any packet after them, so the front is the lowest
+    std::deque<Delay> _minDelays;
+
+    std::array<float, MAX_TARGET_FRAMES> _histogram;
+    int _quantileFrames { 1 };
+
+    // the runs of packets well past the quantile
+    std::deque<Peak> _peaks;
+    bool _isInPeak { false };
+
+    int _targetFrames { 1 };
+};
+
+#endif // hifi_AudioJitterEstimator_h
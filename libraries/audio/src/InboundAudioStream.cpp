@@ -29,8 +29,6 @@ const int InboundAudioStream::WINDOW_SECONDS_FOR_DESIRED_REDUCTION = 10;
 const bool InboundAudioStream::USE_STDEV_FOR_JITTER = false;
 const bool InboundAudioStream::REPETITION_WITH_FADE = true;
 
-static const int STARVE_HISTORY_CAPACITY = 50;
-
 // This is called 1x/s, and we want it to log the last 5s
 static const int UNPLAYED_MS_WINDOW_SECS = 5;
 
@@ -44,9 +42,14 @@ static const int DESIRED_JITTER_BUFFER_FRAMES_PADDING = 1;
 // _desiredJitterBufferFrames calculation)
 static const int STATS_FOR_STATS_PACKET_WINDOW_SECONDS = 30;
 
+// the first packets of a stream tend to arrive in a burst, which would make the ones after look late to the jitter
+// estimator, so the desired jitter buffer frames aren't taken from it until this many have arrived
+static const int JITTER_ESTIMATOR_INITIAL_PACKETS = 50;
+
 // this controls the window size of the time-weighted avg of frames available.  Every time the window fills up,
 // _currentJitterBufferFrames is updated with the time-weighted avg and the running time-weighted avg is reset.
-static const quint64 FRAMES_AVAILABLE_STAT_WINDOW_USECS = 10 * USECS_PER_SECOND;
+// It is short enough that the buffer follows the jitter estimator back down within a few seconds.
+static const quint64 FRAMES_AVAILABLE_STAT_WINDOW_USECS = 2 * USECS_PER_SECOND;
 
 // When the audio codec is switched, temporary codec mismatch is expected due to packets in-flight.
 // A SelectedAudioFormat packet is not sent until this threshold is exceeded.
@@ -59,16 +62,17 @@ InboundAudioStream::InboundAudioStream(int numChannels, int numFrames, int numBl
     _staticJitterBufferFrames(std::max(numStaticJitterBlocks, DEFAULT_STATIC_JITTER_FRAMES)),
     _desiredJitterBufferFrames(_dynamicJitterBufferEnabled ? 1 : _staticJitterBufferFrames),
     _incomingSequenceNumberStats(STATS_FOR_STATS_PACKET_WINDOW_SECONDS),
-    _starveHistory(STARVE_HISTORY_CAPACITY),
     _unplayedMs(0, UNPLAYED_MS_WINDOW_SECS),
     _timeGapStatsForStatsPacket(0, STATS_FOR_STATS_PACKET_WINDOW_SECONDS) {}
 
 InboundAudioStream::~InboundAudioStream() {
+    _pendingPackets.clear();
     cleanupCodec();
 }
 
 void InboundAudioStream::reset() {
     _ringBuffer.reset();
+    _pendingPackets.clear();
     _lastPopSucceeded = false;
     _lastPopOutput = AudioRingBuffer::ConstIterator();
     _isStarved = true;
@@ -89,9 +93,7 @@ void InboundAudioStream::resetStats() {
     _oldFramesDropped = 0;
     _incomingSequenceNumberStats.reset();
     _lastPacketReceivedTime = 0;
-    _timeGapStatsForDesiredCalcOnTooManyStarves.reset();
-    _timeGapStatsForDesiredReduction.reset();
-    _starveHistory.clear();
+    _jitterEstimator.reset();
     _framesAvailableStat.reset();
     _currentJitterBufferFrames = 0;
     _timeGapStatsForStatsPacket.reset();
@@ -100,6 +102,7 @@ void InboundAudioStream::resetStats() {
 
 void InboundAudioStream::clearBuffer() {
     _ringBuffer.clear();
+    _pendingPackets.clear();
     _framesAvailableStat.reset();
     _currentJitterBufferFrames = 0;
 }
@@ -112,8 +115,6 @@ void InboundAudioStream::setReverb(float reverbTime, float wetLevel) {
 
 void InboundAudioStream::perSecondCallbackForUpdatingStats() {
     _incomingSequenceNumberStats.pushStatsToHistory();
-    _timeGapStatsForDesiredCalcOnTooManyStarves.currentIntervalComplete();
-    _timeGapStatsForDesiredReduction.currentIntervalComplete();
     _timeGapStatsForStatsPacket.currentIntervalComplete();
     _unplayedMs.currentIntervalComplete();
 }
@@ -126,7 +127,7 @@ int InboundAudioStream::parseData(ReceivedMessage& message) {
         _incomingSequenceNumberStats.sequenceNumberReceived(sequence, message.getSourceID());
     QString codecInPacket = message.readString();
 
-    packetReceivedUpdateTimingStats();
+    packetReceivedUpdateTimingStats(sequence, arrivalInfo);
 
     int networkFrames;
 
@@ -136,10 +137,22 @@ int InboundAudioStream::parseData(ReceivedMessage& message) {
 
     message.seek(prePropertyPosition + propertyBytes);
 
+    PendingPacket packet;
+    packet.packetType = message.getType();
+
+    // the audio stays in the message, which is shared rather than copied when it is decoded later
+    auto takeAudio = [&](PendingPacket::Frames frames) {
+        packet.frames = frames;
+        packet.message = message.getMessage();
+        packet.audioOffset = (int)message.getPosition();
+        packet.audioSize = (int)message.getBytesLeftToRead();
+        message.seek(message.getSize());
+    };
+
     // handle this packet based on its arrival status.
     switch (arrivalInfo._status) {
         case SequenceNumberStats::Unreasonable: {
-            lostAudioData(1);
+            packet.numLostFrames = 1;
             break;
         }
         case SequenceNumberStats::Early: {
@@ -147,8 +160,7 @@ int InboundAudioStream::parseData(ReceivedMessage& message) {
             // OnTime packet and this packet were lost. If we're using a codec this will 
             // also result in allowing the codec to interpolate lost data. Then
             // fall through to the "on time" logic to actually handle this packet
-            int packetsDropped = arrivalInfo._seqDiffFromExpected;
-            lostAudioData(packetsDropped);
+            packet.numLostFrames = arrivalInfo._seqDiffFromExpected;
 
             // fall through to OnTime case
         }
@@ -159,15 +171,15 @@ int InboundAudioStream::parseData(ReceivedMessage& message) {
                 || message.getType() == PacketType::ReplicatedSilentAudioFrame) {
                 // If we recieved a SilentAudioFrame from our sender, we might want to drop
                 // some of the samples in order to catch up to our desired jitter buffer size.
-                writeDroppableSilentFrames(networkFrames);
+                packet.frames = PendingPacket::Silent;
+                packet.numSilentFrames = networkFrames;
 
             } else {
                 // note: PCM and no codec are identical
                 bool selectedPCM = _selectedCodecName == "pcm" || _selectedCodecName == "";
                 bool packetPCM = codecInPacket == "pcm" || codecInPacket == "";
                 if (codecInPacket == _selectedCodecName || (packetPCM && selectedPCM)) {
-                    auto afterProperties = message.readWithoutCopy(message.getBytesLeftToRead());
-                    parseAudioData(message.getType(), afterProperties);
+                    takeAudio(PendingPacket::Audio);
                     _mismatchedAudioCodecCount = 0;
 
                 } else {
@@ -175,13 +187,12 @@ int InboundAudioStream::parseData(ReceivedMessage& message) {
 
                     if (packetPCM) {
                         // If there are PCM packets in-flight after the codec is changed, use them.
-                        auto afterProperties = message.readWithoutCopy(message.getBytesLeftToRead());
-                        _ringBuffer.writeData(afterProperties.data(), afterProperties.size());
+                        takeAudio(PendingPacket::PCM);
                     } else {
                         // Since the data in the stream is using a codec that we aren't prepared for,
                         // we need to let the codec know that we don't have data for it, this will
                         // allow the codec to interpolate missing data and produce a fade to silence.
-                        lostAudioData(1);
+                        packet.numLostFrames++;
                     }
 
                     if (_mismatchedAudioCodecCount > MAX_MISMATCHED_AUDIO_CODEC_COUNT) {
@@ -206,6 +217,64 @@ int InboundAudioStream::parseData(ReceivedMessage& message) {
         }
     }
 
+    if (_decodeDeferred) {
+        _pendingPackets.push_back(std::move(packet));
+    } else {
+        writePacketFrames(packet);
+    }
+
+    return message.getPosition();
+}
+
+void InboundAudioStream::setDecodeDeferred(bool deferred) {
+    if (!deferred) {
+        decodePendingFrames();
+    }
+    _decodeDeferred = deferred;
+}
+
+void InboundAudioStream::decodePendingFrames() {
+    if (_pendingPackets.empty()) {
+        return;
+    }
+
+    // may block on the real-time thread, which is acceptible as
+    // this is only called by the packet processing thread which,
+    // while high performance, is not as sensitive to delays as
+    // the real-time thread.  the frames take the lock again as they
+    // are decoded, which doesn't block since it is recursive.
+    QMutexLocker lock(&_decoderMutex);
+    for (const auto& packet : _pendingPackets) {
+        writePacketFrames(packet);
+    }
+    _pendingPackets.clear();
+}
+
+void InboundAudioStream::writePacketFrames(const PendingPacket& packet) {
+    if (packet.numLostFrames > 0) {
+        lostAudioData(packet.numLostFrames);
+    }
+
+    auto audio = QByteArray::fromRawData(packet.message.constData() + packet.audioOffset, packet.audioSize);
+    switch (packet.frames) {
+        case PendingPacket::Audio:
+            parseAudioData(packet.packetType, audio);
+            break;
+        case PendingPacket::PCM:
+            _ringBuffer.writeData(audio.constData(), audio.size());
+            break;
+        case PendingPacket::Silent:
+            writeDroppableSilentFrames(packet.numSilentFrames);
+            break;
+        case PendingPacket::None:
+            break;
+    }
+
+    // every packet is checked for starving and overflowing once its frames are in, whenever that is
+    framesWritten();
+}
+
+void InboundAudioStream::framesWritten() {
     int framesAvailable = _ringBuffer.framesAvailable();
     // if this stream was starved, check if we're still starved.
     if (_isStarved && framesAvailable >= _desiredJitterBufferFrames) {
@@ -227,8 +296,6 @@ int InboundAudioStream::parseData(ReceivedMessage& message) {
     }
 
     framesAvailableChanged();
-
-    return message.getPosition();
 }
 
 int InboundAudioStream::parseStreamProperties(PacketType type, const QByteArray& packetAfterSeqNum, int& numAudioSamples) {
@@ -426,43 +493,6 @@ void InboundAudioStream::setToStarved() {
     // if we have more than the desired frames when setToStarved() is called, then we'll immediately
     // be considered refilled. in that case, there's no need to set _isStarved to true.
     _isStarved = (_ringBuffer.framesAvailable() < _desiredJitterBufferFrames);
-
-    // record the time of this starve in the starve history
-    quint64 now = usecTimestampNow();
-    _starveHistory.insert(now);
-
-    if (_dynamicJitterBufferEnabled) {
-        // dynamic jitter buffers are enabled. check if this starve put us over the window
-        // starve threshold
-        quint64 windowEnd = now - WINDOW_SECONDS_FOR_DESIRED_CALC_ON_TOO_MANY_STARVES * USECS_PER_SECOND;
-        RingBufferHistory<quint64>::Iterator starvesIterator = _starveHistory.begin();
-        RingBufferHistory<quint64>::Iterator end = _starveHistory.end();
-        int starvesInWindow = 1;
-        do {
-            ++starvesIterator;
-            if (*starvesIterator < windowEnd) {
-                break;
-            }
-            starvesInWindow++;
-        } while (starvesIterator != end);
-
-        // this starve put us over the starve threshold. update _desiredJitterBufferFrames to
-        // value determined by window A.
-        if (starvesInWindow >= WINDOW_STARVE_THRESHOLD) {
-            int calculatedJitterBufferFrames;
-            // we don't know when the next packet will arrive, so it's possible the gap between the last packet and the
-            // next packet will exceed the max time gap in the window.  If the time since the last packet has already exceeded
-            // the window max gap, then we should use that value to calculate desired frames.
-            int framesSinceLastPacket = ceilf((float)(now - _lastPacketReceivedTime)
-                                              / (float)AudioConstants::NETWORK_FRAME_USECS);
-            calculatedJitterBufferFrames = std::max(_calculatedJitterBufferFrames, framesSinceLastPacket);
-            // make sure _desiredJitterBufferFrames does not become lower here
-            if (calculatedJitterBufferFrames >= _desiredJitterBufferFrames) {
-                _desiredJitterBufferFrames = calculatedJitterBufferFrames;
-                qCInfo(audiostream, "Set desired jitter frames to %d (starved)", _desiredJitterBufferFrames);
-            }
-        }
-    }
 }
 
 void InboundAudioStream::setDynamicJitterBufferEnabled(bool enable) {
@@ -470,8 +500,9 @@ void InboundAudioStream::setDynamicJitterBufferEnabled(bool enable) {
         _desiredJitterBufferFrames = _staticJitterBufferFrames;
     } else {
         if (!_dynamicJitterBufferEnabled) {
-            // if we're enabling dynamic jitter buffer frames, start desired frames at 1
-            _desiredJitterBufferFrames = 1;
+            // if we're enabling dynamic jitter buffer frames, start desired frames at what the estimator has so far
+            _desiredJitterBufferFrames = _jitterEstimator.getPacketsReceived() > JITTER_ESTIMATOR_INITIAL_PACKETS ?
+                std::min(_jitterEstimator.getTargetFrames(), _ringBuffer.getFrameCapacity()) : 1;
         }
     }
     _dynamicJitterBufferEnabled = enable;
@@ -484,37 +515,27 @@ void InboundAudioStream::setStaticJitterBufferFrames(int staticJitterBufferFrame
     }
 }
 
-void InboundAudioStream::packetReceivedUpdateTimingStats() {
-    
-    // update our timegap stats and desired jitter buffer frames if necessary
+void InboundAudioStream::packetReceivedUpdateTimingStats(quint16 sequence,
+                                                          const SequenceNumberStats::ArrivalInfo& arrivalInfo) {
+    quint64 now = usecTimestampNow();
+
+    // update our timegap stats, which are only reported now
     // discard the first few packets we receive since they usually have gaps that aren't represensative of normal jitter
     const quint32 NUM_INITIAL_PACKETS_DISCARD = 1000; // 10s
-    quint64 now = usecTimestampNow();
     if (_incomingSequenceNumberStats.getReceived() > NUM_INITIAL_PACKETS_DISCARD) {
         quint64 gap = now - _lastPacketReceivedTime;
         _timeGapStatsForStatsPacket.update(gap);
+    }
 
-        // update all stats used for desired frames calculations under dynamic jitter buffer mode
-        _timeGapStatsForDesiredCalcOnTooManyStarves.update(gap);
-        _timeGapStatsForDesiredReduction.update(gap);
-
-        if (_timeGapStatsForDesiredCalcOnTooManyStarves.getNewStatsAvailableFlag()) {
-            _calculatedJitterBufferFrames = ceilf((float)_timeGapStatsForDesiredCalcOnTooManyStarves.getWindowMax()
-                                                             / (float) AudioConstants::NETWORK_FRAME_USECS);
-            _timeGapStatsForDesiredCalcOnTooManyStarves.clearNewStatsAvailableFlag();
-        }
+    // the jitter estimator works from the sequence numbers, so it takes late packets too, but not ones that make no sense
+    if (arrivalInfo._status != SequenceNumberStats::Unreasonable) {
+        _jitterEstimator.packetReceived(sequence, now);
 
-        if (_dynamicJitterBufferEnabled) {
-            // if the max gap in window B (_timeGapStatsForDesiredReduction) corresponds to a smaller number of frames than _desiredJitterBufferFrames,
-            // then reduce _desiredJitterBufferFrames to that number of frames.
-            if (_timeGapStatsForDesiredReduction.getNewStatsAvailableFlag() && _timeGapStatsForDesiredReduction.isWindowFilled()) {
-                int calculatedJitterBufferFrames = ceilf((float)_timeGapStatsForDesiredReduction.getWindowMax()
-                                                         / (float)AudioConstants::NETWORK_FRAME_USECS);
-                if (calculatedJitterBufferFrames < _desiredJitterBufferFrames) {
-                    _desiredJitterBufferFrames = calculatedJitterBufferFrames;
-                    qCInfo(audiostream, "Set desired jitter frames to %d (reduced)", _desiredJitterBufferFrames);
-                }
-                _timeGapStatsForDesiredReduction.clearNewStatsAvailableFlag();
+        if (_dynamicJitterBufferEnabled && _jitterEstimator.getPacketsReceived() > JITTER_ESTIMATOR_INITIAL_PACKETS) {
+            int desiredJitterBufferFrames = std::min(_jitterEstimator.getTargetFrames(), _ringBuffer.getFrameCapacity());
+            if (desiredJitterBufferFrames != _desiredJitterBufferFrames) {
+                _desiredJitterBufferFrames = desiredJitterBufferFrames;
+                qCDebug(audiostream, "Set desired jitter frames to %d (estimated)", _desiredJitterBufferFrames);
             }
         }
     }
@@ -578,6 +599,9 @@ void InboundAudioStream::setupCodec(CodecPluginPointer codec, const QString& cod
 }
 
 void InboundAudioStream::cleanupCodec() {
+    // whatever came in for the old codec is decoded with it
+    decodePendingFrames();
+
     // release any old codec encoder/decoder first...
     if (_codec) {
         QMutexLocker lock(&_decoderMutex);
@@ -12,6 +12,8 @@
 #ifndef hifi_InboundAudioStream_h
 #define hifi_InboundAudioStream_h
 
+#include <vector>
+
 #include <Node.h>
 #include <NodeData.h>
 #include <NumericalConstants.h>
@@ -21,6 +23,7 @@
 
 #include <plugins/CodecPlugin.h>
 
+#include "AudioJitterEstimator.h"
 #include "AudioRingBuffer.h"
 #include "MovingMinMaxAvg.h"
 #include "SequenceNumberStats.h"
@@ -41,10 +44,10 @@ public:
     static const int DEFAULT_STATIC_JITTER_FRAMES;
     // legacy (now static) settings
     static const int MAX_FRAMES_OVER_DESIRED;
+    // unused (eradicated) settings
     static const int WINDOW_STARVE_THRESHOLD;
     static const int WINDOW_SECONDS_FOR_DESIRED_CALC_ON_TOO_MANY_STARVES;
     static const int WINDOW_SECONDS_FOR_DESIRED_REDUCTION;
-    // unused (eradicated) settings
     static const bool USE_STDEV_FOR_JITTER;
     static const bool REPETITION_WITH_FADE;
 
@@ -58,6 +61,11 @@ public:
 
     virtual int parseData(ReceivedMessage& packet) override;
 
+    /// when deferred, parseData only queues what each packet holds, and decodePendingFrames decodes everything queued
+    /// since the last call in one go.  the audio-mixer does this on its packet processing workers, once per stream per frame
+    void setDecodeDeferred(bool deferred);
+    void decodePendingFrames();
+
     int popFrames(int maxFrames, bool allOrNothing);
     int popSamples(int maxSamples, bool allOrNothing);
 
@@ -74,7 +82,7 @@ public:
     virtual AudioStreamStats getAudioStreamStats() const;
 
     /// returns the desired number of jitter buffer frames under the dyanmic jitter buffers scheme
-    int getCalculatedJitterBufferFrames() const { return _calculatedJitterBufferFrames; }
+    int getCalculatedJitterBufferFrames() const { return _jitterEstimator.getTargetFrames(); }
     
     bool dynamicJitterBufferEnabled() const { return _dynamicJitterBufferEnabled; }
     int getStaticJitterBufferFrames() { return _staticJitterBufferFrames; }
@@ -109,13 +117,36 @@ signals:
     void mismatchedAudioCodec(SharedNodePointer sendingNode, const QString& currentCodec, const QString& recievedCodec);
 
 public slots:
-    /// This function should be called every second for all the stats to function properly. If dynamic jitter buffers
-    /// is enabled, those stats are used to calculate _desiredJitterBufferFrames.
-    /// If the stats are not used and dynamic jitter buffers is disabled, it's not necessary to call this function.
+    /// This function should be called every second for all the stats to function properly. The stats are only
+    /// reported; _desiredJitterBufferFrames comes from the jitter estimator as packets arrive.
+    /// If the stats are not used, it's not necessary to call this function.
     void perSecondCallbackForUpdatingStats();
 
 private:
-    void packetReceivedUpdateTimingStats();
+    void packetReceivedUpdateTimingStats(quint16 sequence, const SequenceNumberStats::ArrivalInfo& arrivalInfo);
+
+    // what a parsed packet writes to the ring buffer: the frames lost ahead of it, then its own
+    struct PendingPacket {
+        enum Frames {
+            None,
+            Audio,
+            PCM,
+            Silent
+        };
+
+        int numLostFrames { 0 };
+        Frames frames { None };
+        PacketType packetType { PacketType::Unknown };
+        int numSilentFrames { 0 };
+
+        // the received message the audio is in, which is shared rather than copied
+        QByteArray message;
+        int audioOffset { 0 };
+        int audioSize { 0 };
+    };
+
+    void writePacketFrames(const PendingPacket& packet);
+    void framesWritten();
 
     void popSamplesNoCheck(int samples);
     void framesAvailableChanged();
@@ -165,11 +196,7 @@ protected:
     SequenceNumberStats _incomingSequenceNumberStats;
 
     quint64 _lastPacketReceivedTime { 0 };
-    MovingMinMaxAvg<quint64> _timeGapStatsForDesiredCalcOnTooManyStarves { 0, WINDOW_SECONDS_FOR_DESIRED_CALC_ON_TOO_MANY_STARVES };
-    int _calculatedJitterBufferFrames { 0 };
-    MovingMinMaxAvg<quint64> _timeGapStatsForDesiredReduction { 0, WINDOW_SECONDS_FOR_DESIRED_REDUCTION };
-
-    RingBufferHistory<quint64> _starveHistory;
+    AudioJitterEstimator _jitterEstimator;
 
     TimeWeightedAvg<int> _framesAvailableStat;
     MovingMinMaxAvg<float> _unplayedMs;
@@ -187,9 +214,13 @@ protected:
 
     CodecPluginPointer _codec;
     QString _selectedCodecName;
-    QMutex _decoderMutex;
+    // recursive, so that a batch of pending packets is decoded under one lock
+    QMutex _decoderMutex { QMutex::Recursive };
     Decoder* _decoder { nullptr };
     int _mismatchedAudioCodecCount { 0 };
+
+    bool _decodeDeferred { false };
+    std::vector<PendingPacket> _pendingPackets;
 };
 
 float calculateRepeatedFrameFadeFactor(int indexOfRepeat);
@@ -0,0 +1,113 @@
+//
+//  InjectorWheel.h
+//  libraries/audio/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_InjectorWheel_h
+#define hifi_InjectorWheel_h
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// The timing wheel the audio injectors are scheduled on, with a slot per tick (a fraction of a network frame).  All of
+// the injectors due in a tick send their frames as a batch, and scheduling one costs the same however many there are.
+//
+// It has no clock of its own, the owner says what time it is.  Not thread safe.
+template <typename T>
+class InjectorWheel {
+public:
+    static const int NUM_SLOTS = 64;
+
+    InjectorWheel(uint64_t tickUsecs, uint64_t now) : _tickUsecs(tickUsecs), _currentTick(now / tickUsecs) {}
+
+    size_t size() const { return _size; }
+
+    // when the next tick that hasn't been processed yet starts
+    uint64_t getNextTickTimestamp() const { return _currentTick * _tickUsecs; }
+
+    // Rounded to the nearest tick, so something goes at most half a tick early or late.  Something that is already
+    // due goes in the next slot to be processed.
+    void schedule(uint64_t timestamp, T item) {
+        uint64_t tick = std::max((timestamp + _tickUsecs / 2) / _tickUsecs, _currentTick);
+        _slots[tick % NUM_SLOTS].emplace_back(tick, std::move(item));
+        ++_size;
+    }
+
+    // Hands everything due by now to send(T&), which returns the usecs from now until it is due again, or a negative
+    // number once it is done.  Returns how many were sent.
+    template <typename F>
+    size_t advance(uint64_t now, F&& send) {
+        uint64_t currentTick = now / _tickUsecs;
+        if (currentTick < _currentTick) {
+            return 0;
+        }
+
+        // after a stall of more than a turn of the wheel, one turn still goes through every slot
+        if (currentTick - _currentTick >= (uint64_t)NUM_SLOTS) {
+            _currentTick = currentTick - NUM_SLOTS + 1;
+        }
+
+        size_t numSent = 0;
+        for (; _currentTick <= currentTick; ++_currentTick) {
+            auto& slot = _slots[_currentTick % NUM_SLOTS];
+
+            // something that wants to go again right away lands back in this slot, so go until it is empty
+            while (!slot.empty()) {
+                std::swap(_batch, slot);
+
+                for (auto& tickItemPair : _batch) {
+                    if (tickItemPair.first > _currentTick) {
+                        // due in a later turn of the wheel
+                        _held.push_back(std::move(tickItemPair));
+                        continue;
+                    }
+
+                    --_size;
+                    ++numSent;
+                    int64_t nextDelta = send(tickItemPair.second);
+                    if (nextDelta >= 0) {
+                        schedule(now + nextDelta, std::move(tickItemPair.second));
+                    }
+                }
+                _batch.clear();
+            }
+
+            std::swap(slot, _held);
+        }
+        return numSent;
+    }
+
+    // empties the wheel, handing everything on it to f(T&)
+    template <typename F>
+    void clear(F&& f) {
+        for (auto& slot : _slots) {
+            for (auto& tickItemPair : slot) {
+                f(tickItemPair.second);
+            }
+            slot.clear();
+        }
+        _size = 0;
+    }
+
+private:
+    using TickItemPair = std::pair<uint64_t, T>;
+    using Slot = std::vector<TickItemPair>;
+
+    uint64_t _tickUsecs;
+    uint64_t _currentTick;
+    size_t _size { 0 };
+    std::array<Slot, NUM_SLOTS> _slots;
+    Slot _batch;
+    Slot _held;
+};
+
+#endif // hifi_InjectorWheel_h
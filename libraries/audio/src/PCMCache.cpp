@@ -0,0 +1,135 @@
+//
+//  PCMCache.cpp
+//  libraries/audio/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PCMCache.h"
+
+#include <QtCore/QCryptographicHash>
+
+#include "AudioLogging.h"
+
+using AudioConstants::AudioSample;
+
+const uint32_t PCMCache::CURRENT_VERSION = 0x01;
+
+namespace {
+
+const uint32_t PCM_MAGIC = 0x4d435048; // "HPCM"
+
+struct Header {
+    uint32_t magic { PCM_MAGIC };
+    uint32_t version { PCMCache::CURRENT_VERSION };
+    uint32_t numChannels { 0 };
+    uint32_t numSamples { 0 };
+};
+
+// Maps a cached file, and keeps it from being evicted for as long as it is mapped
+class MappedFile : public storage::Storage {
+public:
+    MappedFile(const cache::FilePointer& file) : _file(file), _storage(QString::fromStdString(file->getFilepath())) {}
+
+    const uint8_t* data() const override { return _storage.data(); }
+    uint8_t* mutableData() override { return nullptr; }
+    size_t size() const override { return _storage.size(); }
+    operator bool() const override { return (bool)_storage; }
+
+private:
+    const cache::FilePointer _file;
+    const storage::FileStorage _storage;
+};
+
+}
+
+PCMCache::PCMCache(const std::string& dir, const std::string& ext) :
+    FileCache(dir, ext) { }
+
+PCMCache::Key PCMCache::makeKey(const QString& format, const QByteArray& data) {
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(format.toUtf8());
+    hash.addData(data);
+    return hash.result().toHex().toStdString();
+}
+
+AudioDataPointer PCMCache::getAudioData(const Key& key) {
+    std::lock_guard<std::mutex> lock(_audioDataMutex);
+
+    if (auto audioData = findAudioData(key)) {
+        return audioData;
+    }
+
+    auto file = getFile(key);
+    if (!file) {
+        return AudioDataPointer();
+    }
+
+    auto audioData = mapFile(file);
+    if (audioData) {
+        _audioData[key] = audioData;
+    }
+    return audioData;
+}
+
+AudioDataPointer PCMCache::writeAudioData(const Key& key, uint32_t numChannels, const QByteArray& samples) {
+    uint32_t numSamples = samples.size() / AudioConstants::SAMPLE_SIZE;
+
+    Header header;
+    header.numChannels = numChannels;
+    header.numSamples = numSamples;
+    QByteArray data(reinterpret_cast<const char*>(&header), sizeof(Header));
+    data.append(samples.constData(), numSamples * AudioConstants::SAMPLE_SIZE);
+
+    {
+        std::lock_guard<std::mutex> lock(_audioDataMutex);
+
+        // the same sound may have been decoded twice at once
+        if (auto audioData = findAudioData(key)) {
+            return audioData;
+        }
+
+        // overwrite whatever is there, a file of another version or one that didn't map
+        auto file = writeFile(data.constData(), Metadata(key, data.size()), true);
+        auto audioData = file ? mapFile(file) : AudioDataPointer();
+        if (audioData) {
+            _audioData[key] = audioData;
+            return audioData;
+        }
+    }
+
+    qCWarning(audio) << "PCMCache could not cache sound" << key.c_str();
+    return AudioData::make(numSamples, numChannels, reinterpret_cast<const AudioSample*>(samples.constData()));
+}
+
+AudioDataPointer PCMCache::findAudioData(const Key& key) {
+    auto it = _audioData.find(key);
+    if (it == _audioData.end()) {
+        return AudioDataPointer();
+    }
+
+    auto audioData = it->second.lock();
+    if (!audioData) {
+        _audioData.erase(it);
+    }
+    return audioData;
+}
+
+AudioDataPointer PCMCache::mapFile(const cache::FilePointer& file) {
+    auto storage = std::make_shared<MappedFile>(file);
+    if (!*storage || storage->size() < sizeof(Header)) {
+        return AudioDataPointer();
+    }
+
+    auto header = reinterpret_cast<const Header*>(storage->data());
+    if (header->magic != PCM_MAGIC || header->version != CURRENT_VERSION || header->numChannels == 0) {
+        return AudioDataPointer();
+    }
+
+    // fails if the file is shorter than its header says
+    return AudioData::make(header->numSamples, header->numChannels, storage, sizeof(Header));
+}
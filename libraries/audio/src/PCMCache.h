@@ -0,0 +1,54 @@
+//
+//  PCMCache.h
+//  libraries/audio/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PCMCache_h
+#define hifi_PCMCache_h
+
+#include <mutex>
+#include <unordered_map>
+
+#include <QtCore/QByteArray>
+
+#include <shared/FileCache.h>
+
+#include "Sound.h"
+
+// Keeps sounds on disk the way injectors send them, 16-bit PCM at 24 kHz, so that they are decoded and resampled once.
+// The cached samples are mapped rather than read, and a sound that is in use is shared by everyone who asks for it.
+class PCMCache : public cache::FileCache {
+    Q_OBJECT
+
+public:
+    // Whenever a change is made to the serialized format of the PCM cache, this value should be incremented.
+    // Files of other versions are ignored, and overwritten as their sounds are decoded again.
+    static const uint32_t CURRENT_VERSION;
+
+    PCMCache(const std::string& dir, const std::string& ext);
+
+    // the key of the sound decoded from the data of the given format (the file extension)
+    static Key makeKey(const QString& format, const QByteArray& data);
+
+    // the sound, if it is cached
+    AudioDataPointer getAudioData(const Key& key);
+
+    // caches the samples of the sound, and returns them shared from the cache (or copied, if they couldn't be cached)
+    AudioDataPointer writeAudioData(const Key& key, uint32_t numChannels, const QByteArray& samples);
+
+private:
+    // these are called with the audio data mutex locked
+    AudioDataPointer findAudioData(const Key& key);
+    AudioDataPointer mapFile(const cache::FilePointer& file);
+
+    std::mutex _audioDataMutex;
+    std::unordered_map<Key, std::weak_ptr<const AudioData>> _audioData;
+};
+
+#endif // hifi_PCMCache_h
@@ -32,6 +32,7 @@
 #include "AudioLogging.h"
 #include "AudioSRC.h"
 #include "SndfileConverter.h"
+#include "SoundCache.h"
 
 int audioDataPointerMetaTypeID = qRegisterMetaType<AudioDataPointer>("AudioDataPointer");
 
@@ -63,10 +64,23 @@ AudioDataPointer AudioData::make(uint32_t numSamples, uint32_t numChannels,
 }
 
 
-AudioData::AudioData(uint32_t numSamples, uint32_t numChannels, const AudioSample* samples)
+AudioDataPointer AudioData::make(uint32_t numSamples, uint32_t numChannels,
+                                 const storage::StoragePointer& storage, size_t offset) {
+    if (!storage || offset + numSamples * sizeof(AudioSample) > storage->size()) {
+        return AudioDataPointer();
+    }
+
+    // The storage lives as long as the audio data does
+    auto samples = reinterpret_cast<const AudioSample*>(storage->data() + offset);
+    return AudioDataPointer(new AudioData(numSamples, numChannels, samples, storage));
+}
+
+AudioData::AudioData(uint32_t numSamples, uint32_t numChannels, const AudioSample* samples,
+                     const storage::StoragePointer& storage)
     : _numSamples(numSamples),
       _numChannels(numChannels),
-      _data(samples)
+      _data(samples),
+      _storage(storage)
 {}
 
 void Sound::downloadFinished(const QByteArray& data) {
@@ -126,6 +140,21 @@ void SoundProcessor::run() {
     SndfileConverter converter;
     auto converterExts = converter.getAvailableExtensions();
 
+    // a sound decoded before by this process, or already on disk when the PCM cache was opened, is mapped straight
+    // from the cache
+    std::shared_ptr<PCMCache> pcmCache;
+    PCMCache::Key key;
+    if (ext == "stereo.raw" || ext == "raw" || converterExts.contains(ext)) {
+        if (auto soundCache = DependencyManager::get<SoundCache>()) {
+            pcmCache = soundCache->getPCMCache();
+            key = PCMCache::makeKey(ext, _data);
+            if (auto audioData = pcmCache->getAudioData(key)) {
+                emit onSuccess(audioData);
+                return;
+            }
+        }
+    }
+
     if (ext == "stereo.raw") {
         qCDebug(audio) << "Processing sound of" << _data.size() << "bytes from" << fileName << "as stereo audio file.";
         properties.numChannels = 2;
@@ -155,9 +184,14 @@ void SoundProcessor::run() {
 
     auto data = downSample(outputAudioByteArray, properties);
 
-    int numSamples = data.size() / AudioConstants::SAMPLE_SIZE;
-    auto audioData = AudioData::make(numSamples, properties.numChannels,
-                                     (const AudioSample*)data.constData());
+    AudioDataPointer audioData;
+    if (pcmCache) {
+        audioData = pcmCache->writeAudioData(key, properties.numChannels, data);
+    } else {
+        int numSamples = data.size() / AudioConstants::SAMPLE_SIZE;
+        audioData = AudioData::make(numSamples, properties.numChannels,
+                                    (const AudioSample*)data.constData());
+    }
     emit onSuccess(audioData);
 }
 
@@ -18,6 +18,7 @@
 #include <QtScript/qscriptengine.h>
 
 #include <ResourceCache.h>
+#include <shared/Storage.h>
 
 #include "AudioConstants.h"
 
@@ -37,6 +38,10 @@ public:
     static AudioDataPointer make(uint32_t numSamples, uint32_t numChannels,
                                  const AudioSample* samples);
 
+    // Shares the samples in the storage from the offset on, a mapped file for example, instead of copying them
+    static AudioDataPointer make(uint32_t numSamples, uint32_t numChannels,
+                                 const storage::StoragePointer& storage, size_t offset = 0);
+
     uint32_t getNumSamples() const { return _numSamples; }
     uint32_t getNumChannels() const { return _numChannels; }
     const AudioSample* data() const { return _data; }
@@ -49,11 +54,13 @@ public:
     uint32_t getNumBytes() const { return _numSamples * sizeof(AudioSample); }
 
 private:
-    AudioData(uint32_t numSamples, uint32_t numChannels, const AudioSample* samples);
+    AudioData(uint32_t numSamples, uint32_t numChannels, const AudioSample* samples,
+              const storage::StoragePointer& storage = storage::StoragePointer());
 
     const uint32_t _numSamples { 0 };
     const uint32_t _numChannels { 0 };
     const AudioSample* const _data { nullptr };
+    const storage::StoragePointer _storage;
 };
 
 class Sound : public Resource {
@@ -21,12 +21,17 @@ static const int SOUNDS_LOADING_PRIORITY { -7 }; // Make sure sounds load after
 
 int soundPointerMetaTypeId = qRegisterMetaType<SharedSoundPointer>();
 
+const std::string SoundCache::PCM_DIRNAME { "pcm_cache" };
+const std::string SoundCache::PCM_EXT { "pcm" };
+
 SoundCache::SoundCache(QObject* parent) :
     ResourceCache(parent)
 {
     const qint64 SOUND_DEFAULT_UNUSED_MAX_SIZE = 50 * BYTES_PER_MEGABYTES;
     setUnusedResourceCacheSize(SOUND_DEFAULT_UNUSED_MAX_SIZE);
     setObjectName("SoundCache");
+
+    _pcmCache->initialize();
 }
 
 SharedSoundPointer SoundCache::getSound(const QUrl& url) {
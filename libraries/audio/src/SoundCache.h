@@ -14,6 +14,7 @@
 
 #include <ResourceCache.h>
 
+#include "PCMCache.h"
 #include "Sound.h"
 
 class SoundCache : public ResourceCache, public Dependency {
@@ -23,12 +24,20 @@ class SoundCache : public ResourceCache, public Dependency {
 public:
     Q_INVOKABLE SharedSoundPointer getSound(const QUrl& url);
 
+    // the decoded sounds, shared among processes and kept across runs
+    const std::shared_ptr<PCMCache>& getPCMCache() const { return _pcmCache; }
+
 protected:
     virtual QSharedPointer<Resource> createResource(const QUrl& url) override;
     QSharedPointer<Resource> createResourceCopy(const QSharedPointer<Resource>& resource) override;
 
 private:
     SoundCache(QObject* parent = NULL);
+
+    static const std::string PCM_DIRNAME;
+    static const std::string PCM_EXT;
+
+    std::shared_ptr<PCMCache> _pcmCache { std::make_shared<PCMCache>(PCM_DIRNAME, PCM_EXT) };
 };
 
 #endif // hifi_SoundCache_h
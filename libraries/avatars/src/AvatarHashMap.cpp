@@ -11,8 +11,11 @@
 
 #include "AvatarHashMap.h"
 
+#include <algorithm>
+
 #include <QtCore/QDataStream>
 
+#include <Finally.h>
 #include <NodeList.h>
 #include <udt/PacketHeaders.h>
 #include <PerfStat.h>
@@ -347,15 +350,25 @@ void AvatarHashMap::processBulkAvatarTraits(QSharedPointer<ReceivedMessage> mess
 
     message->readPrimitive(&seq);
 
-    auto traitsAckPacket = NLPacket::create(PacketType::BulkAvatarTraitsAck, sizeof(AvatarTraits::TraitMessageSequence), true);
-    traitsAckPacket->writePrimitive(seq);
-    auto nodeList = DependencyManager::get<LimitedNodeList>();
-    SharedNodePointer avatarMixer = nodeList->soloNodeOfType(NodeType::AvatarMixer);
-    if (!avatarMixer.isNull()) {
-        // we have a mixer to send to, acknowledge that we received these
-        // traits.
-        nodeList->sendPacket(std::move(traitsAckPacket), *avatarMixer);
-    }
+    // avatars we dropped a delta for, because we didn't hold the version it was based on; the mixer sends all
+    // of their traits again when they come back with the ack
+    std::vector<QUuid> avatarsMissingTraits;
+
+    Finally sendAck([&] {
+        auto traitsAckPacket = NLPacket::create(PacketType::BulkAvatarTraitsAck, sizeof(AvatarTraits::TraitMessageSequence) +
+                                                avatarsMissingTraits.size() * NUM_BYTES_RFC4122_UUID, true);
+        traitsAckPacket->writePrimitive(seq);
+        for (const auto& avatarID : avatarsMissingTraits) {
+            traitsAckPacket->write(avatarID.toRfc4122());
+        }
+        auto nodeList = DependencyManager::get<LimitedNodeList>();
+        SharedNodePointer avatarMixer = nodeList->soloNodeOfType(NodeType::AvatarMixer);
+        if (!avatarMixer.isNull()) {
+            // we have a mixer to send to, acknowledge that we received these
+            // traits.
+            nodeList->sendPacket(std::move(traitsAckPacket), *avatarMixer);
+        }
+    });
 
     while (message->getBytesLeftToRead() > 0) {
         // Trying to read more bytes than available, bail
@@ -429,6 +442,22 @@ void AvatarHashMap::processBulkAvatarTraits(QSharedPointer<ReceivedMessage> mess
 
                 message->readPrimitive(&traitBinarySize);
 
+                // the mixer can send only what changed since the version we already hold
+                AvatarTraits::TraitVersion deltaBaseVersion = AvatarTraits::NULL_TRAIT_VERSION;
+                if (traitBinarySize == AvatarTraits::DELTA_TRAIT_SIZE) {
+                    if (message->getBytesLeftToRead() < qint64(sizeof(AvatarTraits::TraitVersion) +
+                                                               sizeof(AvatarTraits::TraitWireSize))) {
+                        qWarning() << "Malformed bulk trait packet, bailling";
+                        return;
+                    }
+                    message->readPrimitive(&deltaBaseVersion);
+                    message->readPrimitive(&traitBinarySize);
+                    if (traitBinarySize < 0) {
+                        qWarning() << "Malformed bulk trait packet, bailling";
+                        return;
+                    }
+                }
+
                 // Trying to read more bytes than available, bail
                 if (traitBinarySize < -1 || message->getBytesLeftToRead() < traitBinarySize) {
                     qWarning() << "Malformed bulk trait packet, bailling";
@@ -440,12 +469,29 @@ void AvatarHashMap::processBulkAvatarTraits(QSharedPointer<ReceivedMessage> mess
                     if (traitBinarySize == AvatarTraits::DELETED_TRAIT_SIZE) {
                         avatar->processDeletedTraitInstance(traitType, traitInstanceID);
                         _replicas.processDeletedTraitInstance(avatarID, traitType, traitInstanceID);
+                        processedInstanceVersion = packetTraitVersion;
                     } else {
                         auto traitData = message->read(traitBinarySize);
-                        avatar->processTraitInstance(traitType, traitInstanceID, traitData);
-                        _replicas.processTraitInstance(avatarID, traitType, traitInstanceID, traitData);
+                        bool isValid = true;
+                        if (deltaBaseVersion != AvatarTraits::NULL_TRAIT_VERSION) {
+                            QByteArray baseData = avatar->packTraitInstance(traitType, traitInstanceID);
+                            isValid = processedInstanceVersion == deltaBaseVersion &&
+                                AvatarTraits::decodeTraitDelta(baseData, traitData, traitData);
+                        }
+
+                        if (isValid) {
+                            avatar->processTraitInstance(traitType, traitInstanceID, traitData);
+                            _replicas.processTraitInstance(avatarID, traitType, traitInstanceID, traitData);
+                            processedInstanceVersion = packetTraitVersion;
+                        } else {
+                            qWarning() << "Dropping trait delta for" << traitInstanceID << "based on version"
+                                       << deltaBaseVersion << "while holding version" << processedInstanceVersion;
+                            if (std::find(avatarsMissingTraits.begin(), avatarsMissingTraits.end(), avatarID) ==
+                                avatarsMissingTraits.end()) {
+                                avatarsMissingTraits.push_back(avatarID);
+                            }
+                        }
                     }
-                    processedInstanceVersion = packetTraitVersion;
                 } else {
                     skipBinaryTrait = true;
                 }
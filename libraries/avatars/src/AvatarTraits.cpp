@@ -11,6 +11,8 @@
 
 #include "AvatarTraits.h"
 
+#include <cstring>
+
 #include <ExtendedIODevice.h>
 
 #include "AvatarData.h"
@@ -132,4 +134,186 @@ namespace AvatarTraits {
         bytesWritten += destination.writePrimitive(DELETED_TRAIT_SIZE);
         return bytesWritten;
     }
+
+    qint64 packVersionedTraitInstanceDelta(TraitType traitType, TraitInstanceID traitInstanceID,
+                                           ExtendedIODevice& destination, TraitVersion traitVersion,
+                                           TraitVersion baseVersion, const QByteArray& delta) {
+        if (delta.size() > MAXIMUM_TRAIT_SIZE) {
+            qWarning() << "Refusing to pack instanced trait delta" << traitType << "of size" << delta.size()
+                        << "bytes since it exceeds the maximum size " << MAXIMUM_TRAIT_SIZE << "bytes";
+            return 0;
+        }
+
+        qint64 bytesWritten = 0;
+        bytesWritten += destination.writePrimitive((TraitType)traitType);
+        bytesWritten += destination.writePrimitive((TraitVersion)traitVersion);
+        bytesWritten += destination.write(traitInstanceID.toRfc4122());
+        bytesWritten += destination.writePrimitive(DELTA_TRAIT_SIZE);
+        bytesWritten += destination.writePrimitive((TraitVersion)baseVersion);
+        bytesWritten += destination.writePrimitive((TraitWireSize)delta.size());
+        bytesWritten += destination.write(delta);
+        return bytesWritten;
+    }
+
+    qint64 packVersionedTraitInstanceUpdate(TraitType traitType, TraitInstanceID traitInstanceID,
+                                            ExtendedIODevice& destination, TraitVersion traitVersion,
+                                            const QByteArray& payload, TraitVersion baseVersion,
+                                            const QByteArray* basePayload, qint64& bytesSavedByDelta) {
+        bytesSavedByDelta = 0;
+        if (payload.size() > MAXIMUM_TRAIT_SIZE) {
+            qWarning() << "Refusing to pack instanced trait" << traitType << "of size" << payload.size()
+                        << "bytes since it exceeds the maximum size " << MAXIMUM_TRAIT_SIZE << "bytes";
+            return 0;
+        }
+
+        if (basePayload) {
+            auto delta = encodeTraitDelta(*basePayload, payload);
+            // a delta carries a base version and a second size on top of what a whole instance needs
+            const qint64 DELTA_OVERHEAD = sizeof(TraitVersion) + sizeof(TraitWireSize);
+            qint64 savedBytes = (qint64)payload.size() - (qint64)delta.size() - DELTA_OVERHEAD;
+            if (savedBytes > 0) {
+                bytesSavedByDelta = savedBytes;
+                return packVersionedTraitInstanceDelta(traitType, traitInstanceID, destination, traitVersion,
+                                                       baseVersion, delta);
+            }
+        }
+
+        qint64 bytesWritten = 0;
+        bytesWritten += destination.writePrimitive((TraitType)traitType);
+        bytesWritten += destination.writePrimitive((TraitVersion)traitVersion);
+        bytesWritten += destination.write(traitInstanceID.toRfc4122());
+        bytesWritten += destination.writePrimitive((TraitWireSize)payload.size());
+        bytesWritten += destination.write(payload);
+        return bytesWritten;
+    }
+
+    namespace {
+        enum DeltaOperation : uint8_t {
+            CopyFromBase,   // uint16 base offset, uint16 length
+            InsertLiteral   // uint16 length, bytes
+        };
+
+        // unchanged runs shorter than this cost more as a copy than as part of a literal
+        const int MIN_DELTA_COPY_LENGTH = 8;
+
+        void appendUInt16(QByteArray& delta, uint16_t value) {
+            delta.append(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        void appendCopy(QByteArray& delta, int offset, int length) {
+            if (length > 0) {
+                delta.append((char)CopyFromBase);
+                appendUInt16(delta, (uint16_t)offset);
+                appendUInt16(delta, (uint16_t)length);
+            }
+        }
+
+        void appendLiteral(QByteArray& delta, const char* bytes, int length) {
+            if (length > 0) {
+                delta.append((char)InsertLiteral);
+                appendUInt16(delta, (uint16_t)length);
+                delta.append(bytes, length);
+            }
+        }
+
+        bool readUInt16(const QByteArray& delta, int& position, int& value) {
+            uint16_t raw;
+            if (position + (int)sizeof(raw) > delta.size()) {
+                return false;
+            }
+            memcpy(&raw, delta.constData() + position, sizeof(raw));
+            position += sizeof(raw);
+            value = raw;
+            return true;
+        }
+    }
+
+    QByteArray encodeTraitDelta(const QByteArray& base, const QByteArray& target) {
+        const int baseSize = base.size();
+        const int targetSize = target.size();
+        const char* baseData = base.constData();
+        const char* targetData = target.constData();
+
+        QByteArray delta;
+        appendUInt16(delta, (uint16_t)targetSize);
+
+        const int commonSize = std::min(baseSize, targetSize);
+        int prefix = 0;
+        while (prefix < commonSize && baseData[prefix] == targetData[prefix]) {
+            ++prefix;
+        }
+        int suffix = 0;
+        while (suffix < commonSize - prefix && baseData[baseSize - 1 - suffix] == targetData[targetSize - 1 - suffix]) {
+            ++suffix;
+        }
+
+        appendCopy(delta, 0, prefix);
+
+        const int middleEnd = targetSize - suffix;
+        if (baseSize == targetSize) {
+            // same layout, so keep whatever is unchanged in the middle as well
+            int literalStart = prefix;
+            int position = prefix;
+            while (position < middleEnd) {
+                int runEnd = position;
+                while (runEnd < middleEnd && baseData[runEnd] == targetData[runEnd]) {
+                    ++runEnd;
+                }
+                if (runEnd - position >= MIN_DELTA_COPY_LENGTH) {
+                    appendLiteral(delta, targetData + literalStart, position - literalStart);
+                    appendCopy(delta, position, runEnd - position);
+                    literalStart = runEnd;
+                }
+                position = std::max(runEnd, position + 1);
+            }
+            appendLiteral(delta, targetData + literalStart, middleEnd - literalStart);
+        } else {
+            appendLiteral(delta, targetData + prefix, middleEnd - prefix);
+        }
+
+        appendCopy(delta, baseSize - suffix, suffix);
+        return delta;
+    }
+
+    bool decodeTraitDelta(const QByteArray& base, const QByteArray& delta, QByteArray& target) {
+        int position = 0;
+        int targetSize;
+        if (!readUInt16(delta, position, targetSize)) {
+            return false;
+        }
+
+        QByteArray result;
+        result.reserve(targetSize);
+        while (position < delta.size()) {
+            auto operation = (uint8_t)delta[position++];
+            if (operation == CopyFromBase) {
+                int offset;
+                int length;
+                if (!readUInt16(delta, position, offset) || !readUInt16(delta, position, length) ||
+                    offset + length > base.size()) {
+                    return false;
+                }
+                result.append(base.constData() + offset, length);
+            } else if (operation == InsertLiteral) {
+                int length;
+                if (!readUInt16(delta, position, length) || position + length > delta.size()) {
+                    return false;
+                }
+                result.append(delta.constData() + position, length);
+                position += length;
+            } else {
+                return false;
+            }
+
+            if (result.size() > targetSize) {
+                return false;
+            }
+        }
+
+        if (result.size() != targetSize) {
+            return false;
+        }
+        target = result;
+        return true;
+    }
 };
@@ -54,6 +54,8 @@ namespace AvatarTraits {
 
     using TraitWireSize = int16_t;
     const TraitWireSize DELETED_TRAIT_SIZE = -1;
+    // the instance is sent as the changes since a version the receiver already has, see packVersionedTraitInstanceDelta
+    const TraitWireSize DELTA_TRAIT_SIZE = -2;
     const TraitWireSize MAXIMUM_TRAIT_SIZE = INT16_MAX;
 
     using TraitMessageSequence = int64_t;
@@ -73,6 +75,38 @@ namespace AvatarTraits {
     qint64 packInstancedTraitDelete(TraitType traitType, TraitInstanceID instanceID, ExtendedIODevice& destination,
                                            TraitVersion traitVersion = NULL_TRAIT_VERSION);
 
+    // Writes a versioned trait instance as a delta against baseVersion, which the receiver must be holding:
+    // type, version, instance ID, DELTA_TRAIT_SIZE, base version, delta size, delta
+    qint64 packVersionedTraitInstanceDelta(TraitType traitType, TraitInstanceID traitInstanceID,
+                                           ExtendedIODevice& destination, TraitVersion traitVersion,
+                                           TraitVersion baseVersion, const QByteArray& delta);
+
+    // Writes a newer version of an instance for a receiver holding baseVersion, whose payload was basePayload (null when
+    // that is no longer known): as a delta against it when that comes out smaller, otherwise whole.  Returns the bytes
+    // written, and sets bytesSavedByDelta to what the delta saved over the whole instance
+    qint64 packVersionedTraitInstanceUpdate(TraitType traitType, TraitInstanceID traitInstanceID,
+                                            ExtendedIODevice& destination, TraitVersion traitVersion,
+                                            const QByteArray& payload, TraitVersion baseVersion,
+                                            const QByteArray* basePayload, qint64& bytesSavedByDelta);
+
+    // The trait bytes sent to one receiver, and how much sending deltas instead of whole instances saved
+    struct SentTraitBytes {
+        qint64 sent { 0 };
+        qint64 savedByDeltas { 0 };
+
+        void record(qint64 bytesSent, qint64 bytesSavedByDeltas) {
+            sent += bytesSent;
+            savedByDeltas += bytesSavedByDeltas;
+        }
+    };
+
+    // A delta is the size of the target followed by a list of operations that build it up in order,
+    // either copying a range of the base or inserting literal bytes.  The encoder only looks for an
+    // unchanged prefix and suffix, plus unchanged runs in between when the size didn't change, which
+    // covers the usual edit of a few properties of an avatar entity.
+    QByteArray encodeTraitDelta(const QByteArray& base, const QByteArray& target);
+    bool decodeTraitDelta(const QByteArray& base, const QByteArray& delta, QByteArray& target);
+
 };
 
 #endif // hifi_AvatarTraits_h
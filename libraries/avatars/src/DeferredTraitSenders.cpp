@@ -0,0 +1,58 @@
+//
+//  DeferredTraitSenders.cpp
+//  libraries/avatars/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "DeferredTraitSenders.h"
+
+#include <algorithm>
+
+#include <NumericalConstants.h>
+
+const float DeferredTraitSenders::RECHECK_DISTANCE_FRACTION = 0.25f;
+const uint64_t DeferredTraitSenders::RECHECK_INTERVAL_USECS = USECS_PER_SECOND;
+
+bool DeferredTraitSenders::isOutsideInterest(const glm::vec3& listenerPosition, const glm::vec3& senderPosition,
+                                             float interestRadius) {
+    return interestRadius > 0.0f && glm::distance(listenerPosition, senderPosition) > interestRadius;
+}
+
+void DeferredTraitSenders::defer(NetworkLocalID sender, const glm::vec3& listenerPosition, uint64_t now) {
+    if (_senders.empty()) {
+        _listenerPosition = listenerPosition;
+        _deferredSince = now;
+    }
+    if (!isDeferred(sender)) {
+        _senders.push_back(sender);
+    }
+}
+
+void DeferredTraitSenders::remove(NetworkLocalID sender) {
+    _senders.erase(std::remove(_senders.begin(), _senders.end(), sender), _senders.end());
+}
+
+std::vector<NetworkLocalID> DeferredTraitSenders::release(const glm::vec3& listenerPosition, float interestRadius,
+                                                          uint64_t now) {
+    std::vector<NetworkLocalID> released;
+    if (_senders.empty()) {
+        return released;
+    }
+
+    // with no radius any more everything goes out
+    float recheckDistance = interestRadius * RECHECK_DISTANCE_FRACTION;
+    if (interestRadius <= 0.0f || glm::distance(listenerPosition, _listenerPosition) > recheckDistance ||
+        now - _deferredSince > RECHECK_INTERVAL_USECS) {
+        released.swap(_senders);
+    }
+    return released;
+}
+
+bool DeferredTraitSenders::isDeferred(NetworkLocalID sender) const {
+    return std::find(_senders.cbegin(), _senders.cend(), sender) != _senders.cend();
+}
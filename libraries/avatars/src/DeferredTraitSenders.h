@@ -0,0 +1,52 @@
+//
+//  DeferredTraitSenders.h
+//  libraries/avatars/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_DeferredTraitSenders_h
+#define hifi_DeferredTraitSenders_h
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <UUID.h>
+
+// The avatars whose avatar entities are held back from a listener because they are outside its interest radius.
+//
+// Rather than having their traits looked at again every frame, they wait here until the listener has moved a good part
+// of the radius, or long enough has passed for them to have come closer themselves, and are then all released at once.
+class DeferredTraitSenders {
+public:
+    // the part of the interest radius the listener has to move for the deferred avatars to be looked at again
+    static const float RECHECK_DISTANCE_FRACTION;
+    // how long the deferred avatars wait at most, since they may be the ones moving
+    static const uint64_t RECHECK_INTERVAL_USECS;
+
+    static bool isOutsideInterest(const glm::vec3& listenerPosition, const glm::vec3& senderPosition, float interestRadius);
+
+    void defer(NetworkLocalID sender, const glm::vec3& listenerPosition, uint64_t now);
+    void remove(NetworkLocalID sender);
+
+    // the avatars to look at again, if it is time to, which are no longer deferred
+    std::vector<NetworkLocalID> release(const glm::vec3& listenerPosition, float interestRadius, uint64_t now);
+
+    bool isDeferred(NetworkLocalID sender) const;
+    int size() const { return (int)_senders.size(); }
+
+private:
+    std::vector<NetworkLocalID> _senders;
+
+    // where the listener was and when, as the first of them was deferred
+    glm::vec3 _listenerPosition;
+    uint64_t _deferredSince { 0 };
+};
+
+#endif // hifi_DeferredTraitSenders_h
@@ -240,6 +240,8 @@ void ModelBaker::bakeSourceCopy() {
         auto config = baker.getConfiguration();
         // Enable compressed draco mesh generation
         config->getJobConfig("BuildDracoMesh")->setEnabled(true);
+        // The draco meshes reorder the vertices the LODs would index, so they are simplified again wherever the baked model loads
+        config->getJobConfig("BuildMeshLODs")->setEnabled(false);
         // Do not permit potentially lossy modification of joint data meant for runtime
         ((PrepareJointsConfig*)config->getJobConfig("PrepareJoints"))->passthrough = true;
     
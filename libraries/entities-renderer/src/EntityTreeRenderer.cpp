@@ -29,6 +29,7 @@
 #include <PerfStat.h>
 #include <PrioritySortUtil.h>
 #include <Rig.h>
+#include <TBBHelpers.h>
 #include <SceneScriptingInterface.h>
 #include <ScriptEngines.h>
 #include <EntitySimulation.h>
@@ -421,6 +422,34 @@ void EntityTreeRenderer::addPendingEntities(const render::ScenePointer& scene, r
     }
 }
 
+// Runs the thread safe half of each renderable's update across the TBB worker pool, so that the main thread
+// only has to commit the results into the transaction
+static void prepareRenderables(const std::vector<EntityRendererPointer>& renderables) {
+    PROFILE_RANGE_EX(simulation_physics, "PrepareRenderables", 0xffff00ff, (uint64_t)renderables.size());
+    const size_t MIN_RENDERABLES_PER_TASK = 16;
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, renderables.size(), MIN_RENDERABLES_PER_TASK),
+                      [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i != range.end(); ++i) {
+            renderables[i]->prepareRenderUpdate();
+        }
+    });
+}
+
+void EntityTreeRenderer::commitRenderableUpdate(const EntityRendererPointer& renderable, const render::ScenePointer& scene,
+                                                render::Transaction& transaction, uint64_t now) {
+    renderable->getEntity()->setNeedsRenderUpdate(true);
+    renderable->updateInScene(scene, transaction);
+
+    auto queuedTime = _renderUpdateQueuedTimes.find(renderable->getEntity()->getEntityItemID());
+    if (queuedTime != _renderUpdateQueuedTimes.end()) {
+        uint64_t latency = now > queuedTime->second ? now - queuedTime->second : 0;
+        _renderUpdateLatencyTotal += latency;
+        _renderUpdateLatencyMax = std::max(_renderUpdateLatencyMax, latency);
+        _renderUpdateLatencyCount++;
+        _renderUpdateQueuedTimes.erase(queuedTime);
+    }
+}
+
 void EntityTreeRenderer::updateChangedEntities(const render::ScenePointer& scene, render::Transaction& transaction) {
     PROFILE_RANGE_EX(simulation_physics, "ChangeInScene", 0xffff00ff, (uint64_t)_changedEntities.size());
     PerformanceTimer pt("change");
@@ -432,6 +461,10 @@ void EntityTreeRenderer::updateChangedEntities(const render::ScenePointer& scene
 
     _renderablesToUpdate.clear();
     _priorityRenderablesToUpdate.clear();
+    _renderUpdateLatencyTotal = 0;
+    _renderUpdateLatencyMax = 0;
+    _renderUpdateLatencyCount = 0;
+    uint64_t queuedTime = usecTimestampNow();
 
     {   // build list of renderables and priority renderables. 
         PROFILE_RANGE_EX(simulation_physics, "CopyRenderables", 0xffff00ff, (uint64_t)changedEntities.size());
@@ -461,15 +494,18 @@ void EntityTreeRenderer::updateChangedEntities(const render::ScenePointer& scene
 
                 if (_entityPriority == EntityPriority::AUTOMATIC) { 
                     _renderablesToUpdate.insert(renderable);
+                    _renderUpdateQueuedTimes.emplace(entityId, queuedTime);
                 } else if (_entityPriority == EntityPriority::PRIORITIZED) {
                     _priorityRenderablesToUpdate.insert(renderable);
+                    _renderUpdateQueuedTimes.emplace(entityId, queuedTime);
                 } else if (_entityPriority == EntityPriority::STATIC) {
                     _staticRenderablesToUpdate.insert(renderable); 
                 }
              }
-             else 
+             else if (renderable)
              {
                  _renderablesToUpdate.insert(renderable);
+                 _renderUpdateQueuedTimes.emplace(entityId, queuedTime);
              }
             
         }
@@ -482,12 +518,12 @@ void EntityTreeRenderer::updateChangedEntities(const render::ScenePointer& scene
         // Update all the priority items first
         // if (!_isEditMode && _priorityRenderablesToUpdate.size()>0)
         if (_priorityRenderablesToUpdate.size() > 0) {
-            for (const auto& renderable : _priorityRenderablesToUpdate) {
+            std::vector<EntityRendererPointer> renderables(_priorityRenderablesToUpdate.begin(), _priorityRenderablesToUpdate.end());
+            prepareRenderables(renderables);
+            uint64_t now = usecTimestampNow();
+            for (const auto& renderable : renderables) {
                 assert(renderable); // only valid renderables are added to _renderablesToUpdate
-                if (renderable != nullptr) {                    
-                    renderable->getEntity()->setNeedsRenderUpdate(true);
-                    renderable->updateInScene(scene, transaction);
-                }
+                commitRenderableUpdate(renderable, scene, transaction, now);
             }
         }
 
@@ -496,12 +532,12 @@ void EntityTreeRenderer::updateChangedEntities(const render::ScenePointer& scene
 
             uint64_t updateStart = usecTimestampNow();
 
-            for (const EntityRendererPointer& renderable : _renderablesToUpdate) {
+            std::vector<EntityRendererPointer> renderables(_renderablesToUpdate.begin(), _renderablesToUpdate.end());
+            prepareRenderables(renderables);
+            uint64_t now = usecTimestampNow();
+            for (const EntityRendererPointer& renderable : renderables) {
                 assert(renderable);  // only valid renderables are added to _renderablesToUpdate
-                if (renderable != nullptr) {
-                    renderable->getEntity()->setNeedsRenderUpdate(true);
-                    renderable->updateInScene(scene, transaction);
-                }
+                commitRenderableUpdate(renderable, scene, transaction, now);
             }
 
             _prevNumEntityUpdates = _renderablesToUpdate.size();
@@ -544,8 +580,18 @@ void EntityTreeRenderer::updateChangedEntities(const render::ScenePointer& scene
             {
                 PROFILE_RANGE_EX(simulation_physics, "SortAndUpdateRenderables", 0xffff00ff, sortedRenderables.size());
 
+                // Only sort to the front about as many renderables as we expect to have time to commit, plus a margin.
+                // Whatever else fits in the budget is committed in no particular order.
+                const float PREPARE_MARGIN = 1.5f;
+                const size_t MIN_RENDERABLES_TO_PREPARE = 64;
+                size_t numToSort = 2 * MIN_RENDERABLES_TO_PREPARE;
+                if (_avgRenderableUpdateCost > 0.0f) {
+                    numToSort = std::max(numToSort,
+                        (size_t)(2.0f * PREPARE_MARGIN * (float)MAX_UPDATE_RENDERABLES_TIME_BUDGET / _avgRenderableUpdateCost));
+                }
+                const auto& sortedRenderablesVector = sortedRenderables.getSortedVector((int)std::min(numToSort, sortedRenderables.size()));
+
                 // compute remaining time budget
-                const auto& sortedRenderablesVector = sortedRenderables.getSortedVector();
                 uint64_t updateStart = usecTimestampNow();
                 uint64_t sortCost = updateStart - sortStart;
                 uint64_t timeBudget = MIN_SORTED_UPDATE_RENDERABLES_TIME_BUDGET;
@@ -554,19 +600,43 @@ void EntityTreeRenderer::updateChangedEntities(const render::ScenePointer& scene
                 }
                 uint64_t expiry = updateStart + timeBudget;
 
+                // prepare, in parallel, about as many of the highest priority renderables as we expect to have
+                // time to commit.  Anything past that which still fits is committed without being prepared
+                size_t numToPrepare = MIN_RENDERABLES_TO_PREPARE;
+                if (_avgRenderableUpdateCost > 0.0f) {
+                    numToPrepare = std::max(numToPrepare, (size_t)(PREPARE_MARGIN * (float)timeBudget / _avgRenderableUpdateCost));
+                }
+                numToPrepare = std::min(numToPrepare, sortedRenderablesVector.size());
+                std::vector<EntityRendererPointer> renderablesToPrepare;
+                renderablesToPrepare.reserve(numToPrepare);
+                for (size_t i = 0; i < numToPrepare; ++i) {
+                    const auto& renderable = sortedRenderablesVector[i].getRenderer();
+                    if (renderable) {
+                        renderablesToPrepare.push_back(renderable);
+                    }
+                }
+                prepareRenderables(renderablesToPrepare);
+
                 // process the sorted renderables
                 for (const auto& sortedRenderable : sortedRenderablesVector) {
-                    if (usecTimestampNow() > expiry) {
+                    uint64_t now = usecTimestampNow();
+                    if (now > expiry) {
                         break;
                     }
                     const auto& renderable = sortedRenderable.getRenderer();
                     if (renderable != nullptr) {
-                        renderable->getEntity()->setNeedsRenderUpdate(true);
-                        renderable->updateInScene(scene, transaction);
+                        commitRenderableUpdate(renderable, scene, transaction, now);
                     }
                     _renderablesToUpdate.erase(renderable);
                 }
 
+                // the ones that were prepared but ran out of time are read again when they're next committed
+                for (const auto& renderable : renderablesToPrepare) {
+                    if (_renderablesToUpdate.find(renderable) != _renderablesToUpdate.end()) {
+                        renderable->discardPreparedRenderUpdate();
+                    }
+                }
+
                 // compute average per-renderable update cost
                 _prevNumEntityUpdates = sortedRenderables.size() - _renderablesToUpdate.size();
                 size_t numUpdated = _prevNumEntityUpdates + 1; // add one to avoid divide by zero
@@ -575,6 +645,19 @@ void EntityTreeRenderer::updateChangedEntities(const render::ScenePointer& scene
                 _avgRenderableUpdateCost = (1.0f - BLEND) * _avgRenderableUpdateCost + BLEND * cost;
             }
         }
+
+        // whatever didn't fit in this frame's budget is our backlog.  Keep the time those entities were first
+        // queued, so their latency counts from then if they're picked up again, and forget everything else
+        _renderUpdateBacklog = (int)_renderablesToUpdate.size();
+        std::unordered_map<EntityItemID, uint64_t> stillQueuedTimes;
+        for (const auto& renderable : _renderablesToUpdate) {
+            auto queued = _renderUpdateQueuedTimes.find(renderable->getEntity()->getEntityItemID());
+            if (queued != _renderUpdateQueuedTimes.end()) {
+                stillQueuedTimes.insert(*queued);
+            }
+        }
+        _renderUpdateQueuedTimes.swap(stillQueuedTimes);
+
         MeshPartPayload::sceneIsReady = true;
     }
 }
@@ -179,6 +179,12 @@ public:
 
     int getPrevNumEntityUpdates() const { return _prevNumEntityUpdates; }
     int getPrevTotalNeededEntityUpdates() const { return _prevTotalNeededEntityUpdates; }
+    int getRenderUpdateBacklog() const { return _renderUpdateBacklog; }
+    // time from an entity changing to its update being committed to the scene, over last frame's updates
+    float getAvgRenderUpdateLatency() const {
+        return _renderUpdateLatencyCount > 0 ? (float)_renderUpdateLatencyTotal / (float)(_renderUpdateLatencyCount * USECS_PER_MSEC) : 0.0f;
+    }
+    float getMaxRenderUpdateLatency() const { return (float)_renderUpdateLatencyMax / (float)USECS_PER_MSEC; }
 
 signals:
     void enterEntity(const EntityItemID& entityItemID);
@@ -301,6 +307,14 @@ private:
     int _prevNumEntityUpdates { 0 };
     int _prevTotalNeededEntityUpdates { 0 };
 
+    void commitRenderableUpdate(const EntityRendererPointer& renderable, const render::ScenePointer& scene,
+                                render::Transaction& transaction, uint64_t now);
+    std::unordered_map<EntityItemID, uint64_t> _renderUpdateQueuedTimes;
+    int _renderUpdateBacklog { 0 };
+    uint64_t _renderUpdateLatencyTotal { 0 };
+    uint64_t _renderUpdateLatencyMax { 0 };
+    uint64_t _renderUpdateLatencyCount { 0 };
+
     std::unordered_set<EntityRendererPointer> _renderablesToUpdate;
     std::unordered_set<EntityRendererPointer> _priorityRenderablesToUpdate;
     QSet<EntityRendererPointer> _staticRenderablesToUpdate;
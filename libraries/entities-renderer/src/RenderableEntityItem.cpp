@@ -325,6 +325,30 @@ void EntityRenderer::updateInScene(const ScenePointer& scene, Transaction& trans
     });
 }
 
+void EntityRenderer::prepareRenderUpdate() {
+    DETAILED_PROFILE_RANGE(simulation_physics, __FUNCTION__);
+    if (!isValidRenderItem()) {
+        return;
+    }
+
+    // walking the parent chain for the transforms is the expensive part, do it before taking our lock
+    PreparedRenderUpdate prepared;
+    prepared.modelTransform = _entity->getTransformToCenter(prepared.hasModelTransform);
+    prepared.bound = _entity->getAABox(prepared.hasBound);
+    prepared.isMoving = _entity->isMovingRelativeToParent();
+    prepared.isValid = true;
+
+    withWriteLock([&] {
+        _preparedUpdate = prepared;
+    });
+}
+
+void EntityRenderer::discardPreparedRenderUpdate() {
+    withWriteLock([&] {
+        _preparedUpdate.isValid = false;
+    });
+}
+
 //
 // Internal methods
 //
@@ -379,6 +403,16 @@ bool EntityRenderer::needsRenderUpdateFromEntity(const EntityItemPointer& entity
 }
 
 void EntityRenderer::updateModelTransformAndBound() {
+    if (_preparedUpdate.isValid) {
+        if (_preparedUpdate.hasModelTransform) {
+            _modelTransform = _preparedUpdate.modelTransform;
+        }
+        if (_preparedUpdate.hasBound) {
+            _bound = _preparedUpdate.bound;
+        }
+        return;
+    }
+
     bool success = false;
     auto newModelTransform = _entity->getTransformToCenter(success);
     if (success) {
@@ -411,7 +445,8 @@ void EntityRenderer::doRenderUpdateSynchronous(const ScenePointer& scene,
 
         updateModelTransformAndBound();
 
-        _moving = entity->isMovingRelativeToParent();
+        _moving = _preparedUpdate.isValid ? _preparedUpdate.isMoving : entity->isMovingRelativeToParent();
+        _preparedUpdate.isValid = false;
 
         //if (entity->getEntityPriority() == EntityPriority::STATIC) _moving = false; // statics can't move
 
@@ -46,6 +46,13 @@ public:
     // Handlers for rendering events... executed on the main thread, only called by EntityTreeRenderer, 
     // cannot be overridden or accessed by subclasses
     virtual void updateInScene(const ScenePointer& scene, Transaction& transaction) final;
+
+    // Thread safe first half of updateInScene, run on a worker pool by EntityTreeRenderer while the main
+    // thread waits.  Reads the entity's transform, bounds and motion, so updateInScene only commits them.
+    virtual void prepareRenderUpdate() final;
+    // drops what prepareRenderUpdate read when it won't be committed this frame, so that it can't be committed over
+    // newer entity state later
+    virtual void discardPreparedRenderUpdate() final;
     virtual bool addToScene(const ScenePointer& scene, Transaction& transaction) final;
     virtual void removeFromScene(const ScenePointer& scene, Transaction& transaction);
 
@@ -141,6 +148,18 @@ protected:
     const Transform& getModelTransform() const;
 
     Item::Bound _bound;
+
+    // filled in by prepareRenderUpdate and consumed by the next doRenderUpdateSynchronous
+    struct PreparedRenderUpdate {
+        Transform modelTransform;
+        Item::Bound bound;
+        bool hasModelTransform { false };
+        bool hasBound { false };
+        bool isMoving { false };
+        bool isValid { false };
+    };
+    PreparedRenderUpdate _preparedUpdate;
+
     SharedSoundPointer _collisionSound;
     QUuid _changeHandlerId;
     ItemID _renderItemID{ Item::INVALID_ITEM_ID };
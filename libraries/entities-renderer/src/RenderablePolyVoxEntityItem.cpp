@@ -13,6 +13,7 @@
 #include "RenderablePolyVoxEntityItem.h"
 
 #include <math.h>
+#include <limits>
 
 #include <glm/gtx/transform.hpp>
 
@@ -50,6 +51,7 @@
 
 #include <Model.h>
 #include <PerfStat.h>
+#include <TBBHelpers.h>
 #include <render/Scene.h>
 
 #ifdef _WIN32
@@ -76,15 +78,19 @@
 
 const float MARCHING_CUBE_COLLISION_HULL_OFFSET = 0.5;
 
+// how long the entity-server has to send back the bricks of an edit before they are sent again, and how many times
+const quint64 BRICK_RESEND_DELAY = 2 * USECS_PER_SECOND;
+const int MAX_BRICK_RESENDS = 5;
+
 /*
   A PolyVoxEntity has several interdependent parts:
 
-  _voxelData -- compressed QByteArray representation of which voxels have which values
+  _voxelBricks -- compressed bricks of which voxels have which values
   _volData -- datastructure from the PolyVox library which holds which voxels have which values
   _mesh -- renderable representation of the voxels
   _shape -- used for bullet (physics) collisions
 
-  Each one depends on the one before it, except that _voxelData is set from _volData if a script edits the voxels.
+  Each one depends on the one before it, except that _voxelBricks is set from _volData if a script edits the voxels.
 
   There are booleans to indicate that something has been updated and the dependents now need to be updated.
   _meshReady       -- do we have something to give scripts that ask for the mesh?
@@ -128,13 +134,23 @@ const float MARCHING_CUBE_COLLISION_HULL_OFFSET = 0.5;
   (for the physics-engine's benefit).  This is the right-hand side of the diagram.
 
   From the 'Ready' state, if a script changes a voxel, _volDataDirty will be set true.  We bake the mesh,
-  compress the voxels into a new _voxelData, and transmit the new _voxelData to the entity-server.  We then
+  compress the voxels into _voxelBricks, and transmit the bricks that changed to the entity-server.  We then
   bake the shape.  This is the left-hand side of the diagram.
 
   The actual state machine is more complicated than the diagram, because it's possible for _volDataDirty or
   _voxelDataDirty to be set true while worker threads are attempting to bake meshes or shapes.  If this happens,
   we jump back to a higher point in the diagram to avoid wasting effort.
 
+  The voxels are handled in bricks of PolyVoxBricks::BRICK_SIZE^3.  _voxelBricks holds each brick compressed on its
+  own, so uncompressing only expands the bricks that differ from what _volData already has, and compressing only
+  recompresses the bricks that scripts edited since last time.  The edit packets carry just those bricks, as patches
+  that the entity-server applies to the bricks it has, and the entity-server sends everyone the bricks that changed in
+  the same way.  An edit packet that is lost has nothing to repair it, so the bricks in it are kept as they are here
+  and sent again until the entity-server sends them back with a newer version than they were edited from.  The mesh
+  is kept per brick of _volData as well, and only the bricks around changed voxels are extracted again, in parallel.
+  Each brick is extracted from the whole of _volData, so its surface reads across into the neighboring bricks and the
+  seams between them match up.
+
   PolyVoxes are designed to seemlessly fit up against neighbors.  If voxels go right up to the edge of polyvox,
   the resulting mesh wont be closed -- the library assumes you'll have another polyvox next to it to continue the
   mesh.
@@ -162,6 +178,21 @@ void loop3(const T& start, const T& end, F f) {
     }
 }
 
+// the mesh bricks tile the cells between the voxels of _volData, which has one less of them on each axis
+ivec3 getNumMeshBricks(const PolyVox::SimpleVolume<uint8_t>* volData) {
+    ivec3 numCells = ivec3(volData->getWidth(), volData->getHeight(), volData->getDepth()) - 1;
+    return glm::max((numCells + PolyVoxBricks::BRICK_SIZE - 1) / PolyVoxBricks::BRICK_SIZE, ivec3(1));
+}
+
+PolyVox::Region getMeshBrickRegion(const PolyVox::SimpleVolume<uint8_t>* volData, const ivec3& numBricks, int index) {
+    ivec3 brick(index % numBricks.x, (index / numBricks.x) % numBricks.y, index / (numBricks.x * numBricks.y));
+    ivec3 lower = brick * PolyVoxBricks::BRICK_SIZE;
+    // the corners are inclusive, and the extractors make the cells from the lower corner up to the upper one
+    ivec3 upper = glm::min(lower + PolyVoxBricks::BRICK_SIZE,
+                           ivec3(volData->getWidth(), volData->getHeight(), volData->getDepth()) - 1);
+    return PolyVox::Region(PolyVox::Vector3DInt32(lower.x, lower.y, lower.z), PolyVox::Vector3DInt32(upper.x, upper.y, upper.z));
+}
+
 EntityItemPointer RenderablePolyVoxEntityItem::factory(const EntityItemID& entityID, const EntityItemProperties& properties) {
     std::shared_ptr<RenderablePolyVoxEntityItem> entity(new RenderablePolyVoxEntityItem(entityID), [](EntityItem* ptr) { ptr->deleteLater(); });
     entity->setProperties(properties);
@@ -195,14 +226,61 @@ bool isEdged(PolyVoxEntityItem::PolyVoxSurfaceStyle surfaceStyle) {
 }
 
 void RenderablePolyVoxEntityItem::setVoxelData(const QByteArray& voxelData) {
+    // a script set the voxel data, and sends it to the entity-server itself
+    bool valid = true;
+    withWriteLock([&] {
+        _voxelBricks.clearDirty();
+        valid = _voxelBricks.applyEdit(voxelData);
+        if (_voxelBricks.getNumDirty() > 0) {
+            _voxelDataDirty = true;
+            startUpdates();
+        }
+    });
+    if (!valid) {
+        qCDebug(entitiesrenderer) << "PolyVox voxel data edit is not reasonable, ignoring it" << getName() << getID();
+    }
+}
+
+void RenderablePolyVoxEntityItem::readVoxelData(const QByteArray& voxelData) {
     // accept compressed voxel information from the entity-server
+    bool valid = true;
     withWriteLock([&] {
-        if (_voxelData != voxelData) {
-            _voxelData = voxelData;
+        ivec3 voxelVolumeSize = _voxelBricks.getVoxelVolumeSize();
+        std::vector<quint32> versions;
+        for (const auto& unacknowledgedBrick : _unacknowledgedBricks) {
+            versions.push_back(_voxelBricks.getVersion(unacknowledgedBrick.first));
+        }
+
+        _voxelBricks.clearDirty();
+        valid = _voxelBricks.merge(voxelData);
+        if (_voxelBricks.getVoxelVolumeSize() != voxelVolumeSize) {
+            // someone else resized the volume, which leaves nothing for our edits to apply to
+            _unacknowledgedBricks.clear();
+        }
+
+        auto version = versions.begin();
+        for (auto itr = _unacknowledgedBricks.begin(); itr != _unacknowledgedBricks.end(); ++version) {
+            int index = itr->first;
+            bool received = _voxelBricks.getVersion(index) != *version;
+            if (_voxelBricks.getVersion(index) > itr->second.baseVersion ||
+                (received && _voxelBricks.getBrick(index) == itr->second.brick)) {
+                // the entity-server has our edit, or one that was made after it
+                itr = _unacknowledgedBricks.erase(itr);
+            } else {
+                // the entity-server hasn't got our edit yet, so keep showing it
+                _voxelBricks.setBrick(index, itr->second.brick);
+                ++itr;
+            }
+        }
+
+        if (_voxelBricks.getNumDirty() > 0) {
             _voxelDataDirty = true;
             startUpdates();
         }
     });
+    if (!valid) {
+        qCDebug(entitiesrenderer) << "PolyVox voxel data is not reasonable, ignoring it" << getName() << getID();
+    }
 }
 
 void RenderablePolyVoxEntityItem::setVoxelSurfaceStyle(PolyVoxSurfaceStyle voxelSurfaceStyle) {
@@ -225,6 +303,8 @@ void RenderablePolyVoxEntityItem::setVoxelSurfaceStyle(PolyVoxSurfaceStyle voxel
             volSizeChanged = true;
         }
         _voxelSurfaceStyle = voxelSurfaceStyle;
+        // the mesh worker rebuilds every brick for a new style
+        _volDataDirty = true;
         startUpdates();
     });
 
@@ -308,21 +388,14 @@ void RenderablePolyVoxEntityItem::forEachVoxelValue(const ivec3& voxelSize, std:
     });
 }
 
-QByteArray RenderablePolyVoxEntityItem::volDataToArray(quint16 voxelXSize, quint16 voxelYSize, quint16 voxelZSize) const {
-    int totalSize = voxelXSize * voxelYSize * voxelZSize;
-    ivec3 voxelSize{ voxelXSize, voxelYSize, voxelZSize };
-    ivec3 low{ 0 };
-    int index = 0;
-
-    QByteArray result = QByteArray(totalSize, '\0');
+QByteArray RenderablePolyVoxEntityItem::volDataToArray(const ivec3& low, const ivec3& size) const {
+    // the voxels of a box of user voxel-coords, x first, then y, then z
+    QByteArray result = QByteArray(size.x * size.y * size.z, '\0');
+    char* voxel = result.data();
     withReadLock([&] {
-        if (isEdged()) {
-            low += 1;
-            voxelSize += 2;
-        }
-
-        loop3(low, voxelSize, [&](const ivec3& v){
-            result[index++] = _volData->getVoxelAt(v.x, v.y, v.z);
+        ivec3 volDataLow = isEdged() ? low + 1 : low;
+        loop3(volDataLow, volDataLow + size, [&](const ivec3& v){
+            *voxel++ = _volData->getVoxelAt(v.x, v.y, v.z);
         });
     });
 
@@ -782,6 +855,7 @@ void RenderablePolyVoxEntityItem::update(const quint64& now) {
     bool doUncompress { false };
     bool doCompress { false };
     bool doRecomputeShape { false };
+    std::vector<QByteArray> resendPatches;
 
     withWriteLock([&] {
         tellNeighborsToRecopyEdges(false);
@@ -799,7 +873,22 @@ void RenderablePolyVoxEntityItem::update(const quint64& now) {
                     doUncompress = true;
                 } else {
                     copyUpperEdgesFromNeighbors();
-                    if (!_volDataDirty && !_voxelDataDirty) {
+                    if (!_unacknowledgedBricks.empty() && now >= _resendBricksAt) {
+                        if (_numBrickResends < MAX_BRICK_RESENDS) {
+                            // only the bricks the entity-server hasn't sent back go again
+                            std::vector<int> indices;
+                            for (const auto& unacknowledgedBrick : _unacknowledgedBricks) {
+                                indices.push_back(unacknowledgedBrick.first);
+                            }
+                            resendPatches = _voxelBricks.writePatches(indices, PolyVoxBricks::MAX_PATCH_SIZE);
+                            _numBrickResends++;
+                            _resendBricksAt = now + BRICK_RESEND_DELAY;
+                        } else {
+                            // the entity-server isn't taking the edits, as happens when we aren't allowed to make them
+                            _unacknowledgedBricks.clear();
+                        }
+                    }
+                    if (!_volDataDirty && !_voxelDataDirty && _unacknowledgedBricks.empty()) {
                         // nothing to do
                         stopUpdates();
                     }
@@ -817,7 +906,7 @@ void RenderablePolyVoxEntityItem::update(const quint64& now) {
                     doRecomputeMesh = true;
                 } else if (_voxelDataDirty) {
                     _voxelDataDirty = false;
-                    // _voxelData changed while we were uncompressing the previous version, uncompress again
+                    // _voxelBricks changed while we were uncompressing the previous version, uncompress again
                     _state = PolyVoxState::Uncompressing;
                     doUncompress = true;
                 } else {
@@ -840,9 +929,13 @@ void RenderablePolyVoxEntityItem::update(const quint64& now) {
                     // we received a change from the wire while baking the mesh.
                     _state = PolyVoxState::Uncompressing;
                     doUncompress = true;
-                } else {
+                } else if (hasCompressDirtyBricks()) {
                     _state = PolyVoxState::Compressing;
                     doCompress = true;
+                } else {
+                    // only the edges copied from neighbors changed, so there's nothing to send
+                    _state = PolyVoxState::BakingShape;
+                    doRecomputeShape = true;
                 }
                 break;
             }
@@ -861,6 +954,10 @@ void RenderablePolyVoxEntityItem::update(const quint64& now) {
                     // we received a change from the wire while baking the mesh.
                     _state = PolyVoxState::Uncompressing;
                     doUncompress = true;
+                } else if (hasCompressDirtyBricks()) {
+                    // bricks a script edited didn't change on the wire, so they still need to be sent
+                    _state = PolyVoxState::Compressing;
+                    doCompress = true;
                 } else {
                     _state = PolyVoxState::BakingShape;
                     doRecomputeShape = true;
@@ -899,6 +996,9 @@ void RenderablePolyVoxEntityItem::update(const quint64& now) {
     if (doRecomputeShape) {
         computeShapeInfoWorker();
     }
+    for (const auto& patch : resendPatches) {
+        sendVoxelDataEdit(patch);
+    }
 }
 
 void RenderablePolyVoxEntityItem::setVoxelVolumeSize(const glm::vec3& voxelVolumeSize) {
@@ -915,6 +1015,8 @@ void RenderablePolyVoxEntityItem::setVoxelVolumeSize(const glm::vec3& voxelVolum
         _voxelVolumeSize = voxelVolumeSize;
         _volData.reset();
         _onCount = 0;
+        _bricks = PolyVoxBricks();
+        _compressDirtyBricks.assign(PolyVoxBricks(ivec3(_voxelVolumeSize)).getNumBricksTotal(), false);
         _updateFromNeighborXEdge = _updateFromNeighborYEdge = _updateFromNeighborZEdge = true;
         startUpdates();
 
@@ -940,6 +1042,9 @@ void RenderablePolyVoxEntityItem::setVoxelVolumeSize(const glm::vec3& voxelVolum
         _volData.reset(new PolyVox::SimpleVolume<uint8_t>(PolyVox::Region(lowCorner, highCorner)));
         // having the "outside of voxel-space" value be 255 has helped me notice some problems.
         _volData->setBorderValue(255);
+
+        ivec3 numMeshBricks = getNumMeshBricks(_volData.get());
+        _meshDirtyBricks.assign(numMeshBricks.x * numMeshBricks.y * numMeshBricks.z, true);
     });
 
     tellNeighborsToRecopyEdges(true);
@@ -992,6 +1097,7 @@ uint8_t RenderablePolyVoxEntityItem::getVoxelInternal(const ivec3& v) const {
 
 void RenderablePolyVoxEntityItem::setVoxelMarkNeighbors(int x, int y, int z, uint8_t toValue) {
     _volData->setVoxelAt(x, y, z, toValue);
+    markMeshBricksDirty({ x, y, z });
     if (x == 0) {
         _neighborXNeedsUpdate = true;
         startUpdates();
@@ -1006,8 +1112,37 @@ void RenderablePolyVoxEntityItem::setVoxelMarkNeighbors(int x, int y, int z, uin
     }
 }
 
+void RenderablePolyVoxEntityItem::markMeshBricksDirty(const ivec3& volDataVoxel) {
+    // the cells of a surface extractor read the voxels on either side of them, and the marching cubes normals
+    // read one further, so a voxel can change the bricks holding the cells from two below it to one above it
+    ivec3 numBricks = getNumMeshBricks(_volData.get());
+    ivec3 low = glm::clamp((volDataVoxel - 2) / PolyVoxBricks::BRICK_SIZE, ivec3(0), numBricks - 1);
+    ivec3 high = glm::clamp((volDataVoxel + 1) / PolyVoxBricks::BRICK_SIZE, ivec3(0), numBricks - 1);
+    loop3(low, high + 1, [&](const ivec3& brick) {
+        _meshDirtyBricks[(brick.z * numBricks.y + brick.y) * numBricks.x + brick.x] = true;
+    });
+}
+
+bool RenderablePolyVoxEntityItem::hasCompressDirtyBricks() const {
+    return std::find(_compressDirtyBricks.begin(), _compressDirtyBricks.end(), true) != _compressDirtyBricks.end();
+}
+
 bool RenderablePolyVoxEntityItem::setVoxelInternal(const ivec3& v, uint8_t toValue) {
     // set a voxel without recompressing the voxel data.  This assumes that the caller has write-locked the entity.
+    bool result = setVolDataVoxel(v, toValue);
+    if (result) {
+        // the brick gets recompressed and sent in the next Compressing state
+        glm::ivec3 numBricks = (ivec3(_voxelVolumeSize) + PolyVoxBricks::BRICK_SIZE - 1) / PolyVoxBricks::BRICK_SIZE;
+        glm::ivec3 brick = v / PolyVoxBricks::BRICK_SIZE;
+        _compressDirtyBricks[(brick.z * numBricks.y + brick.y) * numBricks.x + brick.x] = true;
+    }
+
+    return result;
+}
+
+bool RenderablePolyVoxEntityItem::setVolDataVoxel(const ivec3& v, uint8_t toValue) {
+    // set a voxel of _volData, marking the mesh to be rebuilt but not the voxel data to be recompressed.
+    // This assumes that the caller has write-locked the entity.
     bool result = updateOnCount(v, toValue);
     if (result) {
         if (isEdged()) {
@@ -1046,112 +1181,147 @@ bool RenderablePolyVoxEntityItem::updateOnCount(const ivec3& v, uint8_t toValue)
 }
 
 void RenderablePolyVoxEntityItem::uncompressVolumeData() {
-    // take compressed data and expand it into _volData.
-    QByteArray voxelData;
+    // take compressed data and expand the bricks of it that changed into _volData.
+    PolyVoxBricks newBricks;
+    PolyVoxBricks bricks;
     auto entity = std::static_pointer_cast<RenderablePolyVoxEntityItem>(getThisPointer());
 
     withReadLock([&] {
-        voxelData = _voxelData;
+        newBricks = _voxelBricks;
+        bricks = _bricks;
     });
 
     QtConcurrent::run([=] {
-        QDataStream reader(voxelData);
-        quint16 voxelXSize, voxelYSize, voxelZSize;
-        reader >> voxelXSize;
-        reader >> voxelYSize;
-        reader >> voxelZSize;
-
-        if (voxelXSize == 0 || voxelXSize > PolyVoxEntityItem::MAX_VOXEL_DIMENSION ||
-            voxelYSize == 0 || voxelYSize > PolyVoxEntityItem::MAX_VOXEL_DIMENSION ||
-            voxelZSize == 0 || voxelZSize > PolyVoxEntityItem::MAX_VOXEL_DIMENSION) {
-            qCDebug(entitiesrenderer) << "voxelSize is not reasonable, skipping uncompressions."
-                                      << voxelXSize << voxelYSize << voxelZSize << getName() << getID();
-            entity->setVoxelsFromData(QByteArray(1, 0), 1, 1, 1);
-            return;
+        // _volData was just made when there are no bricks, so empty bricks don't need to be expanded into it
+        bool emptyVolData = !bricks.isValid();
+        bool sameSize = bricks.getVoxelVolumeSize() == newBricks.getVoxelVolumeSize();
+        std::vector<int> changedBricks;
+        for (int i = 0; i < newBricks.getNumBricksTotal(); i++) {
+            const auto& brick = newBricks.getBrick(i);
+            if (emptyVolData ? brick != PolyVoxBricks::Brick() : (!sameSize || brick != bricks.getBrick(i))) {
+                changedBricks.push_back(i);
+            }
         }
-        int rawSize = voxelXSize * voxelYSize * voxelZSize;
-
-        QByteArray compressedData;
-        reader >> compressedData;
 
-        QByteArray uncompressedData = qUncompress(compressedData);
-
-        if (uncompressedData.size() != rawSize) {
-            qCDebug(entitiesrenderer) << "PolyVox uncompress -- size is (" << voxelXSize << voxelYSize << voxelZSize << ")"
-                     << "so expected uncompressed length of" << rawSize << "but length is" << uncompressedData.size()
-                                      << getName() << getID();
-            entity->setVoxelsFromData(QByteArray(1, 0), 1, 1, 1);
-            return;
-        }
+        std::vector<QByteArray> voxels(changedBricks.size());
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, changedBricks.size()), [&](const tbb::blocked_range<size_t>& range) {
+            for (size_t i = range.begin(); i != range.end(); ++i) {
+                voxels[i] = newBricks.getVoxels(changedBricks[i]);
+            }
+        });
 
-        entity->setVoxelsFromData(uncompressedData, voxelXSize, voxelYSize, voxelZSize);
+        entity->setVoxelsFromBricks(newBricks, changedBricks, voxels);
     });
 }
 
-void RenderablePolyVoxEntityItem::setVoxelsFromData(QByteArray uncompressedData,
-                                                    quint16 voxelXSize, quint16 voxelYSize, quint16 voxelZSize) {
+void RenderablePolyVoxEntityItem::setVoxelsFromBricks(const PolyVoxBricks& bricks, const std::vector<int>& changedBricks,
+                                                      const std::vector<QByteArray>& voxels) {
     // this accepts the payload from uncompressVolumeData
     withWriteLock([&] {
-        loop3(ivec3(0), ivec3(voxelXSize, voxelYSize, voxelZSize), [&](const ivec3& v) {
-            int uncompressedIndex = (v.z * voxelYSize * voxelXSize) + (v.y * voxelZSize) + v.x;
-            setVoxelInternal(v, uncompressedData[uncompressedIndex]);
-        });
+        if (bricks.isValid()) {
+            for (size_t i = 0; i < changedBricks.size(); i++) {
+                ivec3 low = bricks.getBrickPosition(changedBricks[i]);
+                const char* voxel = voxels[i].constData();
+                loop3(low, low + bricks.getBrickSize(changedBricks[i]), [&](const ivec3& v) {
+                    setVolDataVoxel(v, (uint8_t)*voxel++);
+                });
+            }
+            _bricks = bricks;
+        }
 
         _state = PolyVoxState::UncompressingFinished;
     });
 }
 
 void RenderablePolyVoxEntityItem::compressVolumeDataAndSendEditPacket() {
-    // compress the data in _volData and save the results.  The compressed form is used during
-    // saves to disk and for transmission over the wire to the entity-server
+    // compress the bricks of _volData that scripts edited and save the results.  The compressed form is used during
+    // saves to disk, and the edited bricks are sent over the wire to the entity-server
 
     EntityItemPointer entity = getThisPointer();
 
-    quint16 voxelXSize;
-    quint16 voxelYSize;
-    quint16 voxelZSize;
-    withReadLock([&] {
-        voxelXSize = _voxelVolumeSize.x;
-        voxelYSize = _voxelVolumeSize.y;
-        voxelZSize = _voxelVolumeSize.z;
+    PolyVoxBricks bricks;
+    std::vector<int> editedBricks;
+    withWriteLock([&] {
+        bricks = PolyVoxBricks(ivec3(_voxelVolumeSize));
+        if (_voxelBricks.getVoxelVolumeSize() != bricks.getVoxelVolumeSize()) {
+            // _voxelBricks is for another size of volume, so all of it has to be made and sent
+            std::fill(_compressDirtyBricks.begin(), _compressDirtyBricks.end(), true);
+        }
+        for (int i = 0; i < (int)_compressDirtyBricks.size(); i++) {
+            if (_compressDirtyBricks[i]) {
+                editedBricks.push_back(i);
+                _compressDirtyBricks[i] = false;
+            }
+        }
     });
 
-    QtConcurrent::run([voxelXSize, voxelYSize, voxelZSize, entity] {
+    QtConcurrent::run([entity, bricks, editedBricks] {
         auto polyVoxEntity = std::static_pointer_cast<RenderablePolyVoxEntityItem>(entity);
-        QByteArray uncompressedData = polyVoxEntity->volDataToArray(voxelXSize, voxelYSize, voxelZSize);
 
-        QByteArray newVoxelData;
-        QDataStream writer(&newVoxelData, QIODevice::WriteOnly | QIODevice::Truncate);
+        std::vector<PolyVoxBricks::Brick> compressedBricks(editedBricks.size());
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, editedBricks.size()), [&](const tbb::blocked_range<size_t>& range) {
+            for (size_t i = range.begin(); i != range.end(); ++i) {
+                int index = editedBricks[i];
+                QByteArray voxels = polyVoxEntity->volDataToArray(bricks.getBrickPosition(index), bricks.getBrickSize(index));
+                compressedBricks[i] = PolyVoxBricks::Brick::encode(voxels);
+            }
+        });
 
-        writer << voxelXSize << voxelYSize << voxelZSize;
+        polyVoxEntity->compressVolumeDataFinished(bricks.getVoxelVolumeSize(), editedBricks, compressedBricks);
+    });
+}
 
-        QByteArray compressedData = qCompress(uncompressedData, 9);
-        writer << compressedData;
+void RenderablePolyVoxEntityItem::compressVolumeDataFinished(const ivec3& voxelVolumeSize,
+                                                             const std::vector<int>& editedBricks,
+                                                             const std::vector<PolyVoxBricks::Brick>& compressedBricks) {
+    // the bricks scripts edited, compressed
+    std::vector<QByteArray> patches;
+    withWriteLock([&] {
+        bool resized = false;
+        if (_voxelBricks.getVoxelVolumeSize() != voxelVolumeSize) {
+            // every brick is sent, and after a resize the entity-server gives every brick a new version, so only
+            // getting back what we sent says it has our edit
+            _voxelBricks.resize(voxelVolumeSize);
+            _unacknowledgedBricks.clear();
+            resized = true;
+        }
+        if (_bricks.getVoxelVolumeSize() != voxelVolumeSize) {
+            _bricks = PolyVoxBricks(voxelVolumeSize);
+        }
 
-        // make sure the compressed data can be sent over the wire-protocol
-        if (newVoxelData.size() > 1150) {
-            // HACK -- until we have a way to allow for properties larger than MTU, don't update.
-            // revert the active voxel-space to the last version that fit.
-            qCDebug(entitiesrenderer) << "compressed voxel data is too large" << entity->getName() << entity->getID();
+        // only the bricks that came out different need to go to the entity-server
+        std::vector<int> sentBricks;
+        for (size_t i = 0; i < editedBricks.size(); i++) {
+            int index = editedBricks[i];
+            const auto& brick = compressedBricks[i];
+            _bricks.setBrick(index, brick);
+            if (!resized && _voxelBricks.getBrick(index) == brick) {
+                continue;
+            }
 
-            const auto polyVoxEntity = std::static_pointer_cast<RenderablePolyVoxEntityItem>(entity);
-            polyVoxEntity->compressVolumeDataFinished(QByteArray());
-            return;
+            auto itr = _unacknowledgedBricks.find(index);
+            quint32 baseVersion = itr != _unacknowledgedBricks.end() ? itr->second.baseVersion :
+                (resized ? std::numeric_limits<quint32>::max() : _voxelBricks.getVersion(index));
+            _unacknowledgedBricks[index] = { baseVersion, brick };
+            _voxelBricks.setBrick(index, brick);
+            sentBricks.push_back(index);
         }
+        _bricks.clearDirty();
 
-        std::static_pointer_cast<RenderablePolyVoxEntityItem>(entity)->compressVolumeDataFinished(newVoxelData);
-    });
-}
-
-void RenderablePolyVoxEntityItem::compressVolumeDataFinished(const QByteArray& voxelData) {
-    // compressed voxel information from the entity-server
-    withWriteLock([&] {
-        if (voxelData.size() > 0 && _voxelData != voxelData) {
-            _voxelData = voxelData;
+        if (!sentBricks.empty()) {
+            patches = _voxelBricks.writePatches(sentBricks, PolyVoxBricks::MAX_PATCH_SIZE);
+            _resendBricksAt = usecTimestampNow() + BRICK_RESEND_DELAY;
+            _numBrickResends = 0;
         }
         _state = PolyVoxState::CompressingFinished;
     });
 
+    for (const auto& patch : patches) {
+        sendVoxelDataEdit(patch);
+    }
+}
+
+void RenderablePolyVoxEntityItem::sendVoxelDataEdit(const QByteArray& editVoxelData) {
     auto now = usecTimestampNow();
     setLastEdited(now);
     setLastBroadcast(now);
@@ -1164,7 +1334,7 @@ void RenderablePolyVoxEntityItem::compressVolumeDataFinished(const QByteArray& v
             EntityPropertyFlags desiredProperties;
             desiredProperties.setHasProperty(PROP_VOXEL_DATA);
             EntityItemProperties properties = getProperties(desiredProperties, false);
-            properties.setVoxelDataDirty();
+            properties.setVoxelData(editVoxelData);
             properties.setLastEdited(now);
 
             EntitySimulationPointer simulation = tree ? tree->getSimulation() : nullptr;
@@ -1244,6 +1414,7 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
                         uint8_t prevValue = _volData->getVoxelAt(x, y, z);
                         if (prevValue != neighborValue) {
                             _volData->setVoxelAt(x, y, z, neighborValue);
+                            markMeshBricksDirty({ x, y, z });
                             _volDataDirty = true;
                         }
                     }
@@ -1264,6 +1435,7 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
                         uint8_t prevValue = _volData->getVoxelAt(x, y, z);
                         if (prevValue != neighborValue) {
                             _volData->setVoxelAt(x, y, z, neighborValue);
+                            markMeshBricksDirty({ x, y, z });
                             _volDataDirty = true;
                         }
                     }
@@ -1284,6 +1456,7 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
                         uint8_t prevValue = _volData->getVoxelAt(x, y, z);
                         if (prevValue != neighborValue) {
                             _volData->setVoxelAt(x, y, z, neighborValue);
+                            markMeshBricksDirty({ x, y, z });
                             _volDataDirty = true;
                         }
                     }
@@ -1324,49 +1497,100 @@ void RenderablePolyVoxEntityItem::tellNeighborsToRecopyEdges(bool force) {
 
 
 void RenderablePolyVoxEntityItem::recomputeMesh() {
-    // use _volData to make a renderable mesh
+    // use _volData to make a renderable mesh, extracting again only the bricks around the voxels that changed
     PolyVoxSurfaceStyle voxelSurfaceStyle;
-    withReadLock([&] {
+    std::vector<bool> dirtyBricks;
+    withWriteLock([&] {
         voxelSurfaceStyle = _voxelSurfaceStyle;
+        dirtyBricks.assign(_meshDirtyBricks.size(), false);
+        dirtyBricks.swap(_meshDirtyBricks);
     });
 
     auto entity = std::static_pointer_cast<RenderablePolyVoxEntityItem>(getThisPointer());
 
-    QtConcurrent::run([entity, voxelSurfaceStyle] {
+    QtConcurrent::run([entity, voxelSurfaceStyle, dirtyBricks] {
         graphics::MeshPointer mesh(new graphics::Mesh());
-
-        // A mesh object to hold the result of surface extraction
-        PolyVox::SurfaceMesh<PolyVox::PositionMaterialNormal> polyVoxMesh;
+        auto& brickMeshes = entity->_brickMeshes;
 
         entity->withReadLock([&] {
             PolyVox::SimpleVolume<uint8_t>* volData = entity->getVolData();
-            switch (voxelSurfaceStyle) {
-                case PolyVoxEntityItem::SURFACE_EDGED_MARCHING_CUBES:
-                case PolyVoxEntityItem::SURFACE_MARCHING_CUBES: {
-                    PolyVox::MarchingCubesSurfaceExtractor<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
-                        (volData, volData->getEnclosingRegion(), &polyVoxMesh);
-                    surfaceExtractor.execute();
-                    break;
-                }
-                case PolyVoxEntityItem::SURFACE_EDGED_CUBIC:
-                case PolyVoxEntityItem::SURFACE_CUBIC: {
-                    PolyVox::CubicSurfaceExtractorWithNormals<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
-                        (volData, volData->getEnclosingRegion(), &polyVoxMesh);
-                    surfaceExtractor.execute();
-                    break;
+            ivec3 numBricks = getNumMeshBricks(volData);
+            size_t numBricksTotal = numBricks.x * numBricks.y * numBricks.z;
+
+            std::vector<int> bricksToExtract;
+            bool extractAll = brickMeshes.size() != numBricksTotal || dirtyBricks.size() != numBricksTotal ||
+                entity->_brickMeshesStyle != voxelSurfaceStyle;
+            if (extractAll) {
+                brickMeshes.assign(numBricksTotal, BrickMesh());
+                entity->_brickMeshesStyle = voxelSurfaceStyle;
+            }
+            for (size_t i = 0; i < numBricksTotal; i++) {
+                if (extractAll || dirtyBricks[i]) {
+                    bricksToExtract.push_back((int)i);
                 }
             }
+
+            tbb::parallel_for(tbb::blocked_range<size_t>(0, bricksToExtract.size()), [&](const tbb::blocked_range<size_t>& range) {
+                for (size_t i = range.begin(); i != range.end(); ++i) {
+                    // A mesh object to hold the result of surface extraction
+                    PolyVox::SurfaceMesh<PolyVox::PositionMaterialNormal> polyVoxMesh;
+                    PolyVox::Region region = getMeshBrickRegion(volData, numBricks, bricksToExtract[i]);
+                    switch (voxelSurfaceStyle) {
+                        case PolyVoxEntityItem::SURFACE_EDGED_MARCHING_CUBES:
+                        case PolyVoxEntityItem::SURFACE_MARCHING_CUBES: {
+                            PolyVox::MarchingCubesSurfaceExtractor<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
+                                (volData, region, &polyVoxMesh);
+                            surfaceExtractor.execute();
+                            break;
+                        }
+                        case PolyVoxEntityItem::SURFACE_EDGED_CUBIC:
+                        case PolyVoxEntityItem::SURFACE_CUBIC: {
+                            PolyVox::CubicSurfaceExtractorWithNormals<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
+                                (volData, region, &polyVoxMesh);
+                            surfaceExtractor.execute();
+                            break;
+                        }
+                    }
+
+                    // the extractors put the vertices relative to the lower corner of the region
+                    auto& brickMesh = brickMeshes[bricksToExtract[i]];
+                    brickMesh.vertices = polyVoxMesh.getRawVertexData();
+                    brickMesh.indices = polyVoxMesh.getIndices();
+                    PolyVox::Vector3DInt32 lowerCorner = region.getLowerCorner();
+                    PolyVox::Vector3DFloat offset((float)lowerCorner.getX(), (float)lowerCorner.getY(), (float)lowerCorner.getZ());
+                    for (auto& vertex : brickMesh.vertices) {
+                        vertex.setPosition(vertex.getPosition() + offset);
+                    }
+                }
+            });
         });
 
+        // put the bricks together into one mesh
+        size_t numVertices = 0;
+        size_t numIndices = 0;
+        for (const auto& brickMesh : brickMeshes) {
+            numVertices += brickMesh.vertices.size();
+            numIndices += brickMesh.indices.size();
+        }
+        std::vector<PolyVox::PositionMaterialNormal> vecVertices;
+        std::vector<uint32_t> vecIndices;
+        vecVertices.reserve(numVertices);
+        vecIndices.reserve(numIndices);
+        for (const auto& brickMesh : brickMeshes) {
+            uint32_t baseVertex = (uint32_t)vecVertices.size();
+            vecVertices.insert(vecVertices.end(), brickMesh.vertices.begin(), brickMesh.vertices.end());
+            for (uint32_t index : brickMesh.indices) {
+                vecIndices.push_back(baseVertex + index);
+            }
+        }
+
         // convert PolyVox mesh to a Sam mesh
-        const std::vector<uint32_t>& vecIndices = polyVoxMesh.getIndices();
         auto indexBuffer = std::make_shared<gpu::Buffer>(vecIndices.size() * sizeof(uint32_t),
                                                          (gpu::Byte*)vecIndices.data());
         auto indexBufferPtr = gpu::BufferPointer(indexBuffer);
         gpu::BufferView indexBufferView(indexBufferPtr, gpu::Element(gpu::SCALAR, gpu::UINT32, gpu::INDEX));
         mesh->setIndexBuffer(indexBufferView);
 
-        const std::vector<PolyVox::PositionMaterialNormal>& vecVertices = polyVoxMesh.getRawVertexData();
         auto vertexBuffer = std::make_shared<gpu::Buffer>(vecVertices.size() * sizeof(PolyVox::PositionMaterialNormal),
                                                           (gpu::Byte*)vecVertices.data());
         auto vertexBufferPtr = gpu::BufferPointer(vertexBuffer);
@@ -1552,7 +1776,7 @@ void RenderablePolyVoxEntityItem::setCollisionPoints(ShapeInfo::PointCollection
     // include the registrationPoint in the shape key, because the offset is already
     // included in the points and the shapeManager wont know that the shape has changed.
     withWriteLock([&] {
-        QString shapeKey = QString(_voxelData.toBase64()) + "," +
+        QString shapeKey = QString(_voxelBricks.write().toBase64()) + "," +
             QString::number(_registrationPoint.x) + "," +
             QString::number(_registrationPoint.y) + "," +
             QString::number(_registrationPoint.z);
@@ -13,10 +13,12 @@
 #define hifi_RenderablePolyVoxEntityItem_h
 
 #include <atomic>
+#include <map>
 
 #include <QSemaphore>
 
 #include <PolyVoxCore/SimpleVolume.h>
+#include <PolyVoxCore/SurfaceMesh.h>
 #include <PolyVoxCore/Raycast.h>
 
 #include <gpu/Forward.h>
@@ -80,6 +82,7 @@ public:
                                                   QVariantMap& extraInfo, bool precisionPicking) const override;
 
     virtual void setVoxelData(const QByteArray& voxelData) override;
+    virtual void readVoxelData(const QByteArray& voxelData) override;
     virtual void setVoxelVolumeSize(const glm::vec3& voxelVolumeSize) override;
     virtual void setVoxelSurfaceStyle(PolyVoxSurfaceStyle voxelSurfaceStyle) override;
 
@@ -121,9 +124,10 @@ public:
 
     virtual void setRegistrationPoint(const glm::vec3& value) override;
 
-    void setVoxelsFromData(QByteArray uncompressedData, quint16 voxelXSize, quint16 voxelYSize, quint16 voxelZSize);
+    void setVoxelsFromBricks(const PolyVoxBricks& bricks, const std::vector<int>& changedBricks,
+                             const std::vector<QByteArray>& voxels);
     void forEachVoxelValue(const ivec3& voxelSize, std::function<void(const ivec3&, uint8_t)> thunk);
-    QByteArray volDataToArray(quint16 voxelXSize, quint16 voxelYSize, quint16 voxelZSize) const;
+    QByteArray volDataToArray(const ivec3& low, const ivec3& size) const;
 
     void setMesh(graphics::MeshPointer mesh);
     void setCollisionPoints(ShapeInfo::PointCollection points, AABox box);
@@ -133,7 +137,9 @@ public:
     bool setVoxelInternal(const ivec3& v, uint8_t toValue);
     void setVoxelMarkNeighbors(int x, int y, int z, uint8_t toValue);
 
-    void compressVolumeDataFinished(const QByteArray& voxelData);
+    void compressVolumeDataFinished(const ivec3& voxelVolumeSize, const std::vector<int>& editedBricks,
+                                    const std::vector<PolyVoxBricks::Brick>& compressedBricks);
+    void sendVoxelDataEdit(const QByteArray& editVoxelData);
     void neighborXEdgeChanged() { withWriteLock([&] { _updateFromNeighborXEdge = true; }); startUpdates(); }
     void neighborYEdgeChanged() { withWriteLock([&] { _updateFromNeighborYEdge = true; }); startUpdates(); }
     void neighborZEdgeChanged() { withWriteLock([&] { _updateFromNeighborZEdge = true; }); startUpdates(); }
@@ -145,7 +151,16 @@ public:
     bool needsToCallUpdate() const override { return _updateNeeded; }
 
 private:
+    // the mesh of a brick of _volData, in voxel-space
+    struct BrickMesh {
+        std::vector<PolyVox::PositionMaterialNormal> vertices;
+        std::vector<uint32_t> indices;
+    };
+
     bool updateOnCount(const ivec3& v, uint8_t toValue);
+    bool setVolDataVoxel(const ivec3& v, uint8_t toValue);
+    void markMeshBricksDirty(const ivec3& volDataVoxel);
+    bool hasCompressDirtyBricks() const;
     PolyVox::RaycastResult doRayCast(glm::vec4 originInVoxel, glm::vec4 farInVoxel, glm::vec4& result) const;
 
     void changeUpdates(bool value);
@@ -163,7 +178,7 @@ private:
     void compressVolumeDataAndSendEditPacket();
     void computeShapeInfoWorker();
 
-    // The PolyVoxEntityItem class has _voxelData which contains dimensions and compressed voxel data.  The dimensions
+    // The PolyVoxEntityItem class has _voxelBricks which contains dimensions and compressed voxel data.  The dimensions
     // may not match _voxelVolumeSize.
     bool _meshReady { false }; // do we have something to give scripts that ask for the mesh?
     bool _voxelDataDirty { false }; // do we need to uncompress data and expand it into _volData?
@@ -179,6 +194,25 @@ private:
     std::shared_ptr<PolyVox::SimpleVolume<uint8_t>> _volData;
     int _onCount; // how many non-zero voxels are in _volData
 
+    // _voxelBricks as it was last uncompressed into or compressed from _volData.  Only the bricks that differ get
+    // uncompressed, and only the bricks edited since get compressed and sent.
+    PolyVoxBricks _bricks;
+    std::vector<bool> _compressDirtyBricks; // bricks of _voxelVolumeSize edited by scripts since the last compress
+    std::vector<bool> _meshDirtyBricks; // bricks of _volData whose meshes need to be rebuilt
+
+    // a brick sent to the entity-server, which it has once it sends back a newer version than the one it was edited from
+    struct UnacknowledgedBrick {
+        quint32 baseVersion;
+        PolyVoxBricks::Brick brick;
+    };
+    std::map<int, UnacknowledgedBrick> _unacknowledgedBricks;
+    quint64 _resendBricksAt { 0 };
+    int _numBrickResends { 0 };
+
+    // only the mesh worker uses these, and there's only ever one of it
+    std::vector<BrickMesh> _brickMeshes;
+    PolyVoxSurfaceStyle _brickMeshesStyle { SURFACE_MARCHING_CUBES };
+
     bool _neighborXNeedsUpdate { false };
     bool _neighborYNeedsUpdate { false };
     bool _neighborZNeedsUpdate { false };
@@ -0,0 +1,118 @@
+//
+//  DeletedEntityLog.cpp
+//  libraries/entities/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "DeletedEntityLog.h"
+
+#include <algorithm>
+
+DeletedEntityLog::DeletedEntityLog() : _directory(std::make_shared<Directory>()) {
+}
+
+DeletedEntityLog::Sequence DeletedEntityLog::Directory::findFirstDeletedAfter(quint64 time, Sequence end) const {
+    Sequence low = begin;
+    Sequence high = std::max(begin, end);
+    while (low < high) {
+        Sequence middle = low + (high - low) / 2;
+        if (at(middle).deletedAt > time) {
+            high = middle;
+        } else {
+            low = middle + 1;
+        }
+    }
+    return low;
+}
+
+void DeletedEntityLog::appendLocked(Sequence sequence, quint64 deletedAt, const QUuid& entityID,
+                                    std::shared_ptr<Directory>& newDirectory) {
+    const Directory* directory = newDirectory ? newDirectory.get() : _directory.get();
+    if (sequence - directory->firstChunkSequence == directory->chunks.size() * CHUNK_SIZE) {
+        // out of room, readers may be holding on to the current directory so add the chunk to a copy of it
+        if (!newDirectory) {
+            newDirectory = std::make_shared<Directory>(*directory);
+        }
+        newDirectory->chunks.push_back(std::make_shared<Chunk>());
+        directory = newDirectory.get();
+    }
+
+    // nobody reads past the published end, so the entry can be filled in place
+    Entry& entry = const_cast<Entry&>(directory->at(sequence));
+    entry.deletedAt = std::max(deletedAt, _lastDeletedAt.load(std::memory_order_relaxed));
+    entry.entityID = entityID;
+    _lastDeletedAt.store(entry.deletedAt, std::memory_order_release);
+}
+
+void DeletedEntityLog::publishLocked(Sequence end, const std::shared_ptr<Directory>& newDirectory) {
+    // the chunks have to be published before the entries in them
+    if (newDirectory) {
+        std::atomic_store_explicit(&_directory, DirectoryPointer(newDirectory), std::memory_order_release);
+    }
+    _end.store(end, std::memory_order_release);
+}
+
+void DeletedEntityLog::append(quint64 deletedAt, const QUuid& entityID) {
+    std::lock_guard<std::mutex> lock(_writeMutex);
+    Sequence end = _end.load(std::memory_order_relaxed);
+    std::shared_ptr<Directory> newDirectory;
+    appendLocked(end, deletedAt, entityID, newDirectory);
+    publishLocked(end + 1, newDirectory);
+}
+
+void DeletedEntityLog::append(quint64 deletedAt, const std::vector<QUuid>& entityIDs) {
+    if (entityIDs.empty()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_writeMutex);
+    Sequence end = _end.load(std::memory_order_relaxed);
+    std::shared_ptr<Directory> newDirectory;
+    for (const auto& entityID : entityIDs) {
+        appendLocked(end++, deletedAt, entityID, newDirectory);
+    }
+    publishLocked(end, newDirectory);
+}
+
+bool DeletedEntityLog::isEmpty() const {
+    return size() == 0;
+}
+
+size_t DeletedEntityLog::size() const {
+    Sequence end = getEnd();
+    DirectoryPointer directory = loadDirectory();
+    return end > directory->begin ? (size_t)(end - directory->begin) : 0;
+}
+
+bool DeletedEntityLog::hasDeletedSince(Sequence cursor, quint64 sinceTime) const {
+    return cursor < getEnd() || (getLastDeletedAt() > sinceTime && !isEmpty());
+}
+
+void DeletedEntityLog::forgetDeletedBefore(quint64 time, Sequence cursor) {
+    std::lock_guard<std::mutex> lock(_writeMutex);
+    Sequence end = _end.load(std::memory_order_relaxed);
+    const Directory* directory = _directory.get();
+
+    Sequence begin = std::min(directory->findFirstDeletedAfter(time, end), std::max(cursor, directory->begin));
+    if (begin <= directory->begin) {
+        return;
+    }
+
+    auto newDirectory = std::make_shared<Directory>(*directory);
+    newDirectory->begin = begin;
+
+    // drop the chunks that are entirely forgotten, but keep one around to append to
+    size_t numForgottenChunks = (size_t)((begin - newDirectory->firstChunkSequence) / CHUNK_SIZE);
+    if (numForgottenChunks == newDirectory->chunks.size() && numForgottenChunks > 0) {
+        numForgottenChunks--;
+    }
+    newDirectory->chunks.erase(newDirectory->chunks.begin(), newDirectory->chunks.begin() + numForgottenChunks);
+    newDirectory->firstChunkSequence += numForgottenChunks * CHUNK_SIZE;
+
+    std::atomic_store_explicit(&_directory, DirectoryPointer(newDirectory), std::memory_order_release);
+}
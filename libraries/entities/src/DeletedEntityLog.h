@@ -0,0 +1,108 @@
+//
+//  DeletedEntityLog.h
+//  libraries/entities/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_DeletedEntityLog_h
+#define hifi_DeletedEntityLog_h
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QUuid>
+
+// DeletedEntityLog is the entity server's record of recently deleted entities, kept so that every client can be told
+// about them.  Deletions are appended in time order and numbered with a sequence; each client keeps a cursor (the
+// sequence it has been sent up to) and the log finds the deletions after a time by binary search, so sending the new
+// deletions to a client only touches those.
+//
+// Appending and forgetting are serialized with a mutex.  Readers never take it: they read the published end of the
+// log and a snapshot of its chunks, and the chunks they hold on to outlive any forgetting done meanwhile.
+class DeletedEntityLog {
+public:
+    using Sequence = uint64_t;
+    static const Sequence NO_CURSOR = (Sequence)-1;
+
+    struct Entry {
+        quint64 deletedAt;
+        QUuid entityID;
+    };
+
+    DeletedEntityLog();
+
+    // deletedAt is raised to the time of the last entry if need be, to keep the log sorted
+    void append(quint64 deletedAt, const QUuid& entityID);
+    void append(quint64 deletedAt, const std::vector<QUuid>& entityIDs);
+
+    bool isEmpty() const;
+    size_t size() const;
+    Sequence getEnd() const { return _end.load(std::memory_order_acquire); }
+    quint64 getLastDeletedAt() const { return _lastDeletedAt.load(std::memory_order_acquire); }
+
+    // whether anything was deleted after sinceTime, or appended at or after cursor
+    bool hasDeletedSince(Sequence cursor, quint64 sinceTime) const;
+
+    // Calls f(const Entry&) for every entry deleted after sinceTime or appended at or after cursor, in order, and
+    // returns the cursor to pass next time.
+    template <typename F>
+    Sequence forEachDeletedSince(Sequence cursor, quint64 sinceTime, F&& f) const;
+
+    // forgets the entries deleted at or before time that are before cursor
+    void forgetDeletedBefore(quint64 time, Sequence cursor = NO_CURSOR);
+
+private:
+    static const Sequence CHUNK_SIZE = 1024;
+
+    struct Chunk {
+        Entry entries[CHUNK_SIZE];
+    };
+
+    struct Directory {
+        Sequence firstChunkSequence { 0 };
+        Sequence begin { 0 };
+        std::vector<std::shared_ptr<Chunk>> chunks;
+
+        const Entry& at(Sequence sequence) const {
+            Sequence offset = sequence - firstChunkSequence;
+            return chunks[offset / CHUNK_SIZE]->entries[offset % CHUNK_SIZE];
+        }
+        // the first sequence in [begin, end) deleted after time
+        Sequence findFirstDeletedAfter(quint64 time, Sequence end) const;
+    };
+    using DirectoryPointer = std::shared_ptr<const Directory>;
+
+    DirectoryPointer loadDirectory() const { return std::atomic_load_explicit(&_directory, std::memory_order_acquire); }
+    void appendLocked(Sequence sequence, quint64 deletedAt, const QUuid& entityID, std::shared_ptr<Directory>& newDirectory);
+    void publishLocked(Sequence end, const std::shared_ptr<Directory>& newDirectory);
+
+    std::mutex _writeMutex;
+    DirectoryPointer _directory;
+    std::atomic<Sequence> _end { 0 };
+    std::atomic<quint64> _lastDeletedAt { 0 };
+};
+
+template <typename F>
+DeletedEntityLog::Sequence DeletedEntityLog::forEachDeletedSince(Sequence cursor, quint64 sinceTime, F&& f) const {
+    // the end has to be read first: the directory published with it, or any later one, holds everything before it
+    Sequence end = getEnd();
+    DirectoryPointer directory = loadDirectory();
+
+    Sequence start = directory->findFirstDeletedAfter(sinceTime, end);
+    if (cursor < start) {
+        start = std::max(cursor, directory->begin);
+    }
+    for (Sequence sequence = start; sequence < end; ++sequence) {
+        f(directory->at(sequence));
+    }
+    return end;
+}
+
+#endif // hifi_DeletedEntityLog_h
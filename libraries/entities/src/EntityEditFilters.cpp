@@ -12,10 +12,86 @@
 #include "EntityEditFilters.h"
 
 #include <QUrl>
+#include <QScriptValueIterator>
 
 #include <ResourceManager.h>
 #include <shared/ScriptInitializerMixin.h>
 
+namespace {
+
+// the properties a filter can declare propertyRanges for, checked without calling into the filter script
+struct RangedProperty {
+    const char* name;
+    int numComponents;
+    bool (*changed)(const EntityItemProperties&);
+    glm::vec3 (*get)(const EntityItemProperties&);
+    void (*set)(EntityItemProperties&, const glm::vec3&);
+};
+
+#define RANGED_FLOAT_PROPERTY(n, N) { #n, 1, \
+    [](const EntityItemProperties& properties) { return properties.n##Changed(); }, \
+    [](const EntityItemProperties& properties) { return glm::vec3(properties.get##N()); }, \
+    [](EntityItemProperties& properties, const glm::vec3& value) { properties.set##N(value.x); } }
+
+#define RANGED_VEC3_PROPERTY(n, N) { #n, 3, \
+    [](const EntityItemProperties& properties) { return properties.n##Changed(); }, \
+    [](const EntityItemProperties& properties) { return properties.get##N(); }, \
+    [](EntityItemProperties& properties, const glm::vec3& value) { properties.set##N(value); } }
+
+const RangedProperty RANGED_PROPERTIES[] = {
+    RANGED_VEC3_PROPERTY(position, Position),
+    RANGED_VEC3_PROPERTY(dimensions, Dimensions),
+    RANGED_VEC3_PROPERTY(velocity, Velocity),
+    RANGED_VEC3_PROPERTY(angularVelocity, AngularVelocity),
+    RANGED_VEC3_PROPERTY(gravity, Gravity),
+    RANGED_VEC3_PROPERTY(acceleration, Acceleration),
+    RANGED_FLOAT_PROPERTY(density, Density),
+    RANGED_FLOAT_PROPERTY(damping, Damping),
+    RANGED_FLOAT_PROPERTY(angularDamping, AngularDamping),
+    RANGED_FLOAT_PROPERTY(restitution, Restitution),
+    RANGED_FLOAT_PROPERTY(friction, Friction),
+    RANGED_FLOAT_PROPERTY(lifetime, Lifetime),
+};
+const int NUM_RANGED_PROPERTIES = sizeof(RANGED_PROPERTIES) / sizeof(RANGED_PROPERTIES[0]);
+
+const quint64 RATE_LIMITER_PRUNE_INTERVAL = 10 * USECS_PER_SECOND;
+
+}
+
+bool EntityEditFilters::EditRateLimiter::allowEdit(const EntityItemID& entityID, quint64 now) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (now > _nextPrune) {
+        // forget the entities that have been quiet for long enough to have a full bucket again
+        for (auto it = _buckets.begin(); it != _buckets.end();) {
+            float tokens = it->tokens + (float)(now - it->lastRefill) * _editsPerSecond / USECS_PER_SECOND;
+            if (tokens >= _burst) {
+                it = _buckets.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        _nextPrune = now + RATE_LIMITER_PRUNE_INTERVAL;
+    }
+
+    auto it = _buckets.find(entityID);
+    if (it == _buckets.end()) {
+        _buckets.insert(entityID, { _burst - 1.0f, now });
+        return true;
+    }
+
+    Bucket& bucket = it.value();
+    if (now > bucket.lastRefill) {
+        bucket.tokens = std::min(_burst, bucket.tokens + (float)(now - bucket.lastRefill) * _editsPerSecond / USECS_PER_SECOND);
+        bucket.lastRefill = now;
+    }
+    if (bucket.tokens < 1.0f) {
+        return false;
+    }
+    bucket.tokens -= 1.0f;
+    return true;
+}
+
 QList<EntityItemID> EntityEditFilters::getZonesByPosition(glm::vec3& position) {
     QList<EntityItemID> zones;
     QList<EntityItemID> missingZones;
@@ -73,8 +149,29 @@ bool EntityEditFilters::filter(glm::vec3& position, EntityItemProperties& proper
                 return true; // accept the message
             }
 
-            auto oldProperties = propertiesIn.getDesiredProperties();
+            // rate limits and value ranges don't need the script
+            bool declarativeChanges = false;
+            if (!passesDeclarativeFilter(filterData, propertiesIn, propertiesOut, declarativeChanges, itemID)) {
+                return false;
+            }
+            wasChanged |= declarativeChanges;
+
             auto specifiedProperties = propertiesIn.getChangedProperties();
+            if (filterData.hasPropertyMask) {
+                bool changesWantedProperty = false;
+                for (auto property : filterData.propertyMaskList) {
+                    if (specifiedProperties.getHasProperty(property)) {
+                        changesWantedProperty = true;
+                        break;
+                    }
+                }
+                if (!changesWantedProperty) {
+                    continue; // nothing this filter's script wants to look at
+                }
+                specifiedProperties &= filterData.propertyMask;
+            }
+
+            auto oldProperties = propertiesIn.getDesiredProperties();
             propertiesIn.setDesiredProperties(specifiedProperties);
             QScriptValue inputValues = propertiesIn.copyToScriptValue(filterData.engine, false, true, true);
             propertiesIn.setDesiredProperties(oldProperties);
@@ -153,7 +250,7 @@ bool EntityEditFilters::filter(glm::vec3& position, EntityItemProperties& proper
 
                 // otherwise, assume it wants to pass all properties
                 propertiesOut = propertiesIn;
-                wasChanged = false;
+                wasChanged = declarativeChanges;
                 
             } else {
                 return false;
@@ -164,6 +261,95 @@ bool EntityEditFilters::filter(glm::vec3& position, EntityItemProperties& proper
     return true;
 }
 
+bool EntityEditFilters::passesDeclarativeFilter(const FilterData& filterData, EntityItemProperties& propertiesIn,
+        EntityItemProperties& propertiesOut, bool& wasChanged, const EntityItemID& entityID) {
+    if (filterData.rateLimiter && !entityID.isInvalidID() && !filterData.rateLimiter->allowEdit(entityID, usecTimestampNow())) {
+        return false;
+    }
+
+    for (const auto& range : filterData.propertyRanges) {
+        const RangedProperty& property = RANGED_PROPERTIES[range.property];
+        if (!property.changed(propertiesIn)) {
+            continue;
+        }
+
+        glm::vec3 value = property.get(propertiesIn);
+        glm::vec3 clampedValue = glm::clamp(value, range.min, range.max);
+        bool inRange = true;
+        for (int i = 0; i < property.numComponents; i++) {
+            if (glm::isnan(value[i])) {
+                return false;
+            }
+            inRange &= clampedValue[i] == value[i];
+        }
+        if (inRange) {
+            continue;
+        }
+        if (!range.clamp) {
+            return false;
+        }
+        property.set(propertiesIn, clampedValue);
+        property.set(propertiesOut, clampedValue);
+        wasChanged = true;
+    }
+    return true;
+}
+
+void EntityEditFilters::readDeclarativeFilter(FilterData& filterData) {
+    // if the filter asks for a list of properties, only edits changing one of them are passed to it, and only those
+    QScriptValue wantsPropertiesValue = filterData.filterFn.property("wantsProperties");
+    if (wantsPropertiesValue.isString() || wantsPropertiesValue.isArray()) {
+        filterData.hasPropertyMask = true;
+        EntityPropertyFlagsFromScriptValue(wantsPropertiesValue, filterData.propertyMask);
+        for (int flag = filterData.propertyMask.firstFlag(); flag <= filterData.propertyMask.lastFlag(); flag++) {
+            if (filterData.propertyMask.getHasProperty((EntityPropertyList)flag)) {
+                filterData.propertyMaskList.push_back((EntityPropertyList)flag);
+            }
+        }
+    }
+
+    // maxEditsPerSecond (and optionally maxEditBurst) limit how often any one entity can be edited
+    QScriptValue maxEditsPerSecondValue = filterData.filterFn.property("maxEditsPerSecond");
+    if (maxEditsPerSecondValue.isNumber() && maxEditsPerSecondValue.toNumber() > 0.0) {
+        float editsPerSecond = (float)maxEditsPerSecondValue.toNumber();
+        QScriptValue maxEditBurstValue = filterData.filterFn.property("maxEditBurst");
+        float burst = maxEditBurstValue.isNumber() ? (float)maxEditBurstValue.toNumber() : editsPerSecond;
+        filterData.rateLimiter = std::make_shared<EditRateLimiter>(editsPerSecond, std::max(burst, 1.0f));
+    }
+
+    // propertyRanges is an object of { min, max, clamp } by property name, e.g. { lifetime: { max: 300, clamp: true } }
+    QScriptValue propertyRangesValue = filterData.filterFn.property("propertyRanges");
+    if (propertyRangesValue.isObject()) {
+        QScriptValueIterator it(propertyRangesValue);
+        while (it.hasNext()) {
+            it.next();
+            PropertyRange range;
+            for (int i = 0; i < NUM_RANGED_PROPERTIES; i++) {
+                if (it.name() == RANGED_PROPERTIES[i].name) {
+                    range.property = i;
+                    break;
+                }
+            }
+            if (range.property < 0) {
+                qWarning() << "Filter can't limit the range of property" << it.name();
+                continue;
+            }
+
+            QScriptValue rangeValue = it.value();
+            QScriptValue minValue = rangeValue.property("min");
+            if (minValue.isNumber()) {
+                range.min = (float)minValue.toNumber();
+            }
+            QScriptValue maxValue = rangeValue.property("max");
+            if (maxValue.isNumber()) {
+                range.max = (float)maxValue.toNumber();
+            }
+            range.clamp = rangeValue.property("clamp").toBool();
+            filterData.propertyRanges.push_back(range);
+        }
+    }
+}
+
 void EntityEditFilters::removeFilter(EntityItemID entityID) {
     QWriteLocker writeLock(&_lock);
     FilterData filterData = _filterDataMap.value(entityID);
@@ -255,138 +441,146 @@ void EntityEditFilters::scriptRequestFinished(EntityItemID entityID) {
         const QString urlString = scriptRequest->getUrl().toString();
         auto scriptContents = scriptRequest->getData();
         qInfo() << "Downloaded script:" << scriptContents;
-        QScriptProgram program(scriptContents, urlString);
-        if (hasCorrectSyntax(program)) {
-            // create a QScriptEngine for this script
-            QScriptEngine* engine = new QScriptEngine();
-            engine->setObjectName("filter:" + entityID.toString());
-            engine->setProperty("type", "edit_filter");
-            engine->setProperty("fileName", urlString);
-            engine->setProperty("entityID", entityID);
-            engine->globalObject().setProperty("Script", engine->newQObject(engine));
-            DependencyManager::get<ScriptInitializers>()->runScriptInitializers(engine);
-            engine->evaluate(scriptContents, urlString);
-            if (!hadUncaughtExceptions(*engine, urlString)) {
-                // put the engine in the engine map (so we don't leak them, etc...)
-                FilterData filterData;
-                filterData.engine = engine;
-                filterData.rejectAll = false;
-                
-                // define the uncaughtException function
-                QScriptEngine& engineRef = *engine;
-                filterData.uncaughtExceptions = [&engineRef, urlString]() { return hadUncaughtExceptions(engineRef, urlString); };
-
-                // now get the filter function
-                auto global = engine->globalObject();
-                auto entitiesObject = engine->newObject();
-                entitiesObject.setProperty("ADD_FILTER_TYPE", EntityTree::FilterType::Add);
-                entitiesObject.setProperty("EDIT_FILTER_TYPE", EntityTree::FilterType::Edit);
-                entitiesObject.setProperty("PHYSICS_FILTER_TYPE", EntityTree::FilterType::Physics);
-                entitiesObject.setProperty("DELETE_FILTER_TYPE", EntityTree::FilterType::Delete);
-                global.setProperty("Entities", entitiesObject);
-                filterData.filterFn = global.property("filter");
-                if (!filterData.filterFn.isFunction()) {
-                    qDebug() << "Filter function specified but not found. Will reject all edits for those without lock rights.";
-                    delete engine;
-                    filterData.rejectAll=true;
-                }
+        if (setFilterScript(entityID, scriptContents, urlString)) {
+            emit filterAdded(entityID, true);
+            return;
+        }
+    } else if (scriptRequest) {
+        const QString urlString = scriptRequest->getUrl().toString();
+        qCritical() << "Failed to download script";
+        // See HTTPResourceRequest::onRequestFinished for interpretation of codes. For example, a 404 is code 6 and 403 is 3. A timeout is 2. Go figure.
+        qCritical() << "ResourceRequest error was" << scriptRequest->getResult();
+    } else {
+        qCritical() << "Failed to create script request.";
+    }
+    emit filterAdded(entityID, false);
+}
 
-                // if the wantsToFilterEdit is a boolean evaluate as a boolean, otherwise assume true
-                QScriptValue wantsToFilterAddValue = filterData.filterFn.property("wantsToFilterAdd");
-                filterData.wantsToFilterAdd = wantsToFilterAddValue.isBool() ? wantsToFilterAddValue.toBool() : true;
-
-                // if the wantsToFilterEdit is a boolean evaluate as a boolean, otherwise assume true
-                QScriptValue wantsToFilterEditValue = filterData.filterFn.property("wantsToFilterEdit");
-                filterData.wantsToFilterEdit = wantsToFilterEditValue.isBool() ? wantsToFilterEditValue.toBool() : true;
-
-                // if the wantsToFilterPhysics is a boolean evaluate as a boolean, otherwise assume true
-                QScriptValue wantsToFilterPhysicsValue = filterData.filterFn.property("wantsToFilterPhysics");
-                filterData.wantsToFilterPhysics = wantsToFilterPhysicsValue.isBool() ? wantsToFilterPhysicsValue.toBool() : true;
-
-                // if the wantsToFilterDelete is a boolean evaluate as a boolean, otherwise assume false
-                QScriptValue wantsToFilterDeleteValue = filterData.filterFn.property("wantsToFilterDelete");
-                filterData.wantsToFilterDelete = wantsToFilterDeleteValue.isBool() ? wantsToFilterDeleteValue.toBool() : false;
-
-                // check to see if the filterFn has properties asking for Original props
-                QScriptValue wantsOriginalPropertiesValue = filterData.filterFn.property("wantsOriginalProperties");
-                // if the wantsOriginalProperties is a boolean, or a string, or list of strings, then evaluate as follows:
-                //   - boolean - true  - include all original properties
-                //               false - no properties at all
-                //   - string  - empty - no properties at all
-                //               any valid property - include just that property in the Original properties
-                //   - list of strings - include only those properties in the Original properties
-                if (wantsOriginalPropertiesValue.isBool()) {
-                    filterData.wantsOriginalProperties = wantsOriginalPropertiesValue.toBool();
-                } else if (wantsOriginalPropertiesValue.isString()) {
-                    auto stringValue = wantsOriginalPropertiesValue.toString();
-                    filterData.wantsOriginalProperties = !stringValue.isEmpty();
-                    if (filterData.wantsOriginalProperties) {
-                        EntityPropertyFlagsFromScriptValue(wantsOriginalPropertiesValue, filterData.includedOriginalProperties);
-                    }
-                } else if (wantsOriginalPropertiesValue.isArray()) {
+bool EntityEditFilters::setFilterScript(EntityItemID entityID, const QString& scriptContents, const QString& urlString) {
+    QScriptProgram program(scriptContents, urlString);
+    if (hasCorrectSyntax(program)) {
+        // create a QScriptEngine for this script
+        QScriptEngine* engine = new QScriptEngine();
+        engine->setObjectName("filter:" + entityID.toString());
+        engine->setProperty("type", "edit_filter");
+        engine->setProperty("fileName", urlString);
+        engine->setProperty("entityID", entityID);
+        engine->globalObject().setProperty("Script", engine->newQObject(engine));
+        DependencyManager::get<ScriptInitializers>()->runScriptInitializers(engine);
+        engine->evaluate(scriptContents, urlString);
+        if (!hadUncaughtExceptions(*engine, urlString)) {
+            // put the engine in the engine map (so we don't leak them, etc...)
+            FilterData filterData;
+            filterData.engine = engine;
+            filterData.rejectAll = false;
+            
+            // define the uncaughtException function
+            QScriptEngine& engineRef = *engine;
+            filterData.uncaughtExceptions = [&engineRef, urlString]() { return hadUncaughtExceptions(engineRef, urlString); };
+
+            // now get the filter function
+            auto global = engine->globalObject();
+            auto entitiesObject = engine->newObject();
+            entitiesObject.setProperty("ADD_FILTER_TYPE", EntityTree::FilterType::Add);
+            entitiesObject.setProperty("EDIT_FILTER_TYPE", EntityTree::FilterType::Edit);
+            entitiesObject.setProperty("PHYSICS_FILTER_TYPE", EntityTree::FilterType::Physics);
+            entitiesObject.setProperty("DELETE_FILTER_TYPE", EntityTree::FilterType::Delete);
+            global.setProperty("Entities", entitiesObject);
+            filterData.filterFn = global.property("filter");
+            if (!filterData.filterFn.isFunction()) {
+                qDebug() << "Filter function specified but not found. Will reject all edits for those without lock rights.";
+                delete engine;
+                filterData.rejectAll=true;
+            }
+
+            // if the wantsToFilterEdit is a boolean evaluate as a boolean, otherwise assume true
+            QScriptValue wantsToFilterAddValue = filterData.filterFn.property("wantsToFilterAdd");
+            filterData.wantsToFilterAdd = wantsToFilterAddValue.isBool() ? wantsToFilterAddValue.toBool() : true;
+
+            // if the wantsToFilterEdit is a boolean evaluate as a boolean, otherwise assume true
+            QScriptValue wantsToFilterEditValue = filterData.filterFn.property("wantsToFilterEdit");
+            filterData.wantsToFilterEdit = wantsToFilterEditValue.isBool() ? wantsToFilterEditValue.toBool() : true;
+
+            // if the wantsToFilterPhysics is a boolean evaluate as a boolean, otherwise assume true
+            QScriptValue wantsToFilterPhysicsValue = filterData.filterFn.property("wantsToFilterPhysics");
+            filterData.wantsToFilterPhysics = wantsToFilterPhysicsValue.isBool() ? wantsToFilterPhysicsValue.toBool() : true;
+
+            // if the wantsToFilterDelete is a boolean evaluate as a boolean, otherwise assume false
+            QScriptValue wantsToFilterDeleteValue = filterData.filterFn.property("wantsToFilterDelete");
+            filterData.wantsToFilterDelete = wantsToFilterDeleteValue.isBool() ? wantsToFilterDeleteValue.toBool() : false;
+
+            // check to see if the filterFn has properties asking for Original props
+            QScriptValue wantsOriginalPropertiesValue = filterData.filterFn.property("wantsOriginalProperties");
+            // if the wantsOriginalProperties is a boolean, or a string, or list of strings, then evaluate as follows:
+            //   - boolean - true  - include all original properties
+            //               false - no properties at all
+            //   - string  - empty - no properties at all
+            //               any valid property - include just that property in the Original properties
+            //   - list of strings - include only those properties in the Original properties
+            if (wantsOriginalPropertiesValue.isBool()) {
+                filterData.wantsOriginalProperties = wantsOriginalPropertiesValue.toBool();
+            } else if (wantsOriginalPropertiesValue.isString()) {
+                auto stringValue = wantsOriginalPropertiesValue.toString();
+                filterData.wantsOriginalProperties = !stringValue.isEmpty();
+                if (filterData.wantsOriginalProperties) {
                     EntityPropertyFlagsFromScriptValue(wantsOriginalPropertiesValue, filterData.includedOriginalProperties);
-                    filterData.wantsOriginalProperties = !filterData.includedOriginalProperties.isEmpty();
                 }
+            } else if (wantsOriginalPropertiesValue.isArray()) {
+                EntityPropertyFlagsFromScriptValue(wantsOriginalPropertiesValue, filterData.includedOriginalProperties);
+                filterData.wantsOriginalProperties = !filterData.includedOriginalProperties.isEmpty();
+            }
 
-                // check to see if the filterFn has properties asking for Zone props
-                QScriptValue wantsZonePropertiesValue = filterData.filterFn.property("wantsZoneProperties");
-                // if the wantsZoneProperties is a boolean, or a string, or list of strings, then evaluate as follows:
-                //   - boolean - true  - include all Zone properties
-                //               false - no properties at all
-                //   - string  - empty - no properties at all
-                //               any valid property - include just that property in the Zone properties
-                //   - list of strings - include only those properties in the Zone properties
-                if (wantsZonePropertiesValue.isBool()) {
-                    filterData.wantsZoneProperties = wantsZonePropertiesValue.toBool();
-                    filterData.wantsZoneBoundingBox = filterData.wantsZoneProperties; // include this too
-                } else if (wantsZonePropertiesValue.isString()) {
-                    auto stringValue = wantsZonePropertiesValue.toString();
-                    filterData.wantsZoneProperties = !stringValue.isEmpty();
-                    if (filterData.wantsZoneProperties) {
+            // check to see if the filterFn has properties asking for Zone props
+            QScriptValue wantsZonePropertiesValue = filterData.filterFn.property("wantsZoneProperties");
+            // if the wantsZoneProperties is a boolean, or a string, or list of strings, then evaluate as follows:
+            //   - boolean - true  - include all Zone properties
+            //               false - no properties at all
+            //   - string  - empty - no properties at all
+            //               any valid property - include just that property in the Zone properties
+            //   - list of strings - include only those properties in the Zone properties
+            if (wantsZonePropertiesValue.isBool()) {
+                filterData.wantsZoneProperties = wantsZonePropertiesValue.toBool();
+                filterData.wantsZoneBoundingBox = filterData.wantsZoneProperties; // include this too
+            } else if (wantsZonePropertiesValue.isString()) {
+                auto stringValue = wantsZonePropertiesValue.toString();
+                filterData.wantsZoneProperties = !stringValue.isEmpty();
+                if (filterData.wantsZoneProperties) {
+                    if (stringValue == "boundingBox") {
+                        filterData.wantsZoneBoundingBox = true;
+                    } else {
+                        EntityPropertyFlagsFromScriptValue(wantsZonePropertiesValue, filterData.includedZoneProperties);
+                    }
+                }
+            } else if (wantsZonePropertiesValue.isArray()) {
+                auto length = wantsZonePropertiesValue.property("length").toInteger();
+                for (int i = 0; i < length; i++) {
+                    auto stringValue = wantsZonePropertiesValue.property(i).toString();
+                    if (!stringValue.isEmpty()) {
+                        filterData.wantsZoneProperties = true;
+
+                        // boundingBox is a special case since it's not a true EntityPropertyFlag, so we
+                        // need to detect it here.
                         if (stringValue == "boundingBox") {
                             filterData.wantsZoneBoundingBox = true;
-                        } else {
-                            EntityPropertyFlagsFromScriptValue(wantsZonePropertiesValue, filterData.includedZoneProperties);
+                            break; // we can break here, since there are no other special cases
                         }
-                    }
-                } else if (wantsZonePropertiesValue.isArray()) {
-                    auto length = wantsZonePropertiesValue.property("length").toInteger();
-                    for (int i = 0; i < length; i++) {
-                        auto stringValue = wantsZonePropertiesValue.property(i).toString();
-                        if (!stringValue.isEmpty()) {
-                            filterData.wantsZoneProperties = true;
-
-                            // boundingBox is a special case since it's not a true EntityPropertyFlag, so we
-                            // need to detect it here.
-                            if (stringValue == "boundingBox") {
-                                filterData.wantsZoneBoundingBox = true;
-                                break; // we can break here, since there are no other special cases
-                            }
 
-                        }
-                    }
-                    if (filterData.wantsZoneProperties) {
-                        EntityPropertyFlagsFromScriptValue(wantsZonePropertiesValue, filterData.includedZoneProperties);
                     }
                 }
+                if (filterData.wantsZoneProperties) {
+                    EntityPropertyFlagsFromScriptValue(wantsZonePropertiesValue, filterData.includedZoneProperties);
+                }
+            }
 
-                _lock.lockForWrite();
-                _filterDataMap.insert(entityID, filterData);
-                _lock.unlock();
+            readDeclarativeFilter(filterData);
 
-                qDebug() << "script request filter processed for entity id " << entityID;
-                
-                emit filterAdded(entityID, true);
-                return;
-            }
-        } 
-    } else if (scriptRequest) {
-        const QString urlString = scriptRequest->getUrl().toString();
-        qCritical() << "Failed to download script";
-        // See HTTPResourceRequest::onRequestFinished for interpretation of codes. For example, a 404 is code 6 and 403 is 3. A timeout is 2. Go figure.
-        qCritical() << "ResourceRequest error was" << scriptRequest->getResult();
-    } else {
-        qCritical() << "Failed to create script request.";
+            _lock.lockForWrite();
+            _filterDataMap.insert(entityID, filterData);
+            _lock.unlock();
+
+            qDebug() << "script request filter processed for entity id " << entityID;
+            return true;
+        }
     }
-    emit filterAdded(entityID, false);
+    return false;
 }
@@ -12,12 +12,17 @@
 #define hifi_EntityEditFilters_h
 
 #include <QObject>
+#include <QHash>
 #include <QMap>
 #include <QScriptValue>
 #include <QScriptEngine>
 #include <glm/glm.hpp>
 
 #include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #include "EntityItemID.h"
 #include "EntityItemProperties.h"
@@ -26,6 +31,33 @@
 class EntityEditFilters : public QObject, public Dependency {
     Q_OBJECT
 public:
+    // Token bucket per entity, for filters that set maxEditsPerSecond.
+    class EditRateLimiter {
+    public:
+        EditRateLimiter(float editsPerSecond, float burst) : _editsPerSecond(editsPerSecond), _burst(burst) {}
+        bool allowEdit(const EntityItemID& entityID, quint64 now);
+
+    private:
+        struct Bucket {
+            float tokens;
+            quint64 lastRefill;
+        };
+
+        std::mutex _mutex;
+        float _editsPerSecond;
+        float _burst;
+        QHash<EntityItemID, Bucket> _buckets;
+        quint64 _nextPrune { 0 };
+    };
+
+    // A simple value range for a numeric property, applied to each component of a vec3.
+    struct PropertyRange {
+        int property { -1 }; // index into the properties that can be ranged natively, see EntityEditFilters.cpp
+        float min { -std::numeric_limits<float>::max() };
+        float max { std::numeric_limits<float>::max() };
+        bool clamp { false }; // otherwise edits out of range are rejected
+    };
+
     struct FilterData {
         QScriptValue filterFn;
         bool wantsOriginalProperties { false };
@@ -40,6 +72,14 @@ public:
         EntityPropertyFlags includedZoneProperties;
         bool wantsZoneBoundingBox { false };
 
+        // Declarative stage, evaluated natively before filterFn is called.  With a property mask filterFn is only
+        // called for edits that change one of those properties, and only those properties are passed to it.
+        bool hasPropertyMask { false };
+        EntityPropertyFlags propertyMask;
+        std::vector<EntityPropertyList> propertyMaskList;
+        std::vector<PropertyRange> propertyRanges;
+        std::shared_ptr<EditRateLimiter> rateLimiter;
+
         std::function<bool()> uncaughtExceptions;
         QScriptEngine* engine;
         bool rejectAll;
@@ -54,6 +94,9 @@ public:
     void addFilter(EntityItemID entityID, QString filterURL);
     void removeFilter(EntityItemID entityID);
 
+    // compiles a downloaded filter script, returns false if it failed to load (all edits are then rejected)
+    bool setFilterScript(EntityItemID entityID, const QString& scriptContents, const QString& urlString);
+
     bool filter(glm::vec3& position, EntityItemProperties& propertiesIn, EntityItemProperties& propertiesOut, bool& wasChanged, 
                 EntityTree::FilterType filterType, EntityItemID& entityID, const EntityItemPointer& existingEntity);
 
@@ -65,6 +108,9 @@ private slots:
     
 private:
     QList<EntityItemID> getZonesByPosition(glm::vec3& position);
+    void readDeclarativeFilter(FilterData& filterData);
+    bool passesDeclarativeFilter(const FilterData& filterData, EntityItemProperties& propertiesIn,
+                                 EntityItemProperties& propertiesOut, bool& wasChanged, const EntityItemID& entityID);
 
     EntityTreePointer _tree {};
     bool _rejectAll {false};
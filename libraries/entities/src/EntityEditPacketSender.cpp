@@ -39,6 +39,13 @@ void EntityEditPacketSender::adjustEditPacketForClockSkew(PacketType type, QByte
     }
 }
 
+void EntityEditPacketSender::packEditMessage(PacketType type, QByteArray& buffer) {
+    // physics edits are sent many times a second and are mostly numbers, which the dictionary doesn't help with
+    if (type == PacketType::EntityAdd || type == PacketType::EntityEdit) {
+        EntityItemProperties::compressEntityEditMessage(buffer, getCompressionDictionary());
+    }
+}
+
 void EntityEditPacketSender::queueEditAvatarEntityMessage(EntityTreePointer entityTree, EntityItemID entityItemID) {
     assert(_myAvatar);
     if (!entityTree) {
@@ -42,6 +42,7 @@ public:
     // My server type is the model server
     virtual char getMyNodeType() const override { return NodeType::EntityServer; }
     virtual void adjustEditPacketForClockSkew(PacketType type, QByteArray& buffer, qint64 clockSkew) override;
+    virtual void packEditMessage(PacketType type, QByteArray& buffer) override;
 
 signals:
     void addingEntityWithCertificate(const QString& certificateID, const QString& placeName);
@@ -1311,7 +1311,8 @@ EntityPropertyFlags EntityItemProperties::getChangedProperties() const {
  *     entity update it.
  *     <p>The size of this property increases with the size and complexity of the PolyVox entity, with the size depending on how 
  *     the particular entity's voxels compress. Because this property value has to fit within a High Fidelity datagram packet, 
- *     there is a limit to the size and complexity of a PolyVox entity; edits which would result in an overflow are rejected.</p>
+ *     there is a limit to the size and complexity of a PolyVox entity; edits which would result in an overflow are rejected.
+ *     The voxels are compressed in bricks of 16 x 16 x 16, and bricks that hold a single value take up next to nothing.</p>
  * @property {Entities.PolyVoxSurfaceStyle} voxelSurfaceStyle=2 - The style of rendering the voxels' surface and how 
  *     neighboring PolyVox entities are joined.
  * @property {string} xTextureURL="" - The URL of the texture to map to surfaces perpendicular to the entity's local x-axis. 
@@ -3604,6 +3605,66 @@ QByteArray EntityItemProperties::packStrokeColors(const QVector<vec3>& strokeCol
     return packedStrokeColors;
 }
 
+AtomicUIntStat EntityItemProperties::_decodedEditMessages { 0 };
+AtomicUIntStat EntityItemProperties::_compressedEditMessages { 0 };
+AtomicUIntStat EntityItemProperties::_compressedEditBytes { 0 };
+AtomicUIntStat EntityItemProperties::_uncompressedEditBytes { 0 };
+
+void EntityItemProperties::compressEntityEditMessage(QByteArray& buffer, const OctreeCompressionDictionaryPointer& dictionary) {
+    const int MAX_COMPRESSION = 9;
+
+    // only a dictionary makes compressing messages this small worthwhile, and then only when they got smaller
+    quint16 compressedSize = 0;
+    if (dictionary) {
+        QByteArray compressed = dictionary->compress(reinterpret_cast<const unsigned char*>(buffer.constData()),
+                                                     buffer.size(), MAX_COMPRESSION);
+        if (!compressed.isEmpty() && compressed.size() < buffer.size() &&
+            compressed.size() <= std::numeric_limits<quint16>::max()) {
+            compressedSize = (quint16)compressed.size();
+            buffer = compressed;
+        }
+    }
+    buffer.prepend(reinterpret_cast<const char*>(&compressedSize), sizeof(compressedSize));
+}
+
+bool EntityItemProperties::decodeCompressedEntityEditPacket(const unsigned char* data, int bytesToRead, int& processedBytes,
+                                                            EntityItemID& entityID, EntityItemProperties& properties) {
+    quint16 compressedSize;
+    processedBytes = 0;
+    if (bytesToRead < (int)sizeof(compressedSize)) {
+        return false;
+    }
+    memcpy(&compressedSize, data, sizeof(compressedSize));
+    data += sizeof(compressedSize);
+    bytesToRead -= sizeof(compressedSize);
+    _decodedEditMessages++;
+
+    if (compressedSize == 0) {
+        bool valid = decodeEntityEditPacket(data, bytesToRead, processedBytes, entityID, properties);
+        processedBytes += sizeof(compressedSize);
+        return valid;
+    }
+
+    // the rest of the packet can be read even if this edit can't be
+    processedBytes = sizeof(compressedSize) + std::min((int)compressedSize, bytesToRead);
+    if (compressedSize > bytesToRead) {
+        return false;
+    }
+
+    QByteArray uncompressed = OctreeCompressionDictionary::uncompress(data, compressedSize);
+    if (uncompressed.isEmpty()) {
+        qCWarning(entities) << "Dropped an entity edit that was compressed with a dictionary this server doesn't have";
+        return false;
+    }
+    _compressedEditMessages++;
+    _compressedEditBytes += compressedSize;
+    _uncompressedEditBytes += uncompressed.size();
+
+    int uncompressedBytesRead = 0;
+    return decodeEntityEditPacket(reinterpret_cast<const unsigned char*>(uncompressed.constData()), uncompressed.size(),
+                                  uncompressedBytesRead, entityID, properties);
+}
+
 // TODO:
 //   how to handle lastEdited?
 //   how to handle lastUpdated?
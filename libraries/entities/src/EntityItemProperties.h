@@ -29,7 +29,9 @@
 #include <AACube.h>
 #include <NumericalConstants.h>
 #include <PropertyFlags.h>
+#include <OctreeCompressionDictionary.h>
 #include <OctreeConstants.h>
+#include <PerfStat.h>
 #include <ShapeInfo.h>
 #include <ColorUtils.h>
 #include "FontFamilies.h"
@@ -451,6 +453,17 @@ public:
     static bool decodeEntityEditPacket(const unsigned char* data, int bytesToRead, int& processedBytes,
                                        EntityItemID& entityID, EntityItemProperties& properties);
 
+    // Adds and edits go out with the size they were compressed to with the entity server's dictionary in front of them,
+    // or 0 if they went out as they were encoded.
+    static void compressEntityEditMessage(QByteArray& buffer, const OctreeCompressionDictionaryPointer& dictionary);
+    static bool decodeCompressedEntityEditPacket(const unsigned char* data, int bytesToRead, int& processedBytes,
+                                                 EntityItemID& entityID, EntityItemProperties& properties);
+
+    static quint64 getDecodedEditMessages() { return _decodedEditMessages; } /// adds and edits decoded
+    static quint64 getCompressedEditMessages() { return _compressedEditMessages; } /// of which were compressed
+    static quint64 getCompressedEditBytes() { return _compressedEditBytes; } /// total bytes of the compressed ones
+    static quint64 getUncompressedEditBytes() { return _uncompressedEditBytes; } /// total bytes they uncompressed to
+
     void clearID() { _id = UNKNOWN_ENTITY_ID; _idSet = false; }
     void markAllChanged();
 
@@ -555,6 +568,11 @@ private:
     bool _renderInfoHasTransparent { false };
 
     EntityPropertyFlags _desiredProperties; // if set will narrow scopes of copy/to/from to just these properties
+
+    static AtomicUIntStat _decodedEditMessages;
+    static AtomicUIntStat _compressedEditMessages;
+    static AtomicUIntStat _compressedEditBytes;
+    static AtomicUIntStat _uncompressedEditBytes;
 };
 
 Q_DECLARE_METATYPE(EntityItemProperties);
@@ -12,10 +12,14 @@
 #ifndef hifi_EntityNodeData_h
 #define hifi_EntityNodeData_h
 
+#include <atomic>
+
 #include <udt/PacketHeaders.h>
 
 #include <OctreeQueryNode.h>
 
+#include "DeletedEntityLog.h"
+
 namespace EntityJSONQueryProperties {
     static const QString SERVER_SCRIPTS_PROPERTY = "serverScripts";
     static const QString FLAGS_PROPERTY = "flags";
@@ -29,6 +33,11 @@ public:
 
     quint64 getLastDeletedEntitiesSentAt() const { return _lastDeletedEntitiesSentAt; }
     void setLastDeletedEntitiesSentAt(quint64 sentAt) { _lastDeletedEntitiesSentAt = sentAt; }
+
+    // the end of the server's deleted entity log when deleted entities were last sent to this node.
+    // Set by the node's send thread, read by the others when the server prunes the log
+    DeletedEntityLog::Sequence getDeletedEntitiesCursor() const { return _deletedEntitiesCursor; }
+    void setDeletedEntitiesCursor(DeletedEntityLog::Sequence cursor) { _deletedEntitiesCursor = cursor; }
     
     // these can only be called from the OctreeSendThread for the given Node
     void insertSentFilteredEntity(const QUuid& entityID) { _sentFilteredEntities.insert(entityID); }
@@ -46,6 +55,7 @@ public:
 
 private:
     quint64 _lastDeletedEntitiesSentAt { usecTimestampNow() };
+    std::atomic<DeletedEntityLog::Sequence> _deletedEntitiesCursor { DeletedEntityLog::NO_CURSOR };
     QSet<QUuid> _sentFilteredEntities;
     QHash<QUuid, QSet<QUuid>> _flaggedExtraEntities;
     QHash<QUuid, QSet<QUuid>> _previousFlaggedExtraEntities;
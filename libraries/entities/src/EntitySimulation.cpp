@@ -11,8 +11,11 @@
 
 #include "EntitySimulation.h"
 
+#include <algorithm>
+
 #include <AACube.h>
 #include <Profile.h>
+#include <TBBHelpers.h>
 
 #include "EntitiesLogging.h"
 #include "MovingEntitiesOperator.h"
@@ -36,10 +39,22 @@ void EntitySimulation::updateEntities() {
 
     // these methods may accumulate entries in _entitiesToBeDeleted
     expireMortalEntities(now);
+    uint64_t expired = usecTimestampNow();
     callUpdateOnEntitiesThatNeedIt(now);
+    uint64_t updated = usecTimestampNow();
     moveSimpleKinematics(now);
+    uint64_t moved = usecTimestampNow();
     sortEntitiesThatMoved();
+    uint64_t sorted = usecTimestampNow();
     processDeadEntities();
+    uint64_t end = usecTimestampNow();
+
+    _updateStats.expireTime.updateAverage(expired - now);
+    _updateStats.updateTime.updateAverage(updated - expired);
+    _updateStats.moveTime.updateAverage(moved - updated);
+    _updateStats.sortTime.updateAverage(sorted - moved);
+    _updateStats.deadTime.updateAverage(end - sorted);
+    _updateStats.totalTime.updateAverage(end - now);
 }
 
 void EntitySimulation::removeEntityFromInternalLists(EntityItemPointer entity) {
@@ -99,6 +114,8 @@ void EntitySimulation::expireMortalEntities(uint64_t now) {
 void EntitySimulation::callUpdateOnEntitiesThatNeedIt(uint64_t now) {
     PerformanceTimer perfTimer("updatingEntities");
     QMutexLocker lock(&_mutex);
+    // updates stay on this thread: an update may change how the entity is simulated (which comes back into this
+    // simulation under _mutex), or lock and edit other entities, as PolyVox entities do with their neighbors
     SetOfEntities::iterator itemItr = _entitiesToUpdate.begin();
     while (itemItr != _entitiesToUpdate.end()) {
         EntityItemPointer entity = *itemItr;
@@ -226,37 +243,113 @@ void EntitySimulation::clearEntities() {
     _nextExpiry = std::numeric_limits<uint64_t>::max();
 }
 
+namespace {
+
+const int MAX_HIERARCHY_DEPTH = 30; // see MAX_PARENTING_CHAIN_SIZE
+
+struct KinematicStep {
+    EntityItemPointer entity;
+    const SpatiallyNestable* root { nullptr };
+    int depth { 0 };
+    bool stillKinematic { false };
+    bool needsSort { false };
+};
+
+// Finds the outermost ancestor of the entity, and how deep the entity is below it.  Looking the parents up also
+// caches them, so that later lookups from other threads don't need the parent finder (and the tree lock).
+bool findHierarchyRoot(const EntityItemPointer& entity, KinematicStep& step) {
+    bool success;
+    step.root = entity.get();
+    step.depth = 0;
+    SpatiallyNestablePointer parent = entity->getParentPointer(success);
+    while (success && parent) {
+        if (++step.depth > MAX_HIERARCHY_DEPTH) {
+            return false;
+        }
+        step.root = parent.get();
+        parent = parent->getParentPointer(success);
+    }
+    return success;
+}
+
+void stepSimpleKinematic(KinematicStep& step, uint64_t now) {
+    const EntityItemPointer& entity = step.entity;
+    bool ancestryIsKnown;
+    entity->getMaximumAACube(ancestryIsKnown);
+
+    bool isMoving = entity->isMovingRelativeToParent();
+    if (isMoving && !entity->getPhysicsInfo() && ancestryIsKnown) {
+        entity->simulate(now);
+        entity->updateQueryAACube();
+        step.stillKinematic = true;
+        step.needsSort = true;
+    } else if (!isMoving && ancestryIsKnown) {
+        // HACK: This catches most cases where the entity's QueryAACube (and spatial sorting in the EntityTree)
+        // would otherwise be out of date at conclusion of its "unowned" simpleKinematicMotion.
+        entity->updateQueryAACube();
+        step.needsSort = true;
+    }
+}
+
+}
+
 void EntitySimulation::moveSimpleKinematics(uint64_t now) {
     PROFILE_RANGE_EX(simulation_physics, "MoveSimples", 0xffff00ff, (uint64_t)_simpleKinematicEntities.size());
+
+    // Moving an entity moves its descendants and grows the query cubes of its ancestors, so the entities are batched
+    // by the root of their hierarchy.  The batches are moved in parallel, the entities in a batch parents first.
+    std::vector<KinematicStep> steps;
+    steps.reserve(_simpleKinematicEntities.size());
     SetOfEntities::iterator itemItr = _simpleKinematicEntities.begin();
     while (itemItr != _simpleKinematicEntities.end()) {
-        EntityItemPointer entity = *itemItr;
+        KinematicStep step;
+        step.entity = *itemItr;
 
         // The entity-server doesn't know where avatars are, so don't attempt to do simple extrapolation for
         // children of avatars.  See related code in EntityMotionState::remoteSimulationOutOfSync.
-        bool ancestryIsKnown;
-        entity->getMaximumAACube(ancestryIsKnown);
-        bool hasAvatarAncestor = entity->hasAncestorOfType(NestableType::Avatar);
-
-        bool isMoving = entity->isMovingRelativeToParent();
-        if (isMoving && !entity->getPhysicsInfo() && ancestryIsKnown && !hasAvatarAncestor) {
-            entity->simulate(now);
-            if (ancestryIsKnown && !hasAvatarAncestor) {
-                entity->updateQueryAACube();
-            }
-            _entitiesToSort.insert(entity);
+        if (findHierarchyRoot(step.entity, step) && !step.entity->hasAncestorOfType(NestableType::Avatar)) {
+            steps.push_back(step);
             ++itemItr;
         } else {
-            if (!isMoving && ancestryIsKnown && !hasAvatarAncestor) {
-                // HACK: This catches most cases where the entity's QueryAACube (and spatial sorting in the EntityTree)
-                // would otherwise be out of date at conclusion of its "unowned" simpleKinematicMotion.
-                entity->updateQueryAACube();
-                _entitiesToSort.insert(entity);
-            }
             // the entity is no longer non-physical-kinematic
             itemItr = _simpleKinematicEntities.erase(itemItr);
         }
     }
+
+    std::sort(steps.begin(), steps.end(), [](const KinematicStep& a, const KinematicStep& b) {
+        return a.root < b.root || (a.root == b.root && a.depth < b.depth);
+    });
+    std::vector<size_t> batchEnds;
+    for (size_t i = 1; i <= steps.size(); ++i) {
+        if (i == steps.size() || steps[i].root != steps[i - 1].root) {
+            batchEnds.push_back(i);
+        }
+    }
+
+    const size_t MIN_BATCHES_PER_TASK = 32;
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, batchEnds.size(), MIN_BATCHES_PER_TASK),
+                      [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t batch = range.begin(); batch != range.end(); ++batch) {
+            for (size_t i = batch > 0 ? batchEnds[batch - 1] : 0; i < batchEnds[batch]; ++i) {
+                stepSimpleKinematic(steps[i], now);
+            }
+        }
+    });
+
+    int numMoved = 0;
+    for (const auto& step : steps) {
+        if (step.needsSort) {
+            _entitiesToSort.insert(step.entity);
+        }
+        if (step.stillKinematic) {
+            numMoved++;
+        } else {
+            // the entity is no longer non-physical-kinematic
+            _simpleKinematicEntities.remove(step.entity);
+        }
+    }
+    _updateStats.numMoved.updateAverage((float)numMoved);
+    _updateStats.numMoveBatches.updateAverage((float)batchEnds.size());
 }
 
 void EntitySimulation::processDeadEntities() {
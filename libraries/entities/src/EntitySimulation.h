@@ -19,6 +19,7 @@
 #include <QVector>
 
 #include <PerfStat.h>
+#include <SimpleMovingAverage.h>
 
 #include "EntityItem.h"
 #include "EntityTree.h"
@@ -80,6 +81,19 @@ public:
     void processChangedEntities();
     virtual void queueEraseDomainEntity(const QUuid& id) const { }
 
+    // moving averages of the time each stage of updateEntities takes, in usecs, and of how much it moved
+    struct UpdateStats {
+        SimpleMovingAverage expireTime;
+        SimpleMovingAverage updateTime;
+        SimpleMovingAverage moveTime;
+        SimpleMovingAverage sortTime;
+        SimpleMovingAverage deadTime;
+        SimpleMovingAverage totalTime;
+        SimpleMovingAverage numMoved;
+        SimpleMovingAverage numMoveBatches;
+    };
+    const UpdateStats& getUpdateStats() const { return _updateStats; }
+
 protected:
     virtual void addEntityToInternalLists(EntityItemPointer entity);
     virtual void removeEntityFromInternalLists(EntityItemPointer entity);
@@ -96,6 +110,8 @@ protected:
     SetOfEntities _simpleKinematicEntities; // entities undergoing non-colliding kinematic motion
     SetOfEntities _deadEntitiesToRemoveFromTree;
 
+    UpdateStats _updateStats;
+
 private:
     void moveSimpleKinematics();
 
@@ -33,6 +33,7 @@
 
 #include "AddEntityOperator.h"
 #include "UpdateEntityOperator.h"
+#include <DirtyOctreeElementOperator.h>
 #include "QVariantGLM.h"
 #include "EntitiesLogging.h"
 #include "RecurseOctreeToMapOperator.h"
@@ -804,6 +805,7 @@ void EntityTree::deleteEntitiesByPointer(const std::vector<EntityItemPointer>& e
 void EntityTree::processRemovedEntities(const DeleteEntityOperator& theOperator) {
     // NOTE: assume tree already write-locked because this method only called in deleteEntitiesByPointer()
     quint64 deletedAt = usecTimestampNow();
+    std::vector<QUuid> deletedIDs;
     const RemovedEntities& entities = theOperator.getEntities();
     foreach(const EntityToDeleteDetails& details, entities) {
         EntityItemPointer theEntity = details.entity;
@@ -811,8 +813,7 @@ void EntityTree::processRemovedEntities(const DeleteEntityOperator& theOperator)
             removeCertifiedEntityOnServer(theEntity);
 
             // set up the deleted entities ID
-            QWriteLocker recentlyDeletedEntitiesLocker(&_recentlyDeletedEntitiesLock);
-            _recentlyDeletedEntityItemIDs.insert(deletedAt, theEntity->getEntityItemID());
+            deletedIDs.push_back(theEntity->getEntityItemID());
         } else {
             theEntity->forEachDescendant([&](SpatiallyNestablePointer child) {
                 if (child->getNestableType() == NestableType::Avatar) {
@@ -833,6 +834,7 @@ void EntityTree::processRemovedEntities(const DeleteEntityOperator& theOperator)
             _simulation->prepareEntityForDelete(theEntity);
         }
     }
+    _deletedEntityLog.append(deletedAt, deletedIDs);
 }
 
 class RayArgs {
@@ -1817,331 +1819,428 @@ void EntityTree::processChallengeOwnershipPacket(ReceivedMessage& message, const
     }
 }
 
-// NOTE: Caller must lock the tree before calling this.
-int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
-                                     const SharedNodePointer& senderNode) {
-    if (!getIsServer()) {
-        qCWarning(entities) << "EntityTree::processEditPacketData() should only be called on a server tree.";
-        return 0;
-    }
+// Decodes and vets one add, clone or edit.  This only reads the tree, the entities involved and the entity map, so
+// the caller only needs to lock the tree for reading.
+EntityTree::PreparedEdit EntityTree::prepareEdit(ReceivedMessage& message, const unsigned char* editData, int maxLength,
+                                                 const SharedNodePointer& senderNode, int& processedBytes) {
+    PreparedEdit edit;
+    PacketType packetType = message.getType();
+    edit.isClone = packetType == PacketType::EntityClone;
+    edit.isAdd = edit.isClone || packetType == PacketType::EntityAdd;
+    edit.isPhysics = packetType == PacketType::EntityPhysics;
 
-    int processedBytes = 0;
-    bool isAdd = false;
-    bool isClone = false;
-    // we handle these types of "edit" packets
-    switch (message.getType()) {
-        case PacketType::EntityErase: {
-            QByteArray dataByteArray = QByteArray::fromRawData(reinterpret_cast<const char*>(editData), maxLength);
-            processedBytes = processEraseMessageDetails(dataByteArray, senderNode);
-            break;
-        }
+    quint64 startDecode = 0, endDecode = 0;
+    quint64 startLookup = 0, endLookup = 0;
+    quint64 startFilter = 0, endFilter = 0;
 
-        case PacketType::EntityClone:
-            isClone = true; // fall through to next case
-            // FALLTHRU
-        case PacketType::EntityAdd:
-            isAdd = true;  // fall through to next case
-            // FALLTHRU
-        case PacketType::EntityPhysics:
-        case PacketType::EntityEdit: {
-            quint64 startDecode = 0, endDecode = 0;
-            quint64 startLookup = 0, endLookup = 0;
-            quint64 startUpdate = 0, endUpdate = 0;
-            quint64 startCreate = 0, endCreate = 0;
-            quint64 startFilter = 0, endFilter = 0;
-            quint64 startLogging = 0, endLogging = 0;
-
-            bool suppressDisallowedClientScript = false;
-            bool suppressDisallowedServerScript = false;
-            bool suppressDisallowedPrivateUserData = false;
-            bool isPhysics = message.getType() == PacketType::EntityPhysics;
-
-            _totalEditMessages++;
-
-            EntityItemID entityItemID;
-            EntityItemProperties properties;
-            startDecode = usecTimestampNow();
-
-            bool validEditPacket = false;
-            EntityItemID entityIDToClone;
-            EntityItemPointer entityToClone;
-            if (isClone) {
-                QByteArray buffer = QByteArray::fromRawData(reinterpret_cast<const char*>(editData), maxLength);
-                validEditPacket = EntityItemProperties::decodeCloneEntityMessage(buffer, processedBytes, entityIDToClone, entityItemID);
-                if (validEditPacket) {
-                    entityToClone = findEntityByEntityItemID(entityIDToClone);
-                    if (entityToClone) {
-                        properties = entityToClone->getProperties();
-                    }
-                }
-            } else {
-                validEditPacket = EntityItemProperties::decodeEntityEditPacket(editData, maxLength, processedBytes, entityItemID, properties);
-            }
+    _totalEditMessages++;
 
-            endDecode = usecTimestampNow();
+    EntityItemID& entityItemID = edit.entityItemID;
+    EntityItemProperties& properties = edit.properties;
+    startDecode = usecTimestampNow();
 
-            EntityItemPointer existingEntity;
-            if (!isAdd) {
-                // search for the entity by EntityItemID
-                startLookup = usecTimestampNow();
-                existingEntity = findEntityByEntityItemID(entityItemID);
-                endLookup = usecTimestampNow();
-                if (!existingEntity) {
-                    // this is not an add-entity operation, and we don't know about the identified entity.
-                    validEditPacket = false;
-                }
+    bool& validEditPacket = edit.valid;
+    if (edit.isClone) {
+        QByteArray buffer = QByteArray::fromRawData(reinterpret_cast<const char*>(editData), maxLength);
+        validEditPacket = EntityItemProperties::decodeCloneEntityMessage(buffer, processedBytes, edit.entityIDToClone, entityItemID);
+        if (validEditPacket) {
+            edit.entityToClone = findEntityByEntityItemID(edit.entityIDToClone);
+            if (edit.entityToClone) {
+                properties = edit.entityToClone->getProperties();
             }
+        }
+    } else if (edit.isPhysics) {
+        validEditPacket = EntityItemProperties::decodeEntityEditPacket(editData, maxLength, processedBytes, entityItemID, properties);
+    } else {
+        validEditPacket = EntityItemProperties::decodeCompressedEntityEditPacket(editData, maxLength, processedBytes,
+                                                                                 entityItemID, properties);
+    }
 
-            if (validEditPacket && !_entityScriptSourceWhitelist.isEmpty()) {
-
-                bool wasDeletedBecauseOfClientScript = false;
+    endDecode = usecTimestampNow();
 
-                // check the client entity script to make sure its URL is in the whitelist
-                if (!properties.getScript().isEmpty()) {
-                    bool clientScriptPassedWhitelist = isScriptInWhitelist(properties.getScript());
+    if (!edit.isAdd) {
+        // search for the entity by EntityItemID
+        startLookup = usecTimestampNow();
+        edit.existingEntity = findEntityByEntityItemID(entityItemID);
+        endLookup = usecTimestampNow();
+        if (!edit.existingEntity) {
+            // this is not an add-entity operation, and we don't know about the identified entity.
+            validEditPacket = false;
+        }
+    }
 
-                    if (!clientScriptPassedWhitelist) {
-                        if (wantEditLogging()) {
-                            qCDebug(entities) << "User [" << senderNode->getUUID()
-                                << "] attempting to set entity script not on whitelist, edit rejected";
-                        }
+    if (validEditPacket && !_entityScriptSourceWhitelist.isEmpty()) {
 
-                        // If this was an add, we also want to tell the client that sent this edit that the entity was not added.
-                        if (isAdd) {
-                            QWriteLocker locker(&_recentlyDeletedEntitiesLock);
-                            _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
-                            validEditPacket = false;
-                            wasDeletedBecauseOfClientScript = true;
-                        } else {
-                            suppressDisallowedClientScript = true;
-                        }
-                    }
-                }
+        bool wasDeletedBecauseOfClientScript = false;
 
-                // check all server entity scripts to make sure their URLs are in the whitelist
-                if (!properties.getServerScripts().isEmpty()) {
-                    bool serverScriptPassedWhitelist = isScriptInWhitelist(properties.getServerScripts());
+        // check the client entity script to make sure its URL is in the whitelist
+        if (!properties.getScript().isEmpty()) {
+            bool clientScriptPassedWhitelist = isScriptInWhitelist(properties.getScript());
 
-                    if (!serverScriptPassedWhitelist) {
-                        if (wantEditLogging()) {
-                            qCDebug(entities) << "User [" << senderNode->getUUID()
-                                << "] attempting to set server entity script not on whitelist, edit rejected";
-                        }
+            if (!clientScriptPassedWhitelist) {
+                if (wantEditLogging()) {
+                    qCDebug(entities) << "User [" << senderNode->getUUID()
+                        << "] attempting to set entity script not on whitelist, edit rejected";
+                }
 
-                        // If this was an add, we also want to tell the client that sent this edit that the entity was not added.
-                        if (isAdd) {
-                            // Make sure we didn't already need to send back a delete because the client script failed
-                            // the whitelist check
-                            if (!wasDeletedBecauseOfClientScript) {
-                                QWriteLocker locker(&_recentlyDeletedEntitiesLock);
-                                _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
-                                validEditPacket = false;
-                            }
-                        } else {
-                            suppressDisallowedServerScript = true;
-                        }
-                    }
+                // If this was an add, we also want to tell the client that sent this edit that the entity was not added.
+                if (edit.isAdd) {
+                    _deletedEntityLog.append(usecTimestampNow(), entityItemID);
+                    validEditPacket = false;
+                    wasDeletedBecauseOfClientScript = true;
+                } else {
+                    edit.suppressDisallowedClientScript = true;
                 }
             }
+        }
 
-            if (!properties.getPrivateUserData().isEmpty() && validEditPacket && !senderNode->getCanGetAndSetPrivateUserData()) {
+        // check all server entity scripts to make sure their URLs are in the whitelist
+        if (!properties.getServerScripts().isEmpty()) {
+            bool serverScriptPassedWhitelist = isScriptInWhitelist(properties.getServerScripts());
+
+            if (!serverScriptPassedWhitelist) {
                 if (wantEditLogging()) {
                     qCDebug(entities) << "User [" << senderNode->getUUID()
-                        << "] is attempting to set private user data but user isn't allowed; edit rejected...";
+                        << "] attempting to set server entity script not on whitelist, edit rejected";
                 }
 
                 // If this was an add, we also want to tell the client that sent this edit that the entity was not added.
-                if (isAdd) {
-                    QWriteLocker locker(&_recentlyDeletedEntitiesLock);
-                    _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
-                    validEditPacket = false;
+                if (edit.isAdd) {
+                    // Make sure we didn't already need to send back a delete because the client script failed
+                    // the whitelist check
+                    if (!wasDeletedBecauseOfClientScript) {
+                        _deletedEntityLog.append(usecTimestampNow(), entityItemID);
+                        validEditPacket = false;
+                    }
                 } else {
-                    suppressDisallowedPrivateUserData = true;
+                    edit.suppressDisallowedServerScript = true;
                 }
             }
+        }
+    }
 
-            if (!isClone) {
-                if ((isAdd || properties.lifetimeChanged()) &&
-                    ((!senderNode->getCanRez() && senderNode->getCanRezTmp()) ||
-                    (!senderNode->getCanRezCertified() && senderNode->getCanRezTmpCertified()))) {
-                    // this node is only allowed to rez temporary entities.  if need be, cap the lifetime.
-                    if (properties.getLifetime() == ENTITY_ITEM_IMMORTAL_LIFETIME ||
-                        properties.getLifetime() > _maxTmpEntityLifetime) {
-                        properties.setLifetime(_maxTmpEntityLifetime);
-                        bumpTimestamp(properties);
-                    }
-                }
+    if (!properties.getPrivateUserData().isEmpty() && validEditPacket && !senderNode->getCanGetAndSetPrivateUserData()) {
+        if (wantEditLogging()) {
+            qCDebug(entities) << "User [" << senderNode->getUUID()
+                << "] is attempting to set private user data but user isn't allowed; edit rejected...";
+        }
 
-                if (isAdd && properties.getLocked() && !senderNode->isAllowedEditor()) {
-                    // if a node can't change locks, don't allow it to create an already-locked entity -- automatically
-                    // clear the locked property and allow the unlocked entity to be created.
-                    properties.setLocked(false);
-                    bumpTimestamp(properties);
-                }
+        // If this was an add, we also want to tell the client that sent this edit that the entity was not added.
+        if (edit.isAdd) {
+            _deletedEntityLog.append(usecTimestampNow(), entityItemID);
+            validEditPacket = false;
+        } else {
+            edit.suppressDisallowedPrivateUserData = true;
+        }
+    }
+
+    if (!edit.isClone) {
+        if ((edit.isAdd || properties.lifetimeChanged()) &&
+            ((!senderNode->getCanRez() && senderNode->getCanRezTmp()) ||
+            (!senderNode->getCanRezCertified() && senderNode->getCanRezTmpCertified()))) {
+            // this node is only allowed to rez temporary entities.  if need be, cap the lifetime.
+            if (properties.getLifetime() == ENTITY_ITEM_IMMORTAL_LIFETIME ||
+                properties.getLifetime() > _maxTmpEntityLifetime) {
+                properties.setLifetime(_maxTmpEntityLifetime);
+                bumpTimestamp(properties);
             }
+        }
 
-            // If we got a valid edit packet, then it could be a new entity or it could be an update to
-            // an existing entity... handle appropriately
-            if (validEditPacket) {
-                startFilter = usecTimestampNow();
-                bool wasChanged = false;
-                // Having (un)lock rights bypasses the filter, unless it's a physics result.
-                FilterType filterType = isPhysics ? FilterType::Physics : (isAdd ? FilterType::Add : FilterType::Edit);
-                //senderNode->getCanRez()
-
-                //bool allowed = (!isPhysics && senderNode->isAllowedEditor()) || filterProperties(existingEntity, properties, properties, wasChanged, filterType);
-
-                bool allowed = (
-                    (!isPhysics && senderNode->isAllowedEditor()) ||
-                    filterProperties(existingEntity, properties, properties, wasChanged, filterType)
-                );
-                if (!allowed) {
-                    // the update failed and we need to convey that fact to the sender
-                    // our method is to re-assert the current properties and bump the lastEdited timestamp
-                    auto timestamp = properties.getLastEdited();
-                    properties = EntityItemProperties();
-                    properties.setLastEdited(timestamp);
-                }
-                if (!allowed || wasChanged) {
-                    bumpTimestamp(properties);
-                    // For now, free ownership on any modification.
-                    properties.clearSimulationOwner();
-                }
-                endFilter = usecTimestampNow();
+        if (edit.isAdd && properties.getLocked() && !senderNode->isAllowedEditor()) {
+            // if a node can't change locks, don't allow it to create an already-locked entity -- automatically
+            // clear the locked property and allow the unlocked entity to be created.
+            properties.setLocked(false);
+            bumpTimestamp(properties);
+        }
+    }
 
-                if (existingEntity && !isAdd) {
+    if (validEditPacket) {
+        startFilter = usecTimestampNow();
+        bool wasChanged = false;
+        // Having (un)lock rights bypasses the filter, unless it's a physics result.
+        FilterType filterType = edit.isPhysics ? FilterType::Physics : (edit.isAdd ? FilterType::Add : FilterType::Edit);
+        edit.allowed = (
+            (!edit.isPhysics && senderNode->isAllowedEditor()) ||
+            filterProperties(edit.existingEntity, properties, properties, wasChanged, filterType)
+        );
+        if (!edit.allowed) {
+            // the update failed and we need to convey that fact to the sender
+            // our method is to re-assert the current properties and bump the lastEdited timestamp
+            auto timestamp = properties.getLastEdited();
+            properties = EntityItemProperties();
+            properties.setLastEdited(timestamp);
+        }
+        if (!edit.allowed || wasChanged) {
+            bumpTimestamp(properties);
+            // For now, free ownership on any modification.
+            properties.clearSimulationOwner();
+        }
+        endFilter = usecTimestampNow();
 
-                    if (suppressDisallowedClientScript) {
-                        bumpTimestamp(properties);
-                        properties.setScript(existingEntity->getScript());
-                    }
+        if (edit.existingEntity && !edit.isAdd) {
+            if (edit.suppressDisallowedClientScript) {
+                bumpTimestamp(properties);
+                properties.setScript(edit.existingEntity->getScript());
+            }
 
-                    if (suppressDisallowedServerScript) {
-                        bumpTimestamp(properties);
-                        properties.setServerScripts(existingEntity->getServerScripts());
-                    }
+            if (edit.suppressDisallowedServerScript) {
+                bumpTimestamp(properties);
+                properties.setServerScripts(edit.existingEntity->getServerScripts());
+            }
 
-                    if (suppressDisallowedPrivateUserData) {
-                        bumpTimestamp(properties);
-                        properties.setPrivateUserData(existingEntity->getPrivateUserData());
-                    }
+            if (edit.suppressDisallowedPrivateUserData) {
+                bumpTimestamp(properties);
+                properties.setPrivateUserData(edit.existingEntity->getPrivateUserData());
+            }
 
-                    // if the EntityItem exists, then update it
-                    startLogging = usecTimestampNow();
-                    if (wantEditLogging()) {
-                        qCDebug(entities) << "User [" << senderNode->getUUID() << "] editing entity. ID:" << entityItemID;
-                        qCDebug(entities) << "   properties:" << properties;
-                    }
-                    if (wantTerseEditLogging()) {
-                        QList<QString> changedProperties = properties.listChangedProperties();
-                        fixupTerseEditLogging(properties, changedProperties);
-                        qCDebug(entities) << senderNode->getUUID() << "edit" <<
-                            existingEntity->getDebugName() << changedProperties;
-                    }
-                    endLogging = usecTimestampNow();
+            if (!edit.isPhysics) {
+                properties.setLastEditedBy(senderNode->getUUID());
+            }
+        }
+    }
 
-                    startUpdate = usecTimestampNow();
-                    if (!isPhysics) {
-                        properties.setLastEditedBy(senderNode->getUUID());
-                    }
-                    updateEntity(existingEntity, properties, senderNode);
-                    existingEntity->markAsChangedOnServer();
-                    endUpdate = usecTimestampNow();
-                    _totalUpdates++;
-                } else if (isAdd) {
-                    bool failedAdd = !allowed;
-                    bool isCertified = !properties.getCertificateID().isEmpty();
-                    bool isCloneable = properties.getCloneable();
-                    int cloneLimit = properties.getCloneLimit();
-                    if (!allowed) {
-                        qCDebug(entities) << "Filtered entity add. ID:" << entityItemID;
-                    } else if (!isClone && !isCertified && !senderNode->getCanRez() && !senderNode->getCanRezTmp()) {
-                        failedAdd = true;
-                        qCDebug(entities) << "User without 'uncertified rez rights' [" << senderNode->getUUID()
-                            << "] attempted to add an uncertified entity with ID:" << entityItemID;
-                    } else if (!isClone && isCertified && !senderNode->getCanRezCertified() && !senderNode->getCanRezTmpCertified()) {
-                        failedAdd = true;
-                        qCDebug(entities) << "User without 'certified rez rights' [" << senderNode->getUUID()
-                            << "] attempted to add a certified entity with ID:" << entityItemID;
-                    } else if (isClone && isCertified && !properties.getCertificateType().contains(DOMAIN_UNLIMITED)) {
-                        failedAdd = true;
-                        qCDebug(entities) << "User attempted to clone certified entity from entity ID:" << entityIDToClone;
-                    } else if (isClone && !isCloneable) {
-                        failedAdd = true;
-                        qCDebug(entities) << "User attempted to clone non-cloneable entity from entity ID:" << entityIDToClone;
-                    } else if (isClone && entityToClone && entityToClone->getCloneIDs().size() >= cloneLimit && cloneLimit != 0) {
-                        failedAdd = true;
-                        qCDebug(entities) << "User attempted to clone entity ID:" << entityIDToClone << " which reached it's cloneable limit.";
-                    } else {
-                        if (isClone) {
-                            properties.convertToCloneProperties(entityIDToClone);
-                        }
+    _totalDecodeTime += endDecode - startDecode;
+    _totalLookupTime += endLookup - startLookup;
+    _totalFilterTime += endFilter - startFilter;
 
-                        // this is a new entity... assign a new entityID
-                        properties.setLastEditedBy(senderNode->getUUID());
-                        startCreate = usecTimestampNow();
-                        EntityItemPointer newEntity = addEntity(entityItemID, properties);
-                        endCreate = usecTimestampNow();
-                        _totalCreates++;
-
-                        if (newEntity && isCertified && getIsServer()) {
-                            if (!properties.verifyStaticCertificateProperties()) {
-                                qCDebug(entities) << "User" << senderNode->getUUID()
-                                    << "attempted to add a certified entity with ID" << entityItemID << "which failed"
-                                    << "static certificate verification.";
-                                // Delete the entity we just added if it doesn't pass static certificate verification
-                                deleteEntity(entityItemID, true);
-                            } else {
-                                validatePop(properties.getCertificateID(), entityItemID, senderNode);
-                            }
-                        }
+    return edit;
+}
 
-                        if (newEntity && isClone) {
-                            entityToClone->addCloneID(newEntity->getEntityItemID());
-                            newEntity->setCloneOriginID(entityIDToClone);
-                        }
+// An edit to an existing entity can be applied with the tree only locked for reading when it can't move the entity
+// to another element, or touch its lock, simulation owner or family.  Anything else goes through updateEntity().
+bool EntityTree::canUpdateEntityInPlace(const PreparedEdit& edit, const SharedNodePointer& senderNode) const {
+    const EntityItemPointer& entity = edit.existingEntity;
+    if (!getIsServer() || edit.isAdd || !entity || !entity->getElement() || entity->getLocked() || entity->hasChildren()) {
+        return false;
+    }
 
-                        if (newEntity) {
-                            newEntity->markAsChangedOnServer();
-                            notifyNewlyCreatedEntity(*newEntity, senderNode);
-                            
-                            startLogging = usecTimestampNow();
-                            if (wantEditLogging()) {
-                                qCDebug(entities) << "User [" << senderNode->getUUID() << "] added entity. ID:"
-                                                  << newEntity->getEntityItemID();
-                                qCDebug(entities) << "   properties:" << properties;
-                            }
-                            if (wantTerseEditLogging()) {
-                                QList<QString> changedProperties = properties.listChangedProperties();
-                                fixupTerseEditLogging(properties, changedProperties);
-                                qCDebug(entities) << senderNode->getUUID() << "add" << entityItemID << changedProperties;
-                            }
-                            endLogging = usecTimestampNow();
+    const EntityItemProperties& properties = edit.properties;
+    if (properties.queryAACubeChanged() || properties.lockedChanged() || properties.simulationOwnerChanged() ||
+        properties.parentIDChanged() || properties.parentJointIndexChanged()) {
+        return false;
+    }
 
-                        } else {
-                            failedAdd = true;
-                            qCDebug(entities) << "Add entity failed ID:" << entityItemID;
-                        }
-                    }
-                    if (failedAdd) { // Let client know it failed, so that they don't have an entity that no one else sees.
-                        QWriteLocker locker(&_recentlyDeletedEntitiesLock);
-                        _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
-                    }
+    QUuid simulatorID = entity->getSimulatorID();
+    if (!simulatorID.isNull() && simulatorID != senderNode->getUUID()) {
+        // updateEntity() squashes the physical changes in edits from anyone but the simulation owner
+        return false;
+    }
+
+    bool allowAnyRez = senderNode->getCanRez() || senderNode->getCanRezCertified() ||
+        senderNode->getCanRezTmp() || senderNode->getCanRezTmpCertified();
+    return allowAnyRez || entity->isAvatarEntity() || entity->isLocalEntity();
+}
+
+// Applies an edit vetted by canUpdateEntityInPlace().  The caller holds the tree's read lock, so the containing
+// element can't change under us.  setProperties() locks the entity for each property it sets rather than for the
+// whole edit, so a send thread encoding the entity meanwhile can pick up part of the edit; it gets the rest once
+// markEntityEditedInPlace() has marked the element changed.  Returns the dirty flags the edit raised.
+uint32_t EntityTree::updateEntityInPlace(const EntityItemPointer& entity, const EntityItemProperties& properties,
+                                         const SharedNodePointer& senderNode) {
+    if (entity->getSimulatorID() == senderNode->getUUID()) {
+        entity->setSimulationOwnershipExpiry(usecTimestampNow() + MAX_INCOMING_SIMULATION_UPDATE_PERIOD);
+    }
+
+    QString entityScriptBefore = entity->getScript();
+    quint64 entityScriptTimestampBefore = entity->getScriptTimestamp();
+    uint32_t preFlags = entity->getDirtyFlags();
+
+    if (entity->setProperties(properties)) {
+        emit editingEntityPointer(entity);
+    }
+
+    QString entityScriptAfter = entity->getScript();
+    quint64 entityScriptTimestampAfter = entity->getScriptTimestamp();
+    bool reload = entityScriptTimestampBefore != entityScriptTimestampAfter;
+    if (entityScriptBefore != entityScriptAfter || reload) {
+        emitEntityScriptChanging(entity->getEntityItemID(), reload); // the entity script has changed
+    }
+
+    return entity->getDirtyFlags() & ~preFlags;
+}
+
+// The second half of an edit applied by updateEntityInPlace().  The send threads read the elements' change times and
+// the tree's dirty bit with the tree locked for reading, so the caller must hold the write lock.
+void EntityTree::markEntityEditedInPlace(const EntityItemPointer& entity, uint32_t newFlags) {
+    // the simulation may have deleted the entity while the tree was unlocked
+    if (!entity->getElement()) {
+        return;
+    }
+
+    DirtyOctreeElementOperator theOperator(entity->getElement());
+    recurseTreeWithOperator(&theOperator);
+    _isDirty = true;
+
+    if (newFlags) {
+        if (entity->isSimulated()) {
+            assert((bool)_simulation);
+            if (newFlags & DIRTY_SIMULATION_FLAGS) {
+                _simulation->changeEntity(entity);
+            }
+        } else {
+            // normally the _simulation clears ALL dirtyFlags, but when not possible we do it explicitly
+            entity->clearDirtyFlags();
+        }
+    }
+}
+
+// NOTE: Caller must lock the tree before calling this, for writing unless inPlace is set; an edit changedInPlace then
+// still needs markEntityEditedInPlace() with the write lock.
+void EntityTree::applyEdit(ReceivedMessage& message, PreparedEdit& edit, const SharedNodePointer& senderNode, bool inPlace) {
+    if (!edit.valid) {
+        return;
+    }
+
+    quint64 startUpdate = 0, endUpdate = 0;
+    quint64 startCreate = 0, endCreate = 0;
+    quint64 startLogging = 0, endLogging = 0;
+
+    const EntityItemID& entityItemID = edit.entityItemID;
+    EntityItemProperties& properties = edit.properties;
+    const EntityItemPointer& existingEntity = edit.existingEntity;
+
+    // the tree may have been unlocked since the edit was vetted, in the meantime the entity may have been deleted
+    if (existingEntity && !edit.isAdd && existingEntity->getElement()) {
+
+        // if the EntityItem exists, then update it
+        startLogging = usecTimestampNow();
+        if (wantEditLogging()) {
+            qCDebug(entities) << "User [" << senderNode->getUUID() << "] editing entity. ID:" << entityItemID;
+            qCDebug(entities) << "   properties:" << properties;
+        }
+        if (wantTerseEditLogging()) {
+            QList<QString> changedProperties = properties.listChangedProperties();
+            fixupTerseEditLogging(properties, changedProperties);
+            qCDebug(entities) << senderNode->getUUID() << "edit" <<
+                existingEntity->getDebugName() << changedProperties;
+        }
+        endLogging = usecTimestampNow();
+
+        startUpdate = usecTimestampNow();
+        if (inPlace) {
+            edit.inPlaceDirtyFlags = updateEntityInPlace(existingEntity, properties, senderNode);
+            edit.changedInPlace = true;
+        } else {
+            updateEntity(existingEntity, properties, senderNode);
+        }
+        existingEntity->markAsChangedOnServer();
+        endUpdate = usecTimestampNow();
+        _totalUpdates++;
+    } else if (edit.isAdd) {
+        const EntityItemID& entityIDToClone = edit.entityIDToClone;
+        const EntityItemPointer& entityToClone = edit.entityToClone;
+        bool isClone = edit.isClone;
+        bool failedAdd = !edit.allowed;
+        bool isCertified = !properties.getCertificateID().isEmpty();
+        bool isCloneable = properties.getCloneable();
+        int cloneLimit = properties.getCloneLimit();
+        if (!edit.allowed) {
+            qCDebug(entities) << "Filtered entity add. ID:" << entityItemID;
+        } else if (!isClone && !isCertified && !senderNode->getCanRez() && !senderNode->getCanRezTmp()) {
+            failedAdd = true;
+            qCDebug(entities) << "User without 'uncertified rez rights' [" << senderNode->getUUID()
+                << "] attempted to add an uncertified entity with ID:" << entityItemID;
+        } else if (!isClone && isCertified && !senderNode->getCanRezCertified() && !senderNode->getCanRezTmpCertified()) {
+            failedAdd = true;
+            qCDebug(entities) << "User without 'certified rez rights' [" << senderNode->getUUID()
+                << "] attempted to add a certified entity with ID:" << entityItemID;
+        } else if (isClone && isCertified && !properties.getCertificateType().contains(DOMAIN_UNLIMITED)) {
+            failedAdd = true;
+            qCDebug(entities) << "User attempted to clone certified entity from entity ID:" << entityIDToClone;
+        } else if (isClone && !isCloneable) {
+            failedAdd = true;
+            qCDebug(entities) << "User attempted to clone non-cloneable entity from entity ID:" << entityIDToClone;
+        } else if (isClone && entityToClone && entityToClone->getCloneIDs().size() >= cloneLimit && cloneLimit != 0) {
+            failedAdd = true;
+            qCDebug(entities) << "User attempted to clone entity ID:" << entityIDToClone << " which reached it's cloneable limit.";
+        } else {
+            if (isClone) {
+                properties.convertToCloneProperties(entityIDToClone);
+            }
+
+            // this is a new entity... assign a new entityID
+            properties.setLastEditedBy(senderNode->getUUID());
+            startCreate = usecTimestampNow();
+            EntityItemPointer newEntity = addEntity(entityItemID, properties);
+            endCreate = usecTimestampNow();
+            _totalCreates++;
+
+            if (newEntity && isCertified && getIsServer()) {
+                if (!properties.verifyStaticCertificateProperties()) {
+                    qCDebug(entities) << "User" << senderNode->getUUID()
+                        << "attempted to add a certified entity with ID" << entityItemID << "which failed"
+                        << "static certificate verification.";
+                    // Delete the entity we just added if it doesn't pass static certificate verification
+                    deleteEntity(entityItemID, true);
                 } else {
-                    HIFI_FCDEBUG(entities(), "Edit failed. [" << message.getType() <<"] " <<
-                            "entity id:" << entityItemID << 
-                            "existingEntity pointer:" << existingEntity.get());
+                    validatePop(properties.getCertificateID(), entityItemID, senderNode);
                 }
             }
 
+            if (newEntity && isClone) {
+                entityToClone->addCloneID(newEntity->getEntityItemID());
+                newEntity->setCloneOriginID(entityIDToClone);
+            }
 
-            _totalDecodeTime += endDecode - startDecode;
-            _totalLookupTime += endLookup - startLookup;
-            _totalUpdateTime += endUpdate - startUpdate;
-            _totalCreateTime += endCreate - startCreate;
-            _totalLoggingTime += endLogging - startLogging;
-            _totalFilterTime += endFilter - startFilter;
+            if (newEntity) {
+                newEntity->markAsChangedOnServer();
+                notifyNewlyCreatedEntity(*newEntity, senderNode);
+
+                startLogging = usecTimestampNow();
+                if (wantEditLogging()) {
+                    qCDebug(entities) << "User [" << senderNode->getUUID() << "] added entity. ID:"
+                                      << newEntity->getEntityItemID();
+                    qCDebug(entities) << "   properties:" << properties;
+                }
+                if (wantTerseEditLogging()) {
+                    QList<QString> changedProperties = properties.listChangedProperties();
+                    fixupTerseEditLogging(properties, changedProperties);
+                    qCDebug(entities) << senderNode->getUUID() << "add" << entityItemID << changedProperties;
+                }
+                endLogging = usecTimestampNow();
 
+            } else {
+                failedAdd = true;
+                qCDebug(entities) << "Add entity failed ID:" << entityItemID;
+            }
+        }
+        if (failedAdd) { // Let client know it failed, so that they don't have an entity that no one else sees.
+            _deletedEntityLog.append(usecTimestampNow(), entityItemID);
+        }
+    } else {
+        HIFI_FCDEBUG(entities(), "Edit failed. [" << message.getType() <<"] " <<
+                "entity id:" << entityItemID <<
+                "existingEntity pointer:" << existingEntity.get());
+    }
+
+    _totalUpdateTime += endUpdate - startUpdate;
+    _totalCreateTime += endCreate - startCreate;
+    _totalLoggingTime += endLogging - startLogging;
+}
+
+// NOTE: Caller must lock the tree before calling this.
+int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
+                                     const SharedNodePointer& senderNode) {
+    if (!getIsServer()) {
+        qCWarning(entities) << "EntityTree::processEditPacketData() should only be called on a server tree.";
+        return 0;
+    }
+
+    int processedBytes = 0;
+    // we handle these types of "edit" packets
+    switch (message.getType()) {
+        case PacketType::EntityErase: {
+            QByteArray dataByteArray = QByteArray::fromRawData(reinterpret_cast<const char*>(editData), maxLength);
+            processedBytes = processEraseMessageDetails(dataByteArray, senderNode);
+            break;
+        }
+
+        case PacketType::EntityClone:
+        case PacketType::EntityAdd:
+        case PacketType::EntityPhysics:
+        case PacketType::EntityEdit: {
+            PreparedEdit edit = prepareEdit(message, editData, maxLength, senderNode, processedBytes);
+            applyEdit(message, edit, senderNode, false);
             break;
         }
 
@@ -2152,6 +2251,62 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
     return processedBytes;
 }
 
+int EntityTree::lockAndProcessEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
+                                             const SharedNodePointer& senderNode, EditLockTimes& lockTimes) {
+    switch (message.getType()) {
+        case PacketType::EntityClone:
+        case PacketType::EntityAdd:
+        case PacketType::EntityPhysics:
+        case PacketType::EntityEdit:
+            if (getIsServer()) {
+                break;
+            }
+            // FALLTHRU
+        default:
+            return Octree::lockAndProcessEditPacketData(message, editData, maxLength, senderNode, lockTimes);
+    }
+
+    // decode, look up, whitelist and filter the edit alongside the send threads
+    int processedBytes = 0;
+    PreparedEdit edit;
+    withReadLock([&] {
+        edit = prepareEdit(message, editData, maxLength, senderNode, processedBytes);
+    });
+    if (!edit.valid) {
+        return processedBytes;
+    }
+
+    quint64 startLock = usecTimestampNow();
+    quint64 startApply = startLock;
+    bool appliedInPlace = false;
+    if (canUpdateEntityInPlace(edit, senderNode)) {
+        withReadLock([&] {
+            // the simulation may have moved or deleted the entity since the edit was vetted
+            if (canUpdateEntityInPlace(edit, senderNode)) {
+                startApply = usecTimestampNow();
+                applyEdit(message, edit, senderNode, true);
+                appliedInPlace = true;
+            }
+        });
+    }
+    if (appliedInPlace) {
+        // only marking the element changed needs the write lock, which is brief
+        if (edit.changedInPlace) {
+            withWriteLock([&] {
+                markEntityEditedInPlace(edit.existingEntity, edit.inPlaceDirtyFlags);
+            });
+        }
+    } else {
+        startLock = usecTimestampNow();
+        withWriteLock([&] {
+            startApply = usecTimestampNow();
+            applyEdit(message, edit, senderNode, false);
+        });
+    }
+    lockTimes.waitTime = startApply - startLock;
+    lockTimes.holdTime = usecTimestampNow() - startApply;
+    return processedBytes;
+}
 
 void EntityTree::notifyNewlyCreatedEntity(const EntityItem& newEntity, const SharedNodePointer& senderNode) {
     _newlyCreatedHooksLock.lockForRead();
@@ -2367,21 +2522,9 @@ quint64 EntityTree::getAdjustedConsiderSince(quint64 sinceTime) {
 }
 
 
-bool EntityTree::hasEntitiesDeletedSince(quint64 sinceTime) {
+bool EntityTree::hasEntitiesDeletedSince(quint64 sinceTime, DeletedEntityLog::Sequence cursor) const {
     quint64 considerEntitiesSince = getAdjustedConsiderSince(sinceTime);
-
-    // we can probably leverage the ordered nature of QMultiMap to do this quickly...
-    bool hasSomethingNewer = false;
-
-    QReadLocker locker(&_recentlyDeletedEntitiesLock);
-    QMultiMap<quint64, QUuid>::const_iterator iterator = _recentlyDeletedEntityItemIDs.constBegin();
-    while (iterator != _recentlyDeletedEntityItemIDs.constEnd()) {
-        if (iterator.key() > considerEntitiesSince) {
-            hasSomethingNewer = true;
-            break; // if we have at least one item, we don't need to keep searching
-        }
-        ++iterator;
-    }
+    bool hasSomethingNewer = _deletedEntityLog.hasDeletedSince(cursor, considerEntitiesSince);
 
 #ifdef EXTRA_ERASE_DEBUGGING
     if (hasSomethingNewer) {
@@ -2396,24 +2539,8 @@ bool EntityTree::hasEntitiesDeletedSince(quint64 sinceTime) {
 }
 
 // called by the server when it knows all nodes have been sent deleted packets
-void EntityTree::forgetEntitiesDeletedBefore(quint64 sinceTime) {
-    quint64 considerSinceTime = sinceTime - DELETED_ENTITIES_EXTRA_USECS_TO_CONSIDER;
-    QSet<quint64> keysToRemove;
-    QWriteLocker locker(&_recentlyDeletedEntitiesLock);
-    QMultiMap<quint64, QUuid>::iterator iterator = _recentlyDeletedEntityItemIDs.begin();
-
-    // First find all the keys in the map that are older and need to be deleted
-    while (iterator != _recentlyDeletedEntityItemIDs.end()) {
-        if (iterator.key() <= considerSinceTime) {
-            keysToRemove << iterator.key();
-        }
-        ++iterator;
-    }
-
-    // Now run through the keysToRemove and remove them
-    foreach (quint64 value, keysToRemove) {
-        _recentlyDeletedEntityItemIDs.remove(value);
-    }
+void EntityTree::forgetEntitiesDeletedBefore(quint64 sinceTime, DeletedEntityLog::Sequence cursor) {
+    _deletedEntityLog.forgetDeletedBefore(getAdjustedConsiderSince(sinceTime), cursor);
 }
 
 
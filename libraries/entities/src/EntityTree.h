@@ -19,6 +19,7 @@
 #include <SpatialParentFinder.h>
 
 #include "AddEntityOperator.h"
+#include "DeletedEntityLog.h"
 #include "EntityTreeElement.h"
 #include "DeleteEntityOperator.h"
 #include "MovingEntitiesOperator.h"
@@ -90,6 +91,8 @@ public:
     void fixupTerseEditLogging(EntityItemProperties& properties, QList<QString>& changedProperties);
     virtual int processEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
                                       const SharedNodePointer& senderNode) override;
+    virtual int lockAndProcessEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
+                                             const SharedNodePointer& senderNode, EditLockTimes& lockTimes) override;
     virtual void processChallengeOwnershipRequestPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) override;
     virtual void processChallengeOwnershipReplyPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) override;
     virtual void processChallengeOwnershipPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) override;
@@ -149,20 +152,14 @@ public:
     void addNewlyCreatedHook(NewlyCreatedEntityHook* hook);
     void removeNewlyCreatedHook(NewlyCreatedEntityHook* hook);
 
-    bool hasAnyDeletedEntities() const { 
-        QReadLocker locker(&_recentlyDeletedEntitiesLock);
-        return _recentlyDeletedEntityItemIDs.size() > 0;
-    }
+    bool hasAnyDeletedEntities() const { return !_deletedEntityLog.isEmpty(); }
 
-    bool hasEntitiesDeletedSince(quint64 sinceTime);
+    bool hasEntitiesDeletedSince(quint64 sinceTime, DeletedEntityLog::Sequence cursor = DeletedEntityLog::NO_CURSOR) const;
     static quint64 getAdjustedConsiderSince(quint64 sinceTime);
 
-    QMultiMap<quint64, QUuid> getRecentlyDeletedEntityIDs() const { 
-        QReadLocker locker(&_recentlyDeletedEntitiesLock);
-        return _recentlyDeletedEntityItemIDs;
-    }
+    const DeletedEntityLog& getDeletedEntityLog() const { return _deletedEntityLog; }
 
-    void forgetEntitiesDeletedBefore(quint64 sinceTime);
+    void forgetEntitiesDeletedBefore(quint64 sinceTime, DeletedEntityLog::Sequence cursor = DeletedEntityLog::NO_CURSOR);
 
     int processEraseMessage(ReceivedMessage& message, const SharedNodePointer& sourceNode);
     int processEraseMessageDetails(const QByteArray& buffer, const SharedNodePointer& sourceNode);
@@ -305,6 +302,33 @@ protected:
     void processRemovedEntities(const DeleteEntityOperator& theOperator);
     bool updateEntity(EntityItemPointer entity, const EntityItemProperties& properties,
             const SharedNodePointer& senderNode = SharedNodePointer(nullptr));
+
+    // an add, clone or edit that has been decoded and vetted, but not applied to the tree yet
+    struct PreparedEdit {
+        bool valid { false };
+        bool isAdd { false };
+        bool isClone { false };
+        bool isPhysics { false };
+        bool allowed { false };
+        bool suppressDisallowedClientScript { false };
+        bool suppressDisallowedServerScript { false };
+        bool suppressDisallowedPrivateUserData { false };
+        EntityItemID entityItemID;
+        EntityItemID entityIDToClone;
+        EntityItemPointer entityToClone;
+        EntityItemPointer existingEntity;
+        EntityItemProperties properties;
+        // set once an edit has been applied with only the tree's read lock
+        bool changedInPlace { false };
+        uint32_t inPlaceDirtyFlags { 0 };
+    };
+    PreparedEdit prepareEdit(ReceivedMessage& message, const unsigned char* editData, int maxLength,
+                             const SharedNodePointer& senderNode, int& processedBytes);
+    void applyEdit(ReceivedMessage& message, PreparedEdit& edit, const SharedNodePointer& senderNode, bool inPlace);
+    bool canUpdateEntityInPlace(const PreparedEdit& edit, const SharedNodePointer& senderNode) const;
+    uint32_t updateEntityInPlace(const EntityItemPointer& entity, const EntityItemProperties& properties,
+                                 const SharedNodePointer& senderNode);
+    void markEntityEditedInPlace(const EntityItemPointer& entity, uint32_t newFlags);
     static bool sendEntitiesOperation(const OctreeElementPointer& element, void* extraData);
     static void bumpTimestamp(EntityItemProperties& properties);
 
@@ -315,8 +339,7 @@ protected:
     QReadWriteLock _newlyCreatedHooksLock;
     QVector<NewlyCreatedEntityHook*> _newlyCreatedHooks;
 
-    mutable QReadWriteLock _recentlyDeletedEntitiesLock; /// lock of server side recent deletes
-    QMultiMap<quint64, QUuid> _recentlyDeletedEntityItemIDs; /// server side recent deletes
+    DeletedEntityLog _deletedEntityLog; /// server side recent deletes
 
     mutable QReadWriteLock _deletedEntitiesLock; /// lock of client side recent deletes
     QSet<QUuid> _deletedEntityItemIDs; /// client side recent deletes
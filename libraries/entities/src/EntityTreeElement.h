@@ -13,6 +13,7 @@
 #define hifi_EntityTreeElement_h
 
 #include <memory>
+#include <unordered_map>
 
 #include <OctreeElement.h>
 #include <QList>
@@ -56,6 +57,7 @@ public:
     bool subtreeCompleted;
     bool childCompleted[NUMBER_OF_CHILDREN];
     QMap<EntityItemID, EntityPropertyFlags> entities;
+    std::unordered_map<const EntityItem*, quint64> voxelBricksSent; // see PolyVoxBricks::writePatchAfter
 };
 using EntityTreeElementExtraEncodeDataPointer = std::shared_ptr<EntityTreeElementExtraEncodeData>;
 
@@ -0,0 +1,462 @@
+//
+//  PolyVoxBricks.cpp
+//  libraries/entities/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PolyVoxBricks.h"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+#include <QDataStream>
+
+#include "EntitiesLogging.h"
+#include "PolyVoxEntityItem.h"
+
+namespace {
+
+// the older format starts with the x dimension, which is never 0
+const quint16 BRICKED_FORMAT_MARKER = 0;
+const quint8 UNVERSIONED_FORMAT_VERSION = 1;
+const quint8 BRICKED_FORMAT_VERSION = 2;
+const quint8 PATCH_FLAG = 1;
+
+// each entry is the first brick, the number of bricks, the type, the version, and what they hold
+enum BrickType : quint8 {
+    UNIFORM_BRICKS = 0, // followed by the value of every voxel in the bricks
+    COMPRESSED_BRICK = 1 // followed by the length and the compressed voxels of a single brick
+};
+
+const int HEADER_SIZE = sizeof(quint16) + 2 * sizeof(quint8) + 3 * sizeof(quint16) + sizeof(quint8);
+const int ENTRY_HEADER_SIZE = 2 * sizeof(quint16) + sizeof(quint8) + sizeof(quint32);
+
+const int COMPRESSION_LEVEL = 9;
+
+bool isValidVolumeSize(int x, int y, int z) {
+    const int MAX_VOXEL_DIMENSION = (int)PolyVoxEntityItem::MAX_VOXEL_DIMENSION;
+    return x > 0 && x <= MAX_VOXEL_DIMENSION && y > 0 && y <= MAX_VOXEL_DIMENSION && z > 0 && z <= MAX_VOXEL_DIMENSION;
+}
+
+int getEntrySize(const PolyVoxBricks::Brick& brick) {
+    return ENTRY_HEADER_SIZE + (brick.compressed.isEmpty() ? (int)sizeof(quint8) :
+                                (int)sizeof(quint16) + brick.compressed.size());
+}
+
+}
+
+PolyVoxBricks::Brick PolyVoxBricks::Brick::encode(const QByteArray& voxels) {
+    Brick brick;
+    if (voxels.isEmpty()) {
+        return brick;
+    }
+
+    const char* data = voxels.constData();
+    if (std::all_of(data + 1, data + voxels.size(), [&](char value) { return value == data[0]; })) {
+        brick.value = (uint8_t)data[0];
+    } else {
+        brick.compressed = qCompress(voxels, COMPRESSION_LEVEL);
+    }
+    return brick;
+}
+
+QByteArray PolyVoxBricks::Brick::decode(int numVoxels) const {
+    if (compressed.isEmpty()) {
+        return QByteArray(numVoxels, (char)value);
+    }
+
+    QByteArray voxels = qUncompress(compressed);
+    if (voxels.size() != numVoxels) {
+        qCDebug(entities) << "PolyVox brick uncompressed to" << voxels.size() << "voxels, expected" << numVoxels;
+        return QByteArray(numVoxels, '\0');
+    }
+    return voxels;
+}
+
+PolyVoxBricks::PolyVoxBricks(const glm::ivec3& voxelVolumeSize) :
+    _voxelVolumeSize(voxelVolumeSize),
+    _numBricks((voxelVolumeSize + BRICK_SIZE - 1) / BRICK_SIZE) {
+    int numBricks = _numBricks.x * _numBricks.y * _numBricks.z;
+    _bricks.resize(numBricks);
+    _versions.resize(numBricks, 0);
+    _dirty.resize(numBricks, false);
+}
+
+bool PolyVoxBricks::read(const QByteArray& voxelData) {
+    bool patch;
+    glm::ivec3 voxelVolumeSize;
+    std::vector<Entry> entries;
+    if (!readEntries(voxelData, patch, voxelVolumeSize, entries) || patch) {
+        return false;
+    }
+
+    *this = PolyVoxBricks(voxelVolumeSize);
+    for (const auto& entry : entries) {
+        for (int i = entry.first; i < entry.first + entry.count; i++) {
+            _bricks[i] = entry.brick;
+            _versions[i] = entry.version;
+        }
+    }
+    return true;
+}
+
+bool PolyVoxBricks::merge(const QByteArray& voxelData) {
+    bool patch;
+    glm::ivec3 voxelVolumeSize;
+    std::vector<Entry> entries;
+    if (!readEntries(voxelData, patch, voxelVolumeSize, entries)) {
+        return false;
+    }
+
+    if (voxelVolumeSize != _voxelVolumeSize) {
+        quint32 version = 0;
+        for (const auto& entry : entries) {
+            version = std::max(version, entry.version);
+        }
+        if (isValid() && version < getLatestVersion()) {
+            // from before the volume was resized, and arrived late
+            return true;
+        }
+        resize(voxelVolumeSize);
+    }
+
+    // a late packet may have bricks we already have newer versions of
+    for (const auto& entry : entries) {
+        for (int i = entry.first; i < entry.first + entry.count; i++) {
+            if (entry.version >= _versions[i]) {
+                setBrick(i, entry.brick);
+                _versions[i] = entry.version;
+            }
+        }
+    }
+    return true;
+}
+
+bool PolyVoxBricks::applyEdit(const QByteArray& voxelData) {
+    bool patch;
+    glm::ivec3 voxelVolumeSize;
+    std::vector<Entry> entries;
+    if (!readEntries(voxelData, patch, voxelVolumeSize, entries)) {
+        return false;
+    }
+
+    // voxelData saved by an entity-server that has since restarted may have newer versions than the bricks it replaces
+    quint32 version = getLatestVersion();
+    for (const auto& entry : entries) {
+        version = std::max(version, entry.version);
+    }
+    version++;
+
+    if (voxelVolumeSize != _voxelVolumeSize) {
+        // what everyone has is for another size of volume, so all of it is new
+        resize(voxelVolumeSize);
+        std::fill(_versions.begin(), _versions.end(), version);
+    }
+    for (const auto& entry : entries) {
+        for (int i = entry.first; i < entry.first + entry.count; i++) {
+            if (_bricks[i] != entry.brick) {
+                setBrick(i, entry.brick);
+                _versions[i] = version;
+            }
+        }
+    }
+    return true;
+}
+
+void PolyVoxBricks::resize(const glm::ivec3& voxelVolumeSize) {
+    quint32 version = getLatestVersion();
+    *this = PolyVoxBricks(voxelVolumeSize);
+    std::fill(_versions.begin(), _versions.end(), version);
+    setAllDirty();
+}
+
+QByteArray PolyVoxBricks::write() const {
+    std::vector<int> indices(_bricks.size());
+    std::iota(indices.begin(), indices.end(), 0);
+    std::vector<Entry> entries = makeEntries(indices);
+    return writeEntries(entries, 0, entries.size(), false);
+}
+
+QByteArray PolyVoxBricks::writePatch() const {
+    std::vector<int> indices;
+    for (int i = 0; i < getNumBricksTotal(); i++) {
+        if (_dirty[i]) {
+            indices.push_back(i);
+        }
+    }
+    std::vector<Entry> entries = makeEntries(indices);
+    return writeEntries(entries, 0, entries.size(), true);
+}
+
+std::vector<QByteArray> PolyVoxBricks::writePatches(const std::vector<int>& indices, int maxSize) const {
+    std::vector<int> sortedIndices = indices;
+    std::sort(sortedIndices.begin(), sortedIndices.end());
+    std::vector<Entry> entries = makeEntries(sortedIndices);
+
+    std::vector<QByteArray> patches;
+    size_t begin = 0;
+    int size = HEADER_SIZE;
+    for (size_t i = 0; i < entries.size(); i++) {
+        int entrySize = getEntrySize(entries[i].brick);
+        if (HEADER_SIZE + entrySize > maxSize) {
+            qCWarning(entities) << "PolyVox brick" << entries[i].first << "compresses to" << entries[i].brick.compressed.size()
+                                << "bytes, which is too large to send";
+            if (begin < i) {
+                patches.push_back(writeEntries(entries, begin, i, true));
+            }
+            begin = i + 1;
+            size = HEADER_SIZE;
+            continue;
+        }
+        if (size + entrySize > maxSize) {
+            patches.push_back(writeEntries(entries, begin, i, true));
+            begin = i;
+            size = HEADER_SIZE;
+        }
+        size += entrySize;
+    }
+    if (begin < entries.size()) {
+        patches.push_back(writeEntries(entries, begin, entries.size(), true));
+    }
+    return patches;
+}
+
+QByteArray PolyVoxBricks::writePatchAfter(quint64& cursor, int maxSize) const {
+    std::vector<int> indices;
+    for (int i = 0; i < getNumBricksTotal(); i++) {
+        if (getSendKey(i) > cursor) {
+            indices.push_back(i);
+        }
+    }
+    std::sort(indices.begin(), indices.end(), [&](int a, int b) { return getSendKey(a) < getSendKey(b); });
+    std::vector<Entry> entries = makeEntries(indices);
+
+    std::vector<Entry> sending;
+    int size = HEADER_SIZE;
+    for (const auto& entry : entries) {
+        int entrySize = getEntrySize(entry.brick);
+        if (HEADER_SIZE + entrySize > MAX_PATCH_SIZE) {
+            // no packet is big enough for it, so the receiver goes without it rather than everything after it
+            qCWarning(entities) << "PolyVox brick" << entry.first << "compresses to" << entry.brick.compressed.size()
+                                << "bytes, which is too large to send";
+        } else if (size + entrySize > maxSize) {
+            break;
+        } else {
+            sending.push_back(entry);
+            size += entrySize;
+        }
+        cursor = getSendKey(entry.first + entry.count - 1);
+    }
+
+    if (sending.empty()) {
+        return QByteArray();
+    }
+    return writeEntries(sending, 0, sending.size(), true);
+}
+
+bool PolyVoxBricks::hasBricksAfter(quint64 cursor) const {
+    for (int i = 0; i < getNumBricksTotal(); i++) {
+        if (getSendKey(i) > cursor) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool PolyVoxBricks::isPatch(const QByteArray& voxelData) {
+    const int FLAGS_OFFSET = sizeof(quint16) + sizeof(quint8);
+    return voxelData.size() > FLAGS_OFFSET && voxelData[0] == 0 && voxelData[1] == 0 &&
+        ((quint8)voxelData[2] == BRICKED_FORMAT_VERSION || (quint8)voxelData[2] == UNVERSIONED_FORMAT_VERSION) &&
+        ((quint8)voxelData[FLAGS_OFFSET] & PATCH_FLAG);
+}
+
+glm::ivec3 PolyVoxBricks::getBrickPosition(int index) const {
+    glm::ivec3 brick(index % _numBricks.x, (index / _numBricks.x) % _numBricks.y, index / (_numBricks.x * _numBricks.y));
+    return brick * BRICK_SIZE;
+}
+
+glm::ivec3 PolyVoxBricks::getBrickSize(int index) const {
+    return glm::min(glm::ivec3(BRICK_SIZE), _voxelVolumeSize - getBrickPosition(index));
+}
+
+int PolyVoxBricks::getBrickIndex(const glm::ivec3& voxel) const {
+    glm::ivec3 brick = voxel / BRICK_SIZE;
+    return (brick.z * _numBricks.y + brick.y) * _numBricks.x + brick.x;
+}
+
+void PolyVoxBricks::setBrick(int index, const Brick& brick) {
+    if (_bricks[index] != brick) {
+        _bricks[index] = brick;
+        _dirty[index] = true;
+    }
+}
+
+quint32 PolyVoxBricks::getLatestVersion() const {
+    return _versions.empty() ? 0 : *std::max_element(_versions.begin(), _versions.end());
+}
+
+QByteArray PolyVoxBricks::getVoxels(int index) const {
+    glm::ivec3 size = getBrickSize(index);
+    return _bricks[index].decode(size.x * size.y * size.z);
+}
+
+int PolyVoxBricks::getNumDirty() const {
+    return (int)std::count(_dirty.begin(), _dirty.end(), true);
+}
+
+void PolyVoxBricks::setAllDirty() {
+    std::fill(_dirty.begin(), _dirty.end(), true);
+}
+
+void PolyVoxBricks::clearDirty() {
+    std::fill(_dirty.begin(), _dirty.end(), false);
+}
+
+std::vector<PolyVoxBricks::Entry> PolyVoxBricks::makeEntries(const std::vector<int>& indices) const {
+    std::vector<Entry> entries;
+    for (int index : indices) {
+        const Brick& brick = _bricks[index];
+        if (!entries.empty()) {
+            // runs of uniform bricks, which is most of a sparse volume, go in one entry
+            Entry& last = entries.back();
+            if (brick.compressed.isEmpty() && last.first + last.count == index && last.brick == brick &&
+                last.version == _versions[index]) {
+                last.count++;
+                continue;
+            }
+        }
+        entries.push_back({ index, 1, brick, _versions[index] });
+    }
+    return entries;
+}
+
+QByteArray PolyVoxBricks::writeEntries(const std::vector<Entry>& entries, size_t begin, size_t end, bool patch) const {
+    QByteArray voxelData;
+    QDataStream writer(&voxelData, QIODevice::WriteOnly | QIODevice::Truncate);
+    writer << BRICKED_FORMAT_MARKER << BRICKED_FORMAT_VERSION << (patch ? PATCH_FLAG : (quint8)0);
+    writer << (quint16)_voxelVolumeSize.x << (quint16)_voxelVolumeSize.y << (quint16)_voxelVolumeSize.z;
+    writer << (quint8)BRICK_SIZE;
+
+    for (size_t i = begin; i < end; i++) {
+        const Entry& entry = entries[i];
+        if (entry.brick.compressed.isEmpty()) {
+            writer << (quint16)entry.first << (quint16)entry.count << (quint8)UNIFORM_BRICKS << entry.version
+                   << (quint8)entry.brick.value;
+        } else {
+            writer << (quint16)entry.first << (quint16)1 << (quint8)COMPRESSED_BRICK << entry.version
+                   << (quint16)entry.brick.compressed.size();
+            writer.writeRawData(entry.brick.compressed.constData(), entry.brick.compressed.size());
+        }
+    }
+    return voxelData;
+}
+
+bool PolyVoxBricks::readEntries(const QByteArray& voxelData, bool& patch, glm::ivec3& voxelVolumeSize,
+                                std::vector<Entry>& entries) {
+    if (voxelData.size() < (int)sizeof(quint16) || voxelData[0] != 0 || voxelData[1] != 0) {
+        // the whole volume, which has no versions
+        PolyVoxBricks bricks;
+        if (!bricks.readLegacy(voxelData)) {
+            return false;
+        }
+        patch = false;
+        voxelVolumeSize = bricks.getVoxelVolumeSize();
+        std::vector<int> indices(bricks.getNumBricksTotal());
+        std::iota(indices.begin(), indices.end(), 0);
+        entries = bricks.makeEntries(indices);
+        return true;
+    }
+
+    QDataStream reader(voxelData);
+    quint16 marker;
+    quint8 version, flags;
+    quint16 voxelXSize, voxelYSize, voxelZSize;
+    quint8 brickSize;
+    reader >> marker >> version >> flags >> voxelXSize >> voxelYSize >> voxelZSize >> brickSize;
+
+    if (reader.status() != QDataStream::Ok || marker != BRICKED_FORMAT_MARKER ||
+        (version != BRICKED_FORMAT_VERSION && version != UNVERSIONED_FORMAT_VERSION) || brickSize != BRICK_SIZE ||
+        !isValidVolumeSize(voxelXSize, voxelYSize, voxelZSize)) {
+        return false;
+    }
+
+    patch = (flags & PATCH_FLAG) != 0;
+    voxelVolumeSize = glm::ivec3(voxelXSize, voxelYSize, voxelZSize);
+    glm::ivec3 numBricks = (voxelVolumeSize + BRICK_SIZE - 1) / BRICK_SIZE;
+    int numBricksTotal = numBricks.x * numBricks.y * numBricks.z;
+
+    entries.clear();
+    while (!reader.atEnd()) {
+        Entry entry;
+        quint16 first, count;
+        quint8 type;
+        reader >> first >> count >> type;
+        entry.version = 0;
+        if (version == BRICKED_FORMAT_VERSION) {
+            reader >> entry.version;
+        }
+        if (reader.status() != QDataStream::Ok || count == 0 || first + count > numBricksTotal) {
+            return false;
+        }
+        entry.first = first;
+        entry.count = count;
+
+        if (type == UNIFORM_BRICKS) {
+            reader >> entry.brick.value;
+        } else if (type == COMPRESSED_BRICK && count == 1) {
+            quint16 length;
+            reader >> length;
+            entry.brick.compressed.resize(length);
+            if (reader.readRawData(entry.brick.compressed.data(), length) != length) {
+                return false;
+            }
+        } else {
+            return false;
+        }
+        if (reader.status() != QDataStream::Ok) {
+            return false;
+        }
+        entries.push_back(entry);
+    }
+    return true;
+}
+
+bool PolyVoxBricks::readLegacy(const QByteArray& voxelData) {
+    QDataStream reader(voxelData);
+    quint16 voxelXSize, voxelYSize, voxelZSize;
+    reader >> voxelXSize >> voxelYSize >> voxelZSize;
+    if (reader.status() != QDataStream::Ok || !isValidVolumeSize(voxelXSize, voxelYSize, voxelZSize)) {
+        return false;
+    }
+
+    QByteArray compressedData;
+    reader >> compressedData;
+    QByteArray voxels = qUncompress(compressedData);
+    if (voxels.size() != voxelXSize * voxelYSize * voxelZSize) {
+        return false;
+    }
+
+    // the whole volume is x first, then y, then z, so copy it out a row at a time
+    *this = PolyVoxBricks(glm::ivec3(voxelXSize, voxelYSize, voxelZSize));
+    for (int i = 0; i < getNumBricksTotal(); i++) {
+        glm::ivec3 position = getBrickPosition(i);
+        glm::ivec3 size = getBrickSize(i);
+        QByteArray brickVoxels(size.x * size.y * size.z, '\0');
+        char* brickRow = brickVoxels.data();
+        for (int z = position.z; z < position.z + size.z; z++) {
+            for (int y = position.y; y < position.y + size.y; y++) {
+                memcpy(brickRow, voxels.constData() + (z * voxelYSize + y) * voxelXSize + position.x, size.x);
+                brickRow += size.x;
+            }
+        }
+        setVoxels(i, brickVoxels);
+    }
+    clearDirty();
+    return true;
+}
@@ -0,0 +1,136 @@
+//
+//  PolyVoxBricks.h
+//  libraries/entities/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PolyVoxBricks_h
+#define hifi_PolyVoxBricks_h
+
+#include <vector>
+
+#include <QByteArray>
+
+#include <glm/glm.hpp>
+
+// The voxels of a PolyVox entity, cut into bricks of BRICK_SIZE^3 that are compressed on their own.  An edit only has
+// to recompress the bricks it touched, and only those bricks go to the entity-server, as a patch.
+//
+// This is the format of the voxelData property.  The older formats, the dimensions followed by the whole volume
+// compressed in one blob, and bricks without versions, are still read.
+//
+// Each brick has the version the entity-server gave it when an edit last changed it.  The entity-server sends each
+// receiver the bricks in the order of their versions, as many as fit in a packet at a time, so it only ever sends what
+// changed since the receiver last heard, and the size of the volume is only limited by how big a single brick can
+// compress to.  A client knows the entity-server has an edit it sent once the bricks come back with a newer version.
+class PolyVoxBricks {
+public:
+    static const int BRICK_SIZE = 16;
+
+    // the most voxelData an edit or an entity-server packet carries at once
+    static const int MAX_PATCH_SIZE = 1150;
+
+    // a brick is either all one value, or compressed
+    class Brick {
+    public:
+        static Brick encode(const QByteArray& voxels);
+        QByteArray decode(int numVoxels) const;
+
+        bool operator==(const Brick& other) const { return value == other.value && compressed == other.compressed; }
+        bool operator!=(const Brick& other) const { return !(*this == other); }
+
+        QByteArray compressed; // empty if the brick is uniform
+        uint8_t value { 0 };
+    };
+
+    PolyVoxBricks() {}
+    PolyVoxBricks(const glm::ivec3& voxelVolumeSize);
+
+    // reads the voxelData property, in any format.  false if it isn't valid, or is a patch
+    bool read(const QByteArray& voxelData);
+
+    // voxelData from the entity-server, which may be a patch.  The bricks take the versions it has, unless they are
+    // older than the ones we have.  false if it isn't valid
+    bool merge(const QByteArray& voxelData);
+
+    // an edit of the voxelData property, which may be a patch.  The bricks it changes, or all of them if it resizes the
+    // volume, get a version newer than any we or the edit have.  false if it isn't valid
+    bool applyEdit(const QByteArray& voxelData);
+
+    // empties the volume, and leaves every brick at the latest version
+    void resize(const glm::ivec3& voxelVolumeSize);
+
+    // the voxelData property, with every brick
+    QByteArray write() const;
+
+    // a voxelData patch with just the dirty bricks
+    QByteArray writePatch() const;
+
+    // voxelData patches with the given bricks, each no bigger than maxSize.  A brick that doesn't fit in a patch on its
+    // own is left out
+    std::vector<QByteArray> writePatches(const std::vector<int>& indices, int maxSize) const;
+
+    // A voxelData patch, no bigger than maxSize, with the bricks that come after the cursor in the order of their
+    // versions, and moves the cursor on past them.  A cursor of 0 is before every brick.  Empty if the next brick
+    // doesn't fit.
+    QByteArray writePatchAfter(quint64& cursor, int maxSize) const;
+    bool hasBricksAfter(quint64 cursor) const;
+
+    static bool isPatch(const QByteArray& voxelData);
+
+    bool isValid() const { return !_bricks.empty(); }
+    const glm::ivec3& getVoxelVolumeSize() const { return _voxelVolumeSize; }
+    const glm::ivec3& getNumBricks() const { return _numBricks; }
+    int getNumBricksTotal() const { return (int)_bricks.size(); }
+
+    // in voxels.  bricks at the high edges of the volume are cut short
+    glm::ivec3 getBrickPosition(int index) const;
+    glm::ivec3 getBrickSize(int index) const;
+    int getBrickIndex(const glm::ivec3& voxel) const;
+
+    // setting a brick leaves its version as it is
+    const Brick& getBrick(int index) const { return _bricks[index]; }
+    void setBrick(int index, const Brick& brick);
+
+    quint32 getVersion(int index) const { return _versions[index]; }
+    quint32 getLatestVersion() const;
+
+    // the voxels of a brick, x first, then y, then z
+    QByteArray getVoxels(int index) const;
+    void setVoxels(int index, const QByteArray& voxels) { setBrick(index, Brick::encode(voxels)); }
+
+    bool isDirty(int index) const { return _dirty[index]; }
+    int getNumDirty() const;
+    void setAllDirty();
+    void clearDirty();
+
+private:
+    // the bricks from first to first + count - 1, which are all the same
+    struct Entry {
+        int first;
+        int count;
+        Brick brick;
+        quint32 version;
+    };
+
+    static bool readEntries(const QByteArray& voxelData, bool& patch, glm::ivec3& voxelVolumeSize,
+                            std::vector<Entry>& entries);
+    bool readLegacy(const QByteArray& voxelData);
+
+    std::vector<Entry> makeEntries(const std::vector<int>& indices) const;
+    QByteArray writeEntries(const std::vector<Entry>& entries, size_t begin, size_t end, bool patch) const;
+    quint64 getSendKey(int index) const { return ((quint64)_versions[index] << 32) | (quint64)(index + 1); }
+
+    glm::ivec3 _voxelVolumeSize { 0 };
+    glm::ivec3 _numBricks { 0 };
+    std::vector<Brick> _bricks;
+    std::vector<quint32> _versions;
+    std::vector<bool> _dirty;
+};
+
+#endif // hifi_PolyVoxBricks_h
@@ -11,6 +11,8 @@
 
 #include "PolyVoxEntityItem.h"
 
+#include <algorithm>
+
 #include <glm/gtx/transform.hpp>
 
 #include <QByteArray>
@@ -68,6 +70,7 @@ QByteArray PolyVoxEntityItem::makeEmptyVoxelData(quint16 voxelXSize, quint16 vox
 
 PolyVoxEntityItem::PolyVoxEntityItem(const EntityItemID& entityItemID) : EntityItem(entityItemID) {
     _type = EntityTypes::PolyVox;
+    _voxelBricks.read(DEFAULT_VOXEL_DATA);
 }
 
 void PolyVoxEntityItem::setVoxelVolumeSize(const glm::vec3& voxelVolumeSize_) {
@@ -134,7 +137,13 @@ int PolyVoxEntityItem::readEntitySubclassDataFromBuffer(const unsigned char* dat
     const unsigned char* dataAt = data;
 
     READ_ENTITY_PROPERTY(PROP_VOXEL_VOLUME_SIZE, glm::vec3, setVoxelVolumeSize);
-    READ_ENTITY_PROPERTY(PROP_VOXEL_DATA, QByteArray, setVoxelData);
+    {
+        // the bricks have versions, so what the entity-server sends is merged in even if we've edited since
+        bool oldOverwrite = overwriteLocalData;
+        overwriteLocalData = true;
+        READ_ENTITY_PROPERTY(PROP_VOXEL_DATA, QByteArray, readVoxelData);
+        overwriteLocalData = oldOverwrite;
+    }
     READ_ENTITY_PROPERTY(PROP_VOXEL_SURFACE_STYLE, uint16_t, setVoxelSurfaceStyle);
     READ_ENTITY_PROPERTY(PROP_X_TEXTURE_URL, QString, setXTextureURL);
     READ_ENTITY_PROPERTY(PROP_Y_TEXTURE_URL, QString, setYTextureURL);
@@ -176,7 +185,12 @@ void PolyVoxEntityItem::appendSubclassData(OctreePacketData* packetData, EncodeB
     bool successPropertyFits = true;
 
     APPEND_ENTITY_PROPERTY(PROP_VOXEL_VOLUME_SIZE, getVoxelVolumeSize());
-    APPEND_ENTITY_PROPERTY(PROP_VOXEL_DATA, getVoxelData());
+    if (modelTreeElementExtraEncodeData) {
+        appendVoxelDataPatch(packetData, modelTreeElementExtraEncodeData, requestedProperties, propertyFlags,
+                             propertiesDidntFit, propertyCount, appendState);
+    } else {
+        APPEND_ENTITY_PROPERTY(PROP_VOXEL_DATA, getVoxelData());
+    }
     APPEND_ENTITY_PROPERTY(PROP_VOXEL_SURFACE_STYLE, (uint16_t) getVoxelSurfaceStyle());
     APPEND_ENTITY_PROPERTY(PROP_X_TEXTURE_URL, getXTextureURL());
     APPEND_ENTITY_PROPERTY(PROP_Y_TEXTURE_URL, getYTextureURL());
@@ -197,19 +211,89 @@ void PolyVoxEntityItem::debugDump() const {
     qCDebug(entities) << "       getLastEdited:" << debugTime(getLastEdited(), now);
 }
 
+void PolyVoxEntityItem::appendVoxelDataPatch(OctreePacketData* packetData,
+                                             EntityTreeElementExtraEncodeDataPointer extraEncodeData,
+                                             EntityPropertyFlags& requestedProperties,
+                                             EntityPropertyFlags& propertyFlags,
+                                             EntityPropertyFlags& propertiesDidntFit,
+                                             int& propertyCount,
+                                             OctreeElement::AppendState& appendState) const {
+    // the entity-server sends each receiver the bricks that changed since it last sent them, a packet's worth at a time
+    if (!requestedProperties.getHasProperty(PROP_VOXEL_DATA)) {
+        propertiesDidntFit -= PROP_VOXEL_DATA;
+        return;
+    }
+
+    quint64& sentCursor = extraEncodeData->voxelBricksSent[this];
+    quint64 cursor = sentCursor;
+    QByteArray patch;
+    bool moreBricks = false;
+    withReadLock([&] {
+        // the property is written with its length ahead of it
+        int maxSize = packetData->getBytesAvailable() - (int)sizeof(uint16_t);
+        patch = _voxelBricks.writePatchAfter(cursor, std::min(maxSize, (int)PolyVoxBricks::MAX_PATCH_SIZE));
+        moreBricks = _voxelBricks.hasBricksAfter(cursor);
+    });
+
+    if (patch.isEmpty()) {
+        // bricks too big to send at all are passed over, and the rest wait for the next packet
+        sentCursor = cursor;
+        if (moreBricks) {
+            appendState = OctreeElement::PARTIAL;
+        } else {
+            propertiesDidntFit -= PROP_VOXEL_DATA;
+        }
+        return;
+    }
+
+    LevelDetails propertyLevel = packetData->startLevel();
+    if (!packetData->appendValue(patch)) {
+        packetData->discardLevel(propertyLevel);
+        appendState = OctreeElement::PARTIAL;
+        return;
+    }
+    packetData->endLevel(propertyLevel);
+    sentCursor = cursor;
+    propertyFlags |= PROP_VOXEL_DATA;
+    propertyCount++;
+    if (moreBricks) {
+        // the rest go in the next packets
+        appendState = OctreeElement::PARTIAL;
+    } else {
+        propertiesDidntFit -= PROP_VOXEL_DATA;
+    }
+}
+
 void PolyVoxEntityItem::setVoxelData(const QByteArray& voxelData) {
+    bool valid = true;
     withWriteLock([&] {
-        _voxelData = voxelData;
-        _voxelDataDirty = true;
+        _voxelBricks.clearDirty();
+        valid = _voxelBricks.applyEdit(voxelData);
+        _voxelDataDirty |= _voxelBricks.getNumDirty() > 0;
     });
+    if (!valid) {
+        qCDebug(entities) << "PolyVox voxel data edit is not reasonable, ignoring it" << getName() << getID();
+    }
+}
+
+void PolyVoxEntityItem::readVoxelData(const QByteArray& voxelData) {
+    bool valid = true;
+    withWriteLock([&] {
+        _voxelBricks.clearDirty();
+        valid = _voxelBricks.merge(voxelData);
+        _voxelDataDirty |= _voxelBricks.getNumDirty() > 0;
+    });
+    if (!valid) {
+        qCDebug(entities) << "PolyVox voxel data is not reasonable, ignoring it" << getName() << getID();
+    }
 }
 
 QByteArray PolyVoxEntityItem::getVoxelData() const {
-    QByteArray voxelDataCopy;
+    QByteArray voxelData;
     withReadLock([&] {
-        voxelDataCopy = _voxelData;
+        voxelData = _voxelBricks.write();
     });
-    return voxelDataCopy;
+    return voxelData;
 }
 
 
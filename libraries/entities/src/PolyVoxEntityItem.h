@@ -13,6 +13,7 @@
 #define hifi_PolyVoxEntityItem_h
 
 #include "EntityItem.h"
+#include "PolyVoxBricks.h"
 
 class PolyVoxEntityItem : public EntityItem {
  public:
@@ -57,8 +58,11 @@ class PolyVoxEntityItem : public EntityItem {
     virtual void setVoxelVolumeSize(const glm::vec3& voxelVolumeSize);
     virtual glm::vec3 getVoxelVolumeSize() const;
 
+    // an edit, which may be a patch of just some bricks
     virtual void setVoxelData(const QByteArray& voxelData);
     virtual QByteArray getVoxelData() const;
+    // voxel data from the entity-server, which may be a patch of just some bricks
+    virtual void readVoxelData(const QByteArray& voxelData);
 
     virtual int getOnCount() const { return 0; }
 
@@ -175,10 +179,15 @@ class PolyVoxEntityItem : public EntityItem {
  protected:
     void setVoxelDataDirty(bool value) { withWriteLock([&] { _voxelDataDirty = value; }); }
 
+    void appendVoxelDataPatch(OctreePacketData* packetData, EntityTreeElementExtraEncodeDataPointer extraEncodeData,
+                              EntityPropertyFlags& requestedProperties, EntityPropertyFlags& propertyFlags,
+                              EntityPropertyFlags& propertiesDidntFit, int& propertyCount,
+                              OctreeElement::AppendState& appendState) const;
+
     glm::vec3 _voxelVolumeSize { DEFAULT_VOXEL_VOLUME_SIZE }; // this is always 3 bytes
 
-    QByteArray _voxelData { DEFAULT_VOXEL_DATA };
-    bool _voxelDataDirty { true }; // _voxelData has changed, things that depend on it should be updated
+    PolyVoxBricks _voxelBricks; // the voxelData property
+    bool _voxelDataDirty { true }; // _voxelBricks has changed, things that depend on it should be updated
 
     PolyVoxSurfaceStyle _voxelSurfaceStyle { DEFAULT_VOXEL_SURFACE_STYLE };
 
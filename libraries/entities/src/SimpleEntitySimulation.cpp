@@ -144,16 +144,6 @@ void SimpleEntitySimulation::clearEntities() {
     EntitySimulation::clearEntities();
 }
 
-void SimpleEntitySimulation::sortEntitiesThatMoved() {
-    SetOfEntities::iterator itemItr = _entitiesToSort.begin();
-    while (itemItr != _entitiesToSort.end()) {
-        EntityItemPointer entity = *itemItr;
-        entity->updateQueryAACube();
-        ++itemItr;
-    }
-    EntitySimulation::sortEntitiesThatMoved();
-}
-
 void SimpleEntitySimulation::expireStaleOwnerships(uint64_t now) {
     if (now > _nextStaleOwnershipExpiry) {
         _nextStaleOwnershipExpiry = (uint64_t)(-1);
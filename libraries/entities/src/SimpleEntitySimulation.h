@@ -34,8 +34,6 @@ protected:
     void removeEntityFromInternalLists(EntityItemPointer entity) override;
     void processChangedEntity(const EntityItemPointer& entity) override;
 
-    void sortEntitiesThatMoved() override;
-
     void expireStaleOwnerships(uint64_t now);
     void stopOwnerlessEntities(uint64_t now);
 
@@ -18,6 +18,7 @@
 #include <glm/gtx/transform.hpp>
 
 #include <BlendshapeConstants.h>
+#include <TBBHelpers.h>
 
 #include <hfm/ModelFormatLogging.h>
 #include <hfm/HFMModelMath.h>
@@ -203,6 +204,15 @@ public:
     HFMBlendshape blendshape;
 };
 
+// a mesh found while walking the objects, extracted along with the others once the walk is done
+class PendingMesh {
+public:
+    QString id;
+    const FBXNode* object;
+    unsigned int meshIndex;
+    QVector<ExtractedBlendshape> blendshapes; // the shapes of the model the mesh is part of, if any
+};
+
 void printNode(const FBXNode& node, int indentLevel) {
     int indentLength = 2;
     hifi::ByteArray spaces(indentLevel * indentLength, ' ');
@@ -419,6 +429,9 @@ HFMModel* FBXSerializer::extractHFMModel(const hifi::VariantHash& mapping, const
 
     QVector<ExtractedBlendshape> blendshapes;
 
+    std::vector<PendingMesh> pendingMeshes;
+    std::vector<const FBXNode*> blendshapeObjects;
+
     QHash<QString, FBXModel> fbxModels;
     QHash<QString, Cluster> fbxClusters; 
     QHash<QString, AnimationCurve> animationCurves;
@@ -529,10 +542,11 @@ HFMModel* FBXSerializer::extractHFMModel(const hifi::VariantHash& mapping, const
             foreach (const FBXNode& object, child.children) {
                 if (object.name == "Geometry") {
                     if (object.properties.at(2) == "Mesh") {
-                        meshes.insert(getID(object.properties), extractMesh(object, meshIndex, deduplicateIndices));
+                        pendingMeshes.push_back({ getID(object.properties), &object, meshIndex++, {} });
                     } else { // object.properties.at(2) == "Shape"
-                        ExtractedBlendshape blendshape = { getID(object.properties), extractBlendshape(object) };
+                        ExtractedBlendshape blendshape = { getID(object.properties), HFMBlendshape() };
                         blendshapes.append(blendshape);
+                        blendshapeObjects.push_back(&object);
                     }
                 } else if (object.name == "Model") {
                     QString name = getModelName(object.properties);
@@ -566,7 +580,7 @@ HFMModel* FBXSerializer::extractHFMModel(const hifi::VariantHash& mapping, const
                     FBXModel fbxModel = { name, -1, glm::vec3(), glm::mat4(), glm::quat(), glm::quat(), glm::quat(),
                                           glm::mat4(), glm::vec3(), glm::vec3(),
                                           false, glm::vec3(), glm::quat(), glm::vec3(1.0f), isLimbNode };
-                    ExtractedMesh* mesh = NULL;
+                    int pendingMesh = -1;
                     QVector<ExtractedBlendshape> blendshapes;
                     foreach (const FBXNode& subobject, object.children) {
                         bool properties = false;
@@ -675,8 +689,8 @@ HFMModel* FBXSerializer::extractHFMModel(const hifi::VariantHash& mapping, const
                             }
                         } else if (subobject.name == "Vertices" || subobject.name == "DracoMesh") {
                             // it's a mesh as well as a model
-                            mesh = &meshes[getID(object.properties)];
-                            *mesh = extractMesh(object, meshIndex, deduplicateIndices);
+                            pendingMesh = (int)pendingMeshes.size();
+                            pendingMeshes.push_back({ getID(object.properties), &object, meshIndex++, {} });
 
                         } else if (subobject.name == "Shape") {
                             ExtractedBlendshape blendshape =  { subobject.properties.at(0).toString(),
@@ -704,11 +718,9 @@ HFMModel* FBXSerializer::extractHFMModel(const hifi::VariantHash& mapping, const
 #endif
                     }
 
-                    // add the blendshapes included in the model, if any
-                    if (mesh) {
-                        foreach (const ExtractedBlendshape& blendshape, blendshapes) {
-                            addBlendshapes(blendshape, blendshapeIndices.values(blendshape.id.toLatin1()), *mesh);
-                        }
+                    // the blendshapes included in the model, if any, are added once its mesh is extracted
+                    if (pendingMesh != -1) {
+                        pendingMeshes[pendingMesh].blendshapes = std::move(blendshapes);
                     }
 
                     // see FBX documentation, http://download.autodesk.com/us/fbx/20112/FBX_SDK_HELP/index.html
@@ -1221,6 +1233,29 @@ HFMModel* FBXSerializer::extractHFMModel(const hifi::VariantHash& mapping, const
 #endif
     }
 
+    // extract the meshes and blendshapes in parallel, each only reads its own node
+    std::vector<ExtractedMesh> extractedMeshes(pendingMeshes.size());
+    ExtractedBlendshape* extractedBlendshapes = blendshapes.data();
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, pendingMeshes.size() + blendshapeObjects.size()),
+                      [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i != range.end(); ++i) {
+            if (i < pendingMeshes.size()) {
+                unsigned int pendingMeshIndex = pendingMeshes[i].meshIndex;
+                extractedMeshes[i] = extractMesh(*pendingMeshes[i].object, pendingMeshIndex, deduplicateIndices);
+            } else {
+                size_t blendshapeIndex = i - pendingMeshes.size();
+                extractedBlendshapes[blendshapeIndex].blendshape = extractBlendshape(*blendshapeObjects[blendshapeIndex]);
+            }
+        }
+    });
+    for (size_t i = 0; i < pendingMeshes.size(); ++i) {
+        ExtractedMesh& mesh = meshes[pendingMeshes[i].id];
+        mesh = std::move(extractedMeshes[i]);
+        foreach (const ExtractedBlendshape& blendshape, pendingMeshes[i].blendshapes) {
+            addBlendshapes(blendshape, blendshapeIndices.values(blendshape.id.toLatin1()), mesh);
+        }
+    }
+
     // TODO: check if is code is needed
     if (!lights.empty()) {
         if (hifiGlobalNodeID.isEmpty()) {
@@ -1456,14 +1491,15 @@ HFMModel* FBXSerializer::extractHFMModel(const hifi::VariantHash& mapping, const
     // see if any materials have texture children
     bool materialsHaveTextures = checkMaterialsHaveTextures(_hfmMaterials, _textureFilenames, _connectionChildMap);
 
+    hfmModel.meshes.reserve(meshes.size());
     for (QMap<QString, ExtractedMesh>::iterator it = meshes.begin(); it != meshes.end(); it++) {
         const QString& meshID = it.key();
-        const ExtractedMesh& extracted = it.value();
+        ExtractedMesh& extracted = it.value();
         const auto& partMaterialTextures = extracted.partMaterialTextures;
 
         uint32_t meshIndex = (uint32_t)hfmModel.meshes.size();
         meshIDsToMeshIndices.insert(meshID, meshIndex);
-        hfmModel.meshes.push_back(extracted.mesh);
+        hfmModel.meshes.push_back(std::move(extracted.mesh));
         hfm::Mesh& mesh = hfmModel.meshes.back();
 
         std::vector<QString> instanceModelIDs = getModelIDsForMeshID(meshID, fbxModels, _connectionParentMap);
@@ -410,6 +410,7 @@ glm::vec3 FBXSerializer::getVec3(const QVariantList& properties, int index) {
 
 QVector<glm::vec4> FBXSerializer::createVec4Vector(const QVector<double>& doubleVector) {
     QVector<glm::vec4> values;
+    values.reserve(doubleVector.size() / 4);
     for (const double* it = doubleVector.constData(), *end = it + ((doubleVector.size() / 4) * 4); it != end; ) {
         float x = *it++;
         float y = *it++;
@@ -423,6 +424,7 @@ QVector<glm::vec4> FBXSerializer::createVec4Vector(const QVector<double>& double
 
 QVector<glm::vec4> FBXSerializer::createVec4VectorRGBA(const QVector<double>& doubleVector, glm::vec4& average) {
     QVector<glm::vec4> values;
+    values.reserve(doubleVector.size() / 4);
     for (const double* it = doubleVector.constData(), *end = it + ((doubleVector.size() / 4) * 4); it != end; ) {
         float x = *it++;
         float y = *it++;
@@ -440,6 +442,7 @@ QVector<glm::vec4> FBXSerializer::createVec4VectorRGBA(const QVector<double>& do
 
 QVector<glm::vec3> FBXSerializer::createVec3Vector(const QVector<double>& doubleVector) {
     QVector<glm::vec3> values;
+    values.reserve(doubleVector.size() / 3);
     for (const double* it = doubleVector.constData(), *end = it + ((doubleVector.size() / 3) * 3); it != end; ) {
         float x = *it++;
         float y = *it++;
@@ -451,6 +454,7 @@ QVector<glm::vec3> FBXSerializer::createVec3Vector(const QVector<double>& double
 
 QVector<glm::vec2> FBXSerializer::createVec2Vector(const QVector<double>& doubleVector) {
     QVector<glm::vec2> values;
+    values.reserve(doubleVector.size() / 2);
     for (const double* it = doubleVector.constData(), *end = it + ((doubleVector.size() / 2) * 2); it != end; ) {
         float s = *it++;
         float t = *it++;
@@ -479,6 +483,7 @@ QVector<int> FBXSerializer::getIntVector(const FBXNode& node) {
     if (!vector.isEmpty()) {
         return vector;
     }
+    vector.reserve(node.properties.size());
     for (int i = 0; i < node.properties.size(); i++) {
         vector.append(node.properties.at(i).toInt());
     }
@@ -498,6 +503,7 @@ QVector<float> FBXSerializer::getFloatVector(const FBXNode& node) {
     if (!vector.isEmpty()) {
         return vector;
     }
+    vector.reserve(node.properties.size());
     for (int i = 0; i < node.properties.size(); i++) {
         vector.append(node.properties.at(i).toFloat());
     }
@@ -517,6 +523,7 @@ QVector<double> FBXSerializer::getDoubleVector(const FBXNode& node) {
     if (!vector.isEmpty()) {
         return vector;
     }
+    vector.reserve(node.properties.size());
     for (int i = 0; i < node.properties.size(); i++) {
         vector.append(node.properties.at(i).toDouble());
     }
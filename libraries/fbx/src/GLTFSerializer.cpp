@@ -14,6 +14,7 @@
 #include <QtCore/QBuffer>
 #include <QtCore/QIODevice>
 #include <QtCore/QEventLoop>
+#include <QtCore/QtEndian>
 #include <QtCore/qjsondocument.h>
 #include <QtCore/qjsonobject.h>
 #include <QtCore/qjsonarray.h>
@@ -1830,12 +1831,6 @@ void GLTFSerializer::setHFMMaterial(HFMMaterial& hfmMat, const GLTFMaterial& mat
 
 template <typename T, typename L>
 bool GLTFSerializer::readArray(const hifi::ByteArray& bin, int byteOffset, int count, QVector<L>& outarray, int accessorType) {
-    QDataStream blobstream(bin);
-    blobstream.setByteOrder(QDataStream::LittleEndian);
-    blobstream.setVersion(QDataStream::Qt_5_9);
-    blobstream.setFloatingPointPrecision(QDataStream::FloatingPointPrecision::SinglePrecision);
-    blobstream.skipRawData(byteOffset);
-
     int bufferCount = 0;
     switch (accessorType) {
         case GLTFAccessorType::SCALAR:
@@ -1861,23 +1856,19 @@ bool GLTFSerializer::readArray(const hifi::ByteArray& bin, int byteOffset, int c
             break;
         default:
             qWarning(modelformat) << "Unknown accessorType: " << accessorType;
-            blobstream.setDevice(nullptr);
             return false;
     }
-    for (int i = 0; i < count; ++i) {
-        for (int j = 0; j < bufferCount; ++j) {
-            if (!blobstream.atEnd()) {
-                T value;
-                blobstream >> value;
-                outarray.push_back(value);
-            } else {
-                blobstream.setDevice(nullptr);
-                return false;
-            }
-        }
-    }
 
-    blobstream.setDevice(nullptr);
+    // all of the values have to be in the buffer, so they can be decoded straight out of it
+    qint64 numValues = (qint64)count * bufferCount;
+    if (byteOffset < 0 || numValues < 0 || byteOffset + numValues * (qint64)sizeof(T) > bin.size()) {
+        return false;
+    }
+    outarray.reserve(outarray.size() + (int)numValues);
+    const char* values = bin.constData() + byteOffset;
+    for (int i = 0; i < (int)numValues; ++i) {
+        outarray.push_back(qFromLittleEndian<T>(values + i * sizeof(T)));
+    }
     return true;
 }
 template <typename T>
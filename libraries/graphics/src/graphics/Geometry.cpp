@@ -26,7 +26,8 @@ Mesh::Mesh(const Mesh& mesh) :
     _vertexBuffer(mesh._vertexBuffer),
     _attributeBuffers(mesh._attributeBuffers),
     _indexBuffer(mesh._indexBuffer),
-    _partBuffer(mesh._partBuffer) {
+    _partBuffer(mesh._partBuffer),
+    _lods(mesh._lods) {
 }
 
 Mesh::~Mesh() {
@@ -148,6 +149,14 @@ Box Mesh::evalPartsBound(int partStart, int partEnd) const {
     return totalBound;
 }
 
+int Mesh::evalLOD(float maxError) const {
+    int lod = 0;
+    while (lod < (int)_lods.size() && _lods[lod].error <= maxError) {
+        lod++;
+    }
+    return lod;
+}
+
 
 graphics::MeshPointer Mesh::map(std::function<glm::vec3(glm::vec3)> vertexFunc,
                              std::function<glm::vec3(glm::vec3)> colorFunc,
@@ -123,6 +123,21 @@ public:
     // the returned box is the bounding box of ALL the evaluated parts bound.
     Box evalPartsBound(int partStart, int partEnd) const;
 
+    // A coarser version of the parts, indexing the same vertices from further along the index buffer
+    class LOD {
+    public:
+        std::vector<Part> parts;
+        float error { 0.0f }; // an estimate of how far the LOD strays from the parts, in the mesh's units
+    };
+
+    // The LODs go from finer to coarser
+    void setLODs(const std::vector<LOD>& lods) { _lods = lods; }
+    const std::vector<LOD>& getLODs() const { return _lods; }
+    size_t getNumLODs() const { return _lods.size(); }
+
+    // evaluate the coarsest LOD that strays no further than maxError from the parts, where 0 is the parts themselves
+    int evalLOD(float maxError) const;
+
     static gpu::Primitive topologyToPrimitive(Topology topo) { return static_cast<gpu::Primitive>(topo); }
 
     // create a copy of this mesh after passing its vertices, normals, and indexes though the provided functions
@@ -154,6 +169,8 @@ protected:
 
     BufferView _partBuffer;
 
+    std::vector<LOD> _lods;
+
     void evalVertexFormat();
     void evalVertexStream();
 
@@ -239,6 +239,14 @@ struct TriangleListMesh {
     std::vector<Extents> partExtents; // Extents of each part with no transform applied. Same length as parts.
 };
 
+/// A coarser version of a mesh's parts, drawn from the same vertices.  Only kept while baking, the graphics mesh holds
+/// the indices after that.
+class MeshLOD {
+public:
+    std::vector<QVector<int>> partTriangleIndices; // the triangles of each of the mesh's parts
+    float error { 0.0f }; // how far the vertices that were simplified away lie from the surface, in the mesh's units
+};
+
 /// A single mesh (with optional blendshapes).
 class Mesh {
 public:
@@ -11,10 +11,14 @@
 
 #include "Baker.h"
 
+#include <algorithm>
+#include <iterator>
+
 #include "BakerTypes.h"
 #include "ModelMath.h"
 #include "CollectShapeVerticesTask.h"
 #include "BuildGraphicsMeshTask.h"
+#include "BuildMeshLODsTask.h"
 #include "CalculateMeshNormalsTask.h"
 #include "CalculateMeshTangentsTask.h"
 #include "CalculateBlendshapeNormalsTask.h"
@@ -35,16 +39,19 @@ namespace baker {
 
         void run(const BakeContextPointer& context, const Input& input, Output& output) {
             const auto& hfmModelIn = input;
-            output.edit0() = hfmModelIn->meshes;
+            // BuildModelTask gives the model its meshes back, so take them rather than copying them
+            auto& meshes = output.edit0();
+            meshes = std::move(hfmModelIn->meshes);
+            hfmModelIn->meshes.clear();
             output.edit1() = hfmModelIn->originalURL;
             output.edit2() = hfmModelIn->meshIndicesToModelNames;
             auto& blendshapesPerMesh = output.edit3();
-            blendshapesPerMesh.reserve(hfmModelIn->meshes.size());
-            for (size_t i = 0; i < hfmModelIn->meshes.size(); i++) {
+            blendshapesPerMesh.reserve(meshes.size());
+            for (size_t i = 0; i < meshes.size(); i++) {
                 blendshapesPerMesh.push_back(
                     std::vector<hfm::Blendshape>(
-                        hfmModelIn->meshes[i].blendshapes.begin(),
-                        hfmModelIn->meshes[i].blendshapes.end()
+                        meshes[i].blendshapes.begin(),
+                        meshes[i].blendshapes.end()
                     )    
                 );
             }
@@ -98,19 +105,27 @@ namespace baker {
                 const auto& tangentsPerBlendshape = safeGet(tangentsPerBlendshapePerMesh, i);
                 auto& blendshapesOut = blendshapesPerMeshOut[i];
                 for (int j = 0; j < (int)blendshapesOut.size(); j++) {
-                    const auto& normals = safeGet(normalsPerBlendshape, j);
-                    const auto& tangents = safeGet(tangentsPerBlendshape, j);
                     auto& blendshape = blendshapesOut[j];
-                    #if (QT_VERSION < QT_VERSION_CHECK(5, 14, 0))
-                    blendshape.normals = QVector<glm::vec3>::fromStdVector(normals);
-                    blendshape.tangents = QVector<glm::vec3>::fromStdVector(tangents);
-                    #else
-                    blendshape.normals = QVector<glm::vec3>(normals.begin(), normals.end());
-                    blendshape.tangents = QVector<glm::vec3>(tangents.begin(), tangents.end());
-                    #endif
+                    // Normals and tangents that came with the blendshape are already there. Calculated ones are sized for
+                    // the whole mesh, but only the first one per blendshape index is ever set or read, so only keep those.
+                    if (blendshape.normals.empty()) {
+                        blendshape.normals = toBlendshapeVector(safeGet(normalsPerBlendshape, j), blendshape.indices.size());
+                    }
+                    if (blendshape.tangents.empty()) {
+                        blendshape.tangents = toBlendshapeVector(safeGet(tangentsPerBlendshape, j), blendshape.indices.size());
+                    }
                 }
             }
         }
+
+    private:
+        static QVector<glm::vec3> toBlendshapeVector(const std::vector<glm::vec3>& values, int numIndices) {
+            int size = std::min((int)values.size(), numIndices);
+            QVector<glm::vec3> result;
+            result.reserve(size);
+            std::copy(values.begin(), values.begin() + size, std::back_inserter(result));
+            return result;
+        }
     };
 
     class BuildMeshesTask {
@@ -128,31 +143,31 @@ namespace baker {
             auto& tangentsPerMeshIn = input.get4();
             auto& blendshapesPerMeshIn = input.get5();
 
-            auto meshesOut = meshesIn;
+            auto& meshesOut = output;
+            meshesOut = meshesIn;
             for (int i = 0; i < numMeshes; i++) {
                 auto& meshOut = meshesOut[i];
                 meshOut.triangleListMesh = triangleListMeshesIn[i];
                 meshOut._mesh = safeGet(graphicsMeshesIn, i);
-                #if (QT_VERSION < QT_VERSION_CHECK(5, 14, 0))
-                meshOut.normals = QVector<glm::vec3>::fromStdVector(safeGet(normalsPerMeshIn, i));
-                meshOut.tangents = QVector<glm::vec3>::fromStdVector(safeGet(tangentsPerMeshIn, i));
-                meshOut.blendshapes = QVector<hfm::Blendshape>::fromStdVector(safeGet(blendshapesPerMeshIn, i));
-                #else
-                meshOut.normals = QVector<glm::vec3>(
-                    safeGet(normalsPerMeshIn, i).begin(),
-                    safeGet(normalsPerMeshIn, i).end()
-                );
-                meshOut.tangents = QVector<glm::vec3>(
-                    safeGet(tangentsPerMeshIn, i).begin(),
-                    safeGet(tangentsPerMeshIn, i).end()
-                );
-                meshOut.blendshapes = QVector<hfm::Blendshape>(
-                    safeGet(blendshapesPerMeshIn, i).begin(),
-                    safeGet(blendshapesPerMeshIn, i).end()
-                );
-                #endif
+                // Keep the normals and tangents the mesh came with, which the calculated ones are only a copy of
+                if (meshOut.normals.empty()) {
+                    meshOut.normals = toQVector(safeGet(normalsPerMeshIn, i));
+                }
+                if (meshOut.tangents.empty()) {
+                    meshOut.tangents = toQVector(safeGet(tangentsPerMeshIn, i));
+                }
+                meshOut.blendshapes = toQVector(safeGet(blendshapesPerMeshIn, i));
             }
-            output = meshesOut;
+        }
+
+    private:
+        template <typename T>
+        static QVector<T> toQVector(const std::vector<T>& values) {
+            #if (QT_VERSION < QT_VERSION_CHECK(5, 14, 0))
+            return QVector<T>::fromStdVector(values);
+            #else
+            return QVector<T>(values.begin(), values.end());
+            #endif
         }
     };
 
@@ -164,12 +179,15 @@ namespace baker {
 
         void run(const BakeContextPointer& context, const Input& input, Output& output) {
             auto hfmModelOut = input.get0();
-            hfmModelOut->meshes = input.get1();
+            // Nothing reads the built meshes or the shape vertices after this, so move them into the model
+            Varying meshes = input[1];
+            hfmModelOut->meshes = std::move(meshes.edit<std::vector<hfm::Mesh>>());
             hfmModelOut->joints = input.get2();
             hfmModelOut->jointRotationOffsets = input.get3();
             hfmModelOut->jointIndices = input.get4();
             hfmModelOut->flowData = input.get5();
-            hfmModelOut->shapeVertices = input.get6();
+            Varying shapeVertices = input[6];
+            hfmModelOut->shapeVertices = std::move(shapeVertices.edit<std::vector<ShapeVertices>>());
             hfmModelOut->shapes = input.get7();
             hfmModelOut->meshExtents = input.get8();
             // These depend on the ShapeVertices
@@ -218,8 +236,11 @@ namespace baker {
             // Build the slim triangle list mesh for each hfm::mesh
             const auto triangleListMeshes = model.addJob<BuildMeshTriangleListTask>("BuildMeshTriangleListTask", meshesIn);
 
+            // Simplify the meshes into coarser LODs, which share the vertices of the full meshes
+            const auto lodsPerMesh = model.addJob<BuildMeshLODsTask>("BuildMeshLODs", meshesIn);
+
             // Build the graphics::MeshPointer for each hfm::Mesh
-            const auto buildGraphicsMeshInputs = BuildGraphicsMeshTask::Input(meshesIn, url, meshIndicesToModelNames, normalsPerMesh, tangentsPerMesh, shapesIn, skinDeformersIn).asVarying();
+            const auto buildGraphicsMeshInputs = BuildGraphicsMeshTask::Input(meshesIn, url, meshIndicesToModelNames, normalsPerMesh, tangentsPerMesh, shapesIn, skinDeformersIn, lodsPerMesh).asVarying();
             const auto graphicsMeshes = model.addJob<BuildGraphicsMeshTask>("BuildGraphicsMesh", buildGraphicsMeshInputs);
 
             // Prepare joint information
@@ -35,6 +35,9 @@ namespace baker {
     using BlendshapeTangents = std::vector<glm::vec3>;
     using TangentsPerBlendshape = std::vector<std::vector<glm::vec3>>;
 
+    using MeshLODs = std::vector<hfm::MeshLOD>;
+    using LODsPerMesh = std::vector<std::vector<hfm::MeshLOD>>;
+
     using MeshIndicesToModelNames = QHash<int, QString>;
 
     class ReweightedDeformers {
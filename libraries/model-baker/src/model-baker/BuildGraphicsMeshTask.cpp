@@ -11,6 +11,8 @@
 
 #include "BuildGraphicsMeshTask.h"
 
+#include <algorithm>
+
 #include <glm/gtc/packing.hpp>
 
 #include <LogHandler.h>
@@ -28,17 +30,16 @@ glm::vec3 normalizeDirForPacking(const glm::vec3& dir) {
     return dir;
 }
 
-void buildGraphicsMesh(const hfm::Mesh& hfmMesh, graphics::MeshPointer& graphicsMeshPointer, const baker::MeshNormals& meshNormals, const baker::MeshTangents& meshTangentsIn, uint16_t numDeformerControllers) {
+void buildGraphicsMesh(const hfm::Mesh& hfmMesh, graphics::MeshPointer& graphicsMeshPointer, const baker::MeshNormals& meshNormals, const baker::MeshTangents& meshTangentsIn, const baker::MeshLODs& meshLODs, uint16_t numDeformerControllers) {
     auto graphicsMesh = std::make_shared<graphics::Mesh>();
 
     // Fill tangents with a dummy value to force tangents to be present if there are normals
-    baker::MeshTangents meshTangents;
-    if (!meshTangentsIn.empty()) {
-        meshTangents = meshTangentsIn;
-    } else {
-        meshTangents.reserve(meshNormals.size());
-        std::fill_n(std::back_inserter(meshTangents), meshNormals.size(), Vectors::UNIT_X);
+    baker::MeshTangents dummyTangents;
+    if (meshTangentsIn.empty()) {
+        dummyTangents.reserve(meshNormals.size());
+        std::fill_n(std::back_inserter(dummyTangents), meshNormals.size(), Vectors::UNIT_X);
     }
+    const baker::MeshTangents& meshTangents = meshTangentsIn.empty() ? dummyTangents : meshTangentsIn;
 
     unsigned int totalSourceIndices = 0;
     foreach(const HFMMeshPart& part, hfmMesh.parts) {
@@ -96,109 +97,8 @@ void buildGraphicsMesh(const hfm::Mesh& hfmMesh, graphics::MeshPointer& graphics
     const size_t clusterIndicesSize = numVertClusters * clusterIndiceElement.getSize();
     const size_t clusterWeightsSize = numVertClusters * clusterWeightElement.getSize();
 
-    // Decide on where to put what seequencially in a big buffer:
-    const size_t positionsOffset = 0;
-    const size_t normalsAndTangentsOffset = positionsOffset + positionsSize;
-    const size_t colorsOffset = normalsAndTangentsOffset + normalsAndTangentsSize;
-    const size_t texCoordsOffset = colorsOffset + colorsSize;
-    const size_t texCoords1Offset = texCoordsOffset + texCoordsSize;
-    const size_t clusterIndicesOffset = texCoords1Offset + texCoords1Size;
-    const size_t clusterWeightsOffset = clusterIndicesOffset + clusterIndicesSize;
-    const size_t totalVertsSize = clusterWeightsOffset + clusterWeightsSize;
-
-    // Copy all vertex data in a single buffer
-    auto vertBuffer = std::make_shared<gpu::Buffer>();
-    vertBuffer->resize(totalVertsSize);
-
-    // First positions
-    vertBuffer->setSubData(positionsOffset, positionsSize, (const gpu::Byte*) hfmMesh.vertices.data());
-
-    // Interleave normals and tangents
-    if (normalsSize > 0) {
-        std::vector<NormalType> normalsAndTangents;
-
-        normalsAndTangents.reserve(meshNormals.size() + (int)meshTangents.size());
-        auto normalIt = meshNormals.cbegin();
-        auto tangentIt = meshTangents.cbegin();
-        for (;
-            normalIt != meshNormals.cend();
-            ++normalIt, ++tangentIt) {
-#if HFM_PACK_NORMALS
-            const auto normal = normalizeDirForPacking(*normalIt);
-            const auto tangent = normalizeDirForPacking(*tangentIt);
-            const auto packedNormal = glm_packSnorm3x10_1x2(glm::vec4(normal, 0.0f));
-            const auto packedTangent = glm_packSnorm3x10_1x2(glm::vec4(tangent, 0.0f));
-#else
-            const auto packedNormal = *normalIt;
-            const auto packedTangent = *tangentIt;
-#endif
-            normalsAndTangents.push_back(packedNormal);
-            normalsAndTangents.push_back(packedTangent);
-        }
-        vertBuffer->setSubData(normalsAndTangentsOffset, normalsAndTangentsSize, (const gpu::Byte*) normalsAndTangents.data());
-    }
-
-    // Pack colors
-    if (colorsSize > 0) {
-#if HFM_PACK_COLORS
-        std::vector<ColorType> colors;
-
-        colors.reserve(hfmMesh.colors.size());
-        for (const auto& color : hfmMesh.colors) {
-            colors.push_back(glm::packUnorm4x8(glm::vec4(color, 1.0f)));
-        }
-        vertBuffer->setSubData(colorsOffset, colorsSize, (const gpu::Byte*) colors.data());
-#else
-        vertBuffer->setSubData(colorsOffset, colorsSize, (const gpu::Byte*) hfmMesh.colors.constData());
-#endif
-    }
-
-    // Pack Texcoords 0 and 1 (if exists)
-    if (texCoordsSize > 0) {
-        QVector<vec2h> texCoordData;
-        texCoordData.reserve(hfmMesh.texCoords.size());
-        for (auto& texCoordVec2f : hfmMesh.texCoords) {
-            vec2h texCoordVec2h;
-
-            texCoordVec2h.x = glm::detail::toFloat16(texCoordVec2f.x);
-            texCoordVec2h.y = glm::detail::toFloat16(texCoordVec2f.y);
-            texCoordData.push_back(texCoordVec2h);
-        }
-        vertBuffer->setSubData(texCoordsOffset, texCoordsSize, (const gpu::Byte*) texCoordData.constData());
-    }
-    if (texCoords1Size > 0) {
-        QVector<vec2h> texCoordData;
-        texCoordData.reserve(hfmMesh.texCoords1.size());
-        for (auto& texCoordVec2f : hfmMesh.texCoords1) {
-            vec2h texCoordVec2h;
-
-            texCoordVec2h.x = glm::detail::toFloat16(texCoordVec2f.x);
-            texCoordVec2h.y = glm::detail::toFloat16(texCoordVec2f.y);
-            texCoordData.push_back(texCoordVec2h);
-        }
-        vertBuffer->setSubData(texCoords1Offset, texCoords1Size, (const gpu::Byte*) texCoordData.constData());
-    }
-
-    // Clusters data
-    if (clusterIndicesSize > 0) {
-        if (numDeformerControllers < (uint16_t)UINT8_MAX) {
-            // yay! we can fit the clusterIndices within 8-bits
-            int32_t numIndices = (int32_t)hfmMesh.clusterIndices.size();
-            std::vector<uint8_t> packedDeformerIndices;
-            packedDeformerIndices.resize(numIndices);
-            for (int32_t i = 0; i < numIndices; ++i) {
-                assert(hfmMesh.clusterIndices[i] <= UINT8_MAX);
-                packedDeformerIndices[i] = (uint8_t)(hfmMesh.clusterIndices[i]);
-            }
-            vertBuffer->setSubData(clusterIndicesOffset, clusterIndicesSize, (const gpu::Byte*) packedDeformerIndices.data());
-        } else {
-            vertBuffer->setSubData(clusterIndicesOffset, clusterIndicesSize, (const gpu::Byte*) hfmMesh.clusterIndices.data());
-        }
-    }
-    if (clusterWeightsSize > 0) {
-        vertBuffer->setSubData(clusterWeightsOffset, clusterWeightsSize, (const gpu::Byte*) hfmMesh.clusterWeights.data());
-    }
-
+    const size_t totalVertsSize = positionsSize + normalsAndTangentsSize + colorsSize + texCoordsSize + texCoords1Size +
+        clusterIndicesSize + clusterWeightsSize;
 
     // Now we decide on how to interleave the attributes and provide the vertices among bufers:
     // Aka the Vertex format and the vertexBufferStream
@@ -281,21 +181,79 @@ void buildGraphicsMesh(const hfm::Mesh& hfmMesh, graphics::MeshPointer& graphics
 
         auto vStride = vClusterWeightOffset + vClusterWeightSize;
 
-        std::vector<gpu::Byte> dest;
-        dest.resize(totalAttribBufferSize);
+        // Pack each attribute straight into its place in the vertex, rather than packing them one after the other
+        // into a buffer of their own first and interleaving that
+        std::vector<gpu::Byte> dest(totalAttribBufferSize, 0);
         auto vDest = dest.data();
 
-        auto source = vertBuffer->getData();
+        const size_t numNormals = meshNormals.size();
+        const size_t numTangents = meshTangents.size();
+        const size_t numColors = hfmMesh.colors.size();
+        const size_t numTexCoords = hfmMesh.texCoords.size();
+        const size_t numTexCoords1 = hfmMesh.texCoords1.size();
+        const size_t numClusterIndices = hfmMesh.clusterIndices.size();
+        const size_t clusterWeightsBytes = hfmMesh.clusterWeights.size() * sizeof(uint16_t);
+        const bool packClusterIndices = numDeformerControllers < (uint16_t)UINT8_MAX;
 
         for (int i = 0; i < numVerts; i++) {
-
-            if (vPositionSize) memcpy(vDest + vPositionOffset, source + positionsOffset + i * vPositionSize, vPositionSize);
-            if (vNormalsAndTangentsSize) memcpy(vDest + vNormalsAndTangentsOffset, source + normalsAndTangentsOffset + i * vNormalsAndTangentsSize, vNormalsAndTangentsSize);
-            if (vColorSize) memcpy(vDest + vColorOffset, source + colorsOffset + i * vColorSize, vColorSize);
-            if (vTexcoord0Size) memcpy(vDest + vTexcoord0Offset, source + texCoordsOffset + i * vTexcoord0Size, vTexcoord0Size);
-            if (vTexcoord1Size) memcpy(vDest + vTexcoord1Offset, source + texCoords1Offset + i * vTexcoord1Size, vTexcoord1Size);
-            if (vClusterIndiceSize) memcpy(vDest + vClusterIndiceOffset, source + clusterIndicesOffset + i * vClusterIndiceSize, vClusterIndiceSize);
-            if (vClusterWeightSize) memcpy(vDest + vClusterWeightOffset, source + clusterWeightsOffset + i * vClusterWeightSize, vClusterWeightSize);
+            if (vPositionSize) {
+                memcpy(vDest + vPositionOffset, &hfmMesh.vertices[i], vPositionSize);
+            }
+            if (vNormalsAndTangentsSize >= 2 * (int)sizeof(NormalType) && (size_t)i < numNormals) {
+#if HFM_PACK_NORMALS
+                const NormalType packedNormal = glm_packSnorm3x10_1x2(glm::vec4(normalizeDirForPacking(meshNormals[i]), 0.0f));
+                const NormalType packedTangent = (size_t)i < numTangents ?
+                    glm_packSnorm3x10_1x2(glm::vec4(normalizeDirForPacking(meshTangents[i]), 0.0f)) : 0;
+#else
+                const NormalType packedNormal = meshNormals[i];
+                const NormalType packedTangent = (size_t)i < numTangents ? meshTangents[i] : NormalType();
+#endif
+                memcpy(vDest + vNormalsAndTangentsOffset, &packedNormal, sizeof(NormalType));
+                memcpy(vDest + vNormalsAndTangentsOffset + sizeof(NormalType), &packedTangent, sizeof(NormalType));
+            }
+            if (vColorSize >= (int)sizeof(ColorType) && (size_t)i < numColors) {
+#if HFM_PACK_COLORS
+                const ColorType packedColor = glm::packUnorm4x8(glm::vec4(hfmMesh.colors[i], 1.0f));
+#else
+                const ColorType packedColor = hfmMesh.colors[i];
+#endif
+                memcpy(vDest + vColorOffset, &packedColor, sizeof(ColorType));
+            }
+            if (vTexcoord0Size >= (int)sizeof(vec2h) && (size_t)i < numTexCoords) {
+                vec2h texCoord;
+                texCoord.x = glm::detail::toFloat16(hfmMesh.texCoords[i].x);
+                texCoord.y = glm::detail::toFloat16(hfmMesh.texCoords[i].y);
+                memcpy(vDest + vTexcoord0Offset, &texCoord, sizeof(vec2h));
+            }
+            if (vTexcoord1Size >= (int)sizeof(vec2h) && (size_t)i < numTexCoords1) {
+                vec2h texCoord;
+                texCoord.x = glm::detail::toFloat16(hfmMesh.texCoords1[i].x);
+                texCoord.y = glm::detail::toFloat16(hfmMesh.texCoords1[i].y);
+                memcpy(vDest + vTexcoord1Offset, &texCoord, sizeof(vec2h));
+            }
+            if (vClusterIndiceSize) {
+                if (packClusterIndices) {
+                    // yay! we can fit the clusterIndices within 8-bits
+                    for (size_t j = i * vClusterIndiceSize, k = 0; k < vClusterIndiceSize && j < numClusterIndices; j++, k++) {
+                        assert(hfmMesh.clusterIndices[j] <= UINT8_MAX);
+                        vDest[vClusterIndiceOffset + k] = (gpu::Byte)hfmMesh.clusterIndices[j];
+                    }
+                } else {
+                    const size_t offset = i * vClusterIndiceSize;
+                    const size_t bytes = numClusterIndices * sizeof(uint16_t);
+                    if (offset < bytes) {
+                        memcpy(vDest + vClusterIndiceOffset, (const gpu::Byte*)hfmMesh.clusterIndices.data() + offset,
+                            std::min(vClusterIndiceSize, bytes - offset));
+                    }
+                }
+            }
+            if (vClusterWeightSize) {
+                const size_t offset = i * vClusterWeightSize;
+                if (offset < clusterWeightsBytes) {
+                    memcpy(vDest + vClusterWeightOffset, (const gpu::Byte*)hfmMesh.clusterWeights.data() + offset,
+                        std::min(vClusterWeightSize, clusterWeightsBytes - offset));
+                }
+            }
 
             vDest += vStride;
         }
@@ -313,6 +271,13 @@ void buildGraphicsMesh(const hfm::Mesh& hfmMesh, graphics::MeshPointer& graphics
     foreach(const HFMMeshPart& part, hfmMesh.parts) {
         totalIndices += (part.quadTrianglesIndices.size() + part.triangleIndices.size());
     }
+    // The LODs go after the parts, in the same buffer
+    unsigned int totalLODIndices = 0;
+    for (const auto& lod : meshLODs) {
+        for (const auto& partIndices : lod.partTriangleIndices) {
+            totalLODIndices += partIndices.size();
+        }
+    }
 
     if (!totalIndices) {
         HIFI_FCDEBUG_ID(model_baker(), repeatMessageID, "BuildGraphicsMeshTask failed -- no indices");
@@ -320,7 +285,7 @@ void buildGraphicsMesh(const hfm::Mesh& hfmMesh, graphics::MeshPointer& graphics
     }
 
     auto indexBuffer = std::make_shared<gpu::Buffer>();
-    indexBuffer->resize(totalIndices * sizeof(int));
+    indexBuffer->resize((totalIndices + totalLODIndices) * sizeof(int));
 
     int indexNum = 0;
     int offset = 0;
@@ -353,6 +318,25 @@ void buildGraphicsMesh(const hfm::Mesh& hfmMesh, graphics::MeshPointer& graphics
         parts.push_back(modelPart);
     }
 
+    std::vector<graphics::Mesh::LOD> lods;
+    lods.reserve(meshLODs.size());
+    for (const auto& meshLOD : meshLODs) {
+        graphics::Mesh::LOD lod;
+        lod.error = meshLOD.error;
+        for (size_t i = 0; i < hfmMesh.parts.size(); i++) {
+            graphics::Mesh::Part lodPart(indexNum, 0, 0, graphics::Mesh::TRIANGLES);
+            if (i < meshLOD.partTriangleIndices.size() && meshLOD.partTriangleIndices[i].size()) {
+                const auto& partIndices = meshLOD.partTriangleIndices[i];
+                indexBuffer->setSubData(offset, partIndices.size() * sizeof(int), (gpu::Byte*) partIndices.constData());
+                offset += partIndices.size() * sizeof(int);
+                indexNum += partIndices.size();
+                lodPart._numIndices = partIndices.size();
+            }
+            lod.parts.push_back(lodPart);
+        }
+        lods.push_back(lod);
+    }
+
     gpu::BufferView indexBufferView(indexBuffer, gpu::Element(gpu::SCALAR, gpu::UINT32, gpu::XYZ));
     graphicsMesh->setIndexBuffer(indexBufferView);
 
@@ -361,6 +345,7 @@ void buildGraphicsMesh(const hfm::Mesh& hfmMesh, graphics::MeshPointer& graphics
         pb->setData(parts.size() * sizeof(graphics::Mesh::Part), (const gpu::Byte*) parts.data());
         gpu::BufferView pbv(pb, gpu::Element(gpu::VEC4, gpu::UINT32, gpu::XYZW));
         graphicsMesh->setPartBuffer(pbv);
+        graphicsMesh->setLODs(lods);
     } else {
         HIFI_FCDEBUG_ID(model_baker(), repeatMessageID, "BuildGraphicsMeshTask failed -- no parts");
         return;
@@ -379,6 +364,7 @@ void BuildGraphicsMeshTask::run(const baker::BakeContextPointer& context, const
     const auto& tangentsPerMesh = input.get4();
     const auto& shapes = input.get5();
     const auto& skinDeformers = input.get6();
+    const auto& lodsPerMesh = input.get7();
 
     // Currently, there is only (at most) one skinDeformer per mesh
     // An undefined shape.skinDeformer has the value hfm::UNDEFINED_KEY
@@ -404,7 +390,7 @@ void BuildGraphicsMeshTask::run(const baker::BakeContextPointer& context, const
         }
 
         // Try to create the graphics::Mesh
-        buildGraphicsMesh(meshes[i], graphicsMesh, baker::safeGet(normalsPerMesh, i), baker::safeGet(tangentsPerMesh, i), numDeformerControllers);
+        buildGraphicsMesh(meshes[i], graphicsMesh, baker::safeGet(normalsPerMesh, i), baker::safeGet(tangentsPerMesh, i), baker::safeGet(lodsPerMesh, i), numDeformerControllers);
 
         // Choose a name for the mesh
         if (graphicsMesh) {
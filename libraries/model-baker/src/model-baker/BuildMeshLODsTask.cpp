@@ -0,0 +1,557 @@
+//
+//  BuildMeshLODsTask.cpp
+//  model-baker/src/model-baker
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BuildMeshLODsTask.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <functional>
+#include <queue>
+
+#include <TBBHelpers.h>
+
+namespace {
+
+const int INDICES_PER_TRIANGLE = 3;
+
+// The sum of the squared distances to a set of planes, as a symmetric 4x4 matrix
+class Quadric {
+public:
+    Quadric() = default;
+    Quadric(const glm::dvec3& normal, double offset) :
+        _xx(normal.x * normal.x), _xy(normal.x * normal.y), _xz(normal.x * normal.z), _xw(normal.x * offset),
+        _yy(normal.y * normal.y), _yz(normal.y * normal.z), _yw(normal.y * offset),
+        _zz(normal.z * normal.z), _zw(normal.z * offset),
+        _ww(offset * offset) {}
+
+    Quadric& operator+=(const Quadric& other) {
+        _xx += other._xx; _xy += other._xy; _xz += other._xz; _xw += other._xw;
+        _yy += other._yy; _yz += other._yz; _yw += other._yw;
+        _zz += other._zz; _zw += other._zw;
+        _ww += other._ww;
+        return *this;
+    }
+
+    double evaluate(const glm::vec3& position) const {
+        double x = position.x;
+        double y = position.y;
+        double z = position.z;
+        double error = x * x * _xx + 2.0 * x * y * _xy + 2.0 * x * z * _xz + 2.0 * x * _xw +
+            y * y * _yy + 2.0 * y * z * _yz + 2.0 * y * _yw +
+            z * z * _zz + 2.0 * z * _zw +
+            _ww;
+        // the planes all go through the vertex the quadric started at, so anything below zero is rounding
+        return std::max(error, 0.0);
+    }
+
+private:
+    double _xx { 0.0 }, _xy { 0.0 }, _xz { 0.0 }, _xw { 0.0 };
+    double _yy { 0.0 }, _yz { 0.0 }, _yw { 0.0 };
+    double _zz { 0.0 }, _zw { 0.0 };
+    double _ww { 0.0 };
+};
+
+// The point of the triangle abc closest to p, after Ericson, Real-Time Collision Detection, 5.1.5
+glm::vec3 closestPointOnTriangle(const glm::vec3& p, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c) {
+    glm::vec3 ab = b - a;
+    glm::vec3 ac = c - a;
+    glm::vec3 ap = p - a;
+    float d1 = glm::dot(ab, ap);
+    float d2 = glm::dot(ac, ap);
+    if (d1 <= 0.0f && d2 <= 0.0f) {
+        return a;
+    }
+    glm::vec3 bp = p - b;
+    float d3 = glm::dot(ab, bp);
+    float d4 = glm::dot(ac, bp);
+    if (d3 >= 0.0f && d4 <= d3) {
+        return b;
+    }
+    float vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+        return a + ab * (d1 / (d1 - d3));
+    }
+    glm::vec3 cp = p - c;
+    float d5 = glm::dot(ab, cp);
+    float d6 = glm::dot(ac, cp);
+    if (d6 >= 0.0f && d5 <= d6) {
+        return c;
+    }
+    float vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+        return a + ac * (d2 / (d2 - d6));
+    }
+    float va = d3 * d6 - d5 * d4;
+    if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f) {
+        return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+    }
+    float denominator = va + vb + vc;
+    if (denominator <= 0.0f) {
+        // degenerate, which the collapses never leave behind
+        return a;
+    }
+    return a + ab * (vb / denominator) + ac * (vc / denominator);
+}
+
+// Collapses the edges of a mesh, cheapest first, one vertex onto another.  Each vertex has one collapse queued, onto the
+// neighbor it would move the surface the least going to, which is queued again whenever anything around it changes.
+class MeshSimplifier {
+public:
+    MeshSimplifier(const hfm::Mesh& mesh);
+
+    int getNumTriangles() const { return _numTriangles; }
+
+    // collapse edges until there are no more than targetTriangles left, or no edge can go without tearing or folding the mesh
+    void simplify(int targetTriangles);
+
+    // the triangles that are left, by part, and how far the vertices collapsed away lie from them
+    hfm::MeshLOD getLOD();
+
+private:
+    class Collapse {
+    public:
+        float cost;
+        int from;
+        int to;
+        uint32_t version;
+
+        bool operator>(const Collapse& other) const { return cost > other.cost; }
+        bool operator<(const Collapse& other) const { return cost < other.cost; }
+    };
+
+    bool hasVertex(int triangle, int vertex) const;
+    void getNeighbors(int vertex, std::vector<int>& neighbors) const;
+    float getCost(int from, int to) const;
+    void queueCollapse(int vertex, bool isChecked = false);
+    bool canCollapse(int from, int to);
+    void collapse(int from, int to);
+    int getSurvivor(int vertex);
+    float measureError();
+
+    const QVector<glm::vec3>& _positions;
+    size_t _numParts;
+
+    std::vector<int> _indices;
+    std::vector<int> _triangleParts;
+    std::vector<bool> _isTriangleRemoved;
+    int _numTriangles { 0 };
+
+    std::vector<std::vector<int>> _vertexTriangles;
+    std::vector<Quadric> _quadrics;
+    std::vector<bool> _isVertexLocked;
+    std::vector<Collapse> _queuedCollapses;
+    std::vector<int> _collapsedTo; // the vertex each one went to, -1 while it is still there
+
+    std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> _collapses;
+
+    // scratch space
+    std::vector<int> _neighbors;
+    std::vector<int> _fromNeighbors;
+    std::vector<int> _toNeighbors;
+    std::vector<Collapse> _candidates;
+};
+
+MeshSimplifier::MeshSimplifier(const hfm::Mesh& mesh) :
+    _positions(mesh.vertices),
+    _numParts(mesh.parts.size())
+{
+    int numVertices = _positions.size();
+    auto addTriangles = [&](const QVector<int>& indices, int part) {
+        for (int i = 0; i + INDICES_PER_TRIANGLE <= indices.size(); i += INDICES_PER_TRIANGLE) {
+            int a = indices[i];
+            int b = indices[i + 1];
+            int c = indices[i + 2];
+            if (a < 0 || b < 0 || c < 0 || a >= numVertices || b >= numVertices || c >= numVertices ||
+                    a == b || b == c || c == a) {
+                continue;
+            }
+            _indices.push_back(a);
+            _indices.push_back(b);
+            _indices.push_back(c);
+            _triangleParts.push_back(part);
+        }
+    };
+    for (size_t i = 0; i < _numParts; i++) {
+        addTriangles(mesh.parts[i].quadTrianglesIndices, (int)i);
+        addTriangles(mesh.parts[i].triangleIndices, (int)i);
+    }
+    _numTriangles = (int)_triangleParts.size();
+    _isTriangleRemoved.resize(_numTriangles, false);
+
+    _vertexTriangles.resize(numVertices);
+    _quadrics.resize(numVertices);
+    _isVertexLocked.resize(numVertices, false);
+    _queuedCollapses.resize(numVertices, { FLT_MAX, -1, -1, 0 });
+    _collapsedTo.resize(numVertices, -1);
+
+    for (int t = 0; t < _numTriangles; t++) {
+        const int* triangle = &_indices[t * INDICES_PER_TRIANGLE];
+        glm::dvec3 a = _positions[triangle[0]];
+        glm::dvec3 b = _positions[triangle[1]];
+        glm::dvec3 c = _positions[triangle[2]];
+        glm::dvec3 normal = glm::cross(b - a, c - a);
+        double length = glm::length(normal);
+        if (length > 0.0) {
+            normal /= length;
+            Quadric plane(normal, -glm::dot(normal, a));
+            for (int i = 0; i < INDICES_PER_TRIANGLE; i++) {
+                _quadrics[triangle[i]] += plane;
+            }
+        }
+
+        for (int i = 0; i < INDICES_PER_TRIANGLE; i++) {
+            _vertexTriangles[triangle[i]].push_back(t);
+        }
+    }
+
+    // Borders, seams (which are borders too, with the vertices split), anything non-manifold and anything between parts
+    // stays put.  Going around a vertex inside a single surface, every neighbor is in exactly two of its triangles.
+    for (int vertex = 0; vertex < numVertices; vertex++) {
+        const auto& triangles = _vertexTriangles[vertex];
+        if (triangles.empty()) {
+            continue;
+        }
+        _neighbors.clear();
+        for (int triangle : triangles) {
+            if (_triangleParts[triangle] != _triangleParts[triangles[0]]) {
+                _isVertexLocked[vertex] = true;
+                break;
+            }
+            const int* indices = &_indices[triangle * INDICES_PER_TRIANGLE];
+            for (int i = 0; i < INDICES_PER_TRIANGLE; i++) {
+                if (indices[i] != vertex) {
+                    _neighbors.push_back(indices[i]);
+                }
+            }
+        }
+        if (_isVertexLocked[vertex]) {
+            continue;
+        }
+        std::sort(_neighbors.begin(), _neighbors.end());
+        for (size_t i = 0; i < _neighbors.size(); i += 2) {
+            if (i + 1 >= _neighbors.size() || _neighbors[i] != _neighbors[i + 1] ||
+                    (i + 2 < _neighbors.size() && _neighbors[i + 2] == _neighbors[i])) {
+                _isVertexLocked[vertex] = true;
+                break;
+            }
+        }
+    }
+
+    for (int vertex = 0; vertex < numVertices; vertex++) {
+        if (!_vertexTriangles[vertex].empty()) {
+            queueCollapse(vertex);
+        }
+    }
+}
+
+bool MeshSimplifier::hasVertex(int triangle, int vertex) const {
+    const int* indices = &_indices[triangle * INDICES_PER_TRIANGLE];
+    return indices[0] == vertex || indices[1] == vertex || indices[2] == vertex;
+}
+
+void MeshSimplifier::getNeighbors(int vertex, std::vector<int>& neighbors) const {
+    neighbors.clear();
+    for (int triangle : _vertexTriangles[vertex]) {
+        if (_isTriangleRemoved[triangle]) {
+            continue;
+        }
+        const int* indices = &_indices[triangle * INDICES_PER_TRIANGLE];
+        for (int i = 0; i < INDICES_PER_TRIANGLE; i++) {
+            if (indices[i] != vertex) {
+                neighbors.push_back(indices[i]);
+            }
+        }
+    }
+    std::sort(neighbors.begin(), neighbors.end());
+    neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+}
+
+float MeshSimplifier::getCost(int from, int to) const {
+    const glm::vec3& position = _positions[to];
+    return (float)(_quadrics[from].evaluate(position) + _quadrics[to].evaluate(position));
+}
+
+void MeshSimplifier::queueCollapse(int vertex, bool isChecked) {
+    if (_isVertexLocked[vertex]) {
+        return;
+    }
+
+    // a new version of the collapse leaves the one in the queue behind
+    auto& queued = _queuedCollapses[vertex];
+    if (!isChecked) {
+        // An unlocked vertex is all the way inside a surface, so going around it, each neighbor comes after it in just one
+        // triangle.  That gets each of them once, without sorting them out.
+        Collapse cheapest { FLT_MAX, vertex, -1, queued.version + 1 };
+        for (int triangle : _vertexTriangles[vertex]) {
+            if (_isTriangleRemoved[triangle]) {
+                continue;
+            }
+            const int* indices = &_indices[triangle * INDICES_PER_TRIANGLE];
+            int corner = indices[0] == vertex ? 0 : (indices[1] == vertex ? 1 : 2);
+            int neighbor = indices[(corner + 1) % INDICES_PER_TRIANGLE];
+            float cost = getCost(vertex, neighbor);
+            if (cost < cheapest.cost) {
+                cheapest.cost = cost;
+                cheapest.to = neighbor;
+            }
+        }
+        // the queue is most of the work, so only go back in it when something changed
+        if (cheapest.to != queued.to || cheapest.cost != queued.cost) {
+            queued = cheapest;
+            if (cheapest.to != -1) {
+                _collapses.push(cheapest);
+            }
+        }
+        return;
+    }
+
+    // The cheapest one could not go, so settle for the cheapest one that can
+    getNeighbors(vertex, _neighbors);
+    _candidates.clear();
+    for (int neighbor : _neighbors) {
+        _candidates.push_back({ getCost(vertex, neighbor), vertex, neighbor, queued.version + 1 });
+    }
+    std::sort(_candidates.begin(), _candidates.end());
+    for (const auto& candidate : _candidates) {
+        if (canCollapse(vertex, candidate.to)) {
+            queued = candidate;
+            _collapses.push(candidate);
+            return;
+        }
+    }
+    queued = { FLT_MAX, vertex, -1, queued.version + 1 };
+}
+
+bool MeshSimplifier::canCollapse(int from, int to) {
+    getNeighbors(from, _fromNeighbors);
+    if (!std::binary_search(_fromNeighbors.begin(), _fromNeighbors.end(), to)) {
+        return false;
+    }
+
+    // Only the far corners of the triangles along the edge can be next to both ends, or the collapse pinches the mesh
+    int numEdgeTriangles = 0;
+    for (int triangle : _vertexTriangles[from]) {
+        if (!_isTriangleRemoved[triangle] && hasVertex(triangle, to)) {
+            numEdgeTriangles++;
+        }
+    }
+    getNeighbors(to, _toNeighbors);
+    int numSharedNeighbors = 0;
+    auto toNeighbor = _toNeighbors.begin();
+    for (int neighbor : _fromNeighbors) {
+        toNeighbor = std::lower_bound(toNeighbor, _toNeighbors.end(), neighbor);
+        if (toNeighbor != _toNeighbors.end() && *toNeighbor == neighbor) {
+            numSharedNeighbors++;
+        }
+    }
+    if (numSharedNeighbors != numEdgeTriangles) {
+        return false;
+    }
+
+    // The triangles that stay must not flip over or collapse to nothing
+    const glm::vec3& position = _positions[to];
+    for (int triangle : _vertexTriangles[from]) {
+        if (_isTriangleRemoved[triangle] || hasVertex(triangle, to)) {
+            continue;
+        }
+        const int* indices = &_indices[triangle * INDICES_PER_TRIANGLE];
+        glm::vec3 corners[INDICES_PER_TRIANGLE];
+        for (int i = 0; i < INDICES_PER_TRIANGLE; i++) {
+            corners[i] = _positions[indices[i]];
+        }
+        glm::vec3 normal = glm::cross(corners[1] - corners[0], corners[2] - corners[0]);
+        for (int i = 0; i < INDICES_PER_TRIANGLE; i++) {
+            if (indices[i] == from) {
+                corners[i] = position;
+            }
+        }
+        glm::vec3 collapsedNormal = glm::cross(corners[1] - corners[0], corners[2] - corners[0]);
+        if (glm::dot(normal, collapsedNormal) <= 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void MeshSimplifier::collapse(int from, int to) {
+    auto& toTriangles = _vertexTriangles[to];
+    for (int triangle : _vertexTriangles[from]) {
+        if (_isTriangleRemoved[triangle]) {
+            continue;
+        }
+        if (hasVertex(triangle, to)) {
+            _isTriangleRemoved[triangle] = true;
+            _numTriangles--;
+        } else {
+            int* indices = &_indices[triangle * INDICES_PER_TRIANGLE];
+            for (int i = 0; i < INDICES_PER_TRIANGLE; i++) {
+                if (indices[i] == from) {
+                    indices[i] = to;
+                }
+            }
+            toTriangles.push_back(triangle);
+        }
+    }
+    _vertexTriangles[from].clear();
+    _collapsedTo[from] = to;
+    toTriangles.erase(std::remove_if(toTriangles.begin(), toTriangles.end(), [&](int triangle) {
+        return _isTriangleRemoved[triangle];
+    }), toTriangles.end());
+
+    _quadrics[to] += _quadrics[from];
+
+    // Everything around the vertex that took over has it for a neighbor, now with a new quadric.  The ones that were going to
+    // collapse onto either end need to look again, the rest only need to see if it is a better place to go than what they had.
+    queueCollapse(to);
+    getNeighbors(to, _toNeighbors);
+    for (int neighbor : _toNeighbors) {
+        auto& queued = _queuedCollapses[neighbor];
+        if (_isVertexLocked[neighbor]) {
+            continue;
+        } else if (queued.to == -1 || queued.to == from || queued.to == to) {
+            queueCollapse(neighbor);
+        } else {
+            float cost = getCost(neighbor, to);
+            if (cost < queued.cost) {
+                queued = { cost, neighbor, to, queued.version + 1 };
+                _collapses.push(queued);
+            }
+        }
+    }
+}
+
+void MeshSimplifier::simplify(int targetTriangles) {
+    while (_numTriangles > targetTriangles && !_collapses.empty()) {
+        Collapse next = _collapses.top();
+        _collapses.pop();
+        auto& queued = _queuedCollapses[next.from];
+        if (next.version != queued.version) {
+            continue;
+        }
+        // out of the queue now, so it goes back in even if nothing changes
+        queued.to = -1;
+        if (!canCollapse(next.from, next.to)) {
+            queueCollapse(next.from, true);
+            continue;
+        }
+        collapse(next.from, next.to);
+    }
+}
+
+int MeshSimplifier::getSurvivor(int vertex) {
+    int survivor = vertex;
+    while (_collapsedTo[survivor] != -1) {
+        survivor = _collapsedTo[survivor];
+    }
+    // shorten the way there for the next time
+    while (vertex != survivor) {
+        int next = _collapsedTo[vertex];
+        _collapsedTo[vertex] = survivor;
+        vertex = next;
+    }
+    return survivor;
+}
+
+// The quadric costs are sums of squared distances to planes, which say which collapse is cheapest but bound nothing, so the
+// error is measured instead: the furthest any vertex collapsed away lies from the triangles around the vertex it ended up
+// at.  That is measured at the vertices only, so it is an estimate, which the faces between them can stray a bit past.
+float MeshSimplifier::measureError() {
+    float maxDistance = 0.0f;
+    for (int vertex = 0; vertex < (int)_collapsedTo.size(); vertex++) {
+        if (_collapsedTo[vertex] == -1) {
+            continue;
+        }
+        const glm::vec3& position = _positions[vertex];
+        float distance = FLT_MAX;
+        for (int triangle : _vertexTriangles[getSurvivor(vertex)]) {
+            if (_isTriangleRemoved[triangle]) {
+                continue;
+            }
+            const int* indices = &_indices[triangle * INDICES_PER_TRIANGLE];
+            glm::vec3 closest = closestPointOnTriangle(position, _positions[indices[0]], _positions[indices[1]],
+                                                       _positions[indices[2]]);
+            distance = std::min(distance, glm::distance(position, closest));
+        }
+        if (distance != FLT_MAX) {
+            maxDistance = std::max(maxDistance, distance);
+        }
+    }
+    return maxDistance;
+}
+
+hfm::MeshLOD MeshSimplifier::getLOD() {
+    hfm::MeshLOD lod;
+    lod.partTriangleIndices.resize(_numParts);
+    for (int t = 0; t < (int)_triangleParts.size(); t++) {
+        if (!_isTriangleRemoved[t]) {
+            auto& indices = lod.partTriangleIndices[_triangleParts[t]];
+            indices.append(_indices[t * INDICES_PER_TRIANGLE]);
+            indices.append(_indices[t * INDICES_PER_TRIANGLE + 1]);
+            indices.append(_indices[t * INDICES_PER_TRIANGLE + 2]);
+        }
+    }
+    lod.error = measureError();
+    return lod;
+}
+
+baker::MeshLODs buildMeshLODs(const hfm::Mesh& mesh, int maxLODs, float reduction, int minTriangles) {
+    baker::MeshLODs lods;
+
+    int numIndices = 0;
+    for (const auto& part : mesh.parts) {
+        numIndices += part.quadTrianglesIndices.size() + part.triangleIndices.size();
+    }
+    if (numIndices / INDICES_PER_TRIANGLE < minTriangles) {
+        return lods;
+    }
+
+    // An LOD that hardly does better than the one before it is not worth its indices
+    const float MAX_KEPT_TRIANGLES = 0.8f;
+
+    MeshSimplifier simplifier(mesh);
+    int numTriangles = simplifier.getNumTriangles();
+    for (int i = 0; i < maxLODs; i++) {
+        simplifier.simplify((int)(numTriangles * reduction));
+        int numLODTriangles = simplifier.getNumTriangles();
+        if (numLODTriangles > numTriangles * MAX_KEPT_TRIANGLES) {
+            break;
+        }
+        auto lod = simplifier.getLOD();
+        // evalLOD takes the errors to only go up from one LOD to the next
+        if (!lods.empty()) {
+            lod.error = std::max(lod.error, lods.back().error);
+        }
+        lods.push_back(lod);
+        numTriangles = numLODTriangles;
+    }
+    return lods;
+}
+
+}
+
+void BuildMeshLODsTask::configure(const Config& config) {
+    _maxLODs = config.maxLODs;
+    _reduction = config.reduction;
+    _minTriangles = config.minTriangles;
+}
+
+void BuildMeshLODsTask::run(const baker::BakeContextPointer& context, const Input& input, Output& output) {
+    const auto& meshes = input;
+    auto& lodsPerMeshOut = output;
+
+    lodsPerMeshOut.clear();
+    lodsPerMeshOut.resize(meshes.size());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, meshes.size()), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i != range.end(); ++i) {
+            lodsPerMeshOut[i] = buildMeshLODs(meshes[i], _maxLODs, _reduction, _minTriangles);
+        }
+    });
+}
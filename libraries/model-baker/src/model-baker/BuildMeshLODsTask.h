@@ -0,0 +1,50 @@
+//
+//  BuildMeshLODsTask.h
+//  model-baker/src/model-baker
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BuildMeshLODsTask_h
+#define hifi_BuildMeshLODsTask_h
+
+#include <hfm/HFM.h>
+
+#include "Engine.h"
+#include "BakerTypes.h"
+
+class BuildMeshLODsConfig : public baker::JobConfig {
+    Q_OBJECT
+    Q_PROPERTY(int maxLODs MEMBER maxLODs)
+    Q_PROPERTY(float reduction MEMBER reduction)
+    Q_PROPERTY(int minTriangles MEMBER minTriangles)
+public:
+    int maxLODs { 3 };
+    float reduction { 0.5f }; // the share of the triangles of the previous LOD to aim for
+    int minTriangles { 1024 }; // meshes with fewer triangles are cheap enough as they are
+};
+
+// Simplify each mesh into coarser and coarser LODs by quadric edge collapse.  Vertices only ever collapse onto one of their
+// neighbors, so the LODs are triangles of the mesh's own vertices, and share its vertex buffer, skinning and blendshapes.
+// Vertices on the mesh's borders and seams, and between parts, stay put so that nothing cracks open.
+class BuildMeshLODsTask {
+public:
+    using Config = BuildMeshLODsConfig;
+    using Input = std::vector<hfm::Mesh>;
+    using Output = baker::LODsPerMesh;
+    using JobModel = baker::Job::ModelIO<BuildMeshLODsTask, Input, Output, Config>;
+
+    void configure(const Config& config);
+    void run(const baker::BakeContextPointer& context, const Input& input, Output& output);
+
+protected:
+    int _maxLODs { 3 };
+    float _reduction { 0.5f };
+    int _minTriangles { 1024 };
+};
+
+#endif // hifi_BuildMeshLODsTask_h
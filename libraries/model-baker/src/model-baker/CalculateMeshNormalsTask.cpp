@@ -27,14 +27,7 @@ void CalculateMeshNormalsTask::run(const baker::BakeContextPointer& context, con
             normalsOut = std::vector<glm::vec3>(mesh.normals.begin(), mesh.normals.end());
         } else {
             normalsOut.resize(mesh.vertices.size());
-            baker::calculateNormals(mesh,
-                [&normalsOut](int normalIndex) /* NormalAccessor */ {
-                    return &normalsOut[normalIndex];
-                },
-                [&mesh](int vertexIndex, glm::vec3& outVertex) /* VertexSetter */ {
-                    outVertex = baker::safeGet(mesh.vertices, vertexIndex);
-                }
-            );
+            baker::calculateNormals(mesh, baker::VertexMap(mesh), normalsOut);
         }
     }
 }
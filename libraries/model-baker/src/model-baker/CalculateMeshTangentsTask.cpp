@@ -32,15 +32,7 @@ void CalculateMeshTangentsTask::run(const baker::BakeContextPointer& context, co
             tangentsOut = std::vector<glm::vec3>(tangentsIn.begin(), tangentsIn.end());
         } else if (!normals.empty() && mesh.vertices.size() <= mesh.texCoords.size()) {
             tangentsOut.resize(normals.size());
-            baker::calculateTangents(mesh,
-            [&mesh, &normals, &tangentsOut](int firstIndex, int secondIndex, glm::vec3* outVertices, glm::vec2* outTexCoords, glm::vec3& outNormal) {
-                outVertices[0] = mesh.vertices[firstIndex];
-                outVertices[1] = mesh.vertices[secondIndex];
-                outNormal = normals[firstIndex];
-                outTexCoords[0] = mesh.texCoords[firstIndex];
-                outTexCoords[1] = mesh.texCoords[secondIndex];
-                return &(tangentsOut[firstIndex]);
-            });
+            baker::calculateTangents(mesh, baker::VertexMap(mesh), normals, tangentsOut);
         }
     }
 }
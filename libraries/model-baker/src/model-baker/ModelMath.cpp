@@ -11,7 +11,12 @@
 
 #include "ModelMath.h"
 
+#include <algorithm>
+#include <numeric>
+
 #include <LogHandler.h>
+#include <TBBHelpers.h>
+
 #include "ModelBakerLogging.h"
 
 namespace baker {
@@ -39,83 +44,138 @@ namespace baker {
         return vector[i];
     }
 
-    void setTangent(const HFMMesh& mesh, const IndexAccessor& vertexAccessor, int firstIndex, int secondIndex) {
-        glm::vec3 vertex[2];
-        glm::vec2 texCoords[2];
-        glm::vec3 normal;
-        glm::vec3* tangent = vertexAccessor(firstIndex, secondIndex, vertex, texCoords, normal);
-        if (tangent) {
-            glm::vec3 bitangent = glm::cross(normal, vertex[1] - vertex[0]);
-            if (glm::length(bitangent) < EPSILON) {
-                return;
-            }
-            glm::vec2 texCoordDelta = texCoords[1] - texCoords[0];
-            glm::vec3 normalizedNormal = glm::normalize(normal);
-            *tangent += glm::cross(glm::angleAxis(-atan2f(-texCoordDelta.t, texCoordDelta.s), normalizedNormal) *
-                glm::normalize(bitangent), normalizedNormal);
-        }
-    }
-
-    void calculateNormals(const hfm::Mesh& mesh, NormalAccessor normalAccessor, VertexSetter vertexSetter) {
+    // Calls f with each face of the mesh, in order: the quads then the triangles of each part, with the number of vertices
+    template <typename F>
+    void forEachFace(const hfm::Mesh& mesh, const char* caller, F f) {
         static int repeatMessageID = LogHandler::getInstance().newRepeatedMessageID();
         for (const HFMMeshPart& part : mesh.parts) {
-            for (int i = 0; i < part.quadIndices.size(); i += 4) {
-                glm::vec3* n0 = normalAccessor(part.quadIndices[i]);
-                glm::vec3* n1 = normalAccessor(part.quadIndices[i + 1]);
-                glm::vec3* n2 = normalAccessor(part.quadIndices[i + 2]);
-                glm::vec3* n3 = normalAccessor(part.quadIndices[i + 3]);
-                if (!n0 || !n1 || !n2 || !n3) {
-                    // Quad is not in the mesh (can occur with blendshape meshes, which are a subset of the hfm Mesh vertices)
-                    continue;
-                }
-                glm::vec3 vertices[3]; // Assume all vertices in this quad are in the same plane, so only the first three are needed to calculate the normal
-                vertexSetter(part.quadIndices[i], vertices[0]);
-                vertexSetter(part.quadIndices[i + 1], vertices[1]);
-                vertexSetter(part.quadIndices[i + 2], vertices[2]);
-                *n0 = *n1 = *n2 = *n3 = glm::cross(vertices[1] - vertices[0], vertices[2] - vertices[0]);
+            const int* quadIndices = part.quadIndices.constData();
+            for (int i = 0; i <= part.quadIndices.size() - 4; i += 4) {
+                f(quadIndices + i, 4);
             }
             // <= size - 3 in order to prevent overflowing triangleIndices when (i % 3) != 0
             // This is most likely evidence of a further problem in extractMesh()
+            const int* triangleIndices = part.triangleIndices.constData();
             for (int i = 0; i <= part.triangleIndices.size() - 3; i += 3) {
-                glm::vec3* n0 = normalAccessor(part.triangleIndices[i]);
-                glm::vec3* n1 = normalAccessor(part.triangleIndices[i + 1]);
-                glm::vec3* n2 = normalAccessor(part.triangleIndices[i + 2]);
-                if (!n0 || !n1 || !n2) {
-                    // Tri is not in the mesh (can occur with blendshape meshes, which are a subset of the hfm Mesh vertices)
-                    continue;
-                }
-                glm::vec3 vertices[3];
-                vertexSetter(part.triangleIndices[i], vertices[0]);
-                vertexSetter(part.triangleIndices[i + 1], vertices[1]);
-                vertexSetter(part.triangleIndices[i + 2], vertices[2]);
-                *n0 = *n1 = *n2 = glm::cross(vertices[1] - vertices[0], vertices[2] - vertices[0]);
+                f(triangleIndices + i, 3);
             }
             if ((part.triangleIndices.size() % 3) != 0) {
-                HIFI_FCDEBUG_ID(model_baker(), repeatMessageID, "Error in baker::calculateNormals: part.triangleIndices.size() is not divisible by three");
+                HIFI_FCDEBUG_ID(model_baker(), repeatMessageID, "Error in baker::" << caller << ": part.triangleIndices.size() is not divisible by three");
             }
         }
     }
 
-    void calculateTangents(const hfm::Mesh& mesh, IndexAccessor accessor) {
-        static int repeatMessageID = LogHandler::getInstance().newRepeatedMessageID();
-        for (const HFMMeshPart& part : mesh.parts) {
-            for (int i = 0; i < part.quadIndices.size(); i += 4) {
-                setTangent(mesh, accessor, part.quadIndices.at(i), part.quadIndices.at(i + 1));
-                setTangent(mesh, accessor, part.quadIndices.at(i + 1), part.quadIndices.at(i + 2));
-                setTangent(mesh, accessor, part.quadIndices.at(i + 2), part.quadIndices.at(i + 3));
-                setTangent(mesh, accessor, part.quadIndices.at(i + 3), part.quadIndices.at(i));
+    // The vertices of a mesh are shared by a handful of faces each, so a task needs a good number of them to be worth it
+    const int MIN_VERTICES_PER_TASK = 1024;
+
+    VertexMap::VertexMap(const hfm::Mesh& mesh) :
+        _vertices(mesh.vertices),
+        _numSlots(mesh.vertices.size()) {
+    }
+
+    VertexMap::VertexMap(const hfm::Mesh& mesh, const hfm::Blendshape& blendshape) :
+        _vertices(mesh.vertices),
+        _movedVertices(blendshape.vertices),
+        _lookup(mesh.vertices.size()),
+        _numSlots(blendshape.vertices.size()) {
+        std::iota(_lookup.begin(), _lookup.end(), 0);
+        for (int indexInBlendshape = 0; indexInBlendshape < blendshape.indices.size(); ++indexInBlendshape) {
+            int indexInMesh = blendshape.indices[indexInBlendshape];
+            if (indexInMesh >= 0 && indexInMesh < (int)_lookup.size()) {
+                _lookup[indexInMesh] = indexInBlendshape;
             }
-            // <= size - 3 in order to prevent overflowing triangleIndices when (i % 3) != 0
-            // This is most likely evidence of a further problem in extractMesh()
-            for (int i = 0; i <= part.triangleIndices.size() - 3; i += 3) {
-                setTangent(mesh, accessor, part.triangleIndices.at(i), part.triangleIndices.at(i + 1));
-                setTangent(mesh, accessor, part.triangleIndices.at(i + 1), part.triangleIndices.at(i + 2));
-                setTangent(mesh, accessor, part.triangleIndices.at(i + 2), part.triangleIndices.at(i));
+        }
+    }
+
+    // The tangent of the edge from firstIndex to secondIndex, if there is one
+    bool calculateTangent(const hfm::Mesh& mesh, const VertexMap& map, const std::vector<glm::vec3>& normals,
+                          int firstIndex, int secondIndex, glm::vec3& tangent) {
+        int firstLookup = map.getLookup(firstIndex);
+        int secondLookup = map.getLookup(secondIndex);
+        if (firstLookup < 0 || firstLookup >= (int)normals.size() || firstLookup >= mesh.texCoords.size() ||
+                secondLookup < 0 || secondLookup >= mesh.texCoords.size()) {
+            return false;
+        }
+
+        glm::vec3 normal = normals[firstLookup];
+        glm::vec3 bitangent = glm::cross(normal, map.getPosition(secondIndex) - map.getPosition(firstIndex));
+        if (glm::length(bitangent) < EPSILON) {
+            return false;
+        }
+        glm::vec2 texCoordDelta = mesh.texCoords[secondLookup] - mesh.texCoords[firstLookup];
+        glm::vec3 normalizedNormal = glm::normalize(normal);
+        tangent = glm::cross(glm::angleAxis(-atan2f(-texCoordDelta.t, texCoordDelta.s), normalizedNormal) *
+            glm::normalize(bitangent), normalizedNormal);
+        return true;
+    }
+
+    void calculateNormals(const hfm::Mesh& mesh, const VertexMap& map, std::vector<glm::vec3>& normals) {
+        const int numSlots = std::min(map.getNumSlots(), (int)normals.size());
+
+        // Each vertex gets the normal of the last face it's in, so find that face first. Then every normal has the one
+        // face to come from, and they can all be worked out at once.
+        std::vector<const int*> lastFaces(numSlots, nullptr);
+        forEachFace(mesh, "calculateNormals", [&](const int* face, int numVertices) {
+            for (int i = 0; i < numVertices; i++) {
+                if (!map.hasSlot(face[i]) || map.getLookup(face[i]) >= numSlots) {
+                    // Face is not in the mesh (can occur with blendshape meshes, which are a subset of the hfm Mesh vertices)
+                    return;
+                }
             }
-            if ((part.triangleIndices.size() % 3) != 0) {
-                HIFI_FCDEBUG_ID(model_baker(), repeatMessageID, "Error in baker::calculateTangents: part.triangleIndices.size() is not divisible by three");
+            for (int i = 0; i < numVertices; i++) {
+                lastFaces[map.getLookup(face[i])] = face;
             }
-        }
+        });
+
+        tbb::parallel_for(tbb::blocked_range<int>(0, numSlots, MIN_VERTICES_PER_TASK), [&](const tbb::blocked_range<int>& range) {
+            for (int i = range.begin(); i != range.end(); ++i) {
+                const int* face = lastFaces[i];
+                if (face) {
+                    // Assume all vertices in a quad are in the same plane, so only the first three are needed to calculate the normal
+                    glm::vec3 vertex = map.getPosition(face[0]);
+                    normals[i] = glm::cross(map.getPosition(face[1]) - vertex, map.getPosition(face[2]) - vertex);
+                }
+            }
+        });
     }
-}
 
+    void calculateTangents(const hfm::Mesh& mesh, const VertexMap& map, const std::vector<glm::vec3>& normals,
+                           std::vector<glm::vec3>& tangents) {
+        const int numSlots = std::min(map.getNumSlots(), (int)tangents.size());
+
+        // Sort the edges by the vertex they start at, keeping the order they come in, so that each tangent is added up
+        // on its own, in the same order as if they were added up one edge after the other
+        std::vector<int> edgeOffsets(numSlots + 1, 0);
+        auto forEachEdge = [&](auto f) {
+            forEachFace(mesh, "calculateTangents", [&](const int* face, int numVertices) {
+                for (int i = 0; i < numVertices; i++) {
+                    int firstIndex = face[i];
+                    if (map.hasSlot(firstIndex) && map.getLookup(firstIndex) < numSlots) {
+                        f(map.getLookup(firstIndex), firstIndex, face[(i + 1) % numVertices]);
+                    }
+                }
+            });
+        };
+        forEachEdge([&](int slot, int firstIndex, int secondIndex) {
+            edgeOffsets[slot + 1]++;
+        });
+        std::partial_sum(edgeOffsets.begin(), edgeOffsets.end(), edgeOffsets.begin());
+
+        std::vector<glm::ivec2> edges(edgeOffsets[numSlots]);
+        std::vector<int> nextEdges(edgeOffsets.begin(), edgeOffsets.end() - 1);
+        forEachEdge([&](int slot, int firstIndex, int secondIndex) {
+            edges[nextEdges[slot]++] = glm::ivec2(firstIndex, secondIndex);
+        });
+
+        tbb::parallel_for(tbb::blocked_range<int>(0, numSlots, MIN_VERTICES_PER_TASK), [&](const tbb::blocked_range<int>& range) {
+            for (int i = range.begin(); i != range.end(); ++i) {
+                glm::vec3 tangent;
+                for (int j = edgeOffsets[i]; j < edgeOffsets[i + 1]; j++) {
+                    if (calculateTangent(mesh, map, normals, edges[j].x, edges[j].y, tangent)) {
+                        tangents[i] += tangent;
+                    }
+                }
+            }
+        });
+    }
+}
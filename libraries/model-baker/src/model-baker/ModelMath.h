@@ -36,21 +36,43 @@ namespace baker {
         }
     }
 
-    // Returns a reference to the normal at the specified index, or nullptr if it cannot be accessed
-    using NormalAccessor = std::function<glm::vec3*(int index)>;
+    // Which of a mesh's vertices get a normal and a tangent, where in the normals and tangents they go, and where the
+    // vertices are. For a mesh, that's all of its vertices, in order. A blendshape moves some of them, and keeps their
+    // normals and tangents in its own order, ahead of the ones for the vertices it leaves where they are.
+    class VertexMap {
+    public:
+        VertexMap(const hfm::Mesh& mesh);
+        VertexMap(const hfm::Mesh& mesh, const hfm::Blendshape& blendshape);
 
-    // Assigns a vertex to outVertex given the lookup index
-    using VertexSetter = std::function<void(int index, glm::vec3& outVertex)>;
+        int getNumSlots() const { return _numSlots; }
 
-    void calculateNormals(const hfm::Mesh& mesh, NormalAccessor normalAccessor, VertexSetter vertexAccessor);
+        // the index of the vertex's normal and tangent
+        int getLookup(int vertex) const { return (vertex >= 0 && vertex < (int)_lookup.size()) ? _lookup[vertex] : vertex; }
 
-    // firstIndex, secondIndex: the vertex indices to be used for calculation
-    // outVertices: should be assigned a 2 element array containing the vertices at firstIndex and secondIndex
-    // outTexCoords: same as outVertices but for texture coordinates
-    // outNormal: reference to the normal of this triangle
-    //
-    // Return value: pointer to the tangent you want to be calculated
-    using IndexAccessor = std::function<glm::vec3*(int firstIndex, int secondIndex, glm::vec3* outVertices, glm::vec2* outTexCoords, glm::vec3& outNormal)>;
+        // whether the vertex gets a normal and a tangent
+        bool hasSlot(int vertex) const {
+            int lookup = getLookup(vertex);
+            return lookup >= 0 && lookup < _numSlots;
+        }
+
+        glm::vec3 getPosition(int vertex) const {
+            int lookup = getLookup(vertex);
+            return (lookup >= 0 && lookup < _movedVertices.size()) ? _movedVertices[lookup] : safeGet(_vertices, lookup);
+        }
+
+    private:
+        QVector<glm::vec3> _vertices;
+        QVector<glm::vec3> _movedVertices;
+        std::vector<int> _lookup;
+        int _numSlots;
+    };
+
+    // Sets the normal of each vertex in the map to that of the last face it is in, for faces whose vertices are all in
+    // the map. normals is indexed by lookup.
+    void calculateNormals(const hfm::Mesh& mesh, const VertexMap& map, std::vector<glm::vec3>& normals);
 
-    void calculateTangents(const hfm::Mesh& mesh, IndexAccessor accessor);
+    // Adds the tangent of each edge of the mesh's faces to the tangent of the vertex the edge starts at, for vertices in
+    // the map. normals and tangents are indexed by lookup, and the mesh's texture coordinates are too.
+    void calculateTangents(const hfm::Mesh& mesh, const VertexMap& map, const std::vector<glm::vec3>& normals,
+                           std::vector<glm::vec3>& tangents);
 };
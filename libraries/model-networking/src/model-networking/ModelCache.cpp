@@ -176,7 +176,9 @@ void GeometryReader::run() {
         }
 
         // Do processing on the model
+        // the baking jobs only share their inputs and outputs, so the independent ones can run side by side
         baker::Baker modelBaker(hfmModel, _mapping.second, _mapping.first);
+        modelBaker.getConfiguration()->setParallel(true);
         modelBaker.run();
 
         auto processedHFMModel = modelBaker.getHFMModel();
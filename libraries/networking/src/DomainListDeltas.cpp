@@ -0,0 +1,60 @@
+//
+//  DomainListDeltas.cpp
+//  libraries/networking/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "DomainListDeltas.h"
+
+DomainListDeltas::Version DomainListDeltas::addNode(const QUuid& nodeID, NodeType_t nodeType) {
+    ++_version;
+
+    auto it = _pendingAdditions.find(nodeID);
+    if (it != _pendingAdditions.end()) {
+        // already on its way, just make sure nodes sent a list since then hear about it again
+        _pendingChanges[it.value()].version = _version;
+        return _version;
+    }
+
+    _pendingAdditions.insert(nodeID, _pendingChanges.size());
+    _pendingChanges.push_back({ _version, nodeID, nodeType, false });
+    _numPendingChanges++;
+    return _version;
+}
+
+DomainListDeltas::Version DomainListDeltas::removeNode(const QUuid& nodeID, NodeType_t nodeType) {
+    ++_version;
+
+    auto it = _pendingAdditions.find(nodeID);
+    if (it != _pendingAdditions.end()) {
+        // nobody needs to hear about a node that is already gone, but anyone sent a full list since still needs the removal
+        _pendingChanges[it.value()].version = NO_VERSION;
+        _pendingAdditions.erase(it);
+        _numPendingChanges--;
+    }
+
+    _pendingChanges.push_back({ _version, nodeID, nodeType, true });
+    _numPendingChanges++;
+    return _version;
+}
+
+DomainListDeltas::Batch DomainListDeltas::takePendingChanges() {
+    Batch batch;
+    batch._changes.reserve(_numPendingChanges);
+    for (const auto& change : _pendingChanges) {
+        if (change.version != NO_VERSION) {
+            batch._changesByType[change.nodeType].push_back(batch._changes.size());
+            batch._changes.push_back(change);
+        }
+    }
+
+    _pendingChanges.clear();
+    _pendingAdditions.clear();
+    _numPendingChanges = 0;
+    return batch;
+}
@@ -0,0 +1,91 @@
+//
+//  DomainListDeltas.h
+//  libraries/networking/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_DomainListDeltas_h
+#define hifi_DomainListDeltas_h
+
+#include <vector>
+
+#include <QtCore/QHash>
+#include <QtCore/QUuid>
+
+#include "NodeType.h"
+
+// DomainListDeltas keeps the domain list versioned for the domain-server.  Every node added to or removed from
+// the domain bumps the version and is queued as a change; the pending changes are taken as one batch every few
+// milliseconds and fanned out to the nodes interested in them.  A node that was sent a full domain list at some
+// version only needs the changes after it, so a batch can be filtered per node.
+//
+// Changes to the same node within one batch are coalesced: re-adding a node keeps one addition (with the latest
+// version), and removing a node drops its pending addition.
+class DomainListDeltas {
+public:
+    using Version = quint64;
+    static const Version NO_VERSION = 0;
+
+    struct Change {
+        Version version;
+        QUuid nodeID;
+        NodeType_t nodeType;
+        bool isRemoval;
+    };
+
+    class Batch {
+    public:
+        bool isEmpty() const { return _changes.empty(); }
+        const std::vector<Change>& getChanges() const { return _changes; }
+
+        // Calls f(const Change&) for each change a node is interested in: the changes to nodes of a type in its
+        // interest set, made after the version of the domain list it was last sent, and not about itself.
+        // The changes to any one node are visited in the order they were made.
+        template <typename F>
+        void forEachChangeFor(const QUuid& nodeID, const NodeSet& interestSet, Version sinceVersion, F&& f) const {
+            for (NodeType_t nodeType : interestSet) {
+                auto it = _changesByType.find(nodeType);
+                if (it == _changesByType.end()) {
+                    continue;
+                }
+                for (size_t index : it.value()) {
+                    const Change& change = _changes[index];
+                    if (change.version > sinceVersion && change.nodeID != nodeID) {
+                        f(change);
+                    }
+                }
+            }
+        }
+
+    private:
+        friend class DomainListDeltas;
+
+        std::vector<Change> _changes;
+        QHash<NodeType_t, std::vector<size_t>> _changesByType;
+    };
+
+    Version getVersion() const { return _version; }
+
+    bool hasPendingChanges() const { return _numPendingChanges > 0; }
+    size_t getNumPendingChanges() const { return _numPendingChanges; }
+
+    Version addNode(const QUuid& nodeID, NodeType_t nodeType);
+    Version removeNode(const QUuid& nodeID, NodeType_t nodeType);
+
+    Batch takePendingChanges();
+
+private:
+    Version _version { NO_VERSION };
+
+    // coalesced changes are left in place with a NO_VERSION version and skipped when the batch is taken
+    std::vector<Change> _pendingChanges;
+    QHash<QUuid, size_t> _pendingAdditions;
+    size_t _numPendingChanges { 0 };
+};
+
+#endif // hifi_DomainListDeltas_h
@@ -167,6 +167,9 @@ public:
     static std::unique_ptr<NLPacketList> encodeMessagesPacket(QString channel, QString message, QUuid senderID);
     static std::unique_ptr<NLPacketList> encodeMessagesDataPacket(QString channel, QByteArray data, QUuid senderID);
 
+    // the payload of a MessagesData packet, for senders passing the same message on to many nodes
+    static QByteArray encodeMessagesPayload(const QString& channel, bool isText, const QByteArray& messageData, QUuid senderID);
+
 signals:
     /**jsdoc
      * Triggered when a text message is received.
@@ -800,16 +800,20 @@ void NodeList::processDomainServerAddedNode(QSharedPointer<ReceivedMessage> mess
     // setup a QDataStream
     QDataStream packetStream(message->getMessage());
 
-    // use our shared method to pull out the new node
-    parseNodeFromPacketStream(packetStream);
+    // the domain-server batches the nodes added over a short window, use our shared method to pull out each one
+    while (packetStream.device()->pos() < message->getSize()) {
+        parseNodeFromPacketStream(packetStream);
+    }
 }
 
 void NodeList::processDomainServerRemovedNode(QSharedPointer<ReceivedMessage> message) {
-    // read the UUID from the packet, remove it if it exists
-    QUuid nodeUUID = QUuid::fromRfc4122(message->readWithoutCopy(NUM_BYTES_RFC4122_UUID));
-    qCDebug(networking) << "Received packet from domain-server to remove node with UUID" << uuidStringWithoutCurlyBraces(nodeUUID);
-    killNodeWithUUID(nodeUUID);
-    removeDelayedAdd(nodeUUID);
+    // read each UUID from the packet, remove them if they exist
+    while (message->getBytesLeftToRead() >= NUM_BYTES_RFC4122_UUID) {
+        QUuid nodeUUID = QUuid::fromRfc4122(message->readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+        qCDebug(networking) << "Received packet from domain-server to remove node with UUID" << uuidStringWithoutCurlyBraces(nodeUUID);
+        killNodeWithUUID(nodeUUID);
+        removeDelayedAdd(nodeUUID);
+    }
 }
 
 void NodeList::parseNodeFromPacketStream(QDataStream& packetStream) {
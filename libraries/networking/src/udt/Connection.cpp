@@ -68,6 +68,15 @@ Connection::~Connection() {
 
 void Connection::stopSendQueue() {
     if (auto sendQueue = _sendQueue.release()) {
+        if (sendQueue->isOnSharedSenderThread()) {
+            // the sender thread carries on with other queues, once this one is off it we can delete it right here
+            sendQueue->stop();
+            sendQueue->detachFromSenderThread();
+            _lastMessageNumber = sendQueue->getCurrentMessageNumber();
+            delete sendQueue;
+            return;
+        }
+
         // grab the send queue thread so we can wait on it
         QThread* sendQueueThread = sendQueue->thread();
         
@@ -85,6 +94,24 @@ void Connection::stopSendQueue() {
     }
 }
 
+ConnectionStats::Stats Connection::sampleStats() {
+    auto stats = _stats.sample();
+
+    // the sending threads are shared by the whole process, report what they did since this connection last looked
+    stats.senderThreads = SendQueue::getNumSenderThreads();
+    auto numSenderWakeups = SendQueue::getNumSenderWakeups();
+    auto sampleDuration = (stats.endTime - stats.startTime).count();
+    if (sampleDuration > 0) {
+        stats.senderWakeupsPerSecond = (int)((numSenderWakeups - _lastSampledSenderWakeups) * USECS_PER_SECOND / (quint64)sampleDuration);
+    }
+    _lastSampledSenderWakeups = numSenderWakeups;
+
+    if (_sendQueue) {
+        stats.sendJitter = _sendQueue->sampleSendJitter();
+    }
+    return stats;
+}
+
 void Connection::setMaxBandwidth(int maxBandwidth) {
     _congestionControl->setMaxBandwidth(maxBandwidth);
 }
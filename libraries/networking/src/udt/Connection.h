@@ -66,7 +66,7 @@ public:
 
     void queueReceivedMessagePacket(std::unique_ptr<Packet> packet);
     
-    ConnectionStats::Stats sampleStats() { return _stats.sample(); }
+    ConnectionStats::Stats sampleStats();
 
     HifiSockAddr getDestination() const { return _destination; }
 
@@ -137,6 +137,7 @@ private:
     ControlPacketPointer _handshakeACK;
 
     ConnectionStats _stats;
+    uint64_t _lastSampledSenderWakeups { SendQueue::getNumSenderWakeups() };
 };
     
 }
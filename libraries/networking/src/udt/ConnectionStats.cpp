@@ -106,6 +106,9 @@ QDebug& operator<<(QDebug&& debug, const udt::ConnectionStats::Stats& stats) {
     debug << "\n     Duplicate packets: " << stats.duplicatePackets;
     debug << "\n     Sent util bytes: " << stats.sentUtilBytes;
     debug << "\n     Sent bytes: " << stats.sentBytes;
-    debug << "\n     Received bytes: " << stats.receivedBytes << "\n";
+    debug << "\n     Received bytes: " << stats.receivedBytes;
+    debug << "\n     Sender threads: " << stats.senderThreads;
+    debug << "\n     Sender wakeups per second: " << stats.senderWakeupsPerSecond;
+    debug << "\n     Send jitter (us): " << stats.sendJitter << "\n";
     return debug;
 }
@@ -68,6 +68,12 @@ public:
         int rtt { 0 };
         int congestionWindowSize { 0 };
         int packetSendPeriod { 0 };
+
+        // the sending threads of the whole process: how many there are, how often they wake up,
+        // and how late this connection's paced packets went out on average (in microseconds)
+        int senderThreads { 0 };
+        int senderWakeupsPerSecond { 0 };
+        int sendJitter { 0 };
         
         // TODO: Remove once Win build supports brace initialization: `Events events {{ 0 }};`
         Stats() { events.fill(0); }
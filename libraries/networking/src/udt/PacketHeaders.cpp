@@ -75,7 +75,9 @@ PacketVersion versionForPacketType(PacketType packetType) {
             return static_cast<PacketVersion>(DomainConnectRequestVersion::HasCompressedSystemInfo);
 
         case PacketType::DomainServerAddedNode:
-            return static_cast<PacketVersion>(DomainServerAddedNodeVersion::PermissionsGrid);
+            return static_cast<PacketVersion>(DomainServerAddedNodeVersion::MultipleNodes);
+        case PacketType::DomainServerRemovedNode:
+            return static_cast<PacketVersion>(DomainServerRemovedNodeVersion::MultipleNodes);
 
         case PacketType::EntityScriptCallMethod:
             return static_cast<PacketVersion>(EntityScriptCallMethodVersion::ClientCallable);
@@ -97,8 +99,9 @@ PacketVersion versionForPacketType(PacketType packetType) {
         case PacketType::EntityQueryInitialResultsComplete:
             return static_cast<PacketVersion>(EntityVersion::ParticleSpin);
         case PacketType::BulkAvatarTraitsAck:
+            return static_cast<PacketVersion>(AvatarMixerPacketVersion::AvatarTraitsResendRequests);
         case PacketType::BulkAvatarTraits:
-            return static_cast<PacketVersion>(AvatarMixerPacketVersion::AvatarTraitsAck);
+            return static_cast<PacketVersion>(AvatarMixerPacketVersion::AvatarTraitDeltas);
         default:
             return 22;
     }
@@ -136,6 +136,7 @@ public:
         BulkAvatarTraitsAck,
         StopInjector,
         AvatarZonePresence,
+        EntityCompressionDictionary,
         NUM_PACKET_TYPE
     };
 
@@ -284,6 +285,9 @@ enum class EntityVersion : PacketVersion {
     CloneGrabbable, // maki
     RemovedCustomTags, // maki
     SkeletonModelURLInIdentityPacket, // maki
+    PolyVoxBricks,
+    CompressedEntityEdits,
+    PolyVoxBrickVersions,
     // TO DO - reinstate with tonemapping in zones
     // ToneMappingMode, // caitlyn
     
@@ -351,7 +355,9 @@ enum class AvatarMixerPacketVersion : PacketVersion {
     FBXJointOrderChange,
     HandControllerSection,
     SendVerificationFailed,
-    ARKitBlendshapes
+    ARKitBlendshapes,
+    AvatarTraitDeltas,
+    AvatarTraitsResendRequests
 };
 
 enum class DomainConnectRequestVersion : PacketVersion {
@@ -375,7 +381,13 @@ enum class DomainConnectionDeniedVersion : PacketVersion {
 
 enum class DomainServerAddedNodeVersion : PacketVersion {
     PrePermissionsGrid = 17,
-    PermissionsGrid
+    PermissionsGrid,
+    MultipleNodes
+};
+
+enum class DomainServerRemovedNodeVersion : PacketVersion {
+    PreMultipleNodes = 22,
+    MultipleNodes
 };
 
 enum class DomainListVersion : PacketVersion {
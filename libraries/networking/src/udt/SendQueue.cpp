@@ -28,6 +28,7 @@
 #include "Packet.h"
 #include "PacketList.h"
 #include "../UserActivityLogger.h"
+#include "SendQueueScheduler.h"
 #include "Socket.h"
 #include <Trace.h>
 #include <Profile.h>
@@ -63,6 +64,17 @@ private:
 
 const microseconds SendQueue::MAXIMUM_ESTIMATED_TIMEOUT = seconds(5);
 const microseconds SendQueue::MINIMUM_ESTIMATED_TIMEOUT = milliseconds(10);
+const p_high_resolution_clock::time_point SendQueue::NEVER = p_high_resolution_clock::time_point::max();
+
+static const auto HANDSHAKE_RESEND_INTERVAL = std::chrono::milliseconds(100);
+static const auto EMPTY_QUEUES_INACTIVE_TIMEOUT = std::chrono::seconds(5);
+
+// a queue on a shared thread sends at most this many packets per pass, so that one busy queue can't hold up
+// the others, and catches up on at most that many send periods after being late
+static const int MAX_PACKETS_PER_PASS = 16;
+
+static std::atomic<int> numDedicatedSenderThreads { 0 };
+static std::atomic<uint64_t> numDedicatedSenderWakeups { 0 };
 
 std::unique_ptr<SendQueue> SendQueue::create(Socket* socket, HifiSockAddr destination, SequenceNumber currentSequenceNumber,
                                              MessageNumber currentMessageNumber, bool hasReceivedHandshakeACK) {
@@ -71,11 +83,19 @@ std::unique_ptr<SendQueue> SendQueue::create(Socket* socket, HifiSockAddr destin
     auto queue = std::unique_ptr<SendQueue>(new SendQueue(socket, destination, currentSequenceNumber,
                                                           currentMessageNumber, hasReceivedHandshakeACK));
 
+    if (auto scheduler = SendQueueScheduler::getInstance()) {
+        // no thread of our own, one of the shared sender threads takes it from here
+        queue->_senderThread = scheduler->add(queue.get());
+        return queue;
+    }
+
     // Setup queue private thread
     QThread* thread = new QThread;
     thread->setObjectName("Networking: SendQueue " + destination.objectName()); // Name thread for easier debug
     
     connect(thread, &QThread::started, queue.get(), &SendQueue::run);
+    connect(thread, &QThread::started, [] { numDedicatedSenderThreads++; });
+    connect(thread, &QThread::finished, [] { numDedicatedSenderThreads--; });
     
     connect(queue.get(), &QObject::destroyed, thread, &QThread::quit); // Thread auto cleanup
     connect(thread, &QThread::finished, thread, &QThread::deleteLater); // Thread auto cleanup
@@ -108,10 +128,10 @@ SendQueue::~SendQueue() {
 void SendQueue::queuePacket(std::unique_ptr<Packet> packet) {
     _packets.queuePacket(std::move(packet));
     
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for packets
-    _emptyCondition.notify_one();
+    // wake the send thread in case it is sleeping waiting for packets
+    wake();
     
-    if (!thread()->isRunning() && _state == State::NotStarted) {
+    if (!_senderThread && !thread()->isRunning() && _state == State::NotStarted) {
         thread()->start();
     }
 }
@@ -119,10 +139,10 @@ void SendQueue::queuePacket(std::unique_ptr<Packet> packet) {
 void SendQueue::queuePacketList(std::unique_ptr<PacketList> packetList) {
     _packets.queuePacketList(std::move(packetList));
     
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for packets
-    _emptyCondition.notify_one();
+    // wake the send thread in case it is sleeping waiting for packets
+    wake();
     
-    if (!thread()->isRunning() && _state == State::NotStarted) {
+    if (!_senderThread && !thread()->isRunning() && _state == State::NotStarted) {
         thread()->start();
     }
 }
@@ -133,7 +153,23 @@ void SendQueue::stop() {
     
     // Notify all conditions in case we're waiting somewhere
     _handshakeACKCondition.notify_one();
-    _emptyCondition.notify_one();
+    wake();
+}
+
+void SendQueue::detachFromSenderThread() {
+    if (_senderThread) {
+        _senderThread->remove(this);
+        _senderThread = nullptr;
+    }
+}
+
+void SendQueue::wake() {
+    if (_senderThread) {
+        _senderThread->wake(this);
+    } else {
+        // call notify_one on the condition_variable_any in case the send thread is sleeping
+        _emptyCondition.notify_one();
+    }
 }
     
 int SendQueue::sendPacket(const Packet& packet) {
@@ -164,8 +200,8 @@ void SendQueue::ack(SequenceNumber ack) {
     
     _lastACKSequenceNumber = (uint32_t) ack;
 
-    // call notify_one on the condition_variable_any in case the send thread is sleeping with a full congestion window
-    _emptyCondition.notify_one();
+    // wake the send thread in case it is sleeping with a full congestion window
+    wake();
 }
 
 void SendQueue::fastRetransmit(udt::SequenceNumber ack) {
@@ -174,27 +210,30 @@ void SendQueue::fastRetransmit(udt::SequenceNumber ack) {
         _naks.insert(ack, ack);
     }
 
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for losses to re-send
-    _emptyCondition.notify_one();
+    // wake the send thread in case it is sleeping waiting for losses to re-send
+    wake();
 }
 
 void SendQueue::sendHandshake() {
     std::unique_lock<std::mutex> handshakeLock { _handshakeMutex };
     if (!_hasReceivedHandshakeACK) {
         // we haven't received a handshake ACK from the client, send another now
-        // if the handshake hasn't been completed, then the initial sequence number
-        // should be the current sequence number + 1
-        SequenceNumber initialSequenceNumber = _currentSequenceNumber + 1;
-        auto handshakePacket = ControlPacket::create(ControlPacket::Handshake, sizeof(SequenceNumber));
-        handshakePacket->writePrimitive(initialSequenceNumber);
-        _socket->writeBasePacket(*handshakePacket, _destination);
+        writeHandshake();
         
         // we wait for the ACK or the re-send interval to expire
-        static const auto HANDSHAKE_RESEND_INTERVAL = std::chrono::milliseconds(100);
         _handshakeACKCondition.wait_for(handshakeLock, HANDSHAKE_RESEND_INTERVAL);
     }
 }
 
+void SendQueue::writeHandshake() {
+    // if the handshake hasn't been completed, then the initial sequence number
+    // should be the current sequence number + 1
+    SequenceNumber initialSequenceNumber = _currentSequenceNumber + 1;
+    auto handshakePacket = ControlPacket::create(ControlPacket::Handshake, sizeof(SequenceNumber));
+    handshakePacket->writePrimitive(initialSequenceNumber);
+    _socket->writeBasePacket(*handshakePacket, _destination);
+}
+
 void SendQueue::handshakeACK() {
     {
         std::lock_guard<std::mutex> locker { _handshakeMutex };
@@ -203,6 +242,9 @@ void SendQueue::handshakeACK() {
 
     // Notify on the handshake ACK condition
     _handshakeACKCondition.notify_one();
+    if (_senderThread) {
+        wake();
+    }
 }
 
 SequenceNumber SendQueue::getNextSequenceNumber() {
@@ -266,6 +308,7 @@ void SendQueue::run() {
     // Wait for handshake to be complete
     while (_state == State::Running && !_hasReceivedHandshakeACK) {
         sendHandshake();
+        numDedicatedSenderWakeups++;
 
         // Keep processing events
         QCoreApplication::sendPostedEvents(this);
@@ -278,6 +321,8 @@ void SendQueue::run() {
     auto nextPacketTimestamp = p_high_resolution_clock::now();
 
     while (_state == State::Running) {
+        numDedicatedSenderWakeups++;
+
         bool attemptedToSendPacket = maybeResendPacket();
         
         // if we didn't find a packet to re-send AND we think we can fit a new packet on the wire
@@ -351,8 +396,163 @@ void SendQueue::run() {
             }
             
             std::this_thread::sleep_for(timeToSleep);
+
+            auto lateness = p_high_resolution_clock::now() - nextPacketTimestamp;
+            if (lateness.count() > 0) {
+                recordSendJitter(lateness);
+            }
+        }
+    }
+}
+
+p_high_resolution_clock::time_point SendQueue::runOnce(p_high_resolution_clock::time_point now) {
+    // deliver anything queued for us (destination changes) before sending, as run() does between packets
+    QCoreApplication::sendPostedEvents(this);
+
+    if (_state == State::Stopped) {
+        return NEVER;
+    } else if (_state == State::NotStarted) {
+        _state = State::Running;
+        _nextPacketTimestamp = now;
+    }
+
+    if (!_hasReceivedHandshakeACK) {
+        // keep re-sending the handshake until handshakeACK() wakes us up
+        if (now >= _nextHandshakeAt) {
+            writeHandshake();
+            _nextHandshakeAt = now + HANDSHAKE_RESEND_INTERVAL;
         }
+        return _nextHandshakeAt;
     }
+
+    auto packetSendPeriod = std::chrono::microseconds(_packetSendPeriod);
+    bool isPaced = packetSendPeriod.count() > 0;
+
+    if (isPaced) {
+        if (now < _nextPacketTimestamp) {
+            // woken up early, by new packets or an ACK, the next send isn't due yet
+            _isWaitingOnPacing = true;
+            return _nextPacketTimestamp;
+        }
+
+        if (_isWaitingOnPacing) {
+            _isWaitingOnPacing = false;
+            recordSendJitter(now - _nextPacketTimestamp);
+        }
+
+        if (now - _nextPacketTimestamp > MAX_PACKETS_PER_PASS * packetSendPeriod) {
+            // don't make up for the time spent idle with a burst
+            _nextPacketTimestamp = now;
+        }
+    }
+
+    int numPacketsSent = 0;
+    while (numPacketsSent < MAX_PACKETS_PER_PASS && (!isPaced || _nextPacketTimestamp <= now)) {
+        bool attemptedToSendPacket = maybeResendPacket() || maybeSendNewPacket() > 0;
+        if (!attemptedToSendPacket) {
+            break;
+        }
+
+        numPacketsSent++;
+        if (isPaced) {
+            _nextPacketTimestamp += packetSendPeriod;
+        }
+    }
+
+    if (numPacketsSent > 0) {
+        _isIdle = false;
+        if (isPaced && _nextPacketTimestamp > now) {
+            _isWaitingOnPacing = true;
+            return _nextPacketTimestamp;
+        }
+        return now;
+    }
+
+    return checkInactive(now);
+}
+
+p_high_resolution_clock::time_point SendQueue::checkInactive(p_high_resolution_clock::time_point now) {
+    // the non-blocking version of isInactive(): instead of waiting on _emptyCondition,
+    // return when to look again, the sender thread runs us earlier if we're woken up
+    using DoubleLock = DoubleLock<std::recursive_mutex, std::mutex>;
+    DoubleLock doubleLock(_packets.getLock(), _naksLock);
+    DoubleLock::Lock locker(doubleLock, std::try_to_lock);
+
+    if (!locker.owns_lock()) {
+        // someone is queueing packets or losses right now, look again in a moment
+        return now + std::chrono::milliseconds(1);
+    }
+
+    if (!((_packets.isEmpty() || isFlowWindowFull()) && _naks.isEmpty())) {
+        // something came in since we last looked
+        return now;
+    }
+
+    if (!_isIdle) {
+        _isIdle = true;
+        _idleSince = now;
+    }
+
+    if (uint32_t(_lastACKSequenceNumber) == uint32_t(_currentSequenceNumber)) {
+        // we've sent the client as much data as we have (and they've ACKed it)
+        // either wait for new data to send or 5 seconds before cleaning up the queue
+        if (now - _idleSince < EMPTY_QUEUES_INACTIVE_TIMEOUT) {
+            return _idleSince + EMPTY_QUEUES_INACTIVE_TIMEOUT;
+        }
+
+        locker.unlock();
+        deactivate();
+        return NEVER;
+    }
+
+    // We think the client is still waiting for data (based on the sequence number gap)
+    // Let's wait either for a response from the client or until the estimated timeout has elapsed
+    auto estimatedTimeout = std::chrono::microseconds(_estimatedTimeout);
+    estimatedTimeout = std::min(MAXIMUM_ESTIMATED_TIMEOUT, std::max(MINIMUM_ESTIMATED_TIMEOUT, estimatedTimeout));
+
+    auto timeSinceLastSend = std::chrono::high_resolution_clock::now() - _lastPacketSentAt;
+    if (now - _idleSince < estimatedTimeout && timeSinceLastSend <= estimatedTimeout) {
+        return _idleSince + estimatedTimeout;
+    }
+
+    // after a timeout if we still have sent packets that the client hasn't ACKed we
+    // add them to the loss list and go back to sending
+    _naks.append(SequenceNumber(_lastACKSequenceNumber) + 1, _currentSequenceNumber);
+    locker.unlock();
+
+    emit timeout();
+
+    _isIdle = false;
+    return now;
+}
+
+void SendQueue::recordSendJitter(p_high_resolution_clock::duration lateness) {
+    _sendJitterTotal += duration_cast<microseconds>(lateness).count();
+    _numSendJitterSamples++;
+}
+
+int SendQueue::sampleSendJitter() {
+    uint64_t total = _sendJitterTotal.exchange(0);
+    uint32_t numSamples = _numSendJitterSamples.exchange(0);
+    return numSamples > 0 ? (int)(total / numSamples) : 0;
+}
+
+void SendQueue::setNumSharedSenderThreads(int numThreads) {
+    SendQueueScheduler::setNumThreads(numThreads);
+}
+
+int SendQueue::getNumSharedSenderThreads() {
+    return SendQueueScheduler::getNumThreads();
+}
+
+int SendQueue::getNumSenderThreads() {
+    auto scheduler = SendQueueScheduler::getInstance();
+    return numDedicatedSenderThreads + (scheduler ? scheduler->getNumRunningThreads() : 0);
+}
+
+uint64_t SendQueue::getNumSenderWakeups() {
+    auto scheduler = SendQueueScheduler::getInstance();
+    return numDedicatedSenderWakeups + (scheduler ? scheduler->getNumWakeups() : 0);
 }
 
 int SendQueue::maybeSendNewPacket() {
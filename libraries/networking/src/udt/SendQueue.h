@@ -38,6 +38,7 @@ class BasePacket;
 class ControlPacket;
 class Packet;
 class PacketList;
+class SenderThread;
 class Socket;
     
 class SendQueue : public QObject {
@@ -68,7 +69,22 @@ public:
     void setPacketSendPeriod(int newPeriod) { _packetSendPeriod = newPeriod; }
     
     void setEstimatedTimeout(int estimatedTimeout) { _estimatedTimeout = estimatedTimeout; }
+
+    // average lateness of paced sends since the last call, in microseconds
+    int sampleSendJitter();
+
+    // With zero shared sender threads (the default, or HIFI_UDT_SENDER_THREADS in the environment) every queue
+    // runs on a thread of its own. Otherwise queues created from then on are all paced by that many threads.
+    static void setNumSharedSenderThreads(int numThreads);
+    static int getNumSharedSenderThreads();
+
+    static int getNumSenderThreads(); // threads currently sending for this process, in either mode
+    static uint64_t getNumSenderWakeups(); // times those threads woke up so far
     
+    bool isOnSharedSenderThread() const { return _senderThread != nullptr; }
+    // takes the queue off its shared sender thread, which won't touch it again, so it can be deleted on this one
+    void detachFromSenderThread();
+
 public slots:
     void stop();
     
@@ -93,8 +109,20 @@ private:
               MessageNumber currentMessageNumber, bool hasReceivedHandshakeACK);
     SendQueue(SendQueue& other) = delete;
     SendQueue(SendQueue&& other) = delete;
-    
+
+    friend class SenderThread;
+
+    // One non-blocking pass of run() for the shared sender threads: sends what pacing allows right now
+    // and returns when the queue next wants to run, or NEVER once it has stopped
+    p_high_resolution_clock::time_point runOnce(p_high_resolution_clock::time_point now);
+    p_high_resolution_clock::time_point checkInactive(p_high_resolution_clock::time_point now);
+    static const p_high_resolution_clock::time_point NEVER;
+
+    void wake(); // lets the sending thread know there may be something new to do
+    void recordSendJitter(p_high_resolution_clock::duration lateness);
+
     void sendHandshake();
+    void writeHandshake();
     
     int sendPacket(const Packet& packet);
     bool sendNewPacketAndAddToSentList(std::unique_ptr<Packet> newPacket, SequenceNumber sequenceNumber);
@@ -142,6 +170,17 @@ private:
 
     std::chrono::high_resolution_clock::time_point _lastPacketSentAt;
 
+    SenderThread* _senderThread { nullptr }; // the shared thread pacing this queue, if any
+    std::atomic<bool> _isWakePending { false };
+    p_high_resolution_clock::time_point _nextPacketTimestamp;
+    p_high_resolution_clock::time_point _nextHandshakeAt;
+    p_high_resolution_clock::time_point _idleSince;
+    bool _isIdle { false };
+    bool _isWaitingOnPacing { false };
+
+    std::atomic<uint64_t> _sendJitterTotal { 0 };
+    std::atomic<uint32_t> _numSendJitterSamples { 0 };
+
     static const std::chrono::microseconds MAXIMUM_ESTIMATED_TIMEOUT;
     static const std::chrono::microseconds MINIMUM_ESTIMATED_TIMEOUT;
 };
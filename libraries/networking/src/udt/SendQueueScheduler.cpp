@@ -0,0 +1,232 @@
+//
+//  SendQueueScheduler.cpp
+//  libraries/networking/src/udt
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SendQueueScheduler.h"
+
+#include <algorithm>
+
+#include <QtCore/QProcessEnvironment>
+
+#include "../NetworkLogging.h"
+#include "SendQueue.h"
+
+using namespace udt;
+using namespace std::chrono;
+
+namespace {
+
+const QString SENDER_THREADS_ENVIRONMENT_VARIABLE = "HIFI_UDT_SENDER_THREADS";
+
+// Pacing resolution of the shared threads. Queues with shorter send periods catch up
+// by sending a few packets per pass, see SendQueue::runOnce
+const uint64_t TICK_USECS = 100;
+
+uint64_t toUsecs(p_high_resolution_clock::time_point timePoint) {
+    return duration_cast<microseconds>(timePoint.time_since_epoch()).count();
+}
+
+std::mutex instanceMutex;
+std::atomic<SendQueueScheduler*> instance { nullptr };
+int numThreads { -1 }; // read from the environment on first use, unless set before that
+
+int getNumThreadsLocked() {
+    if (numThreads < 0) {
+        numThreads = std::max(0, QProcessEnvironment::systemEnvironment().value(SENDER_THREADS_ENVIRONMENT_VARIABLE, "0").toInt());
+    }
+    return numThreads;
+}
+
+}
+
+SenderThread::SenderThread(int index) :
+    _wheel(TICK_USECS, toUsecs(p_high_resolution_clock::now()))
+{
+    setObjectName("Networking: SendQueue sender " + QString::number(index));
+}
+
+void SenderThread::add(SendQueue* queue) {
+    // called from the thread creating the queue, which is the only one allowed to move it
+    queue->moveToThread(this);
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _queues[queue] = Entry();
+        _numQueues++;
+
+        // run it right away, to get the handshake going
+        queue->_isWakePending = true;
+        _wokenQueues.push_back(queue);
+    }
+    _wakeCondition.notify_one();
+}
+
+void SenderThread::remove(SendQueue* queue) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _passCompleteCondition.wait(lock, [&] { return _currentQueue != queue; });
+
+    auto it = _queues.find(queue);
+    if (it == _queues.end()) {
+        return;
+    }
+    if (it->second.timer != Wheel::INVALID_TIMER_ID) {
+        _wheel.cancel(it->second.timer);
+    }
+    _queues.erase(it);
+    _wokenQueues.erase(std::remove(_wokenQueues.begin(), _wokenQueues.end(), queue), _wokenQueues.end());
+    _numQueues--;
+}
+
+void SenderThread::wake(SendQueue* queue) {
+    if (queue->_isWakePending.exchange(true)) {
+        // already on its way
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_queues.find(queue) == _queues.end()) {
+            return;
+        }
+        _wokenQueues.push_back(queue);
+    }
+    _wakeCondition.notify_one();
+}
+
+void SenderThread::scheduleDue(SendQueue* queue) {
+    auto& entry = _queues[queue];
+    if (!entry.isDue) {
+        entry.isDue = true;
+        _dueQueues.push_back(queue);
+    }
+}
+
+void SenderThread::run() {
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    while (true) {
+        _numWakeups++;
+
+        _wheel.advance(toUsecs(p_high_resolution_clock::now()), [&](Wheel::TimerID, SendQueue*&& queue, uint64_t) {
+            auto it = _queues.find(queue);
+            if (it != _queues.end()) {
+                it->second.timer = Wheel::INVALID_TIMER_ID;
+                scheduleDue(queue);
+            }
+        });
+
+        for (auto queue : _wokenQueues) {
+            auto it = _queues.find(queue);
+            if (it != _queues.end()) {
+                if (it->second.timer != Wheel::INVALID_TIMER_ID) {
+                    _wheel.cancel(it->second.timer);
+                    it->second.timer = Wheel::INVALID_TIMER_ID;
+                }
+                scheduleDue(queue);
+            }
+        }
+        _wokenQueues.clear();
+
+        for (auto queue : _dueQueues) {
+            auto it = _queues.find(queue);
+            if (it == _queues.end()) {
+                // removed while an earlier queue was running
+                continue;
+            }
+            it->second.isDue = false;
+
+            // run the queue without the lock, so it can be woken up meanwhile
+            _currentQueue = queue;
+            lock.unlock();
+
+            queue->_isWakePending = false;
+            auto nextRun = queue->runOnce(p_high_resolution_clock::now());
+
+            lock.lock();
+            _currentQueue = nullptr;
+            _passCompleteCondition.notify_all();
+
+            it = _queues.find(queue);
+            if (it != _queues.end() && nextRun != SendQueue::NEVER && it->second.timer == Wheel::INVALID_TIMER_ID) {
+                it->second.timer = _wheel.add(toUsecs(nextRun), queue);
+            }
+        }
+        _dueQueues.clear();
+
+        if (!_wokenQueues.empty()) {
+            continue;
+        }
+
+        uint64_t nextExpiry = _wheel.getNextExpiry();
+        if (nextExpiry == Wheel::NO_EXPIRY) {
+            _wakeCondition.wait(lock);
+        } else {
+            _wakeCondition.wait_until(lock, p_high_resolution_clock::time_point(microseconds(nextExpiry)));
+        }
+    }
+}
+
+SendQueueScheduler* SendQueueScheduler::getInstance() {
+    auto scheduler = instance.load();
+    if (scheduler) {
+        return scheduler;
+    }
+
+    std::lock_guard<std::mutex> lock(instanceMutex);
+    if (!instance && getNumThreadsLocked() > 0) {
+        // deliberately leaked, with its threads: they sleep once the last connection is gone
+        instance = new SendQueueScheduler(numThreads);
+    }
+    return instance;
+}
+
+void SendQueueScheduler::setNumThreads(int newNumThreads) {
+    std::lock_guard<std::mutex> lock(instanceMutex);
+    if (instance) {
+        qCWarning(networking) << "SendQueueScheduler is already running with" << numThreads << "threads, ignoring"
+            << newNumThreads;
+        return;
+    }
+    numThreads = std::max(0, newNumThreads);
+}
+
+int SendQueueScheduler::getNumThreads() {
+    std::lock_guard<std::mutex> lock(instanceMutex);
+    return getNumThreadsLocked();
+}
+
+SendQueueScheduler::SendQueueScheduler(int numThreads) {
+    qCDebug(networking) << "Sending on" << numThreads << "shared SendQueue threads";
+    for (int i = 0; i < numThreads; i++) {
+        _threads.emplace_back(new SenderThread(i));
+        _threads.back()->start();
+    }
+}
+
+SenderThread* SendQueueScheduler::add(SendQueue* queue) {
+    auto thread = std::min_element(_threads.begin(), _threads.end(), [](const std::unique_ptr<SenderThread>& a,
+                                                                       const std::unique_ptr<SenderThread>& b) {
+        return a->getNumQueues() < b->getNumQueues();
+    })->get();
+    thread->add(queue);
+    return thread;
+}
+
+int SendQueueScheduler::getNumRunningThreads() const {
+    return (int)_threads.size();
+}
+
+uint64_t SendQueueScheduler::getNumWakeups() const {
+    uint64_t numWakeups = 0;
+    for (auto& thread : _threads) {
+        numWakeups += thread->getNumWakeups();
+    }
+    return numWakeups;
+}
@@ -0,0 +1,97 @@
+//
+//  SendQueueScheduler.h
+//  libraries/networking/src/udt
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SendQueueScheduler_h
+#define hifi_SendQueueScheduler_h
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <QtCore/QThread>
+
+#include <PortableHighResolutionClock.h>
+#include <TimerWheel.h>
+
+namespace udt {
+
+class SendQueue;
+
+// One of the shared sender threads. It keeps its queues in a TimerWheel, keyed on when each next wants to run
+// (its next paced send, handshake re-send or timeout check), and sleeps until the earliest of them or until
+// one of its queues is woken up by new packets, ACKs or losses.
+class SenderThread : public QThread {
+public:
+    SenderThread(int index);
+
+    void add(SendQueue* queue);
+    void remove(SendQueue* queue); // waits for the queue's current pass, if any, to finish
+    void wake(SendQueue* queue);
+
+    int getNumQueues() const { return _numQueues; }
+    uint64_t getNumWakeups() const { return _numWakeups; }
+
+protected:
+    void run() override;
+
+private:
+    using Wheel = TimerWheel<SendQueue*>;
+
+    struct Entry {
+        Wheel::TimerID timer { Wheel::INVALID_TIMER_ID };
+        bool isDue { false };
+    };
+
+    void scheduleDue(SendQueue* queue);
+
+    std::mutex _mutex;
+    std::condition_variable _wakeCondition;
+    std::condition_variable _passCompleteCondition;
+
+    Wheel _wheel;
+    std::unordered_map<SendQueue*, Entry> _queues;
+    std::vector<SendQueue*> _wokenQueues;
+    std::vector<SendQueue*> _dueQueues;
+    SendQueue* _currentQueue { nullptr };
+
+    std::atomic<int> _numQueues { 0 };
+    std::atomic<uint64_t> _numWakeups { 0 };
+};
+
+// Spreads the SendQueues of every Socket in the process over a few SenderThreads,
+// for servers with hundreds of mostly idle connections.  See SendQueue::setNumSharedSenderThreads.
+class SendQueueScheduler {
+public:
+    // nullptr until shared sender threads are asked for
+    static SendQueueScheduler* getInstance();
+
+    static void setNumThreads(int numThreads);
+    static int getNumThreads();
+
+    // assigns the queue to the least loaded thread and moves it there
+    SenderThread* add(SendQueue* queue);
+
+    int getNumRunningThreads() const;
+    uint64_t getNumWakeups() const;
+
+private:
+    SendQueueScheduler(int numThreads);
+
+    std::vector<std::unique_ptr<SenderThread>> _threads;
+};
+
+}
+
+#endif // hifi_SendQueueScheduler_h
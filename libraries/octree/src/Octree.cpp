@@ -135,6 +135,20 @@ bool Octree::recurseElementWithOperationSorted(const OctreeElementPointer& eleme
     return keepSearching;
 }
 
+int Octree::lockAndProcessEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
+                                         const SharedNodePointer& sourceNode, EditLockTimes& lockTimes) {
+    int bytesRead = 0;
+    quint64 startLock = usecTimestampNow();
+    quint64 startProcess = startLock;
+    withWriteLock([&] {
+        startProcess = usecTimestampNow();
+        bytesRead = processEditPacketData(message, editData, maxLength, sourceNode);
+    });
+    lockTimes.waitTime = startProcess - startLock;
+    lockTimes.holdTime = usecTimestampNow() - startProcess;
+    return bytesRead;
+}
+
 void Octree::recurseTreeWithOperator(RecurseOctreeOperator* operatorObject) {
     recurseElementWithOperator(_rootElement, operatorObject);
 }
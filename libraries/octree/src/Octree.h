@@ -138,6 +138,15 @@ public:
     virtual bool handlesEditPacketType(PacketType packetType) const { return false; }
     virtual int processEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
                                       const SharedNodePointer& sourceNode) { return 0; }
+
+    struct EditLockTimes {
+        quint64 waitTime { 0 }; // usecs spent waiting for the tree lock
+        quint64 holdTime { 0 }; // usecs the tree was locked while the edit was applied
+    };
+    // Locks the tree and processes one edit.  By default the whole edit is processed with the tree locked for writing;
+    // trees that can decode and vet their edits without it only take the write lock to apply them.
+    virtual int lockAndProcessEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
+                                             const SharedNodePointer& sourceNode, EditLockTimes& lockTimes);
     virtual void processChallengeOwnershipRequestPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) { return; }
     virtual void processChallengeOwnershipReplyPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) { return; }
     virtual void processChallengeOwnershipPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) { return; }
@@ -0,0 +1,230 @@
+//
+//  OctreeCompressionDictionary.cpp
+//  libraries/octree/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeCompressionDictionary.h"
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <queue>
+
+#include <QtCore/QtEndian>
+
+#include <zlib.h>
+
+namespace {
+
+// qCompress() puts the uncompressed size in front of the zlib stream
+const int UNCOMPRESSED_SIZE_BYTES = sizeof(quint32);
+// anything bigger is not octree data
+const quint32 MAX_UNCOMPRESSED_SIZE = 16 * 1024 * 1024;
+
+const size_t MAX_REGISTERED_DICTIONARIES = 4;
+std::mutex registryMutex;
+std::deque<OctreeCompressionDictionaryPointer> registry;
+
+// training looks at the 8 byte substrings the samples share, counted in a fixed size hash table
+const int KMER_SIZE = sizeof(uint64_t);
+const int KMER_HASH_BITS = 20;
+const int SEGMENT_SIZE = 64;
+const int SEGMENT_STRIDE = SEGMENT_SIZE / 2;
+
+uint32_t hashKmer(const char* data) {
+    uint64_t kmer;
+    memcpy(&kmer, data, sizeof(kmer));
+    return (uint32_t)((kmer * 0x9E3779B97F4A7C15ULL) >> (64 - KMER_HASH_BITS));
+}
+
+struct Segment {
+    int sample;
+    int offset;
+    int size;
+    uint64_t score;
+
+    bool operator<(const Segment& other) const { return score < other.score; }
+};
+
+}
+
+OctreeCompressionDictionary::OctreeCompressionDictionary(const QByteArray& data) :
+    _data(data),
+    _id((ID)adler32(adler32(0L, Z_NULL, 0), (const Bytef*)data.constData(), (uInt)data.size()))
+{
+}
+
+QByteArray OctreeCompressionDictionary::train(const std::vector<QByteArray>& samples, int maxSize) {
+    const size_t TABLE_SIZE = (size_t)1 << KMER_HASH_BITS;
+
+    // count the samples each substring is in, substrings in only one sample don't help the others
+    std::vector<uint32_t> frequencies(TABLE_SIZE, 0);
+    std::vector<uint32_t> lastCounted(TABLE_SIZE, 0);
+    uint32_t stamp = 0;
+    for (const auto& sample : samples) {
+        ++stamp;
+        for (int i = 0; i + KMER_SIZE <= sample.size(); ++i) {
+            uint32_t hash = hashKmer(sample.constData() + i);
+            if (lastCounted[hash] != stamp) {
+                lastCounted[hash] = stamp;
+                frequencies[hash]++;
+            }
+        }
+    }
+
+    auto score = [&](const Segment& segment) {
+        ++stamp;
+        uint64_t total = 0;
+        const char* data = samples[segment.sample].constData() + segment.offset;
+        for (int i = 0; i + KMER_SIZE <= segment.size; ++i) {
+            uint32_t hash = hashKmer(data + i);
+            if (lastCounted[hash] != stamp) {
+                lastCounted[hash] = stamp;
+                total += frequencies[hash] > 1 ? frequencies[hash] : 0;
+            }
+        }
+        return total;
+    };
+
+    std::priority_queue<Segment> candidates;
+    for (int i = 0; i < (int)samples.size(); ++i) {
+        int sampleSize = samples[i].size();
+        for (int offset = 0; offset + KMER_SIZE <= sampleSize; offset += SEGMENT_STRIDE) {
+            Segment segment { i, offset, std::min(SEGMENT_SIZE, sampleSize - offset), 0 };
+            segment.score = score(segment);
+            if (segment.score > 0) {
+                candidates.push(segment);
+            }
+        }
+    }
+
+    // Greedily take the best segment and stop counting what it covers.  Scores only ever go down, so a segment
+    // whose updated score is still the best is the best.
+    std::vector<Segment> chosen;
+    int size = 0;
+    while (!candidates.empty() && size < maxSize) {
+        Segment segment = candidates.top();
+        candidates.pop();
+
+        segment.score = score(segment);
+        if (segment.score == 0) {
+            continue;
+        }
+        if (!candidates.empty() && segment.score < candidates.top().score) {
+            candidates.push(segment);
+            continue;
+        }
+
+        segment.size = std::min(segment.size, maxSize - size);
+        const char* data = samples[segment.sample].constData() + segment.offset;
+        for (int i = 0; i + KMER_SIZE <= segment.size; ++i) {
+            frequencies[hashKmer(data + i)] = 0;
+        }
+        chosen.push_back(segment);
+        size += segment.size;
+    }
+
+    QByteArray dictionary;
+    dictionary.reserve(size);
+    for (auto segment = chosen.rbegin(); segment != chosen.rend(); ++segment) {
+        dictionary.append(samples[segment->sample].constData() + segment->offset, segment->size);
+    }
+    return dictionary;
+}
+
+QByteArray OctreeCompressionDictionary::compress(const unsigned char* data, int size, int compressionLevel) const {
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    if (deflateInit(&stream, compressionLevel) != Z_OK) {
+        return QByteArray();
+    }
+
+    QByteArray compressed;
+    int status = deflateSetDictionary(&stream, (const Bytef*)_data.constData(), (uInt)_data.size());
+    if (status == Z_OK) {
+        compressed.resize(UNCOMPRESSED_SIZE_BYTES + (int)deflateBound(&stream, (uLong)size));
+        qToBigEndian<quint32>((quint32)size, (uchar*)compressed.data());
+
+        stream.next_in = const_cast<Bytef*>(data);
+        stream.avail_in = (uInt)size;
+        stream.next_out = (Bytef*)compressed.data() + UNCOMPRESSED_SIZE_BYTES;
+        stream.avail_out = (uInt)(compressed.size() - UNCOMPRESSED_SIZE_BYTES);
+        status = deflate(&stream, Z_FINISH);
+    }
+    deflateEnd(&stream);
+
+    if (status != Z_STREAM_END) {
+        return QByteArray();
+    }
+    compressed.resize(UNCOMPRESSED_SIZE_BYTES + (int)stream.total_out);
+    return compressed;
+}
+
+QByteArray OctreeCompressionDictionary::uncompress(const unsigned char* data, int size) {
+    if (!data || size <= UNCOMPRESSED_SIZE_BYTES) {
+        return QByteArray();
+    }
+
+    quint32 uncompressedSize = qFromBigEndian<quint32>(data);
+    if (uncompressedSize == 0 || uncompressedSize > MAX_UNCOMPRESSED_SIZE) {
+        return QByteArray();
+    }
+
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    if (inflateInit(&stream) != Z_OK) {
+        return QByteArray();
+    }
+
+    QByteArray uncompressed((int)uncompressedSize, Qt::Uninitialized);
+    stream.next_in = const_cast<Bytef*>(data + UNCOMPRESSED_SIZE_BYTES);
+    stream.avail_in = (uInt)(size - UNCOMPRESSED_SIZE_BYTES);
+    stream.next_out = (Bytef*)uncompressed.data();
+    stream.avail_out = (uInt)uncompressedSize;
+
+    int status = inflate(&stream, Z_FINISH);
+    if (status == Z_NEED_DICT) {
+        auto dictionary = find((ID)stream.adler);
+        if (dictionary && inflateSetDictionary(&stream, (const Bytef*)dictionary->getData().constData(),
+                                               (uInt)dictionary->getData().size()) == Z_OK) {
+            status = inflate(&stream, Z_FINISH);
+        }
+    }
+    inflateEnd(&stream);
+
+    if (status != Z_STREAM_END || stream.total_out != uncompressedSize) {
+        return QByteArray();
+    }
+    return uncompressed;
+}
+
+void OctreeCompressionDictionary::add(const OctreeCompressionDictionaryPointer& dictionary) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    auto existing = std::find_if(registry.begin(), registry.end(), [&](const OctreeCompressionDictionaryPointer& other) {
+        return other->getID() == dictionary->getID();
+    });
+    if (existing != registry.end()) {
+        registry.erase(existing);
+    }
+    registry.push_back(dictionary);
+    if (registry.size() > MAX_REGISTERED_DICTIONARIES) {
+        registry.pop_front();
+    }
+}
+
+OctreeCompressionDictionaryPointer OctreeCompressionDictionary::find(ID id) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (auto dictionary = registry.rbegin(); dictionary != registry.rend(); ++dictionary) {
+        if ((*dictionary)->getID() == id) {
+            return *dictionary;
+        }
+    }
+    return OctreeCompressionDictionaryPointer();
+}
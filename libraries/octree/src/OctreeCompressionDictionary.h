@@ -0,0 +1,66 @@
+//
+//  OctreeCompressionDictionary.h
+//  libraries/octree/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreeCompressionDictionary_h
+#define hifi_OctreeCompressionDictionary_h
+
+#include <memory>
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+
+class OctreeCompressionDictionary;
+using OctreeCompressionDictionaryPointer = std::shared_ptr<const OctreeCompressionDictionary>;
+
+// the octree query JSON parameter a client reports the ID of its latest compression dictionary in, 0 for none yet
+const QString COMPRESSION_DICTIONARY_QUERY_PARAMETER = "compressionDictionary";
+
+// OctreeCompressionDictionary is a zlib preset dictionary trained on a server's own content.  Octree data compressed
+// with it keeps the qCompress() framing (the uncompressed size followed by a zlib stream) and the zlib stream names
+// the dictionary by its ID, so uncompress() handles both plain and dictionary compressed data without any flags.
+//
+// A server only compresses with a dictionary once the client has said it has it, the client registers the
+// dictionaries it is sent with add() so that uncompress() can find them.
+class OctreeCompressionDictionary {
+public:
+    // the adler32 checksum of the dictionary, which is what zlib puts in the stream header
+    using ID = uint32_t;
+    static const ID NO_DICTIONARY = 0;
+
+    // zlib only looks back 32KB, less what it keeps for lookahead and the data being compressed
+    static const int DEFAULT_MAX_SIZE = 31 * 1024;
+
+    explicit OctreeCompressionDictionary(const QByteArray& data);
+
+    // Builds a dictionary from the segments of the samples that share the most substrings with the other samples,
+    // with the best of them last, where matches are cheapest.  Returns an empty dictionary if nothing is shared.
+    static QByteArray train(const std::vector<QByteArray>& samples, int maxSize = DEFAULT_MAX_SIZE);
+
+    ID getID() const { return _id; }
+    const QByteArray& getData() const { return _data; }
+
+    // returns an empty array on failure, like qCompress
+    QByteArray compress(const unsigned char* data, int size, int compressionLevel) const;
+
+    // uncompresses qCompress() data or data compressed with any registered dictionary, or returns an empty array
+    static QByteArray uncompress(const unsigned char* data, int size);
+
+    // registers a dictionary with uncompress(), only the last few registered are kept
+    static void add(const OctreeCompressionDictionaryPointer& dictionary);
+    static OctreeCompressionDictionaryPointer find(ID id);
+
+private:
+    QByteArray _data;
+    ID _id;
+};
+
+#endif // hifi_OctreeCompressionDictionary_h
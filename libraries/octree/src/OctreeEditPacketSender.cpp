@@ -207,6 +207,7 @@ void OctreeEditPacketSender::queueOctreeEditMessage(PacketType type, QByteArray&
             if (nodeClockSkew != 0) {
                 adjustEditPacketForClockSkew(type, editMessage, nodeClockSkew);
             }
+            packEditMessage(type, editMessage);
 
             newPacket->write(editMessage);
 
@@ -217,6 +218,16 @@ void OctreeEditPacketSender::queueOctreeEditMessage(PacketType type, QByteArray&
             auto& sentPacketHistory = _sentPacketHistories[nodeUUID];
             sentPacketHistory.untrackedPacketSent(sequence);
         } else {
+            // This is really the first time we know which server/node this particular edit message
+            // is going to, so we couldn't adjust for clock skew till now. But here's our chance.
+            // We call this virtual function that allows our specific type of EditPacketSender to
+            // fixup the buffer for any clock skew
+            if (node->getClockSkewUsec() != 0) {
+                adjustEditPacketForClockSkew(type, editMessage, node->getClockSkewUsec());
+            }
+            // packed before it's known whether it fits in the buffered packet, since packing changes its size
+            packEditMessage(type, editMessage);
+
             // only a NLPacket for now
             std::unique_ptr<NLPacket>& bufferedPacket = _pendingEditPackets[nodeUUID].first;
 
@@ -236,14 +247,6 @@ void OctreeEditPacketSender::queueOctreeEditMessage(PacketType type, QByteArray&
                 }
             }
 
-            // This is really the first time we know which server/node this particular edit message
-            // is going to, so we couldn't adjust for clock skew till now. But here's our chance.
-            // We call this virtual function that allows our specific type of EditPacketSender to
-            // fixup the buffer for any clock skew
-            if (node->getClockSkewUsec() != 0) {
-                adjustEditPacketForClockSkew(type, editMessage, node->getClockSkewUsec());
-            }
-
             bufferedPacket->write(editMessage);
         }
     }
@@ -357,4 +360,8 @@ void OctreeEditPacketSender::nodeKilled(SharedNodePointer node) {
     _pendingEditPackets.erase(nodeUUID);
     _outgoingSequenceNumbers.erase(nodeUUID);
     _sentPacketHistories.erase(nodeUUID);
+
+    if (node->getType() == getMyNodeType()) {
+        setCompressionDictionary(OctreeCompressionDictionaryPointer());
+    }
 }
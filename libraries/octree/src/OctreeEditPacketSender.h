@@ -12,11 +12,13 @@
 #ifndef hifi_OctreeEditPacketSender_h
 #define hifi_OctreeEditPacketSender_h
 
+#include <memory>
 #include <unordered_map>
 
 #include <PacketSender.h>
 #include <udt/PacketHeaders.h>
 
+#include "OctreeCompressionDictionary.h"
 #include "SentPacketHistory.h"
 
 /// Utility for processing, packing, queueing and sending of outbound edit messages.
@@ -62,9 +64,16 @@ public:
     // is there an octree server available to send packets to
     bool serversExist() const;
 
+    /// The compression dictionary the server sent, which it can uncompress edits with. It is dropped when the server goes
+    /// away, since the next one won't have it.
+    void setCompressionDictionary(const OctreeCompressionDictionaryPointer& dictionary) { std::atomic_store(&_compressionDictionary, dictionary); }
+    OctreeCompressionDictionaryPointer getCompressionDictionary() const { return std::atomic_load(&_compressionDictionary); }
+
     // you must override these...
     virtual char getMyNodeType() const = 0;
     virtual void adjustEditPacketForClockSkew(PacketType type, QByteArray& buffer, qint64 clockSkew) { }
+    // puts an edit message in the form it goes out in, once it has been adjusted for clock skew
+    virtual void packEditMessage(PacketType type, QByteArray& buffer) { }
 
     void processNackPacket(ReceivedMessage& message, SharedNodePointer sendingNode);
 
@@ -102,5 +111,7 @@ protected:
     // protected by _packetsQueueLock
     std::unordered_map<QUuid, SentPacketHistory> _sentPacketHistories;
     std::unordered_map<QUuid, quint16> _outgoingSequenceNumbers;
+
+    OctreeCompressionDictionaryPointer _compressionDictionary;
 };
 #endif // hifi_OctreeEditPacketSender_h
@@ -590,6 +590,9 @@ bool OctreePacketData::appendRawData(QByteArray data) {
 
 AtomicUIntStat OctreePacketData::_compressContentTime { 0 };
 AtomicUIntStat OctreePacketData::_compressContentCalls { 0 };
+AtomicUIntStat OctreePacketData::_dictionaryCompressContentCalls { 0 };
+AtomicUIntStat OctreePacketData::_compressContentBytesIn { 0 };
+AtomicUIntStat OctreePacketData::_compressContentBytesOut { 0 };
 
 bool OctreePacketData::compressContent() {
     PerformanceWarning warn(false, "OctreePacketData::compressContent()", false, &_compressContentTime, &_compressContentCalls);
@@ -605,10 +608,18 @@ bool OctreePacketData::compressContent() {
     const uchar* uncompressedData = &_uncompressed[0];
     int uncompressedSize = _bytesInUse;
 
-    QByteArray compressedData = qCompress(uncompressedData, uncompressedSize, MAX_COMPRESSION);
+    QByteArray compressedData;
+    if (_compressionDictionary) {
+        compressedData = _compressionDictionary->compress(uncompressedData, uncompressedSize, MAX_COMPRESSION);
+        _dictionaryCompressContentCalls++;
+    } else {
+        compressedData = qCompress(uncompressedData, uncompressedSize, MAX_COMPRESSION);
+    }
 
-    if (compressedData.size() < _compressedByteArray.size()) {
+    if (!compressedData.isEmpty() && compressedData.size() < _compressedByteArray.size()) {
         _compressedBytes = compressedData.size();
+        _compressContentBytesIn += uncompressedSize;
+        _compressContentBytesOut += _compressedBytes;
         memcpy(_compressed, compressedData.constData(), _compressedBytes);
         _dirty = false;
         success = true;
@@ -629,11 +640,8 @@ void OctreePacketData::loadFinalizedContent(const unsigned char* data, int lengt
             _compressedBytes = length;
             memcpy(_compressed, data, _compressedBytes);
 
-            QByteArray compressedData;
-            compressedData.resize(_compressedBytes);
-            memcpy(compressedData.data(), data, _compressedBytes);
-
-            QByteArray uncompressedData = qUncompress(compressedData);
+            // handles plain qCompress() content as well as content compressed with a registered dictionary
+            QByteArray uncompressedData = OctreeCompressionDictionary::uncompress(data, length);
             if (uncompressedData.size() > _bytesAvailable) {
                 int moreNeeded = uncompressedData.size() - _bytesAvailable;
                 _uncompressedByteArray.resize(_uncompressedByteArray.size() + moreNeeded);
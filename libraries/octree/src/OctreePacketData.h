@@ -43,6 +43,7 @@
 #include "GizmoType.h"
 #include "TextEffect.h"
 
+#include "OctreeCompressionDictionary.h"
 #include "OctreeConstants.h"
 #include "OctreeElement.h"
 
@@ -241,6 +242,10 @@ public:
     
     /// returns whether or not zlib compression enabled on finalization
     bool isCompressed() const { return _enableCompression; }
+
+    /// the preset dictionary to compress with, if any, kept across changes of settings
+    void setCompressionDictionary(const OctreeCompressionDictionaryPointer& dictionary) { _compressionDictionary = dictionary; }
+    const OctreeCompressionDictionaryPointer& getCompressionDictionary() const { return _compressionDictionary; }
     
     /// returns the target uncompressed size
     unsigned int getTargetSize() const { return _targetSize; }
@@ -256,6 +261,9 @@ public:
     
     static quint64 getCompressContentTime() { return _compressContentTime; } /// total time spent compressing content
     static quint64 getCompressContentCalls() { return _compressContentCalls; } /// total calls to compress content
+    static quint64 getDictionaryCompressContentCalls() { return _dictionaryCompressContentCalls; } /// calls compressing with a dictionary
+    static quint64 getCompressContentBytesIn() { return _compressContentBytesIn; } /// total bytes of content compressed
+    static quint64 getCompressContentBytesOut() { return _compressContentBytesOut; } /// total bytes it was compressed to
     static quint64 getTotalBytesOfOctalCodes() { return _totalBytesOfOctalCodes; }  /// total bytes for octal codes
     static quint64 getTotalBytesOfBitMasks() { return _totalBytesOfBitMasks; }  /// total bytes of bitmasks
     static quint64 getTotalBytesOfColor() { return _totalBytesOfColor; } /// total bytes of color
@@ -310,6 +318,7 @@ private:
 
     bool compressContent();
     
+    OctreeCompressionDictionaryPointer _compressionDictionary;
     QByteArray _compressedByteArray;
     unsigned char* _compressed { nullptr };
     int _compressedBytes;
@@ -330,6 +339,9 @@ private:
 
     static AtomicUIntStat _compressContentTime;
     static AtomicUIntStat _compressContentCalls;
+    static AtomicUIntStat _dictionaryCompressContentCalls;
+    static AtomicUIntStat _compressContentBytesIn;
+    static AtomicUIntStat _compressContentBytesOut;
 
     static AtomicUIntStat _totalBytesOfOctalCodes;
     static AtomicUIntStat _totalBytesOfBitMasks;
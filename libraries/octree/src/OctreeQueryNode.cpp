@@ -242,3 +242,21 @@ bool OctreeQueryNode::haveJSONParametersChanged() {
 
     return parametersChanged;
 }
+
+QJsonObject OctreeQueryNode::getJSONFilters() {
+    auto filters = getJSONParameters();
+    filters.remove(COMPRESSION_DICTIONARY_QUERY_PARAMETER);
+    return filters;
+}
+
+const OctreeCompressionDictionaryPointer& OctreeQueryNode::updateCompressionDictionary() {
+    auto reportedID = (OctreeCompressionDictionary::ID)getJSONParameters().value(COMPRESSION_DICTIONARY_QUERY_PARAMETER).toDouble();
+
+    // switch to the dictionary sent last once the node has it, until then keep using the one it had
+    if (_sentCompressionDictionary && _sentCompressionDictionary->getID() == reportedID) {
+        _compressionDictionary = _sentCompressionDictionary;
+    } else if (_compressionDictionary && _compressionDictionary->getID() != reportedID) {
+        _compressionDictionary.reset();
+    }
+    return _compressionDictionary;
+}
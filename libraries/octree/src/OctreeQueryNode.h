@@ -16,6 +16,7 @@
 
 #include <qqueue.h>
 
+#include "OctreeCompressionDictionary.h"
 #include "OctreeConstants.h"
 #include "OctreeElementBag.h"
 #include "OctreePacketData.h"
@@ -83,6 +84,15 @@ public:
     // call only from OctreeSendThread for the given node
     bool haveJSONParametersChanged();
 
+    // the JSON parameters that say what to send, without the ones about how to send it
+    QJsonObject getJSONFilters();
+
+    // The compression dictionary last sent to this node and the one its octree data is compressed with, which is
+    // only ever one the node has reported having in its query.  Call only from OctreeSendThread for the given node.
+    const OctreeCompressionDictionaryPointer& getSentCompressionDictionary() const { return _sentCompressionDictionary; }
+    void setSentCompressionDictionary(const OctreeCompressionDictionaryPointer& dictionary) { _sentCompressionDictionary = dictionary; }
+    const OctreeCompressionDictionaryPointer& updateCompressionDictionary();
+
     bool shouldForceFullScene() const { return _shouldForceFullScene; }
     void setShouldForceFullScene(bool shouldForceFullScene) { _shouldForceFullScene = shouldForceFullScene; }
 
@@ -117,6 +127,9 @@ private:
 
     QJsonObject _lastCheckJSONParameters;
 
+    OctreeCompressionDictionaryPointer _sentCompressionDictionary;
+    OctreeCompressionDictionaryPointer _compressionDictionary;
+
     bool _shouldForceFullScene { true }; // hifi had default to false but we load entire scene
 };
 
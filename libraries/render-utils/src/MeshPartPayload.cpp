@@ -33,6 +33,8 @@ bool MeshPartPayload::enableMaterialProceduralShaders = true;
 #endif
 
 bool MeshPartPayload::sceneIsReady = false;
+bool MeshPartPayload::enableLODs = true;
+float MeshPartPayload::lodMaxPixelError = 1.0f;
 
 using namespace render;
 
@@ -82,6 +84,14 @@ void MeshPartPayload::updateMeshPart(const std::shared_ptr<const graphics::Mesh>
         auto vertexFormat = _drawMesh->getVertexFormat();
         _hasColorAttrib = vertexFormat->hasAttribute(gpu::Stream::COLOR);
         _drawPart = _drawMesh->getPartBuffer().get<graphics::Mesh::Part>(partIndex);
+        _drawLODParts.clear();
+        for (const auto& lod : _drawMesh->getLODs()) {
+            if (partIndex >= (int)lod.parts.size()) {
+                break;
+            }
+            _drawLODParts.push_back(lod.parts[partIndex]);
+        }
+        _drawLOD = 0;
         _localBound = _drawMesh->evalPartBound(partIndex);
     }
 }
@@ -171,8 +181,40 @@ ShapeKey MeshPartPayload::getShapeKey() const {
     return builder.build();
 }
 
+void MeshPartPayload::updateDrawLOD(RenderArgs* args) {
+    // The other passes draw what the main view last picked, so that the shadows and mirrors match it
+    if (args->_renderMode != RenderArgs::RenderMode::DEFAULT_RENDER_MODE) {
+        return;
+    }
+
+    if (!enableLODs || _drawLODParts.empty()) {
+        _drawLOD = 0;
+        return;
+    }
+
+    const ViewFrustum& viewFrustum = args->getViewFrustum();
+    float distance = glm::distance(viewFrustum.getPosition(), _worldBound.calcCenter()) -
+        0.5f * glm::length(_worldBound.getDimensions());
+    const float MIN_LOD_DISTANCE = 0.01f;
+    if (distance < MIN_LOD_DISTANCE) {
+        _drawLOD = 0;
+        return;
+    }
+
+    // the LOD errors are in the mesh's units, so bring the pixels down to those
+    float pixelsPerMeter = 0.5f * (float)args->_viewport.w * viewFrustum.getProjection()[1][1] / distance;
+    glm::vec3 scale = glm::abs(_worldFromLocalTransform.getScale());
+    float pixelsPerUnit = pixelsPerMeter * glm::max(scale.x, glm::max(scale.y, scale.z));
+    if (pixelsPerUnit <= 0.0f) {
+        _drawLOD = 0;
+        return;
+    }
+    _drawLOD = std::min(_drawMesh->evalLOD(lodMaxPixelError / pixelsPerUnit), (int)_drawLODParts.size());
+}
+
 void MeshPartPayload::drawCall(gpu::Batch& batch) const {
-    batch.drawIndexed(gpu::TRIANGLES, _drawPart._numIndices, _drawPart._startIndex);
+    const auto& drawPart = getDrawPart();
+    batch.drawIndexed(gpu::TRIANGLES, drawPart._numIndices, drawPart._startIndex);
 }
 
 void MeshPartPayload::bindMesh(gpu::Batch& batch) {
@@ -226,7 +268,7 @@ void MeshPartPayload::render(RenderArgs* args) {
     }
 
     const int INDICES_PER_TRIANGLE = 3;
-    args->_details._trianglesRendered += _drawPart._numIndices / INDICES_PER_TRIANGLE;
+    args->_details._trianglesRendered += getDrawPart()._numIndices / INDICES_PER_TRIANGLE;
 }
 
 namespace render {
@@ -487,6 +529,8 @@ void ModelMeshPartPayload::render(RenderArgs* args) {
 
     gpu::Batch& batch = *(args->_batch);
 
+    updateDrawLOD(args);
+
     bindTransform(batch, args->_renderMode);
 
     //Bind the index buffer and vertex buffer and Blend shapes if needed
@@ -525,7 +569,7 @@ void ModelMeshPartPayload::render(RenderArgs* args) {
     }
 
     const int INDICES_PER_TRIANGLE = 3;
-    args->_details._trianglesRendered += _drawPart._numIndices / INDICES_PER_TRIANGLE;
+    args->_details._trianglesRendered += getDrawPart()._numIndices / INDICES_PER_TRIANGLE;
 }
 
 void ModelMeshPartPayload::setBlendshapeBuffer(const std::unordered_map<int, gpu::BufferPointer>& blendshapeBuffers,
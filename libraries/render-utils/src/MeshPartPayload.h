@@ -50,6 +50,10 @@ public:
     virtual render::ShapeKey getShapeKey() const;
     virtual void render(RenderArgs* args);
 
+    // pick the LOD to draw from how big the part is on screen
+    void updateDrawLOD(RenderArgs* args);
+    const graphics::Mesh::Part& getDrawPart() const { return _drawLOD > 0 ? _drawLODParts[_drawLOD - 1] : _drawPart; }
+
     // ModelMeshPartPayload functions to perform render
     void drawCall(gpu::Batch& batch) const;
     virtual void bindMesh(gpu::Batch& batch);
@@ -66,6 +70,8 @@ public:
 
     graphics::MultiMaterial _drawMaterials;
     graphics::Mesh::Part _drawPart;
+    std::vector<graphics::Mesh::Part> _drawLODParts;
+    int _drawLOD { 0 };
 
     size_t getVerticesCount() const { return _drawMesh ? _drawMesh->getNumVertices() : 0; }
     size_t getMaterialTextureSize() { return _drawMaterials.getTextureSize(); }
@@ -80,6 +86,8 @@ public:
     static bool DEFAULT_ENABLE_MATERIAL_PROCEDURAL_SHADERS;
     static bool enableMaterialProceduralShaders; // set from menu/settings
     static bool sceneIsReady; // set from entity tree renderer
+    static bool enableLODs; // set from menu
+    static float lodMaxPixelError; // how many pixels an LOD can stray from the full mesh before a finer one is drawn
 
 protected:
     render::ItemKey _itemKey{ render::ItemKey::Builder::opaqueShape().build() };
@@ -127,7 +127,7 @@ void FetchNonspatialItems::run(const RenderContextPointer& renderContext, const
     for (auto& id : items) {
         auto& item = scene->getItem(id);
         if (filter.test(item.getKey())) {
-            outItems.emplace_back(ItemBound(id, item.getBound()));
+            outItems.emplace_back(ItemBound(id, scene->getFrameBound(id)));
         }
     }
 }
@@ -234,7 +234,7 @@ void CullSpatialSelection::run(const RenderContextPointer& renderContext,
                 for (auto id : inSelection.insideItems) {
                     auto& item = scene->getItem(id);
                     if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
+                        ItemBound itemBound(id, scene->getFrameBound(id));
                         outItems.emplace_back(itemBound);
                         if (item.getKey().isMetaCullGroup()) {
                             item.fetchMetaSubItemBounds(outItems, (*scene));
@@ -249,7 +249,7 @@ void CullSpatialSelection::run(const RenderContextPointer& renderContext,
                 for (auto id : inSelection.insideSubcellItems) {
                     auto& item = scene->getItem(id);
                     if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
+                        ItemBound itemBound(id, scene->getFrameBound(id));
                         outItems.emplace_back(itemBound);
                         if (item.getKey().isMetaCullGroup()) {
                             item.fetchMetaSubItemBounds(outItems, (*scene));
@@ -264,7 +264,7 @@ void CullSpatialSelection::run(const RenderContextPointer& renderContext,
                 for (auto id : inSelection.partialItems) {
                     auto& item = scene->getItem(id);
                     if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
+                        ItemBound itemBound(id, scene->getFrameBound(id));
                         outItems.emplace_back(itemBound);
                         if (item.getKey().isMetaCullGroup()) {
                             item.fetchMetaSubItemBounds(outItems, (*scene));
@@ -279,7 +279,7 @@ void CullSpatialSelection::run(const RenderContextPointer& renderContext,
                 for (auto id : inSelection.partialSubcellItems) {
                     auto& item = scene->getItem(id);
                     if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
+                        ItemBound itemBound(id, scene->getFrameBound(id));
                         outItems.emplace_back(itemBound);
                         if (item.getKey().isMetaCullGroup()) {
                             item.fetchMetaSubItemBounds(outItems, (*scene));
@@ -296,7 +296,7 @@ void CullSpatialSelection::run(const RenderContextPointer& renderContext,
                 for (auto id : inSelection.insideItems) {
                     auto& item = scene->getItem(id);
                     if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
+                        ItemBound itemBound(id, scene->getFrameBound(id));
                         outItems.emplace_back(itemBound);
                         if (item.getKey().isMetaCullGroup()) {
                             item.fetchMetaSubItemBounds(outItems, (*scene));
@@ -311,7 +311,7 @@ void CullSpatialSelection::run(const RenderContextPointer& renderContext,
                 for (auto id : inSelection.insideSubcellItems) {
                     auto& item = scene->getItem(id);
                     if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
+                        ItemBound itemBound(id, scene->getFrameBound(id));
                         if (test.solidAngleTest(itemBound.bound)) {
                             outItems.emplace_back(itemBound);
                             if (item.getKey().isMetaCullGroup()) {
@@ -328,7 +328,7 @@ void CullSpatialSelection::run(const RenderContextPointer& renderContext,
                 for (auto id : inSelection.partialItems) {
                     auto& item = scene->getItem(id);
                     if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
+                        ItemBound itemBound(id, scene->getFrameBound(id));
                         if (test.frustumTest(itemBound.bound)) {
                             outItems.emplace_back(itemBound);
                             if (item.getKey().isMetaCullGroup()) {
@@ -345,7 +345,7 @@ void CullSpatialSelection::run(const RenderContextPointer& renderContext,
                 for (auto id : inSelection.partialSubcellItems) {
                     auto& item = scene->getItem(id);
                     if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
+                        ItemBound itemBound(id, scene->getFrameBound(id));
                         if (test.frustumTest(itemBound.bound)) {
                             if (test.solidAngleTest(itemBound.bound)) {
                                 outItems.emplace_back(itemBound);
@@ -10,8 +10,11 @@
 //
 #include "Scene.h"
 
+#include <algorithm>
 #include <numeric>
+#include <unordered_map>
 #include <gpu/Batch.h>
+#include <TBBHelpers.h>
 #include "Logging.h"
 #include "TransitionStage.h"
 #include "HighlightStage.h"
@@ -180,15 +183,66 @@ void Transaction::clear() {
     _highlightQueries.clear();
 }
 
+void Transaction::coalesceUpdates() {
+    if (_updatedItems.size() < 2) {
+        return;
+    }
+
+    // bring each item's updates together, keeping the items in the order they were first updated
+    std::unordered_map<ItemID, size_t> firstUpdates;
+    firstUpdates.reserve(_updatedItems.size());
+    for (size_t i = 0; i < _updatedItems.size(); i++) {
+        firstUpdates.emplace(std::get<0>(_updatedItems[i]), i);
+    }
+    std::stable_sort(_updatedItems.begin(), _updatedItems.end(), [&](const Update& a, const Update& b) {
+        return firstUpdates.at(std::get<0>(a)) < firstUpdates.at(std::get<0>(b));
+    });
+
+    // within each item's run of updates, an empty update only asks for the key and bound to be refreshed,
+    // which applying any of the other updates does anyway
+    auto target = _updatedItems.begin();
+    auto runBegin = _updatedItems.begin();
+    while (runBegin != _updatedItems.end()) {
+        auto id = std::get<0>(*runBegin);
+        auto runEnd = runBegin;
+        bool hasFunctor = false;
+        while (runEnd != _updatedItems.end() && std::get<0>(*runEnd) == id) {
+            hasFunctor = hasFunctor || (bool)std::get<1>(*runEnd);
+            ++runEnd;
+        }
+
+        bool keptOne = false;
+        for (auto itr = runBegin; itr != runEnd; ++itr) {
+            if (std::get<1>(*itr) || (!hasFunctor && !keptOne)) {
+                if (target != itr) {
+                    *target = std::move(*itr);
+                }
+                ++target;
+                keptOne = true;
+            }
+        }
+        runBegin = runEnd;
+    }
+    _updatedItems.erase(target, _updatedItems.end());
+}
+
 
 Scene::Scene(glm::vec3 origin, float size) :
     _masterSpatialTree(origin, size)
 {
     _items.push_back(Item()); // add the itemID #0 to nothing
+    startFrameBounds();
 }
 
 Scene::~Scene() {
     qCDebug(renderlogging) << "Scene::~Scene()";
+    TransactionNode* node = _transactionLog.exchange(nullptr);
+    while (node) {
+        TransactionNode* next = node->next;
+        node->~TransactionNode();
+        TransactionPool::deallocate(node, sizeof(TransactionNode));
+        node = next;
+    }
 }
 
 ItemID Scene::allocateID() {
@@ -200,30 +254,47 @@ bool Scene::isAllocatedID(const ItemID& id) const {
     return Item::isValidID(id) && (id < _numAllocatedItems.load());
 }
 
+void Scene::pushTransaction(TransactionNode* node) {
+    node->next = _transactionLog.load(std::memory_order_relaxed);
+    while (!_transactionLog.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+    _transactionLogSize++;
+}
+
 /// Enqueue change batch to the scene
 void Scene::enqueueTransaction(const Transaction& transaction) {
-    std::unique_lock<std::mutex> lock(_transactionQueueMutex);
-    _transactionQueue.emplace_back(transaction);
+    auto node = new (TransactionPool::allocate(sizeof(TransactionNode))) TransactionNode{ transaction };
+    pushTransaction(node);
 }
 
 void Scene::enqueueTransaction(Transaction&& transaction) {
-    std::unique_lock<std::mutex> lock(_transactionQueueMutex);
-    _transactionQueue.emplace_back(std::move(transaction));
+    auto node = new (TransactionPool::allocate(sizeof(TransactionNode))) TransactionNode{ std::move(transaction) };
+    pushTransaction(node);
 }
 
 uint32_t Scene::enqueueFrame() {
     PROFILE_RANGE(render, __FUNCTION__);
+    // take the whole log at once, it comes out newest first
+    TransactionNode* head = _transactionLog.exchange(nullptr, std::memory_order_acquire);
     TransactionQueue localTransactionQueue;
-    {
-        std::unique_lock<std::mutex> lock(_transactionQueueMutex);
-        localTransactionQueue.swap(_transactionQueue);
+    for (auto node = head; node; node = node->next) {
+        _transactionLogSize--;
+        localTransactionQueue.emplace_back(std::move(node->transaction));
+    }
+    while (head) {
+        TransactionNode* next = head->next;
+        head->~TransactionNode();
+        TransactionPool::deallocate(head, sizeof(TransactionNode));
+        head = next;
     }
+    std::reverse(localTransactionQueue.begin(), localTransactionQueue.end());
 
     Transaction consolidatedTransaction;
     consolidatedTransaction.merge(std::move(localTransactionQueue));
+    consolidatedTransaction.coalesceUpdates();
     {
         std::unique_lock<std::mutex> lock(_transactionFramesMutex);
-        _transactionFrames.push_back(consolidatedTransaction);
+        _transactionFrames.push_back(std::move(consolidatedTransaction));
     }
 
     return ++_transactionFrameNumber;
@@ -246,6 +317,19 @@ void Scene::processTransactionQueue() {
     }
 
     queuedFrames.clear();
+
+    // the items may have changed, and the views of the new frame are about to ask for their bounds
+    startFrameBounds();
+}
+
+void Scene::startFrameBounds() {
+    if (++_frameStamp == 0) {
+        // the stamps wrapped around, none of them can be trusted
+        std::fill(_frameBoundStamps.begin(), _frameBoundStamps.end(), 0);
+        _frameStamp = 1;
+    }
+    _frameBounds.resize(_items.size());
+    _frameBoundStamps.resize(_items.size(), 0);
 }
 
 void Scene::processTransactionFrame(const Transaction& transaction) {
@@ -335,40 +419,113 @@ void Scene::removeItems(const Transaction::Removes& transactions) {
     }
 }
 
+namespace {
+
+// An item touched by the frame's updates: its run in the (coalesced) update list
+// and what its container needs to know once the update functors have run
+struct ItemUpdate {
+    size_t begin { 0 };
+    size_t end { 0 };
+    ItemKey oldKey;
+    ItemCell oldCell { Item::INVALID_CELL };
+    ItemKey newKey;
+    Item::Bound bound;
+    bool exists { false };
+};
+
+}
+
 void Scene::updateItems(const Transaction::Updates& transactions) {
-    for (auto& update : transactions) {
-        auto updateID = std::get<0>(update);
+    // split the updates into runs, one per item.  Transactions coming from enqueueFrame are already coalesced
+    // so each item has one run, but items updated in several runs still work: their runs are applied in order
+    std::vector<ItemUpdate> itemUpdates;
+    for (size_t i = 0; i < transactions.size(); ++i) {
+        auto updateID = std::get<0>(transactions[i]);
         if (updateID == Item::INVALID_ITEM_ID) {
             continue;
         }
+        if (itemUpdates.empty() || std::get<0>(transactions[itemUpdates.back().begin]) != updateID || itemUpdates.back().end != i) {
+            ItemUpdate itemUpdate;
+            itemUpdate.begin = i;
+            itemUpdates.push_back(itemUpdate);
+        }
+        itemUpdates.back().end = i + 1;
+    }
+
+    // run the update functors, which only touch their own item
+    auto applyFunctors = [&](ItemUpdate& itemUpdate) {
+        auto updateID = std::get<0>(transactions[itemUpdate.begin]);
 
         // Access the true item
         auto& item = _items[updateID];
 
         // If item doesn't exist it cannot be updated
         if (!item.exist()) {
-            continue;
+            return;
         }
-
-        // Good to go, deal with the update
-        auto oldCell = item.getCell();
-        auto oldKey = item.getKey();
+        itemUpdate.exists = true;
+        itemUpdate.oldCell = item.getCell();
+        itemUpdate.oldKey = item.getKey();
 
         // Update the item
-        item.update(std::get<1>(update));
-        auto newKey = item.getKey();
+        for (size_t i = itemUpdate.begin; i < itemUpdate.end; ++i) {
+            item.update(std::get<1>(transactions[i]));
+        }
+        itemUpdate.newKey = item.getKey();
+        if (itemUpdate.newKey.isSpatial()) {
+            itemUpdate.bound = item.getBound();
+        }
+    };
+
+    const size_t MIN_PARALLEL_ITEM_UPDATES = 1024;
+    if (_parallelItemUpdates && itemUpdates.size() >= MIN_PARALLEL_ITEM_UPDATES) {
+        // the same item can't show up in two runs processed concurrently, since the runs of an item are contiguous
+        // unless the transaction wasn't coalesced, in which case we stay on this thread
+        bool itemsAreDistinct = true;
+        for (size_t i = 1; i < itemUpdates.size() && itemsAreDistinct; ++i) {
+            itemsAreDistinct = std::get<0>(transactions[itemUpdates[i - 1].begin]) < std::get<0>(transactions[itemUpdates[i].begin]);
+        }
+        if (itemsAreDistinct) {
+            const size_t MIN_ITEMS_PER_TASK = 64;
+            tbb::parallel_for(tbb::blocked_range<size_t>(0, itemUpdates.size(), MIN_ITEMS_PER_TASK),
+                              [&](const tbb::blocked_range<size_t>& range) {
+                for (size_t i = range.begin(); i != range.end(); ++i) {
+                    applyFunctors(itemUpdates[i]);
+                }
+            });
+        } else {
+            for (auto& itemUpdate : itemUpdates) {
+                applyFunctors(itemUpdate);
+            }
+        }
+    } else {
+        for (auto& itemUpdate : itemUpdates) {
+            applyFunctors(itemUpdate);
+        }
+    }
+
+    // then move the items within the containers, which is shared by all items
+    for (const auto& itemUpdate : itemUpdates) {
+        if (!itemUpdate.exists) {
+            continue;
+        }
+        auto updateID = std::get<0>(transactions[itemUpdate.begin]);
+        auto& item = _items[updateID];
+        const auto& oldCell = itemUpdate.oldCell;
+        const auto& oldKey = itemUpdate.oldKey;
+        const auto& newKey = itemUpdate.newKey;
 
         // Update the item's container
         if (oldKey.isSpatial() == newKey.isSpatial()) {
             if (newKey.isSpatial()) {
-                auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, item.getBound(), updateID, newKey);
+                auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, itemUpdate.bound, updateID, newKey);
                 item.resetCell(newCell, newKey.isSmall());
             }
         } else {
             if (newKey.isSpatial()) {
                 _masterNonspatialSet.erase(updateID);
 
-                auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, item.getBound(), updateID, newKey);
+                auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, itemUpdate.bound, updateID, newKey);
                 item.resetCell(newCell, newKey.isSmall());
             } else {
                 _masterSpatialTree.removeItem(oldCell, oldKey, updateID);
@@ -18,6 +18,7 @@
 #include "Selection.h"
 #include "Transition.h"
 #include "HighlightStyle.h"
+#include "TransactionPool.h"
 
 namespace render {
 
@@ -44,14 +45,13 @@ public:
     typedef std::function<void(HighlightStyle const*)> SelectionHighlightQueryFunc;
 
     Transaction() {}
-    ~Transaction() {}
 
     // Item transactions
     void resetItem(ItemID id, const PayloadPointer& payload);
     void removeItem(ItemID id);
     bool hasRemovedItems() const { return !_removedItems.empty(); }
     template <class T> void updateItem(ItemID id, std::function<void(T&)> func) {
-        updateItem(id, std::make_shared<UpdateFunctor<T>>(func));
+        updateItem(id, std::allocate_shared<UpdateFunctor<T>>(TransactionAllocator<UpdateFunctor<T>>(), std::move(func)));
     }
     void updateItem(ItemID id, const UpdateFunctorPointer& functor);
     void updateItem(ItemID id) { updateItem(id, nullptr); }
@@ -76,6 +76,10 @@ public:
     void merge(Transaction&& transaction);
     void clear();
 
+    // Groups the updates by item, keeping their order within each item, and drops the empty updates
+    // of items that are already being updated, so that each item is touched only once when applied
+    void coalesceUpdates();
+
 protected:
 
     using Reset = std::tuple<ItemID, PayloadPointer>;
@@ -175,6 +179,17 @@ public:
     // Same as getItem, checking if the id is valid
     const Item getItemSafe(const ItemID& id) const { if (isAllocatedID(id)) { return _items[id]; } else { return Item(); } }
 
+    // The bound of an item for this frame.  It is asked of the item once, the first time any view of the frame needs it,
+    // and the other views (secondary camera, mirrors, shadow cascades) get the same one back.
+    // WARNING, There is No check on the validity of the ID, same as getItem
+    const Item::Bound& getFrameBound(const ItemID& id) const {
+        if (_frameBoundStamps[id] != _frameStamp) {
+            _frameBoundStamps[id] = _frameStamp;
+            _frameBounds[id] = _items[id].getBound();
+        }
+        return _frameBounds[id];
+    }
+
     // Access the spatialized items
     const ItemSpatialTree& getSpatialTree() const { return _masterSpatialTree; }
 
@@ -194,15 +209,27 @@ public:
     void setItemTransition(ItemID id, Index transitionId);
     void removeItemTransition(ItemID id);
 
-    size_t getTransactionQueueSize() { return _transactionQueue.size(); }
+    size_t getTransactionQueueSize() { return _transactionLogSize.load(); }
+
+    // Apply the item updates of a frame across the worker threads, once there are enough distinct items.
+    // Off by default: every update functor then has to be safe to run concurrently with those of other items
+    void setParallelItemUpdates(bool enabled) { _parallelItemUpdates = enabled; }
+    bool getParallelItemUpdates() const { return _parallelItemUpdates; }
 
 protected:
 
     // Thread safe elements that can be accessed from anywhere
     std::atomic<unsigned int> _IDAllocator{ 1 }; // first valid itemID will be One
     std::atomic<unsigned int> _numAllocatedItems{ 1 }; // num of allocated items, matching the _items.size()
-    std::mutex _transactionQueueMutex;
-    TransactionQueue _transactionQueue;
+
+    // The transactions enqueued since the last frame, as a lock free stack that enqueueFrame takes in one go
+    struct TransactionNode {
+        Transaction transaction;
+        TransactionNode* next { nullptr };
+    };
+    std::atomic<TransactionNode*> _transactionLog { nullptr };
+    std::atomic<size_t> _transactionLogSize { 0 };
+    void pushTransaction(TransactionNode* node);
 
     
     std::mutex _transactionFramesMutex;
@@ -220,10 +247,17 @@ protected:
     ItemSpatialTree _masterSpatialTree;
     ItemIDSet _masterNonspatialSet;
 
+    // The bounds of the frame, indexed like _items.  A bound is current if its stamp is the frame's
+    mutable std::vector<Item::Bound> _frameBounds;
+    mutable std::vector<uint32_t> _frameBoundStamps;
+    uint32_t _frameStamp { 1 };
+    void startFrameBounds();
+
     void resetItems(const Transaction::Resets& transactions);
     void resetTransitionFinishedOperator(const Transaction::TransitionFinishedOperators& transactions);
     void removeItems(const Transaction::Removes& transactions);
     void updateItems(const Transaction::Updates& transactions);
+    bool _parallelItemUpdates { false };
 
     void resetTransitionItems(const Transaction::TransitionResets& transactions);
     void removeTransitionItems(const Transaction::TransitionRemoves& transactions);
@@ -0,0 +1,150 @@
+//
+//  TransactionPool.cpp
+//  render/src/render
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TransactionPool.h"
+
+#include <algorithm>
+#include <mutex>
+#include <new>
+#include <vector>
+
+using namespace render;
+
+namespace {
+
+const size_t MIN_BLOCK_SIZE = 64;
+const int NUM_SIZE_CLASSES = 4; // 64, 128, 256 and 512 bytes
+const size_t BATCH_SIZE = 64;
+
+static_assert((MIN_BLOCK_SIZE << (NUM_SIZE_CLASSES - 1)) == TransactionPool::MAX_BLOCK_SIZE, "size classes must reach MAX_BLOCK_SIZE");
+
+int sizeClassFor(size_t size) {
+    int sizeClass = 0;
+    size_t blockSize = MIN_BLOCK_SIZE;
+    while (blockSize < size) {
+        blockSize <<= 1;
+        sizeClass++;
+    }
+    return sizeClass;
+}
+
+size_t blockSizeFor(int sizeClass) {
+    return MIN_BLOCK_SIZE << sizeClass;
+}
+
+// The free blocks shared by every thread, one list per size class
+struct Depot {
+    std::mutex mutex;
+    std::vector<void*> freeBlocks;
+};
+
+Depot* getDepots() {
+    // deliberately leaked: blocks can still be in flight in static transactions while the process exits,
+    // so neither the depots nor the memory behind them are ever given back
+    static Depot* depots = new Depot[NUM_SIZE_CLASSES];
+    return depots;
+}
+
+// set once this thread's cache is gone, for transactions freed later on while the thread exits.  it has no destructor
+// of its own, so it can still be read then
+thread_local bool threadCacheDestroyed = false;
+
+// Each thread's own free blocks, refilled from and spilled to the depot a batch at a time
+struct ThreadCache {
+    std::vector<void*> freeBlocks[NUM_SIZE_CLASSES];
+
+    ~ThreadCache() {
+        Depot* depots = getDepots();
+        for (int i = 0; i < NUM_SIZE_CLASSES; i++) {
+            std::unique_lock<std::mutex> lock(depots[i].mutex);
+            depots[i].freeBlocks.insert(depots[i].freeBlocks.end(), freeBlocks[i].begin(), freeBlocks[i].end());
+            freeBlocks[i].clear();
+        }
+        threadCacheDestroyed = true;
+    }
+
+    void refill(int sizeClass) {
+        auto& blocks = freeBlocks[sizeClass];
+        Depot& depot = getDepots()[sizeClass];
+        {
+            std::unique_lock<std::mutex> lock(depot.mutex);
+            size_t count = std::min(BATCH_SIZE, depot.freeBlocks.size());
+            blocks.insert(blocks.end(), depot.freeBlocks.end() - count, depot.freeBlocks.end());
+            depot.freeBlocks.resize(depot.freeBlocks.size() - count);
+        }
+
+        if (blocks.empty()) {
+            // carve a fresh batch out of one chunk
+            size_t blockSize = blockSizeFor(sizeClass);
+            char* chunk = static_cast<char*>(::operator new(blockSize * BATCH_SIZE));
+            for (size_t i = 0; i < BATCH_SIZE; i++) {
+                blocks.push_back(chunk + i * blockSize);
+            }
+        }
+    }
+
+    void spill(int sizeClass) {
+        auto& blocks = freeBlocks[sizeClass];
+        Depot& depot = getDepots()[sizeClass];
+        std::unique_lock<std::mutex> lock(depot.mutex);
+        depot.freeBlocks.insert(depot.freeBlocks.end(), blocks.end() - BATCH_SIZE, blocks.end());
+        blocks.resize(blocks.size() - BATCH_SIZE);
+    }
+};
+
+thread_local ThreadCache threadCache;
+
+}
+
+void* TransactionPool::allocate(size_t size) {
+    if (size > MAX_BLOCK_SIZE) {
+        return ::operator new(size);
+    }
+
+    int sizeClass = sizeClassFor(size);
+    if (threadCacheDestroyed) {
+        // a whole block, since it can end up back in a depot
+        return ::operator new(blockSizeFor(sizeClass));
+    }
+
+    auto& blocks = threadCache.freeBlocks[sizeClass];
+    if (blocks.empty()) {
+        threadCache.refill(sizeClass);
+    }
+    void* block = blocks.back();
+    blocks.pop_back();
+    return block;
+}
+
+void TransactionPool::deallocate(void* block, size_t size) {
+    if (!block) {
+        return;
+    }
+    if (size > MAX_BLOCK_SIZE) {
+        ::operator delete(block);
+        return;
+    }
+
+    int sizeClass = sizeClassFor(size);
+    if (threadCacheDestroyed) {
+        // most blocks were carved out of a larger chunk, so they can't go back to the heap on their own
+        Depot& depot = getDepots()[sizeClass];
+        std::unique_lock<std::mutex> lock(depot.mutex);
+        depot.freeBlocks.push_back(block);
+        return;
+    }
+
+    auto& blocks = threadCache.freeBlocks[sizeClass];
+    blocks.push_back(block);
+    if (blocks.size() >= 2 * BATCH_SIZE) {
+        threadCache.spill(sizeClass);
+    }
+}
@@ -0,0 +1,53 @@
+//
+//  TransactionPool.h
+//  render/src/render
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_render_TransactionPool_h
+#define hifi_render_TransactionPool_h
+
+#include <cstddef>
+
+namespace render {
+
+// TransactionPool recycles the small blocks that transactions allocate at a high rate: the update functors
+// created for every updateItem() call and the nodes of the scene's transaction log.
+// Blocks are usually allocated on the threads building transactions and freed on the render thread,
+// so each thread keeps a small cache of free blocks and trades them in batches through a shared depot.
+// Blocks larger than MAX_BLOCK_SIZE fall through to the regular heap.
+class TransactionPool {
+public:
+    static const size_t MAX_BLOCK_SIZE = 512;
+
+    static void* allocate(size_t size);
+    static void deallocate(void* block, size_t size);
+};
+
+// Standard allocator over the TransactionPool, for use with std::allocate_shared and friends
+template <class T>
+class TransactionAllocator {
+public:
+    using value_type = T;
+
+    TransactionAllocator() {}
+    template <class U> TransactionAllocator(const TransactionAllocator<U>&) {}
+
+    T* allocate(size_t n) { return static_cast<T*>(TransactionPool::allocate(n * sizeof(T))); }
+    void deallocate(T* block, size_t n) { TransactionPool::deallocate(block, n * sizeof(T)); }
+};
+
+template <class T, class U>
+bool operator==(const TransactionAllocator<T>&, const TransactionAllocator<U>&) { return true; }
+
+template <class T, class U>
+bool operator!=(const TransactionAllocator<T>&, const TransactionAllocator<U>&) { return false; }
+
+}
+
+#endif // hifi_render_TransactionPool_h
@@ -188,12 +188,20 @@ ScriptEnginePointer scriptEngineFactory(ScriptEngine::Context context,
     return engineSP;
 }
 
+// timers are checked once per script frame, so finer ticks than this would not buy any precision
+static const uint64_t TIMER_WHEEL_TICK_USECS = USECS_PER_MSEC;
+
+static uint64_t timerWheelNow() {
+    using namespace std::chrono;
+    return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
 int ScriptEngine::processLevelMaxRetries { ScriptRequest::MAX_RETRIES };
 ScriptEngine::ScriptEngine(Context context, const QString& scriptContents, const QString& fileNameString) :
     BaseScriptEngine(),
     _context(context),
     _scriptContents(scriptContents),
-    _timerFunctionMap(),
+    _timers(TIMER_WHEEL_TICK_USECS, timerWheelNow()),
     _fileNameString(fileNameString),
     _arrayBufferClass(new ArrayBufferClass(this)),
     _assetScriptingInterface(new AssetScriptingInterface(this))
@@ -362,6 +370,8 @@ void ScriptEngine::runDebuggable() {
             return;
         }
 
+        processTimers();
+
         qint64 now = usecTimestampNow();
         // we check for 'now' in the past in case people set their clock back
         if (_lastUpdate < now) {
@@ -1382,6 +1392,15 @@ void ScriptEngine::run() {
             break;
         }
 
+        {
+            PROFILE_RANGE(script, "processTimers");
+            processTimers();
+        }
+
+        if (_isFinished) {
+            break;
+        }
+
         if (!_isFinished && entityScriptingInterface->getEntityPacketSender()->serversExist()) {
             // release the queue of edit entity messages.
             entityScriptingInterface->getEntityPacketSender()->releaseQueuedMessages();
@@ -1452,32 +1471,20 @@ void ScriptEngine::run() {
 // NOTE: This is private because it must be called on the same thread that created the timers, which is why
 // we want to only call it in our own run "shutdown" processing.
 void ScriptEngine::stopAllTimers() {
-    QMutableHashIterator<QTimer*, CallbackData> i(_timerFunctionMap);
+    QList<QObject*> timers = _timerHandles.keys();
     int j {0};
-    while (i.hasNext()) {
-        i.next();
-        QTimer* timer = i.key();
+    for (auto timer : timers) {
         qCDebug(scriptengine) << getFilename() << "stopAllTimers[" << j++ << "]";
         stopTimer(timer);
     }
 }
 
 void ScriptEngine::stopAllTimersForEntityScript(const EntityItemID& entityID) {
-     // We could maintain a separate map of entityID => QTimer, but someone will have to prove to me that it's worth the complexity. -HRS
-    QVector<QTimer*> toDelete;
-    QMutableHashIterator<QTimer*, CallbackData> i(_timerFunctionMap);
-    while (i.hasNext()) {
-        i.next();
-        if (i.value().definingEntityIdentifier != entityID) {
-            continue;
-        }
-        QTimer* timer = i.key();
-        toDelete << timer; // don't delete while we're iterating. save it.
-    }
-    for (auto timer:toDelete) { // now reap 'em
+    // copy, since stopping a timer removes it from the index
+    QSet<QObject*> timers = _timersByEntity.value(entityID);
+    for (auto timer : timers) {
         stopTimer(timer);
     }
-
 }
 
 void ScriptEngine::stop(bool marshal) {
@@ -1530,58 +1537,65 @@ void ScriptEngine::updateMemoryCost(const qint64& deltaSize) {
     }
 }
 
-void ScriptEngine::timerFired() {
+void ScriptEngine::processTimers() {
+    if (_timers.empty()) {
+        return;
+    }
+
     {
         QSharedPointer<ScriptEngines> scriptEngines(_scriptEngines);
         if (!scriptEngines || scriptEngines->isStopped()) {
-            scriptWarningMessage("Script.timerFired() while shutting down is ignored... parent script:" + getFilename());
-            return; // bail early
+            return; // leave the timers alone, stopAllTimers() will clean them up while shutting down
         }
     }
 
-    QTimer* callingTimer = reinterpret_cast<QTimer*>(sender());
-    CallbackData timerData = _timerFunctionMap.value(callingTimer);
-
-    if (!callingTimer->isActive()) {
-        // this timer is done, we can kill it
-        _timerFunctionMap.remove(callingTimer);
-        delete callingTimer;
-    }
-
-    // call the associated JS function, if it exists
-    if (timerData.function.isValid()) {
-        PROFILE_RANGE(script, __FUNCTION__);
-        auto preTimer = p_high_resolution_clock::now();
-        callWithEnvironment(timerData.definingEntityIdentifier, timerData.definingSandboxURL, timerData.function, timerData.function, QScriptValueList());
-        auto postTimer = p_high_resolution_clock::now();
-        auto elapsed = (postTimer - preTimer);
-        _totalTimerExecution += std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
-    } else {
-        qCWarning(scriptengine) << "timerFired -- invalid function" << timerData.function.toVariant().toString();
-    }
+    // every timer that came due since the last frame runs in this one batch, in the order they expired
+    auto now = timerWheelNow();
+    _timers.advance(now, [&](ScriptTimerWheel::TimerID, ScriptTimerData&& timerData, uint64_t expiry) {
+        if (timerData.isSingleShot) {
+            // this timer is done, we can kill it
+            forgetTimer(timerData.handle, timerData.callback.definingEntityIdentifier);
+        } else {
+            // keep the interval's phase, unless we've fallen so far behind that we would fire it again right away
+            uint64_t intervalUsecs = (uint64_t)timerData.intervalMS * USECS_PER_MSEC;
+            uint64_t nextExpiry = expiry + intervalUsecs;
+            if (nextExpiry <= now) {
+                nextExpiry = now + std::max(intervalUsecs, TIMER_WHEEL_TICK_USECS);
+            }
+            _timerHandles[timerData.handle] = _timers.add(nextExpiry, timerData);
+        }
+
+        // call the associated JS function, if it exists
+        if (timerData.callback.function.isValid()) {
+            PROFILE_RANGE(script, "timerFired");
+            auto preTimer = p_high_resolution_clock::now();
+            callWithEnvironment(timerData.callback.definingEntityIdentifier, timerData.callback.definingSandboxURL,
+                                timerData.callback.function, timerData.callback.function, QScriptValueList());
+            auto postTimer = p_high_resolution_clock::now();
+            auto elapsed = (postTimer - preTimer);
+            _totalTimerExecution += std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
+        } else {
+            qCWarning(scriptengine) << "timerFired -- invalid function" << timerData.callback.function.toVariant().toString();
+        }
+    });
 }
 
 QObject* ScriptEngine::setupTimerWithInterval(const QScriptValue& function, int intervalMS, bool isSingleShot) {
-    // create the timer, add it to the map, and start it
-    QTimer* newTimer = new QTimer(this);
-    newTimer->setSingleShot(isSingleShot);
-
-    // The default timer type is not very accurate below about 200ms http://doc.qt.io/qt-5/qt.html#TimerType-enum
-    static const int MIN_TIMEOUT_FOR_COARSE_TIMER = 200;
-    if (intervalMS < MIN_TIMEOUT_FOR_COARSE_TIMER) {
-        newTimer->setTimerType(Qt::PreciseTimer);
-    }
-
-    connect(newTimer, &QTimer::timeout, this, &ScriptEngine::timerFired);
-
-    // make sure the timer stops when the script does
-    connect(this, &ScriptEngine::scriptEnding, newTimer, &QTimer::stop);
+    // the handle is all the script gets to see, the timer itself lives in the wheel
+    QObject* newTimer = new QObject(this);
 
+    ScriptTimerData timerData;
+    timerData.callback = { function, currentEntityIdentifier, currentSandboxURL };
+    timerData.handle = newTimer;
+    timerData.intervalMS = std::max(intervalMS, 0);
+    timerData.isSingleShot = isSingleShot;
 
-    CallbackData timerData = { function, currentEntityIdentifier, currentSandboxURL };
-    _timerFunctionMap.insert(newTimer, timerData);
+    uint64_t expiry = timerWheelNow() + (uint64_t)timerData.intervalMS * USECS_PER_MSEC;
+    _timerHandles.insert(newTimer, _timers.add(expiry, timerData));
+    if (!currentEntityIdentifier.isInvalidID()) {
+        _timersByEntity[currentEntityIdentifier].insert(newTimer);
+    }
 
-    newTimer->start(intervalMS);
     return newTimer;
 }
 
@@ -1605,16 +1619,35 @@ QObject* ScriptEngine::setTimeout(const QScriptValue& function, int timeoutMS) {
     return setupTimerWithInterval(function, timeoutMS, true);
 }
 
-void ScriptEngine::stopTimer(QTimer *timer) {
-    if (_timerFunctionMap.contains(timer)) {
-        timer->stop();
-        _timerFunctionMap.remove(timer);
-        delete timer;
+void ScriptEngine::stopTimer(QObject* timer) {
+    auto it = _timerHandles.find(timer);
+    if (it != _timerHandles.end()) {
+        EntityItemID entityID;
+        auto timerData = _timers.get(it.value());
+        if (timerData) {
+            entityID = timerData->callback.definingEntityIdentifier;
+        }
+        _timers.cancel(it.value());
+        forgetTimer(timer, entityID);
     } else {
-        qCDebug(scriptengine) << "stopTimer -- not in _timerFunctionMap" << timer;
+        qCDebug(scriptengine) << "stopTimer -- not in _timerHandles" << timer;
     }
 }
 
+void ScriptEngine::forgetTimer(QObject* timer, const EntityItemID& entityID) {
+    _timerHandles.remove(timer);
+    if (!entityID.isInvalidID()) {
+        auto it = _timersByEntity.find(entityID);
+        if (it != _timersByEntity.end()) {
+            it->remove(timer);
+            if (it->isEmpty()) {
+                _timersByEntity.erase(it);
+            }
+        }
+    }
+    delete timer;
+}
+
 QUrl ScriptEngine::resolvePath(const QString& include) const {
     QUrl url(include);
     // first lets check to see if it's already a full URL -- or a Windows path like "c:/"
@@ -2601,6 +2634,10 @@ void ScriptEngine::unloadEntityScript(const EntityItemID& entityID, bool shouldR
                 QWriteLocker locker { &_entityScriptsLock };
                 _entityScripts.remove(entityID);
             }
+            {
+                QMutexLocker locker { &_entityScriptCallTimesLock };
+                _entityScriptCallTimes.remove(entityID);
+            }
             emit entityScriptDetailsUpdated();
         } else if (oldDetails.status != EntityScriptStatus::UNLOADED) {
             EntityScriptDetails newDetails;
@@ -2646,6 +2683,10 @@ void ScriptEngine::unloadAllEntityScripts(bool blockingCall) {
         QWriteLocker locker{ &_entityScriptsLock };
         _entityScripts.clear();
     }
+    {
+        QMutexLocker locker{ &_entityScriptCallTimesLock };
+        _entityScriptCallTimes.clear();
+    }
     emit entityScriptDetailsUpdated();
 
 #ifdef DEBUG_ENGINE_STATE
@@ -2690,6 +2731,11 @@ void ScriptEngine::refreshFileScript(const EntityItemID& entityID) {
 // of the code being executed (e.g., if we ever sandbox different entity scripts, or provide different
 // global values for different entity scripts).
 void ScriptEngine::doWithEnvironment(const EntityItemID& entityID, const QUrl& sandboxURL, std::function<void()> operation) {
+    // only the outermost call is timed, so nested calls into other entity scripts are charged to the caller
+    const bool timeCall = !entityID.isNull() && _entityScriptCallDepth == 0;
+    auto callStart = p_high_resolution_clock::now();
+    ++_entityScriptCallDepth;
+
     EntityItemID oldIdentifier = currentEntityIdentifier;
     QUrl oldSandboxURL;
     if (currentSandboxURL.isValid()) oldSandboxURL = currentSandboxURL;
@@ -2707,6 +2753,18 @@ void ScriptEngine::doWithEnvironment(const EntityItemID& entityID, const QUrl& s
     maybeEmitUncaughtException(!entityID.isNull() ? entityID.toString() : __FUNCTION__);
     currentEntityIdentifier = oldIdentifier;
     currentSandboxURL = oldSandboxURL;
+
+    --_entityScriptCallDepth;
+    if (timeCall) {
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(p_high_resolution_clock::now() - callStart);
+        QMutexLocker locker(&_entityScriptCallTimesLock);
+        _entityScriptCallTimes[entityID] += elapsed.count();
+    }
+}
+
+QHash<EntityItemID, quint64> ScriptEngine::getEntityScriptCallTimes() const {
+    QMutexLocker locker(&_entityScriptCallTimesLock);
+    return _entityScriptCallTimes;
 }
 
 void ScriptEngine::callWithEnvironment(const EntityItemID& entityID, const QUrl& sandboxURL, QScriptValue function, QScriptValue thisObject, QScriptValueList args) {
@@ -15,6 +15,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include <QtCore/QMutex>
 #include <QtCore/QObject>
 #include <QtCore/QUrl>
 #include <QtCore/QSet>
@@ -45,6 +46,7 @@
 #include "ConsoleScriptingInterface.h"
 #include "SettingHandle.h"
 #include "Profile.h"
+#include "TimerWheel.h"
 
 class QScriptEngineDebugger;
 
@@ -65,6 +67,14 @@ public:
     QUrl definingSandboxURL;
 };
 
+class ScriptTimerData {
+public:
+    CallbackData callback;
+    QObject* handle { nullptr };
+    int intervalMS { 0 };
+    bool isSingleShot { true };
+};
+
 class DeferredLoadEntity {
 public:
     EntityItemID entityID;
@@ -491,7 +501,7 @@ public:
      *     Script.clearInterval(timer);
      * }, 10000);
      */
-    Q_INVOKABLE void clearInterval(QObject* timer) { stopTimer(reinterpret_cast<QTimer*>(timer)); }
+    Q_INVOKABLE void clearInterval(QObject* timer) { stopTimer(timer); }
 
     /**jsdoc
      * Stops a timeout timer set by {@link Script.setTimeout|setTimeout}.
@@ -506,7 +516,7 @@ public:
      * // Uncomment the following line to stop the timer from firing.
      * //Script.clearTimeout(timer);
      */
-    Q_INVOKABLE void clearTimeout(QObject* timer) { stopTimer(reinterpret_cast<QTimer*>(timer)); }
+    Q_INVOKABLE void clearTimeout(QObject* timer) { stopTimer(timer); }
 
     /**jsdoc
      * Prints a message to the program log and emits {@link Script.printedMessage}.
@@ -678,6 +688,10 @@ public:
     bool getEntityScriptDetails(const EntityItemID& entityID, EntityScriptDetails &details) const;
     bool hasEntityScriptDetails(const EntityItemID& entityID) const;
 
+    // Total time, in microseconds, this engine has spent running code on behalf of each entity script
+    // (preload, method calls, timers and event handlers).  Safe to call from any thread.
+    QHash<EntityItemID, quint64> getEntityScriptCallTimes() const;
+
     void setScriptEngines(QSharedPointer<ScriptEngines>& scriptEngines) { _scriptEngines = scriptEngines; }
 
 public slots:
@@ -903,7 +917,7 @@ protected:
     Q_INVOKABLE QString _requireResolve(const QString& moduleId, const QString& relativeTo = QString());
 
     QString logException(const QScriptValue& exception);
-    void timerFired();
+    void processTimers();
     void stopAllTimers();
     void stopAllTimersForEntityScript(const EntityItemID& entityID);
     void refreshFileScript(const EntityItemID& entityID);
@@ -912,7 +926,8 @@ protected:
     void setParentURL(const QString& parentURL) { _parentURL = parentURL; }
 
     QObject* setupTimerWithInterval(const QScriptValue& function, int intervalMS, bool isSingleShot);
-    void stopTimer(QTimer* timer);
+    void stopTimer(QObject* timer);
+    void forgetTimer(QObject* timer, const EntityItemID& entityID);
 
     QHash<EntityItemID, RegisteredEventHandlers> _registeredHandlers;
     void forwardHandlerCall(const EntityItemID& entityID, const QString& eventName, QScriptValueList eventHanderArgs);
@@ -942,7 +957,12 @@ protected:
     std::atomic<bool> _isRunning { false };
     std::atomic<bool> _isStopping { false };
     bool _isInitialized { false };
-    QHash<QTimer*, CallbackData> _timerFunctionMap;
+    // all of this engine's timers live in one wheel, advanced once per frame of run().
+    // Scripts hold on to a small QObject handle per timer, which maps to the timer's current slot in the wheel
+    using ScriptTimerWheel = TimerWheel<ScriptTimerData>;
+    ScriptTimerWheel _timers;
+    QHash<QObject*, ScriptTimerWheel::TimerID> _timerHandles;
+    QHash<EntityItemID, QSet<QObject*>> _timersByEntity;
     QSet<QUrl> _includedURLs;
     mutable QReadWriteLock _entityScriptsLock { QReadWriteLock::Recursive };
     QHash<EntityItemID, EntityScriptDetails> _entityScripts;
@@ -974,6 +994,10 @@ protected:
 
     std::chrono::microseconds _totalTimerExecution { 0 };
 
+    mutable QMutex _entityScriptCallTimesLock;
+    QHash<EntityItemID, quint64> _entityScriptCallTimes;
+    int _entityScriptCallDepth { 0 };
+
     static const QString _SETTINGS_ENABLE_EXTENDED_MODULE_COMPAT;
     static const QString _SETTINGS_ENABLE_EXTENDED_EXCEPTIONS;
 
@@ -0,0 +1,174 @@
+//
+//  PrioritySortUtil.cpp
+//  libraries/shared/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PrioritySortUtil.h"
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#include <xmmintrin.h>
+#endif
+
+using namespace PrioritySortUtil;
+
+namespace {
+
+// what the priority math needs of a view
+struct ViewParameters {
+    glm::vec3 position;
+    glm::vec3 direction;
+    float keyholeRadius;
+    float farClip;
+    float cosAngle;
+    float sinAngle;
+};
+
+struct Weights {
+    float angular;
+    float center;
+};
+
+// ConicalViewFrustum::intersects(), given the projection of the offset on the view direction
+inline bool isInView(const ViewParameters& view, float projection, float distance, float radius) {
+    if (distance < view.keyholeRadius + radius) {
+        return true;
+    }
+    if (distance > view.farClip + radius) {
+        return false;
+    }
+    return projection > sqrtf(distance * distance - radius * radius) * view.cosAngle - radius * view.sinAngle;
+}
+
+// one thing at a time, for what doesn't fill a whole vector
+inline void computeSpatialPriority(const ViewParameters& view, const Weights& weights, float x, float y, float z,
+                                   float radius, float& inView, float& outOfView) {
+    float dx = x - view.position.x;
+    float dy = y - view.position.y;
+    float dz = z - view.position.z;
+    float distance = sqrtf(dx * dx + dy * dy + dz * dz) + 0.001f; // add 1mm to avoid divide by zero
+    // Other item's angle from view centre:
+    float projection = dx * view.direction.x + dy * view.direction.y + dz * view.direction.z;
+    float cosineAngle = projection / distance;
+    if (cosineAngle > 0.0f) {
+        cosineAngle = sqrtf(cosineAngle);
+    }
+    float angularSize = radius / distance;
+    float spatial = weights.angular * angularSize + weights.center * cosineAngle;
+
+    if (distance - radius > view.keyholeRadius && !isInView(view, projection, distance, radius)) {
+        outOfView = std::max(outOfView, spatial);
+    } else {
+        inView = std::max(inView, spatial);
+    }
+}
+
+//
+// on x86 architecture, assume that SSE2 is present
+//
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+struct ViewVectors {
+    ViewVectors(const ViewParameters& view) :
+        keyholeRadius(_mm_set1_ps(view.keyholeRadius)),
+        farClip(_mm_set1_ps(view.farClip)),
+        cosAngle(_mm_set1_ps(view.cosAngle)),
+        sinAngle(_mm_set1_ps(view.sinAngle)) {}
+
+    __m128 keyholeRadius;
+    __m128 farClip;
+    __m128 cosAngle;
+    __m128 sinAngle;
+};
+
+inline __m128 isInView(const ViewVectors& view, __m128 projection, __m128 distance, __m128 radius) {
+    __m128 isInKeyhole = _mm_cmplt_ps(distance, _mm_add_ps(view.keyholeRadius, radius));
+    __m128 isPastFarClip = _mm_cmpgt_ps(distance, _mm_add_ps(view.farClip, radius));
+    // NaN where the thing contains the view, but that's inside the keyhole
+    __m128 edge = _mm_sqrt_ps(_mm_sub_ps(_mm_mul_ps(distance, distance), _mm_mul_ps(radius, radius)));
+    __m128 isInCone = _mm_cmpgt_ps(projection, _mm_sub_ps(_mm_mul_ps(edge, view.cosAngle), _mm_mul_ps(radius, view.sinAngle)));
+    return _mm_or_ps(isInKeyhole, _mm_andnot_ps(isPastFarClip, isInCone));
+}
+
+inline __m128 blend(__m128 mask, __m128 ifTrue, __m128 ifFalse) {
+    return _mm_or_ps(_mm_and_ps(mask, ifTrue), _mm_andnot_ps(mask, ifFalse));
+}
+
+// Four things at a time.  sqrt and divide are exact in SSE and the operations are the same, so the priorities come out
+// the same as one at a time.
+void computeSpatialPriorities(const ViewParameters& view, const Weights& weights, size_t numThings,
+                              const float* x, const float* y, const float* z, const float* radius,
+                              float* inView, float* outOfView) {
+    const ViewVectors viewVectors(view);
+    const __m128 viewX = _mm_set1_ps(view.position.x);
+    const __m128 viewY = _mm_set1_ps(view.position.y);
+    const __m128 viewZ = _mm_set1_ps(view.position.z);
+    const __m128 directionX = _mm_set1_ps(view.direction.x);
+    const __m128 directionY = _mm_set1_ps(view.direction.y);
+    const __m128 directionZ = _mm_set1_ps(view.direction.z);
+    const __m128 angularWeight = _mm_set1_ps(weights.angular);
+    const __m128 centerWeight = _mm_set1_ps(weights.center);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 avoidDivideByZero = _mm_set1_ps(0.001f);
+
+    size_t i = 0;
+    for (; i + 4 <= numThings; i += 4) {
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(x + i), viewX);
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(y + i), viewY);
+        __m128 dz = _mm_sub_ps(_mm_loadu_ps(z + i), viewZ);
+        __m128 r = _mm_loadu_ps(radius + i);
+
+        __m128 lengthSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+        __m128 distance = _mm_add_ps(_mm_sqrt_ps(lengthSquared), avoidDivideByZero);
+        __m128 projection = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, directionX), _mm_mul_ps(dy, directionY)),
+                                       _mm_mul_ps(dz, directionZ));
+        __m128 cosineAngle = _mm_div_ps(projection, distance);
+        cosineAngle = blend(_mm_cmpgt_ps(cosineAngle, zero), _mm_sqrt_ps(_mm_max_ps(cosineAngle, zero)), cosineAngle);
+        __m128 angularSize = _mm_div_ps(r, distance);
+        __m128 spatial = _mm_add_ps(_mm_mul_ps(angularWeight, angularSize), _mm_mul_ps(centerWeight, cosineAngle));
+
+        __m128 isOutsideKeyhole = _mm_cmpgt_ps(_mm_sub_ps(distance, r), viewVectors.keyholeRadius);
+        __m128 isOut = _mm_andnot_ps(isInView(viewVectors, projection, distance, r), isOutsideKeyhole);
+
+        __m128 in = _mm_loadu_ps(inView + i);
+        __m128 out = _mm_loadu_ps(outOfView + i);
+        _mm_storeu_ps(inView + i, blend(isOut, in, _mm_max_ps(in, spatial)));
+        _mm_storeu_ps(outOfView + i, blend(isOut, _mm_max_ps(out, spatial), out));
+    }
+    for (; i < numThings; ++i) {
+        computeSpatialPriority(view, weights, x[i], y[i], z[i], radius[i], inView[i], outOfView[i]);
+    }
+}
+
+#else
+
+void computeSpatialPriorities(const ViewParameters& view, const Weights& weights, size_t numThings,
+                              const float* x, const float* y, const float* z, const float* radius,
+                              float* inView, float* outOfView) {
+    for (size_t i = 0; i < numThings; ++i) {
+        computeSpatialPriority(view, weights, x[i], y[i], z[i], radius[i], inView[i], outOfView[i]);
+    }
+}
+
+#endif
+
+}
+
+void SpatialPriorityBatch::compute(const ConicalViewFrustums& views, float angularWeight, float centerWeight) {
+    const size_t numThings = size();
+    _inView.assign(numThings, -std::numeric_limits<float>::infinity());
+    _outOfView.assign(numThings, -std::numeric_limits<float>::infinity());
+
+    const Weights weights { angularWeight, centerWeight };
+    for (const auto& view : views) {
+        const ViewParameters parameters { view.getPosition(), view.getDirection(), view.getRadius(), view.getFarClip(),
+                                          view.getCosAngle(), view.getSinAngle() };
+        computeSpatialPriorities(parameters, weights, numThings, _x.data(), _y.data(), _z.data(), _radius.data(),
+                                 _inView.data(), _outOfView.data());
+    }
+}
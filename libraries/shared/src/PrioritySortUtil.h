@@ -11,9 +11,14 @@
 #ifndef hifi_PrioritySortUtil_h
 #define hifi_PrioritySortUtil_h
 
+#include <algorithm>
+#include <limits>
+#include <vector>
+
 #include <glm/glm.hpp>
 
 #include "NumericalConstants.h"
+#include "SharedUtil.h"
 #include "shared/ConicalViewFrustum.h"
 
 //   PrioritySortUtil is a helper for sorting 3D things relative to a ViewFrustum.
@@ -27,6 +32,8 @@ namespace PrioritySortUtil {
     constexpr float DEFAULT_CENTER_COEF { 0.5f };
     constexpr float DEFAULT_AGE_COEF { 0.25f };
 
+    const float MIN_RADIUS = 0.1f; // WORKAROUND for zero size objects (we still want them to sort by distance)
+
     class Sortable {
     public:
         virtual ~Sortable() = default;
@@ -41,6 +48,60 @@ namespace PrioritySortUtil {
         float _priority { 0.0f };
     };
 
+    // The part of a priority that only depends on where a thing is relative to the views:
+    // angularWeight * angularSize + centerWeight * sqrt(cosine of the angle from the view direction), the best of it over
+    // the views the thing is in and over the views it is out of.
+    struct SpatialPriority {
+        float inView { -std::numeric_limits<float>::infinity() };
+        float outOfView { -std::numeric_limits<float>::infinity() };
+    };
+
+    // priority = spatial priority * (age + 1) + ageWeight * age, less OUT_OF_VIEW_PENALTY if not in any view
+    inline float computePriority(const SpatialPriority& spatial, float age, float ageWeight) {
+        float agePriority = ageWeight * age;
+        float priority = std::numeric_limits<float>::min();
+        priority = std::max(priority, spatial.inView * (age + 1.0f) + agePriority);
+        priority = std::max(priority, spatial.outOfView * (age + 1.0f) + agePriority + OUT_OF_VIEW_PENALTY);
+        return priority;
+    }
+
+    // Things to compute spatial priorities for, kept as arrays so that the math over them vectorizes.
+    class SpatialPriorityBatch {
+    public:
+        size_t size() const { return _x.size(); }
+        void resize(size_t num) {
+            _x.resize(num);
+            _y.resize(num);
+            _z.resize(num);
+            _radius.resize(num);
+        }
+        void reserve(size_t num) {
+            _x.reserve(num);
+            _y.reserve(num);
+            _z.reserve(num);
+            _radius.reserve(num);
+        }
+        void set(size_t i, const glm::vec3& position, float radius) {
+            _x[i] = position.x;
+            _y[i] = position.y;
+            _z[i] = position.z;
+            _radius[i] = radius;
+        }
+
+        SpatialPriority getPriority(size_t i) const { return { _inView[i], _outOfView[i] }; }
+
+        void compute(const ConicalViewFrustums& views, float angularWeight, float centerWeight);
+
+    private:
+        std::vector<float> _x;
+        std::vector<float> _y;
+        std::vector<float> _z;
+        std::vector<float> _radius;
+
+        std::vector<float> _inView;
+        std::vector<float> _outOfView;
+    };
+
     template <typename T>
     class PriorityQueue {
     public:
@@ -61,70 +122,62 @@ namespace PrioritySortUtil {
         }
 
         size_t size() const { return _vector.size(); }
+        // priorities are computed in one batch, when the queue is next sorted
         void push(T thing) {
-            thing.setPriority(computePriority(thing));
             _vector.push_back(thing);
         }
         void reserve(size_t num) {
             _vector.reserve(num);
+            _batch.reserve(num);
+            _batchAges.reserve(num);
         }
+        // sorts only the numToSort highest priority things to the front, if numToSort is given
         const std::vector<T>& getSortedVector(int numToSort = 0) {
-            if (numToSort == 0 || numToSort >= (int)_vector.size()) {
-                std::sort(_vector.begin(), _vector.end(),
-                    [](const T& left, const T& right) { return left.getPriority() > right.getPriority(); });
+            computePriorities();
+
+            auto higherPriority = [](const T& left, const T& right) { return left.getPriority() > right.getPriority(); };
+            if (numToSort <= 0 || numToSort >= (int)_vector.size()) {
+                std::sort(_vector.begin(), _vector.end(), higherPriority);
             } else {
-                std::partial_sort(_vector.begin(), _vector.begin() + numToSort, _vector.end(),
-                    [](const T& left, const T& right) { return left.getPriority() > right.getPriority(); });
+                // select the top numToSort in linear time, then sort only those
+                std::nth_element(_vector.begin(), _vector.begin() + numToSort, _vector.end(), higherPriority);
+                std::sort(_vector.begin(), _vector.begin() + numToSort, higherPriority);
             }
             return _vector;
         }
 
     private:
 
-        float computePriority(const T& thing) const {
-            float priority = std::numeric_limits<float>::min();
-
-            for (const auto& view : _views) {
-                priority = std::max(priority, computePriority(view, thing));
+        void computePriorities() {
+            if (_numPrioritized == _vector.size()) {
+                return;
             }
-
-            return priority;
-        }
-
-        float computePriority(const ConicalViewFrustum& view, const T& thing) const {
             // priority = weighted linear combination of multiple values:
             //   (a) angular size
             //   (b) proximity to center of view
             //   (c) time since last update
             // where the relative "weights" are tuned to scale the contributing values into units of "priority".
-
-            glm::vec3 position = thing.getPosition();
-            glm::vec3 offset = position - view.getPosition();
-            float distance = glm::length(offset) + 0.001f; // add 1mm to avoid divide by zero
-            const float MIN_RADIUS = 0.1f; // WORKAROUND for zero size objects (we still want them to sort by distance)
-            float radius = glm::max(thing.getRadius(), MIN_RADIUS);
-            // Other item's angle from view centre:
-            float cosineAngle = glm::dot(offset, view.getDirection()) / distance;
-            if (cosineAngle > 0.0f) {
-                cosineAngle = std::sqrt(cosineAngle);
+            const size_t numToPrioritize = _vector.size() - _numPrioritized;
+            _batch.resize(numToPrioritize);
+            _batchAges.resize(numToPrioritize);
+            for (size_t i = 0; i < numToPrioritize; ++i) {
+                const T& thing = _vector[_numPrioritized + i];
+                _batch.set(i, thing.getPosition(), glm::max(thing.getRadius(), MIN_RADIUS));
+                _batchAges[i] = float((_usecCurrentTime - thing.getTimestamp()) / USECS_PER_SECOND);
             }
-            float age = float((_usecCurrentTime - thing.getTimestamp()) / USECS_PER_SECOND);
-
-            // the "age" term accumulates at the sum of all weights
-            float angularSize = radius / distance;
-            float priority = (_angularWeight * angularSize + _centerWeight * cosineAngle) * (age + 1.0f) + _ageWeight * age;
 
-            // decrement priority of things outside keyhole
-            if (distance - radius > view.getRadius()) {
-                if (!view.intersects(offset, distance, radius)) {
-                    priority += OUT_OF_VIEW_PENALTY;
-                }
+            _batch.compute(_views, _angularWeight, _centerWeight);
+            for (size_t i = 0; i < _batch.size(); ++i) {
+                _vector[_numPrioritized + i].setPriority(computePriority(_batch.getPriority(i), _batchAges[i], _ageWeight));
             }
-            return priority;
+            _numPrioritized = _vector.size();
         }
 
         ConicalViewFrustums _views;
         std::vector<T> _vector;
+        size_t _numPrioritized { 0 };
+        SpatialPriorityBatch _batch;
+        std::vector<float> _batchAges;
         float _angularWeight { DEFAULT_ANGULAR_COEF };
         float _centerWeight { DEFAULT_CENTER_COEF };
         float _ageWeight { DEFAULT_AGE_COEF };
@@ -52,6 +52,12 @@ extern "C" FILE * __cdecl __iob_func(void) {
 #include <cerrno>
 #endif
 
+#ifdef Q_OS_LINUX
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/sysinfo.h>
+#endif
+
 #include <QtCore/QDebug>
 #include <QDateTime>
 #include <QElapsedTimer>
@@ -880,6 +886,38 @@ bool getMemoryInfo(MemoryInfo& info) {
     info.processUsedMemoryBytes = pmc.PrivateUsage;
     info.processPeakUsedMemoryBytes = pmc.PeakPagefileUsage;
 
+    return true;
+#elif defined(Q_OS_LINUX)
+    struct sysinfo si;
+    if (sysinfo(&si) != 0) {
+        return false;
+    }
+
+    info.totalMemoryBytes = (uint64_t)si.totalram * si.mem_unit;
+    info.availMemoryBytes = (uint64_t)si.freeram * si.mem_unit;
+    info.usedMemoryBytes = info.totalMemoryBytes - info.availMemoryBytes;
+
+    // resident pages are the second field
+    FILE* statm = fopen("/proc/self/statm", "r");
+    if (!statm) {
+        return false;
+    }
+    unsigned long long size = 0;
+    unsigned long long resident = 0;
+    int numRead = fscanf(statm, "%llu %llu", &size, &resident);
+    fclose(statm);
+    if (numRead != 2) {
+        return false;
+    }
+    info.processUsedMemoryBytes = (uint64_t)resident * sysconf(_SC_PAGESIZE);
+
+    // the peak resident size, in kilobytes
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return false;
+    }
+    info.processPeakUsedMemoryBytes = (uint64_t)usage.ru_maxrss * 1024;
+
     return true;
 #endif
 
@@ -0,0 +1,319 @@
+//
+//  TimerWheel.h
+//  libraries/shared/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_TimerWheel_h
+#define hifi_TimerWheel_h
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// TimerWheel is a hierarchical timing wheel: O(1) add and cancel, with expired timers handed back in
+// batches whenever the owner calls advance().  It has no thread or clock of its own, so the owner
+// decides the resolution (tickUsecs) and when time moves on, e.g. once per frame of a script loop.
+//
+// Timers are identified by a TimerID that stays unique for the life of the wheel, so cancelling
+// a timer that already fired is a harmless no-op.  Not thread safe.
+template <typename T>
+class TimerWheel {
+public:
+    using TimerID = uint64_t;
+    static constexpr TimerID INVALID_TIMER_ID = 0;
+
+    TimerWheel(uint64_t tickUsecs, uint64_t now) : _tickUsecs(tickUsecs > 0 ? tickUsecs : 1) {
+        _currentTick = toTick(now);
+        _nodes.resize(NUM_BUCKETS);
+        for (uint32_t i = 0; i < NUM_BUCKETS; i++) {
+            _nodes[i].prev = i;
+            _nodes[i].next = i;
+        }
+    }
+
+    uint64_t getTickUsecs() const { return _tickUsecs; }
+    size_t size() const { return _numActive; }
+    bool empty() const { return _numActive == 0; }
+
+    // schedules payload to be handed back by the first advance() at or after expiry (in usecs)
+    TimerID add(uint64_t expiry, T payload) {
+        uint32_t index = allocateNode();
+        Node& node = _nodes[index];
+        node.expiry = expiry;
+        node.expiryTick = toTick(expiry);
+        node.payload = std::move(payload);
+        node.active = true;
+        link(index);
+        _numActive++;
+        return makeID(index, node.generation);
+    }
+
+    bool cancel(TimerID id) {
+        uint32_t index = findNode(id);
+        if (index == NO_NODE) {
+            return false;
+        }
+        unlink(index);
+        releaseNode(index);
+        return true;
+    }
+
+    bool isActive(TimerID id) const { return findNode(id) != NO_NODE; }
+
+    T* get(TimerID id) {
+        uint32_t index = findNode(id);
+        return index != NO_NODE ? &_nodes[index].payload : nullptr;
+    }
+
+    // The earliest time (in usecs) at which advance() could have something to do, or NO_EXPIRY when empty.
+    // Timers still sitting in the coarser levels only count from when they cascade down, so this can be
+    // earlier than the first real expiry: an owner sleeping until then just wakes up and asks again.
+    static constexpr uint64_t NO_EXPIRY = UINT64_MAX;
+    uint64_t getNextExpiry() const {
+        if (_numActive == 0) {
+            return NO_EXPIRY;
+        }
+
+        uint64_t nextTick = NO_EXPIRY;
+        for (uint64_t tick = _currentTick; tick < _currentTick + LEVEL0_SLOTS; tick++) {
+            if (!isBucketEmpty(bucketFor(0, (uint32_t)(tick & LEVEL0_MASK)))) {
+                nextTick = tick;
+                break;
+            }
+        }
+
+        for (int level = 1; level < NUM_LEVELS; level++) {
+            // a slot of this level cascades on the first tick of its span
+            uint64_t span = (uint64_t)1 << (LEVEL0_BITS + (level - 1) * LEVELN_BITS);
+            uint64_t firstBoundary = (_currentTick + span - 1) / span * span;
+            for (uint64_t boundary = firstBoundary; boundary < firstBoundary + LEVELN_SLOTS * span; boundary += span) {
+                if (boundary >= nextTick) {
+                    break;
+                }
+                if (!isBucketEmpty(bucketFor(level, levelIndex(boundary, level)))) {
+                    nextTick = boundary;
+                    break;
+                }
+            }
+        }
+        return nextTick * _tickUsecs;
+    }
+
+    // Hands every timer due at or before now to onExpired(TimerID, T&& payload, uint64_t expiry), in tick order.
+    // The callback may add or cancel timers, including ones that are due in this same batch.
+    template <typename F>
+    size_t advance(uint64_t now, F&& onExpired) {
+        uint64_t targetTick = now / _tickUsecs;
+        size_t numExpired = 0;
+
+        while (_currentTick <= targetTick) {
+            if (_numActive == 0) {
+                // nothing to cascade or fire, jump straight to the end
+                _currentTick = targetTick + 1;
+                break;
+            }
+
+            uint32_t slot = (uint32_t)(_currentTick & LEVEL0_MASK);
+            if (slot == 0) {
+                // the first level wrapped, pull the next chunk of timers down from the coarser levels
+                for (int level = 1; level < NUM_LEVELS; level++) {
+                    uint32_t levelSlot = levelIndex(_currentTick, level);
+                    cascade(bucketFor(level, levelSlot));
+                    if (levelSlot != 0) {
+                        break;
+                    }
+                }
+            }
+
+            // move the whole slot aside first, so timers added by the callbacks don't land in the batch
+            splice(bucketFor(0, slot), EXPIRING_BUCKET);
+            _currentTick++;
+
+            while (_nodes[EXPIRING_BUCKET].next != EXPIRING_BUCKET) {
+                uint32_t index = _nodes[EXPIRING_BUCKET].next;
+                unlink(index);
+
+                Node& node = _nodes[index];
+                if (node.expiryTick >= _currentTick) {
+                    // parked in the last level because it was further out than the wheel spans
+                    link(index);
+                    continue;
+                }
+
+                TimerID id = makeID(index, node.generation);
+                uint64_t expiry = node.expiry;
+                T payload = std::move(node.payload);
+                releaseNode(index);
+
+                onExpired(id, std::move(payload), expiry);
+                numExpired++;
+            }
+        }
+        return numExpired;
+    }
+
+private:
+    static constexpr int LEVEL0_BITS = 8;
+    static constexpr int LEVELN_BITS = 6;
+    static constexpr int NUM_LEVELS = 4;
+    static constexpr uint32_t LEVEL0_SLOTS = 1 << LEVEL0_BITS;
+    static constexpr uint32_t LEVELN_SLOTS = 1 << LEVELN_BITS;
+    static constexpr uint64_t LEVEL0_MASK = LEVEL0_SLOTS - 1;
+    static constexpr uint64_t LEVELN_MASK = LEVELN_SLOTS - 1;
+    static constexpr uint64_t MAX_SPAN_TICKS = (uint64_t)1 << (LEVEL0_BITS + (NUM_LEVELS - 1) * LEVELN_BITS);
+
+    // the first nodes are list sentinels: one per bucket, then one for the batch being expired
+    static constexpr uint32_t NUM_WHEEL_BUCKETS = LEVEL0_SLOTS + (NUM_LEVELS - 1) * LEVELN_SLOTS;
+    static constexpr uint32_t EXPIRING_BUCKET = NUM_WHEEL_BUCKETS;
+    static constexpr uint32_t NUM_BUCKETS = NUM_WHEEL_BUCKETS + 1;
+    static constexpr uint32_t NO_NODE = (uint32_t)-1;
+
+    struct Node {
+        uint32_t prev { NO_NODE };
+        uint32_t next { NO_NODE };
+        uint32_t generation { 0 };
+        bool active { false };
+        uint64_t expiryTick { 0 };
+        uint64_t expiry { 0 };
+        T payload {};
+    };
+
+    uint64_t toTick(uint64_t time) const { return (time + _tickUsecs - 1) / _tickUsecs; }
+
+    static uint32_t levelIndex(uint64_t tick, int level) {
+        return (uint32_t)((tick >> (LEVEL0_BITS + (level - 1) * LEVELN_BITS)) & LEVELN_MASK);
+    }
+
+    static uint32_t bucketFor(int level, uint32_t slot) {
+        return level == 0 ? slot : LEVEL0_SLOTS + (level - 1) * LEVELN_SLOTS + slot;
+    }
+
+    static TimerID makeID(uint32_t index, uint32_t generation) {
+        // generation starts at one, so a valid ID is never INVALID_TIMER_ID
+        return ((TimerID)generation << 32) | index;
+    }
+
+    bool isBucketEmpty(uint32_t bucket) const { return _nodes[bucket].next == bucket; }
+
+    uint32_t findNode(TimerID id) const {
+        uint32_t index = (uint32_t)(id & 0xFFFFFFFF);
+        uint32_t generation = (uint32_t)(id >> 32);
+        if (index < NUM_BUCKETS || index >= _nodes.size()) {
+            return NO_NODE;
+        }
+        const Node& node = _nodes[index];
+        return (node.active && node.generation == generation) ? index : NO_NODE;
+    }
+
+    uint32_t allocateNode() {
+        uint32_t index;
+        if (!_freeNodes.empty()) {
+            index = _freeNodes.back();
+            _freeNodes.pop_back();
+        } else {
+            index = (uint32_t)_nodes.size();
+            _nodes.emplace_back();
+        }
+        _nodes[index].generation++;
+        return index;
+    }
+
+    void releaseNode(uint32_t index) {
+        Node& node = _nodes[index];
+        assert(node.active);
+        node.active = false;
+        node.payload = T();
+        _freeNodes.push_back(index);
+        _numActive--;
+    }
+
+    void link(uint32_t index) {
+        uint64_t expiryTick = _nodes[index].expiryTick;
+        uint32_t bucket;
+        if (expiryTick < _currentTick) {
+            // already due, fire on the next tick
+            bucket = bucketFor(0, (uint32_t)(_currentTick & LEVEL0_MASK));
+        } else {
+            uint64_t delta = expiryTick - _currentTick;
+            if (delta >= MAX_SPAN_TICKS) {
+                // too far out, park it at the end of the wheel and re-link it when it comes around
+                expiryTick = _currentTick + MAX_SPAN_TICKS - 1;
+                delta = MAX_SPAN_TICKS - 1;
+            }
+
+            if (delta < LEVEL0_SLOTS) {
+                bucket = bucketFor(0, (uint32_t)(expiryTick & LEVEL0_MASK));
+            } else {
+                int level = 1;
+                while (level < NUM_LEVELS - 1 && delta >= ((uint64_t)1 << (LEVEL0_BITS + level * LEVELN_BITS))) {
+                    level++;
+                }
+                bucket = bucketFor(level, levelIndex(expiryTick, level));
+            }
+        }
+        pushBack(bucket, index);
+    }
+
+    void pushBack(uint32_t bucket, uint32_t index) {
+        Node& sentinel = _nodes[bucket];
+        Node& node = _nodes[index];
+        node.prev = sentinel.prev;
+        node.next = bucket;
+        _nodes[sentinel.prev].next = index;
+        sentinel.prev = index;
+    }
+
+    void unlink(uint32_t index) {
+        Node& node = _nodes[index];
+        _nodes[node.prev].next = node.next;
+        _nodes[node.next].prev = node.prev;
+        node.prev = NO_NODE;
+        node.next = NO_NODE;
+    }
+
+    // moves every node of one bucket to the end of another
+    void splice(uint32_t fromBucket, uint32_t toBucket) {
+        Node& from = _nodes[fromBucket];
+        if (from.next == fromBucket) {
+            return;
+        }
+        uint32_t first = from.next;
+        uint32_t last = from.prev;
+        from.next = fromBucket;
+        from.prev = fromBucket;
+
+        Node& to = _nodes[toBucket];
+        _nodes[to.prev].next = first;
+        _nodes[first].prev = to.prev;
+        _nodes[last].next = toBucket;
+        to.prev = last;
+    }
+
+    void cascade(uint32_t bucket) {
+        uint32_t index = _nodes[bucket].next;
+        _nodes[bucket].next = bucket;
+        _nodes[bucket].prev = bucket;
+        while (index != bucket) {
+            uint32_t next = _nodes[index].next;
+            link(index);
+            index = next;
+        }
+    }
+
+    uint64_t _tickUsecs;
+    uint64_t _currentTick { 0 };
+    size_t _numActive { 0 };
+    std::vector<Node> _nodes;
+    std::vector<uint32_t> _freeNodes;
+};
+
+#endif // hifi_TimerWheel_h
@@ -117,6 +117,8 @@ protected:
     bool _isEnabled{ true };
 
     uint8_t _branch { 0 };
+
+    bool _isParallel { false };
 public:
     bool _isTask{ false };
     bool _isSwitch{ false };
@@ -222,6 +224,11 @@ public:
     uint8_t getBranch() const { return _branch; }
     void setBranch(uint8_t index);
 
+    // Whether a task runs its jobs concurrently, each as soon as the jobs it takes input from are done.
+    // Only for tasks whose jobs share nothing but their inputs and outputs.
+    bool isParallel() const { return _isParallel; }
+    void setParallel(bool parallel) { _isParallel = parallel; }
+
 public slots:
 
     /**jsdoc
@@ -10,8 +10,41 @@
 //
 #include "Task.h"
 
+#include <memory>
+#include <unordered_set>
+
+#include <tbb/task_group.h>
+
 using namespace task;
 
+namespace {
+
+using VaryingIDs = std::unordered_set<const void*>;
+
+// a varying and the varyings it holds, if it is a set of them
+void collectVaryingIDs(const Varying& varying, VaryingIDs& ids) {
+    if (varying.isNull()) {
+        return;
+    }
+    ids.insert(varying.id());
+    for (uint8_t i = 0; i < varying.length(); i++) {
+        collectVaryingIDs(varying[i], ids);
+    }
+}
+
+bool intersect(const VaryingIDs& left, const VaryingIDs& right) {
+    const auto& smaller = left.size() < right.size() ? left : right;
+    const auto& larger = left.size() < right.size() ? right : left;
+    for (auto id : smaller) {
+        if (larger.find(id) != larger.end()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}
+
 JobContext::JobContext() {
 }
 
@@ -29,3 +62,49 @@ void TaskFlow::abortTask() {
 bool TaskFlow::doAbortTask() const {
     return _doAbortTask;
 }
+
+void JobGraph::build(const std::vector<Varying>& inputs, const std::vector<Varying>& outputs) {
+    size_t numJobs = inputs.size();
+    std::vector<VaryingIDs> reads(numJobs);
+    std::vector<VaryingIDs> writes(numJobs);
+    for (size_t i = 0; i < numJobs; i++) {
+        collectVaryingIDs(inputs[i], reads[i]);
+        collectVaryingIDs(outputs[i], writes[i]);
+    }
+
+    _dependents.assign(numJobs, std::vector<size_t>());
+    _numDependencies.assign(numJobs, 0);
+    for (size_t job = 0; job < numJobs; job++) {
+        for (size_t previous = 0; previous < job; previous++) {
+            if (intersect(writes[previous], reads[job]) || intersect(reads[previous], writes[job]) ||
+                    intersect(writes[previous], writes[job])) {
+                _dependents[previous].push_back(job);
+                _numDependencies[job]++;
+            }
+        }
+    }
+}
+
+void JobGraph::run(const std::function<void(size_t job)>& runJob) const {
+    size_t numJobs = getNumJobs();
+    std::unique_ptr<std::atomic<int>[]> numWaiting(new std::atomic<int>[numJobs]);
+    for (size_t i = 0; i < numJobs; i++) {
+        numWaiting[i] = _numDependencies[i];
+    }
+
+    tbb::task_group tasks;
+    std::function<void(size_t)> runAndRelease = [&](size_t job) {
+        runJob(job);
+        for (size_t dependent : _dependents[job]) {
+            if (--numWaiting[dependent] == 0) {
+                tasks.run([&runAndRelease, dependent] { runAndRelease(dependent); });
+            }
+        }
+    };
+    for (size_t i = 0; i < numJobs; i++) {
+        if (_numDependencies[i] == 0) {
+            tasks.run([&runAndRelease, i] { runAndRelease(i); });
+        }
+    }
+    tasks.wait();
+}
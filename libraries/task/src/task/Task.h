@@ -15,7 +15,11 @@
 #include "Config.h"
 #include "Varying.h"
 
+#include <atomic>
+#include <functional>
+#include <type_traits>
 #include <unordered_map>
+#include <vector>
 
 namespace task {
 
@@ -64,6 +68,24 @@ protected:
 };
 using JobContextPointer = std::shared_ptr<JobContext>;
 
+// The order the jobs of a task have to run in, found from the varyings they read and write.
+// A job waits for the jobs added before it that write what it reads, read what it writes, or write what it writes,
+// so any order that respects that produces the same results as running the jobs one after the other.
+class JobGraph {
+public:
+    // the inputs and outputs of the jobs, in the order the jobs were added
+    void build(const std::vector<Varying>& inputs, const std::vector<Varying>& outputs);
+
+    size_t getNumJobs() const { return _numDependencies.size(); }
+
+    // run every job once on the worker pool, each as soon as the jobs it waits for are done
+    void run(const std::function<void(size_t job)>& runJob) const;
+
+protected:
+    std::vector<std::vector<size_t>> _dependents;
+    std::vector<int> _numDependencies;
+};
+
 // The guts of a job
 class JobConcept {
 public:
@@ -249,6 +271,7 @@ public:
         Varying _input;
         Varying _output;
         Jobs _jobs;
+        JobGraph _graph;
 
         const Varying getInput() const override { return _input; }
         const Varying getOutput() const override { return _output; }
@@ -330,14 +353,56 @@ public:
         void run(const ContextPointer& jobContext) override {
             auto config = std::static_pointer_cast<C>(Concept::_config);
             if (config->isEnabled()) {
-                for (auto job : TaskConcept::_jobs) {
-                    job.run(jobContext);
-                    if (jobContext->taskFlow.doAbortTask()) {
-                        jobContext->taskFlow.reset();
-                        return;
-                    }
+                if (config->isParallel()) {
+                    runJobsInParallel(jobContext, std::is_copy_constructible<Context>());
+                } else {
+                    runJobs(jobContext);
+                }
+            }
+        }
+
+    protected:
+        void runJobs(const ContextPointer& jobContext) {
+            for (auto job : TaskConcept::_jobs) {
+                job.run(jobContext);
+                if (jobContext->taskFlow.doAbortTask()) {
+                    jobContext->taskFlow.reset();
+                    return;
+                }
+            }
+        }
+
+        // The jobs running at the same time get a copy of the context each, since a job's config is handed to it through
+        // the context.  Once a job aborts the task, the jobs that haven't started yet are skipped.
+        void runJobsInParallel(const ContextPointer& jobContext, std::true_type) {
+            auto& jobs = TaskConcept::_jobs;
+            auto& graph = TaskConcept::_graph;
+            if (graph.getNumJobs() != jobs.size()) {
+                std::vector<Varying> inputs;
+                std::vector<Varying> outputs;
+                for (const auto& job : jobs) {
+                    inputs.push_back(job.getInput());
+                    outputs.push_back(job.getOutput());
                 }
+                graph.build(inputs, outputs);
             }
+
+            std::atomic<bool> isAborted { false };
+            graph.run([&](size_t i) {
+                if (isAborted) {
+                    return;
+                }
+                auto context = std::make_shared<Context>(*jobContext);
+                jobs[i].run(context);
+                if (context->taskFlow.doAbortTask()) {
+                    isAborted = true;
+                }
+            });
+        }
+
+        // a context that can't be copied can't be handed out, so the jobs take turns with it
+        void runJobsInParallel(const ContextPointer& jobContext, std::false_type) {
+            runJobs(jobContext);
         }
     };
     template <class T, class C = Config> using Model = TaskModel<T, C, None, None>;
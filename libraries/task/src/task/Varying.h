@@ -46,6 +46,9 @@ public:
 
     bool isNull() const { return _concept == nullptr; }
 
+    // the data this varying refers to, the same for all of its copies
+    const void* id() const { return _concept.get(); }
+
 protected:
     class Concept {
     public:
@@ -68,13 +71,20 @@ protected:
         virtual ~Model() = default;
 
         virtual Varying operator[] (uint8_t index) const override {
-            return Varying();
+            return getSubVarying(_data, index, nullptr);
         }
         virtual uint8_t length() const override {
-            return 0;
+            return getNumSubVaryings(_data, nullptr);
         }
 
         Data _data;
+
+    private:
+        // the varying sets and arrays hold sub varyings, any other data has none
+        template <class P> static Varying getSubVarying(const P& data, uint8_t index, typename P::is_proxy_tag*) { return data[index]; }
+        template <class P> static Varying getSubVarying(const P&, uint8_t, ...) { return Varying(); }
+        template <class P> static uint8_t getNumSubVaryings(const P& data, typename P::is_proxy_tag*) { return data.length(); }
+        template <class P> static uint8_t getNumSubVaryings(const P&, ...) { return 0; }
     };
 
     std::shared_ptr<Concept> _concept;
@@ -112,6 +122,7 @@ template <class T0, class T1, class T2>
 class VaryingSet3 : public std::tuple<Varying, Varying,Varying>{
 public:
     using Parent = std::tuple<Varying, Varying, Varying>;
+    typedef void is_proxy_tag;
 
     VaryingSet3() : Parent(Varying(T0()), Varying(T1()), Varying(T2())) {}
     VaryingSet3(const VaryingSet3& src) : Parent(std::get<0>(src), std::get<1>(src), std::get<2>(src)) {}
@@ -144,6 +155,7 @@ template <class T0, class T1, class T2, class T3>
 class VaryingSet4 : public std::tuple<Varying, Varying, Varying, Varying>{
 public:
     using Parent = std::tuple<Varying, Varying, Varying, Varying>;
+    typedef void is_proxy_tag;
 
     VaryingSet4() : Parent(Varying(T0()), Varying(T1()), Varying(T2()), Varying(T3())) {}
     VaryingSet4(const VaryingSet4& src) : Parent(std::get<0>(src), std::get<1>(src), std::get<2>(src), std::get<3>(src)) {}
@@ -181,6 +193,7 @@ template <class T0, class T1, class T2, class T3, class T4>
 class VaryingSet5 : public std::tuple<Varying, Varying, Varying, Varying, Varying>{
 public:
     using Parent = std::tuple<Varying, Varying, Varying, Varying, Varying>;
+    typedef void is_proxy_tag;
 
     VaryingSet5() : Parent(Varying(T0()), Varying(T1()), Varying(T2()), Varying(T3()), Varying(T4())) {}
     VaryingSet5(const VaryingSet5& src) : Parent(std::get<0>(src), std::get<1>(src), std::get<2>(src), std::get<3>(src), std::get<4>(src)) {}
@@ -223,6 +236,7 @@ template <class T0, class T1, class T2, class T3, class T4, class T5>
 class VaryingSet6 : public std::tuple<Varying, Varying, Varying, Varying, Varying, Varying>{
 public:
     using Parent = std::tuple<Varying, Varying, Varying, Varying, Varying, Varying>;
+    typedef void is_proxy_tag;
 
     VaryingSet6() : Parent(Varying(T0()), Varying(T1()), Varying(T2()), Varying(T3()), Varying(T4()), Varying(T5())) {}
     VaryingSet6(const VaryingSet6& src) : Parent(std::get<0>(src), std::get<1>(src), std::get<2>(src), std::get<3>(src), std::get<4>(src), std::get<5>(src)) {}
@@ -271,6 +285,7 @@ template <class T0, class T1, class T2, class T3, class T4, class T5, class T6>
 class VaryingSet7 : public std::tuple<Varying, Varying, Varying, Varying, Varying, Varying, Varying>{
 public:
     using Parent = std::tuple<Varying, Varying, Varying, Varying, Varying, Varying, Varying>;
+    typedef void is_proxy_tag;
     
     VaryingSet7() : Parent(Varying(T0()), Varying(T1()), Varying(T2()), Varying(T3()), Varying(T4()), Varying(T5()), Varying(T6())) {}
     VaryingSet7(const VaryingSet7& src) : Parent(std::get<0>(src), std::get<1>(src), std::get<2>(src), std::get<3>(src), std::get<4>(src), std::get<5>(src), std::get<6>(src)) {}
@@ -324,6 +339,7 @@ template <class T0, class T1, class T2, class T3, class T4, class T5, class T6,
 class VaryingSet8 : public std::tuple<Varying, Varying, Varying, Varying, Varying, Varying, Varying, Varying> {
 public:
     using Parent = std::tuple<Varying, Varying, Varying, Varying, Varying, Varying, Varying, Varying>;
+    typedef void is_proxy_tag;
 
     VaryingSet8() : Parent(Varying(T0()), Varying(T1()), Varying(T2()), Varying(T3()), Varying(T4()), Varying(T5()), Varying(T6()), Varying(T7())) {}
     VaryingSet8(const VaryingSet8& src) : Parent(std::get<0>(src), std::get<1>(src), std::get<2>(src), std::get<3>(src), std::get<4>(src), std::get<5>(src), std::get<6>(src), std::get<7>(src)) {}
@@ -382,6 +398,7 @@ template <class T0, class T1, class T2, class T3, class T4, class T5, class T6,
 class VaryingSet9 : public std::tuple<Varying, Varying, Varying, Varying, Varying, Varying, Varying, Varying, Varying> {
 public:
     using Parent = std::tuple<Varying, Varying, Varying, Varying, Varying, Varying, Varying, Varying, Varying>;
+    typedef void is_proxy_tag;
 
     VaryingSet9() : Parent(Varying(T0()), Varying(T1()), Varying(T2()), Varying(T3()), Varying(T4()), Varying(T5()), Varying(T6()), Varying(T7()), Varying(T8())) {}
     VaryingSet9(const VaryingSet9& src) : Parent(std::get<0>(src), std::get<1>(src), std::get<2>(src), std::get<3>(src), std::get<4>(src), std::get<5>(src), std::get<6>(src), std::get<7>(src), std::get<8>(src)) {}
@@ -445,6 +462,7 @@ template <class T0, class T1, class T2, class T3, class T4, class T5, class T6,
 class VaryingSet10 : public std::tuple<Varying, Varying, Varying, Varying, Varying, Varying, Varying, Varying, Varying, Varying> {
 public:
     using Parent = std::tuple<Varying, Varying, Varying, Varying, Varying, Varying, Varying, Varying, Varying, Varying>;
+    typedef void is_proxy_tag;
 
     VaryingSet10() : Parent(Varying(T0()), Varying(T1()), Varying(T2()), Varying(T3()), Varying(T4()), Varying(T5()), Varying(T6()), Varying(T7()), Varying(T8()), Varying(T9())) {}
     VaryingSet10(const VaryingSet10& src) : Parent(std::get<0>(src), std::get<1>(src), std::get<2>(src), std::get<3>(src), std::get<4>(src), std::get<5>(src), std::get<6>(src), std::get<7>(src), std::get<8>(src), std::get<9>(src)) {}
@@ -512,6 +530,8 @@ public:
 template < class T, int NUM >
 class VaryingArray : public std::array<Varying, NUM> {
 public:
+    typedef void is_proxy_tag;
+
     VaryingArray() {
         for (size_t i = 0; i < NUM; i++) {
             (*this)[i] = Varying(T());
@@ -522,6 +542,8 @@ public:
         assert(list.size() == NUM);
         std::copy(list.begin(), list.end(), std::array<Varying, NUM>::begin());
     }
+
+    uint8_t length() const { return NUM; }
 };
 
 }
@@ -0,0 +1,86 @@
+//
+//  AudienceCellsTests.cpp
+//  tests/audio/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudienceCellsTests.h"
+
+#include <AudienceCells.h>
+
+QTEST_MAIN(AudienceCellsTests)
+
+using namespace AudienceCells;
+
+void AudienceCellsTests::testCellAssignment() {
+    // a 20m square hall with 4m cells, and a balcony overlapping its back with 2m cells
+    std::vector<Audience> audiences {
+        { AABox(glm::vec3(0.0f), glm::vec3(20.0f, 5.0f, 20.0f)), 4.0f },
+        { AABox(glm::vec3(0.0f, 0.0f, 16.0f), glm::vec3(20.0f, 10.0f, 8.0f)), 2.0f }
+    };
+
+    CellKey cell;
+    QVERIFY(findCell(audiences, glm::vec3(1.0f, 1.5f, 1.0f), cell));
+    QCOMPARE(cell, CellKey(0, 0, 0, 0));
+    QVERIFY(findCell(audiences, glm::vec3(9.0f, 1.5f, 13.0f), cell));
+    QCOMPARE(cell, CellKey(0, 2, 0, 3));
+
+    // neighbours a step apart across a cell boundary hear different mixes
+    CellKey other;
+    QVERIFY(findCell(audiences, glm::vec3(3.9f, 1.5f, 1.0f), cell));
+    QVERIFY(findCell(audiences, glm::vec3(4.1f, 1.5f, 1.0f), other));
+    QVERIFY(cell != other);
+
+    // where the audiences overlap, the first one has the listener
+    QVERIFY(findCell(audiences, glm::vec3(1.0f, 1.5f, 17.0f), cell));
+    QCOMPARE(std::get<0>(cell), 0);
+    QVERIFY(findCell(audiences, glm::vec3(1.0f, 7.0f, 17.0f), cell));
+    QCOMPARE(cell, CellKey(1, 0, 3, 0));
+
+    // and outside both, no one
+    QVERIFY(!findCell(audiences, glm::vec3(-1.0f, 1.5f, 1.0f), cell));
+    QVERIFY(!findCell(audiences, glm::vec3(1.0f, 1.5f, 30.0f), cell));
+
+    // every cell's corner is where the positions it holds start
+    QVERIFY(findCell(audiences, glm::vec3(9.0f, 1.5f, 13.0f), cell));
+    QCOMPARE(getCellCorner(audiences, cell), glm::vec3(8.0f, 0.0f, 12.0f));
+    QVERIFY(findCell(audiences, glm::vec3(5.0f, 9.0f, 23.0f), cell));
+    QCOMPARE(getCellCorner(audiences, cell), glm::vec3(4.0f, 8.0f, 22.0f));
+}
+
+void AudienceCellsTests::testShareDecision() {
+    Listener listener;
+    QVERIFY(canShareMix(listener));
+
+    auto without = [](void (*change)(Listener&)) {
+        Listener listener;
+        change(listener);
+        return canShareMix(listener);
+    };
+
+    // only agents with a socket and a microphone stream of their own
+    QVERIFY(!without([](Listener& listener) { listener.isAgent = false; }));
+    QVERIFY(!without([](Listener& listener) { listener.hasActiveSocket = false; }));
+    QVERIFY(!without([](Listener& listener) { listener.isUpstream = true; }));
+    QVERIFY(!without([](Listener& listener) { listener.hasAvatarStream = false; }));
+
+    // anything that changes what the listener hears
+    QVERIFY(!without([](Listener& listener) { listener.isIgnoreBoxEnabled = true; }));
+    QVERIFY(!without([](Listener& listener) { listener.isLoopingBack = true; }));
+    QVERIFY(!without([](Listener& listener) { listener.isSoloing = true; }));
+    QVERIFY(!without([](Listener& listener) { listener.isIgnoring = true; }));
+    QVERIFY(!without([](Listener& listener) { listener.masterAvatarGain = 0.5f; }));
+    QVERIFY(!without([](Listener& listener) { listener.masterInjectorGain = 0.0f; }));
+    QVERIFY(!without([](Listener& listener) { listener.hasAvatarGainAdjustments = true; }));
+
+    // gains turned back to unity share again
+    listener.masterAvatarGain = 0.5f;
+    QVERIFY(!canShareMix(listener));
+    listener.masterAvatarGain = 1.0f;
+    QVERIFY(canShareMix(listener));
+}
@@ -0,0 +1,25 @@
+//
+//  AudienceCellsTests.h
+//  tests/audio/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudienceCellsTests_h
+#define hifi_AudienceCellsTests_h
+
+#include <QtTest/QtTest>
+
+class AudienceCellsTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testCellAssignment();
+    void testShareDecision();
+};
+
+#endif // hifi_AudienceCellsTests_h
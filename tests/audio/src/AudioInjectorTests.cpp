@@ -0,0 +1,179 @@
+//
+//  AudioInjectorTests.cpp
+//  tests/audio/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioInjectorTests.h"
+
+#include <vector>
+
+#include <AudioInjectorManager.h>
+#include <InjectorWheel.h>
+#include <PCMCache.h>
+#include <SharedUtil.h>
+
+QTEST_MAIN(AudioInjectorTests)
+
+namespace {
+
+const uint64_t TICK_USECS = 100;
+const uint64_t START = 1000 * TICK_USECS;
+
+using Wheel = InjectorWheel<int>;
+// which item was sent on which tick
+using Sends = std::vector<std::pair<int, uint64_t>>;
+
+QByteArray makeSamples(int numSamples) {
+    QByteArray samples(numSamples * AudioConstants::SAMPLE_SIZE, Qt::Uninitialized);
+    auto data = reinterpret_cast<AudioConstants::AudioSample*>(samples.data());
+    for (int i = 0; i < numSamples; i++) {
+        data[i] = (AudioConstants::AudioSample)((i * 37) % AudioConstants::MAX_SAMPLE_VALUE);
+    }
+    return samples;
+}
+
+std::shared_ptr<PCMCache> makePCMCache(const QString& location) {
+    auto pcmCache = std::make_shared<PCMCache>(location.toStdString(), "pcm");
+    pcmCache->initialize();
+    return pcmCache;
+}
+
+bool hasSamples(const AudioDataPointer& audioData, const QByteArray& samples) {
+    return audioData && audioData->getNumBytes() == (uint32_t)samples.size() &&
+        memcmp(audioData->rawData(), samples.constData(), samples.size()) == 0;
+}
+
+}
+
+void AudioInjectorTests::testPCMCache() {
+    QTemporaryDir testDir;
+    const QByteArray source { "the bytes of a sound file" };
+    auto key = PCMCache::makeKey("wav", source);
+    QVERIFY(key != PCMCache::makeKey("raw", source));
+
+    auto samples = makeSamples(AudioConstants::SAMPLE_RATE);
+    {
+        auto pcmCache = makePCMCache(testDir.path());
+        QVERIFY(!pcmCache->getAudioData(key));
+
+        auto audioData = pcmCache->writeAudioData(key, 2, samples);
+        QVERIFY(hasSamples(audioData, samples));
+        QCOMPARE(audioData->getNumChannels(), (uint32_t)2);
+
+        // everyone asking for a sound in use shares it
+        QCOMPARE(pcmCache->getAudioData(key).get(), audioData.get());
+    }
+
+    // and the sound is still there the next time around
+    auto pcmCache = makePCMCache(testDir.path());
+    auto audioData = pcmCache->getAudioData(key);
+    QVERIFY(hasSamples(audioData, samples));
+    QCOMPARE(audioData->getNumChannels(), (uint32_t)2);
+}
+
+void AudioInjectorTests::testInjectorWheel() {
+    Wheel wheel(TICK_USECS, START);
+    wheel.schedule(START, 1);
+    // each goes on the nearest tick
+    wheel.schedule(START + 3 * TICK_USECS + TICK_USECS / 4, 2);
+    wheel.schedule(START + 3 * TICK_USECS + 3 * TICK_USECS / 4, 3);
+    // more than a turn of the wheel away
+    wheel.schedule(START + 100 * TICK_USECS, 4);
+    wheel.schedule(START + 10 * TICK_USECS, 5);
+    QCOMPARE(wheel.size(), (size_t)5);
+
+    Sends sends;
+    int numSends1 = 0;
+    int numSends5 = 0;
+    for (uint64_t tick = 0; tick <= 110; tick++) {
+        wheel.advance(START + tick * TICK_USECS, [&](int& item) -> int64_t {
+            sends.emplace_back(item, tick);
+            // 1 goes again two ticks later, twice, and 5 goes again right away, once
+            if (item == 1 && ++numSends1 < 3) {
+                return 2 * TICK_USECS;
+            }
+            if (item == 5 && ++numSends5 < 2) {
+                return 0;
+            }
+            return -1;
+        });
+    }
+
+    Sends expected { { 1, 0 }, { 1, 2 }, { 2, 3 }, { 3, 4 }, { 1, 4 }, { 5, 10 }, { 5, 10 }, { 4, 100 } };
+    QCOMPARE(sends, expected);
+    QCOMPARE(wheel.size(), (size_t)0);
+    QCOMPARE(wheel.getNextTickTimestamp(), START + 111 * TICK_USECS);
+}
+
+void AudioInjectorTests::testInjectorWheelStall() {
+    Wheel wheel(TICK_USECS, START);
+    for (int tick : { 5, 20, 130 }) {
+        wheel.schedule(START + tick * TICK_USECS, tick);
+    }
+
+    // everything due by then goes at once, and nothing that isn't
+    Sends sends;
+    auto send = [&](int& item) -> int64_t {
+        sends.emplace_back(item, 0);
+        return -1;
+    };
+    QCOMPARE(wheel.advance(START + 100 * TICK_USECS, send), (size_t)2);
+    QCOMPARE(sends, (Sends { { 5, 0 }, { 20, 0 } }));
+    QCOMPARE(wheel.size(), (size_t)1);
+
+    // a stall of several turns still gets to it
+    QCOMPARE(wheel.advance(START + 300 * TICK_USECS, send), (size_t)1);
+    QCOMPARE(sends.back().first, 130);
+    QCOMPARE(wheel.size(), (size_t)0);
+
+    // and time going backwards sends nothing
+    wheel.schedule(START + 300 * TICK_USECS, 1);
+    QCOMPARE(wheel.advance(START, send), (size_t)0);
+}
+
+void AudioInjectorTests::benchmarkInjectors() {
+    const size_t NUM_INJECTORS = 5000;
+    const unsigned long NUM_MSECS = 2000;
+
+    auto injectorManager = DependencyManager::set<AudioInjectorManager>();
+    injectorManager->setMaxInjectors(NUM_INJECTORS);
+
+    // long enough that no injector gets to the end, all of them share the one sound
+    auto samples = makeSamples(10 * AudioConstants::SAMPLE_RATE);
+    auto audioData = AudioData::make(samples.size() / AudioConstants::SAMPLE_SIZE, 1,
+                                     reinterpret_cast<const AudioConstants::AudioSample*>(samples.constData()));
+
+    std::vector<AudioInjectorPointer> injectors;
+    uint64_t start = usecTimestampNow();
+    for (size_t i = 0; i < NUM_INJECTORS; i++) {
+        AudioInjectorOptions options;
+        options.position = glm::vec3((float)(i % 100), 0.0f, (float)(i / 100));
+        injectors.push_back(injectorManager->playSound(audioData, options));
+    }
+    QCOMPARE(injectorManager->getNumInjectors(), NUM_INJECTORS);
+
+    QThread::msleep(NUM_MSECS);
+    uint64_t elapsed = usecTimestampNow() - start;
+
+    // stop the injector thread before looking at how far the injectors got
+    injectorManager.clear();
+    DependencyManager::destroy<AudioInjectorManager>();
+
+    // the first two frames go right away
+    float framesDue = (float)elapsed / AudioConstants::NETWORK_FRAME_USECS + 1.0f;
+    float framesSent = 0.0f;
+    for (const auto& injector : injectors) {
+        framesSent += (float)injector->getCurrentSendOffset() / AudioConstants::NETWORK_FRAME_BYTES_PER_CHANNEL;
+    }
+    float onTime = framesSent / (NUM_INJECTORS * framesDue);
+
+    // how far they got depends on the machine and its load, so only a clear majority is asked for
+    qDebug() << NUM_INJECTORS << "injectors sent" << 100.0f * onTime << "% of the frames due in" << NUM_MSECS << "ms";
+    QVERIFY(onTime > 0.6f);
+}
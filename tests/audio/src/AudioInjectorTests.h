@@ -0,0 +1,27 @@
+//
+//  AudioInjectorTests.h
+//  tests/audio/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioInjectorTests_h
+#define hifi_AudioInjectorTests_h
+
+#include <QtTest/QtTest>
+
+class AudioInjectorTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testPCMCache();
+    void testInjectorWheel();
+    void testInjectorWheelStall();
+    void benchmarkInjectors();
+};
+
+#endif // hifi_AudioInjectorTests_h
@@ -0,0 +1,401 @@
+//
+//  AudioJitterEstimatorTests.cpp
+//  tests/audio/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioJitterEstimatorTests.h"
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <vector>
+
+#include <AudioConstants.h>
+#include <AudioJitterEstimator.h>
+#include <InboundAudioStream.h>
+
+QTEST_MAIN(AudioJitterEstimatorTests)
+
+namespace {
+
+const quint64 FRAME_USECS = AudioConstants::NETWORK_FRAME_USECS;
+const quint64 USECS_PER_MSEC = 1000;
+const quint64 USECS_PER_SEC = 1000 * USECS_PER_MSEC;
+
+// the same numbers on every run and every platform, which the standard distributions don't promise
+class Random {
+public:
+    Random(quint32 seed) : _state(seed) {}
+
+    float uniform() {
+        _state ^= _state << 13;
+        _state ^= _state >> 17;
+        _state ^= _state << 5;
+        return (_state >> 8) / (float)(1 << 24);
+    }
+
+    float exponential(float mean) { return -mean * logf(1.0f - uniform()); }
+
+private:
+    quint32 _state;
+};
+
+int framesForDelay(quint64 delayUsecs) {
+    return 1 + (int)((delayUsecs + FRAME_USECS - 1) / FRAME_USECS);
+}
+
+// the network holds on to the packets sent from this one on until the delay is up, then lets them all go at once
+void addStall(std::vector<quint64>& delays, int first, quint64 stallUsecs) {
+    quint64 release = first * FRAME_USECS + delays[first] + stallUsecs;
+    for (int i = first; i < (int)delays.size() && i * FRAME_USECS < release; i++) {
+        delays[i] = std::max(delays[i], release - i * FRAME_USECS);
+    }
+}
+
+// Traces are the one-way delay of each packet, in the order they were sent, a minute long.  They are generated here in
+// the shape of the ones recorded from clients, so the replay doesn't depend on data files.
+const int TRACE_FRAMES = 6000;
+
+std::vector<quint64> makeWiredTrace() {
+    Random random(1);
+    std::vector<quint64> delays(TRACE_FRAMES);
+    for (auto& delay : delays) {
+        delay = 20 * USECS_PER_MSEC + (quint64)(random.uniform() * 2 * USECS_PER_MSEC);
+    }
+    return delays;
+}
+
+// jittery, and every couple of seconds the radio sits on the packets for a while
+std::vector<quint64> makeWifiTrace() {
+    Random random(2);
+    std::vector<quint64> delays(TRACE_FRAMES);
+    for (auto& delay : delays) {
+        delay = 30 * USECS_PER_MSEC + (quint64)random.exponential(3 * USECS_PER_MSEC);
+    }
+    for (int i = 100; i < TRACE_FRAMES; i += 150 + (int)(random.uniform() * 200)) {
+        addStall(delays, i, (quint64)((40 + random.uniform() * 50) * USECS_PER_MSEC));
+    }
+    return delays;
+}
+
+// a long way away, more jittery still, and now and then it stops for a few hundred milliseconds
+std::vector<quint64> makeCellularTrace() {
+    Random random(3);
+    std::vector<quint64> delays(TRACE_FRAMES);
+    for (auto& delay : delays) {
+        delay = 60 * USECS_PER_MSEC + (quint64)random.exponential(8 * USECS_PER_MSEC);
+    }
+    for (int i = 300; i < TRACE_FRAMES; i += 500 + (int)(random.uniform() * 500)) {
+        addStall(delays, i, (quint64)((150 + random.uniform() * 250) * USECS_PER_MSEC));
+    }
+    return delays;
+}
+
+// steady, but the route is longer for the middle 20s
+std::vector<quint64> makeRouteChangeTrace() {
+    Random random(4);
+    std::vector<quint64> delays(TRACE_FRAMES);
+    for (int i = 0; i < TRACE_FRAMES; i++) {
+        quint64 route = (i >= TRACE_FRAMES / 3 && i < 2 * TRACE_FRAMES / 3) ? 70 : 30;
+        delays[i] = route * USECS_PER_MSEC + (quint64)(random.uniform() * 3 * USECS_PER_MSEC);
+    }
+    return delays;
+}
+
+// The desired frames the way InboundAudioStream worked them out before the estimator: from the largest gap between
+// packets in the last 10s, and from the largest in the last 50s once the stream starves 3 times in 50s.
+class LegacyJitterBuffer {
+public:
+    void packetReceived(quint64 now) {
+        completeIntervals(now);
+        const int NUM_INITIAL_PACKETS_DISCARD = 1000;
+        if (++_packetsReceived > NUM_INITIAL_PACKETS_DISCARD) {
+            _intervalMaxGap = std::max(_intervalMaxGap, now - _lastPacketReceivedTime);
+        }
+        _lastPacketReceivedTime = now;
+    }
+
+    void starved(quint64 now) {
+        const quint64 STARVE_WINDOW_USECS = 50 * USECS_PER_SEC;
+        const int WINDOW_STARVE_THRESHOLD = 3;
+        completeIntervals(now);
+        _starves.push_back(now);
+        while (now - _starves.front() > STARVE_WINDOW_USECS) {
+            _starves.pop_front();
+        }
+        if ((int)_starves.size() >= WINDOW_STARVE_THRESHOLD) {
+            int frames = std::max(_calculatedFrames, (int)((now - _lastPacketReceivedTime + FRAME_USECS - 1) / FRAME_USECS));
+            _desiredFrames = std::max(_desiredFrames, frames);
+        }
+    }
+
+    int getDesiredFrames() const { return _desiredFrames; }
+
+private:
+    void completeIntervals(quint64 now) {
+        const size_t LONG_WINDOW_SECONDS = 50;
+        const size_t SHORT_WINDOW_SECONDS = 10;
+        if (_nextIntervalTime == 0) {
+            _nextIntervalTime = now + USECS_PER_SEC;
+        }
+        for (; now >= _nextIntervalTime; _nextIntervalTime += USECS_PER_SEC) {
+            _intervalMaxGaps.push_back(_intervalMaxGap);
+            _intervalMaxGap = 0;
+            if (_intervalMaxGaps.size() > LONG_WINDOW_SECONDS) {
+                _intervalMaxGaps.pop_front();
+            }
+            quint64 longMax = *std::max_element(_intervalMaxGaps.begin(), _intervalMaxGaps.end());
+            _calculatedFrames = (int)((longMax + FRAME_USECS - 1) / FRAME_USECS);
+
+            if (_intervalMaxGaps.size() >= SHORT_WINDOW_SECONDS && _packetsReceived > 1000) {
+                quint64 shortMax = *std::max_element(_intervalMaxGaps.end() - SHORT_WINDOW_SECONDS, _intervalMaxGaps.end());
+                _desiredFrames = std::min(_desiredFrames, std::max(1, (int)((shortMax + FRAME_USECS - 1) / FRAME_USECS)));
+            }
+        }
+    }
+
+    int _packetsReceived { 0 };
+    quint64 _lastPacketReceivedTime { 0 };
+    quint64 _nextIntervalTime { 0 };
+    quint64 _intervalMaxGap { 0 };
+    std::deque<quint64> _intervalMaxGaps;
+    int _calculatedFrames { 0 };
+    std::deque<quint64> _starves;
+    int _desiredFrames { 1 };
+};
+
+enum class Policy {
+    Static,
+    Legacy,
+    Estimated
+};
+
+struct Result {
+    int starves { 0 };
+    int gapFrames { 0 }; // mixes with nothing from the stream in them, while it refills
+    float addedLatencyMsecs { 0.0f }; // how long the audio waits in the buffer, on average
+};
+
+// Plays a trace through a model of InboundAudioStream on the mixer: the packets go into the buffer as they arrive,
+// and a frame is mixed every FRAME_USECS.  The sender talks for 4s and is silent for 2s, and while silent the frames
+// over the desired frames are dropped.
+Result replay(const std::vector<quint64>& delays, Policy policy, int staticFrames = 1) {
+    const int MAX_FRAMES_OVER_DESIRED = InboundAudioStream::MAX_FRAMES_OVER_DESIRED;
+    const int DESIRED_JITTER_BUFFER_FRAMES_PADDING = 1;
+    const int JITTER_ESTIMATOR_INITIAL_PACKETS = 50;
+    const int TALK_FRAMES = 400;
+    const int TALK_AND_SILENCE_FRAMES = 600;
+
+    struct Arrival {
+        int sequence;
+        quint64 time;
+    };
+    std::vector<Arrival> arrivals;
+    for (int i = 0; i < (int)delays.size(); i++) {
+        arrivals.push_back({ i, i * FRAME_USECS + delays[i] });
+    }
+    std::stable_sort(arrivals.begin(), arrivals.end(), [](const Arrival& a, const Arrival& b) { return a.time < b.time; });
+
+    AudioJitterEstimator estimator;
+    LegacyJitterBuffer legacy;
+    int desiredFrames = policy == Policy::Static ? staticFrames : 1;
+
+    std::deque<quint64> buffer; // when each frame went in
+    bool isStarved = true;
+    bool hasStarted = false;
+    int nextSequence = 0;
+
+    Result result;
+    quint64 totalWait = 0;
+    int framesMixed = 0;
+
+    size_t next = 0;
+    for (quint64 mix = arrivals.front().time + FRAME_USECS / 2; next < arrivals.size(); mix += FRAME_USECS) {
+        for (; next < arrivals.size() && arrivals[next].time <= mix; next++) {
+            const Arrival& arrival = arrivals[next];
+            if (policy == Policy::Estimated) {
+                estimator.packetReceived((quint16)arrival.sequence, arrival.time);
+                if (estimator.getPacketsReceived() > JITTER_ESTIMATOR_INITIAL_PACKETS) {
+                    desiredFrames = estimator.getTargetFrames();
+                }
+            } else if (policy == Policy::Legacy) {
+                legacy.packetReceived(arrival.time);
+                desiredFrames = legacy.getDesiredFrames();
+            }
+
+            if (arrival.sequence < nextSequence) {
+                // late, the stream has already filled in for it
+                continue;
+            }
+            for (; nextSequence < arrival.sequence; nextSequence++) {
+                buffer.push_back(arrival.time);
+            }
+            nextSequence++;
+
+            bool isSilent = arrival.sequence % TALK_AND_SILENCE_FRAMES >= TALK_FRAMES;
+            if (!isSilent || (int)buffer.size() < desiredFrames + DESIRED_JITTER_BUFFER_FRAMES_PADDING) {
+                buffer.push_back(arrival.time);
+            }
+
+            if (isStarved && (int)buffer.size() >= desiredFrames) {
+                isStarved = false;
+            }
+            if ((int)buffer.size() > desiredFrames + MAX_FRAMES_OVER_DESIRED) {
+                buffer.erase(buffer.begin(), buffer.end() - (desiredFrames + DESIRED_JITTER_BUFFER_FRAMES_PADDING));
+            }
+        }
+
+        if (isStarved) {
+            result.gapFrames += hasStarted ? 1 : 0;
+        } else if (buffer.empty()) {
+            result.starves++;
+            result.gapFrames++;
+            isStarved = desiredFrames > 0;
+            if (policy == Policy::Legacy) {
+                legacy.starved(mix);
+                desiredFrames = legacy.getDesiredFrames();
+            }
+        } else {
+            totalWait += mix - buffer.front();
+            framesMixed++;
+            buffer.pop_front();
+            hasStarted = true;
+        }
+    }
+
+    result.addedLatencyMsecs = framesMixed > 0 ? (float)totalWait / framesMixed / USECS_PER_MSEC : 0.0f;
+    return result;
+}
+
+}
+
+void AudioJitterEstimatorTests::testSteadyStream() {
+    AudioJitterEstimator estimator;
+    QCOMPARE(estimator.getTargetFrames(), 1);
+
+    Random random(5);
+    for (int i = 0; i < 1000; i++) {
+        estimator.packetReceived((quint16)i, i * FRAME_USECS + 20 * USECS_PER_MSEC + (quint64)(random.uniform() * USECS_PER_MSEC));
+    }
+    QVERIFY(estimator.getTargetFrames() <= 2);
+
+    estimator.reset();
+    QCOMPARE(estimator.getTargetFrames(), 1);
+    QCOMPARE(estimator.getPacketsReceived(), 0);
+}
+
+void AudioJitterEstimatorTests::testAdaptation() {
+    const quint64 LATE_USECS = 45 * USECS_PER_MSEC;
+
+    AudioJitterEstimator estimator;
+    int sequence = 0;
+    for (; sequence < 1000; sequence++) {
+        estimator.packetReceived((quint16)sequence, sequence * FRAME_USECS);
+    }
+    QCOMPARE(estimator.getTargetFrames(), 1);
+
+    // every fourth packet is late, which has to be covered within a second
+    for (int i = 0; i < 100; i++, sequence++) {
+        estimator.packetReceived((quint16)sequence, sequence * FRAME_USECS + (i % 4 == 0 ? LATE_USECS : 0));
+    }
+    QCOMPARE(estimator.getTargetFrames(), framesForDelay(LATE_USECS));
+
+    // and once they stop, the target comes back down in several seconds
+    int framesToRecover = 0;
+    for (; estimator.getTargetFrames() > 1 && framesToRecover < 2000; framesToRecover++, sequence++) {
+        estimator.packetReceived((quint16)sequence, sequence * FRAME_USECS);
+    }
+    QCOMPARE(estimator.getTargetFrames(), 1);
+    QVERIFY(framesToRecover > 100);
+
+    // a single late packet isn't worth the latency
+    for (int i = 0; i < 1000; i++, sequence++) {
+        estimator.packetReceived((quint16)sequence, sequence * FRAME_USECS);
+    }
+    estimator.packetReceived((quint16)sequence, sequence * FRAME_USECS + LATE_USECS);
+    QCOMPARE(estimator.getTargetFrames(), 1);
+}
+
+void AudioJitterEstimatorTests::testSequenceWrap() {
+    AudioJitterEstimator fromZero;
+    AudioJitterEstimator wrapping;
+    const int FIRST_SEQUENCE = 65000;
+
+    Random random(6);
+    for (int i = 0; i < 3000; i++) {
+        quint64 arrival = i * FRAME_USECS + (quint64)random.exponential(5 * USECS_PER_MSEC);
+        fromZero.packetReceived((quint16)i, arrival);
+        wrapping.packetReceived((quint16)(FIRST_SEQUENCE + i), arrival);
+        QCOMPARE(wrapping.getTargetFrames(), fromZero.getTargetFrames());
+    }
+    QVERIFY(fromZero.getTargetFrames() > 1);
+}
+
+void AudioJitterEstimatorTests::testPause() {
+    AudioJitterEstimator estimator;
+    int sequence = 0;
+    for (; sequence < 500; sequence++) {
+        estimator.packetReceived((quint16)sequence, sequence * FRAME_USECS);
+    }
+
+    // the sender stops for a few seconds, then carries on from the same sequence number
+    const quint64 PAUSE_USECS = 3 * USECS_PER_SEC;
+    for (int i = 0; i < 50; i++, sequence++) {
+        estimator.packetReceived((quint16)sequence, sequence * FRAME_USECS + PAUSE_USECS);
+    }
+    QCOMPARE(estimator.getTargetFrames(), 1);
+
+    // or skips ahead
+    sequence += 1000;
+    for (int i = 0; i < 50; i++, sequence++) {
+        estimator.packetReceived((quint16)sequence, sequence * FRAME_USECS);
+    }
+    QCOMPARE(estimator.getTargetFrames(), 1);
+}
+
+void AudioJitterEstimatorTests::simulateTraces() {
+    struct Trace {
+        const char* name;
+        std::vector<quint64> delays;
+    };
+    std::vector<Trace> traces = {
+        { "wired", makeWiredTrace() },
+        { "wifi", makeWifiTrace() },
+        { "cellular", makeCellularTrace() },
+        { "route change", makeRouteChangeTrace() }
+    };
+
+    for (const auto& trace : traces) {
+        Result estimated = replay(trace.delays, Policy::Estimated);
+        Result legacy = replay(trace.delays, Policy::Legacy);
+        qDebug() << trace.name << "estimated:" << estimated.starves << "starves," << estimated.gapFrames << "gap frames,"
+            << estimated.addedLatencyMsecs << "ms added latency";
+        qDebug() << trace.name << "legacy:   " << legacy.starves << "starves," << legacy.gapFrames << "gap frames,"
+            << legacy.addedLatencyMsecs << "ms added latency";
+        for (int frames : { 1, 2, 4, 8 }) {
+            Result fixed = replay(trace.delays, Policy::Static, frames);
+            qDebug() << trace.name << "static" << frames << ":" << fixed.starves << "starves," << fixed.gapFrames
+                << "gap frames," << fixed.addedLatencyMsecs << "ms added latency";
+        }
+
+        // the replay is deterministic
+        Result again = replay(trace.delays, Policy::Estimated);
+        QCOMPARE(again.starves, estimated.starves);
+        QCOMPARE(again.addedLatencyMsecs, estimated.addedLatencyMsecs);
+
+        // never more starves than the old scheme, which takes more than 10s to adapt
+        QVERIFY(estimated.starves <= legacy.starves);
+    }
+
+    // and a clean network costs nothing
+    Result wired = replay(traces[0].delays, Policy::Estimated);
+    Result wiredStatic = replay(traces[0].delays, Policy::Static, 1);
+    QCOMPARE(wired.starves, 0);
+    QVERIFY(wired.addedLatencyMsecs <= wiredStatic.addedLatencyMsecs);
+}
@@ -0,0 +1,28 @@
+//
+//  AudioJitterEstimatorTests.h
+//  tests/audio/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioJitterEstimatorTests_h
+#define hifi_AudioJitterEstimatorTests_h
+
+#include <QtTest/QtTest>
+
+class AudioJitterEstimatorTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testSteadyStream();
+    void testAdaptation();
+    void testSequenceWrap();
+    void testPause();
+    void simulateTraces();
+};
+
+#endif // hifi_AudioJitterEstimatorTests_h
@@ -0,0 +1,205 @@
+//
+//  InboundAudioStreamTests.cpp
+//  tests/audio/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "InboundAudioStreamTests.h"
+
+#include <vector>
+
+#include <AudioConstants.h>
+#include <MixedAudioStream.h>
+#include <ReceivedMessage.h>
+#include <udt/PacketHeaders.h>
+
+QTEST_MAIN(InboundAudioStreamTests)
+
+namespace {
+
+const int FRAME_CAPACITY = 100;
+const int FRAME_SAMPLES = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL * AudioConstants::STEREO;
+
+QByteArray makeHeader(quint16 sequence, const QString& codec) {
+    QByteArray payload;
+    QDataStream stream(&payload, QIODevice::WriteOnly);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream << sequence;
+    QByteArray codecName = codec.toUtf8();
+    stream << (quint32)codecName.size();
+    stream.writeRawData(codecName.constData(), codecName.size());
+    return payload;
+}
+
+// a frame of raw stereo samples that all have the same value
+void parseAudio(InboundAudioStream& stream, quint16 sequence, const QString& codec, AudioConstants::AudioSample value) {
+    QByteArray payload = makeHeader(sequence, codec);
+    std::vector<AudioConstants::AudioSample> samples(FRAME_SAMPLES, value);
+    payload.append((const char*)samples.data(), (int)(samples.size() * sizeof(AudioConstants::AudioSample)));
+    ReceivedMessage message(payload, PacketType::MixedAudio, versionForPacketType(PacketType::MixedAudio), HifiSockAddr());
+    stream.parseData(message);
+}
+
+void parseSilence(InboundAudioStream& stream, quint16 sequence, quint16 numSilentSamples) {
+    QByteArray payload = makeHeader(sequence, "pcm");
+    payload.append((const char*)&numSilentSamples, sizeof(numSilentSamples));
+    ReceivedMessage message(payload, PacketType::SilentAudioFrame, versionForPacketType(PacketType::SilentAudioFrame),
+                            HifiSockAddr());
+    stream.parseData(message);
+}
+
+// pops the next frame, and checks that every sample in it has the given value
+bool popFrameOf(InboundAudioStream& stream, AudioConstants::AudioSample value) {
+    if (stream.popFrames(1, true) != 1) {
+        return false;
+    }
+    std::vector<AudioConstants::AudioSample> samples(FRAME_SAMPLES);
+    auto output = stream.getLastPopOutput();
+    output.readSamples(samples.data(), FRAME_SAMPLES);
+    for (auto sample : samples) {
+        if (sample != value) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+void InboundAudioStreamTests::testAudioLostAndSilentFrames() {
+    MixedAudioStream stream(FRAME_CAPACITY, 1);
+    QVERIFY(stream.isStarved());
+
+    // the starve check runs as each packet comes in
+    parseAudio(stream, 0, "pcm", 1000);
+    QCOMPARE(stream.getFramesAvailable(), 1);
+    QVERIFY(!stream.isStarved());
+
+    parseAudio(stream, 1, "pcm", 2000);
+    QCOMPARE(stream.getFramesAvailable(), 2);
+
+    // 2 is lost, which is made up for by a frame of silence ahead of 3
+    parseAudio(stream, 3, "pcm", 3000);
+    QCOMPARE(stream.getFramesAvailable(), 4);
+
+    parseSilence(stream, 4, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+    QCOMPARE(stream.getFramesAvailable(), 5);
+    QCOMPARE(stream.getSilentFramesDropped(), 0);
+
+    // late packets are ignored
+    parseAudio(stream, 2, "pcm", 4000);
+    QCOMPARE(stream.getFramesAvailable(), 5);
+
+    QVERIFY(popFrameOf(stream, 1000));
+    QVERIFY(popFrameOf(stream, 2000));
+    QVERIFY(popFrameOf(stream, 0));
+    QVERIFY(popFrameOf(stream, 3000));
+    QVERIFY(popFrameOf(stream, 0));
+    QCOMPARE(stream.getFramesAvailable(), 0);
+}
+
+void InboundAudioStreamTests::testCodecSwitch() {
+    MixedAudioStream stream(FRAME_CAPACITY, 1);
+
+    // without a codec plugin there is no decoder, so only the codec names matter here
+    stream.setupCodec(CodecPluginPointer(), "opus", AudioConstants::STEREO);
+
+    // PCM still in flight from before the switch is used as is
+    parseAudio(stream, 0, "pcm", 1000);
+    QCOMPARE(stream.getFramesAvailable(), 1);
+
+    // audio in a codec we aren't prepared for is made up for by silence
+    parseAudio(stream, 1, "zlib", 2000);
+    QCOMPARE(stream.getFramesAvailable(), 2);
+
+    stream.setupCodec(CodecPluginPointer(), "pcm", AudioConstants::STEREO);
+    parseAudio(stream, 2, "pcm", 3000);
+    QCOMPARE(stream.getFramesAvailable(), 3);
+
+    QVERIFY(popFrameOf(stream, 1000));
+    QVERIFY(popFrameOf(stream, 0));
+    QVERIFY(popFrameOf(stream, 3000));
+}
+
+void InboundAudioStreamTests::testDeferredDecode() {
+    MixedAudioStream stream(FRAME_CAPACITY, 1);
+    stream.setDecodeDeferred(true);
+
+    parseAudio(stream, 0, "pcm", 1000);
+    parseAudio(stream, 1, "pcm", 2000);
+    parseAudio(stream, 3, "pcm", 3000);
+    parseSilence(stream, 4, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+    parseAudio(stream, 2, "pcm", 4000);
+
+    // nothing is written until the frames are decoded, by when the messages they came in are gone
+    QCOMPARE(stream.getFramesAvailable(), 0);
+    QVERIFY(stream.isStarved());
+
+    stream.decodePendingFrames();
+    QCOMPARE(stream.getFramesAvailable(), 5);
+    QVERIFY(!stream.isStarved());
+
+    QVERIFY(popFrameOf(stream, 1000));
+    QVERIFY(popFrameOf(stream, 2000));
+    QVERIFY(popFrameOf(stream, 0));
+    QVERIFY(popFrameOf(stream, 3000));
+    QVERIFY(popFrameOf(stream, 0));
+
+    // and once they are, there is nothing more to do
+    stream.decodePendingFrames();
+    QCOMPARE(stream.getFramesAvailable(), 0);
+}
+
+void InboundAudioStreamTests::testDeferredMatchesOnArrival() {
+    // more than enough for the oldest frames to be dropped, which happens as each packet is written either way
+    const int NUM_PACKETS = InboundAudioStream::MAX_FRAMES_OVER_DESIRED + 5;
+
+    MixedAudioStream onArrival(FRAME_CAPACITY, 1);
+    MixedAudioStream deferred(FRAME_CAPACITY, 1);
+    deferred.setDecodeDeferred(true);
+    for (int i = 0; i < NUM_PACKETS; i++) {
+        parseAudio(onArrival, i, "pcm", i + 1);
+        parseAudio(deferred, i, "pcm", i + 1);
+    }
+    deferred.decodePendingFrames();
+
+    QCOMPARE(deferred.getFramesAvailable(), onArrival.getFramesAvailable());
+    QVERIFY(deferred.getFramesAvailable() < NUM_PACKETS);
+    QCOMPARE(deferred.getAudioStreamStats()._framesDropped, onArrival.getAudioStreamStats()._framesDropped);
+
+    // the newest frames are the ones kept
+    int numFrames = onArrival.getFramesAvailable();
+    for (int value = NUM_PACKETS - numFrames + 1; value <= NUM_PACKETS; value++) {
+        QVERIFY(popFrameOf(onArrival, (AudioConstants::AudioSample)value));
+        QVERIFY(popFrameOf(deferred, (AudioConstants::AudioSample)value));
+    }
+}
+
+void InboundAudioStreamTests::testDeferredCodecSwitch() {
+    MixedAudioStream stream(FRAME_CAPACITY, 1);
+    stream.setDecodeDeferred(true);
+    stream.setupCodec(CodecPluginPointer(), "pcm", AudioConstants::STEREO);
+
+    parseAudio(stream, 0, "pcm", 1000);
+    parseAudio(stream, 1, "pcm", 2000);
+    QCOMPARE(stream.getFramesAvailable(), 0);
+
+    // what came in for the old codec is decoded with it, before the switch
+    stream.setupCodec(CodecPluginPointer(), "opus", AudioConstants::STEREO);
+    QCOMPARE(stream.getFramesAvailable(), 2);
+
+    parseAudio(stream, 2, "opus", 3000);
+    parseAudio(stream, 3, "pcm", 4000);
+    stream.decodePendingFrames();
+    QCOMPARE(stream.getFramesAvailable(), 4);
+
+    QVERIFY(popFrameOf(stream, 1000));
+    QVERIFY(popFrameOf(stream, 2000));
+    QVERIFY(popFrameOf(stream, 3000));
+    QVERIFY(popFrameOf(stream, 4000));
+}
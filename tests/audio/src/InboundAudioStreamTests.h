@@ -0,0 +1,28 @@
+//
+//  InboundAudioStreamTests.h
+//  tests/audio/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_InboundAudioStreamTests_h
+#define hifi_InboundAudioStreamTests_h
+
+#include <QtTest/QtTest>
+
+class InboundAudioStreamTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testAudioLostAndSilentFrames();
+    void testCodecSwitch();
+    void testDeferredDecode();
+    void testDeferredMatchesOnArrival();
+    void testDeferredCodecSwitch();
+};
+
+#endif // hifi_InboundAudioStreamTests_h
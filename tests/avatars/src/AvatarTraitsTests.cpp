@@ -0,0 +1,305 @@
+//
+//  AvatarTraitsTests.cpp
+//  tests/avatars/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AvatarTraitsTests.h"
+
+#include <random>
+
+#include <AvatarTraits.h>
+#include <DeferredTraitSenders.h>
+#include <ExtendedIODevice.h>
+#include <UUID.h>
+
+QTEST_MAIN(AvatarTraitsTests)
+
+// Write-only device collecting everything packed into it
+class TraitsBuffer : public ExtendedIODevice {
+public:
+    TraitsBuffer() { open(QIODevice::WriteOnly); }
+
+    QByteArray data;
+
+protected:
+    qint64 readData(char*, qint64) override { return -1; }
+    qint64 writeData(const char* bytes, qint64 size) override {
+        data.append(bytes, (int)size);
+        return size;
+    }
+};
+
+// bytes of a whole versioned instance on the wire besides its payload: type, version, instance ID, size
+static const qint64 INSTANCE_HEADER_SIZE = sizeof(AvatarTraits::TraitType) + sizeof(AvatarTraits::TraitVersion) +
+    NUM_BYTES_RFC4122_UUID + sizeof(AvatarTraits::TraitWireSize);
+
+static QByteArray randomBytes(std::mt19937& generator, int size) {
+    std::uniform_int_distribution<int> byteDistribution(0, 255);
+    QByteArray bytes(size, 0);
+    for (int i = 0; i < size; i++) {
+        bytes[i] = (char)byteDistribution(generator);
+    }
+    return bytes;
+}
+
+// Stands in for an avatar entity's serialized properties: position, rotation, velocities and the like,
+// followed by a mostly static tail of model URL, dimensions, user data...
+static QByteArray makeEntityPayload(std::mt19937& generator) {
+    std::uniform_int_distribution<int> sizeDistribution(200, 1200);
+    return randomBytes(generator, sizeDistribution(generator));
+}
+
+// Edits a few properties in place, sometimes growing or shrinking one of them
+static QByteArray editEntityPayload(std::mt19937& generator, const QByteArray& payload) {
+    QByteArray edited = payload;
+    std::uniform_int_distribution<int> numEditsDistribution(1, 3);
+    std::uniform_int_distribution<int> editSizeDistribution(4, 16);
+    int numEdits = numEditsDistribution(generator);
+    for (int i = 0; i < numEdits; i++) {
+        int editSize = editSizeDistribution(generator);
+        std::uniform_int_distribution<int> offsetDistribution(0, edited.size() - editSize);
+        edited.replace(offsetDistribution(generator), editSize, randomBytes(generator, editSize));
+    }
+    if (std::uniform_int_distribution<int>(0, 9)(generator) == 0) {
+        std::uniform_int_distribution<int> offsetDistribution(0, edited.size() - 1);
+        edited.insert(offsetDistribution(generator), randomBytes(generator, editSizeDistribution(generator)));
+    }
+    return edited;
+}
+
+// Reads back a versioned instance the way AvatarHashMap::processBulkAvatarTraits does, applying it to the
+// payload the receiver holds.  Returns false if a delta doesn't apply
+static bool readVersionedInstance(const QByteArray& data, AvatarTraits::TraitVersion heldVersion, QByteArray& payload) {
+    const char* position = data.constData() + sizeof(AvatarTraits::TraitType) + sizeof(AvatarTraits::TraitVersion) +
+        NUM_BYTES_RFC4122_UUID;
+    auto size = *reinterpret_cast<const AvatarTraits::TraitWireSize*>(position);
+    position += sizeof(AvatarTraits::TraitWireSize);
+    if (size != AvatarTraits::DELTA_TRAIT_SIZE) {
+        payload = QByteArray(position, size);
+        return true;
+    }
+    auto baseVersion = *reinterpret_cast<const AvatarTraits::TraitVersion*>(position);
+    position += sizeof(AvatarTraits::TraitVersion);
+    size = *reinterpret_cast<const AvatarTraits::TraitWireSize*>(position);
+    position += sizeof(AvatarTraits::TraitWireSize);
+    return baseVersion == heldVersion && AvatarTraits::decodeTraitDelta(payload, QByteArray(position, size), payload);
+}
+
+void AvatarTraitsTests::testDeltaRoundTrip() {
+    std::mt19937 generator(1234);
+    QByteArray empty;
+
+    for (int i = 0; i < 1000; i++) {
+        QByteArray base = makeEntityPayload(generator);
+        QByteArray target = editEntityPayload(generator, base);
+
+        QByteArray decoded;
+        QVERIFY(AvatarTraits::decodeTraitDelta(base, AvatarTraits::encodeTraitDelta(base, target), decoded));
+        QCOMPARE(decoded, target);
+
+        // unrelated payloads and empty ones still round trip
+        QByteArray unrelated = makeEntityPayload(generator);
+        QVERIFY(AvatarTraits::decodeTraitDelta(base, AvatarTraits::encodeTraitDelta(base, unrelated), decoded));
+        QCOMPARE(decoded, unrelated);
+        QVERIFY(AvatarTraits::decodeTraitDelta(empty, AvatarTraits::encodeTraitDelta(empty, target), decoded));
+        QCOMPARE(decoded, target);
+        QVERIFY(AvatarTraits::decodeTraitDelta(base, AvatarTraits::encodeTraitDelta(base, empty), decoded));
+        QCOMPARE(decoded, empty);
+    }
+
+    // a delta against the wrong base or a truncated one is rejected rather than read out of bounds
+    QByteArray base = makeEntityPayload(generator);
+    QByteArray target = editEntityPayload(generator, base);
+    QByteArray delta = AvatarTraits::encodeTraitDelta(base, target);
+    QByteArray decoded;
+    QVERIFY(!AvatarTraits::decodeTraitDelta(base.left(10), delta, decoded));
+    QVERIFY(!AvatarTraits::decodeTraitDelta(base, delta.left(delta.size() - 1), decoded));
+}
+
+void AvatarTraitsTests::testDeltaWireFormat() {
+    std::mt19937 generator(42);
+    QByteArray base = makeEntityPayload(generator);
+    QByteArray target = editEntityPayload(generator, base);
+    QByteArray delta = AvatarTraits::encodeTraitDelta(base, target);
+    auto instanceID = QUuid::createUuid();
+
+    TraitsBuffer buffer;
+    qint64 bytesWritten = AvatarTraits::packVersionedTraitInstanceDelta(AvatarTraits::AvatarEntity, instanceID,
+                                                                        buffer, 7, 5, delta);
+    QCOMPARE(bytesWritten, (qint64)buffer.data.size());
+    QCOMPARE(bytesWritten, INSTANCE_HEADER_SIZE + (qint64)sizeof(AvatarTraits::TraitVersion) +
+                           (qint64)sizeof(AvatarTraits::TraitWireSize) + delta.size());
+
+    // read it back the way AvatarHashMap::processBulkAvatarTraits does
+    const char* data = buffer.data.constData();
+    QCOMPARE(*reinterpret_cast<const AvatarTraits::TraitType*>(data), (AvatarTraits::TraitType)AvatarTraits::AvatarEntity);
+    data += sizeof(AvatarTraits::TraitType);
+    QCOMPARE(*reinterpret_cast<const AvatarTraits::TraitVersion*>(data), (AvatarTraits::TraitVersion)7);
+    data += sizeof(AvatarTraits::TraitVersion);
+    QCOMPARE(QUuid::fromRfc4122(QByteArray(data, NUM_BYTES_RFC4122_UUID)), instanceID);
+    data += NUM_BYTES_RFC4122_UUID;
+    QCOMPARE(*reinterpret_cast<const AvatarTraits::TraitWireSize*>(data), AvatarTraits::DELTA_TRAIT_SIZE);
+    data += sizeof(AvatarTraits::TraitWireSize);
+    QCOMPARE(*reinterpret_cast<const AvatarTraits::TraitVersion*>(data), (AvatarTraits::TraitVersion)5);
+    data += sizeof(AvatarTraits::TraitVersion);
+    auto deltaSize = *reinterpret_cast<const AvatarTraits::TraitWireSize*>(data);
+    data += sizeof(AvatarTraits::TraitWireSize);
+    QCOMPARE((int)deltaSize, delta.size());
+
+    QByteArray decoded;
+    QVERIFY(AvatarTraits::decodeTraitDelta(base, QByteArray(data, deltaSize), decoded));
+    QCOMPARE(decoded, target);
+}
+
+void AvatarTraitsTests::testAvatarEntityEdits() {
+    // 100 avatars with 20 avatar entities each, every entity edited a few times,
+    // with every listener holding the previous version of each entity
+    const int NUM_AVATARS = 100;
+    const int NUM_ENTITIES_PER_AVATAR = 20;
+    const int NUM_EDITS = 5;
+    std::mt19937 generator(2026);
+
+    qint64 fullBytes = 0;
+    qint64 deltaBytes = 0;
+    for (int avatar = 0; avatar < NUM_AVATARS; avatar++) {
+        for (int entity = 0; entity < NUM_ENTITIES_PER_AVATAR; entity++) {
+            auto instanceID = QUuid::createUuid();
+            QByteArray payload = makeEntityPayload(generator);
+
+            for (int version = 1; version <= NUM_EDITS; version++) {
+                QByteArray edited = editEntityPayload(generator, payload);
+                QByteArray delta = AvatarTraits::encodeTraitDelta(payload, edited);
+
+                // the mixer falls back to the whole instance whenever the delta isn't smaller
+                qint64 fullSize = INSTANCE_HEADER_SIZE + edited.size();
+                TraitsBuffer buffer;
+                qint64 deltaSize = AvatarTraits::packVersionedTraitInstanceDelta(AvatarTraits::AvatarEntity, instanceID,
+                                                                                 buffer, version + 1, version, delta);
+                fullBytes += fullSize;
+                deltaBytes += std::min(fullSize, deltaSize);
+
+                QByteArray decoded;
+                QVERIFY(AvatarTraits::decodeTraitDelta(payload, delta, decoded));
+                QCOMPARE(decoded, edited);
+                payload = edited;
+            }
+        }
+    }
+
+    qDebug() << NUM_AVATARS << "avatars x" << NUM_ENTITIES_PER_AVATAR << "avatar entities x" << NUM_EDITS << "edits:"
+        << fullBytes << "bytes as whole instances," << deltaBytes << "bytes as deltas";
+
+    // small edits of large entities should cost a fraction of resending them
+    QVERIFY(deltaBytes * 4 < fullBytes);
+}
+
+void AvatarTraitsTests::testDeltaFanOut() {
+    // the mixer keeps a few versions of an avatar entity, and its listeners each hold a different one of them
+    std::mt19937 generator(7);
+    std::vector<QByteArray> versions { randomBytes(generator, 1000) };
+    for (int i = 1; i <= 3; i++) {
+        QByteArray edited = versions.back();
+        edited.replace(200 * i, 8, randomBytes(generator, 8));
+        versions.push_back(edited);
+    }
+    const AvatarTraits::TraitVersion currentVersion = (AvatarTraits::TraitVersion)versions.size() - 1;
+    const QByteArray& current = versions.back();
+    auto instanceID = QUuid::createUuid();
+
+    struct Listener {
+        AvatarTraits::TraitVersion heldVersion;
+        bool holdsKnownBase;
+        QByteArray payload;
+        AvatarTraits::SentTraitBytes sentBytes;
+    };
+    std::vector<Listener> listeners {
+        { 0, true, versions[0] },
+        { 2, true, versions[2] },
+        // holds a version the mixer no longer has
+        { 0, false, makeEntityPayload(generator) },
+        // holds nothing yet
+        { AvatarTraits::NULL_TRAIT_VERSION, false, QByteArray() }
+    };
+
+    for (auto& listener : listeners) {
+        const QByteArray* basePayload = listener.holdsKnownBase ? &versions[listener.heldVersion] : nullptr;
+        TraitsBuffer buffer;
+        qint64 savedBytes = -1;
+        qint64 bytesWritten = AvatarTraits::packVersionedTraitInstanceUpdate(AvatarTraits::AvatarEntity, instanceID, buffer,
+                                                                             currentVersion, current, listener.heldVersion,
+                                                                             basePayload, savedBytes);
+        listener.sentBytes.record(bytesWritten, savedBytes);
+
+        QCOMPARE(bytesWritten, (qint64)buffer.data.size());
+        QVERIFY(readVersionedInstance(buffer.data, listener.heldVersion, listener.payload));
+        QCOMPARE(listener.payload, current);
+
+        // the counters add up to what went out, and to what the whole instance would have cost
+        QCOMPARE(listener.sentBytes.sent, bytesWritten);
+        QCOMPARE(listener.sentBytes.sent + listener.sentBytes.savedByDeltas, INSTANCE_HEADER_SIZE + current.size());
+        if (listener.holdsKnownBase) {
+            QVERIFY(listener.sentBytes.savedByDeltas > 0);
+        } else {
+            QCOMPARE(listener.sentBytes.savedByDeltas, (qint64)0);
+        }
+    }
+
+    // a delta that reaches a listener holding another version than it was based on doesn't apply
+    TraitsBuffer buffer;
+    qint64 savedBytes = 0;
+    AvatarTraits::packVersionedTraitInstanceUpdate(AvatarTraits::AvatarEntity, instanceID, buffer, currentVersion, current,
+                                                   2, &versions[2], savedBytes);
+    QByteArray payload = versions[1];
+    QVERIFY(!readVersionedInstance(buffer.data, 1, payload));
+}
+
+void AvatarTraitsTests::testInterestDeferral() {
+    const float RADIUS = 20.0f;
+    const glm::vec3 LISTENER(0.0f);
+    QVERIFY(!DeferredTraitSenders::isOutsideInterest(LISTENER, glm::vec3(0.0f, 0.0f, 10.0f), RADIUS));
+    QVERIFY(DeferredTraitSenders::isOutsideInterest(LISTENER, glm::vec3(0.0f, 0.0f, 30.0f), RADIUS));
+    QVERIFY(!DeferredTraitSenders::isOutsideInterest(LISTENER, glm::vec3(0.0f, 0.0f, 30.0f), 0.0f));
+
+    DeferredTraitSenders deferred;
+    uint64_t now = 1000;
+    QVERIFY(deferred.release(LISTENER, RADIUS, now).empty());
+
+    deferred.defer(1, LISTENER, now);
+    deferred.defer(2, LISTENER, now);
+    deferred.defer(1, LISTENER, now);
+    QCOMPARE(deferred.size(), 2);
+    QVERIFY(deferred.isDeferred(1));
+
+    // they wait while the listener stays put
+    now += DeferredTraitSenders::RECHECK_INTERVAL_USECS / 2;
+    QVERIFY(deferred.release(LISTENER + glm::vec3(1.0f, 0.0f, 0.0f), RADIUS, now).empty());
+    QCOMPARE(deferred.size(), 2);
+
+    // and are all released once it has moved far enough
+    glm::vec3 moved = LISTENER + glm::vec3(RADIUS * DeferredTraitSenders::RECHECK_DISTANCE_FRACTION + 1.0f, 0.0f, 0.0f);
+    auto released = deferred.release(moved, RADIUS, now);
+    QCOMPARE((int)released.size(), 2);
+    QCOMPARE(deferred.size(), 0);
+
+    // or, if it doesn't move, once enough time has passed for them to have come closer
+    deferred.defer(3, moved, now);
+    now += DeferredTraitSenders::RECHECK_INTERVAL_USECS + 1;
+    released = deferred.release(moved, RADIUS, now);
+    QCOMPARE((int)released.size(), 1);
+    QCOMPARE(released[0], (NetworkLocalID)3);
+
+    // turning the radius off releases them straight away
+    deferred.defer(4, moved, now);
+    QCOMPARE((int)deferred.release(moved, 0.0f, now).size(), 1);
+
+    // avatars that leave are forgotten
+    deferred.defer(5, moved, now);
+    deferred.remove(5);
+    QCOMPARE(deferred.size(), 0);
+}
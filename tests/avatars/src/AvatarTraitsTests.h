@@ -0,0 +1,28 @@
+//
+//  AvatarTraitsTests.h
+//  tests/avatars/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_avatars_AvatarTraitsTests_h
+#define hifi_avatars_AvatarTraitsTests_h
+
+#include <QtTest/QtTest>
+
+class AvatarTraitsTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testDeltaRoundTrip();
+    void testDeltaWireFormat();
+    void testAvatarEntityEdits();
+    void testDeltaFanOut();
+    void testInterestDeferral();
+};
+
+#endif // hifi_avatars_AvatarTraitsTests_h
@@ -0,0 +1,152 @@
+//
+//  FBXSerializerTests.cpp
+//  tests/fbx/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FBXSerializerTests.h"
+
+#include <set>
+
+#include <QtCore/QDirIterator>
+#include <QtCore/QProcessEnvironment>
+
+#include <FBXSerializer.h>
+#include <GLTFSerializer.h>
+#include <NumericalConstants.h>
+#include <ResourceManager.h>
+#include <SharedUtil.h>
+
+QTEST_MAIN(FBXSerializerTests)
+
+namespace {
+
+void addModels(QStringList& corpus, const QString& directory, const QStringList& filters) {
+    QDirIterator it(directory, filters, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        corpus.append(it.next());
+    }
+}
+
+// the models that come with the marketplace scripts, along with the .fbx and .glb files under HIFI_MODEL_CORPUS, if set
+QStringList getCorpus(bool includeExternal = true) {
+    QStringList corpus;
+    addModels(corpus, QFileInfo(__FILE__).absolutePath() + "/../../../unpublishedScripts/marketplace", { "*.fbx" });
+
+    QString externalCorpus = QProcessEnvironment::systemEnvironment().value("HIFI_MODEL_CORPUS");
+    if (includeExternal && !externalCorpus.isEmpty()) {
+        addModels(corpus, externalCorpus, { "*.fbx", "*.glb" });
+    }
+
+    corpus.sort();
+    return corpus;
+}
+
+HFMModel::Pointer parse(const QString& path, const QByteArray& data) {
+    hifi::URL url = hifi::URL::fromLocalFile(path);
+    if (path.endsWith(".glb", Qt::CaseInsensitive)) {
+        return GLTFSerializer().read(data, hifi::VariantHash(), url);
+    }
+    return FBXSerializer().read(data, hifi::VariantHash(), url);
+}
+
+QByteArray readModel(const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    return file.readAll();
+}
+
+}
+
+void FBXSerializerTests::initTestCase() {
+    DependencyManager::set<ResourceManager>();
+}
+
+void FBXSerializerTests::cleanupTestCase() {
+    DependencyManager::get<ResourceManager>()->cleanup();
+}
+
+void FBXSerializerTests::testDeterministicMeshes() {
+    auto corpus = getCorpus(false);
+    if (corpus.isEmpty()) {
+        QSKIP("No models to parse");
+    }
+
+    // the meshes and blendshapes are extracted in parallel, but have to come out the same, in the same order, every time
+    for (const auto& path : corpus) {
+        QByteArray data = readModel(path);
+        QVERIFY(!data.isEmpty());
+
+        auto model = parse(path, data);
+        auto other = parse(path, data);
+        QVERIFY(model && other);
+        QCOMPARE(model->meshes.size(), other->meshes.size());
+
+        std::set<unsigned int> meshIndices;
+        for (size_t i = 0; i < model->meshes.size(); i++) {
+            const auto& mesh = model->meshes[i];
+            const auto& otherMesh = other->meshes[i];
+            QCOMPARE(mesh.meshIndex, otherMesh.meshIndex);
+            QCOMPARE(mesh.parts.size(), otherMesh.parts.size());
+            QVERIFY(mesh.vertices == otherMesh.vertices);
+            QVERIFY(mesh.normals == otherMesh.normals);
+            QVERIFY(mesh.texCoords == otherMesh.texCoords);
+            QCOMPARE(mesh.blendshapes.size(), otherMesh.blendshapes.size());
+            for (int j = 0; j < mesh.blendshapes.size(); j++) {
+                QVERIFY(mesh.blendshapes[j].indices == otherMesh.blendshapes[j].indices);
+                QVERIFY(mesh.blendshapes[j].vertices == otherMesh.blendshapes[j].vertices);
+            }
+            QVERIFY(meshIndices.insert(mesh.meshIndex).second);
+        }
+    }
+}
+
+void FBXSerializerTests::benchmarkParsing() {
+    auto corpus = getCorpus();
+    if (corpus.isEmpty()) {
+        QSKIP("No models to parse");
+    }
+
+    const int NUM_PARSES = 5;
+    uint64_t totalUsecs = 0;
+    uint64_t totalBytes = 0;
+    for (const auto& path : corpus) {
+        QByteArray data = readModel(path);
+        QVERIFY(!data.isEmpty());
+
+        size_t numMeshes = 0;
+        int numVertices = 0;
+        uint64_t start = usecTimestampNow();
+        for (int i = 0; i < NUM_PARSES; i++) {
+            auto model = parse(path, data);
+            QVERIFY(model);
+            numMeshes = model->meshes.size();
+            numVertices = 0;
+            for (const auto& mesh : model->meshes) {
+                numVertices += mesh.vertices.size();
+            }
+        }
+        uint64_t usecs = (usecTimestampNow() - start) / NUM_PARSES;
+        totalUsecs += usecs;
+        totalBytes += data.size();
+
+        // the peak of the process so far, which the biggest model sets
+        MemoryInfo memoryInfo;
+        QString peakMemory = "n/a";
+        if (getMemoryInfo(memoryInfo)) {
+            peakMemory = QString::number(memoryInfo.processPeakUsedMemoryBytes / BYTES_PER_KILOBYTE) + " KB";
+        }
+
+        qDebug() << QFileInfo(path).fileName() << data.size() / BYTES_PER_KILOBYTE << "KB," << numMeshes << "meshes,"
+            << numVertices << "vertices:" << usecs << "us/parse, peak memory" << peakMemory;
+    }
+
+    qDebug() << corpus.size() << "models," << totalBytes / BYTES_PER_KILOBYTE << "KB:" << totalUsecs << "us/parse";
+}
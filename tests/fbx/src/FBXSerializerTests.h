@@ -0,0 +1,28 @@
+//
+//  FBXSerializerTests.h
+//  tests/fbx/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_FBXSerializerTests_h
+#define hifi_FBXSerializerTests_h
+
+#include <QtTest/QtTest>
+
+class FBXSerializerTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void testDeterministicMeshes();
+    void benchmarkParsing();
+};
+
+#endif // hifi_FBXSerializerTests_h
@@ -0,0 +1,549 @@
+//
+//  BakerTests.cpp
+//  tests/model-baker/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BakerTests.h"
+
+#include <cfloat>
+#include <numeric>
+
+#include <QtCore/QDirIterator>
+#include <QtCore/QProcessEnvironment>
+
+#include <FBXSerializer.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+#include <model-baker/Baker.h>
+#include <model-baker/BuildMeshLODsTask.h>
+#include <model-baker/CalculateBlendshapeNormalsTask.h>
+#include <model-baker/CalculateBlendshapeTangentsTask.h>
+#include <model-baker/CalculateMeshNormalsTask.h>
+#include <model-baker/CalculateMeshTangentsTask.h>
+
+QTEST_MAIN(BakerTests)
+
+namespace {
+
+// the default avatar, which has blendshapes to calculate normals and tangents for, along with its meshes
+const QString AVATAR_PATH = QFileInfo(__FILE__).absolutePath() + "/../../../interface/resources/meshes/lynden/lynden.fbx";
+
+hfm::Model::Pointer loadAvatar(const QString& path = AVATAR_PATH) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return nullptr;
+    }
+    return FBXSerializer().read(file.readAll(), hifi::VariantHash(), hifi::URL::fromLocalFile(path));
+}
+
+// up to count of the .fbx files under HIFI_MODEL_CORPUS, if set, and the default avatar over and over to make up the rest
+QStringList getAvatars(int count) {
+    QStringList avatars;
+    QString corpus = QProcessEnvironment::systemEnvironment().value("HIFI_MODEL_CORPUS");
+    if (!corpus.isEmpty()) {
+        QDirIterator it(corpus, { "*.fbx" }, QDir::Files, QDirIterator::Subdirectories);
+        while (it.hasNext() && avatars.size() < count) {
+            avatars.append(it.next());
+        }
+        avatars.sort();
+    }
+    while (avatars.size() < count) {
+        avatars.append(AVATAR_PATH);
+    }
+    return avatars;
+}
+
+QString getMemoryUsage() {
+    MemoryInfo memoryInfo;
+    if (!getMemoryInfo(memoryInfo)) {
+        return "n/a";
+    }
+    return QString("%1 KB, peak %2 KB").arg(memoryInfo.processUsedMemoryBytes / BYTES_PER_KILOBYTE)
+        .arg(memoryInfo.processPeakUsedMemoryBytes / BYTES_PER_KILOBYTE);
+}
+
+// the baker builds its model out of the one it is given, so every bake starts from a copy
+hfm::Model::Pointer bake(const hfm::Model& model, bool isParallel) {
+    baker::Baker baker(std::make_shared<hfm::Model>(model), hifi::VariantHash(), hifi::URL());
+    baker.getConfiguration()->setParallel(isParallel);
+    baker.run();
+    return baker.getHFMModel();
+}
+
+// The normals and tangents of a mesh, or of a blendshape when it has a lookup, worked out one face and one edge at a time,
+// the way the baker did before it worked them out in parallel
+class ReferenceNormalsAndTangents {
+public:
+    ReferenceNormalsAndTangents(const hfm::Mesh& mesh) : _mesh(mesh), _numSlots(mesh.vertices.size()) {}
+    ReferenceNormalsAndTangents(const hfm::Mesh& mesh, const hfm::Blendshape& blendshape) :
+        _mesh(mesh), _movedVertices(blendshape.vertices), _lookup(mesh.vertices.size()), _numSlots(blendshape.vertices.size()) {
+        std::iota(_lookup.begin(), _lookup.end(), 0);
+        for (int i = 0; i < blendshape.indices.size(); i++) {
+            _lookup[blendshape.indices[i]] = i;
+        }
+    }
+
+    std::vector<glm::vec3> getNormals() const {
+        std::vector<glm::vec3> normals(_mesh.vertices.size());
+        forEachFace([&](const int* face, int numVertices) {
+            for (int i = 0; i < numVertices; i++) {
+                if (lookup(face[i]) >= _numSlots) {
+                    return;
+                }
+            }
+            glm::vec3 normal = glm::cross(position(face[1]) - position(face[0]), position(face[2]) - position(face[0]));
+            for (int i = 0; i < numVertices; i++) {
+                normals[lookup(face[i])] = normal;
+            }
+        });
+        return normals;
+    }
+
+    std::vector<glm::vec3> getTangents(const std::vector<glm::vec3>& normals) const {
+        std::vector<glm::vec3> tangents(normals.size());
+        if (_mesh.texCoords.size() < _mesh.vertices.size()) {
+            return tangents;
+        }
+        forEachFace([&](const int* face, int numVertices) {
+            for (int i = 0; i < numVertices; i++) {
+                int first = face[i];
+                int second = face[(i + 1) % numVertices];
+                if (lookup(first) >= _numSlots) {
+                    continue;
+                }
+                glm::vec3 normal = normals[lookup(first)];
+                glm::vec3 bitangent = glm::cross(normal, position(second) - position(first));
+                if (glm::length(bitangent) < EPSILON) {
+                    continue;
+                }
+                glm::vec2 texCoordDelta = _mesh.texCoords[lookup(second)] - _mesh.texCoords[lookup(first)];
+                glm::vec3 normalizedNormal = glm::normalize(normal);
+                tangents[lookup(first)] += glm::cross(glm::angleAxis(-atan2f(-texCoordDelta.t, texCoordDelta.s), normalizedNormal) *
+                    glm::normalize(bitangent), normalizedNormal);
+            }
+        });
+        return tangents;
+    }
+
+private:
+    int lookup(int vertex) const { return _lookup.empty() ? vertex : _lookup[vertex]; }
+    glm::vec3 position(int vertex) const {
+        int index = lookup(vertex);
+        return index < _movedVertices.size() ? _movedVertices[index] : _mesh.vertices[index];
+    }
+
+    template <typename F>
+    void forEachFace(F f) const {
+        for (const auto& part : _mesh.parts) {
+            for (int i = 0; i + 4 <= part.quadIndices.size(); i += 4) {
+                f(part.quadIndices.constData() + i, 4);
+            }
+            for (int i = 0; i + 3 <= part.triangleIndices.size(); i += 3) {
+                f(part.triangleIndices.constData() + i, 3);
+            }
+        }
+    }
+
+    const hfm::Mesh& _mesh;
+    QVector<glm::vec3> _movedVertices;
+    std::vector<int> _lookup;
+    int _numSlots;
+};
+
+// the avatar's meshes and blendshapes, without the normals and tangents that came with them, so they all get worked out
+bool loadBareMeshes(std::vector<hfm::Mesh>& meshes, baker::BlendshapesPerMesh& blendshapesPerMesh) {
+    auto avatar = loadAvatar();
+    if (!avatar) {
+        return false;
+    }
+    meshes = avatar->meshes;
+    for (auto& mesh : meshes) {
+        mesh.normals.clear();
+        mesh.tangents.clear();
+        blendshapesPerMesh.emplace_back();
+        for (auto blendshape : mesh.blendshapes) {
+            blendshape.normals.clear();
+            blendshape.tangents.clear();
+            blendshapesPerMesh.back().push_back(blendshape);
+        }
+    }
+    return true;
+}
+
+// a closed sphere of rings by segments, all in one part, with nothing to hold any of its vertices in place
+hfm::Mesh makeSphere(int rings, int segments) {
+    hfm::Mesh mesh;
+    mesh.vertices.append(glm::vec3(0.0f, 1.0f, 0.0f));
+    for (int ring = 1; ring < rings; ring++) {
+        float latitude = PI * (float)ring / (float)rings;
+        for (int segment = 0; segment < segments; segment++) {
+            float longitude = TWO_PI * (float)segment / (float)segments;
+            mesh.vertices.append(glm::vec3(sinf(latitude) * cosf(longitude), cosf(latitude), sinf(latitude) * sinf(longitude)));
+        }
+    }
+    mesh.vertices.append(glm::vec3(0.0f, -1.0f, 0.0f));
+
+    hfm::MeshPart part;
+    int southPole = mesh.vertices.size() - 1;
+    auto ringVertex = [&](int ring, int segment) { return 1 + (ring - 1) * segments + segment % segments; };
+    for (int segment = 0; segment < segments; segment++) {
+        part.triangleIndices << 0 << ringVertex(1, segment + 1) << ringVertex(1, segment);
+        part.triangleIndices << southPole << ringVertex(rings - 1, segment) << ringVertex(rings - 1, segment + 1);
+        for (int ring = 1; ring < rings - 1; ring++) {
+            part.triangleIndices << ringVertex(ring, segment) << ringVertex(ring, segment + 1) << ringVertex(ring + 1, segment);
+            part.triangleIndices << ringVertex(ring + 1, segment) << ringVertex(ring, segment + 1) << ringVertex(ring + 1, segment + 1);
+        }
+    }
+    mesh.parts.push_back(part);
+    return mesh;
+}
+
+int getNumTriangles(const hfm::Mesh& mesh) {
+    int numIndices = 0;
+    for (const auto& part : mesh.parts) {
+        numIndices += part.quadTrianglesIndices.size() + part.triangleIndices.size();
+    }
+    return numIndices / 3;
+}
+
+int getNumTriangles(const hfm::MeshLOD& lod) {
+    int numIndices = 0;
+    for (const auto& partIndices : lod.partTriangleIndices) {
+        numIndices += partIndices.size();
+    }
+    return numIndices / 3;
+}
+
+bool isClose(const std::vector<glm::vec3>& values, const std::vector<glm::vec3>& expected) {
+    if (values.size() != expected.size()) {
+        return false;
+    }
+    const float TOLERANCE = 1.0e-4f;
+    for (size_t i = 0; i < values.size(); i++) {
+        if (glm::length(values[i] - expected[i]) > TOLERANCE * glm::max(1.0f, glm::length(expected[i]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+void BakerTests::testParallelBaking() {
+    auto avatar = loadAvatar();
+    QVERIFY(avatar);
+
+    auto sequential = bake(*avatar, false);
+    auto parallel = bake(*avatar, true);
+    QVERIFY(sequential && parallel);
+
+    QCOMPARE(parallel->meshes.size(), sequential->meshes.size());
+    for (size_t i = 0; i < sequential->meshes.size(); i++) {
+        const auto& mesh = sequential->meshes[i];
+        const auto& parallelMesh = parallel->meshes[i];
+        QVERIFY(parallelMesh.normals == mesh.normals);
+        QVERIFY(parallelMesh.tangents == mesh.tangents);
+        if (mesh._mesh && parallelMesh._mesh) {
+            QCOMPARE(parallelMesh._mesh->getNumLODs(), mesh._mesh->getNumLODs());
+        }
+        QCOMPARE(parallelMesh.triangleListMesh.indices.size(), mesh.triangleListMesh.indices.size());
+        QCOMPARE(parallelMesh._mesh != nullptr, mesh._mesh != nullptr);
+        QCOMPARE(parallelMesh.blendshapes.size(), mesh.blendshapes.size());
+        for (int j = 0; j < mesh.blendshapes.size(); j++) {
+            QVERIFY(parallelMesh.blendshapes[j].normals == mesh.blendshapes[j].normals);
+            QVERIFY(parallelMesh.blendshapes[j].tangents == mesh.blendshapes[j].tangents);
+        }
+    }
+    QCOMPARE(parallel->joints.size(), sequential->joints.size());
+    QCOMPARE(parallel->jointIndices, sequential->jointIndices);
+    QCOMPARE(parallel->shapeVertices.size(), sequential->shapeVertices.size());
+    QVERIFY(parallel->meshExtents.minimum == sequential->meshExtents.minimum);
+    QVERIFY(parallel->meshExtents.maximum == sequential->meshExtents.maximum);
+}
+
+void BakerTests::benchmarkParallelBaking() {
+    auto avatar = loadAvatar();
+    QVERIFY(avatar);
+
+    const int NUM_BAKES = 10;
+    int numBaked = 0;
+    auto timeBakes = [&](bool isParallel) {
+        uint64_t start = usecTimestampNow();
+        for (int i = 0; i < NUM_BAKES; i++) {
+            numBaked += bake(*avatar, isParallel) ? 1 : 0;
+        }
+        return (usecTimestampNow() - start) / NUM_BAKES;
+    };
+
+    // warm up the worker pool and the allocator before timing anything
+    bake(*avatar, true);
+
+    uint64_t sequentialUsecs = timeBakes(false);
+    uint64_t parallelUsecs = timeBakes(true);
+    QCOMPARE(numBaked, 2 * NUM_BAKES);
+
+    qDebug() << QFileInfo(AVATAR_PATH).fileName() << avatar->meshes.size() << "meshes, on" << QThread::idealThreadCount()
+        << "threads:" << sequentialUsecs << "us/bake sequential," << parallelUsecs << "us/bake parallel";
+}
+
+void BakerTests::testSparseBlendshapes() {
+    auto avatar = loadAvatar();
+    QVERIFY(avatar);
+
+    auto baked = bake(*avatar, false);
+    QVERIFY(baked);
+
+    // the calculated normals and tangents of a blendshape are kept for its own vertices, not the whole mesh's
+    int numBlendshapes = 0;
+    for (const auto& mesh : baked->meshes) {
+        for (const auto& blendshape : mesh.blendshapes) {
+            QCOMPARE(blendshape.normals.size(), blendshape.indices.size());
+            QVERIFY(blendshape.tangents.isEmpty() || blendshape.tangents.size() == blendshape.indices.size());
+            numBlendshapes++;
+        }
+    }
+    QVERIFY(numBlendshapes > 0);
+}
+
+void BakerTests::benchmarkAvatarMemory() {
+    const int NUM_AVATARS = 50;
+    auto avatars = getAvatars(NUM_AVATARS);
+    qDebug() << "before loading" << NUM_AVATARS << "avatars:" << getMemoryUsage();
+
+    // load and bake them all the way a domain full of avatars would, keeping each one around
+    std::vector<hfm::Model::Pointer> baked;
+    baked.reserve(avatars.size());
+    uint64_t start = usecTimestampNow();
+    for (const auto& path : avatars) {
+        auto avatar = loadAvatar(path);
+        QVERIFY(avatar);
+        baker::Baker baker(avatar, hifi::VariantHash(), hifi::URL());
+        baker.run();
+        baked.push_back(baker.getHFMModel());
+        QVERIFY(baked.back());
+    }
+    uint64_t usecs = usecTimestampNow() - start;
+
+    int numMeshes = 0;
+    int numVertices = 0;
+    for (const auto& model : baked) {
+        numMeshes += (int)model->meshes.size();
+        for (const auto& mesh : model->meshes) {
+            numVertices += mesh.vertices.size();
+        }
+    }
+
+    QStringList distinctAvatars = avatars;
+    distinctAvatars.removeDuplicates();
+    qDebug() << "after loading" << distinctAvatars.size() << "distinct avatars" << baked.size() << "times," << numMeshes
+        << "meshes," << numVertices << "vertices:" << getMemoryUsage() << "at" << usecs / baked.size() << "us/avatar";
+}
+
+void BakerTests::testNormalsAndTangents() {
+    std::vector<hfm::Mesh> meshes;
+    baker::BlendshapesPerMesh blendshapesPerMesh;
+    QVERIFY(loadBareMeshes(meshes, blendshapesPerMesh));
+
+    baker::NormalsPerMesh normalsPerMesh;
+    CalculateMeshNormalsTask().run(nullptr, meshes, normalsPerMesh);
+    baker::TangentsPerMesh tangentsPerMesh;
+    CalculateMeshTangentsTask().run(nullptr, CalculateMeshTangentsTask::Input(normalsPerMesh, meshes), tangentsPerMesh);
+    std::vector<baker::NormalsPerBlendshape> normalsPerBlendshapePerMesh;
+    CalculateBlendshapeNormalsTask().run(nullptr, CalculateBlendshapeNormalsTask::Input(blendshapesPerMesh, meshes),
+                                         normalsPerBlendshapePerMesh);
+    std::vector<baker::TangentsPerBlendshape> tangentsPerBlendshapePerMesh;
+    CalculateBlendshapeTangentsTask().run(nullptr,
+        CalculateBlendshapeTangentsTask::Input(normalsPerBlendshapePerMesh, blendshapesPerMesh, meshes), tangentsPerBlendshapePerMesh);
+
+    int numBlendshapes = 0;
+    QCOMPARE(normalsPerMesh.size(), meshes.size());
+    for (size_t i = 0; i < meshes.size(); i++) {
+        ReferenceNormalsAndTangents reference(meshes[i]);
+        auto normals = reference.getNormals();
+        QVERIFY(isClose(normalsPerMesh[i], normals));
+        if (!tangentsPerMesh[i].empty()) {
+            QVERIFY(isClose(tangentsPerMesh[i], reference.getTangents(normals)));
+        }
+
+        const auto& blendshapes = blendshapesPerMesh[i];
+        QCOMPARE(normalsPerBlendshapePerMesh[i].size(), blendshapes.size());
+        for (size_t j = 0; j < blendshapes.size(); j++) {
+            ReferenceNormalsAndTangents blendshapeReference(meshes[i], blendshapes[j]);
+            auto blendshapeNormals = blendshapeReference.getNormals();
+            QVERIFY(isClose(normalsPerBlendshapePerMesh[i][j], blendshapeNormals));
+            if (!tangentsPerBlendshapePerMesh[i][j].empty()) {
+                QVERIFY(isClose(tangentsPerBlendshapePerMesh[i][j], blendshapeReference.getTangents(blendshapeNormals)));
+            }
+            numBlendshapes++;
+        }
+    }
+    QVERIFY(numBlendshapes > 0);
+}
+
+void BakerTests::benchmarkNormalsAndTangents() {
+    std::vector<hfm::Mesh> meshes;
+    baker::BlendshapesPerMesh blendshapesPerMesh;
+    QVERIFY(loadBareMeshes(meshes, blendshapesPerMesh));
+
+    const int NUM_RUNS = 5;
+    int numBlendshapes = 0;
+    uint64_t start = usecTimestampNow();
+    for (int run = 0; run < NUM_RUNS; run++) {
+        numBlendshapes = 0;
+        for (size_t i = 0; i < meshes.size(); i++) {
+            ReferenceNormalsAndTangents(meshes[i]).getTangents(ReferenceNormalsAndTangents(meshes[i]).getNormals());
+            for (const auto& blendshape : blendshapesPerMesh[i]) {
+                ReferenceNormalsAndTangents reference(meshes[i], blendshape);
+                reference.getTangents(reference.getNormals());
+                numBlendshapes++;
+            }
+        }
+    }
+    uint64_t referenceUsecs = (usecTimestampNow() - start) / NUM_RUNS;
+
+    start = usecTimestampNow();
+    for (int run = 0; run < NUM_RUNS; run++) {
+        baker::NormalsPerMesh normalsPerMesh;
+        CalculateMeshNormalsTask().run(nullptr, meshes, normalsPerMesh);
+        baker::TangentsPerMesh tangentsPerMesh;
+        CalculateMeshTangentsTask().run(nullptr, CalculateMeshTangentsTask::Input(normalsPerMesh, meshes), tangentsPerMesh);
+        std::vector<baker::NormalsPerBlendshape> normalsPerBlendshapePerMesh;
+        CalculateBlendshapeNormalsTask().run(nullptr, CalculateBlendshapeNormalsTask::Input(blendshapesPerMesh, meshes),
+                                             normalsPerBlendshapePerMesh);
+        std::vector<baker::TangentsPerBlendshape> tangentsPerBlendshapePerMesh;
+        CalculateBlendshapeTangentsTask().run(nullptr,
+            CalculateBlendshapeTangentsTask::Input(normalsPerBlendshapePerMesh, blendshapesPerMesh, meshes), tangentsPerBlendshapePerMesh);
+    }
+    uint64_t usecs = (usecTimestampNow() - start) / NUM_RUNS;
+
+    qDebug() << QFileInfo(AVATAR_PATH).fileName() << meshes.size() << "meshes," << numBlendshapes << "blendshapes, on"
+        << QThread::idealThreadCount() << "threads:" << referenceUsecs << "us one face at a time," << usecs << "us in parallel";
+}
+
+void BakerTests::testMeshLODs() {
+    auto avatar = loadAvatar();
+    QVERIFY(avatar);
+    std::vector<hfm::Mesh> meshes = avatar->meshes;
+    meshes.push_back(makeSphere(64, 128));
+
+    baker::LODsPerMesh lodsPerMesh;
+    BuildMeshLODsTask().run(nullptr, meshes, lodsPerMesh);
+    QCOMPARE(lodsPerMesh.size(), meshes.size());
+
+    for (size_t i = 0; i < meshes.size(); i++) {
+        const auto& mesh = meshes[i];
+        int numTriangles = getNumTriangles(mesh);
+        float error = 0.0f;
+        for (const auto& lod : lodsPerMesh[i]) {
+            // coarser every time, as far from the surface or further, and only out of the mesh's own vertices
+            int numLODTriangles = getNumTriangles(lod);
+            QVERIFY(numLODTriangles < numTriangles);
+            QVERIFY(lod.error >= error);
+            QCOMPARE(lod.partTriangleIndices.size(), mesh.parts.size());
+            for (const auto& partIndices : lod.partTriangleIndices) {
+                QCOMPARE(partIndices.size() % 3, 0);
+                for (int j = 0; j < partIndices.size(); j += 3) {
+                    QVERIFY(partIndices[j] >= 0 && partIndices[j] < mesh.vertices.size());
+                    QVERIFY(partIndices[j + 1] >= 0 && partIndices[j + 1] < mesh.vertices.size());
+                    QVERIFY(partIndices[j + 2] >= 0 && partIndices[j + 2] < mesh.vertices.size());
+                    QVERIFY(partIndices[j] != partIndices[j + 1] && partIndices[j + 1] != partIndices[j + 2] &&
+                        partIndices[j + 2] != partIndices[j]);
+                }
+            }
+            numTriangles = numLODTriangles;
+            error = lod.error;
+        }
+    }
+
+    // nothing holds the sphere together but its own curvature, so every LOD halves it, and stays close to it, though not
+    // on it
+    const auto& sphereLODs = lodsPerMesh.back();
+    QCOMPARE((int)sphereLODs.size(), BuildMeshLODsConfig().maxLODs);
+    int numSphereTriangles = getNumTriangles(meshes.back());
+    for (const auto& lod : sphereLODs) {
+        QVERIFY(getNumTriangles(lod) <= numSphereTriangles / 2);
+        numSphereTriangles = getNumTriangles(lod);
+        QVERIFY(lod.error > 0.0f && lod.error < 0.1f);
+    }
+
+    // and the LODs make it to the graphics meshes, after the parts in the index buffer
+    auto baked = bake(*avatar, false);
+    QVERIFY(baked);
+    QCOMPARE(baked->meshes.size(), avatar->meshes.size());
+    for (size_t i = 0; i < baked->meshes.size(); i++) {
+        const auto& mesh = baked->meshes[i];
+        if (!mesh._mesh) {
+            continue;
+        }
+        QCOMPARE(mesh._mesh->getNumLODs(), lodsPerMesh[i].size());
+        size_t numIndices = 3 * getNumTriangles(mesh);
+        for (const auto& lod : mesh._mesh->getLODs()) {
+            QCOMPARE(lod.parts.size(), mesh._mesh->getNumParts());
+            for (const auto& part : lod.parts) {
+                QVERIFY((size_t)(part._startIndex + part._numIndices) <= mesh._mesh->getNumIndices());
+                numIndices += part._numIndices;
+            }
+        }
+        QCOMPARE(mesh._mesh->getNumIndices(), numIndices);
+        QCOMPARE(mesh._mesh->evalLOD(-1.0f), 0);
+        QCOMPARE(mesh._mesh->evalLOD(FLT_MAX), (int)mesh._mesh->getNumLODs());
+    }
+}
+
+void BakerTests::benchmarkMeshLODs() {
+    auto avatar = loadAvatar();
+    QVERIFY(avatar);
+
+    const int NUM_RUNS = 5;
+    baker::LODsPerMesh lodsPerMesh;
+    uint64_t start = usecTimestampNow();
+    for (int run = 0; run < NUM_RUNS; run++) {
+        BuildMeshLODsTask().run(nullptr, avatar->meshes, lodsPerMesh);
+    }
+    uint64_t usecs = (usecTimestampNow() - start) / NUM_RUNS;
+
+    auto baked = bake(*avatar, false);
+    QVERIFY(baked);
+
+    // A test scene: a crowd of the avatar, a row every meter out to 100 m, ten to a row, seen on a 1080p screen with a
+    // 90 degree field of view.  This is what MeshPartPayload does for each part, with the avatar's size standing in for the
+    // parts' bounds.
+    const int NUM_ROWS = 100;
+    const int AVATARS_PER_ROW = 10;
+    const float VIEWPORT_HEIGHT = 1080.0f;
+    const float PROJECTION_Y_SCALE = 1.0f / tanf(0.25f * PI);
+    const float MAX_PIXEL_ERROR = 1.0f;
+    float radius = 0.5f * glm::length(baked->meshExtents.size());
+    int64_t numTriangles = 0;
+    int64_t numLODTriangles = 0;
+    for (int row = 1; row <= NUM_ROWS; row++) {
+        float distance = std::max((float)row - radius, 0.01f);
+        float pixelsPerMeter = 0.5f * VIEWPORT_HEIGHT * PROJECTION_Y_SCALE / distance;
+        for (const auto& mesh : baked->meshes) {
+            if (!mesh._mesh) {
+                continue;
+            }
+            int lod = mesh._mesh->evalLOD(MAX_PIXEL_ERROR / pixelsPerMeter);
+            for (int i = 0; i < (int)mesh._mesh->getNumParts(); i++) {
+                auto part = mesh._mesh->getPartBuffer().get<graphics::Mesh::Part>(i);
+                numTriangles += AVATARS_PER_ROW * (part._numIndices / 3);
+                auto lodPart = lod > 0 ? mesh._mesh->getLODs()[lod - 1].parts[i] : part;
+                numLODTriangles += AVATARS_PER_ROW * (lodPart._numIndices / 3);
+            }
+        }
+    }
+
+    int numLODs = 0;
+    for (const auto& lods : lodsPerMesh) {
+        numLODs += (int)lods.size();
+    }
+    qDebug() << QFileInfo(AVATAR_PATH).fileName() << avatar->meshes.size() << "meshes," << numLODs << "LODs:" << usecs
+        << "us to simplify," << NUM_ROWS * AVATARS_PER_ROW << "avatars:" << numTriangles << "triangles/frame without LODs,"
+        << numLODTriangles << "with";
+}
@@ -0,0 +1,31 @@
+//
+//  BakerTests.h
+//  tests/model-baker/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BakerTests_h
+#define hifi_BakerTests_h
+
+#include <QtTest/QtTest>
+
+class BakerTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testParallelBaking();
+    void benchmarkParallelBaking();
+    void testSparseBlendshapes();
+    void benchmarkAvatarMemory();
+    void testNormalsAndTangents();
+    void benchmarkNormalsAndTangents();
+    void testMeshLODs();
+    void benchmarkMeshLODs();
+};
+
+#endif // hifi_BakerTests_h
@@ -0,0 +1,284 @@
+//
+//  DomainListDeltasTests.cpp
+//  tests/networking/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "DomainListDeltasTests.h"
+
+#include <DomainListDeltas.h>
+#include <SharedUtil.h>
+
+QTEST_MAIN(DomainListDeltasTests)
+
+static std::vector<DomainListDeltas::Change> changesFor(const DomainListDeltas::Batch& batch, const QUuid& nodeID,
+                                                       const NodeSet& interestSet, DomainListDeltas::Version sinceVersion) {
+    std::vector<DomainListDeltas::Change> changes;
+    batch.forEachChangeFor(nodeID, interestSet, sinceVersion, [&](const DomainListDeltas::Change& change) {
+        changes.push_back(change);
+    });
+    return changes;
+}
+
+void DomainListDeltasTests::testCoalescing() {
+    DomainListDeltas deltas;
+    QUuid a = QUuid::createUuid();
+    QUuid b = QUuid::createUuid();
+    QUuid c = QUuid::createUuid();
+
+    QCOMPARE(deltas.addNode(a, NodeType::Agent), (DomainListDeltas::Version)1);
+    deltas.removeNode(b, NodeType::Agent);
+    deltas.addNode(c, NodeType::Agent);
+    deltas.addNode(a, NodeType::Agent);
+    deltas.removeNode(c, NodeType::Agent);
+    deltas.addNode(c, NodeType::Agent);
+    QCOMPARE(deltas.getVersion(), (DomainListDeltas::Version)6);
+
+    // the second addition of a replaces the first, the first addition of c is dropped by its removal
+    QCOMPARE(deltas.getNumPendingChanges(), (size_t)4);
+    auto batch = deltas.takePendingChanges();
+    QVERIFY(!deltas.hasPendingChanges());
+
+    const auto& changes = batch.getChanges();
+    QCOMPARE((int)changes.size(), 4);
+    QCOMPARE(changes[0].nodeID, a);
+    QCOMPARE(changes[0].version, (DomainListDeltas::Version)4);
+    QVERIFY(!changes[0].isRemoval);
+    QCOMPARE(changes[1].nodeID, b);
+    QVERIFY(changes[1].isRemoval);
+    QCOMPARE(changes[2].nodeID, c);
+    QVERIFY(changes[2].isRemoval);
+    QCOMPARE(changes[3].nodeID, c);
+    QVERIFY(!changes[3].isRemoval);
+
+    QVERIFY(deltas.takePendingChanges().isEmpty());
+}
+
+void DomainListDeltasTests::testFiltering() {
+    DomainListDeltas deltas;
+    QUuid agent = QUuid::createUuid();
+    QUuid otherAgent = QUuid::createUuid();
+    QUuid audioMixer = QUuid::createUuid();
+    QUuid avatarMixer = QUuid::createUuid();
+
+    deltas.addNode(audioMixer, NodeType::AudioMixer);
+    deltas.addNode(agent, NodeType::Agent);
+    auto snapshotVersion = deltas.getVersion();
+    deltas.addNode(avatarMixer, NodeType::AvatarMixer);
+    deltas.addNode(otherAgent, NodeType::Agent);
+    auto batch = deltas.takePendingChanges();
+
+    // an agent only hears about the mixers, and only about the ones it wasn't already sent in a full list
+    NodeSet agentInterests { NodeType::AudioMixer, NodeType::AvatarMixer };
+    auto changes = changesFor(batch, agent, agentInterests, DomainListDeltas::NO_VERSION);
+    QCOMPARE((int)changes.size(), 2);
+    changes = changesFor(batch, agent, agentInterests, snapshotVersion);
+    QCOMPARE((int)changes.size(), 1);
+    QCOMPARE(changes[0].nodeID, avatarMixer);
+
+    // a mixer hears about every agent but itself
+    NodeSet mixerInterests { NodeType::Agent, NodeType::AudioMixer };
+    changes = changesFor(batch, audioMixer, mixerInterests, DomainListDeltas::NO_VERSION);
+    QCOMPARE((int)changes.size(), 2);
+    QCOMPARE(changes[0].nodeID, agent);
+    QCOMPARE(changes[1].nodeID, otherAgent);
+}
+
+namespace {
+
+// rough sizes of what the domain-server sends, see DomainServer::sendDomainListToNode
+const quint64 PACKET_HEADER_BYTES = 30;
+const quint64 DOMAIN_LIST_HEADER_BYTES = PACKET_HEADER_BYTES + 60;
+const quint64 NODE_BYTES = 100; // a packed node and the connection secret for it
+
+const int TICK_MSECS = 100;
+const int TICKS_PER_CHECK_IN = 1000 / TICK_MSECS;
+const int DOMAIN_LIST_SNAPSHOT_INTERVAL = 10;
+
+struct SimulatedNode {
+    QUuid id;
+    NodeType_t type;
+    NodeSet interestSet;
+    int checkInTick;
+    DomainListDeltas::Version version { DomainListDeltas::NO_VERSION };
+    int numListsSinceSnapshot { 0 };
+    QSet<QUuid> knownNodes;
+};
+
+struct SimulationResult {
+    quint64 nodeVisits { 0 };
+    quint64 bytesSent { 0 };
+    quint64 usecs { 0 };
+    bool allNodesInSync { true };
+};
+
+// Simulates numAgents agents joining a domain with a handful of assignment clients over joinSeconds, a tenth of them
+// leaving again, and every node checking in once a second.  Either the way the domain-server used to work (a full
+// domain list per check-in, plus a pass over all nodes for every node joining or leaving) or with domain list deltas.
+SimulationResult simulateDomain(int numAgents, int joinSeconds, bool useDeltas) {
+    const std::vector<NodeType_t> ASSIGNMENT_TYPES { NodeType::AudioMixer, NodeType::AvatarMixer, NodeType::MessagesMixer,
+        NodeType::EntityServer, NodeType::AssetServer, NodeType::EntityScriptServer };
+    const NodeSet AGENT_INTERESTS(ASSIGNMENT_TYPES.begin(), ASSIGNMENT_TYPES.end());
+    const NodeSet ASSIGNMENT_INTERESTS { NodeType::Agent, NodeType::AudioMixer, NodeType::AvatarMixer, NodeType::EntityServer };
+
+    const int joinTicks = joinSeconds * 1000 / TICK_MSECS;
+    const int totalTicks = joinTicks + 2 * TICKS_PER_CHECK_IN * DOMAIN_LIST_SNAPSHOT_INTERVAL;
+    const int numLeaving = numAgents / 10;
+
+    SimulationResult result;
+    DomainListDeltas deltas;
+    std::vector<SimulatedNode> nodes;
+
+    auto sendFullList = [&](SimulatedNode& node) {
+        result.bytesSent += DOMAIN_LIST_HEADER_BYTES;
+        node.knownNodes.clear();
+        for (const auto& other : nodes) {
+            result.nodeVisits++;
+            if (other.id != node.id && node.interestSet.contains(other.type)) {
+                result.bytesSent += NODE_BYTES;
+                node.knownNodes.insert(other.id);
+            }
+        }
+    };
+
+    auto broadcast = [&](const SimulatedNode& changed, bool isRemoval) {
+        for (auto& other : nodes) {
+            result.nodeVisits++;
+            if (other.id != changed.id && other.interestSet.contains(changed.type)) {
+                result.bytesSent += PACKET_HEADER_BYTES + (isRemoval ? NUM_BYTES_RFC4122_UUID : NODE_BYTES);
+                if (isRemoval) {
+                    other.knownNodes.remove(changed.id);
+                } else {
+                    other.knownNodes.insert(changed.id);
+                }
+            }
+        }
+    };
+
+    auto join = [&](NodeType_t type, const NodeSet& interestSet, int tick) {
+        SimulatedNode node;
+        node.id = QUuid::createUuid();
+        node.type = type;
+        node.interestSet = interestSet;
+        node.checkInTick = tick % TICKS_PER_CHECK_IN;
+        nodes.push_back(node);
+
+        sendFullList(nodes.back());
+        if (useDeltas) {
+            deltas.addNode(node.id, node.type);
+        } else {
+            broadcast(nodes.back(), false);
+        }
+    };
+
+    auto leave = [&](size_t index) {
+        SimulatedNode node = nodes[index];
+        nodes[index] = nodes.back();
+        nodes.pop_back();
+        if (useDeltas) {
+            deltas.removeNode(node.id, node.type);
+        } else {
+            broadcast(node, true);
+        }
+    };
+
+    quint64 start = usecTimestampNow();
+    for (int i = 0; i < (int)ASSIGNMENT_TYPES.size(); ++i) {
+        join(ASSIGNMENT_TYPES[i], ASSIGNMENT_INTERESTS, i);
+    }
+
+    int numJoined = 0;
+    int numLeft = 0;
+    for (int tick = 0; tick < totalTicks; ++tick) {
+        while (numJoined < numAgents && (quint64)numJoined * joinTicks <= (quint64)tick * numAgents) {
+            join(NodeType::Agent, AGENT_INTERESTS, tick);
+            numJoined++;
+        }
+        while (numLeft < numLeaving && (quint64)numLeft * joinTicks <= (quint64)tick * numLeaving) {
+            // some of the agents that are already in leave again
+            leave(ASSIGNMENT_TYPES.size() + numLeft);
+            numLeft++;
+        }
+
+        for (auto& node : nodes) {
+            if (node.checkInTick != tick % TICKS_PER_CHECK_IN) {
+                continue;
+            }
+            if (!useDeltas) {
+                sendFullList(node);
+            } else if (node.version == DomainListDeltas::NO_VERSION || node.numListsSinceSnapshot >= DOMAIN_LIST_SNAPSHOT_INTERVAL) {
+                sendFullList(node);
+                node.version = deltas.getVersion();
+                node.numListsSinceSnapshot = 0;
+            } else {
+                result.bytesSent += DOMAIN_LIST_HEADER_BYTES;
+                node.numListsSinceSnapshot++;
+            }
+        }
+
+        if (useDeltas && deltas.hasPendingChanges()) {
+            auto batch = deltas.takePendingChanges();
+            for (auto& node : nodes) {
+                result.nodeVisits++;
+                bool sentAdditions = false;
+                bool sentRemovals = false;
+                batch.forEachChangeFor(node.id, node.interestSet, node.version, [&](const DomainListDeltas::Change& change) {
+                    if (change.isRemoval) {
+                        result.bytesSent += NUM_BYTES_RFC4122_UUID;
+                        sentRemovals = true;
+                        node.knownNodes.remove(change.nodeID);
+                    } else {
+                        result.bytesSent += NODE_BYTES;
+                        sentAdditions = true;
+                        node.knownNodes.insert(change.nodeID);
+                    }
+                });
+                result.bytesSent += (sentAdditions ? PACKET_HEADER_BYTES : 0) + (sentRemovals ? PACKET_HEADER_BYTES : 0);
+            }
+        }
+    }
+    result.usecs = usecTimestampNow() - start;
+
+    // every node should know about exactly the nodes it is interested in
+    for (const auto& node : nodes) {
+        int numInteresting = 0;
+        for (const auto& other : nodes) {
+            if (other.id != node.id && node.interestSet.contains(other.type)) {
+                numInteresting++;
+                result.allNodesInSync &= node.knownNodes.contains(other.id);
+            }
+        }
+        result.allNodesInSync &= node.knownNodes.size() == numInteresting;
+    }
+    return result;
+}
+
+}
+
+void DomainListDeltasTests::benchmarkCheckIns() {
+    const int NUM_AGENTS = 1000;
+    const int JOIN_SECONDS = 60;
+
+    auto fullLists = simulateDomain(NUM_AGENTS, JOIN_SECONDS, false);
+    auto deltas = simulateDomain(NUM_AGENTS, JOIN_SECONDS, true);
+
+    auto report = [&](const char* name, const SimulationResult& result) {
+        qDebug() << name << NUM_AGENTS << "agents joining over" << JOIN_SECONDS << "s,"
+            << "node visits" << result.nodeVisits << "MB sent" << (float)result.bytesSent / (1024 * 1024)
+            << "ms" << (float)result.usecs / USECS_PER_MSEC;
+    };
+    report("full lists:", fullLists);
+    report("deltas:", deltas);
+
+    QVERIFY(fullLists.allNodesInSync);
+    QVERIFY(deltas.allNodesInSync);
+
+    // the assignment clients alone were sent a thousand nodes a second, now they mostly get the ones that changed
+    QVERIFY(deltas.bytesSent * 4 < fullLists.bytesSent);
+    QVERIFY(deltas.nodeVisits * 4 < fullLists.nodeVisits);
+}
@@ -0,0 +1,26 @@
+//
+//  DomainListDeltasTests.h
+//  tests/networking/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_DomainListDeltasTests_h
+#define hifi_DomainListDeltasTests_h
+
+#include <QtTest/QtTest>
+
+class DomainListDeltasTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testCoalescing();
+    void testFiltering();
+    void benchmarkCheckIns();
+};
+
+#endif // hifi_DomainListDeltasTests_h
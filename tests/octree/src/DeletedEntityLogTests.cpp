@@ -0,0 +1,258 @@
+//
+//  DeletedEntityLogTests.cpp
+//  tests/octree/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "DeletedEntityLogTests.h"
+
+#include <algorithm>
+#include <thread>
+
+#include <QtCore/QMultiMap>
+
+#include <DeletedEntityLog.h>
+#include <SharedUtil.h>
+
+QTEST_MAIN(DeletedEntityLogTests)
+
+namespace {
+
+QUuid idFor(uint32_t index) {
+    return QUuid(index, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+}
+
+std::vector<QUuid> deletedSince(const DeletedEntityLog& log, DeletedEntityLog::Sequence& cursor, quint64 sinceTime) {
+    std::vector<QUuid> entityIDs;
+    cursor = log.forEachDeletedSince(cursor, sinceTime, [&](const DeletedEntityLog::Entry& deleted) {
+        entityIDs.push_back(deleted.entityID);
+    });
+    return entityIDs;
+}
+
+const quint64 NEVER = (quint64)-1;
+
+}
+
+void DeletedEntityLogTests::testDeletedSince() {
+    DeletedEntityLog log;
+    QVERIFY(log.isEmpty());
+    QVERIFY(!log.hasDeletedSince(DeletedEntityLog::NO_CURSOR, 0));
+
+    log.append(100, idFor(0));
+    log.append(200, std::vector<QUuid> { idFor(1), idFor(2) });
+    // out of order times are raised to keep the log sorted
+    log.append(150, idFor(3));
+    QCOMPARE(log.size(), (size_t)4);
+    QCOMPARE(log.getLastDeletedAt(), (quint64)200);
+
+    // without a cursor only the time counts
+    DeletedEntityLog::Sequence cursor = DeletedEntityLog::NO_CURSOR;
+    QVERIFY(log.hasDeletedSince(cursor, 150));
+    QVERIFY(!log.hasDeletedSince(cursor, 200));
+    auto entityIDs = deletedSince(log, cursor, 150);
+    QCOMPARE((int)entityIDs.size(), 3);
+    QCOMPARE(entityIDs[0], idFor(1));
+    QCOMPARE(entityIDs[2], idFor(3));
+    QCOMPARE(cursor, log.getEnd());
+
+    // the cursor alone finds what was appended since, whatever the time
+    log.append(300, idFor(4));
+    QVERIFY(log.hasDeletedSince(cursor, NEVER));
+    entityIDs = deletedSince(log, cursor, NEVER);
+    QCOMPARE((int)entityIDs.size(), 1);
+    QCOMPARE(entityIDs[0], idFor(4));
+    QVERIFY(!log.hasDeletedSince(cursor, NEVER));
+
+    // and the ones since the time are sent again, even if the cursor is past them
+    entityIDs = deletedSince(log, cursor, 199);
+    QCOMPARE((int)entityIDs.size(), 4);
+}
+
+void DeletedEntityLogTests::testForget() {
+    const uint32_t NUM_DELETED = 5000;
+
+    DeletedEntityLog log;
+    for (uint32_t i = 0; i < NUM_DELETED; i++) {
+        log.append(i, idFor(i));
+    }
+
+    // a client that hasn't been sent everything keeps what it hasn't been sent around
+    DeletedEntityLog::Sequence cursor = 1000;
+    log.forgetDeletedBefore(3000, cursor);
+    QCOMPARE(log.size(), (size_t)(NUM_DELETED - 1000));
+    auto entityIDs = deletedSince(log, cursor, NEVER);
+    QCOMPARE((int)entityIDs.size(), (int)(NUM_DELETED - 1000));
+    QCOMPARE(entityIDs[0], idFor(1000));
+
+    log.forgetDeletedBefore(3000, cursor);
+    QCOMPARE(log.size(), (size_t)(NUM_DELETED - 3001));
+
+    // a cursor from before the forgotten entries only gets what is left
+    DeletedEntityLog::Sequence staleCursor = 0;
+    entityIDs = deletedSince(log, staleCursor, NEVER);
+    QCOMPARE(entityIDs[0], idFor(3001));
+
+    log.forgetDeletedBefore(NEVER);
+    QVERIFY(log.isEmpty());
+    log.append(NUM_DELETED, idFor(NUM_DELETED));
+    entityIDs = deletedSince(log, cursor, NEVER);
+    QCOMPARE((int)entityIDs.size(), 1);
+    QCOMPARE(entityIDs[0], idFor(NUM_DELETED));
+}
+
+void DeletedEntityLogTests::testConcurrentReaders() {
+    const uint32_t NUM_DELETED = 200000;
+    const int NUM_READERS = 4;
+
+    DeletedEntityLog log;
+    std::vector<std::atomic<DeletedEntityLog::Sequence>> cursors(NUM_READERS);
+    std::vector<int> readersInOrder(NUM_READERS, 1);
+    std::atomic<bool> done { false };
+
+    // each reader has to see every deleted entity once and in order, while the pruner forgets what all of them have seen
+    std::vector<std::thread> threads;
+    for (int r = 0; r < NUM_READERS; r++) {
+        cursors[r] = 0;
+        threads.emplace_back([&, r] {
+            DeletedEntityLog::Sequence cursor = 0;
+            uint32_t next = 0;
+            quint64 lastDeletedAt = 0;
+            while (next < NUM_DELETED) {
+                cursor = log.forEachDeletedSince(cursor, NEVER, [&](const DeletedEntityLog::Entry& deleted) {
+                    readersInOrder[r] = readersInOrder[r] && deleted.entityID == idFor(next) && deleted.deletedAt >= lastDeletedAt;
+                    lastDeletedAt = deleted.deletedAt;
+                    next++;
+                });
+                cursors[r] = cursor;
+            }
+        });
+    }
+    threads.emplace_back([&] {
+        while (!done) {
+            DeletedEntityLog::Sequence earliestCursor = DeletedEntityLog::NO_CURSOR;
+            for (auto& cursor : cursors) {
+                earliestCursor = std::min(earliestCursor, cursor.load());
+            }
+            log.forgetDeletedBefore(NEVER, earliestCursor);
+            std::this_thread::yield();
+        }
+    });
+
+    std::vector<QUuid> batch;
+    for (uint32_t i = 0; i < NUM_DELETED;) {
+        // deletions come one at a time or in batches, like they do from the tree
+        uint32_t batchSize = std::min((i % 7) * 3 + 1, NUM_DELETED - i);
+        if (batchSize == 1) {
+            log.append(i, idFor(i));
+        } else {
+            batch.clear();
+            for (uint32_t j = 0; j < batchSize; j++) {
+                batch.push_back(idFor(i + j));
+            }
+            log.append(i, batch);
+        }
+        i += batchSize;
+    }
+
+    for (int r = 0; r < NUM_READERS; r++) {
+        threads[r].join();
+    }
+    done = true;
+    threads.back().join();
+
+    for (int r = 0; r < NUM_READERS; r++) {
+        QVERIFY(readersInOrder[r]);
+    }
+    QCOMPARE(log.getEnd(), (DeletedEntityLog::Sequence)NUM_DELETED);
+}
+
+void DeletedEntityLogTests::benchmarkSendDeletes() {
+    const int NUM_DELETED = 100000;
+    const int NUM_CLIENTS = 200;
+    const int NUM_TICKS = 100;
+    const int TICKS_PER_PRUNE = 10;
+    const quint64 USECS_PER_TICK = 100 * USECS_PER_MSEC;
+    const quint64 EXTRA_USECS_TO_CONSIDER = 50 * USECS_PER_MSEC;
+
+    std::vector<QUuid> entityIDs;
+    for (int i = 0; i < NUM_DELETED; i++) {
+        entityIDs.push_back(QUuid::createUuid());
+    }
+
+    // every tick a batch of entities is deleted, every client is sent the ones deleted since it was last sent them
+    // and once a second the ones every client has been sent are forgotten
+    auto simulate = [&](bool useLog, quint64& numSent) {
+        QMultiMap<quint64, QUuid> recentlyDeleted;
+        DeletedEntityLog log;
+        std::vector<quint64> sentAt(NUM_CLIENTS, 0);
+        std::vector<DeletedEntityLog::Sequence> cursors(NUM_CLIENTS, DeletedEntityLog::NO_CURSOR);
+        numSent = 0;
+
+        quint64 start = usecTimestampNow();
+        int numDeleted = 0;
+        for (int tick = 0; tick < NUM_TICKS; tick++) {
+            quint64 tickTime = (tick + 1) * USECS_PER_TICK;
+            int numToDelete = NUM_DELETED / NUM_TICKS;
+            for (int i = 0; i < numToDelete; i++, numDeleted++) {
+                quint64 deletedAt = tickTime + i * USECS_PER_TICK / numToDelete;
+                if (useLog) {
+                    log.append(deletedAt, entityIDs[numDeleted]);
+                } else {
+                    recentlyDeleted.insert(deletedAt, entityIDs[numDeleted]);
+                }
+            }
+
+            quint64 now = tickTime + USECS_PER_TICK;
+            for (int c = 0; c < NUM_CLIENTS; c++) {
+                quint64 considerSince = sentAt[c] - std::min(sentAt[c], EXTRA_USECS_TO_CONSIDER);
+                if (useLog) {
+                    cursors[c] = log.forEachDeletedSince(cursors[c], considerSince, [&](const DeletedEntityLog::Entry& deleted) {
+                        numSent += deleted.entityID.isNull() ? 0 : 1;
+                    });
+                } else {
+                    // the way EntityServer::sendSpecialPackets used to do it
+                    const auto& deleted = recentlyDeleted;
+                    for (auto it = deleted.constBegin(); it != deleted.constEnd(); ++it) {
+                        if (it.key() > considerSince) {
+                            for (const auto& entityID : deleted.values(it.key())) {
+                                numSent += entityID.isNull() ? 0 : 1;
+                            }
+                        }
+                    }
+                }
+                sentAt[c] = now;
+            }
+
+            if (tick % TICKS_PER_PRUNE == TICKS_PER_PRUNE - 1) {
+                quint64 forgetBefore = now - EXTRA_USECS_TO_CONSIDER;
+                if (useLog) {
+                    log.forgetDeletedBefore(forgetBefore, *std::min_element(cursors.begin(), cursors.end()));
+                } else {
+                    for (auto it = recentlyDeleted.begin(); it != recentlyDeleted.end();) {
+                        it = it.key() <= forgetBefore ? recentlyDeleted.erase(it) : ++it;
+                    }
+                }
+            }
+        }
+        return usecTimestampNow() - start;
+    };
+
+    quint64 numSentByMap;
+    quint64 numSentByLog;
+    quint64 mapUsecs = simulate(false, numSentByMap);
+    quint64 logUsecs = simulate(true, numSentByLog);
+
+    qDebug() << NUM_DELETED << "deletions," << NUM_CLIENTS << "clients: multi map" << (float)mapUsecs / USECS_PER_MSEC
+        << "ms, log" << (float)logUsecs / USECS_PER_MSEC << "ms," << numSentByLog << "IDs sent";
+
+    // both send every deletion to every client, plus the ones in the extra window again
+    QCOMPARE(numSentByLog, numSentByMap);
+    QVERIFY(numSentByLog >= (quint64)NUM_DELETED * NUM_CLIENTS);
+    QVERIFY(logUsecs < mapUsecs);
+}
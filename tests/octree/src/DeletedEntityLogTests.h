@@ -0,0 +1,27 @@
+//
+//  DeletedEntityLogTests.h
+//  tests/octree/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_DeletedEntityLogTests_h
+#define hifi_DeletedEntityLogTests_h
+
+#include <QtTest/QtTest>
+
+class DeletedEntityLogTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testDeletedSince();
+    void testForget();
+    void testConcurrentReaders();
+    void benchmarkSendDeletes();
+};
+
+#endif // hifi_DeletedEntityLogTests_h
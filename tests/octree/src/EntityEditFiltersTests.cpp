@@ -0,0 +1,202 @@
+//
+//  EntityEditFiltersTests.cpp
+//  tests/octree/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityEditFiltersTests.h"
+
+#include <EntityEditFilters.h>
+#include <SharedUtil.h>
+#include <shared/ScriptInitializerMixin.h>
+
+QTEST_MAIN(EntityEditFiltersTests)
+
+namespace {
+
+// rejects names containing "bad", and tags everything else it sees with a description
+const QString TAGGING_FILTER =
+    "function filter(properties, type) {\n"
+    "    if (properties.name !== undefined && properties.name.indexOf('bad') !== -1) {\n"
+    "        return false;\n"
+    "    }\n"
+    "    properties.description = 'seen';\n"
+    "    return properties;\n"
+    "}\n";
+
+// the same filter run entirely in JavaScript, and with the checks that don't need it declared natively
+const QString TYPICAL_FILTER =
+    "function filter(properties, type) {\n"
+    "    var d = properties.dimensions;\n"
+    "    if (d !== undefined && (d.x > 10 || d.y > 10 || d.z > 10)) {\n"
+    "        return false;\n"
+    "    }\n"
+    "    var v = properties.velocity;\n"
+    "    if (v !== undefined && (Math.abs(v.x) > 20 || Math.abs(v.y) > 20 || Math.abs(v.z) > 20)) {\n"
+    "        return false;\n"
+    "    }\n"
+    "    if (properties.name !== undefined && properties.name.indexOf('bad') !== -1) {\n"
+    "        return false;\n"
+    "    }\n"
+    "    return properties;\n"
+    "}\n";
+const QString TYPICAL_FILTER_DECLARATIONS =
+    "filter.wantsProperties = ['name'];\n"
+    "filter.propertyRanges = { dimensions: { max: 10 }, velocity: { min: -20, max: 20 } };\n";
+
+bool runFilter(EntityEditFilters& filters, EntityItemProperties& properties, bool& wasChanged,
+               EntityItemID entityID = EntityItemID(QUuid::createUuid())) {
+    glm::vec3 position = properties.getPosition();
+    wasChanged = false;
+    return filters.filter(position, properties, properties, wasChanged, EntityTree::FilterType::Edit, entityID, nullptr);
+}
+
+}
+
+void EntityEditFiltersTests::initTestCase() {
+    DependencyManager::set<ScriptInitializers>();
+}
+
+void EntityEditFiltersTests::testPropertyMask() {
+    EntityEditFilters filters;
+    QVERIFY(filters.setFilterScript(EntityItemID(), TAGGING_FILTER + "filter.wantsProperties = ['name'];", "mask.js"));
+    bool wasChanged;
+
+    // the script doesn't want to see edits that don't touch the name
+    EntityItemProperties moved;
+    moved.setPosition(glm::vec3(1.0f, 2.0f, 3.0f));
+    moved.setVelocity(glm::vec3(0.0f, 1.0f, 0.0f));
+    QVERIFY(runFilter(filters, moved, wasChanged));
+    QVERIFY(!wasChanged);
+    QVERIFY(!moved.descriptionChanged());
+
+    EntityItemProperties renamed;
+    renamed.setPosition(glm::vec3(1.0f, 2.0f, 3.0f));
+    renamed.setName("good");
+    QVERIFY(runFilter(filters, renamed, wasChanged));
+    QVERIFY(wasChanged);
+    QCOMPARE(renamed.getDescription(), QString("seen"));
+    QCOMPARE(renamed.getPosition(), glm::vec3(1.0f, 2.0f, 3.0f));
+
+    EntityItemProperties badlyRenamed;
+    badlyRenamed.setName("bad");
+    QVERIFY(!runFilter(filters, badlyRenamed, wasChanged));
+
+    filters.removeFilter(EntityItemID());
+}
+
+void EntityEditFiltersTests::testPropertyRanges() {
+    EntityEditFilters filters;
+    QVERIFY(filters.setFilterScript(EntityItemID(), TAGGING_FILTER +
+        "filter.wantsProperties = [];\n"
+        "filter.propertyRanges = { lifetime: { min: 0, max: 300, clamp: true }, dimensions: { min: 0.01, max: 10 } };\n",
+        "ranges.js"));
+    bool wasChanged;
+
+    EntityItemProperties inRange;
+    inRange.setLifetime(60.0f);
+    inRange.setDimensions(glm::vec3(1.0f, 2.0f, 3.0f));
+    QVERIFY(runFilter(filters, inRange, wasChanged));
+    QVERIFY(!wasChanged);
+    QVERIFY(!inRange.descriptionChanged());
+
+    EntityItemProperties tooLong;
+    tooLong.setLifetime(1000.0f);
+    QVERIFY(runFilter(filters, tooLong, wasChanged));
+    QVERIFY(wasChanged);
+    QCOMPARE(tooLong.getLifetime(), 300.0f);
+
+    EntityItemProperties tooBig;
+    tooBig.setDimensions(glm::vec3(1.0f, 20.0f, 1.0f));
+    QVERIFY(!runFilter(filters, tooBig, wasChanged));
+
+    EntityItemProperties notANumber;
+    notANumber.setDimensions(glm::vec3(1.0f, std::numeric_limits<float>::quiet_NaN(), 1.0f));
+    QVERIFY(!runFilter(filters, notANumber, wasChanged));
+
+    filters.removeFilter(EntityItemID());
+}
+
+void EntityEditFiltersTests::testRateLimit() {
+    EntityEditFilters filters;
+    QVERIFY(filters.setFilterScript(EntityItemID(), TAGGING_FILTER +
+        "filter.wantsProperties = [];\n"
+        "filter.maxEditsPerSecond = 5;\n",
+        "rate.js"));
+    bool wasChanged;
+
+    EntityItemID busyEntity(QUuid::createUuid());
+    EntityItemProperties properties;
+    properties.setPosition(glm::vec3(1.0f));
+    for (int i = 0; i < 5; i++) {
+        QVERIFY(runFilter(filters, properties, wasChanged, busyEntity));
+    }
+    QVERIFY(!runFilter(filters, properties, wasChanged, busyEntity));
+
+    // other entities have their own budget
+    QVERIFY(runFilter(filters, properties, wasChanged));
+
+    // and the budget comes back with time
+    QTest::qWait(250);
+    QVERIFY(runFilter(filters, properties, wasChanged, busyEntity));
+
+    filters.removeFilter(EntityItemID());
+}
+
+void EntityEditFiltersTests::benchmarkEdits() {
+    const int NUM_EDITS = 20000;
+    const int RENAME_EVERY = 10;
+    const int OVERSIZE_EVERY = 50;
+
+    // mostly moving things around, now and again a rename or an oversized entity
+    std::vector<EntityItemProperties> edits;
+    edits.reserve(NUM_EDITS);
+    for (int i = 0; i < NUM_EDITS; i++) {
+        EntityItemProperties properties;
+        properties.setPosition(glm::vec3((float)i, 1.0f, 2.0f));
+        properties.setRotation(glm::quat());
+        properties.setVelocity(glm::vec3(0.0f, (float)(i % 30), 0.0f));
+        properties.setLastEdited(usecTimestampNow());
+        if (i % RENAME_EVERY == 0) {
+            properties.setName(i % (2 * RENAME_EVERY) == 0 ? "bad" : "good");
+        }
+        if (i % OVERSIZE_EVERY == 0) {
+            properties.setDimensions(glm::vec3(11.0f));
+        }
+        edits.push_back(properties);
+    }
+
+    auto run = [&](const QString& script, int& numAccepted) {
+        EntityEditFilters filters;
+        if (!filters.setFilterScript(EntityItemID(), script, "typical.js")) {
+            return 0.0f;
+        }
+        EntityItemID entityID(QUuid::createUuid());
+        numAccepted = 0;
+        quint64 start = usecTimestampNow();
+        for (const auto& edit : edits) {
+            EntityItemProperties properties = edit;
+            bool wasChanged;
+            if (runFilter(filters, properties, wasChanged, entityID)) {
+                numAccepted++;
+            }
+        }
+        float seconds = (float)(usecTimestampNow() - start) / USECS_PER_SECOND;
+        filters.removeFilter(EntityItemID());
+        return seconds > 0.0f ? NUM_EDITS / seconds : 0.0f;
+    };
+
+    int scriptAccepted = 0;
+    int declarativeAccepted = 0;
+    float scriptRate = run(TYPICAL_FILTER, scriptAccepted);
+    float declarativeRate = run(TYPICAL_FILTER + TYPICAL_FILTER_DECLARATIONS, declarativeAccepted);
+    qDebug() << "typical filter, script only:" << scriptRate << "edits/s, with declarations:" << declarativeRate << "edits/s";
+
+    QCOMPARE(declarativeAccepted, scriptAccepted);
+    QVERIFY(declarativeRate > scriptRate);
+}
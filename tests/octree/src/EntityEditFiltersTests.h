@@ -0,0 +1,28 @@
+//
+//  EntityEditFiltersTests.h
+//  tests/octree/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityEditFiltersTests_h
+#define hifi_EntityEditFiltersTests_h
+
+#include <QtTest/QtTest>
+
+class EntityEditFiltersTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void testPropertyMask();
+    void testPropertyRanges();
+    void testRateLimit();
+    void benchmarkEdits();
+};
+
+#endif // hifi_EntityEditFiltersTests_h
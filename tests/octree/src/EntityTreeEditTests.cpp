@@ -0,0 +1,104 @@
+//
+//  EntityTreeEditTests.cpp
+//  tests/octree/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityTreeEditTests.h"
+
+#include <atomic>
+#include <thread>
+
+#include <EntityItemProperties.h>
+#include <EntityTree.h>
+#include <EntityTreeElement.h>
+#include <Node.h>
+#include <OctreeConstants.h>
+#include <ReceivedMessage.h>
+#include <SharedUtil.h>
+#include <udt/PacketHeaders.h>
+
+QTEST_MAIN(EntityTreeEditTests)
+
+void EntityTreeEditTests::testEditsWhileEncoding() {
+    const int NUM_EDITS = 2000;
+
+    EntityTreePointer tree = std::make_shared<EntityTree>();
+    tree->setIsServer(true);
+
+    EntityItemID entityID(QUuid::createUuid());
+    EntityItemProperties properties;
+    properties.setType(EntityTypes::Box);
+    properties.setPosition(glm::vec3(TREE_SCALE * 0.5f));
+    EntityItemPointer entity;
+    tree->withWriteLock([&] {
+        entity = tree->addEntity(entityID, properties);
+    });
+    QVERIFY(entity);
+
+    NodePermissions permissions;
+    permissions.set(NodePermissions::Permission::canRezPermanentEntities);
+    SharedNodePointer sender(new Node(QUuid::createUuid(), NodeType::Agent, HifiSockAddr(), HifiSockAddr()));
+    sender->setPermissions(permissions);
+
+    // stands in for a send thread: with the tree locked for reading, it encodes the entity whenever its element has
+    // changed since the last pass started
+    std::atomic<bool> editsDone { false };
+    QString lastEncodedName;
+    int numEncodes = 0;
+    std::thread encoder([&] {
+        quint64 lastPassStart = 0;
+        while (true) {
+            bool isLastPass = editsDone;
+            tree->withReadLock([&] {
+                quint64 passStart = usecTimestampNow();
+                auto element = entity->getElement();
+                if (element && element->hasChangedSince(lastPassStart)) {
+                    lastEncodedName = entity->getName();
+                    numEncodes++;
+                }
+                lastPassStart = passStart;
+            });
+            if (isLastPass) {
+                break;
+            }
+        }
+    });
+
+    // renames go in place, with the tree only locked for reading
+    QString lastName;
+    for (int i = 0; i < NUM_EDITS; i++) {
+        EntityItemProperties edit;
+        lastName = QString("edit %1").arg(i);
+        edit.setName(lastName);
+        edit.setLastEdited(usecTimestampNow());
+
+        QByteArray buffer(NLPacket::maxPayloadSize(PacketType::EntityEdit), 0);
+        EntityPropertyFlags didntFit;
+        EntityItemProperties::encodeEntityEditPacket(PacketType::EntityEdit, entityID, edit, buffer,
+                                                     edit.getChangedProperties(), didntFit);
+        EntityItemProperties::compressEntityEditMessage(buffer, OctreeCompressionDictionaryPointer());
+        ReceivedMessage message(buffer, PacketType::EntityEdit, versionForPacketType(PacketType::EntityEdit), HifiSockAddr());
+
+        quint64 editStart = usecTimestampNow();
+        Octree::EditLockTimes lockTimes;
+        tree->lockAndProcessEditPacketData(message, reinterpret_cast<const unsigned char*>(buffer.constData()),
+                                           buffer.size(), sender, lockTimes);
+
+        // the element is marked changed by the time the edit has been taken in
+        QVERIFY(entity->getElement()->getLastChanged() >= editStart);
+    }
+    editsDone = true;
+    encoder.join();
+
+    qDebug() << NUM_EDITS << "edits," << numEncodes << "encodes alongside them";
+
+    // every edit was applied, and the encoder's last pass saw the last of them
+    QCOMPARE(entity->getName(), lastName);
+    QCOMPARE(lastEncodedName, lastName);
+}
@@ -0,0 +1,306 @@
+//
+//  OctreeCompressionDictionaryTests.cpp
+//  tests/octree/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeCompressionDictionaryTests.h"
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtScript/QScriptEngine>
+
+#include <EntityItemProperties.h>
+#include <NLPacket.h>
+#include <OctreeCompressionDictionary.h>
+#include <OctreePacketData.h>
+#include <SharedUtil.h>
+
+QTEST_MAIN(OctreeCompressionDictionaryTests)
+
+namespace {
+
+const int MAX_COMPRESSION = 9;
+
+// something like what a domain is made of, a handful of models with the same sort of user data
+QByteArray entityLike(int index) {
+    return QString("{\"type\":\"Model\",\"name\":\"Tree %1\",\"modelURL\":\"https://content.example.com/forest/v1/tree%2.fst\","
+                   "\"userData\":\"{\\\"grabbableKey\\\":{\\\"grabbable\\\":false},\\\"variant\\\":%3}\"}")
+        .arg(index).arg(index % 5).arg(index % 7).toUtf8();
+}
+
+std::vector<QByteArray> entitiesLike(int first, int count) {
+    std::vector<QByteArray> entities;
+    for (int i = first; i < first + count; i++) {
+        entities.push_back(entityLike(i));
+    }
+    return entities;
+}
+
+QByteArray uncompress(const QByteArray& compressed) {
+    return OctreeCompressionDictionary::uncompress((const unsigned char*)compressed.constData(), compressed.size());
+}
+
+// an edit giving an entity the sort of name, script and user data the others have, encoded the way it is sent
+QByteArray encodeEdit(const EntityItemID& entityID, int index) {
+    EntityItemProperties properties;
+    properties.setName(QString("Tree %1").arg(index));
+    properties.setScript(QString("https://content.example.com/forest/v1/sway%1.js").arg(index % 3));
+    properties.setUserData(QString("{\"grabbableKey\":{\"grabbable\":false},\"variant\":%1}").arg(index % 7));
+
+    QByteArray buffer(NLPacket::maxPayloadSize(PacketType::EntityEdit), 0);
+    EntityPropertyFlags didntFit;
+    EntityItemProperties::encodeEntityEditPacket(PacketType::EntityEdit, entityID, properties, buffer,
+                                                 properties.getChangedProperties(), didntFit);
+    return buffer;
+}
+
+// the entities in the serverless tutorial domain, encoded the way they are sent
+std::vector<QByteArray> encodeDomainSnapshot() {
+    QFile file(QFileInfo(__FILE__).absolutePath() + "/../../../interface/resources/serverless/tutorial.json");
+    if (!file.open(QIODevice::ReadOnly)) {
+        return std::vector<QByteArray>();
+    }
+
+    QScriptEngine scriptEngine;
+    std::vector<QByteArray> encodedEntities;
+    auto entities = QJsonDocument::fromJson(file.readAll()).object()["Entities"].toArray();
+    for (const auto& entity : entities) {
+        EntityItemProperties properties;
+        properties.copyFromJSONString(scriptEngine, QJsonDocument(entity.toObject()).toJson(QJsonDocument::Compact));
+
+        QByteArray buffer(NLPacket::maxPayloadSize(PacketType::EntityAdd), 0);
+        EntityPropertyFlags didntFit;
+        auto result = EntityItemProperties::encodeEntityEditPacket(PacketType::EntityAdd,
+            EntityItemID(QUuid(entity.toObject()["id"].toString())), properties, buffer, properties.getChangedProperties(), didntFit);
+        if (result != OctreeElement::NONE) {
+            encodedEntities.push_back(buffer);
+        }
+    }
+    return encodedEntities;
+}
+
+// packs entities into sections the way OctreeSendThread fills an EntityData packet
+std::vector<QByteArray> packSections(const std::vector<QByteArray>& entities) {
+    std::vector<QByteArray> sections(1);
+    for (const auto& entity : entities) {
+        if (!sections.back().isEmpty() && sections.back().size() + entity.size() > MAX_OCTREE_PACKET_DATA_SIZE) {
+            sections.emplace_back();
+        }
+        sections.back().append(entity);
+    }
+    return sections;
+}
+
+struct CompressionResult {
+    int bytesIn { 0 };
+    int bytesOut { 0 };
+    float compressUsecs { 0.0f };
+    float uncompressUsecs { 0.0f };
+    bool roundTrips { true };
+};
+
+CompressionResult measure(const std::vector<QByteArray>& messages, const OctreeCompressionDictionaryPointer& dictionary) {
+    const int NUM_ITERATIONS = 20;
+
+    CompressionResult result;
+    std::vector<QByteArray> compressed(messages.size());
+    quint64 start = usecTimestampNow();
+    for (int i = 0; i < NUM_ITERATIONS; i++) {
+        for (size_t j = 0; j < messages.size(); j++) {
+            auto data = (const unsigned char*)messages[j].constData();
+            compressed[j] = dictionary ? dictionary->compress(data, messages[j].size(), MAX_COMPRESSION) :
+                qCompress(data, messages[j].size(), MAX_COMPRESSION);
+        }
+    }
+    result.compressUsecs = (float)(usecTimestampNow() - start) / (NUM_ITERATIONS * messages.size());
+
+    start = usecTimestampNow();
+    for (int i = 0; i < NUM_ITERATIONS; i++) {
+        for (size_t j = 0; j < messages.size(); j++) {
+            result.roundTrips &= uncompress(compressed[j]) == messages[j];
+        }
+    }
+    result.uncompressUsecs = (float)(usecTimestampNow() - start) / (NUM_ITERATIONS * messages.size());
+
+    for (size_t j = 0; j < messages.size(); j++) {
+        result.bytesIn += messages[j].size();
+        result.bytesOut += compressed[j].size();
+    }
+    return result;
+}
+
+}
+
+void OctreeCompressionDictionaryTests::testRoundTrip() {
+    auto data = OctreeCompressionDictionary::train(entitiesLike(0, 200));
+    QVERIFY(!data.isEmpty());
+    QVERIFY(data.size() <= OctreeCompressionDictionary::DEFAULT_MAX_SIZE);
+    auto dictionary = std::make_shared<const OctreeCompressionDictionary>(data);
+    OctreeCompressionDictionary::add(dictionary);
+    QCOMPARE(OctreeCompressionDictionary::find(dictionary->getID()), dictionary);
+
+    // entities the dictionary wasn't trained on come out smaller than they do without it
+    QByteArray content = entityLike(1000);
+    QByteArray plain = qCompress(content, MAX_COMPRESSION);
+    QByteArray withDictionary = dictionary->compress((const unsigned char*)content.constData(), content.size(), MAX_COMPRESSION);
+    QVERIFY(withDictionary.size() < plain.size());
+    QCOMPARE(uncompress(withDictionary), content);
+
+    // plain qCompress data still goes through
+    QCOMPARE(uncompress(plain), content);
+
+    // a limited dictionary is limited
+    auto small = OctreeCompressionDictionary::train(entitiesLike(0, 200), 100);
+    QVERIFY(!small.isEmpty());
+    QVERIFY(small.size() <= 100);
+
+    // nothing shared, nothing to train
+    std::vector<QByteArray> unrelated { QByteArray("abcdefghijklmnop"), QByteArray("qrstuvwxyz012345") };
+    QVERIFY(OctreeCompressionDictionary::train(unrelated).isEmpty());
+}
+
+void OctreeCompressionDictionaryTests::testUnknownDictionary() {
+    OctreeCompressionDictionary unregistered(OctreeCompressionDictionary::train(entitiesLike(5000, 50)) + "unregistered");
+    QVERIFY(!OctreeCompressionDictionary::find(unregistered.getID()));
+
+    QByteArray content = entityLike(1);
+    QByteArray compressed = unregistered.compress((const unsigned char*)content.constData(), content.size(), MAX_COMPRESSION);
+    QVERIFY(!compressed.isEmpty());
+    QVERIFY(uncompress(compressed).isEmpty());
+
+    // nor does anything else that isn't what it claims to be
+    QVERIFY(uncompress(QByteArray()).isEmpty());
+    QVERIFY(uncompress(compressed.left(compressed.size() / 2)).isEmpty());
+    QByteArray wrongSize = qCompress(content);
+    wrongSize[3] = wrongSize[3] + 1;
+    QVERIFY(uncompress(wrongSize).isEmpty());
+}
+
+void OctreeCompressionDictionaryTests::testPacketData() {
+    auto dictionary = std::make_shared<const OctreeCompressionDictionary>(OctreeCompressionDictionary::train(entitiesLike(0, 200)));
+    OctreeCompressionDictionary::add(dictionary);
+
+    QByteArray content;
+    for (const auto& entity : entitiesLike(300, 8)) {
+        content.append(entity);
+    }
+
+    // the dictionary stays across changes of settings
+    OctreePacketData sent;
+    sent.setCompressionDictionary(dictionary);
+    sent.changeSettings(true, MAX_OCTREE_PACKET_DATA_SIZE);
+    QCOMPARE(sent.getCompressionDictionary(), OctreeCompressionDictionaryPointer(dictionary));
+    QVERIFY(sent.appendRawData((const unsigned char*)content.constData(), content.size()));
+    int compressedSize = sent.getFinalizedSize();
+
+    OctreePacketData plain(true);
+    QVERIFY(plain.appendRawData((const unsigned char*)content.constData(), content.size()));
+    QVERIFY(compressedSize < plain.getFinalizedSize());
+
+    OctreePacketData received(true);
+    received.loadFinalizedContent(sent.getFinalizedData(), compressedSize);
+    QCOMPARE(QByteArray((const char*)received.getUncompressedData(), received.getUncompressedSize()), content);
+}
+
+void OctreeCompressionDictionaryTests::testEntityEdits() {
+    std::vector<QByteArray> edits;
+    for (int i = 0; i < 200; i++) {
+        edits.push_back(encodeEdit(EntityItemID(QUuid::createUuid()), i));
+    }
+    QByteArray data = OctreeCompressionDictionary::train(edits);
+    auto dictionary = std::make_shared<const OctreeCompressionDictionary>(data);
+    OctreeCompressionDictionary::add(dictionary);
+    auto unregistered = std::make_shared<const OctreeCompressionDictionary>(data + "unregistered");
+
+    EntityItemID entityID(QUuid::createUuid());
+    QByteArray edit = encodeEdit(entityID, 1000);
+
+    QByteArray plain = edit;
+    EntityItemProperties::compressEntityEditMessage(plain, OctreeCompressionDictionaryPointer());
+    QCOMPARE(plain.size(), edit.size() + (int)sizeof(quint16));
+
+    QByteArray compressed = edit;
+    EntityItemProperties::compressEntityEditMessage(compressed, dictionary);
+    QVERIFY(compressed.size() < plain.size());
+
+    QByteArray unknown = edit;
+    EntityItemProperties::compressEntityEditMessage(unknown, unregistered);
+    QVERIFY(unknown.size() < plain.size());
+
+    // edits share packets, so one the server can't uncompress is skipped over and the rest still go through
+    QByteArray packet = compressed + unknown + plain;
+    auto decode = [&](int& offset, EntityItemID& decodedID, EntityItemProperties& properties) {
+        int processedBytes = 0;
+        bool valid = EntityItemProperties::decodeCompressedEntityEditPacket(
+            (const unsigned char*)packet.constData() + offset, packet.size() - offset, processedBytes, decodedID, properties);
+        offset += processedBytes;
+        return valid;
+    };
+
+    int offset = 0;
+    EntityItemID decodedID;
+    EntityItemProperties properties;
+    QVERIFY(decode(offset, decodedID, properties));
+    QCOMPARE(offset, compressed.size());
+    QCOMPARE(decodedID, entityID);
+    QCOMPARE(properties.getName(), QString("Tree 1000"));
+    QCOMPARE(properties.getScript(), QString("https://content.example.com/forest/v1/sway1.js"));
+
+    QVERIFY(!decode(offset, decodedID, properties));
+    QCOMPARE(offset, compressed.size() + unknown.size());
+
+    EntityItemProperties plainProperties;
+    QVERIFY(decode(offset, decodedID, plainProperties));
+    QCOMPARE(offset, packet.size());
+    QCOMPARE(decodedID, entityID);
+    QCOMPARE(plainProperties.getUserData(), properties.getUserData());
+}
+
+void OctreeCompressionDictionaryTests::benchmarkDomainSnapshot() {
+    auto entities = encodeDomainSnapshot();
+    if (entities.empty()) {
+        QSKIP("no domain snapshot to benchmark with");
+    }
+
+    // train on half the domain and measure on the other half, so a dictionary that just memorized its samples
+    // doesn't look better than it is
+    std::vector<QByteArray> trainingEntities;
+    std::vector<QByteArray> otherEntities;
+    for (size_t i = 0; i < entities.size(); i++) {
+        (i % 2 == 0 ? trainingEntities : otherEntities).push_back(entities[i]);
+    }
+
+    quint64 start = usecTimestampNow();
+    auto dictionary = std::make_shared<const OctreeCompressionDictionary>(OctreeCompressionDictionary::train(trainingEntities));
+    float trainingMsecs = (float)(usecTimestampNow() - start) / USECS_PER_MSEC;
+    OctreeCompressionDictionary::add(dictionary);
+    qDebug() << "trained a" << dictionary->getData().size() << "byte dictionary on" << trainingEntities.size()
+        << "entities in" << trainingMsecs << "ms";
+
+    auto report = [&](const char* packetType, const std::vector<QByteArray>& messages) {
+        auto plain = measure(messages, nullptr);
+        auto withDictionary = measure(messages, dictionary);
+        auto line = [&](const char* name, const CompressionResult& result) {
+            qDebug() << packetType << name << messages.size() << "messages," << "ratio"
+                << (float)result.bytesIn / result.bytesOut << "compress" << result.compressUsecs << "us/message"
+                << "uncompress" << result.uncompressUsecs << "us/message";
+        };
+        line("zlib:", plain);
+        line("zlib with dictionary:", withDictionary);
+
+        QVERIFY(plain.roundTrips);
+        QVERIFY(withDictionary.roundTrips);
+        QVERIFY(withDictionary.bytesOut < plain.bytesOut);
+    };
+
+    // EntityData packs entities into sections, edits go one entity at a time
+    report("EntityData", packSections(otherEntities));
+    report("EntityEdit", otherEntities);
+}
@@ -0,0 +1,28 @@
+//
+//  OctreeCompressionDictionaryTests.h
+//  tests/octree/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreeCompressionDictionaryTests_h
+#define hifi_OctreeCompressionDictionaryTests_h
+
+#include <QtTest/QtTest>
+
+class OctreeCompressionDictionaryTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testRoundTrip();
+    void testUnknownDictionary();
+    void testPacketData();
+    void testEntityEdits();
+    void benchmarkDomainSnapshot();
+};
+
+#endif // hifi_OctreeCompressionDictionaryTests_h
@@ -0,0 +1,369 @@
+//
+//  PolyVoxBricksTests.cpp
+//  tests/octree/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PolyVoxBricksTests.h"
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include <QtCore/QDataStream>
+
+#include <PolyVoxBricks.h>
+#include <SharedUtil.h>
+
+QTEST_MAIN(PolyVoxBricksTests)
+
+namespace {
+
+int voxelIndex(const glm::ivec3& size, int x, int y, int z) {
+    return (z * size.y + y) * size.x + x;
+}
+
+// rolling ground up to about half way, with a little noise, which is the sort of thing people build
+QByteArray makeTerrain(const glm::ivec3& size) {
+    QByteArray voxels(size.x * size.y * size.z, '\0');
+    for (int z = 0; z < size.z; z++) {
+        for (int x = 0; x < size.x; x++) {
+            int height = size.y / 2 + (int)(4.0f * sinf(x * 0.2f) * cosf(z * 0.15f));
+            for (int y = 0; y < height; y++) {
+                voxels[voxelIndex(size, x, y, z)] = (char)(y < height - 3 ? 1 : 1 + (x * 7 + z * 3) % 3);
+            }
+        }
+    }
+    return voxels;
+}
+
+void setSphere(QByteArray& voxels, const glm::ivec3& size, const glm::ivec3& center, int radius, uint8_t value) {
+    glm::ivec3 low = glm::max(center - radius, glm::ivec3(0));
+    glm::ivec3 high = glm::min(center + radius + 1, size);
+    for (int z = low.z; z < high.z; z++) {
+        for (int y = low.y; y < high.y; y++) {
+            for (int x = low.x; x < high.x; x++) {
+                glm::ivec3 offset = glm::ivec3(x, y, z) - center;
+                if (glm::dot(offset, offset) <= radius * radius) {
+                    voxels[voxelIndex(size, x, y, z)] = (char)value;
+                }
+            }
+        }
+    }
+}
+
+// the voxel data the way it was before bricks
+QByteArray makeLegacyVoxelData(const QByteArray& voxels, const glm::ivec3& size) {
+    QByteArray voxelData;
+    QDataStream writer(&voxelData, QIODevice::WriteOnly | QIODevice::Truncate);
+    writer << (quint16)size.x << (quint16)size.y << (quint16)size.z;
+    writer << qCompress(voxels, 9);
+    return voxelData;
+}
+
+QByteArray getBrickVoxels(const QByteArray& voxels, const PolyVoxBricks& bricks, int index) {
+    const glm::ivec3& size = bricks.getVoxelVolumeSize();
+    glm::ivec3 position = bricks.getBrickPosition(index);
+    glm::ivec3 brickSize = bricks.getBrickSize(index);
+    QByteArray brickVoxels;
+    for (int z = position.z; z < position.z + brickSize.z; z++) {
+        for (int y = position.y; y < position.y + brickSize.y; y++) {
+            brickVoxels.append(voxels.constData() + voxelIndex(size, position.x, y, z), brickSize.x);
+        }
+    }
+    return brickVoxels;
+}
+
+void setBricks(PolyVoxBricks& bricks, const QByteArray& voxels) {
+    for (int i = 0; i < bricks.getNumBricksTotal(); i++) {
+        bricks.setVoxels(i, getBrickVoxels(voxels, bricks, i));
+    }
+}
+
+void verifyVoxels(const PolyVoxBricks& bricks, const QByteArray& voxels) {
+    for (int i = 0; i < bricks.getNumBricksTotal(); i++) {
+        QCOMPARE(bricks.getVoxels(i), getBrickVoxels(voxels, bricks, i));
+    }
+}
+
+}
+
+void PolyVoxBricksTests::testRoundTrip() {
+    // not a multiple of the brick size, so the bricks at the high edges are cut short
+    glm::ivec3 size(40, 33, 17);
+    QByteArray voxels = makeTerrain(size);
+
+    PolyVoxBricks bricks(size);
+    QVERIFY(bricks.getNumBricks() == glm::ivec3(3, 3, 2));
+    QVERIFY(bricks.getBrickSize(bricks.getNumBricksTotal() - 1) == glm::ivec3(8, 1, 1));
+    setBricks(bricks, voxels);
+
+    PolyVoxBricks other;
+    QVERIFY(other.read(bricks.write()));
+    QVERIFY(other.getVoxelVolumeSize() == size);
+    QCOMPARE(other.getNumDirty(), 0);
+    verifyVoxels(other, voxels);
+    QCOMPARE(other.write(), bricks.write());
+
+    // the empty bricks above the ground go in a single entry
+    PolyVoxBricks empty(size);
+    QVERIFY(empty.write().size() < 24);
+
+    // a patch isn't whole voxel data
+    QVERIFY(!other.read(bricks.writePatch()));
+    QVERIFY(!other.read(QByteArray()));
+}
+
+void PolyVoxBricksTests::testLegacyVoxelData() {
+    glm::ivec3 size(24, 20, 36);
+    QByteArray voxels = makeTerrain(size);
+    setSphere(voxels, size, glm::ivec3(12, 10, 18), 6, 2);
+
+    PolyVoxBricks bricks;
+    QVERIFY(bricks.read(makeLegacyVoxelData(voxels, size)));
+    QVERIFY(bricks.getVoxelVolumeSize() == size);
+    verifyVoxels(bricks, voxels);
+    QVERIFY(!PolyVoxBricks::isPatch(makeLegacyVoxelData(voxels, size)));
+
+    // the uncompressed size has to match the dimensions
+    QVERIFY(!bricks.read(makeLegacyVoxelData(voxels.left(voxels.size() - 1), size)));
+    QVERIFY(!bricks.read(makeLegacyVoxelData(QByteArray(129 * 2 * 2, '\0'), glm::ivec3(129, 2, 2))));
+}
+
+void PolyVoxBricksTests::testPatch() {
+    glm::ivec3 size(64, 64, 64);
+    QByteArray voxels = makeTerrain(size);
+    QByteArray legacyVoxelData = makeLegacyVoxelData(voxels, size);
+
+    PolyVoxBricks bricks;
+    QVERIFY(bricks.read(legacyVoxelData));
+    QByteArray voxelData = bricks.write();
+
+    // an edit on the surface touches a few bricks
+    setSphere(voxels, size, glm::ivec3(20, 32, 20), 3, 0);
+    setBricks(bricks, voxels);
+    QVERIFY(bricks.getNumDirty() > 0);
+    QVERIFY(bricks.getNumDirty() <= 8);
+
+    QByteArray patch = bricks.writePatch();
+    QVERIFY(PolyVoxBricks::isPatch(patch));
+    QVERIFY(!PolyVoxBricks::isPatch(voxelData));
+    QVERIFY(patch.size() < voxelData.size());
+
+    // the entity-server may still have either format
+    PolyVoxBricks server;
+    QVERIFY(server.read(voxelData));
+    QVERIFY(server.applyEdit(patch));
+    verifyVoxels(server, voxels);
+    PolyVoxBricks legacyServer;
+    QVERIFY(legacyServer.read(legacyVoxelData));
+    QVERIFY(legacyServer.applyEdit(patch));
+    verifyVoxels(legacyServer, voxels);
+
+    // a patch for another size of volume starts it over at that size
+    PolyVoxBricks otherSize(glm::ivec3(64, 64, 32));
+    QVERIFY(otherSize.applyEdit(patch));
+    QVERIFY(otherSize.getVoxelVolumeSize() == size);
+    for (int i = 0; i < otherSize.getNumBricksTotal(); i++) {
+        QVERIFY(otherSize.getBrick(i) == (bricks.isDirty(i) ? bricks.getBrick(i) : PolyVoxBricks::Brick()));
+    }
+
+    // edits to other bricks from two clients both land
+    PolyVoxBricks first;
+    PolyVoxBricks second;
+    QVERIFY(first.read(voxelData));
+    QVERIFY(second.read(voxelData));
+    QByteArray firstVoxels = first.getVoxels(0);
+    firstVoxels[0] = 3;
+    first.setVoxels(0, firstVoxels);
+    int lastBrick = second.getNumBricksTotal() - 1;
+    second.setVoxels(lastBrick, QByteArray(second.getBrickSize(lastBrick).x * second.getBrickSize(lastBrick).y *
+                                           second.getBrickSize(lastBrick).z, 2));
+    PolyVoxBricks merged;
+    QVERIFY(merged.read(voxelData));
+    QVERIFY(merged.applyEdit(first.writePatch()));
+    QVERIFY(merged.applyEdit(second.writePatch()));
+    QVERIFY(merged.getBrick(0) == first.getBrick(0));
+    QVERIFY(merged.getBrick(lastBrick) == second.getBrick(lastBrick));
+}
+
+void PolyVoxBricksTests::testVersions() {
+    glm::ivec3 size(48, 32, 48);
+    QByteArray voxels = makeTerrain(size);
+    PolyVoxBricks server(size);
+    setBricks(server, voxels);
+    server.clearDirty();
+    QCOMPARE(server.getLatestVersion(), (quint32)0);
+    QByteArray original = server.write();
+
+    // the entity-server sends a client everything to start with
+    PolyVoxBricks client;
+    quint64 cursor = 0;
+    while (server.hasBricksAfter(cursor)) {
+        QByteArray patch = server.writePatchAfter(cursor, PolyVoxBricks::MAX_PATCH_SIZE);
+        QVERIFY(!patch.isEmpty());
+        QVERIFY(client.merge(patch));
+    }
+    verifyVoxels(client, voxels);
+
+    // an edit gives only the bricks it changes a new version
+    PolyVoxBricks editor;
+    QVERIFY(editor.read(original));
+    setSphere(voxels, size, glm::ivec3(8, 16, 8), 3, 0);
+    setBricks(editor, voxels);
+    int numEdited = editor.getNumDirty();
+    QVERIFY(numEdited > 0);
+    QVERIFY(server.applyEdit(editor.writePatch()));
+    QCOMPARE(server.getLatestVersion(), (quint32)1);
+    for (int i = 0; i < server.getNumBricksTotal(); i++) {
+        QCOMPARE(server.getVersion(i), (quint32)(editor.isDirty(i) ? 1 : 0));
+    }
+
+    // and the same edit again changes nothing
+    QVERIFY(server.applyEdit(editor.writePatch()));
+    QCOMPARE(server.getLatestVersion(), (quint32)1);
+
+    // the client then only gets the bricks that changed, with the versions the entity-server gave them
+    client.clearDirty();
+    while (server.hasBricksAfter(cursor)) {
+        QVERIFY(client.merge(server.writePatchAfter(cursor, PolyVoxBricks::MAX_PATCH_SIZE)));
+    }
+    QCOMPARE(client.getNumDirty(), numEdited);
+    for (int i = 0; i < client.getNumBricksTotal(); i++) {
+        QCOMPARE(client.getVersion(i), server.getVersion(i));
+    }
+    verifyVoxels(client, voxels);
+
+    // a packet from before the edit that turns up late doesn't undo it
+    QVERIFY(client.merge(original));
+    verifyVoxels(client, voxels);
+
+    // voxel data saved before a restart has newer versions than anything in the volume it is loaded into
+    PolyVoxBricks restarted(glm::ivec3(PolyVoxBricks::BRICK_SIZE));
+    QVERIFY(restarted.applyEdit(server.write()));
+    for (int i = 0; i < restarted.getNumBricksTotal(); i++) {
+        QVERIFY(restarted.getVersion(i) > server.getLatestVersion());
+    }
+    verifyVoxels(restarted, voxels);
+}
+
+void PolyVoxBricksTests::testLargeVolume() {
+    const glm::ivec3 SIZE(128, 128, 128);
+    QByteArray voxels = makeTerrain(SIZE);
+    PolyVoxBricks server(SIZE);
+    setBricks(server, voxels);
+    server.clearDirty();
+
+    // rolling ground this size is a lot more than a packet
+    QVERIFY(server.write().size() > PolyVoxBricks::MAX_PATCH_SIZE);
+
+    // but goes out a packet at a time
+    PolyVoxBricks client;
+    quint64 cursor = 0;
+    int numPackets = 0;
+    while (server.hasBricksAfter(cursor)) {
+        QByteArray patch = server.writePatchAfter(cursor, PolyVoxBricks::MAX_PATCH_SIZE);
+        QVERIFY(!patch.isEmpty());
+        QVERIFY(patch.size() <= PolyVoxBricks::MAX_PATCH_SIZE);
+        QVERIFY(client.merge(patch));
+        numPackets++;
+    }
+    QVERIFY(numPackets > 1);
+    verifyVoxels(client, voxels);
+
+    // nothing goes in a packet without room for the next brick
+    quint64 fullCursor = 0;
+    QVERIFY(server.writePatchAfter(fullCursor, 8).isEmpty());
+    QCOMPARE(fullCursor, (quint64)0);
+
+    // an edit across a lot of the surface goes to the entity-server in patches that each fit in a packet
+    setSphere(voxels, SIZE, glm::ivec3(64, 64, 64), 40, 0);
+    PolyVoxBricks editor = client;
+    editor.clearDirty();
+    setBricks(editor, voxels);
+    std::vector<int> editedBricks;
+    for (int i = 0; i < editor.getNumBricksTotal(); i++) {
+        if (editor.isDirty(i)) {
+            editedBricks.push_back(i);
+        }
+    }
+    std::vector<QByteArray> patches = editor.writePatches(editedBricks, PolyVoxBricks::MAX_PATCH_SIZE);
+    QVERIFY(patches.size() > 1);
+    for (const auto& patch : patches) {
+        QVERIFY(PolyVoxBricks::isPatch(patch));
+        QVERIFY(patch.size() <= PolyVoxBricks::MAX_PATCH_SIZE);
+        QVERIFY(server.applyEdit(patch));
+    }
+    verifyVoxels(server, voxels);
+
+    // and comes back to the client the same way
+    while (server.hasBricksAfter(cursor)) {
+        QVERIFY(client.merge(server.writePatchAfter(cursor, PolyVoxBricks::MAX_PATCH_SIZE)));
+    }
+    verifyVoxels(client, voxels);
+}
+
+void PolyVoxBricksTests::benchmarkEdit() {
+    const glm::ivec3 SIZE(128, 128, 128);
+    const int NUM_EDITS = 20;
+    const int EDIT_RADIUS = 3;
+
+    // rolling ground, which was too big to edit at all at this size when the whole volume was sent
+    QByteArray voxels = makeTerrain(SIZE);
+    PolyVoxBricks bricks(SIZE);
+    setBricks(bricks, voxels);
+    bricks.clearDirty();
+
+    // a script digging a trench along the ground, one sphere per edit
+    uint64_t wholeUsecs = 0;
+    uint64_t brickUsecs = 0;
+    int64_t wholeBytes = 0;
+    int64_t patchBytes = 0;
+    for (int i = 0; i < NUM_EDITS; i++) {
+        glm::ivec3 center(8 + i * 2, SIZE.y / 2, 8);
+        setSphere(voxels, SIZE, center, EDIT_RADIUS, 0);
+
+        // before, the whole volume was compressed and sent
+        uint64_t start = usecTimestampNow();
+        QByteArray wholeVoxelData = makeLegacyVoxelData(voxels, SIZE);
+        wholeUsecs += usecTimestampNow() - start;
+        wholeBytes += wholeVoxelData.size();
+
+        // now, only the bricks the edit touched
+        start = usecTimestampNow();
+        glm::ivec3 low = glm::max(center - EDIT_RADIUS, glm::ivec3(0)) / PolyVoxBricks::BRICK_SIZE;
+        glm::ivec3 high = glm::min(center + EDIT_RADIUS, SIZE - 1) / PolyVoxBricks::BRICK_SIZE;
+        std::vector<int> editedBricks;
+        for (int z = low.z; z <= high.z; z++) {
+            for (int y = low.y; y <= high.y; y++) {
+                for (int x = low.x; x <= high.x; x++) {
+                    int index = bricks.getBrickIndex(glm::ivec3(x, y, z) * PolyVoxBricks::BRICK_SIZE);
+                    bricks.setVoxels(index, getBrickVoxels(voxels, bricks, index));
+                    editedBricks.push_back(index);
+                }
+            }
+        }
+        std::vector<QByteArray> patches = bricks.writePatches(editedBricks, PolyVoxBricks::MAX_PATCH_SIZE);
+        brickUsecs += usecTimestampNow() - start;
+
+        // every edit is one that goes out
+        QVERIFY(!patches.empty());
+        for (const auto& patch : patches) {
+            QVERIFY(patch.size() <= PolyVoxBricks::MAX_PATCH_SIZE);
+            patchBytes += patch.size();
+        }
+    }
+
+    PolyVoxBricks result;
+    QVERIFY(result.read(bricks.write()));
+    verifyVoxels(result, voxels);
+
+    qDebug() << "128^3 volume, per edit: whole volume" << wholeBytes / NUM_EDITS << "bytes," << wholeUsecs / NUM_EDITS
+        << "us to compress; bricks" << patchBytes / NUM_EDITS << "bytes sent," << brickUsecs / NUM_EDITS
+        << "us to compress";
+}
@@ -0,0 +1,29 @@
+//
+//  PolyVoxBricksTests.h
+//  tests/octree/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PolyVoxBricksTests_h
+#define hifi_PolyVoxBricksTests_h
+
+#include <QtTest/QtTest>
+
+class PolyVoxBricksTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testRoundTrip();
+    void testLegacyVoxelData();
+    void testPatch();
+    void testVersions();
+    void testLargeVolume();
+    void benchmarkEdit();
+};
+
+#endif // hifi_PolyVoxBricksTests_h
@@ -0,0 +1,432 @@
+//
+//  SceneTests.cpp
+//  tests/render/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SceneTests.h"
+
+#include <atomic>
+#include <thread>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <render/CullTask.h>
+#include <render/Scene.h>
+#include <GLMHelpers.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+#include <ViewFrustum.h>
+
+QTEST_MAIN(SceneTests)
+
+struct TestItem {
+    glm::vec3 position;
+    std::vector<int> applied;
+    mutable std::atomic<int> numKeyEvaluations { 0 };
+    mutable std::atomic<int> numBoundEvaluations { 0 };
+};
+using TestItemPointer = std::shared_ptr<TestItem>;
+
+namespace render {
+template <> const ItemKey payloadGetKey(const TestItemPointer& item) {
+    item->numKeyEvaluations++;
+    return ItemKey::Builder::opaqueShape().build();
+}
+template <> const Item::Bound payloadGetBound(const TestItemPointer& item) {
+    item->numBoundEvaluations++;
+    return Item::Bound(item->position - glm::vec3(0.5f), 1.0f);
+}
+}
+
+using TestPayload = render::Payload<TestItem>;
+
+static const float SCENE_SIZE = 1000.0f;
+
+static std::vector<TestItemPointer> addItems(const render::ScenePointer& scene, int numItems, std::vector<render::ItemID>& ids) {
+    std::vector<TestItemPointer> items;
+    render::Transaction transaction;
+    for (int i = 0; i < numItems; ++i) {
+        auto item = std::make_shared<TestItem>();
+        item->position = glm::vec3((float)(i % 100), (float)((i / 100) % 100), (float)(i / 10000));
+        auto id = scene->allocateID();
+        transaction.resetItem(id, std::make_shared<TestPayload>(item));
+        items.push_back(item);
+        ids.push_back(id);
+    }
+    scene->enqueueTransaction(std::move(transaction));
+    scene->enqueueFrame();
+    scene->processTransactionQueue();
+    for (auto& item : items) {
+        item->numKeyEvaluations = 0;
+        item->numBoundEvaluations = 0;
+    }
+    return items;
+}
+
+// the views of a frame with the secondary camera and four shadow cascades on
+static std::vector<ViewFrustum> makeFrameViews() {
+    std::vector<ViewFrustum> views;
+
+    ViewFrustum main;
+    main.setPosition(glm::vec3(50.0f, 50.0f, 120.0f));
+    main.setProjection(60.0f, 16.0f / 9.0f, 0.1f, 500.0f);
+    main.calculate();
+    views.push_back(main);
+
+    ViewFrustum secondary;
+    secondary.setPosition(glm::vec3(50.0f, 50.0f, -60.0f));
+    secondary.setOrientation(glm::angleAxis(PI, Vectors::UNIT_Y));
+    secondary.setProjection(45.0f, 1.0f, 0.1f, 500.0f);
+    secondary.calculate();
+    views.push_back(secondary);
+
+    // the cascades look down from the light, each twice as big as the one before
+    const int NUM_CASCADES = 4;
+    for (int cascade = 0; cascade < NUM_CASCADES; ++cascade) {
+        float halfSize = 15.0f * (float)(1 << cascade);
+        ViewFrustum shadow;
+        shadow.setPosition(glm::vec3(50.0f, 200.0f, 0.0f));
+        shadow.setOrientation(glm::angleAxis(-0.5f * PI, Vectors::UNIT_X));
+        shadow.setProjection(glm::ortho(-halfSize, halfSize, -halfSize, halfSize, 0.1f, 400.0f));
+        shadow.calculate();
+        views.push_back(shadow);
+    }
+    return views;
+}
+
+// what each render view does first, without a gpu backend: fetch the items from the spatial tree and cull them
+static void fetchAndCull(const render::RenderContextPointer& renderContext, const ViewFrustum& view, render::ItemBounds& outItems) {
+    const auto filter = render::ItemFilter::Builder::visibleWorldItems().build();
+    renderContext->args->setViewFrustum(view);
+
+    render::FetchSpatialTree fetch;
+    render::ItemSpatialTree::ItemSelection selection;
+    fetch.run(renderContext, render::FetchSpatialTree::Inputs(filter, glm::ivec2(0)), selection);
+
+    render::CullSpatialSelection cull([](const RenderArgs*, const AABox&) { return true; }, false, render::RenderDetails::ITEM);
+    cull.run(renderContext, render::CullSpatialSelection::Inputs(selection, filter), outItems);
+}
+
+static render::RenderContextPointer makeRenderContext(const render::ScenePointer& scene, RenderArgs& args) {
+    auto renderContext = std::make_shared<render::RenderContext>();
+    renderContext->_scene = scene;
+    renderContext->args = &args;
+    renderContext->jobConfig = std::make_shared<render::CullSpatialSelection::Config>();
+    return renderContext;
+}
+
+static std::function<void(TestItem&)> appendUpdate(int value) {
+    return [value](TestItem& item) { item.applied.push_back(value); };
+}
+
+// a transaction that shows which items its updates are for, in order
+class InspectableTransaction : public render::Transaction {
+public:
+    std::vector<render::ItemID> getUpdatedItemIDs() const {
+        std::vector<render::ItemID> ids;
+        for (const auto& update : _updatedItems) {
+            ids.push_back(std::get<0>(update));
+        }
+        return ids;
+    }
+};
+
+void SceneTests::testUpdateOrder() {
+    auto scene = std::make_shared<render::Scene>(glm::vec3(-0.5f * SCENE_SIZE), SCENE_SIZE);
+    std::vector<render::ItemID> ids;
+    auto items = addItems(scene, 1, ids);
+
+    render::Transaction first;
+    first.updateItem<TestItem>(ids[0], appendUpdate(1));
+    first.updateItem(ids[0]);
+    first.updateItem<TestItem>(ids[0], appendUpdate(2));
+    scene->enqueueTransaction(std::move(first));
+
+    render::Transaction second;
+    second.updateItem<TestItem>(ids[0], appendUpdate(3));
+    scene->enqueueTransaction(second);
+    QCOMPARE(scene->getTransactionQueueSize(), (size_t)2);
+
+    scene->enqueueFrame();
+    QCOMPARE(scene->getTransactionQueueSize(), (size_t)0);
+    scene->processTransactionQueue();
+
+    std::vector<int> expected { 1, 2, 3 };
+    QVERIFY(items[0]->applied == expected);
+}
+
+void SceneTests::testCoalescedUpdates() {
+    auto scene = std::make_shared<render::Scene>(glm::vec3(-0.5f * SCENE_SIZE), SCENE_SIZE);
+    std::vector<render::ItemID> ids;
+    auto items = addItems(scene, 3, ids);
+
+    // updates to the same items spread over several transactions, interleaved with other items
+    render::Transaction transaction;
+    transaction.updateItem(ids[0]);
+    transaction.updateItem<TestItem>(ids[0], appendUpdate(1));
+    transaction.updateItem(ids[1]);
+    transaction.updateItem(ids[2]);
+    transaction.updateItem(ids[0]);
+    scene->enqueueTransaction(transaction);
+
+    transaction.clear();
+    transaction.updateItem(ids[1]);
+    transaction.updateItem<TestItem>(ids[0], appendUpdate(2));
+    transaction.updateItem(ids[2]);
+    scene->enqueueTransaction(transaction);
+
+    scene->enqueueFrame();
+    scene->processTransactionQueue();
+
+    // the empty updates of item 0 are dropped in favor of its two real ones,
+    // and the empty updates of the other items collapse into one
+    std::vector<int> expected { 1, 2 };
+    QVERIFY(items[0]->applied == expected);
+    QCOMPARE(items[0]->numKeyEvaluations.load(), 2);
+    QCOMPARE(items[1]->numKeyEvaluations.load(), 1);
+    QCOMPARE(items[2]->numKeyEvaluations.load(), 1);
+    QVERIFY(items[1]->applied.empty());
+
+    // the items stay in the order they were first updated, not in the order of their ids
+    InspectableTransaction ordered;
+    ordered.updateItem<TestItem>(ids[2], appendUpdate(1));
+    ordered.updateItem<TestItem>(ids[0], appendUpdate(2));
+    ordered.updateItem<TestItem>(ids[2], appendUpdate(3));
+    ordered.updateItem<TestItem>(ids[1], appendUpdate(4));
+    ordered.updateItem<TestItem>(ids[0], appendUpdate(5));
+    ordered.coalesceUpdates();
+    std::vector<render::ItemID> expectedIDs { ids[2], ids[2], ids[0], ids[0], ids[1] };
+    QVERIFY(ordered.getUpdatedItemIDs() == expectedIDs);
+}
+
+void SceneTests::testConcurrentEnqueue() {
+    auto scene = std::make_shared<render::Scene>(glm::vec3(-0.5f * SCENE_SIZE), SCENE_SIZE);
+    const int NUM_THREADS = 8;
+    const int NUM_TRANSACTIONS_PER_THREAD = 2000;
+    std::vector<render::ItemID> ids;
+    auto items = addItems(scene, NUM_THREADS, ids);
+
+    std::atomic<int> numRunning { NUM_THREADS };
+    std::vector<std::thread> threads;
+    for (int t = 0; t < NUM_THREADS; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < NUM_TRANSACTIONS_PER_THREAD; ++i) {
+                render::Transaction transaction;
+                transaction.updateItem<TestItem>(ids[t], appendUpdate(i));
+                scene->enqueueTransaction(std::move(transaction));
+            }
+            numRunning--;
+        });
+    }
+
+    // keep flushing frames while the producers are running
+    while (numRunning > 0) {
+        scene->enqueueFrame();
+        scene->processTransactionQueue();
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    scene->enqueueFrame();
+    scene->processTransactionQueue();
+
+    for (int t = 0; t < NUM_THREADS; ++t) {
+        const auto& applied = items[t]->applied;
+        QCOMPARE((int)applied.size(), NUM_TRANSACTIONS_PER_THREAD);
+        for (int i = 0; i < NUM_TRANSACTIONS_PER_THREAD; ++i) {
+            QCOMPARE(applied[i], i);
+        }
+    }
+}
+
+void SceneTests::testParallelUpdates() {
+    auto scene = std::make_shared<render::Scene>(glm::vec3(-0.5f * SCENE_SIZE), SCENE_SIZE);
+    scene->setParallelItemUpdates(true);
+    const int NUM_ITEMS = 10000;
+    std::vector<render::ItemID> ids;
+    auto items = addItems(scene, NUM_ITEMS, ids);
+
+    const glm::vec3 OFFSET(1.0f, 2.0f, 3.0f);
+    render::Transaction transaction;
+    for (int i = 0; i < NUM_ITEMS; ++i) {
+        transaction.updateItem<TestItem>(ids[i], [OFFSET](TestItem& item) { item.position += OFFSET; });
+    }
+    for (int i = NUM_ITEMS - 1; i >= 0; --i) {
+        transaction.updateItem<TestItem>(ids[i], [](TestItem& item) { item.position *= 2.0f; });
+    }
+    scene->enqueueTransaction(std::move(transaction));
+    scene->enqueueFrame();
+    scene->processTransactionQueue();
+
+    for (int i = 0; i < NUM_ITEMS; ++i) {
+        glm::vec3 expected = (glm::vec3((float)(i % 100), (float)((i / 100) % 100), (float)(i / 10000)) + OFFSET) * 2.0f;
+        QCOMPARE(items[i]->position, expected);
+        QCOMPARE(items[i]->numKeyEvaluations.load(), 2);
+        QCOMPARE(scene->getItem(ids[i]).getBound().calcCenter(), expected);
+    }
+}
+
+void SceneTests::testFrameBounds() {
+    auto scene = std::make_shared<render::Scene>(glm::vec3(-0.5f * SCENE_SIZE), SCENE_SIZE);
+    const int NUM_ITEMS = 10000;
+    std::vector<render::ItemID> ids;
+    auto items = addItems(scene, NUM_ITEMS, ids);
+    RenderArgs args;
+    auto renderContext = makeRenderContext(scene, args);
+
+    // every view of the frame gets its bounds from the same evaluation of each item
+    std::vector<int> numViewsSeen(ids.back() + 1, 0);
+    std::vector<render::ItemBound> seen;
+    for (const auto& view : makeFrameViews()) {
+        render::ItemBounds itemBounds;
+        fetchAndCull(renderContext, view, itemBounds);
+        for (const auto& itemBound : itemBounds) {
+            numViewsSeen[itemBound.id]++;
+        }
+        seen.insert(seen.end(), itemBounds.begin(), itemBounds.end());
+    }
+    int numSeenMoreThanOnce = 0;
+    for (int i = 0; i < NUM_ITEMS; ++i) {
+        QVERIFY(items[i]->numBoundEvaluations.load() <= 1);
+        numSeenMoreThanOnce += numViewsSeen[ids[i]] > 1 ? 1 : 0;
+    }
+    QVERIFY(numSeenMoreThanOnce > 0);
+    for (const auto& itemBound : seen) {
+        QVERIFY(itemBound.bound == scene->getItem(itemBound.id).getBound());
+    }
+
+    // and so does anything else that asks during the frame
+    for (auto& item : items) {
+        item->numBoundEvaluations = 0;
+    }
+    scene->processTransactionQueue();
+    for (int i = 0; i < NUM_ITEMS; ++i) {
+        scene->getFrameBound(ids[i]);
+        scene->getFrameBound(ids[i]);
+        QCOMPARE(items[i]->numBoundEvaluations.load(), 1);
+    }
+
+    // an item that moved has its new bound the next frame
+    render::Transaction transaction;
+    transaction.updateItem<TestItem>(ids[0], [](TestItem& item) { item.position = glm::vec3(10.0f, 20.0f, 30.0f); });
+    scene->enqueueTransaction(std::move(transaction));
+    scene->enqueueFrame();
+    scene->processTransactionQueue();
+    QCOMPARE(scene->getFrameBound(ids[0]).calcCenter(), glm::vec3(10.0f, 20.0f, 30.0f));
+    QCOMPARE(scene->getFrameBound(ids[1]).calcCenter(), items[1]->position);
+}
+
+void SceneTests::benchmarkFrameBounds() {
+    const int NUM_ITEMS = 100000;
+    const int NUM_FRAMES = 20;
+
+    auto scene = std::make_shared<render::Scene>(glm::vec3(-0.5f * SCENE_SIZE), SCENE_SIZE);
+    std::vector<render::ItemID> ids;
+    auto items = addItems(scene, NUM_ITEMS, ids);
+    RenderArgs args;
+    auto renderContext = makeRenderContext(scene, args);
+    auto views = makeFrameViews();
+
+    auto countBoundEvaluations = [&] {
+        int numBoundEvaluations = 0;
+        for (auto& item : items) {
+            numBoundEvaluations += item->numBoundEvaluations.exchange(0);
+        }
+        return numBoundEvaluations;
+    };
+
+    // Without sharing, each view asks the items for their bounds again.  Starting a new frame before each view does that
+    auto measure = [&](bool shared, int& numBoundEvaluations) {
+        quint64 usecs = 0;
+        size_t numCulled = 0;
+        countBoundEvaluations();
+        for (int frame = 0; frame < NUM_FRAMES; ++frame) {
+            scene->processTransactionQueue();
+            for (const auto& view : views) {
+                if (!shared) {
+                    scene->processTransactionQueue();
+                }
+                render::ItemBounds itemBounds;
+                quint64 start = usecTimestampNow();
+                fetchAndCull(renderContext, view, itemBounds);
+                usecs += usecTimestampNow() - start;
+                numCulled += itemBounds.size();
+            }
+        }
+        numBoundEvaluations = countBoundEvaluations() / NUM_FRAMES;
+        return std::make_pair((float)usecs / (NUM_FRAMES * USECS_PER_MSEC), numCulled / NUM_FRAMES);
+    };
+
+    int numUnsharedEvaluations = 0;
+    int numSharedEvaluations = 0;
+    auto unshared = measure(false, numUnsharedEvaluations);
+    auto shared = measure(true, numSharedEvaluations);
+
+    qDebug() << NUM_ITEMS << "items," << views.size() << "views (main, secondary camera, 4 shadow cascades), fetch and cull per frame:"
+        << "bounds per view" << unshared.first << "ms," << numUnsharedEvaluations << "bound evaluations;"
+        << "bounds shared by the frame" << shared.first << "ms," << numSharedEvaluations << "bound evaluations";
+
+    QCOMPARE(shared.second, unshared.second);
+    QVERIFY(numSharedEvaluations < numUnsharedEvaluations);
+}
+
+void SceneTests::benchmarkItemUpdates() {
+    const int NUM_ITEMS = 100000;
+    const int NUM_FRAMES = 10;
+    // updates come in many small transactions, and some items are touched more than once per frame
+    const int ITEMS_PER_TRANSACTION = 50;
+    const int NUM_REPEATED_UPDATES = NUM_ITEMS / 10;
+
+    for (bool parallel : { false, true }) {
+        auto scene = std::make_shared<render::Scene>(glm::vec3(-0.5f * SCENE_SIZE), SCENE_SIZE);
+        scene->setParallelItemUpdates(parallel);
+        std::vector<render::ItemID> ids;
+        auto items = addItems(scene, NUM_ITEMS, ids);
+
+        quint64 enqueueUsecs = 0;
+        quint64 frameUsecs = 0;
+        quint64 processUsecs = 0;
+        for (int frame = 0; frame < NUM_FRAMES; ++frame) {
+            glm::vec3 offset((float)(frame % 2 ? 1 : -1));
+
+            quint64 start = usecTimestampNow();
+            render::Transaction transaction;
+            for (int i = 0; i < NUM_ITEMS; ++i) {
+                transaction.updateItem<TestItem>(ids[i], [offset](TestItem& item) { item.position += offset; });
+                if ((i + 1) % ITEMS_PER_TRANSACTION == 0) {
+                    scene->enqueueTransaction(std::move(transaction));
+                    transaction.clear();
+                }
+            }
+            for (int i = 0; i < NUM_REPEATED_UPDATES; ++i) {
+                transaction.updateItem(ids[(i * 7) % NUM_ITEMS]);
+            }
+            scene->enqueueTransaction(std::move(transaction));
+
+            quint64 enqueued = usecTimestampNow();
+            scene->enqueueFrame();
+            quint64 framed = usecTimestampNow();
+            scene->processTransactionQueue();
+            quint64 processed = usecTimestampNow();
+
+            enqueueUsecs += enqueued - start;
+            frameUsecs += framed - enqueued;
+            processUsecs += processed - framed;
+        }
+
+        qDebug() << (parallel ? "parallel" : "serial") << NUM_ITEMS << "item updates per frame, avg per frame (ms):"
+            << "build+enqueue" << (float)enqueueUsecs / (NUM_FRAMES * USECS_PER_MSEC)
+            << "enqueueFrame" << (float)frameUsecs / (NUM_FRAMES * USECS_PER_MSEC)
+            << "processTransactionQueue" << (float)processUsecs / (NUM_FRAMES * USECS_PER_MSEC);
+
+        // an even number of frames moves every item back to where it started
+        QCOMPARE(items[0]->position, glm::vec3(0.0f));
+        QCOMPARE(items[NUM_ITEMS - 1]->position, glm::vec3(99.0f, 99.0f, 9.0f));
+    }
+}
@@ -0,0 +1,30 @@
+//
+//  SceneTests.h
+//  tests/render/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_render_SceneTests_h
+#define hifi_render_SceneTests_h
+
+#include <QtTest/QtTest>
+
+class SceneTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testUpdateOrder();
+    void testCoalescedUpdates();
+    void testConcurrentEnqueue();
+    void testParallelUpdates();
+    void testFrameBounds();
+    void benchmarkItemUpdates();
+    void benchmarkFrameBounds();
+};
+
+#endif // hifi_render_SceneTests_h
@@ -0,0 +1,216 @@
+//
+//  PrioritySortUtilTests.cpp
+//  tests/shared/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PrioritySortUtilTests.h"
+
+#include <algorithm>
+#include <random>
+
+#include <glm/gtc/quaternion.hpp>
+
+#include <PrioritySortUtil.h>
+#include <SharedUtil.h>
+#include <ViewFrustum.h>
+
+QTEST_MAIN(PrioritySortUtilTests)
+
+namespace {
+
+const float ANGULAR_WEIGHT = 1.0f;
+const float CENTER_WEIGHT = 0.5f;
+const float AGE_WEIGHT = 0.25f;
+
+struct Thing {
+    glm::vec3 position;
+    float radius;
+    uint64_t timestamp;
+};
+
+class TestSortable : public PrioritySortUtil::Sortable {
+public:
+    TestSortable(const Thing* thing) : _thing(thing) {}
+
+    glm::vec3 getPosition() const override { return _thing->position; }
+    float getRadius() const override { return _thing->radius; }
+    uint64_t getTimestamp() const override { return _thing->timestamp; }
+    const Thing* getThing() const { return _thing; }
+
+private:
+    const Thing* _thing;
+};
+
+ConicalViewFrustum makeView(const glm::vec3& position, float yawDegrees) {
+    ViewFrustum viewFrustum;
+    viewFrustum.setPosition(position);
+    viewFrustum.setOrientation(glm::angleAxis(glm::radians(yawDegrees), glm::vec3(0.0f, 1.0f, 0.0f)));
+    viewFrustum.setProjection(90.0f, 16.0f / 9.0f, 0.1f, 500.0f);
+    viewFrustum.calculate();
+    ConicalViewFrustum view(viewFrustum);
+    view.calculate();
+    return view;
+}
+
+// a crowd around the origin, aged a whole number of seconds and a half so that the age doesn't depend on exactly when
+// a queue reads the time
+std::vector<Thing> makeThings(size_t numThings, uint64_t now) {
+    std::mt19937 generator(numThings);
+    std::uniform_real_distribution<float> coordinate(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> radius(0.0f, 2.0f);
+    std::uniform_int_distribution<int> age(0, 5);
+
+    std::vector<Thing> things;
+    for (size_t i = 0; i < numThings; i++) {
+        glm::vec3 position(coordinate(generator), 0.1f * coordinate(generator), coordinate(generator));
+        uint64_t timestamp = now - age(generator) * USECS_PER_SECOND - USECS_PER_SECOND / 2;
+        things.push_back({ position, radius(generator), timestamp });
+    }
+    return things;
+}
+
+// how PriorityQueue computed priorities, one thing at a time
+float referencePriority(const ConicalViewFrustums& views, const PrioritySortUtil::Sortable& thing, uint64_t now) {
+    float priority = std::numeric_limits<float>::min();
+    for (const auto& view : views) {
+        glm::vec3 offset = thing.getPosition() - view.getPosition();
+        float distance = glm::length(offset) + 0.001f;
+        float radius = glm::max(thing.getRadius(), PrioritySortUtil::MIN_RADIUS);
+        float cosineAngle = glm::dot(offset, view.getDirection()) / distance;
+        if (cosineAngle > 0.0f) {
+            cosineAngle = std::sqrt(cosineAngle);
+        }
+        float age = float((now - thing.getTimestamp()) / USECS_PER_SECOND);
+        float viewPriority = (ANGULAR_WEIGHT * radius / distance + CENTER_WEIGHT * cosineAngle) * (age + 1.0f) + AGE_WEIGHT * age;
+        if (distance - radius > view.getRadius() && !view.intersects(offset, distance, radius)) {
+            viewPriority += OUT_OF_VIEW_PENALTY;
+        }
+        priority = std::max(priority, viewPriority);
+    }
+    return priority;
+}
+
+using Queue = PrioritySortUtil::PriorityQueue<TestSortable>;
+
+std::vector<TestSortable> sort(const ConicalViewFrustums& views, const std::vector<Thing>& things, int numToSort = 0) {
+    Queue queue(views, ANGULAR_WEIGHT, CENTER_WEIGHT, AGE_WEIGHT);
+    queue.reserve(things.size());
+    for (const auto& thing : things) {
+        queue.push(TestSortable(&thing));
+    }
+    return queue.getSortedVector(numToSort);
+}
+
+bool higherPriority(const TestSortable& left, const TestSortable& right) {
+    return left.getPriority() > right.getPriority();
+}
+
+}
+
+void PrioritySortUtilTests::testPriorities() {
+    uint64_t now = usecTimestampNow();
+    auto things = makeThings(1000, now);
+    ConicalViewFrustums views { makeView(glm::vec3(0.0f), 0.0f), makeView(glm::vec3(20.0f, 0.0f, 0.0f), 135.0f) };
+
+    auto sorted = sort(views, things);
+    QCOMPARE(sorted.size(), things.size());
+    int numAtTheBack = 0;
+    for (size_t i = 0; i < sorted.size(); i++) {
+        QCOMPARE(sorted[i].getPriority(), referencePriority(views, sorted[i], now));
+        if (i > 0) {
+            QVERIFY(sorted[i - 1].getPriority() >= sorted[i].getPriority());
+        }
+        numAtTheBack += sorted[i].getPriority() == std::numeric_limits<float>::min() ? 1 : 0;
+    }
+    // the penalty puts what is out of view at the back
+    QVERIFY(numAtTheBack > 0);
+    QVERIFY(numAtTheBack < (int)sorted.size());
+
+    // no views, no priority
+    for (const auto& sortable : sort(ConicalViewFrustums(), things)) {
+        QCOMPARE(sortable.getPriority(), std::numeric_limits<float>::min());
+    }
+}
+
+void PrioritySortUtilTests::testPartialSort() {
+    uint64_t now = usecTimestampNow();
+    auto things = makeThings(1000, now);
+    ConicalViewFrustums views { makeView(glm::vec3(0.0f), 30.0f) };
+
+    const int NUM_TO_SORT = 50;
+    auto sorted = sort(views, things, NUM_TO_SORT);
+    auto fullySorted = sort(views, things);
+    QCOMPARE(sorted.size(), things.size());
+    for (int i = 0; i < NUM_TO_SORT; i++) {
+        QCOMPARE(sorted[i].getPriority(), fullySorted[i].getPriority());
+    }
+    for (size_t i = NUM_TO_SORT; i < sorted.size(); i++) {
+        QVERIFY(sorted[i].getPriority() <= sorted[NUM_TO_SORT - 1].getPriority());
+    }
+}
+
+void PrioritySortUtilTests::benchmarkSorting() {
+    const int NUM_FRAMES = 60;
+    const int NUM_TO_SORT = 50;
+
+    for (size_t numThings : { 100, 1000, 10000 }) {
+        uint64_t now = usecTimestampNow();
+        auto things = makeThings(numThings, now);
+        ConicalViewFrustums views { makeView(glm::vec3(0.0f), 0.0f), makeView(glm::vec3(0.0f, 0.0f, 5.0f), 180.0f) };
+        float checksum = 0.0f;
+
+        // how PriorityQueue used to do it
+        auto timeOneAtATime = [&](int numToSort) {
+            uint64_t start = usecTimestampNow();
+            for (int frame = 0; frame < NUM_FRAMES; frame++) {
+                std::vector<TestSortable> sorted;
+                sorted.reserve(things.size());
+                for (const auto& thing : things) {
+                    TestSortable sortable(&thing);
+                    sortable.setPriority(referencePriority(views, sortable, now));
+                    sorted.push_back(sortable);
+                }
+                if (numToSort == 0) {
+                    std::sort(sorted.begin(), sorted.end(), higherPriority);
+                } else {
+                    std::partial_sort(sorted.begin(), sorted.begin() + numToSort, sorted.end(), higherPriority);
+                }
+                checksum += sorted[0].getPriority();
+            }
+            return (float)(usecTimestampNow() - start) / NUM_FRAMES;
+        };
+
+        auto timeBatched = [&](int numToSort) {
+            uint64_t start = usecTimestampNow();
+            for (int frame = 0; frame < NUM_FRAMES; frame++) {
+                Queue queue(views, ANGULAR_WEIGHT, CENTER_WEIGHT, AGE_WEIGHT);
+                queue.reserve(things.size());
+                for (const auto& thing : things) {
+                    queue.push(TestSortable(&thing));
+                }
+                checksum += queue.getSortedVector(numToSort)[0].getPriority();
+            }
+            return (float)(usecTimestampNow() - start) / NUM_FRAMES;
+        };
+
+        float oneAtATimeUsecs = timeOneAtATime(0);
+        float batchedUsecs = timeBatched(0);
+        float oneAtATimeTopUsecs = timeOneAtATime(NUM_TO_SORT);
+        float batchedTopUsecs = timeBatched(NUM_TO_SORT);
+
+        qDebug() << numThings << "sortables, two views:" << "full sort" << oneAtATimeUsecs << "us/frame before,"
+            << batchedUsecs << "us/frame batched;" << "top" << NUM_TO_SORT << oneAtATimeTopUsecs << "us/frame before,"
+            << batchedTopUsecs << "us/frame batched" << "(" << checksum << ")";
+
+        // the queue used to only sort everything
+        if (numThings >= 10000) {
+            QVERIFY(batchedTopUsecs < oneAtATimeUsecs);
+        }
+    }
+}
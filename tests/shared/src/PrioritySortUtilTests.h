@@ -0,0 +1,26 @@
+//
+//  PrioritySortUtilTests.h
+//  tests/shared/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PrioritySortUtilTests_h
+#define hifi_PrioritySortUtilTests_h
+
+#include <QtTest/QtTest>
+
+class PrioritySortUtilTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testPriorities();
+    void testPartialSort();
+    void benchmarkSorting();
+};
+
+#endif // hifi_PrioritySortUtilTests_h
@@ -0,0 +1,207 @@
+//
+//  TimerWheelTests.cpp
+//  tests/shared/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TimerWheelTests.h"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+
+#include <NumericalConstants.h>
+#include <TimerWheel.h>
+
+#include <test-utils/QTestExtensions.h>
+
+QTEST_MAIN(TimerWheelTests)
+
+using Wheel = TimerWheel<int>;
+
+static const uint64_t TICK_USECS = USECS_PER_MSEC;
+static const uint64_t FRAME_USECS = USECS_PER_SECOND / 60;
+
+void TimerWheelTests::testExpiryOrder() {
+    Wheel wheel(TICK_USECS, 0);
+    std::vector<uint64_t> expiries = { 500, 3 * USECS_PER_MSEC, 300 * USECS_PER_MSEC, 20 * USECS_PER_SECOND, 2 * USECS_PER_MSEC };
+    for (int i = 0; i < (int)expiries.size(); i++) {
+        wheel.add(expiries[i], i);
+    }
+    QCOMPARE(wheel.size(), expiries.size());
+
+    uint64_t lastExpiry = 0;
+    int numFired = 0;
+    for (uint64_t now = 0; now <= 30 * USECS_PER_SECOND; now += FRAME_USECS) {
+        wheel.advance(now, [&](Wheel::TimerID, int&& value, uint64_t expiry) {
+            QCOMPARE(expiry, expiries[value]);
+            QVERIFY(expiry <= now);
+            QVERIFY(now - expiry < FRAME_USECS + TICK_USECS);
+            QVERIFY(expiry >= lastExpiry);
+            lastExpiry = expiry;
+            numFired++;
+        });
+    }
+    QCOMPARE(numFired, (int)expiries.size());
+    QVERIFY(wheel.empty());
+}
+
+void TimerWheelTests::testCancel() {
+    Wheel wheel(TICK_USECS, 0);
+    auto first = wheel.add(10 * USECS_PER_MSEC, 1);
+    auto second = wheel.add(10 * USECS_PER_MSEC, 2);
+    auto third = wheel.add(5 * USECS_PER_SECOND, 3);
+
+    QVERIFY(wheel.cancel(second));
+    QVERIFY(!wheel.cancel(second));
+    QVERIFY(wheel.cancel(third));
+    QVERIFY(wheel.isActive(first));
+    QCOMPARE(wheel.size(), (size_t)1);
+
+    std::vector<int> fired;
+    wheel.advance(10 * USECS_PER_SECOND, [&](Wheel::TimerID, int&& value, uint64_t) {
+        fired.push_back(value);
+    });
+    QCOMPARE(fired.size(), (size_t)1);
+    QCOMPARE(fired[0], 1);
+
+    // an expired ID stays dead, even once its slot has been reused
+    QVERIFY(!wheel.isActive(first));
+    auto reused = wheel.add(11 * USECS_PER_SECOND, 4);
+    QVERIFY(reused != first);
+    QVERIFY(!wheel.cancel(first));
+    QVERIFY(wheel.isActive(reused));
+}
+
+void TimerWheelTests::testReentrantCallbacks() {
+    Wheel wheel(TICK_USECS, 0);
+    wheel.add(5 * USECS_PER_MSEC, 1);
+    auto doomed = wheel.add(5 * USECS_PER_MSEC, 2);
+
+    std::vector<int> fired;
+    wheel.advance(FRAME_USECS, [&](Wheel::TimerID, int&& value, uint64_t expiry) {
+        fired.push_back(value);
+        if (value == 1) {
+            // cancel a timer from the same batch, and re-arm one that is due within this advance
+            QVERIFY(wheel.cancel(doomed));
+            wheel.add(expiry + USECS_PER_MSEC, 3);
+        }
+    });
+    QCOMPARE(fired, std::vector<int>({ 1, 3 }));
+    QVERIFY(wheel.empty());
+}
+
+void TimerWheelTests::testLongTimers() {
+    // further out than the wheel spans at this resolution
+    const uint64_t LONG_EXPIRY = 2 * 24 * 60 * 60 * USECS_PER_SECOND;
+    Wheel wheel(TICK_USECS, 0);
+    wheel.add(LONG_EXPIRY, 1);
+
+    int numFired = 0;
+    const uint64_t STEP = 10 * USECS_PER_SECOND;
+    for (uint64_t now = 0; now < LONG_EXPIRY + STEP; now += STEP) {
+        wheel.advance(now, [&](Wheel::TimerID, int&&, uint64_t expiry) {
+            QCOMPARE(expiry, LONG_EXPIRY);
+            QVERIFY(now >= LONG_EXPIRY);
+            numFired++;
+        });
+    }
+    QCOMPARE(numFired, 1);
+}
+
+void TimerWheelTests::testNextExpiry() {
+    Wheel wheel(TICK_USECS, 0);
+    QCOMPARE(wheel.getNextExpiry(), Wheel::NO_EXPIRY);
+
+    std::mt19937 random(7);
+    std::uniform_int_distribution<uint64_t> delays(0, 10 * USECS_PER_SECOND);
+    std::vector<uint64_t> expiries;
+    for (int i = 0; i < 200; i++) {
+        expiries.push_back(delays(random));
+        wheel.add(expiries.back(), i);
+    }
+    std::sort(expiries.begin(), expiries.end());
+
+    // sleeping until the next expiry and advancing to it never misses a timer, nor fires one late
+    size_t numFired = 0;
+    int numWakeups = 0;
+    while (!wheel.empty()) {
+        uint64_t now = wheel.getNextExpiry();
+        QVERIFY(now != Wheel::NO_EXPIRY);
+        QVERIFY(now <= expiries[numFired] + TICK_USECS);
+        wheel.advance(now, [&](Wheel::TimerID, int&&, uint64_t expiry) {
+            QCOMPARE(expiry, expiries[numFired]);
+            QVERIFY(now - expiry < TICK_USECS);
+            numFired++;
+        });
+        numWakeups++;
+    }
+    QCOMPARE(numFired, expiries.size());
+    // the coarser levels cost a few extra wakeups, not one per tick
+    QVERIFY(numWakeups < 2 * (int)expiries.size());
+    QCOMPARE(wheel.getNextExpiry(), Wheel::NO_EXPIRY);
+}
+
+void TimerWheelTests::testStress() {
+    // 50k active timers, as a script frame loop would drive them: re-armed intervals plus churn from
+    // short timeouts that are set and cleared every frame
+    const int NUM_TIMERS = 50000;
+    const int NUM_FRAMES = 60 * 20;
+    const uint64_t MAX_INTERVAL_USECS = 2 * USECS_PER_SECOND;
+
+    std::mt19937 random(42);
+    std::uniform_int_distribution<uint64_t> intervals(USECS_PER_MSEC, MAX_INTERVAL_USECS);
+
+    Wheel wheel(TICK_USECS, 0);
+    std::vector<uint64_t> timerIntervals(NUM_TIMERS);
+    for (int i = 0; i < NUM_TIMERS; i++) {
+        timerIntervals[i] = intervals(random);
+        wheel.add(timerIntervals[i], i);
+    }
+
+    using clock = std::chrono::steady_clock;
+    std::chrono::nanoseconds totalCPU { 0 };
+    std::chrono::nanoseconds worstFrameCPU { 0 };
+    uint64_t numFired = 0;
+    uint64_t totalJitter = 0;
+    uint64_t maxJitter = 0;
+
+    uint64_t now = 0;
+    for (int frame = 0; frame < NUM_FRAMES; frame++) {
+        now += FRAME_USECS;
+        auto start = clock::now();
+
+        wheel.advance(now, [&](Wheel::TimerID, int&& value, uint64_t expiry) {
+            uint64_t jitter = now - expiry;
+            totalJitter += jitter;
+            maxJitter = std::max(maxJitter, jitter);
+            numFired++;
+            wheel.add(expiry + timerIntervals[value], value);
+        });
+
+        for (int i = 0; i < 100; i++) {
+            auto id = wheel.add(now + intervals(random), -1);
+            wheel.cancel(id);
+        }
+
+        auto elapsed = clock::now() - start;
+        totalCPU += elapsed;
+        worstFrameCPU = std::max<std::chrono::nanoseconds>(worstFrameCPU, elapsed);
+    }
+
+    QCOMPARE(wheel.size(), (size_t)NUM_TIMERS);
+    QVERIFY(numFired > 0);
+    // a timer is never run early, and never later than the frame that follows it
+    QVERIFY(maxJitter < FRAME_USECS + TICK_USECS);
+
+    using namespace std::chrono;
+    qDebug() << "timers:" << NUM_TIMERS << "frames:" << NUM_FRAMES << "fired:" << numFired;
+    qDebug() << "cpu per frame (usecs) avg:" << duration_cast<microseconds>(totalCPU).count() / NUM_FRAMES
+             << "worst:" << duration_cast<microseconds>(worstFrameCPU).count();
+    qDebug() << "jitter (usecs) avg:" << totalJitter / numFired << "max:" << maxJitter;
+}
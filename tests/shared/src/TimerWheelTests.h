@@ -0,0 +1,29 @@
+//
+//  TimerWheelTests.h
+//  tests/shared/src
+//
+//  Created by Maki Deprez on 10/19/26.
+//  Copyright 2026 Tivoli Cloud VR, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TimerWheelTests_h
+#define hifi_TimerWheelTests_h
+
+#include <QtTest/QtTest>
+
+class TimerWheelTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testExpiryOrder();
+    void testCancel();
+    void testReentrantCallbacks();
+    void testLongTimers();
+    void testNextExpiry();
+    void testStress();
+};
+
+#endif // hifi_TimerWheelTests_h
@@ -13,9 +13,11 @@
 
 #include <QtCore/QDebug>
 
+#include <udt/Connection.h>
 #include <udt/Constants.h>
 #include <udt/Packet.h>
 #include <udt/PacketList.h>
+#include <udt/SendQueue.h>
 
 #include <LogHandler.h>
 
@@ -55,10 +57,17 @@ const QCommandLineOption MESSAGE_SEED {
 const QCommandLineOption STATS_INTERVAL {
     "stats-interval", "stats output interval (default is 100ms)", "milliseconds"
 };
+const QCommandLineOption CONNECTIONS {
+    "connections", "number of connections, to consecutive ports from the target or listening port (default is 1)", "count"
+};
+const QCommandLineOption SENDER_THREADS {
+    "sender-threads", "number of threads shared by all reliable connections to send on (default is one per connection)", "count"
+};
 
 const QStringList CLIENT_STATS_TABLE_HEADERS {
     "Send (Mb/s)", "Est. Max (Mb/s)", "RTT (ms)", "CW (P)", "Period (us)",
-    "Recv ACK", "Procd ACK", "Sent Packets", "Re-sent Packets"
+    "Recv ACK", "Procd ACK", "Sent Packets", "Re-sent Packets",
+    "Threads", "Wakeups/s", "Jitter (us)"
 };
 
 const QStringList SERVER_STATS_TABLE_HEADERS {
@@ -74,6 +83,15 @@ UDTTest::UDTTest(int& argc, char** argv) :
     // randomize the seed for packet size randomization
     srand(time(NULL));
 
+    if (_argumentParser.isSet(SENDER_THREADS)) {
+        // has to be decided before any connection starts sending
+        udt::SendQueue::setNumSharedSenderThreads(_argumentParser.value(SENDER_THREADS).toInt());
+    }
+
+    if (_argumentParser.isSet(CONNECTIONS)) {
+        _numConnections = std::max(1, _argumentParser.value(CONNECTIONS).toInt());
+    }
+
     _socket.bind(QHostAddress::AnyIPv4, _argumentParser.value(PORT_OPTION).toUInt());
     qDebug() << "Test socket is listening on" << _socket.localPort();
     
@@ -92,7 +110,26 @@ UDTTest::UDTTest(int& argc, char** argv) :
         } else {
             _target = HifiSockAddr(address, port);
             qDebug() << "Packets will be sent to" << _target;
+
+            for (int i = 0; i < _numConnections; ++i) {
+                _targets.push_back(HifiSockAddr(address, port + i));
+            }
+            if (_numConnections > 1) {
+                qDebug() << "over" << _numConnections << "connections, up to port" << port + _numConnections - 1;
+            }
+        }
+    } else if (_numConnections > 1) {
+        // a receiver for many connections at once, with one socket per connection the sender opens
+        if (!_argumentParser.isSet(PORT_OPTION)) {
+            qCritical() << "A listening port is required to listen for more than one connection.";
+            QMetaObject::invokeMethod(this, "quit", Qt::QueuedConnection);
+        }
+
+        for (int i = 1; i < _numConnections; ++i) {
+            _extraSockets.emplace_back(new udt::Socket);
+            _extraSockets.back()->bind(QHostAddress::AnyIPv4, _socket.localPort() + i);
         }
+        qDebug() << "Also listening on ports up to" << _socket.localPort() + _numConnections - 1;
     }
     
     if (_argumentParser.isSet(PACKET_SIZE)) {
@@ -141,6 +178,11 @@ UDTTest::UDTTest(int& argc, char** argv) :
 
     if (_argumentParser.isSet(ORDERED_PACKETS)) {
         _sendOrdered = true;
+
+        if (_numConnections > 1) {
+            qCritical() << "Cannot send ordered packets over more than one connection.";
+            QMetaObject::invokeMethod(this, "quit", Qt::QueuedConnection);
+        }
     }
     
     if (_argumentParser.isSet(MESSAGE_SIZE)) {
@@ -224,7 +266,7 @@ void UDTTest::parseArguments() {
     _argumentParser.addOptions({
         PORT_OPTION, TARGET_OPTION, PACKET_SIZE, MIN_PACKET_SIZE, MAX_PACKET_SIZE,
         MAX_SEND_BYTES, MAX_SEND_PACKETS, UNRELIABLE_PACKETS, ORDERED_PACKETS,
-        MESSAGE_SIZE, MESSAGE_SEED, STATS_INTERVAL
+        MESSAGE_SIZE, MESSAGE_SEED, STATS_INTERVAL, CONNECTIONS, SENDER_THREADS
     });
     
     if (!_argumentParser.parse(arguments())) {
@@ -244,17 +286,24 @@ void UDTTest::sendInitialPackets() {
     
     int numPackets = std::max(NUM_INITIAL_PACKETS, _maxSendPackets);
     
-    for (int i = 0; i < numPackets; ++i) {
-        sendPacket();
-    }
-    
-    if (numPackets == NUM_INITIAL_PACKETS) {
-        // we've put 500 initial packets in the queue, everytime we hear one has gone out we should add a new one
-        _socket.connectToSendSignal(_target, this, SLOT(refillPacket()));
+    for (auto& target : _targets) {
+        for (int i = 0; i < numPackets; ++i) {
+            sendPacket(target);
+        }
+
+        if (numPackets == NUM_INITIAL_PACKETS) {
+            // we've put 500 initial packets in the queue, everytime we hear one has gone out we should add a new one
+            _socket.connectToSendSignal(target, this, SLOT(refillPacket()));
+        }
     }
 }
 
-void UDTTest::sendPacket() {
+void UDTTest::refillPacket() {
+    auto connection = qobject_cast<udt::Connection*>(sender());
+    sendPacket(connection ? connection->getDestination() : _target);
+}
+
+void UDTTest::sendPacket(const HifiSockAddr& target) {
     
     if (_maxSendPackets != -1 && _totalQueuedPackets > _maxSendPackets) {
         // don't send more packets, we've hit max
@@ -310,7 +359,7 @@ void UDTTest::sendPacket() {
             _totalQueuedBytes += (int)packetList->getDataSize();
             _totalQueuedPackets += (int)packetList->getNumPackets();
             
-            _socket.writePacketList(std::move(packetList), _target);
+            _socket.writePacketList(std::move(packetList), target);
         }
         
     } else {
@@ -321,9 +370,9 @@ void UDTTest::sendPacket() {
         
         // queue or send this packet by calling write packet on the socket for our target
         if (_sendReliable) {
-            _socket.writePacket(std::move(newPacket), _target);
+            _socket.writePacket(std::move(newPacket), target);
         } else {
-            _socket.writePacket(*newPacket, _target);
+            _socket.writePacket(*newPacket, target);
         }
         
         ++_totalQueuedPackets;
@@ -373,6 +422,25 @@ void UDTTest::sampleStats() {
         }
         
         udt::ConnectionStats::Stats stats = _socket.sampleStatsForConnection(_target);
+
+        if (_targets.size() > 1) {
+            // rates and counts add up over all of the connections, the rest is averaged
+            int64_t totalRTT = stats.rtt;
+            int64_t totalJitter = stats.sendJitter;
+            for (size_t i = 1; i < _targets.size(); ++i) {
+                auto connectionStats = _socket.sampleStatsForConnection(_targets[i]);
+                stats.sendRate += connectionStats.sendRate;
+                stats.estimatedBandwith += connectionStats.estimatedBandwith;
+                stats.events[udt::ConnectionStats::Stats::ReceivedACK] += connectionStats.events[udt::ConnectionStats::Stats::ReceivedACK];
+                stats.events[udt::ConnectionStats::Stats::ProcessedACK] += connectionStats.events[udt::ConnectionStats::Stats::ProcessedACK];
+                stats.sentPackets += connectionStats.sentPackets;
+                stats.retransmittedPackets += connectionStats.retransmittedPackets;
+                totalRTT += connectionStats.rtt;
+                totalJitter += connectionStats.sendJitter;
+            }
+            stats.rtt = (int)(totalRTT / (int64_t)_targets.size());
+            stats.sendJitter = (int)(totalJitter / (int64_t)_targets.size());
+        }
         
         int headerIndex = -1;
         
@@ -386,7 +454,10 @@ void UDTTest::sampleStats() {
             QString::number(stats.events[udt::ConnectionStats::Stats::ReceivedACK]).rightJustified(CLIENT_STATS_TABLE_HEADERS[++headerIndex].size()),
             QString::number(stats.events[udt::ConnectionStats::Stats::ProcessedACK]).rightJustified(CLIENT_STATS_TABLE_HEADERS[++headerIndex].size()),
             QString::number(stats.sentPackets).rightJustified(CLIENT_STATS_TABLE_HEADERS[++headerIndex].size()),
-            QString::number(stats.retransmittedPackets).rightJustified(CLIENT_STATS_TABLE_HEADERS[++headerIndex].size())
+            QString::number(stats.retransmittedPackets).rightJustified(CLIENT_STATS_TABLE_HEADERS[++headerIndex].size()),
+            QString::number(stats.senderThreads).rightJustified(CLIENT_STATS_TABLE_HEADERS[++headerIndex].size()),
+            QString::number(stats.senderWakeupsPerSecond).rightJustified(CLIENT_STATS_TABLE_HEADERS[++headerIndex].size()),
+            QString::number(stats.sendJitter).rightJustified(CLIENT_STATS_TABLE_HEADERS[++headerIndex].size())
         };
         
         // output this line of values
@@ -414,7 +485,7 @@ void UDTTest::sampleStats() {
                 QString::number(stats.rtt / USECS_PER_MSEC, 'f', 2).rightJustified(SERVER_STATS_TABLE_HEADERS[++headerIndex].size()),
                 QString::number(stats.congestionWindowSize).rightJustified(SERVER_STATS_TABLE_HEADERS[++headerIndex].size()),
                 QString::number(stats.events[udt::ConnectionStats::Stats::SentACK]).rightJustified(SERVER_STATS_TABLE_HEADERS[++headerIndex].size()),
-                QString::number(stats.events[udt::ConnectionStats::Stats::Duplicate]).rightJustified(SERVER_STATS_TABLE_HEADERS[++headerIndex].size())
+                QString::number(stats.duplicatePackets).rightJustified(SERVER_STATS_TABLE_HEADERS[++headerIndex].size())
             };
             
             // output this line of values
@@ -36,7 +36,7 @@ public:
     UDTTest(int& argc, char** argv);
 
 public slots:
-    void refillPacket() { sendPacket(); } // adds a new packet to the queue when we are told one is sent
+    void refillPacket(); // adds a new packet to the queue when we are told one is sent
     void sampleStats();
     
 private:
@@ -44,12 +44,15 @@ private:
     void handleMessage(std::unique_ptr<Message> message);
     
     void sendInitialPackets(); // fills the queue with packets to start
-    void sendPacket(); // constructs and sends a packet according to the test parameters
+    void sendPacket(const HifiSockAddr& target); // constructs and sends a packet according to the test parameters
     
     QCommandLineParser _argumentParser;
     udt::Socket _socket;
+    std::vector<std::unique_ptr<udt::Socket>> _extraSockets; // receivers listening for more than one connection
     
     HifiSockAddr _target; // the target for sent packets
+    std::vector<HifiSockAddr> _targets; // one per connection, on consecutive ports from the target
+    int _numConnections { 1 };
     
     int _minPacketSize { udt::MAX_PACKET_SIZE };
     int _maxPacketSize { udt::MAX_PACKET_SIZE };